@@ -0,0 +1,168 @@
+#include "chimp_codec.h"
+#include "temporal_1d_simd_codec.h"
+#include "zstd_compressor.h"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+// Tick-like prices: a random walk over a 0.5 tick grid that often stays on the same level,
+// which is what trade and quote price columns look like in practice.
+template <typename T>
+static std::vector<T> generate_tick_prices(size_t num_elements) {
+    std::vector<T> data(num_elements);
+    std::mt19937 gen(1337); // Fixed seed for reproducible benchmarks
+    std::discrete_distribution<int> step({1, 3, 12, 3, 1}); // -2..+2 ticks, mostly unchanged
+    T price = static_cast<T>(30000.0);
+    for (T& val : data) {
+        price += static_cast<T>(step(gen) - 2) * static_cast<T>(0.5);
+        val = price;
+    }
+    return data;
+}
+
+class ChimpCodecBenchmark : public benchmark::Fixture {
+public:
+    void SetUp(const ::benchmark::State& state) override {
+        const size_t num_elements = state.range(0);
+        float_data = generate_tick_prices<float>(num_elements);
+        double_data = generate_tick_prices<double>(num_elements);
+        xor_shuffle_codec_ = std::make_unique<cryptodd::Temporal1dSimdCodec>(std::make_unique<cryptodd::ZstdCompressor>());
+    }
+
+    void TearDown(const ::benchmark::State& state) override {
+        float_data.clear();
+        double_data.clear();
+        xor_shuffle_codec_.reset();
+    }
+
+protected:
+    static void report_ratio(benchmark::State& state, const size_t original_bytes, const size_t encoded_bytes) {
+        state.counters["ratio"] = encoded_bytes == 0 ? 0.0 : static_cast<double>(original_bytes) / static_cast<double>(encoded_bytes);
+        state.counters["bits_per_value"] = 8.0 * static_cast<double>(encoded_bytes) / static_cast<double>(state.range(0));
+    }
+
+    std::vector<float> float_data;
+    std::vector<double> double_data;
+    cryptodd::ChimpCodec chimp_codec_;
+    cryptodd::ChimpCodecWorkspace chimp_workspace_;
+    cryptodd::Temporal1dSimdCodecWorkspace xor_shuffle_workspace_;
+    std::unique_ptr<cryptodd::Temporal1dSimdCodec> xor_shuffle_codec_;
+};
+
+// --- Float32: Chimp128 ---
+BENCHMARK_DEFINE_F(ChimpCodecBenchmark, Encode32_Chimp)(benchmark::State& state) {
+    size_t encoded_bytes = 0;
+    for (auto _ : state) {
+        auto result = chimp_codec_.encode32(float_data, 0.0f, chimp_workspace_);
+        if (!result) {
+            state.SkipWithError(result.error().c_str());
+            return;
+        }
+        encoded_bytes = result->size();
+        benchmark::DoNotOptimize(std::move(*result));
+    }
+    report_ratio(state, float_data.size() * sizeof(float), encoded_bytes);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * float_data.size() * sizeof(float));
+}
+
+BENCHMARK_DEFINE_F(ChimpCodecBenchmark, Decode32_Chimp)(benchmark::State& state) {
+    auto encode_result = chimp_codec_.encode32(float_data, 0.0f, chimp_workspace_);
+    if (!encode_result) {
+        state.SkipWithError(("Setup for decode failed during encode: " + encode_result.error()).c_str());
+        return;
+    }
+    const cryptodd::memory::vector<std::byte> encoded = std::move(*encode_result);
+
+    for (auto _ : state) {
+        float decoder_prev_element = 0.0f;
+        auto result = chimp_codec_.decode32(encoded, float_data.size(), decoder_prev_element);
+        if (!result) {
+            state.SkipWithError(result.error().c_str());
+            return;
+        }
+        benchmark::DoNotOptimize(std::move(*result));
+    }
+    report_ratio(state, float_data.size() * sizeof(float), encoded.size());
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * float_data.size() * sizeof(float));
+}
+
+// --- Float32: XOR + byte shuffle + zstd (baseline) ---
+BENCHMARK_DEFINE_F(ChimpCodecBenchmark, Encode32_Xor_Shuffle)(benchmark::State& state) {
+    size_t encoded_bytes = 0;
+    for (auto _ : state) {
+        auto result = xor_shuffle_codec_->encode32_Xor_Shuffle(float_data, 0.0f, xor_shuffle_workspace_);
+        if (!result) {
+            state.SkipWithError(result.error().c_str());
+            return;
+        }
+        encoded_bytes = result->size();
+        benchmark::DoNotOptimize(std::move(*result));
+    }
+    report_ratio(state, float_data.size() * sizeof(float), encoded_bytes);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * float_data.size() * sizeof(float));
+}
+
+BENCHMARK_DEFINE_F(ChimpCodecBenchmark, Decode32_Xor_Shuffle)(benchmark::State& state) {
+    auto encode_result = xor_shuffle_codec_->encode32_Xor_Shuffle(float_data, 0.0f, xor_shuffle_workspace_);
+    if (!encode_result) {
+        state.SkipWithError(("Setup for decode failed during encode: " + encode_result.error()).c_str());
+        return;
+    }
+    const cryptodd::memory::vector<std::byte> encoded = std::move(*encode_result);
+
+    for (auto _ : state) {
+        float decoder_prev_element = 0.0f;
+        auto result = xor_shuffle_codec_->decode32_Xor_Shuffle(encoded, float_data.size(), decoder_prev_element);
+        if (!result) {
+            state.SkipWithError(result.error().c_str());
+            return;
+        }
+        benchmark::DoNotOptimize(std::move(*result));
+    }
+    report_ratio(state, float_data.size() * sizeof(float), encoded.size());
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * float_data.size() * sizeof(float));
+}
+
+// --- Float64: Chimp128 ---
+BENCHMARK_DEFINE_F(ChimpCodecBenchmark, Encode64_Chimp)(benchmark::State& state) {
+    size_t encoded_bytes = 0;
+    for (auto _ : state) {
+        auto result = chimp_codec_.encode64(double_data, 0.0, chimp_workspace_);
+        if (!result) {
+            state.SkipWithError(result.error().c_str());
+            return;
+        }
+        encoded_bytes = result->size();
+        benchmark::DoNotOptimize(std::move(*result));
+    }
+    report_ratio(state, double_data.size() * sizeof(double), encoded_bytes);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * double_data.size() * sizeof(double));
+}
+
+BENCHMARK_DEFINE_F(ChimpCodecBenchmark, Decode64_Chimp)(benchmark::State& state) {
+    auto encode_result = chimp_codec_.encode64(double_data, 0.0, chimp_workspace_);
+    if (!encode_result) {
+        state.SkipWithError(("Setup for decode failed during encode: " + encode_result.error()).c_str());
+        return;
+    }
+    const cryptodd::memory::vector<std::byte> encoded = std::move(*encode_result);
+
+    for (auto _ : state) {
+        double decoder_prev_element = 0.0;
+        auto result = chimp_codec_.decode64(encoded, double_data.size(), decoder_prev_element);
+        if (!result) {
+            state.SkipWithError(result.error().c_str());
+            return;
+        }
+        benchmark::DoNotOptimize(std::move(*result));
+    }
+    report_ratio(state, double_data.size() * sizeof(double), encoded.size());
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * double_data.size() * sizeof(double));
+}
+
+BENCHMARK_REGISTER_F(ChimpCodecBenchmark, Encode32_Chimp)->RangeMultiplier(4)->Range(1 << 12, 1 << 20);
+BENCHMARK_REGISTER_F(ChimpCodecBenchmark, Decode32_Chimp)->RangeMultiplier(4)->Range(1 << 12, 1 << 20);
+BENCHMARK_REGISTER_F(ChimpCodecBenchmark, Encode32_Xor_Shuffle)->RangeMultiplier(4)->Range(1 << 12, 1 << 20);
+BENCHMARK_REGISTER_F(ChimpCodecBenchmark, Decode32_Xor_Shuffle)->RangeMultiplier(4)->Range(1 << 12, 1 << 20);
+BENCHMARK_REGISTER_F(ChimpCodecBenchmark, Encode64_Chimp)->RangeMultiplier(4)->Range(1 << 12, 1 << 20);
+BENCHMARK_REGISTER_F(ChimpCodecBenchmark, Decode64_Chimp)->RangeMultiplier(4)->Range(1 << 12, 1 << 20);
@@ -137,4 +137,69 @@ BENCHMARK_DEFINE_F(OkxObSimdCodecBenchmark, Decode32)(benchmark::State& state) {
 }
 
 BENCHMARK_REGISTER_F(OkxObSimdCodecBenchmark, Encode32)->RangeMultiplier(8)->Range(16, 16 * 1024);
-BENCHMARK_REGISTER_F(OkxObSimdCodecBenchmark, Decode32)->RangeMultiplier(8)->Range(16, 16 * 1024);
\ No newline at end of file
+BENCHMARK_REGISTER_F(OkxObSimdCodecBenchmark, Decode32)->RangeMultiplier(8)->Range(16, 16 * 1024);
+
+// --- Pre-compression transform only (no zstd): two-pass reference vs fused single pass ---
+
+BENCHMARK_DEFINE_F(OkxObSimdCodecBenchmark, Transform16_TwoPass)(benchmark::State& state) {
+    constexpr size_t snapshot_floats = cryptodd::OkxObSimdCodec::SnapshotFloats;
+    const size_t num_snapshots = state.range(0);
+    std::vector<hwy::float16_t> deltas(original_data.size());
+    std::vector<uint8_t> shuffled(original_data.size() * sizeof(hwy::float16_t));
+    for (auto _ : state) {
+        for (size_t s = 0; s < num_snapshots; ++s) {
+            const float* prev = s == 0 ? initial_prev_snapshot.data() : original_data.data() + (s - 1) * snapshot_floats;
+            cryptodd::simd::DemoteAndXor_dispatcher(original_data.data() + s * snapshot_floats, prev, deltas.data() + s * snapshot_floats, snapshot_floats);
+        }
+        cryptodd::simd::ShuffleFloat16_dispatcher(deltas.data(), shuffled.data(), original_data.size());
+        benchmark::DoNotOptimize(shuffled.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * original_data.size() * sizeof(float));
+}
+
+BENCHMARK_DEFINE_F(OkxObSimdCodecBenchmark, Transform16_Fused)(benchmark::State& state) {
+    const size_t num_snapshots = state.range(0);
+    std::vector<uint8_t> shuffled(original_data.size() * sizeof(hwy::float16_t));
+    for (auto _ : state) {
+        cryptodd::simd::DemoteXorShuffle16_dispatcher(original_data.data(), initial_prev_snapshot.data(), shuffled.data(),
+                                                      num_snapshots, cryptodd::OkxObSimdCodec::SnapshotFloats);
+        benchmark::DoNotOptimize(shuffled.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * original_data.size() * sizeof(float));
+}
+
+BENCHMARK_DEFINE_F(OkxObSimdCodecBenchmark, Transform32_TwoPass)(benchmark::State& state) {
+    constexpr size_t snapshot_floats = cryptodd::OkxObSimdCodec::SnapshotFloats;
+    const size_t num_snapshots = state.range(0);
+    std::vector<float> deltas(original_data.size());
+    std::vector<uint8_t> shuffled(original_data.size() * sizeof(float));
+    for (auto _ : state) {
+        for (size_t s = 0; s < num_snapshots; ++s) {
+            const float* prev = s == 0 ? initial_prev_snapshot.data() : original_data.data() + (s - 1) * snapshot_floats;
+            cryptodd::simd::XorFloat32_dispatcher(original_data.data() + s * snapshot_floats, prev, deltas.data() + s * snapshot_floats, snapshot_floats);
+        }
+        cryptodd::simd::ShuffleFloat32_dispatcher(deltas.data(), shuffled.data(), original_data.size());
+        benchmark::DoNotOptimize(shuffled.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * original_data.size() * sizeof(float));
+}
+
+BENCHMARK_DEFINE_F(OkxObSimdCodecBenchmark, Transform32_Fused)(benchmark::State& state) {
+    const size_t num_snapshots = state.range(0);
+    std::vector<uint8_t> shuffled(original_data.size() * sizeof(float));
+    for (auto _ : state) {
+        cryptodd::simd::XorShuffleFloat32_dispatcher(original_data.data(), initial_prev_snapshot.data(), shuffled.data(),
+                                                     num_snapshots, cryptodd::OkxObSimdCodec::SnapshotFloats);
+        benchmark::DoNotOptimize(shuffled.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * original_data.size() * sizeof(float));
+}
+
+BENCHMARK_REGISTER_F(OkxObSimdCodecBenchmark, Transform16_TwoPass)->RangeMultiplier(8)->Range(16, 16 * 1024);
+BENCHMARK_REGISTER_F(OkxObSimdCodecBenchmark, Transform16_Fused)->RangeMultiplier(8)->Range(16, 16 * 1024);
+BENCHMARK_REGISTER_F(OkxObSimdCodecBenchmark, Transform32_TwoPass)->RangeMultiplier(8)->Range(16, 16 * 1024);
+BENCHMARK_REGISTER_F(OkxObSimdCodecBenchmark, Transform32_Fused)->RangeMultiplier(8)->Range(16, 16 * 1024);
@@ -43,6 +43,28 @@ public:
     }
 
 protected:
+    // Encodes once with the given shuffle layout, then times decode only.
+    void run_decode32_layout(benchmark::State& state, const cryptodd::codecs::ShuffleLayout layout) {
+        const size_t num_elements = state.range(0);
+        auto encode_result = codec_->encode32_Xor_Shuffle(original_float_data, initial_prev_element_float, workspace_, layout);
+        if (!encode_result) {
+            state.SkipWithError(("Setup for decode failed during encode: " + encode_result.error()).c_str());
+            return;
+        }
+        const cryptodd::memory::vector<std::byte> encoded = std::move(*encode_result);
+
+        for (auto _ : state) {
+            float decoder_prev_element = initial_prev_element_float;
+            auto result = codec_->decode32_Xor_Shuffle(encoded, num_elements, decoder_prev_element, layout);
+            if (!result) {
+                state.SkipWithError(result.error().c_str());
+                return;
+            }
+            benchmark::DoNotOptimize(std::move(*result));
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * original_float_data.size() * sizeof(float));
+    }
+
     std::vector<float> original_float_data;
     std::vector<int64_t> original_int64_data;
     float initial_prev_element_float = 123.45f;
@@ -186,6 +208,102 @@ BENCHMARK_DEFINE_F(Temporal1dSimdCodecBenchmark, Decode64_Delta)(benchmark::Stat
     state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * original_int64_data.size() * sizeof(int64_t));
 }
 
+BENCHMARK_DEFINE_F(Temporal1dSimdCodecBenchmark, Encode64_Delta_BitPack)(benchmark::State& state) {
+    size_t encoded_bytes = 0;
+    for (auto _ : state) {
+        auto result = codec_->encode64_Delta_BitPack(original_int64_data, initial_prev_element_int64, workspace_);
+        if (!result) {
+            state.SkipWithError(result.error().c_str());
+            return;
+        }
+        encoded_bytes = result->size();
+        benchmark::DoNotOptimize(std::move(*result));
+    }
+    state.counters["bits_per_value"] = 8.0 * static_cast<double>(encoded_bytes) / static_cast<double>(original_int64_data.size());
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * original_int64_data.size() * sizeof(int64_t));
+}
+
+BENCHMARK_DEFINE_F(Temporal1dSimdCodecBenchmark, Decode64_Delta_BitPack)(benchmark::State& state) {
+    const size_t num_elements = state.range(0);
+    auto encode_result = codec_->encode64_Delta_BitPack(original_int64_data, initial_prev_element_int64, workspace_);
+    if (!encode_result) {
+        state.SkipWithError(("Setup for decode failed during encode: " + encode_result.error()).c_str());
+        return;
+    }
+    const cryptodd::memory::vector<std::byte> encoded = std::move(*encode_result);
+
+    for (auto _ : state) {
+        int64_t decoder_prev_element = initial_prev_element_int64;
+        auto result = codec_->decode64_Delta_BitPack(encoded, num_elements, decoder_prev_element);
+        if (!result) {
+            state.SkipWithError(result.error().c_str());
+            return;
+        }
+        benchmark::DoNotOptimize(std::move(*result));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * original_int64_data.size() * sizeof(int64_t));
+}
+
+
+// --- Pre-compression transform only (no zstd): two-pass reference vs fused single pass ---
+BENCHMARK_DEFINE_F(Temporal1dSimdCodecBenchmark, Transform16_TwoPass)(benchmark::State& state) {
+    const size_t n = original_float_data.size();
+    std::vector<hwy::float16_t> deltas(n);
+    std::vector<uint8_t> shuffled(n * sizeof(hwy::float16_t));
+    for (auto _ : state) {
+        cryptodd::simd::DemoteAndXor1D_dispatcher(original_float_data.data(), deltas.data(), n, initial_prev_element_float);
+        cryptodd::simd::ShuffleFloat16_1D_dispatcher(deltas.data(), shuffled.data(), n);
+        benchmark::DoNotOptimize(shuffled.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * n * sizeof(float));
+}
+
+BENCHMARK_DEFINE_F(Temporal1dSimdCodecBenchmark, Transform16_Fused)(benchmark::State& state) {
+    const size_t n = original_float_data.size();
+    std::vector<uint8_t> shuffled(n * sizeof(hwy::float16_t));
+    for (auto _ : state) {
+        cryptodd::simd::DemoteXorShuffle16_1D_dispatcher(original_float_data.data(), shuffled.data(), n, initial_prev_element_float);
+        benchmark::DoNotOptimize(shuffled.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * n * sizeof(float));
+}
+
+BENCHMARK_DEFINE_F(Temporal1dSimdCodecBenchmark, Transform32_TwoPass)(benchmark::State& state) {
+    const size_t n = original_float_data.size();
+    std::vector<float> deltas(n);
+    std::vector<uint8_t> shuffled(n * sizeof(float));
+    for (auto _ : state) {
+        cryptodd::simd::XorFloat32_1D_dispatcher(original_float_data.data(), deltas.data(), n, initial_prev_element_float);
+        cryptodd::simd::ShuffleFloat32_1D_dispatcher(deltas.data(), shuffled.data(), n);
+        benchmark::DoNotOptimize(shuffled.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * n * sizeof(float));
+}
+
+BENCHMARK_DEFINE_F(Temporal1dSimdCodecBenchmark, Transform32_Fused)(benchmark::State& state) {
+    const size_t n = original_float_data.size();
+    std::vector<uint8_t> shuffled(n * sizeof(float));
+    for (auto _ : state) {
+        cryptodd::simd::XorShuffleFloat32_1D_dispatcher(original_float_data.data(), shuffled.data(), n, initial_prev_element_float);
+        benchmark::DoNotOptimize(shuffled.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * n * sizeof(float));
+}
+
+// --- Decode Layout Benchmarks ---
+// Global decompresses the whole chunk before unshuffling; Blocked streams it through a block-sized buffer.
+// The gap opens up once the chunk no longer fits in L2.
+BENCHMARK_DEFINE_F(Temporal1dSimdCodecBenchmark, Decode32_GlobalLayout)(benchmark::State& state) {
+    run_decode32_layout(state, cryptodd::codecs::ShuffleLayout::Global);
+}
+
+BENCHMARK_DEFINE_F(Temporal1dSimdCodecBenchmark, Decode32_BlockedLayout)(benchmark::State& state) {
+    run_decode32_layout(state, cryptodd::codecs::ShuffleLayout::Blocked);
+}
 
 BENCHMARK_REGISTER_F(Temporal1dSimdCodecBenchmark, Encode16_Xor_Shuffle)->RangeMultiplier(8)->Range(64, 16 * 1024);
 BENCHMARK_REGISTER_F(Temporal1dSimdCodecBenchmark, Decode16_Xor_Shuffle)->RangeMultiplier(8)->Range(64, 16 * 1024);
@@ -194,4 +312,12 @@ BENCHMARK_REGISTER_F(Temporal1dSimdCodecBenchmark, Decode32_Xor_Shuffle)->RangeM
 BENCHMARK_REGISTER_F(Temporal1dSimdCodecBenchmark, Encode64_Xor)->RangeMultiplier(8)->Range(64, 16 * 1024);
 BENCHMARK_REGISTER_F(Temporal1dSimdCodecBenchmark, Decode64_Xor)->RangeMultiplier(8)->Range(64, 16 * 1024);
 BENCHMARK_REGISTER_F(Temporal1dSimdCodecBenchmark, Encode64_Delta)->RangeMultiplier(8)->Range(64, 16 * 1024);
-BENCHMARK_REGISTER_F(Temporal1dSimdCodecBenchmark, Decode64_Delta)->RangeMultiplier(8)->Range(64, 16 * 1024);
\ No newline at end of file
+BENCHMARK_REGISTER_F(Temporal1dSimdCodecBenchmark, Decode64_Delta)->RangeMultiplier(8)->Range(64, 16 * 1024);
+BENCHMARK_REGISTER_F(Temporal1dSimdCodecBenchmark, Encode64_Delta_BitPack)->RangeMultiplier(8)->Range(64, 16 * 1024);
+BENCHMARK_REGISTER_F(Temporal1dSimdCodecBenchmark, Decode64_Delta_BitPack)->RangeMultiplier(8)->Range(64, 16 * 1024);
+BENCHMARK_REGISTER_F(Temporal1dSimdCodecBenchmark, Transform16_TwoPass)->RangeMultiplier(8)->Range(64, 256 * 1024);
+BENCHMARK_REGISTER_F(Temporal1dSimdCodecBenchmark, Transform16_Fused)->RangeMultiplier(8)->Range(64, 256 * 1024);
+BENCHMARK_REGISTER_F(Temporal1dSimdCodecBenchmark, Transform32_TwoPass)->RangeMultiplier(8)->Range(64, 256 * 1024);
+BENCHMARK_REGISTER_F(Temporal1dSimdCodecBenchmark, Transform32_Fused)->RangeMultiplier(8)->Range(64, 256 * 1024);
+BENCHMARK_REGISTER_F(Temporal1dSimdCodecBenchmark, Decode32_GlobalLayout)->RangeMultiplier(8)->Range(4 * 1024, 2 * 1024 * 1024);
+BENCHMARK_REGISTER_F(Temporal1dSimdCodecBenchmark, Decode32_BlockedLayout)->RangeMultiplier(8)->Range(4 * 1024, 2 * 1024 * 1024);
@@ -157,11 +157,64 @@ BENCHMARK_DEFINE_F(Temporal2dSimdCodecBenchmark, Decode64)(benchmark::State& sta
     state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * original_int64_data.size() * sizeof(int64_t));
 }
 
+// --- Pre-compression transform only (no zstd): two-pass reference vs fused single pass ---
+BENCHMARK_DEFINE_F(Temporal2dSimdCodecBenchmark, Transform16_TwoPass)(benchmark::State& state) {
+    const size_t num_rows = state.range(0);
+    std::vector<hwy::float16_t> deltas(original_float_data.size());
+    std::vector<uint8_t> shuffled(original_float_data.size() * sizeof(hwy::float16_t));
+    for (auto _ : state) {
+        cryptodd::simd::DemoteAndXor2D_dispatcher(original_float_data.data(), initial_prev_row_float.data(), deltas.data(), num_rows, kNumFeatures);
+        cryptodd::simd::ShuffleFloat16_2D_dispatcher(deltas.data(), shuffled.data(), num_rows, kNumFeatures);
+        benchmark::DoNotOptimize(shuffled.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * original_float_data.size() * sizeof(float));
+}
+
+BENCHMARK_DEFINE_F(Temporal2dSimdCodecBenchmark, Transform16_Fused)(benchmark::State& state) {
+    const size_t num_rows = state.range(0);
+    std::vector<uint8_t> shuffled(original_float_data.size() * sizeof(hwy::float16_t));
+    for (auto _ : state) {
+        cryptodd::simd::DemoteXorShuffle16_2D_dispatcher(original_float_data.data(), initial_prev_row_float.data(), shuffled.data(), num_rows, kNumFeatures);
+        benchmark::DoNotOptimize(shuffled.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * original_float_data.size() * sizeof(float));
+}
+
+BENCHMARK_DEFINE_F(Temporal2dSimdCodecBenchmark, Transform32_TwoPass)(benchmark::State& state) {
+    const size_t num_rows = state.range(0);
+    std::vector<float> deltas(original_float_data.size());
+    std::vector<uint8_t> shuffled(original_float_data.size() * sizeof(float));
+    for (auto _ : state) {
+        cryptodd::simd::XorFloat32_2D_dispatcher(original_float_data.data(), initial_prev_row_float.data(), deltas.data(), num_rows, kNumFeatures);
+        cryptodd::simd::ShuffleFloat32_2D_dispatcher(deltas.data(), shuffled.data(), num_rows, kNumFeatures);
+        benchmark::DoNotOptimize(shuffled.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * original_float_data.size() * sizeof(float));
+}
+
+BENCHMARK_DEFINE_F(Temporal2dSimdCodecBenchmark, Transform32_Fused)(benchmark::State& state) {
+    const size_t num_rows = state.range(0);
+    std::vector<uint8_t> shuffled(original_float_data.size() * sizeof(float));
+    for (auto _ : state) {
+        cryptodd::simd::XorShuffleFloat32_2D_dispatcher(original_float_data.data(), initial_prev_row_float.data(), shuffled.data(), num_rows, kNumFeatures);
+        benchmark::DoNotOptimize(shuffled.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * original_float_data.size() * sizeof(float));
+}
+
 BENCHMARK_REGISTER_F(Temporal2dSimdCodecBenchmark, Encode16)->RangeMultiplier(8)->Range(64, 16 * 1024);
 BENCHMARK_REGISTER_F(Temporal2dSimdCodecBenchmark, Decode16)->RangeMultiplier(8)->Range(64, 16 * 1024);
 BENCHMARK_REGISTER_F(Temporal2dSimdCodecBenchmark, Encode32)->RangeMultiplier(8)->Range(64, 16 * 1024);
 BENCHMARK_REGISTER_F(Temporal2dSimdCodecBenchmark, Decode32)->RangeMultiplier(8)->Range(64, 16 * 1024);
 BENCHMARK_REGISTER_F(Temporal2dSimdCodecBenchmark, Encode64)->RangeMultiplier(8)->Range(64, 16 * 1024);
 BENCHMARK_REGISTER_F(Temporal2dSimdCodecBenchmark, Decode64)->RangeMultiplier(8)->Range(64, 16 * 1024);
+BENCHMARK_REGISTER_F(Temporal2dSimdCodecBenchmark, Transform16_TwoPass)->RangeMultiplier(8)->Range(64, 16 * 1024);
+BENCHMARK_REGISTER_F(Temporal2dSimdCodecBenchmark, Transform16_Fused)->RangeMultiplier(8)->Range(64, 16 * 1024);
+BENCHMARK_REGISTER_F(Temporal2dSimdCodecBenchmark, Transform32_TwoPass)->RangeMultiplier(8)->Range(64, 16 * 1024);
+BENCHMARK_REGISTER_F(Temporal2dSimdCodecBenchmark, Transform32_Fused)->RangeMultiplier(8)->Range(64, 16 * 1024);
 
 //BENCHMARK_MAIN();
\ No newline at end of file
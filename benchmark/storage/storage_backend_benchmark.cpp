@@ -0,0 +1,198 @@
+#include "buffered_file_backend.h"
+#include "file_backend.h"
+#include "mio_backend.h"
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace cryptodd::storage;
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr size_t kPieceSize = size_t{1} << 20; // bytes per read() in scans
+constexpr size_t kLookupSize = 4096;           // bytes per read() in random lookups
+constexpr size_t kLookups = 4096;
+
+// The files written by test_file(), removed when the benchmarks exit.
+struct TestFiles {
+    std::map<size_t, fs::path> paths;
+
+    ~TestFiles() {
+        std::error_code ec;
+        for (const auto& [mib, path] : paths) fs::remove(path, ec);
+    }
+};
+
+// A file of `mib` MiB of random bytes, written once per size and shared by every benchmark.
+const fs::path& test_file(const size_t mib) {
+    static TestFiles files;
+    auto& path = files.paths[mib];
+    if (path.empty()) {
+        path = fs::temp_directory_path() / ("cryptodd_storage_benchmark_" + std::to_string(mib) + ".bin");
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        std::mt19937_64 gen(1337); // Fixed seed for reproducible benchmarks
+        std::vector<uint64_t> block(kPieceSize / sizeof(uint64_t));
+        for (size_t i = 0; i < mib; ++i) {
+            for (auto& word : block) word = gen();
+            out.write(reinterpret_cast<const char*>(block.data()), static_cast<std::streamsize>(kPieceSize));
+        }
+    }
+    return path;
+}
+
+// Evicts the file from the page cache, so the next pass reads from the device; a no-op outside Linux.
+void drop_cache(const fs::path& path) {
+#if defined(__linux__)
+    if (const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC); fd >= 0) {
+        ::fdatasync(fd);
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        ::close(fd);
+    }
+#else
+    (void)path;
+#endif
+}
+
+template <typename MakeBackend>
+void run_scan(benchmark::State& state, MakeBackend make_backend) {
+    const auto& path = test_file(static_cast<size_t>(state.range(0)));
+    const bool cold = state.range(1) != 0;
+    std::vector<std::byte> piece(kPieceSize);
+    uint64_t total = 0;
+    for (auto _ : state) {
+        if (cold) {
+            state.PauseTiming();
+            drop_cache(path);
+            state.ResumeTiming();
+        }
+        // Mapping (and populating) the file is part of the cost of a scan.
+        std::unique_ptr<IStorageBackend> backend = make_backend(path);
+        while (true) {
+            const auto n = backend->read(piece);
+            if (!n) {
+                state.SkipWithError(n.error().c_str());
+                return;
+            }
+            if (*n == 0) break;
+            total += *n;
+        }
+        benchmark::DoNotOptimize(piece.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(total));
+}
+
+template <typename MakeBackend>
+void run_lookups(benchmark::State& state, MakeBackend make_backend) {
+    const auto& path = test_file(static_cast<size_t>(state.range(0)));
+    const uint64_t file_size = fs::file_size(path);
+    std::unique_ptr<IStorageBackend> backend = make_backend(path);
+    std::mt19937_64 gen(42);
+    std::uniform_int_distribution<uint64_t> offset_dist(0, file_size - kLookupSize);
+    std::vector<uint64_t> offsets(kLookups);
+    for (auto& offset : offsets) offset = offset_dist(gen);
+
+    std::vector<std::byte> buffer(kLookupSize);
+    for (auto _ : state) {
+        for (const auto offset : offsets) {
+            if (!backend->seek(offset) || !backend->read(buffer)) {
+                state.SkipWithError("lookup failed");
+                return;
+            }
+            benchmark::DoNotOptimize(buffer.data());
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kLookups));
+}
+
+constexpr auto kReadOnly = std::ios_base::in | std::ios_base::binary;
+
+std::unique_ptr<IStorageBackend> make_file(const fs::path& path) {
+    return std::make_unique<FileBackend>(path, kReadOnly);
+}
+
+std::unique_ptr<IStorageBackend> make_buffered(const fs::path& path, const AccessHint hint) {
+    auto backend = std::make_unique<BufferedFileBackend>(path, kReadOnly);
+    (void)backend->advise(hint);
+    return backend;
+}
+
+std::unique_ptr<IStorageBackend> make_mmap(const fs::path& path, const MapOptions options, const AccessHint hint) {
+    auto backend = std::make_unique<MioBackend>(path, kReadOnly, options);
+    (void)backend->advise(hint);
+    return backend;
+}
+
+} // namespace
+
+// --- Sequential scans: {file size in MiB, cold page cache} ---
+static void BM_Scan_FileBackend(benchmark::State& state) {
+    run_scan(state, make_file);
+}
+
+static void BM_Scan_Buffered_Sequential(benchmark::State& state) {
+    run_scan(state, [](const fs::path& path) { return make_buffered(path, AccessHint::SEQUENTIAL); });
+}
+
+static void BM_Scan_Mmap(benchmark::State& state) {
+    run_scan(state, [](const fs::path& path) { return make_mmap(path, {}, AccessHint::NORMAL); });
+}
+
+static void BM_Scan_Mmap_Sequential(benchmark::State& state) {
+    run_scan(state, [](const fs::path& path) { return make_mmap(path, {}, AccessHint::SEQUENTIAL); });
+}
+
+static void BM_Scan_Mmap_Populate(benchmark::State& state) {
+    run_scan(state, [](const fs::path& path) { return make_mmap(path, {.populate = true}, AccessHint::NORMAL); });
+}
+
+static void BM_Scan_Mmap_HugePages(benchmark::State& state) {
+    run_scan(state, [](const fs::path& path) { return make_mmap(path, {.huge_pages = true}, AccessHint::SEQUENTIAL); });
+}
+
+// --- Random 4 KiB lookups on a warm file: {file size in MiB} ---
+static void BM_Lookup_FileBackend(benchmark::State& state) {
+    run_lookups(state, make_file);
+}
+
+static void BM_Lookup_Buffered_Random(benchmark::State& state) {
+    run_lookups(state, [](const fs::path& path) { return make_buffered(path, AccessHint::RANDOM); });
+}
+
+static void BM_Lookup_Mmap_Random(benchmark::State& state) {
+    run_lookups(state, [](const fs::path& path) { return make_mmap(path, {}, AccessHint::RANDOM); });
+}
+
+static void BM_Lookup_Mmap_Populate(benchmark::State& state) {
+    run_lookups(state, [](const fs::path& path) { return make_mmap(path, {.populate = true}, AccessHint::RANDOM); });
+}
+
+static void BM_Lookup_Mmap_HugePages(benchmark::State& state) {
+    run_lookups(state, [](const fs::path& path) {
+        return make_mmap(path, {.populate = true, .huge_pages = true}, AccessHint::RANDOM);
+    });
+}
+
+BENCHMARK(BM_Scan_FileBackend)->ArgsProduct({{64, 1024}, {0, 1}})->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_Scan_Buffered_Sequential)->ArgsProduct({{64, 1024}, {0, 1}})->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_Scan_Mmap)->ArgsProduct({{64, 1024}, {0, 1}})->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_Scan_Mmap_Sequential)->ArgsProduct({{64, 1024}, {0, 1}})->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_Scan_Mmap_Populate)->ArgsProduct({{64, 1024}, {0, 1}})->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_Scan_Mmap_HugePages)->ArgsProduct({{64, 1024}, {0, 1}})->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK(BM_Lookup_FileBackend)->Arg(64)->Arg(1024)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Lookup_Buffered_Random)->Arg(64)->Arg(1024)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Lookup_Mmap_Random)->Arg(64)->Arg(1024)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Lookup_Mmap_Populate)->Arg(64)->Arg(1024)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Lookup_Mmap_HugePages)->Arg(64)->Arg(1024)->Unit(benchmark::kMicrosecond);
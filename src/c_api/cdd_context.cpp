@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <functional>
 #include <iostream>
 #include <string>
@@ -17,6 +18,8 @@
 #include "operations/store_array_handler.h"
 #include "operations/store_chunk_handler.h"
 #include "operations/ping_handler.h"
+#include "operations/advise_handler.h"
+#include "operations/verify_handler.h"
 
 namespace cryptodd::ffi {
 
@@ -54,6 +57,13 @@ std::expected<std::unique_ptr<CddContext>, ExpectedError> CddContext::create(con
 
         std::unique_ptr<DataReader> reader;
         std::unique_ptr<DataWriter> writer;
+        const bool direct_io = backend_config.direct_io.value_or(false);
+        if (direct_io && backend_config.type != "File") {
+            return std::unexpected(ExpectedError("direct_io is only supported by the File backend."));
+        }
+        if (backend_config.mmap && (backend_config.type != "File" || backend_config.mode != "Read")) {
+            return std::unexpected(ExpectedError("mmap is only supported by the File backend in Read mode."));
+        }
 
         if (backend_config.mode == "Read") {
             if (backend_config.type != "File") {
@@ -62,13 +72,25 @@ std::expected<std::unique_ptr<CddContext>, ExpectedError> CddContext::create(con
             if (!backend_config.path) {
                 return std::unexpected(ExpectedError("File backend in Read mode requires a 'path'."));
             }
-            auto reader_result = DataReader::open(*backend_config.path);
+            FileReaderOptions reader_options{
+                .direct_io = direct_io,
+                .access = backend_config.access.value_or(storage::AccessHint::NORMAL),
+            };
+            if (const auto& mmap = backend_config.mmap) {
+                reader_options.memory_map = true;
+                reader_options.map.populate = mmap->populate.value_or(false);
+                reader_options.map.huge_pages = mmap->huge_pages.value_or(false);
+                reader_options.lock_index = mmap->lock_index.value_or(false);
+            }
+            auto reader_result = DataReader::open(*backend_config.path, reader_options);
             if (!reader_result) {
                 return std::unexpected(ExpectedError(reader_result.error()));
             }
             reader = std::move(*reader_result);
         } else { // WriteAppend or WriteTruncate
             size_t capacity = DataWriter::DEFAULT_CHUNK_OFFSETS_BLOCK_CAPACITY;
+            FileWriterOptions file_options;
+            file_options.direct_io = direct_io;
             memory::vector<std::byte> user_metadata;
 
             if (config.writer_options) {
@@ -76,6 +98,10 @@ std::expected<std::unique_ptr<CddContext>, ExpectedError> CddContext::create(con
                 if (writer_opts.chunk_offsets_block_capacity) {
                     capacity = *writer_opts.chunk_offsets_block_capacity;
                 }
+                file_options.write_buffer_size = writer_opts.write_buffer_size.value_or(file_options.write_buffer_size);
+                file_options.preallocate_extent = writer_opts.preallocate_extent.value_or(file_options.preallocate_extent);
+                file_options.chunk_alignment = writer_opts.chunk_alignment.value_or(file_options.chunk_alignment);
+                file_options.bitpack_index = writer_opts.bitpack_index.value_or(file_options.bitpack_index);
                 if (writer_opts.user_metadata_base64) {
                     const auto& metadata_b64 = *writer_opts.user_metadata_base64;
                     if (!metadata_b64.empty()) {
@@ -94,15 +120,21 @@ std::expected<std::unique_ptr<CddContext>, ExpectedError> CddContext::create(con
                     return std::unexpected(ExpectedError("File backend requires a 'path'."));
                 }
                 if (backend_config.mode == "WriteAppend") {
-                    writer_result = DataWriter::open_for_append(*backend_config.path);
+                    writer_result = DataWriter::open_for_append(*backend_config.path, file_options);
                 } else { // WriteTruncate
-                    writer_result = DataWriter::create_new(*backend_config.path, capacity, user_metadata);
+                    writer_result = DataWriter::create_new(*backend_config.path, capacity, user_metadata, file_options);
                 }
             } else if (backend_config.type == "Memory") {
                 if (backend_config.mode != "WriteTruncate") {
                     return std::unexpected(ExpectedError("Memory backend only supports WriteTruncate mode."));
                 }
                 writer_result = DataWriter::create_in_memory(capacity, user_metadata);
+                if (writer_result) {
+                    if (auto aligned = (*writer_result)->set_chunk_alignment(file_options.chunk_alignment); !aligned) {
+                        return std::unexpected(ExpectedError(aligned.error()));
+                    }
+                    (*writer_result)->set_bitpack_index(file_options.bitpack_index);
+                }
             } else {
                  return std::unexpected(ExpectedError("Unsupported backend type for writing: " + backend_config.type));
             }
@@ -111,9 +143,40 @@ std::expected<std::unique_ptr<CddContext>, ExpectedError> CddContext::create(con
                 return std::unexpected(ExpectedError(writer_result.error()));
             }
             writer = std::move(*writer_result);
+
+            if (config.writer_options && config.writer_options->durability) {
+                const auto& durability = *config.writer_options->durability;
+                DurabilityOptions options;
+                options.mode = durability.mode;
+                options.every_chunks = durability.every_chunks.value_or(options.every_chunks);
+                if (durability.interval_ms) {
+                    options.interval = std::chrono::milliseconds(*durability.interval_ms);
+                }
+                if (auto configured = writer->set_durability(options); !configured) {
+                    return std::unexpected(ExpectedError(configured.error()));
+                }
+            }
         }
         
-        return std::make_unique<CddContext>(ProtectedMarker{}, std::move(reader), std::move(writer), backend_config.type, backend_config.mode);
+        auto context = std::make_unique<CddContext>(ProtectedMarker{}, std::move(reader), std::move(writer), backend_config.type, backend_config.mode);
+        if (config.writer_options && config.writer_options->adaptive_zstd) {
+            const auto& adaptive = *config.writer_options->adaptive_zstd;
+            AdaptiveLevelOptions options;
+            options.min_level = adaptive.min_level.value_or(options.min_level);
+            options.max_level = adaptive.max_level.value_or(options.max_level);
+            // Without an explicit initial level, start from the default one moved into [min_level, max_level].
+            options.initial_level = adaptive.initial_level.value_or(std::max(options.min_level, std::min(options.initial_level, options.max_level)));
+            options.target_mbps = adaptive.target_mbps.value_or(options.target_mbps);
+            options.max_latency_ms = adaptive.max_latency_ms.value_or(options.max_latency_ms);
+            if (auto configured = context->get_compressor().level_controller().configure(options); !configured) {
+                return std::unexpected(ExpectedError(configured.error()));
+            }
+        }
+        if (config.writer_options) {
+            context->hash_options_.algorithm = config.writer_options->hash_algorithm.value_or(context->hash_options_.algorithm);
+            context->hash_options_.parallel_threshold = config.writer_options->hash_parallel_threshold.value_or(context->hash_options_.parallel_threshold);
+        }
+        return context;
 
     } catch(const nlohmann::json::exception& e) {
         return std::unexpected(ExpectedError(std::string("JSON configuration error: ") + e.what()));
@@ -207,6 +270,8 @@ case cx_hash(#OpName): return std::make_unique<OpName##Handler>()
                 CDD_CREATE_HANDLER_CASE(SetUserMetadata);
                 CDD_CREATE_HANDLER_CASE(Flush);
                 CDD_CREATE_HANDLER_CASE(Ping);
+                CDD_CREATE_HANDLER_CASE(Advise);
+                CDD_CREATE_HANDLER_CASE(Verify);
             default:
                 return {};
             }
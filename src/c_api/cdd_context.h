@@ -15,6 +15,7 @@
 #include "../data_io/data_writer.h"
 #include "../data_io/data_compressor.h"
 #include "../data_io/data_extractor.h"
+#include "../file_format/chunk_hash.h"
 
 namespace cryptodd::ffi {
 
@@ -67,6 +68,7 @@ public:
     std::optional<std::reference_wrapper<cryptodd::DataReader>> get_reader();
     cryptodd::DataCompressor& get_compressor() { return compressor_; }
     cryptodd::DataExtractor& get_extractor() { return extractor_; }
+    const cryptodd::HashOptions& get_hash_options() const { return hash_options_; }
     std::span<const std::byte> get_zero_state(size_t byte_size);
     CddContext(const CddContext&) = delete;
     CddContext& operator=(const CddContext&) = delete;
@@ -79,6 +81,7 @@ private:
     std::unique_ptr<cryptodd::DataWriter> writer_;
     cryptodd::DataCompressor compressor_;
     cryptodd::DataExtractor extractor_;
+    cryptodd::HashOptions hash_options_;
     std::map<size_t, cryptodd::memory::vector<std::byte>> zero_state_cache_;
     std::mutex zero_state_cache_mutex_;
     
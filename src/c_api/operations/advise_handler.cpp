@@ -0,0 +1,49 @@
+#include "../operations/advise_handler.h"
+#include "../operations/json_serialization.h"
+#include "../../data_io/codec_advisor.h"
+#include <nlohmann/json.hpp>
+
+namespace cryptodd::ffi {
+
+// The "Adapter"
+std::expected<nlohmann::json, ExpectedError> AdviseHandler::execute(
+    CddContext& context, const nlohmann::json& op_request, std::span<const std::byte> input_data, std::span<std::byte>)
+{
+    auto request_result = from_json<AdviseRequest>(op_request);
+    if (!request_result) return std::unexpected(request_result.error());
+
+    auto response_result = execute_typed(context, *request_result, input_data);
+    if (!response_result) return std::unexpected(response_result.error());
+
+    return to_json(*response_result);
+}
+
+// The "Business Logic"
+std::expected<AdviseResponse, ExpectedError> AdviseHandler::execute_typed(
+    CddContext& context, const AdviseRequest& request, std::span<const std::byte> input_data)
+{
+    // The sample is only analysed and compressed in memory, so any context mode can advise.
+    AdviseOptions options;
+    options.trial_compress = request.trial_compress.value_or(false);
+    options.trial_rows = request.trial_rows.value_or(options.trial_rows);
+    options.trial_level = request.zstd_level.value_or(options.trial_level);
+
+    auto stats = CodecAdvisor::analyze(input_data, request.data_spec.dtype, request.data_spec.shape);
+    if (!stats) return std::unexpected(ExpectedError("Advise failed: " + stats.error().to_string()));
+    auto ranked = CodecAdvisor(context.get_compressor()).advise(input_data, request.data_spec.dtype, request.data_spec.shape, *stats, options);
+    if (!ranked) return std::unexpected(ExpectedError("Advise failed: " + ranked.error().to_string()));
+
+    AdviseResponse response;
+    response.client_key = request.client_key;
+    response.xor_significant_bits = stats->xor_significant_bits;
+    response.unchanged_fraction = stats->unchanged_fraction;
+    response.raw_entropy_bits = stats->raw_entropy_bits;
+    response.recommendations.reserve(ranked->size());
+    for (const auto& r : *ranked) {
+        response.recommendations.push_back({r.codec, r.estimated_ratio, r.estimated_throughput_mbps, r.measured});
+    }
+    // Metadata will be injected at the C API layer
+    return response;
+}
+
+} // namespace cryptodd::ffi
@@ -25,12 +25,27 @@ std::expected<FlushResponse, ExpectedError> FlushHandler::execute_typed(
     auto writer_opt = context.get_writer();
     if (!writer_opt) return std::unexpected(ExpectedError("Context is not in a writable mode."));
     
-    auto result = writer_opt.value().get().flush();
+    auto& writer = writer_opt.value().get();
+    auto result = writer.flush();
     if (!result) return std::unexpected(ExpectedError(result.error()));
 
     FlushResponse response;
     response.client_key = request.client_key;
     response.status = "Flush completed.";
+    if (const auto stats = writer.sync_stats()) {
+        const auto& latency = stats->latency;
+        response.sync_stats = SyncStatsInfo{
+            .requests = stats->requests,
+            .batches = stats->batches,
+            .syncs = stats->syncs,
+            .failures = stats->failures,
+            .mean_us = latency.mean_us(),
+            .p50_us = latency.quantile_us(0.5),
+            .p99_us = latency.quantile_us(0.99),
+            .max_us = latency.max_us,
+            .latency_buckets = {latency.buckets.begin(), latency.buckets.end()},
+        };
+    }
     // Metadata will be injected at the C API layer
     return response;
 }
@@ -59,6 +59,7 @@ std::expected<InspectResponse, ExpectedError> InspectHandler::execute_typed(
         .user_metadata_base64 = std::move(user_meta_b64)
     };
 
+    response.index_lock_error = reader.index_lock_error();
     response.total_chunks = reader.num_chunks();
     response.chunk_summaries.reserve(reader.num_chunks());
 
@@ -61,12 +61,42 @@ static void to_json_base(nlohmann::json& j, const T& base) {
 void to_json(nlohmann::json& j, const DataSpec& spec) { j = {{"dtype", magic_enum::enum_name(spec.dtype)}, {"shape", spec.shape}}; }
 void from_json(const nlohmann::json& j, DataSpec& spec) { enum_from_json(get_required<nlohmann::json>(j, "dtype"), spec.dtype); spec.shape = get_required<std::vector<int64_t>>(j, "shape"); }
 
-void to_json(nlohmann::json& j, const EncodingSpec& spec) { j = {{"codec", magic_enum::enum_name(spec.codec)}, {"flags", spec.flags}, {"zstd_level", spec.zstd_level}}; }
-void from_json(const nlohmann::json& j, EncodingSpec& spec) { enum_from_json(get_required<nlohmann::json>(j, "codec"), spec.codec); spec.flags = j.value("flags", std::vector<std::string>{}); spec.zstd_level = j.value<std::optional<int>>("zstd_level", std::nullopt); }
+void to_json(nlohmann::json& j, const EncodingSpec& spec) {
+    j = {{"codec", magic_enum::enum_name(spec.codec)}, {"flags", spec.flags}, {"zstd_level", spec.zstd_level}, {"zstd_adaptive", spec.zstd_adaptive}, {"num_frames", spec.num_frames},
+         {"zstd_workers", spec.zstd_workers}, {"zstd_long_distance_matching", spec.zstd_long_distance_matching}, {"zstd_window_log", spec.zstd_window_log}};
+    j["zstd_strategy"] = spec.zstd_strategy ? nlohmann::json(magic_enum::enum_name(*spec.zstd_strategy)) : nlohmann::json(nullptr);
+    j["tick_sizes"] = spec.tick_sizes ? nlohmann::json(*spec.tick_sizes) : nlohmann::json(nullptr);
+    j["error_bounds"] = spec.error_bounds ? nlohmann::json(*spec.error_bounds) : nlohmann::json(nullptr);
+    j["relative_error_bound"] = spec.relative_error_bound;
+    j["hash_algorithm"] = spec.hash_algorithm ? nlohmann::json(magic_enum::enum_name(*spec.hash_algorithm)) : nlohmann::json(nullptr);
+}
+void from_json(const nlohmann::json& j, EncodingSpec& spec) {
+    enum_from_json(get_required<nlohmann::json>(j, "codec"), spec.codec);
+    spec.flags = j.value("flags", std::vector<std::string>{});
+    spec.zstd_level = j.value<std::optional<int>>("zstd_level", std::nullopt);
+    spec.zstd_adaptive = j.value<std::optional<bool>>("zstd_adaptive", std::nullopt);
+    spec.num_frames = j.value<std::optional<int>>("num_frames", std::nullopt);
+    spec.zstd_workers = j.value<std::optional<int>>("zstd_workers", std::nullopt);
+    spec.zstd_long_distance_matching = j.value<std::optional<bool>>("zstd_long_distance_matching", std::nullopt);
+    spec.zstd_window_log = j.value<std::optional<int>>("zstd_window_log", std::nullopt);
+    if (j.contains("zstd_strategy") && !j["zstd_strategy"].is_null()) {
+        ZstdStrategy strategy{};
+        enum_from_json(j["zstd_strategy"], strategy);
+        spec.zstd_strategy = strategy;
+    }
+    spec.tick_sizes = j.value<std::optional<std::vector<double>>>("tick_sizes", std::nullopt);
+    spec.error_bounds = j.value<std::optional<std::vector<double>>>("error_bounds", std::nullopt);
+    spec.relative_error_bound = j.value<std::optional<bool>>("relative_error_bound", std::nullopt);
+    if (j.contains("hash_algorithm") && !j["hash_algorithm"].is_null()) {
+        HashAlgorithm algorithm{};
+        enum_from_json(j["hash_algorithm"], algorithm);
+        spec.hash_algorithm = algorithm;
+    }
+}
 
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(ByCountChunking, rows_per_chunk)
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(OperationMetadata, backend_type, mode, duration_us)
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(ChunkWriteDetails, chunk_index, original_size, compressed_size, compression_ratio)
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(ChunkWriteDetails, chunk_index, original_size, compressed_size, compression_ratio, zstd_level)
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(FileHeaderInfo, version, index_block_offset, index_block_size, user_metadata_base64)
 
 // --- StoreChunk ---
@@ -102,12 +132,35 @@ void to_json(nlohmann::json& j, const StoreArrayResponse& res) { to_json_base(j,
 // --- LoadChunks ---
 void from_json(const nlohmann::json& j, ChunkSelection& s); // Implemented below
 void to_json(nlohmann::json& j, const ChunkSelection& s);   // Implemented below
-void from_json(const nlohmann::json& j, LoadChunksRequest& req) { from_json_base(j, req); req.selection = get_required<ChunkSelection>(j, "selection"); req.check_checksums = j.value("check_checksums", req.check_checksums); }
-void to_json(nlohmann::json& j, const LoadChunksResponse& res) { to_json_base(j, res); j["bytes_written_to_output"] = res.bytes_written_to_output; if (res.final_shape) j["final_shape"] = *res.final_shape; j["metadata"] = res.metadata; }
+void from_json(const nlohmann::json& j, LoadChunksRequest& req) {
+    from_json_base(j, req);
+    req.selection = get_required<ChunkSelection>(j, "selection");
+    req.check_checksums = j.value("check_checksums", req.check_checksums);
+    if (j.contains("access") && !j["access"].is_null()) {
+        storage::AccessHint access{};
+        enum_from_json(j["access"], access);
+        req.access = access;
+    }
+    req.prefetch_chunks = j.value<std::optional<size_t>>("prefetch_chunks", std::nullopt);
+}
+void to_json(nlohmann::json& j, const LoadChunksResponse& res) {
+    to_json_base(j, res);
+    j["bytes_written_to_output"] = res.bytes_written_to_output;
+    if (res.final_shape) j["final_shape"] = *res.final_shape;
+    if (res.prefetched_chunks) j["prefetched_chunks"] = *res.prefetched_chunks;
+    j["metadata"] = res.metadata;
+}
 
 // --- Inspect ---
 void from_json(const nlohmann::json& j, InspectRequest& req) { from_json_base(j, req); req.calculate_checksums = j.value("calculate_checksums", false); }
-void to_json(nlohmann::json& j, const InspectResponse& res) { to_json_base(j, res); j["file_header"] = res.file_header; j["total_chunks"] = res.total_chunks; j["chunk_summaries"] = res.chunk_summaries; j["metadata"] = res.metadata; }
+void to_json(nlohmann::json& j, const InspectResponse& res) {
+    to_json_base(j, res);
+    j["file_header"] = res.file_header;
+    j["total_chunks"] = res.total_chunks;
+    j["chunk_summaries"] = res.chunk_summaries;
+    if (res.index_lock_error) j["index_lock_error"] = *res.index_lock_error;
+    j["metadata"] = res.metadata;
+}
 
 // --- Metadata ---
 void from_json(const nlohmann::json& j, GetUserMetadataRequest& req) { from_json_base(j, req); }
@@ -117,15 +170,107 @@ void to_json(nlohmann::json& j, const SetUserMetadataResponse& res) { to_json_ba
 
 // --- Flush ---
 void from_json(const nlohmann::json& j, FlushRequest& req) { from_json_base(j, req); }
-void to_json(nlohmann::json& j, const FlushResponse& res) { to_json_base(j, res); j["status"] = res.status; j["metadata"] = res.metadata; }
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(SyncStatsInfo, requests, batches, syncs, failures, mean_us, p50_us, p99_us, max_us, latency_buckets)
+void to_json(nlohmann::json& j, const FlushResponse& res) {
+    to_json_base(j, res);
+    j["status"] = res.status;
+    if (res.sync_stats) j["sync_stats"] = *res.sync_stats;
+    j["metadata"] = res.metadata;
+}
 
 // --- Ping ---
 void from_json(const nlohmann::json& j, PingRequest& req) { from_json_base(j, req); }
 void to_json(nlohmann::json& j, const PingResponse& res) { to_json_base(j, res); j["message"] = res.message; j["metadata"] = res.metadata; }
 
+// --- Advise ---
+void from_json(const nlohmann::json& j, AdviseRequest& req) {
+    from_json_base(j, req);
+    req.data_spec = get_required<DataSpec>(j, "data_spec");
+    req.trial_compress = j.value<std::optional<bool>>("trial_compress", std::nullopt);
+    req.trial_rows = j.value<std::optional<size_t>>("trial_rows", std::nullopt);
+    req.zstd_level = j.value<std::optional<int>>("zstd_level", std::nullopt);
+}
+void to_json(nlohmann::json& j, const CodecAdvice& advice) {
+    j = nlohmann::json{
+        {"estimated_ratio", advice.estimated_ratio},
+        {"estimated_throughput_mbps", advice.estimated_throughput_mbps},
+        {"measured", advice.measured}
+    };
+    enum_to_json(j["codec"], advice.codec);
+}
+void to_json(nlohmann::json& j, const AdviseResponse& res) {
+    to_json_base(j, res);
+    j["recommendations"] = res.recommendations;
+    j["xor_significant_bits"] = res.xor_significant_bits;
+    j["unchanged_fraction"] = res.unchanged_fraction;
+    j["raw_entropy_bits"] = res.raw_entropy_bits;
+    j["metadata"] = res.metadata;
+}
+
+// --- Verify ---
+void from_json(const nlohmann::json& j, VerifyRequest& req) {
+    from_json_base(j, req);
+    req.max_read_mbps = j.value<std::optional<double>>("max_read_mbps", std::nullopt);
+    req.max_in_flight = j.value<std::optional<size_t>>("max_in_flight", std::nullopt);
+}
+void to_json(nlohmann::json& j, const ChunkFaultInfo& fault) {
+    j = nlohmann::json{{"index", fault.index}, {"reason", fault.reason}};
+}
+void to_json(nlohmann::json& j, const VerifyResponse& res) {
+    to_json_base(j, res);
+    j["ok"] = res.ok;
+    j["chunks_verified"] = res.chunks_verified;
+    j["chunks_unhashed"] = res.chunks_unhashed;
+    j["index_blocks"] = res.index_blocks;
+    j["bytes_read"] = res.bytes_read;
+    j["raw_bytes"] = res.raw_bytes;
+    j["faults"] = res.faults;
+    if (res.index_error) j["index_error"] = *res.index_error;
+    j["elapsed_s"] = res.elapsed_s;
+    j["read_mbps"] = res.read_mbps;
+    j["metadata"] = res.metadata;
+}
+
+void from_json(const nlohmann::json& j, AdaptiveZstdOptions& opts) {
+    opts.min_level = j.value<std::optional<int>>("min_level", std::nullopt);
+    opts.max_level = j.value<std::optional<int>>("max_level", std::nullopt);
+    opts.initial_level = j.value<std::optional<int>>("initial_level", std::nullopt);
+    opts.target_mbps = j.value<std::optional<double>>("target_mbps", std::nullopt);
+    opts.max_latency_ms = j.value<std::optional<double>>("max_latency_ms", std::nullopt);
+}
+
+void to_json(nlohmann::json& j, const AdaptiveZstdOptions& opts) {
+    j = {{"min_level", opts.min_level}, {"max_level", opts.max_level}, {"initial_level", opts.initial_level},
+         {"target_mbps", opts.target_mbps}, {"max_latency_ms", opts.max_latency_ms}};
+}
+
+void from_json(const nlohmann::json& j, DurabilityConfig& config) {
+    enum_from_json(get_required<nlohmann::json>(j, "mode"), config.mode);
+    config.every_chunks = j.value<std::optional<size_t>>("every_chunks", std::nullopt);
+    config.interval_ms = j.value<std::optional<int64_t>>("interval_ms", std::nullopt);
+}
+
+void to_json(nlohmann::json& j, const DurabilityConfig& config) {
+    j["mode"] = magic_enum::enum_name(config.mode);
+    if (config.every_chunks) j["every_chunks"] = *config.every_chunks;
+    if (config.interval_ms) j["interval_ms"] = *config.interval_ms;
+}
+
 void from_json(const nlohmann::json& j, WriterOptions& opts) {
     opts.chunk_offsets_block_capacity = j.value<std::optional<size_t>>("chunk_offsets_block_capacity", std::nullopt);
     opts.user_metadata_base64 = j.value<std::optional<std::string>>("user_metadata_base64", std::nullopt);
+    opts.adaptive_zstd = j.value<std::optional<AdaptiveZstdOptions>>("adaptive_zstd", std::nullopt);
+    if (j.contains("hash_algorithm") && !j["hash_algorithm"].is_null()) {
+        HashAlgorithm algorithm{};
+        enum_from_json(j["hash_algorithm"], algorithm);
+        opts.hash_algorithm = algorithm;
+    }
+    opts.hash_parallel_threshold = j.value<std::optional<size_t>>("hash_parallel_threshold", std::nullopt);
+    opts.write_buffer_size = j.value<std::optional<size_t>>("write_buffer_size", std::nullopt);
+    opts.preallocate_extent = j.value<std::optional<uint64_t>>("preallocate_extent", std::nullopt);
+    opts.durability = j.value<std::optional<DurabilityConfig>>("durability", std::nullopt);
+    opts.chunk_alignment = j.value<std::optional<uint32_t>>("chunk_alignment", std::nullopt);
+    opts.bitpack_index = j.value<std::optional<bool>>("bitpack_index", std::nullopt);
 }
 
 void to_json(nlohmann::json& j, const WriterOptions& opts) {
@@ -135,12 +280,56 @@ void to_json(nlohmann::json& j, const WriterOptions& opts) {
     if (opts.user_metadata_base64) {
         j["user_metadata_base64"] = *opts.user_metadata_base64;
     }
+    if (opts.adaptive_zstd) {
+        j["adaptive_zstd"] = *opts.adaptive_zstd;
+    }
+    if (opts.hash_algorithm) {
+        j["hash_algorithm"] = magic_enum::enum_name(*opts.hash_algorithm);
+    }
+    if (opts.hash_parallel_threshold) {
+        j["hash_parallel_threshold"] = *opts.hash_parallel_threshold;
+    }
+    if (opts.write_buffer_size) {
+        j["write_buffer_size"] = *opts.write_buffer_size;
+    }
+    if (opts.preallocate_extent) {
+        j["preallocate_extent"] = *opts.preallocate_extent;
+    }
+    if (opts.durability) {
+        j["durability"] = *opts.durability;
+    }
+    if (opts.chunk_alignment) {
+        j["chunk_alignment"] = *opts.chunk_alignment;
+    }
+    if (opts.bitpack_index) {
+        j["bitpack_index"] = *opts.bitpack_index;
+    }
+}
+
+void from_json(const nlohmann::json& j, MmapConfig& config) {
+    config.populate = j.value<std::optional<bool>>("populate", std::nullopt);
+    config.huge_pages = j.value<std::optional<bool>>("huge_pages", std::nullopt);
+    config.lock_index = j.value<std::optional<bool>>("lock_index", std::nullopt);
+}
+
+void to_json(nlohmann::json& j, const MmapConfig& config) {
+    j = nlohmann::json::object();
+    if (config.populate) j["populate"] = *config.populate;
+    if (config.huge_pages) j["huge_pages"] = *config.huge_pages;
+    if (config.lock_index) j["lock_index"] = *config.lock_index;
 }
 
 void from_json(const nlohmann::json& j, BackendConfig& config) {
     config.type = get_required<std::string>(j, "type");
     config.mode = get_required<std::string>(j, "mode");
     config.path = j.value<std::optional<std::string>>("path", std::nullopt);
+    config.direct_io = j.value<std::optional<bool>>("direct_io", std::nullopt);
+    if (j.contains("access") && !j["access"].is_null()) {
+        storage::AccessHint access{};
+        enum_from_json(j["access"], access);
+        config.access = access;
+    }
+    config.mmap = j.value<std::optional<MmapConfig>>("mmap", std::nullopt);
 }
 
 void to_json(nlohmann::json& j, const BackendConfig& config) {
@@ -149,6 +338,15 @@ void to_json(nlohmann::json& j, const BackendConfig& config) {
     if (config.path) {
         j["path"] = *config.path;
     }
+    if (config.direct_io) {
+        j["direct_io"] = *config.direct_io;
+    }
+    if (config.access) {
+        j["access"] = magic_enum::enum_name(*config.access);
+    }
+    if (config.mmap) {
+        j["mmap"] = *config.mmap;
+    }
 }
 
 void from_json(const nlohmann::json& j, ContextConfig& config) {
@@ -221,6 +419,7 @@ INSTANTIATE_FROM_JSON(StoreChunkRequest) INSTANTIATE_FROM_JSON(StoreArrayRequest
 INSTANTIATE_FROM_JSON(LoadChunksRequest) INSTANTIATE_FROM_JSON(InspectRequest)
 INSTANTIATE_FROM_JSON(GetUserMetadataRequest) INSTANTIATE_FROM_JSON(SetUserMetadataRequest)
 INSTANTIATE_FROM_JSON(FlushRequest) INSTANTIATE_FROM_JSON(PingRequest)
+INSTANTIATE_FROM_JSON(AdviseRequest) INSTANTIATE_FROM_JSON(VerifyRequest)
 INSTANTIATE_FROM_JSON(WriterOptions)
 INSTANTIATE_FROM_JSON(BackendConfig)
 INSTANTIATE_FROM_JSON(ContextConfig)
@@ -237,6 +436,7 @@ INSTANTIATE_TO_JSON(StoreChunkResponse) INSTANTIATE_TO_JSON(StoreArrayResponse)
 INSTANTIATE_TO_JSON(LoadChunksResponse) INSTANTIATE_TO_JSON(InspectResponse)
 INSTANTIATE_TO_JSON(GetUserMetadataResponse) INSTANTIATE_TO_JSON(SetUserMetadataResponse)
 INSTANTIATE_TO_JSON(FlushResponse) INSTANTIATE_TO_JSON(PingResponse)
+INSTANTIATE_TO_JSON(AdviseResponse) INSTANTIATE_TO_JSON(VerifyResponse)
 INSTANTIATE_TO_JSON(WriterOptions)
 INSTANTIATE_TO_JSON(BackendConfig)
 INSTANTIATE_TO_JSON(ContextConfig)
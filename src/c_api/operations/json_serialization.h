@@ -10,13 +10,13 @@ namespace cryptodd::ffi {
 // Forward declare all request/response types so this header remains lightweight.
 struct StoreChunkRequest; struct StoreArrayRequest; struct LoadChunksRequest;
 struct InspectRequest; struct GetUserMetadataRequest; struct SetUserMetadataRequest;
-struct FlushRequest; struct PingRequest;
+struct FlushRequest; struct PingRequest; struct AdviseRequest; struct VerifyRequest;
 struct WriterOptions;
 struct BackendConfig; struct ContextConfig;
 
 struct StoreChunkResponse; struct StoreArrayResponse; struct LoadChunksResponse;
 struct InspectResponse; struct GetUserMetadataResponse; struct SetUserMetadataResponse;
-struct FlushResponse; struct PingResponse;
+struct FlushResponse; struct PingResponse; struct AdviseResponse; struct VerifyResponse;
 
 // Generic deserializer from a JSON object to a strongly-typed request struct.
 // It catches parsing/validation exceptions and converts them to ExpectedError.
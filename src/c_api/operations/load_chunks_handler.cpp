@@ -4,11 +4,14 @@
 #include "../../data_io/data_reader.h"
 #include "../../data_io/data_extractor.h"
 #include "../../file_format/cdd_file_format.h"
+#include "../../file_format/chunk_hash.h"
+#include "../../codecs/codec_constants.h"
 
 #include <numeric>
 #include <variant>
 #include <cstring>
 #include <algorithm> // For std::all_of
+#include <optional>
 
 namespace cryptodd::ffi {
 
@@ -54,6 +57,28 @@ std::expected<LoadChunksResponse, ExpectedError> LoadChunksHandler::execute_type
         return response;
     }
 
+    using storage::AccessHint;
+    // A per-request hint holds until the request is served, however it ends; the reader's own then applies again.
+    struct HintOverride {
+        cryptodd::DataReader& reader;
+        ~HintOverride() { (void)reader.advise(reader.access_hint()); }
+    };
+    std::optional<HintOverride> hint_override;
+    if (request.access) {
+        if (auto advised = reader.advise(*request.access); !advised) return std::unexpected(ExpectedError(advised.error()));
+        hint_override.emplace(reader);
+    }
+
+    // WILLNEED for the chunks coming next, refilled once half of them are read, so the device works on the next reads
+    // while this one completes instead of serving one synchronous read at a time. Every chunk is read before any is
+    // decoded (the output size is checked first), so this overlaps reads with reads, not with decoding. Random
+    // lookups would only pull in bytes nobody reads.
+    const auto access = request.access.value_or(reader.access_hint());
+    const size_t prefetch = request.prefetch_chunks.value_or(
+        access == AccessHint::RANDOM || indices_to_load.size() < 2 ? 0 : DEFAULT_PREFETCH_CHUNKS);
+    size_t prefetched_until = 0; // position in indices_to_load
+    size_t prefetched_chunks = 0;
+
     size_t total_decoded_size = 0;
     std::vector<std::unique_ptr<Chunk>> chunks;
     chunks.reserve(indices_to_load.size());
@@ -63,10 +88,24 @@ std::expected<LoadChunksResponse, ExpectedError> LoadChunksHandler::execute_type
     bool compatible_shapes = true;
     int64_t sum_first_dim = 0;
 
-    for (const auto index : indices_to_load) {
+    for (size_t position = 0; position < indices_to_load.size(); ++position) {
+        const auto index = indices_to_load[position];
         if (index >= reader.num_chunks()) {
              return std::unexpected(ExpectedError("Chunk index " + std::to_string(index) + " is out of bounds."));
         }
+        // The chunk read now is read right away; only those after it gain from being hinted.
+        if (prefetch > 0 && prefetched_until < indices_to_load.size() && prefetched_until <= position + 1 + prefetch / 2) {
+            const size_t from = std::max(prefetched_until, position + 1);
+            const size_t to = std::min(indices_to_load.size(), position + 1 + prefetch);
+            std::vector<size_t> ahead;
+            for (size_t p = from; p < to; ++p) {
+                if (indices_to_load[p] < reader.num_chunks()) ahead.push_back(indices_to_load[p]);
+            }
+            auto advised = reader.prefetch_chunks(ahead);
+            if (!advised) return std::unexpected(ExpectedError(advised.error()));
+            prefetched_chunks += *advised;
+            prefetched_until = to;
+        }
         auto chunk_result = reader.get_chunk(index);
         if (!chunk_result) return std::unexpected(ExpectedError(chunk_result.error()));
         
@@ -109,13 +148,21 @@ std::expected<LoadChunksResponse, ExpectedError> LoadChunksHandler::execute_type
 
     size_t current_offset = 0;
     for (auto& chunk : chunks) {
-        const auto check_hash = request.check_checksums.value_or(!chunk->has_flag(ChunkFlags::SKIP_HASH_CHECK));
+        const ChunkFlags flags = chunk->flags();
+        const auto check_hash = chunk_has_hash(flags) && request.check_checksums.value_or(!chunk->has_flag(ChunkFlags::SKIP_HASH_CHECK));
         std::optional<blake3_hash256_t> hash = std::nullopt;
         if (check_hash && chunk->has_flag(ChunkFlags::RECONSTRUCTION_NOT_PERFECT))
         {
-            hash = calculate_blake3_hash256(chunk->data());
+            hash = calculate_chunk_hash(chunk->data(), flags);
         }
-        auto buffer_result = extractor.read_chunk(*chunk);
+        // Lossless chunks are hashed as they are reconstructed when the codec works block by block, otherwise
+        // block by block as they are copied out, so their bytes are read from memory once. Tree hashes keep
+        // their own parallel pass.
+        const bool stream_hash = check_hash && !hash && !hasFlag(flags, ChunkFlags::HASH_BLAKE3_TREE);
+        ChunkHasher decoded_hasher(flags);
+        auto buffer_result = stream_hash
+            ? extractor.read_chunk(*chunk, [&decoded_hasher](const std::span<const std::byte> block) { decoded_hasher.update(block); })
+            : extractor.read_chunk(*chunk);
         if (!buffer_result) return std::unexpected(ExpectedError(buffer_result.error().to_string()));
         
         auto decoded_span = (*buffer_result)->as_bytes();
@@ -130,23 +177,39 @@ std::expected<LoadChunksResponse, ExpectedError> LoadChunksHandler::execute_type
             ));
         }
 
+        bool copied = false;
+        if (stream_hash && decoded_hasher.size() != decoded_span.size())
+        {
+            decoded_hasher = ChunkHasher(flags);
+            for (size_t offset = 0; offset < decoded_span.size(); offset += codecs::ShuffleBlock::TARGET_BLOCK_BYTES)
+            {
+                const auto block = decoded_span.subspan(offset, std::min(codecs::ShuffleBlock::TARGET_BLOCK_BYTES, decoded_span.size() - offset));
+                decoded_hasher.update(block);
+                std::memcpy(output_data.data() + current_offset + offset, block.data(), block.size());
+            }
+            copied = true;
+        }
         if (check_hash)
         {
             if (!hash)
             {
-                hash = calculate_blake3_hash256(decoded_span);
+                hash = stream_hash ? decoded_hasher.finalize() : calculate_chunk_hash(decoded_span, flags);
             }
             if (hash.value() != chunk->hash())
             {
                 return std::unexpected(ExpectedError("Checksum mismatch for chunk at offset " + std::to_string(current_offset) + "."));
             }
         }
-        std::memcpy(output_data.data() + current_offset, decoded_span.data(), decoded_span.size());
+        if (!copied)
+        {
+            std::memcpy(output_data.data() + current_offset, decoded_span.data(), decoded_span.size());
+        }
         current_offset += decoded_span.size();
     }
     
     response.client_key = request.client_key;
     response.bytes_written_to_output = current_offset;
+    if (prefetch > 0) response.prefetched_chunks = prefetched_chunks;
 
     if (compatible_shapes && first_dtype.has_value()) {
         std::vector<int64_t> final_shape;
@@ -7,6 +7,9 @@
 namespace cryptodd::ffi {
 class LoadChunksHandler final : public IOperationHandler {
 public:
+    // Chunks of a selection prefetched ahead of the one being read, unless the request says otherwise.
+    static constexpr size_t DEFAULT_PREFETCH_CHUNKS = 4;
+
     std::expected<nlohmann::json, ExpectedError> execute(
         CddContext& context, const nlohmann::json& op_request,
         std::span<const std::byte> input_data, std::span<std::byte> output_data) override;
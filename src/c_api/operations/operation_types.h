@@ -1,6 +1,10 @@
 #pragma once
 
 #include "../file_format/cdd_file_format.h"
+#include "../../codecs/zstd_compressor.h"
+#include "../../file_format/chunk_hash.h"
+#include "../../data_io/group_commit.h"
+#include "../../storage/i_storage_backend.h"
 #include <cstddef>
 #include <cstdint>
 #include <optional>
@@ -41,6 +45,27 @@ struct EncodingSpec {
     ChunkDataType codec;
     std::vector<std::string> flags;
     std::optional<int> zstd_level;
+    // Lets the context's level controller pick the level (see WriterOptions::adaptive_zstd); excludes zstd_level.
+    // Rejected for codecs without a zstd stage (RAW, TEMPORAL_1D_CHIMP_*, TEMPORAL_1D_SIMD_I64_DELTA_BITPACK).
+    std::optional<bool> zstd_adaptive;
+    std::optional<int> num_frames; // > 1 splits the chunk into independently encoded row ranges (ChunkFlags::MULTI_FRAME).
+    // Advanced zstd parameters, ZSTD_COMPRESSED only (see ZstdCompressor::Params).
+    std::optional<int> zstd_workers;
+    std::optional<bool> zstd_long_distance_matching;
+    std::optional<int> zstd_window_log;
+    std::optional<ZstdStrategy> zstd_strategy;
+    // Tick size per column (Temporal 2D) or feature (orderbook), or a single one for all; *_FIXED_POINT_* codecs only.
+    std::optional<std::vector<double>> tick_sizes;
+    // Maximum absolute error per column, or a single one for all; *_QUANTIZED_* codecs only.
+    std::optional<std::vector<double>> error_bounds;
+    // Makes error_bounds a fraction of each column's largest magnitude within the chunk (or frame).
+    std::optional<bool> relative_error_bound;
+    // Overrides the writer's hash algorithm (see WriterOptions::hash_algorithm) for this chunk.
+    std::optional<HashAlgorithm> hash_algorithm;
+
+    [[nodiscard]] bool has_advanced_zstd_params() const {
+        return zstd_workers || zstd_long_distance_matching || zstd_window_log || zstd_strategy;
+    }
 };
 
 struct ByCountChunking {
@@ -64,6 +89,7 @@ struct ChunkWriteDetails {
     int64_t original_size;
     int64_t compressed_size;
     float compression_ratio;
+    int zstd_level; // the level actually used, which the adaptive controller may have chosen
 };
 
 struct StoreChunkResponse : OperationResponseBase {
@@ -97,11 +123,19 @@ using ChunkSelection = std::variant<AllSelection, IndicesSelection, RangeSelecti
 struct LoadChunksRequest : OperationRequestBase {
     ChunkSelection selection;
     std::optional<bool> check_checksums{};
+    // Overrides the reader's access hint (BackendConfig::access) while this request is served. SEQUENTIAL and RANDOM
+    // only take effect on a reader opened with one of them or memory-mapped: on one opened NORMAL (or WILLNEED) only
+    // WILLNEED does, and under direct_io none does.
+    std::optional<storage::AccessHint> access;
+    // How many chunks of the selection to keep prefetching (WILLNEED) ahead of the one being read; 0 disables it.
+    // Defaults to LoadChunksHandler::DEFAULT_PREFETCH_CHUNKS, or 0 under a RANDOM hint or for a single chunk.
+    std::optional<size_t> prefetch_chunks;
 };
 
 struct LoadChunksResponse : OperationResponseBase {
     size_t bytes_written_to_output{};
     std::optional<std::vector<int64_t>> final_shape;
+    std::optional<size_t> prefetched_chunks; // chunks whose WILLNEED hint reached the OS before they were read
     OperationMetadata metadata{};
 };
 
@@ -130,6 +164,7 @@ struct InspectResponse : OperationResponseBase {
     FileHeaderInfo file_header;
     size_t total_chunks;
     std::vector<ChunkSummary> chunk_summaries;
+    std::optional<std::string> index_lock_error; // why mmap.lock_index left the index unlocked (DataReader::index_lock_error)
     OperationMetadata metadata{};
 };
 
@@ -150,8 +185,22 @@ struct SetUserMetadataResponse : OperationResponseBase {
 
 // --- Flush ---
 struct FlushRequest : OperationRequestBase {};
+// Group commit statistics of the device holding the file (see DeviceSyncStats); latencies in microseconds.
+struct SyncStatsInfo {
+    uint64_t requests;
+    uint64_t batches;
+    uint64_t syncs;
+    uint64_t failures;
+    double mean_us;
+    uint64_t p50_us;
+    uint64_t p99_us;
+    uint64_t max_us;
+    std::vector<uint64_t> latency_buckets; // see SyncLatencyHistogram::buckets
+};
+
 struct FlushResponse : OperationResponseBase {
     std::string status;
+    std::optional<SyncStatsInfo> sync_stats; // once the writer has synced a file (durability other than NONE)
     OperationMetadata metadata{};
 };
 
@@ -162,15 +211,98 @@ struct PingResponse : OperationResponseBase {
     OperationMetadata metadata{};
 };
 
+// --- Advise ---
+struct AdviseRequest : OperationRequestBase {
+    DataSpec data_spec;
+    std::optional<bool> trial_compress;
+    std::optional<size_t> trial_rows;
+    std::optional<int> zstd_level;
+};
+
+struct CodecAdvice {
+    ChunkDataType codec;
+    double estimated_ratio;
+    double estimated_throughput_mbps;
+    bool measured;
+};
+
+struct AdviseResponse : OperationResponseBase {
+    std::vector<CodecAdvice> recommendations;
+    double xor_significant_bits;
+    double unchanged_fraction;
+    double raw_entropy_bits;
+    OperationMetadata metadata{};
+};
+
+// --- Verify ---
+struct VerifyRequest : OperationRequestBase {
+    std::optional<double> max_read_mbps;
+    std::optional<size_t> max_in_flight;
+};
+
+struct ChunkFaultInfo {
+    size_t index;
+    std::string reason;
+};
+
+struct VerifyResponse : OperationResponseBase {
+    bool ok;
+    size_t chunks_verified;
+    size_t chunks_unhashed;
+    size_t index_blocks;
+    uint64_t bytes_read;
+    uint64_t raw_bytes;
+    std::vector<ChunkFaultInfo> faults; // sorted by chunk index
+    std::optional<std::string> index_error;
+    double elapsed_s;
+    double read_mbps;
+    OperationMetadata metadata{};
+};
+
+// Targets of the adaptive zstd level (see AdaptiveLevelOptions); unset fields keep its defaults.
+struct AdaptiveZstdOptions {
+    std::optional<int> min_level;
+    std::optional<int> max_level;
+    std::optional<int> initial_level;
+    std::optional<double> target_mbps;
+    std::optional<double> max_latency_ms;
+};
+
+// When appended chunks are synced to the device (see DurabilityMode); unset fields keep DurabilityOptions' defaults.
+struct DurabilityConfig {
+    DurabilityMode mode;
+    std::optional<size_t> every_chunks;
+    std::optional<int64_t> interval_ms;
+};
+
 struct WriterOptions {
     std::optional<size_t> chunk_offsets_block_capacity;
     std::optional<std::string> user_metadata_base64;
+    std::optional<AdaptiveZstdOptions> adaptive_zstd;
+    std::optional<HashAlgorithm> hash_algorithm; // default chunk hash, BLAKE3_256 if unset
+    std::optional<size_t> hash_parallel_threshold; // BLAKE3 chunks this large are tree-hashed in parallel
+    std::optional<size_t> write_buffer_size; // bytes staged before writing out (File backend); 0 writes through
+    std::optional<uint64_t> preallocate_extent; // disk space reserved ahead of the data (File backend); 0 disables
+    std::optional<DurabilityConfig> durability;
+    std::optional<uint32_t> chunk_alignment; // chunks start at multiples of this power of two; 0 packs them
+    std::optional<bool> bitpack_index; // see FileWriterOptions::bitpack_index
+};
+
+// File backend in Read mode: read through a memory mapping of the file instead of read calls.
+struct MmapConfig {
+    std::optional<bool> populate;   // fault the whole file in when it is mapped (see storage::MapOptions)
+    std::optional<bool> huge_pages; // MADV_HUGEPAGE
+    // mlock the header and the chunk index, as far as RLIMIT_MEMLOCK allows; Inspect reports a refusal.
+    std::optional<bool> lock_index;
 };
 
 struct BackendConfig {
     std::string type;
     std::string mode;
     std::optional<std::string> path;
+    std::optional<bool> direct_io; // File backend: read or write around the page cache (O_DIRECT)
+    std::optional<storage::AccessHint> access; // Read mode: how the file will be read (see FileReaderOptions::access)
+    std::optional<MmapConfig> mmap;
 };
 
 struct ContextConfig {
@@ -1,7 +1,6 @@
 #include "../operations/store_chunk_handler.h"
 #include "../operations/json_serialization.h"
 #include "../operations/store_utils.h"
-#include "../../codecs/zstd_compressor.h" // For ZstdCompressor::DEFAULT_COMPRESSION_LEVEL
 #include "../../file_format/cdd_file_format.h" // For get_dtype_size
 #include "../../data_io/data_writer.h" // For DataWriter
 #include <numeric> // For std::accumulate
@@ -45,7 +44,7 @@ std::expected<StoreChunkResponse, ExpectedError> StoreChunkHandler::execute_type
     response.client_key = request.client_key;
     response.details = *result;
     response.shape = request.data_spec.shape;
-    response.zstd_level = request.encoding.zstd_level.value_or(cryptodd::ZstdCompressor::DEFAULT_COMPRESSION_LEVEL);
+    response.zstd_level = result->zstd_level;
     // Metadata will be injected at the C API layer
 
     return response;
@@ -8,8 +8,10 @@
 #include "../../codecs/zstd_compressor.h"
 #include "../../data_io/data_writer.h"
 #include "../../data_io/data_compressor.h"
+#include "../../data_io/chunk_frames.h"
 #include "../../file_format/cdd_file_format.h" // For get_dtype_size
 #include "../file_format/blake3_stream_hasher.h"
+#include "../../file_format/chunk_hash.h"
 
 namespace cryptodd::ffi::StoreUtils {
 
@@ -29,6 +31,22 @@ namespace cryptodd::ffi::StoreUtils {
                 return true;
             }
         }
+
+        // Codecs that never run zstd: an adaptive level would be recorded for nothing, and their throughput would
+        // steer the level of the chunks that do.
+        constexpr bool has_zstd_stage(const ChunkDataType datatype)
+        {
+            switch (datatype)
+            {
+            case ChunkDataType::RAW:
+            case ChunkDataType::TEMPORAL_1D_CHIMP_F32:
+            case ChunkDataType::TEMPORAL_1D_CHIMP_F64:
+            case ChunkDataType::TEMPORAL_1D_SIMD_I64_DELTA_BITPACK:
+                return false;
+            default:
+                return true;
+            }
+        }
     }
 
 std::expected<ChunkWriteDetails, ExpectedError> compress_and_write_chunk(
@@ -65,87 +83,225 @@ std::expected<ChunkWriteDetails, ExpectedError> compress_and_write_chunk(
 
     direct_hash = !hasFlag(flags, ChunkFlags::RECONSTRUCTION_NOT_PERFECT);
 
-    const int zstd_level = encoding_spec.zstd_level.value_or(ZstdCompressor::DEFAULT_COMPRESSION_LEVEL);
+    const bool zstd_adaptive = encoding_spec.zstd_adaptive.value_or(false);
+    if (zstd_adaptive && encoding_spec.zstd_level) {
+        return std::unexpected(ExpectedError("zstd_level and zstd_adaptive cannot be combined."));
+    }
+    if (zstd_adaptive && !has_zstd_stage(codec)) {
+        return std::unexpected(ExpectedError("zstd_adaptive is not supported with the " + std::string(magic_enum::enum_name(codec)) + " codec, which has no zstd stage."));
+    }
+    // The adaptive level is only known once the chunk is encoded; it is read back from the chunk flags.
+    const int zstd_level = zstd_adaptive ? DataCompressor::ADAPTIVE_LEVEL : encoding_spec.zstd_level.value_or(ZstdCompressor::DEFAULT_COMPRESSION_LEVEL);
+    int used_zstd_level = zstd_adaptive ? ZstdCompressor::DEFAULT_COMPRESSION_LEVEL : zstd_level;
+    const int num_frames = encoding_spec.num_frames.value_or(1);
+    if (encoding_spec.has_advanced_zstd_params() && codec != ChunkDataType::ZSTD_COMPRESSED) {
+        return std::unexpected(ExpectedError("Advanced zstd parameters are only supported with the ZSTD_COMPRESSED codec."));
+    }
+    const std::span<const double> tick_sizes = encoding_spec.tick_sizes ? std::span<const double>(*encoding_spec.tick_sizes) : std::span<const double>{};
+    const std::span<const double> error_bounds = encoding_spec.error_bounds ? std::span<const double>(*encoding_spec.error_bounds) : std::span<const double>{};
+    const bool relative_error_bound = encoding_spec.relative_error_bound.value_or(false);
+    HashOptions hash_options = context.get_hash_options();
+    hash_options.algorithm = encoding_spec.hash_algorithm.value_or(hash_options.algorithm);
 
     DataCompressor& compressor = context.get_compressor();
     
     std::expected<size_t, std::string> append_result;
     size_t compressed_size = 0;
     size_t original_size = chunk_input_data.size();
-    blake3_hash256_t raw_data_hash = direct_hash ? calculate_blake3_hash256(chunk_input_data) : blake3_hash256_t{};
+    // Lossless chunks hash the input, the others their payload; the algorithm is recorded in the chunk flags.
+    // Codecs that encode block by block feed the input to `input_hasher` while it is in cache, saving a pass
+    // over it. Tree hashes keep their own parallel pass.
+    const ChunkFlags input_hash_flags = hash_flags(hash_options, chunk_input_data.size());
+    ChunkHasher input_hasher(input_hash_flags);
+    codecs::BlockVisitor hash_input_block;
+    if (direct_hash && !hasFlag(input_hash_flags, ChunkFlags::HASH_BLAKE3_TREE)) {
+        hash_input_block = [&input_hasher](const std::span<const std::byte> block) { input_hasher.update(block); };
+    }
+    const auto hash_chunk = [&](const std::span<const std::byte> hashed) {
+        flags |= hash_flags(hash_options, hashed.size());
+        const bool fused = hash_input_block && hashed.data() == chunk_input_data.data() && input_hasher.size() == hashed.size();
+        return fused ? input_hasher.finalize() : calculate_chunk_hash(hashed, flags);
+    };
+    blake3_hash256_t raw_data_hash{};
 
     if (codec != ChunkDataType::RAW) {
         std::remove_reference_t<decltype(compressor)>::ChunkResult chunk_result;
-        switch (codec) {
-            case ChunkDataType::ZSTD_COMPRESSED:
-                chunk_result = compressor.compress_zstd(chunk_input_data, data_spec.shape, data_spec.dtype, zstd_level);
-                flags |= ChunkFlags::ZSTD;
-                break;
-            case ChunkDataType::TEMPORAL_1D_SIMD_F16_XOR_SHUFFLE_AS_F32:
-            case ChunkDataType::TEMPORAL_1D_SIMD_F32_XOR_SHUFFLE:
-                {
-                    if (data_spec.dtype != DType::FLOAT32) return std::unexpected(ExpectedError("This codec requires FLOAT32 dtype."));
-                    auto data_span = std::span(reinterpret_cast<const float*>(chunk_input_data.data()), chunk_input_data.size() / sizeof(float));
-                    chunk_result = compressor.compress_chunk(data_span, codec, 0.0f, zstd_level);
-                    break;
-                }
-            case ChunkDataType::TEMPORAL_1D_SIMD_I64_XOR:
-            case ChunkDataType::TEMPORAL_1D_SIMD_I64_DELTA:
-                {
-                    if (data_spec.dtype != DType::INT64) return std::unexpected(ExpectedError("This codec requires INT64 dtype."));
-                    auto data_span = std::span(reinterpret_cast<const int64_t*>(chunk_input_data.data()), chunk_input_data.size() / sizeof(int64_t));
-                    chunk_result = compressor.compress_chunk(data_span, codec, 0, zstd_level);
-                    break;
-                }
-            case ChunkDataType::OKX_OB_SIMD_F16_AS_F32: case ChunkDataType::BINANCE_OB_SIMD_F16_AS_F32: case ChunkDataType::GENERIC_OB_SIMD_F16_AS_F32:
-            case ChunkDataType::TEMPORAL_2D_SIMD_F16_AS_F32: case ChunkDataType::OKX_OB_SIMD_F32: case ChunkDataType::BINANCE_OB_SIMD_F32:
-            case ChunkDataType::GENERIC_OB_SIMD_F32: case ChunkDataType::TEMPORAL_2D_SIMD_F32:
-                {
-                    if (data_spec.dtype != DType::FLOAT32) return std::unexpected(ExpectedError("This codec requires FLOAT32 dtype."));
-                    auto data_span = std::span(reinterpret_cast<const float*>(chunk_input_data.data()), chunk_input_data.size() / sizeof(float));
+        if (num_frames > 1 && codec != ChunkDataType::ZSTD_COMPRESSED) {
+            const auto geometry = chunk_frames::row_geometry(codec, data_spec.shape);
+            if (!geometry) return std::unexpected(ExpectedError(geometry.error()));
+            if (data_spec.dtype != geometry->dtype) {
+                return std::unexpected(ExpectedError(std::string("This codec requires ") + std::string(magic_enum::enum_name(geometry->dtype)) + " dtype."));
+            }
+            const auto zero_state = context.get_zero_state(geometry->row_bytes());
+            chunk_result = compressor.compress_chunk_frames(chunk_input_data, codec, data_spec.shape, zero_state, static_cast<size_t>(num_frames), zstd_level, tick_sizes,
+                                                         error_bounds, relative_error_bound);
+        } else {
+            switch (codec) {
+                case ChunkDataType::ZSTD_COMPRESSED:
+                    {
+                        ZstdCompressor::Params params;
+                        params.level = zstd_level;
+                        params.workers = encoding_spec.zstd_workers.value_or(0);
+                        params.long_distance_matching = encoding_spec.zstd_long_distance_matching.value_or(false);
+                        params.window_log = encoding_spec.zstd_window_log.value_or(0);
+                        params.strategy = encoding_spec.zstd_strategy.value_or(ZstdStrategy::DEFAULT);
+                        chunk_result = compressor.compress_zstd(chunk_input_data, data_spec.shape, data_spec.dtype, params);
+                        flags |= ChunkFlags::ZSTD;
+                        break;
+                    }
+                case ChunkDataType::TEMPORAL_1D_SIMD_F16_XOR_SHUFFLE_AS_F32:
+                case ChunkDataType::TEMPORAL_1D_SIMD_F32_XOR_SHUFFLE:
+                    {
+                        if (data_spec.dtype != DType::FLOAT32) return std::unexpected(ExpectedError("This codec requires FLOAT32 dtype."));
+                        auto data_span = std::span(reinterpret_cast<const float*>(chunk_input_data.data()), chunk_input_data.size() / sizeof(float));
+                        chunk_result = compressor.compress_chunk(data_span, codec, 0.0f, zstd_level, hash_input_block);
+                        break;
+                    }
+                case ChunkDataType::TEMPORAL_1D_CHIMP_F32:
+                    {
+                        if (data_spec.dtype != DType::FLOAT32) return std::unexpected(ExpectedError("This codec requires FLOAT32 dtype."));
+                        auto data_span = std::span(reinterpret_cast<const float*>(chunk_input_data.data()), chunk_input_data.size() / sizeof(float));
+                        chunk_result = compressor.compress_chunk(data_span, codec, 0.0f, zstd_level);
+                        break;
+                    }
+                case ChunkDataType::TEMPORAL_1D_CHIMP_F64:
+                case ChunkDataType::TEMPORAL_1D_SIMD_F64_XOR_SHUFFLE:
+                    {
+                        if (data_spec.dtype != DType::FLOAT64) return std::unexpected(ExpectedError("This codec requires FLOAT64 dtype."));
+                        auto data_span = std::span(reinterpret_cast<const double*>(chunk_input_data.data()), chunk_input_data.size() / sizeof(double));
+                        chunk_result = compressor.compress_chunk(data_span, codec, 0.0, zstd_level, hash_input_block);
+                        break;
+                    }
+                case ChunkDataType::TEMPORAL_1D_SIMD_I64_XOR:
+                case ChunkDataType::TEMPORAL_1D_SIMD_I64_DELTA:
+                case ChunkDataType::TEMPORAL_1D_SIMD_I64_DELTA_BITPACK:
+                case ChunkDataType::TEMPORAL_1D_SIMD_I64_DELTA_BITPACK_ZSTD:
+                case ChunkDataType::TEMPORAL_1D_SIMD_I64_DOUBLE_DELTA:
+                    {
+                        if (data_spec.dtype != DType::INT64) return std::unexpected(ExpectedError("This codec requires INT64 dtype."));
+                        auto data_span = std::span(reinterpret_cast<const int64_t*>(chunk_input_data.data()), chunk_input_data.size() / sizeof(int64_t));
+                        chunk_result = compressor.compress_chunk(data_span, codec, 0, zstd_level);
+                        break;
+                    }
+                case ChunkDataType::OKX_OB_SIMD_F16_AS_F32: case ChunkDataType::BINANCE_OB_SIMD_F16_AS_F32: case ChunkDataType::GENERIC_OB_SIMD_F16_AS_F32:
+                case ChunkDataType::TEMPORAL_2D_SIMD_F16_AS_F32: case ChunkDataType::OKX_OB_SIMD_F32: case ChunkDataType::BINANCE_OB_SIMD_F32:
+                case ChunkDataType::GENERIC_OB_SIMD_F32: case ChunkDataType::TEMPORAL_2D_SIMD_F32:
+                case ChunkDataType::GENERIC_OB_SIMD_BFP16_AS_F32: case ChunkDataType::GENERIC_OB_SIMD_SPARSE_F32:
+                    {
+                        if (data_spec.dtype != DType::FLOAT32) return std::unexpected(ExpectedError("This codec requires FLOAT32 dtype."));
+                        auto data_span = std::span(reinterpret_cast<const float*>(chunk_input_data.data()), chunk_input_data.size() / sizeof(float));
                     
-                    size_t prev_state_elements = (data_spec.shape.size() > 1) ? data_spec.shape[1] : 0;
-                    if (data_spec.shape.size() == 3) prev_state_elements *= data_spec.shape[2];
+                        size_t prev_state_elements = (data_spec.shape.size() > 1) ? data_spec.shape[1] : 0;
+                        if (data_spec.shape.size() == 3) prev_state_elements *= data_spec.shape[2];
                     
-                    const auto zero_state_bytes = context.get_zero_state(prev_state_elements * sizeof(float));
-                    const std::span<const float> prev_state(reinterpret_cast<const float*>(zero_state_bytes.data()), prev_state_elements);
-
-                    chunk_result = compressor.compress_chunk(data_span, codec, data_spec.shape, prev_state, zstd_level);
-                    break;
-                }
-            case ChunkDataType::TEMPORAL_2D_SIMD_I64:
-                {
-                    if (data_spec.dtype != DType::INT64) return std::unexpected(ExpectedError("This codec requires INT64 dtype."));
-                    auto data_span = std::span(reinterpret_cast<const int64_t*>(chunk_input_data.data()), chunk_input_data.size() / sizeof(int64_t));
-
-                    if (data_spec.shape.size() != 2) return std::unexpected(ExpectedError("TEMPORAL_2D_SIMD_I64 requires a 2D shape."));
-                    const size_t prev_state_elements = data_spec.shape[1];
-                    const auto zero_state_bytes = context.get_zero_state(prev_state_elements * sizeof(int64_t));
-                    const std::span<const int64_t> prev_state(reinterpret_cast<const int64_t*>(zero_state_bytes.data()), prev_state_elements);
-                    chunk_result = compressor.compress_chunk(data_span, codec, data_spec.shape, prev_state, zstd_level);
-                    break;
-                }
-            default:
-                return std::unexpected(ExpectedError("The specified codec is not RAW and not a supported compression type for writing."));
+                        const auto zero_state_bytes = context.get_zero_state(prev_state_elements * sizeof(float));
+                        const std::span<const float> prev_state(reinterpret_cast<const float*>(zero_state_bytes.data()), prev_state_elements);
+
+                        chunk_result = compressor.compress_chunk(data_span, codec, data_spec.shape, prev_state, zstd_level);
+                        break;
+                    }
+                case ChunkDataType::TEMPORAL_2D_SIMD_F64:
+                    {
+                        if (data_spec.dtype != DType::FLOAT64) return std::unexpected(ExpectedError("This codec requires FLOAT64 dtype."));
+                        auto data_span = std::span(reinterpret_cast<const double*>(chunk_input_data.data()), chunk_input_data.size() / sizeof(double));
+
+                        if (data_spec.shape.size() != 2) return std::unexpected(ExpectedError("Temporal 2D double codecs require a 2D shape."));
+                        const size_t prev_state_elements = data_spec.shape[1];
+                        const auto zero_state_bytes = context.get_zero_state(prev_state_elements * sizeof(double));
+                        const std::span<const double> prev_state(reinterpret_cast<const double*>(zero_state_bytes.data()), prev_state_elements);
+                        chunk_result = compressor.compress_chunk(data_span, codec, data_spec.shape, prev_state, zstd_level);
+                        break;
+                    }
+                case ChunkDataType::TEMPORAL_2D_SIMD_I64:
+                case ChunkDataType::TEMPORAL_2D_SIMD_I64_DOUBLE_DELTA:
+                case ChunkDataType::TEMPORAL_2D_SIMD_I64_DELTA:
+                case ChunkDataType::TEMPORAL_2D_SIMD_I64_DELTA_SHUFFLE:
+                    {
+                        if (data_spec.dtype != DType::INT64) return std::unexpected(ExpectedError("This codec requires INT64 dtype."));
+                        auto data_span = std::span(reinterpret_cast<const int64_t*>(chunk_input_data.data()), chunk_input_data.size() / sizeof(int64_t));
+
+                        if (data_spec.shape.size() != 2) return std::unexpected(ExpectedError("Temporal 2D int64 codecs require a 2D shape."));
+                        const size_t prev_state_elements = data_spec.shape[1];
+                        const auto zero_state_bytes = context.get_zero_state(prev_state_elements * sizeof(int64_t));
+                        const std::span<const int64_t> prev_state(reinterpret_cast<const int64_t*>(zero_state_bytes.data()), prev_state_elements);
+                        chunk_result = compressor.compress_chunk(data_span, codec, data_spec.shape, prev_state, zstd_level);
+                        break;
+                    }
+                case ChunkDataType::TEMPORAL_1D_FIXED_POINT_F32:
+                case ChunkDataType::TEMPORAL_2D_FIXED_POINT_F32:
+                case ChunkDataType::ORDERBOOK_FIXED_POINT_F32:
+                    {
+                        if (data_spec.dtype != DType::FLOAT32) return std::unexpected(ExpectedError("This codec requires FLOAT32 dtype."));
+                        auto data_span = std::span(reinterpret_cast<const float*>(chunk_input_data.data()), chunk_input_data.size() / sizeof(float));
+                        // Chunks that are off the tick grid come back with their float fallback codec as type.
+                        chunk_result = compressor.compress_fixed_point(data_span, codec, data_spec.shape, tick_sizes, {}, zstd_level);
+                        break;
+                    }
+                case ChunkDataType::TEMPORAL_1D_FIXED_POINT_F64:
+                case ChunkDataType::TEMPORAL_2D_FIXED_POINT_F64:
+                    {
+                        if (data_spec.dtype != DType::FLOAT64) return std::unexpected(ExpectedError("This codec requires FLOAT64 dtype."));
+                        auto data_span = std::span(reinterpret_cast<const double*>(chunk_input_data.data()), chunk_input_data.size() / sizeof(double));
+                        chunk_result = compressor.compress_fixed_point(data_span, codec, data_spec.shape, tick_sizes, {}, zstd_level);
+                        break;
+                    }
+                case ChunkDataType::TEMPORAL_1D_QUANTIZED_F32:
+                case ChunkDataType::TEMPORAL_2D_QUANTIZED_F32:
+                    {
+                        if (data_spec.dtype != DType::FLOAT32) return std::unexpected(ExpectedError("This codec requires FLOAT32 dtype."));
+                        auto data_span = std::span(reinterpret_cast<const float*>(chunk_input_data.data()), chunk_input_data.size() / sizeof(float));
+                        // Chunks that cannot be quantized come back with their lossless float fallback codec as type.
+                        chunk_result = compressor.compress_quantized(data_span, codec, data_spec.shape, error_bounds, relative_error_bound, {}, zstd_level);
+                        break;
+                    }
+                case ChunkDataType::TEMPORAL_1D_QUANTIZED_F64:
+                case ChunkDataType::TEMPORAL_2D_QUANTIZED_F64:
+                    {
+                        if (data_spec.dtype != DType::FLOAT64) return std::unexpected(ExpectedError("This codec requires FLOAT64 dtype."));
+                        auto data_span = std::span(reinterpret_cast<const double*>(chunk_input_data.data()), chunk_input_data.size() / sizeof(double));
+                        chunk_result = compressor.compress_quantized(data_span, codec, data_spec.shape, error_bounds, relative_error_bound, {}, zstd_level);
+                        break;
+                    }
+                default:
+                    return std::unexpected(ExpectedError("The specified codec is not RAW and not a supported compression type for writing."));
+            }
         }
         if (!chunk_result) return std::unexpected(ExpectedError(chunk_result.error().to_string()));
 
         auto& chunk = *chunk_result->get();
         compressed_size = chunk.data().size(); // Get size BEFORE data is moved inside append_chunk.
-        if (!direct_hash)
+        // The payload layout is decided by the codec, not by the caller's spec, so it must be carried over.
+        if (chunk.has_flag(ChunkFlags::BLOCKED_SHUFFLE))
+        {
+            flags |= ChunkFlags::BLOCKED_SHUFFLE;
+        }
+        if (chunk.has_flag(ChunkFlags::MULTI_FRAME))
         {
-            raw_data_hash = calculate_blake3_hash256(chunk.data());
+            flags |= ChunkFlags::MULTI_FRAME;
         }
+        if (chunk.has_flag(ChunkFlags::ZSTD_LONG_WINDOW))
+        {
+            flags |= ChunkFlags::ZSTD_LONG_WINDOW;
+        }
+        if (const auto recorded_level = chunk_zstd_level(chunk.flags()))
+        {
+            flags = with_zstd_level(flags, *recorded_level);
+            used_zstd_level = *recorded_level;
+        }
+        // Bounded-error codecs only know after encoding whether the chunk round-trips exactly.
+        if (chunk.has_flag(ChunkFlags::RECONSTRUCTION_BOUNDED))
+        {
+            flags |= ChunkFlags::RECONSTRUCTION_NOT_PERFECT | ChunkFlags::RECONSTRUCTION_BOUNDED;
+            direct_hash = false;
+        }
+        raw_data_hash = hash_chunk(direct_hash ? chunk_input_data : std::span<const std::byte>(chunk.data()));
         append_result = writer.append_chunk(chunk.type(), chunk.dtype(), flags, chunk.get_shape(), chunk, raw_data_hash);
     } else {
         // For raw data, a temporary chunk must be created to hold the data for the writer.
         Chunk temp_chunk;
         temp_chunk.set_data({chunk_input_data.begin(), chunk_input_data.end()});
         compressed_size = chunk_input_data.size();
-        if (!direct_hash)
-        {
-            raw_data_hash = calculate_blake3_hash256(temp_chunk.data());
-        }
+        raw_data_hash = hash_chunk(chunk_input_data);
         append_result = writer.append_chunk(codec, data_spec.dtype, flags, data_spec.shape, temp_chunk, raw_data_hash);
     }
 
@@ -157,7 +313,8 @@ std::expected<ChunkWriteDetails, ExpectedError> compress_and_write_chunk(
         .chunk_index = *append_result,
         .original_size = static_cast<int64_t>(original_size),
         .compressed_size = static_cast<int64_t>(compressed_size),
-        .compression_ratio = ratio
+        .compression_ratio = ratio,
+        .zstd_level = used_zstd_level
     };
 }
 
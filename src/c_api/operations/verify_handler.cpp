@@ -0,0 +1,55 @@
+#include "../operations/verify_handler.h"
+#include "../cdd_context.h"
+#include "../operations/json_serialization.h"
+#include "../../data_io/data_reader.h"
+#include "../../data_io/data_verifier.h"
+#include <nlohmann/json.hpp>
+
+namespace cryptodd::ffi {
+
+// The "Adapter"
+std::expected<nlohmann::json, ExpectedError> VerifyHandler::execute(
+    CddContext& context, const nlohmann::json& op_request, std::span<const std::byte>, std::span<std::byte>)
+{
+    auto request_result = from_json<VerifyRequest>(op_request);
+    if (!request_result) return std::unexpected(request_result.error());
+
+    auto response_result = execute_typed(context, *request_result);
+    if (!response_result) return std::unexpected(response_result.error());
+
+    return to_json(*response_result);
+}
+
+// The "Business Logic"
+std::expected<VerifyResponse, ExpectedError> VerifyHandler::execute_typed(CddContext& context, const VerifyRequest& request)
+{
+    auto reader_opt = context.get_reader();
+    if (!reader_opt) return std::unexpected(ExpectedError("Context is not in a readable mode."));
+
+    VerifyOptions options;
+    options.max_read_mbps = request.max_read_mbps.value_or(options.max_read_mbps);
+    options.max_in_flight = request.max_in_flight.value_or(options.max_in_flight);
+
+    // Corruption is reported in the response; only invalid options fail the operation.
+    auto report = verify_file(reader_opt.value().get(), options);
+    if (!report) return std::unexpected(ExpectedError("Verify failed: " + report.error()));
+
+    VerifyResponse response;
+    response.client_key = request.client_key;
+    response.ok = report->ok();
+    response.chunks_verified = report->chunks_verified;
+    response.chunks_unhashed = report->chunks_unhashed;
+    response.index_blocks = report->index_blocks;
+    response.bytes_read = report->bytes_read;
+    response.raw_bytes = report->raw_bytes;
+    response.index_error = report->index_error;
+    response.elapsed_s = report->elapsed_s;
+    response.read_mbps = report->read_mbps;
+    for (auto& fault : report->corrupted) {
+        response.faults.push_back({fault.index, std::move(fault.reason)});
+    }
+    // Metadata will be injected at the C API layer
+    return response;
+}
+
+} // namespace cryptodd::ffi
@@ -0,0 +1,375 @@
+#include "bitpack_simd_codec.h"
+
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "bitpack_simd_codec.cpp"
+#include "hwy/foreach_target.h"
+
+#include <hwy/highway.h>
+
+HWY_BEFORE_NAMESPACE();
+namespace cryptodd::HWY_NAMESPACE {
+
+namespace hn = hwy::HWY_NAMESPACE;
+
+// One lane per stream. Every SIMD width Highway can cap to divides codecs::BitPack::STREAMS, so a
+// group of streams is always a whole vector.
+inline constexpr hn::CappedTag<uint64_t, codecs::BitPack::STREAMS> du64_streams;
+
+inline constexpr uint64_t LowMask(const unsigned bits) {
+    return bits >= 64 ? ~uint64_t{0} : (uint64_t{1} << bits) - 1;
+}
+
+HWY_NOINLINE void PackBlock64(const uint64_t* HWY_RESTRICT values, const uint64_t base, const unsigned bit_width, uint64_t* HWY_RESTRICT out_words) {
+    if (bit_width == 0) return;
+    constexpr size_t S = codecs::BitPack::STREAMS;
+    const size_t lanes = hn::Lanes(du64_streams);
+    const auto v_base = hn::Set(du64_streams, base);
+    const auto v_mask = hn::Set(du64_streams, LowMask(bit_width));
+
+    for (size_t g = 0; g < S; g += lanes) {
+        auto acc = hn::Zero(du64_streams);
+        unsigned bit_pos = 0;
+        size_t word = 0;
+        for (size_t slot = 0; slot < codecs::BitPack::VALUES_PER_STREAM; ++slot) {
+            const auto v = hn::And(hn::Sub(hn::LoadU(du64_streams, values + slot * S + g), v_base), v_mask);
+            acc = hn::Or(acc, hn::ShiftLeftSame(v, static_cast<int>(bit_pos)));
+            bit_pos += bit_width;
+            if (bit_pos >= 64) {
+                hn::StoreU(acc, du64_streams, out_words + word * S + g);
+                ++word;
+                bit_pos -= 64;
+                // Carry the bits of `v` that did not fit into the word just written.
+                acc = bit_pos == 0 ? hn::Zero(du64_streams) : hn::ShiftRightSame(v, static_cast<int>(bit_width - bit_pos));
+            }
+        }
+    }
+}
+
+HWY_NOINLINE void UnpackBlock64(const uint64_t* HWY_RESTRICT words, const uint64_t base, const unsigned bit_width, uint64_t* HWY_RESTRICT out_values) {
+    constexpr size_t S = codecs::BitPack::STREAMS;
+    const size_t lanes = hn::Lanes(du64_streams);
+    const auto v_base = hn::Set(du64_streams, base);
+
+    if (bit_width == 0) {
+        for (size_t i = 0; i < codecs::BitPack::BLOCK_VALUES; i += lanes) {
+            hn::StoreU(v_base, du64_streams, out_values + i);
+        }
+        return;
+    }
+
+    const auto v_mask = hn::Set(du64_streams, LowMask(bit_width));
+    for (size_t g = 0; g < S; g += lanes) {
+        size_t word = 0;
+        auto cur = hn::LoadU(du64_streams, words + g);
+        unsigned bit_pos = 0;
+        for (size_t slot = 0; slot < codecs::BitPack::VALUES_PER_STREAM; ++slot) {
+            auto v = hn::ShiftRightSame(cur, static_cast<int>(bit_pos));
+            const unsigned end = bit_pos + bit_width;
+            if (end > 64) {
+                ++word;
+                cur = hn::LoadU(du64_streams, words + word * S + g);
+                v = hn::Or(v, hn::ShiftLeftSame(cur, static_cast<int>(64 - bit_pos)));
+                bit_pos = end - 64;
+            } else if (end == 64) {
+                ++word;
+                if (word < bit_width) cur = hn::LoadU(du64_streams, words + word * S + g);
+                bit_pos = 0;
+            } else {
+                bit_pos = end;
+            }
+            hn::StoreU(hn::Add(hn::And(v, v_mask), v_base), du64_streams, out_values + slot * S + g);
+        }
+    }
+}
+
+HWY_NOINLINE void ZigZagDeltaInt64_1D(const int64_t* HWY_RESTRICT data, uint64_t* HWY_RESTRICT out, size_t num_elements, int64_t prev_element) {
+    if (num_elements == 0) return;
+    const auto zigzag = [](const uint64_t delta) { return (delta << 1) ^ (0 - (delta >> 63)); };
+    out[0] = zigzag(static_cast<uint64_t>(data[0]) - static_cast<uint64_t>(prev_element));
+    size_t i = 1;
+#if HWY_TARGET != HWY_SCALAR
+    const hn::ScalableTag<int64_t> di64;
+    const hn::ScalableTag<uint64_t> du64;
+    const size_t lanes = hn::Lanes(di64);
+    for (; i + lanes <= num_elements; i += lanes) {
+        const auto v_delta = hn::Sub(hn::LoadU(di64, data + i), hn::LoadU(di64, data + i - 1));
+        const auto v_zigzag = hn::Xor(hn::ShiftLeft<1>(v_delta), hn::ShiftRight<63>(v_delta));
+        hn::StoreU(hn::BitCast(du64, v_zigzag), du64, out + i);
+    }
+#endif
+    for (; i < num_elements; ++i) {
+        out[i] = zigzag(static_cast<uint64_t>(data[i]) - static_cast<uint64_t>(data[i - 1]));
+    }
+}
+
+// `zigzag` and `out` may alias: every step loads its input before storing to the same index.
+HWY_NOINLINE void UnZigZagCumulativeSumInt64_1D(const uint64_t* zigzag, int64_t* out, size_t num_elements, int64_t& prev_element) {
+    if (num_elements == 0) return;
+    uint64_t current = static_cast<uint64_t>(prev_element);
+    size_t i = 0;
+
+#if HWY_TARGET != HWY_SCALAR
+    const hn::FixedTag<uint64_t, 2> du64_128;
+    const hn::FixedTag<int64_t, 2> di64_128;
+    const auto v_one = hn::Set(du64_128, 1);
+
+    for (; i + 2 <= num_elements; i += 2) {
+        const auto v_zigzag = hn::LoadU(du64_128, zigzag + i);
+        const auto v_delta = hn::Xor(hn::ShiftRight<1>(v_zigzag), hn::Neg(hn::BitCast(du64_128, hn::BitCast(di64_128, hn::And(v_zigzag, v_one)))));
+        const auto v_scan = hn::Add(v_delta, hn::SlideUpLanes(du64_128, v_delta, 1));
+        const auto v_recon = hn::Add(v_scan, hn::Set(du64_128, current));
+        hn::StoreU(hn::BitCast(di64_128, v_recon), di64_128, out + i);
+        current = hn::ExtractLane(v_recon, 1);
+    }
+#endif
+
+    for (; i < num_elements; ++i) {
+        const uint64_t z = zigzag[i];
+        current += (z >> 1) ^ (0 - (z & 1));
+        out[i] = static_cast<int64_t>(current);
+    }
+    prev_element = static_cast<int64_t>(current);
+}
+
+} // namespace cryptodd::HWY_NAMESPACE
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <format>
+#include "../memory/allocator.h"
+
+namespace cryptodd {
+
+namespace simd {
+    HWY_EXPORT(PackBlock64);
+    void PackBlock64_dispatcher(const uint64_t* values, uint64_t base, unsigned bit_width, uint64_t* out_words) {
+        HWY_DYNAMIC_DISPATCH(PackBlock64)(values, base, bit_width, out_words);
+    }
+
+    HWY_EXPORT(UnpackBlock64);
+    void UnpackBlock64_dispatcher(const uint64_t* words, uint64_t base, unsigned bit_width, uint64_t* out_values) {
+        HWY_DYNAMIC_DISPATCH(UnpackBlock64)(words, base, bit_width, out_values);
+    }
+
+    HWY_EXPORT(ZigZagDeltaInt64_1D);
+    void ZigZagDeltaInt64_1D_dispatcher(const int64_t* data, uint64_t* out, size_t num_elements, int64_t prev_element) {
+        HWY_DYNAMIC_DISPATCH(ZigZagDeltaInt64_1D)(data, out, num_elements, prev_element);
+    }
+
+    HWY_EXPORT(UnZigZagCumulativeSumInt64_1D);
+    void UnZigZagCumulativeSumInt64_1D_dispatcher(const uint64_t* zigzag, int64_t* out, size_t num_elements, int64_t& prev_element) {
+        HWY_DYNAMIC_DISPATCH(UnZigZagCumulativeSumInt64_1D)(zigzag, out, num_elements, prev_element);
+    }
+} // namespace simd
+
+namespace bitpack {
+
+namespace {
+    using namespace codecs::BitPack;
+
+    constexpr uint64_t low_mask(const unsigned bits) {
+        return bits >= 64 ? ~uint64_t{0} : (uint64_t{1} << bits) - 1;
+    }
+
+    constexpr size_t words_for_bits(const size_t bits) { return (bits + 63) / 64; }
+
+    constexpr size_t round_up_8(const size_t bytes) { return (bytes + 7) & ~size_t{7}; }
+
+    // Packed section size of a block of `count` values.
+    constexpr size_t packed_words(const size_t count, const unsigned bit_width) {
+        return count == BLOCK_VALUES ? STREAMS * bit_width : words_for_bits(count * bit_width);
+    }
+
+    void store_word(std::byte* out, const size_t index, const uint64_t word) {
+        std::memcpy(out + index * sizeof(uint64_t), &word, sizeof(uint64_t));
+    }
+
+    uint64_t load_word(const std::byte* in, const size_t index) {
+        uint64_t word;
+        std::memcpy(&word, in + index * sizeof(uint64_t), sizeof(uint64_t));
+        return word;
+    }
+
+    // Single LSB-first stream of (value - base) & mask fields, `value_shift` bits dropped first.
+    void pack_scalar(const uint64_t* values, const size_t count, const uint64_t base, const unsigned value_shift,
+                     const unsigned bit_width, std::byte* out) {
+        if (bit_width == 0) return;
+        const uint64_t mask = low_mask(bit_width);
+        uint64_t acc = 0;
+        unsigned fill = 0;
+        size_t word = 0;
+        for (size_t i = 0; i < count; ++i) {
+            const uint64_t v = ((values[i] - base) >> value_shift) & mask;
+            acc |= v << fill;
+            const unsigned end = fill + bit_width;
+            if (end >= 64) {
+                store_word(out, word++, acc);
+                acc = fill == 0 ? 0 : v >> (64 - fill);
+                fill = end - 64;
+            } else {
+                fill = end;
+            }
+        }
+        if (fill > 0) store_word(out, word, acc);
+    }
+
+    uint64_t unpack_scalar_field(const std::byte* in, const size_t index, const unsigned bit_width) {
+        const size_t bit = index * bit_width;
+        const size_t word = bit / 64;
+        const unsigned shift = static_cast<unsigned>(bit % 64);
+        uint64_t v = load_word(in, word) >> shift;
+        if (shift + bit_width > 64) v |= load_word(in, word + 1) << (64 - shift);
+        return v & low_mask(bit_width);
+    }
+
+    struct BlockPlan {
+        unsigned bit_width = 0;
+        unsigned exception_bit_width = 0;
+        size_t exception_count = 0;
+    };
+
+    size_t planned_bytes(const size_t count, const BlockPlan& plan) {
+        return BLOCK_HEADER_BYTES + packed_words(count, plan.bit_width) * sizeof(uint64_t)
+               + round_up_8(plan.exception_count)
+               + words_for_bits(plan.exception_count * plan.exception_bit_width) * sizeof(uint64_t);
+    }
+
+    // Picks the bit width with the smallest encoded size from a histogram of value bit lengths.
+    // Ties go to the wider width, which has fewer exceptions to patch on decode.
+    BlockPlan plan_block(const std::array<size_t, 65>& length_histogram, const size_t count) {
+        unsigned max_length = 64;
+        while (max_length > 0 && length_histogram[max_length] == 0) --max_length;
+
+        BlockPlan best{max_length, 0, 0};
+        size_t best_bytes = planned_bytes(count, best);
+        size_t exceptions = 0;
+        for (unsigned width = max_length; width-- > 0;) {
+            exceptions += length_histogram[width + 1];
+            if (exceptions > MAX_EXCEPTIONS) break;
+            const BlockPlan plan{width, max_length - width, exceptions};
+            if (const size_t bytes = planned_bytes(count, plan); bytes < best_bytes) {
+                best = plan;
+                best_bytes = bytes;
+            }
+        }
+        return best;
+    }
+
+    size_t encode_block(const uint64_t* values, const size_t count, std::byte* out) {
+        const uint64_t base = *std::min_element(values, values + count);
+        std::array<size_t, 65> length_histogram{};
+        for (size_t i = 0; i < count; ++i) {
+            ++length_histogram[std::bit_width(values[i] - base)];
+        }
+        const BlockPlan plan = plan_block(length_histogram, count);
+
+        std::memset(out, 0, BLOCK_HEADER_BYTES);
+        std::memcpy(out, &base, sizeof(base));
+        out[8] = static_cast<std::byte>(plan.bit_width);
+        out[9] = static_cast<std::byte>(plan.exception_count);
+        out[10] = static_cast<std::byte>(plan.exception_bit_width);
+        std::byte* cursor = out + BLOCK_HEADER_BYTES;
+
+        if (count == BLOCK_VALUES) {
+            simd::PackBlock64_dispatcher(values, base, plan.bit_width, reinterpret_cast<uint64_t*>(cursor));
+        } else {
+            pack_scalar(values, count, base, 0, plan.bit_width, cursor);
+        }
+        cursor += packed_words(count, plan.bit_width) * sizeof(uint64_t);
+
+        if (plan.exception_count > 0) {
+            std::array<uint64_t, MAX_EXCEPTIONS> exception_values{};
+            const size_t positions_bytes = round_up_8(plan.exception_count);
+            std::memset(cursor, 0, positions_bytes);
+            size_t e = 0;
+            for (size_t i = 0; i < count; ++i) {
+                if (std::bit_width(values[i] - base) > plan.bit_width) {
+                    cursor[e] = static_cast<std::byte>(i);
+                    exception_values[e++] = values[i];
+                }
+            }
+            cursor += positions_bytes;
+            pack_scalar(exception_values.data(), e, base, plan.bit_width, plan.exception_bit_width, cursor);
+            cursor += words_for_bits(e * plan.exception_bit_width) * sizeof(uint64_t);
+        }
+        return static_cast<size_t>(cursor - out);
+    }
+
+    std::expected<size_t, std::string> decode_block(std::span<const std::byte> in, uint64_t* out, const size_t count) {
+        if (in.size() < BLOCK_HEADER_BYTES) return std::unexpected("Bit-packed block header is truncated");
+        uint64_t base;
+        std::memcpy(&base, in.data(), sizeof(base));
+        const unsigned bit_width = static_cast<unsigned>(in[8]);
+        const size_t exception_count = static_cast<size_t>(in[9]);
+        const unsigned exception_bit_width = static_cast<unsigned>(in[10]);
+        if (bit_width > 64) return std::unexpected(std::format("Invalid bit width {} in bit-packed block", bit_width));
+        if (exception_count > 0 && (exception_bit_width == 0 || bit_width + exception_bit_width > 64)) {
+            return std::unexpected("Invalid exception bit width in bit-packed block");
+        }
+
+        const BlockPlan plan{bit_width, exception_bit_width, exception_count};
+        const size_t block_bytes = planned_bytes(count, plan);
+        if (in.size() < block_bytes) return std::unexpected("Bit-packed block is truncated");
+        const std::byte* cursor = in.data() + BLOCK_HEADER_BYTES;
+
+        if (count == BLOCK_VALUES) {
+            simd::UnpackBlock64_dispatcher(reinterpret_cast<const uint64_t*>(cursor), base, bit_width, out);
+        } else if (bit_width == 0) {
+            std::fill_n(out, count, base);
+        } else {
+            for (size_t i = 0; i < count; ++i) {
+                out[i] = unpack_scalar_field(cursor, i, bit_width) + base;
+            }
+        }
+        cursor += packed_words(count, bit_width) * sizeof(uint64_t);
+
+        if (exception_count > 0) {
+            const std::byte* positions = cursor;
+            const std::byte* high_bits = cursor + round_up_8(exception_count);
+            for (size_t e = 0; e < exception_count; ++e) {
+                const size_t position = static_cast<size_t>(positions[e]);
+                if (position >= count) return std::unexpected("Exception position out of range in bit-packed block");
+                out[position] += unpack_scalar_field(high_bits, e, exception_bit_width) << bit_width;
+            }
+        }
+        return block_bytes;
+    }
+} // namespace
+
+size_t encode(std::span<const uint64_t> values, std::byte* out) {
+    size_t written = 0;
+    for (size_t offset = 0; offset < values.size(); offset += BLOCK_VALUES) {
+        const size_t count = std::min(BLOCK_VALUES, values.size() - offset);
+        written += encode_block(values.data() + offset, count, out + written);
+    }
+    return written;
+}
+
+std::expected<void, std::string> decode(std::span<const std::byte> encoded, std::span<uint64_t> out) {
+    // Packed words are read as uint64_t by the SIMD kernels; realign payloads that do not start on a word boundary.
+    memory::vector<uint64_t> realigned;
+    if (!encoded.empty() && reinterpret_cast<std::uintptr_t>(encoded.data()) % alignof(uint64_t) != 0) {
+        realigned.resize(words_for_bits(encoded.size() * 8));
+        std::memcpy(realigned.data(), encoded.data(), encoded.size());
+        encoded = std::as_bytes(std::span(realigned)).first(encoded.size());
+    }
+
+    size_t consumed = 0;
+    for (size_t offset = 0; offset < out.size(); offset += BLOCK_VALUES) {
+        const size_t count = std::min(BLOCK_VALUES, out.size() - offset);
+        auto block = decode_block(encoded.subspan(consumed), out.data() + offset, count);
+        if (!block) return std::unexpected(block.error());
+        consumed += *block;
+    }
+    if (consumed != encoded.size()) return std::unexpected("Bit-packed payload has trailing bytes");
+    return {};
+}
+
+} // namespace bitpack
+
+} // namespace cryptodd
+#endif // HWY_ONCE
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "codec_constants.h"
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string>
+
+/**
+ * @file bitpack_simd_codec.h
+ * @brief Frame-of-reference bit-packing with patched exceptions (PFor) for 64-bit unsigned values.
+ *
+ * Values are cut into blocks of codecs::BitPack::BLOCK_VALUES (only the last block may be shorter):
+ *
+ *     uint64_t base                     // block minimum, subtracted from every value
+ *     uint8_t  bit_width                // bits kept per value, 0..64
+ *     uint8_t  exception_count          // values whose (value - base) needs more than bit_width bits
+ *     uint8_t  exception_bit_width      // bits of (value - base) >> bit_width stored per exception
+ *     uint8_t  reserved[5]
+ *     uint64_t packed[...]              // low bit_width bits of every value
+ *     uint8_t  exception_positions[exception_count], zero-padded to a multiple of 8
+ *     uint64_t exception_high_bits[...] // exception_count fields of exception_bit_width bits
+ *
+ * Full blocks store `packed` as codecs::BitPack::STREAMS interleaved streams (value i goes to stream
+ * i % STREAMS; word w of stream s is packed[w * STREAMS + s]), so unpacking runs one stream per SIMD
+ * lane. The last, partial block and the exception high bits are packed as a single LSB-first stream.
+ * Every section is a multiple of 8 bytes, so words stay 8-byte aligned relative to the payload start.
+ * Integers are stored in native byte order, like the rest of the chunk payload.
+ *
+ * The bit width of each block is chosen to minimise its encoded size, so a few outliers (e.g. the
+ * first delta of a series) are stored as exceptions instead of widening the whole block.
+ */
+namespace cryptodd {
+
+namespace simd {
+    // Packs/unpacks one full block of codecs::BitPack::BLOCK_VALUES values; `out_words` receives STREAMS * bit_width words.
+    void PackBlock64_dispatcher(const uint64_t* values, uint64_t base, unsigned bit_width, uint64_t* out_words);
+    void UnpackBlock64_dispatcher(const uint64_t* words, uint64_t base, unsigned bit_width, uint64_t* out_values);
+
+    // Chain helpers for delta + zigzag: out[i] = zigzag(data[i] - data[i - 1]), and its inverse. The inverse may run in place.
+    void ZigZagDeltaInt64_1D_dispatcher(const int64_t* data, uint64_t* out, size_t num_elements, int64_t prev_element);
+    void UnZigZagCumulativeSumInt64_1D_dispatcher(const uint64_t* zigzag, int64_t* out, size_t num_elements, int64_t& prev_element);
+}
+
+namespace bitpack {
+    /** @brief Upper bound of `encode()` output for `num_values` values. */
+    [[nodiscard]] constexpr size_t max_encoded_size(const size_t num_values) {
+        const size_t blocks = (num_values + codecs::BitPack::BLOCK_VALUES - 1) / codecs::BitPack::BLOCK_VALUES;
+        return blocks * codecs::BitPack::BLOCK_HEADER_BYTES + num_values * sizeof(uint64_t);
+    }
+
+    /**
+     * @brief Encodes `values` into `out`, which must hold at least max_encoded_size(values.size()) bytes.
+     * @return The number of bytes written.
+     */
+    size_t encode(std::span<const uint64_t> values, std::byte* out);
+
+    /** @brief Decodes exactly `out.size()` values; fails if `encoded` is truncated, corrupted, or has trailing bytes. */
+    std::expected<void, std::string> decode(std::span<const std::byte> encoded, std::span<uint64_t> out);
+} // namespace bitpack
+
+} // namespace cryptodd
@@ -0,0 +1,274 @@
+#include "chimp_codec.h"
+
+#include <array>
+#include <bit>
+#include <cstring>
+
+namespace cryptodd {
+
+namespace {
+
+    // Leading-zero counts are rounded down to one of 8 values so they fit in a 3-bit code.
+    constexpr std::array<unsigned, 8> kLeadingValues = {0, 8, 12, 16, 18, 20, 22, 24};
+
+    constexpr std::array<uint8_t, 65> make_leading_codes() {
+        std::array<uint8_t, 65> codes{};
+        for (unsigned lz = 0; lz <= 64; ++lz) {
+            uint8_t code = 0;
+            for (uint8_t c = 0; c < kLeadingValues.size(); ++c) {
+                if (kLeadingValues[c] <= lz) code = c;
+            }
+            codes[lz] = code;
+        }
+        return codes;
+    }
+    constexpr auto kLeadingCodes = make_leading_codes();
+
+    // Marks "no usable leading-zero count"; set after the '00' and '01' cases.
+    constexpr unsigned kNoStoredLeading = 65;
+
+    template <typename Float>
+    struct ChimpTraits;
+
+    template <>
+    struct ChimpTraits<float> {
+        using Bits = uint32_t;
+        static constexpr unsigned BITS = 32;
+        static constexpr unsigned THRESHOLD = 12;
+        static constexpr unsigned SIGNIFICANT_BITS_FIELD = 5;
+    };
+
+    template <>
+    struct ChimpTraits<double> {
+        using Bits = uint64_t;
+        static constexpr unsigned BITS = 64;
+        static constexpr unsigned THRESHOLD = 13;
+        static constexpr unsigned SIGNIFICANT_BITS_FIELD = 6;
+    };
+
+    constexpr uint64_t low_mask(const unsigned n) {
+        return n >= 64 ? ~uint64_t{0} : (uint64_t{1} << n) - 1;
+    }
+
+    class BitWriter {
+    public:
+        explicit BitWriter(std::byte* out) : out_(out) {}
+
+        // `value` must have no bits set above the low `n`; n in [0, 64].
+        void write(const uint64_t value, const unsigned n) {
+            const unsigned free = 64 - fill_;
+            if (n < free) {
+                acc_ = (acc_ << n) | value;
+                fill_ += n;
+                return;
+            }
+            const unsigned rest = n - free;
+            acc_ = (free == 64 ? 0 : acc_ << free) | (value >> rest);
+            flush_word();
+            acc_ = value & low_mask(rest);
+            fill_ = rest;
+        }
+
+        // Pads the last word with zero bits and returns the number of bytes written.
+        size_t finish() {
+            if (fill_ > 0) {
+                acc_ <<= 64 - fill_;
+                flush_word();
+                acc_ = 0;
+                fill_ = 0;
+            }
+            return words_ * sizeof(uint64_t);
+        }
+
+    private:
+        void flush_word() {
+            std::memcpy(out_ + words_ * sizeof(uint64_t), &acc_, sizeof(uint64_t));
+            ++words_;
+        }
+
+        std::byte* out_;
+        size_t words_ = 0;
+        uint64_t acc_ = 0;
+        unsigned fill_ = 0;
+    };
+
+    // Reads past the end return zero bits and set `overrun()`, so the hot loop only checks once at the end.
+    class BitReader {
+    public:
+        explicit BitReader(std::span<const std::byte> in) : in_(in), word_count_(in.size() / sizeof(uint64_t)) {}
+
+        // n in [1, 64].
+        uint64_t read(const unsigned n) {
+            if (n <= avail_) {
+                avail_ -= n;
+                return (cur_ >> avail_) & low_mask(n);
+            }
+            const unsigned need = n - avail_;
+            const uint64_t high = cur_ & low_mask(avail_);
+            refill();
+            avail_ = 64 - need;
+            return need == 64 ? cur_ : (high << need) | (cur_ >> avail_);
+        }
+
+        [[nodiscard]] bool overrun() const { return overrun_; }
+
+    private:
+        void refill() {
+            if (next_ < word_count_) {
+                std::memcpy(&cur_, in_.data() + next_ * sizeof(uint64_t), sizeof(uint64_t));
+                ++next_;
+            } else {
+                cur_ = 0;
+                overrun_ = true;
+            }
+        }
+
+        std::span<const std::byte> in_;
+        size_t word_count_;
+        size_t next_ = 0;
+        uint64_t cur_ = 0;
+        unsigned avail_ = 0;
+        bool overrun_ = false;
+    };
+
+    template <typename Float>
+    std::expected<memory::vector<std::byte>, std::string> encode_chimp(std::span<const Float> data, const Float prev_element, ChimpCodecWorkspace& workspace) {
+        using T = ChimpTraits<Float>;
+        using Bits = typename T::Bits;
+        constexpr Bits key_mask = (Bits{1} << (T::THRESHOLD + 1)) - 1;
+        static_assert(key_mask < codecs::Chimp::INDEX_TABLE_SIZE);
+        if (data.size() >= UINT32_MAX) return std::unexpected("Chimp codec supports at most 2^32 - 2 elements per chunk");
+
+        // Worst case per value: '11' + 3-bit lead code + all bits.
+        const size_t max_bits = data.size() * (2 + 3 + T::BITS);
+        memory::vector<std::byte> out((max_bits + 63) / 64 * sizeof(uint64_t));
+        BitWriter writer(out.data());
+
+        const auto indices = workspace.reset_indices();
+        std::array<Bits, codecs::Chimp::RING_SIZE> ring{};
+        constexpr size_t ring_mask = codecs::Chimp::RING_SIZE - 1;
+        ring[0] = std::bit_cast<Bits>(prev_element);
+        indices[ring[0] & key_mask] = 0;
+        unsigned stored_leading = kNoStoredLeading;
+
+        for (size_t i = 0; i < data.size(); ++i) {
+            const auto position = static_cast<uint32_t>(i + 1);
+            const Bits value = std::bit_cast<Bits>(data[i]);
+            const Bits key = value & key_mask;
+
+            // Prefer the most recent value sharing our low bits if the XOR with it ends in enough zeros.
+            size_t reference = (position - 1) & ring_mask;
+            Bits xored = ring[reference] ^ value;
+            unsigned trailing = 0;
+            const uint32_t candidate = indices[key];
+            if (position - candidate < codecs::Chimp::RING_SIZE) {
+                const Bits candidate_xor = ring[candidate & ring_mask] ^ value;
+                const unsigned candidate_trailing = static_cast<unsigned>(std::countr_zero(candidate_xor));
+                if (candidate_trailing > T::THRESHOLD) {
+                    reference = candidate & ring_mask;
+                    xored = candidate_xor;
+                    trailing = candidate_trailing;
+                }
+            }
+
+            if (xored == 0) {
+                writer.write(reference, 2 + codecs::Chimp::RING_INDEX_BITS);
+                stored_leading = kNoStoredLeading;
+            } else {
+                const uint8_t lead_code = kLeadingCodes[std::countl_zero(xored)];
+                const unsigned leading = kLeadingValues[lead_code];
+                if (trailing > T::THRESHOLD) {
+                    const unsigned significant = T::BITS - leading - trailing;
+                    const uint64_t header = (uint64_t{0b01} << codecs::Chimp::RING_INDEX_BITS | reference) << (3 + T::SIGNIFICANT_BITS_FIELD)
+                                            | uint64_t{lead_code} << T::SIGNIFICANT_BITS_FIELD | significant;
+                    writer.write(header, 2 + codecs::Chimp::RING_INDEX_BITS + 3 + T::SIGNIFICANT_BITS_FIELD);
+                    writer.write(xored >> trailing, significant);
+                    stored_leading = kNoStoredLeading;
+                } else if (leading == stored_leading) {
+                    writer.write(0b10, 2);
+                    writer.write(xored, T::BITS - leading);
+                } else {
+                    stored_leading = leading;
+                    writer.write(0b11u << 3 | lead_code, 5);
+                    writer.write(xored, T::BITS - leading);
+                }
+            }
+
+            ring[position & ring_mask] = value;
+            indices[key] = position;
+        }
+
+        out.resize(writer.finish());
+        return out;
+    }
+
+    template <typename Float, typename OutVector>
+    std::expected<OutVector, std::string> decode_chimp(std::span<const std::byte> encoded, const size_t num_elements, Float& prev_element) {
+        using T = ChimpTraits<Float>;
+        using Bits = typename T::Bits;
+        if (encoded.size() % sizeof(uint64_t) != 0) return std::unexpected("Chimp payload size is not a multiple of 8 bytes");
+
+        OutVector out(num_elements);
+        BitReader reader(encoded);
+        std::array<Bits, codecs::Chimp::RING_SIZE> ring{};
+        constexpr size_t ring_mask = codecs::Chimp::RING_SIZE - 1;
+        ring[0] = std::bit_cast<Bits>(prev_element);
+        unsigned stored_leading = kNoStoredLeading;
+
+        for (size_t i = 0; i < num_elements; ++i) {
+            const size_t position = i + 1;
+            const Bits last = ring[(position - 1) & ring_mask];
+            Bits value;
+            switch (reader.read(2)) {
+                case 0b00:
+                    value = ring[reader.read(codecs::Chimp::RING_INDEX_BITS)];
+                    stored_leading = kNoStoredLeading;
+                    break;
+                case 0b01: {
+                    const uint64_t header = reader.read(codecs::Chimp::RING_INDEX_BITS + 3 + T::SIGNIFICANT_BITS_FIELD);
+                    const size_t reference = header >> (3 + T::SIGNIFICANT_BITS_FIELD);
+                    const unsigned leading = kLeadingValues[(header >> T::SIGNIFICANT_BITS_FIELD) & 0b111];
+                    const unsigned significant = static_cast<unsigned>(header & low_mask(T::SIGNIFICANT_BITS_FIELD));
+                    if (significant == 0 || leading + significant > T::BITS) return std::unexpected("Corrupted Chimp stream: invalid significant bit count");
+                    const unsigned trailing = T::BITS - leading - significant;
+                    value = ring[reference] ^ static_cast<Bits>(reader.read(significant) << trailing);
+                    stored_leading = kNoStoredLeading;
+                    break;
+                }
+                case 0b10:
+                    if (stored_leading == kNoStoredLeading) return std::unexpected("Corrupted Chimp stream: reused leading zeros before any were stored");
+                    value = last ^ static_cast<Bits>(reader.read(T::BITS - stored_leading));
+                    break;
+                default:
+                    stored_leading = kLeadingValues[reader.read(3)];
+                    value = last ^ static_cast<Bits>(reader.read(T::BITS - stored_leading));
+                    break;
+            }
+            ring[position & ring_mask] = value;
+            out[i] = std::bit_cast<Float>(value);
+        }
+
+        if (reader.overrun()) return std::unexpected("Chimp payload is truncated");
+        if (num_elements > 0) prev_element = out[num_elements - 1];
+        return out;
+    }
+
+} // namespace
+
+std::expected<memory::vector<std::byte>, std::string> ChimpCodec::encode32(std::span<const float> data, const float prev_element, ChimpCodecWorkspace& workspace) const {
+    return encode_chimp<float>(data, prev_element, workspace);
+}
+
+std::expected<Float32AlignedVector, std::string> ChimpCodec::decode32(std::span<const std::byte> encoded, const size_t num_elements, float& prev_element) const {
+    return decode_chimp<float, Float32AlignedVector>(encoded, num_elements, prev_element);
+}
+
+std::expected<memory::vector<std::byte>, std::string> ChimpCodec::encode64(std::span<const double> data, const double prev_element, ChimpCodecWorkspace& workspace) const {
+    return encode_chimp<double>(data, prev_element, workspace);
+}
+
+std::expected<Float64AlignedVector, std::string> ChimpCodec::decode64(std::span<const std::byte> encoded, const size_t num_elements, double& prev_element) const {
+    return decode_chimp<double, Float64AlignedVector>(encoded, num_elements, prev_element);
+}
+
+} // namespace cryptodd
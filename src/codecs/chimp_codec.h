@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <hwy/aligned_allocator.h>
+#include <span>
+#include <string>
+#include "../memory/aligned.h"
+#include "../memory/allocator.h"
+
+namespace cryptodd {
+
+using Float32AlignedVector = memory::AlignedVector<float, static_cast<std::size_t>(HWY_ALIGNMENT)>;
+using Float64AlignedVector = memory::AlignedVector<double, static_cast<std::size_t>(HWY_ALIGNMENT)>;
+
+namespace codecs::Chimp {
+    /** Number of previous values an encoded value can be XORed against (Chimp128). */
+    constexpr size_t RING_SIZE = 128;
+    constexpr unsigned RING_INDEX_BITS = 7;
+    /** Size of the encoder's "last position of these low bits" table. Covers both widths' thresholds. */
+    constexpr size_t INDEX_TABLE_SIZE = size_t{1} << 14;
+} // namespace codecs::Chimp
+
+class ChimpCodecWorkspace {
+public:
+    ChimpCodecWorkspace() = default;
+    ChimpCodecWorkspace(const ChimpCodecWorkspace&) = delete;
+    ChimpCodecWorkspace& operator=(const ChimpCodecWorkspace&) = delete;
+    ChimpCodecWorkspace(ChimpCodecWorkspace&&) noexcept = default;
+    ChimpCodecWorkspace& operator=(ChimpCodecWorkspace&&) noexcept = default;
+
+    // Clears the position table; positions are only meaningful within one encode call.
+    [[nodiscard]] std::span<uint32_t> reset_indices() {
+        indices_.assign(codecs::Chimp::INDEX_TABLE_SIZE, 0);
+        return indices_;
+    }
+
+private:
+    memory::vector<uint32_t> indices_;
+};
+
+/**
+ * @brief Chimp128 floating-point compressor for 1D series.
+ *
+ * Each value is XORed against one of the previous 128 values, picked through a table keyed
+ * on the low mantissa bits so that repeated price levels produce long runs of trailing zeros,
+ * and the XOR is written with a 2-bit flag and as few significant bits as possible. The
+ * output is a bit stream packed MSB-first into native-endian 64-bit words; there is no zstd
+ * stage. Lossless for every bit pattern, including NaN payloads and signed zeros.
+ *
+ * `prev_element` seeds the ring, so a chunk continues the series of the previous one exactly
+ * like the XOR shuffle codecs. The decoder leaves the last decoded value in `prev_element`.
+ */
+class ChimpCodec {
+public:
+    std::expected<memory::vector<std::byte>, std::string> encode32(std::span<const float> data, float prev_element, ChimpCodecWorkspace& workspace) const;
+    std::expected<Float32AlignedVector, std::string> decode32(std::span<const std::byte> encoded, size_t num_elements, float& prev_element) const;
+
+    std::expected<memory::vector<std::byte>, std::string> encode64(std::span<const double> data, double prev_element, ChimpCodecWorkspace& workspace) const;
+    std::expected<Float64AlignedVector, std::string> decode64(std::span<const std::byte> encoded, size_t num_elements, double& prev_element) const;
+};
+
+} // namespace cryptodd
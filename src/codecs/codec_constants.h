@@ -1,6 +1,9 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
 
 namespace cryptodd::codecs {
 
@@ -16,4 +19,53 @@ namespace Orderbook {
     constexpr size_t BINANCE_FEATURES = 8;
 } // namespace Orderbook
 
+/**
+ * @brief Byte-plane layout used by the XOR+shuffle float codecs.
+ *
+ * `Global` stores each byte plane across the whole chunk. `Blocked` splits the chunk into row
+ * blocks of `ShuffleBlock::rows_per_block()` rows and stores the byte planes of each block
+ * contiguously, so a decoder can unshuffle and reconstruct block by block while the chunk is
+ * still being decompressed. Chunks written with `Blocked` carry `ChunkFlags::BLOCKED_SHUFFLE`.
+ */
+enum class ShuffleLayout : uint8_t {
+    Global,
+    Blocked,
+};
+
+namespace ShuffleBlock {
+    /**
+     * Target size of one block of shuffled bytes. Small enough for a decompressed block and the
+     * floats reconstructed from it to stay in L2. This is part of the on-disk format of
+     * BLOCKED_SHUFFLE chunks: changing it makes existing files unreadable.
+     */
+    constexpr size_t TARGET_BLOCK_BYTES = 128 * 1024;
+
+    /** @brief Rows per block for rows of `row_bytes` shuffled bytes. Always at least one row. */
+    constexpr size_t rows_per_block(const size_t row_bytes) {
+        return (row_bytes == 0 || row_bytes >= TARGET_BLOCK_BYTES) ? 1 : TARGET_BLOCK_BYTES / row_bytes;
+    }
+} // namespace ShuffleBlock
+
+/**
+ * @brief Receives the raw (unencoded) bytes of each row block a `Blocked` codec encodes or decodes, in order,
+ * while the block is still in cache. Used to hash a chunk in the same pass as its encode or decode.
+ */
+using BlockVisitor = std::function<void(std::span<const std::byte> raw_block)>;
+
+/**
+ * @brief Block layout of the FOR/PFor bit-packing used by the *_BITPACK int64 codecs (see bitpack_simd_codec.h).
+ *
+ * A full block packs `BLOCK_VALUES` values as `STREAMS` interleaved bit streams so the decoder can unpack
+ * one word from every stream per vector operation on any SIMD width that divides `STREAMS`. The constants
+ * are part of the on-disk format: changing them makes existing files unreadable.
+ */
+namespace BitPack {
+    constexpr size_t STREAMS = 4;
+    constexpr size_t VALUES_PER_STREAM = 64;
+    constexpr size_t BLOCK_VALUES = STREAMS * VALUES_PER_STREAM;
+    constexpr size_t BLOCK_HEADER_BYTES = 16;
+    /** PFor exceptions per block are counted in one byte. */
+    constexpr size_t MAX_EXCEPTIONS = 255;
+} // namespace BitPack
+
 } // namespace cryptodd::codecs
\ No newline at end of file
@@ -0,0 +1,535 @@
+#include "fixed_point_simd_codec.h"
+
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "fixed_point_simd_codec.cpp"
+#include "hwy/foreach_target.h"
+
+#include <hwy/highway.h>
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+HWY_BEFORE_NAMESPACE();
+namespace cryptodd::HWY_NAMESPACE {
+
+namespace hn = hwy::HWY_NAMESPACE;
+
+// Every integer up to 2^53 in magnitude converts to double exactly, so decoding never depends on rounding.
+inline constexpr double kMaxExactInteger = 9007199254740992.0;
+
+template <typename T>
+using BitsOf = std::conditional_t<sizeof(T) == sizeof(uint32_t), uint32_t, uint64_t>;
+
+template <bool kRequireExact, typename T>
+HWY_INLINE bool QuantizeScalar(const T value, const double scale, int64_t& out) {
+    const double rounded = std::nearbyint(static_cast<double>(value) * scale);
+    if (!(std::abs(rounded) <= kMaxExactInteger)) return false; // Also rejects NaN and infinities.
+    out = static_cast<int64_t>(rounded);
+    if constexpr (!kRequireExact) return true;
+    return hwy::BitCastScalar<BitsOf<T>>(static_cast<T>(static_cast<double>(out) / scale)) == hwy::BitCastScalar<BitsOf<T>>(value);
+}
+
+template <typename T, class D64, class V>
+HWY_INLINE auto WidenToF64(const D64 d64, const V v) {
+    if constexpr (std::is_same_v<T, float>) {
+        return hn::PromoteTo(d64, v);
+    } else {
+        return v;
+    }
+}
+
+template <typename T, class DT, class V>
+HWY_INLINE auto NarrowFromF64(const DT dt, const V v) {
+    if constexpr (std::is_same_v<T, float>) {
+        return hn::DemoteTo(dt, v);
+    } else {
+        return v;
+    }
+}
+
+// Quantizes `count` values with scales[i], or with scales[0] for every value when `broadcast`.
+// With kRequireExact, the round trip is checked with the exact operations the decoder uses, so a value that passes
+// decodes bit for bit; without it, only the integer range is checked.
+template <bool kRequireExact, typename T>
+HWY_INLINE bool QuantizeSpan(const T* HWY_RESTRICT data, int64_t* HWY_RESTRICT out, const size_t count, const double* HWY_RESTRICT scales, const bool broadcast) {
+    size_t i = 0;
+#if HWY_TARGET != HWY_SCALAR && HWY_HAVE_FLOAT64
+    const hn::ScalableTag<double> d64;
+    const hn::RebindToSigned<decltype(d64)> di64;
+    const hn::Rebind<T, decltype(d64)> dt;
+    const hn::RebindToUnsigned<decltype(dt)> dut;
+    const size_t lanes = hn::Lanes(d64);
+    const auto v_limit = hn::Set(d64, kMaxExactInteger);
+
+    for (; i + lanes <= count; i += lanes) {
+        const auto v_value = hn::LoadU(dt, data + i);
+        const auto v_scale = broadcast ? hn::Set(d64, scales[0]) : hn::LoadU(d64, scales + i);
+        const auto v_rounded = hn::Round(hn::Mul(WidenToF64<T>(d64, v_value), v_scale));
+        // NaN fails the comparison, so it is rejected here before the conversion.
+        if (!hn::AllTrue(d64, hn::Le(hn::Abs(v_rounded), v_limit))) return false;
+        const auto v_quantized = hn::ConvertTo(di64, v_rounded);
+
+        if constexpr (kRequireExact) {
+            const auto v_back = NarrowFromF64<T>(dt, hn::Div(hn::ConvertTo(d64, v_quantized), v_scale));
+            if (!hn::AllTrue(dut, hn::Eq(hn::BitCast(dut, v_back), hn::BitCast(dut, v_value)))) return false;
+        }
+        hn::StoreU(v_quantized, di64, out + i);
+    }
+#endif
+    for (; i < count; ++i) {
+        if (!QuantizeScalar<kRequireExact>(data[i], broadcast ? scales[0] : scales[i], out[i])) return false;
+    }
+    return true;
+}
+
+template <typename T>
+HWY_INLINE void DequantizeSpan(const int64_t* HWY_RESTRICT quantized, T* HWY_RESTRICT out, const size_t count, const double* HWY_RESTRICT scales, const bool broadcast) {
+    size_t i = 0;
+#if HWY_TARGET != HWY_SCALAR && HWY_HAVE_FLOAT64
+    const hn::ScalableTag<double> d64;
+    const hn::RebindToSigned<decltype(d64)> di64;
+    const hn::Rebind<T, decltype(d64)> dt;
+    const size_t lanes = hn::Lanes(d64);
+
+    for (; i + lanes <= count; i += lanes) {
+        const auto v_scale = broadcast ? hn::Set(d64, scales[0]) : hn::LoadU(d64, scales + i);
+        const auto v_value = hn::Div(hn::ConvertTo(d64, hn::LoadU(di64, quantized + i)), v_scale);
+        hn::StoreU(NarrowFromF64<T>(dt, v_value), dt, out + i);
+    }
+#endif
+    for (; i < count; ++i) {
+        out[i] = static_cast<T>(static_cast<double>(quantized[i]) / (broadcast ? scales[0] : scales[i]));
+    }
+}
+
+// With period 1 every value shares scales[0]; otherwise the data is walked one row of `period` values at a time.
+template <typename T>
+HWY_INLINE bool QuantizeRows(const T* HWY_RESTRICT data, int64_t* HWY_RESTRICT out, const size_t num_elements, const double* HWY_RESTRICT scales, const size_t period) {
+    if (period == 1) return QuantizeSpan<true>(data, out, num_elements, scales, true);
+    for (size_t row = 0; row < num_elements; row += period) {
+        if (!QuantizeSpan<true>(data + row, out + row, std::min(period, num_elements - row), scales, false)) return false;
+    }
+    return true;
+}
+
+template <typename T>
+HWY_INLINE void DequantizeRows(const int64_t* HWY_RESTRICT quantized, T* HWY_RESTRICT out, const size_t num_elements, const double* HWY_RESTRICT scales, const size_t period) {
+    if (period == 1) {
+        DequantizeSpan(quantized, out, num_elements, scales, true);
+        return;
+    }
+    for (size_t row = 0; row < num_elements; row += period) {
+        DequantizeSpan(quantized + row, out + row, std::min(period, num_elements - row), scales, false);
+    }
+}
+
+HWY_NOINLINE bool QuantizeFloat32(const float* HWY_RESTRICT data, int64_t* HWY_RESTRICT out, size_t num_elements, const double* HWY_RESTRICT scales, size_t period) {
+    return QuantizeRows(data, out, num_elements, scales, period);
+}
+
+HWY_NOINLINE bool QuantizeFloat64(const double* HWY_RESTRICT data, int64_t* HWY_RESTRICT out, size_t num_elements, const double* HWY_RESTRICT scales, size_t period) {
+    return QuantizeRows(data, out, num_elements, scales, period);
+}
+
+HWY_NOINLINE bool RoundToGridFloat32(const float* HWY_RESTRICT data, int64_t* HWY_RESTRICT out, size_t num_elements, double scale) {
+    return QuantizeSpan<false>(data, out, num_elements, &scale, true);
+}
+
+HWY_NOINLINE bool RoundToGridFloat64(const double* HWY_RESTRICT data, int64_t* HWY_RESTRICT out, size_t num_elements, double scale) {
+    return QuantizeSpan<false>(data, out, num_elements, &scale, true);
+}
+
+HWY_NOINLINE void DequantizeFloat32(const int64_t* HWY_RESTRICT quantized, float* HWY_RESTRICT out, size_t num_elements, const double* HWY_RESTRICT scales, size_t period) {
+    DequantizeRows(quantized, out, num_elements, scales, period);
+}
+
+HWY_NOINLINE void DequantizeFloat64(const int64_t* HWY_RESTRICT quantized, double* HWY_RESTRICT out, size_t num_elements, const double* HWY_RESTRICT scales, size_t period) {
+    DequantizeRows(quantized, out, num_elements, scales, period);
+}
+
+// Like ZigZagDeltaInt64_1D, against the value `lag` elements back; the first `lag` values are taken against 0.
+HWY_NOINLINE void ZigZagLagDeltaInt64(const int64_t* HWY_RESTRICT data, uint64_t* HWY_RESTRICT out, size_t num_elements, size_t lag) {
+    const auto zigzag = [](const uint64_t delta) { return (delta << 1) ^ (0 - (delta >> 63)); };
+    const size_t head = std::min(lag, num_elements);
+    for (size_t i = 0; i < head; ++i) {
+        out[i] = zigzag(static_cast<uint64_t>(data[i]));
+    }
+    size_t i = head;
+#if HWY_TARGET != HWY_SCALAR
+    const hn::ScalableTag<int64_t> di64;
+    const hn::ScalableTag<uint64_t> du64;
+    const size_t lanes = hn::Lanes(di64);
+    for (; i + lanes <= num_elements; i += lanes) {
+        const auto v_delta = hn::Sub(hn::LoadU(di64, data + i), hn::LoadU(di64, data + i - lag));
+        const auto v_zigzag = hn::Xor(hn::ShiftLeft<1>(v_delta), hn::ShiftRight<63>(v_delta));
+        hn::StoreU(hn::BitCast(du64, v_zigzag), du64, out + i);
+    }
+#endif
+    for (; i < num_elements; ++i) {
+        out[i] = zigzag(static_cast<uint64_t>(data[i]) - static_cast<uint64_t>(data[i - lag]));
+    }
+}
+
+// `zigzag` and `out` may alias. A vector only reads outputs at least `lag` elements back, which are final as
+// long as lag covers a whole vector; shorter lags take the scalar loop.
+HWY_NOINLINE void UnZigZagLagSumInt64(const uint64_t* zigzag, int64_t* out, size_t num_elements, size_t lag) {
+    const auto unzigzag = [](const uint64_t z) { return (z >> 1) ^ (0 - (z & 1)); };
+    const size_t head = std::min(lag, num_elements);
+    for (size_t i = 0; i < head; ++i) {
+        out[i] = static_cast<int64_t>(unzigzag(zigzag[i]));
+    }
+    size_t i = head;
+#if HWY_TARGET != HWY_SCALAR
+    const hn::ScalableTag<int64_t> di64;
+    const hn::ScalableTag<uint64_t> du64;
+    const size_t lanes = hn::Lanes(di64);
+    if (lag >= lanes) {
+        const auto v_one = hn::Set(du64, 1);
+        for (; i + lanes <= num_elements; i += lanes) {
+            const auto v_zigzag = hn::LoadU(du64, zigzag + i);
+            const auto v_delta = hn::Xor(hn::ShiftRight<1>(v_zigzag), hn::BitCast(du64, hn::Neg(hn::BitCast(di64, hn::And(v_zigzag, v_one)))));
+            const auto v_prev = hn::BitCast(du64, hn::LoadU(di64, out + i - lag));
+            hn::StoreU(hn::BitCast(di64, hn::Add(v_prev, v_delta)), di64, out + i);
+        }
+    }
+#endif
+    for (; i < num_elements; ++i) {
+        out[i] = static_cast<int64_t>(static_cast<uint64_t>(out[i - lag]) + unzigzag(zigzag[i]));
+    }
+}
+
+} // namespace cryptodd::HWY_NAMESPACE
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+#include <cstring>
+#include <format>
+#include <limits>
+#include "bitpack_simd_codec.h"
+
+namespace cryptodd {
+
+namespace simd {
+    HWY_EXPORT(QuantizeFloat32);
+    bool QuantizeFloat32_dispatcher(const float* data, int64_t* out, size_t num_elements, const double* scales, size_t period) {
+        return HWY_DYNAMIC_DISPATCH(QuantizeFloat32)(data, out, num_elements, scales, period);
+    }
+
+    HWY_EXPORT(QuantizeFloat64);
+    bool QuantizeFloat64_dispatcher(const double* data, int64_t* out, size_t num_elements, const double* scales, size_t period) {
+        return HWY_DYNAMIC_DISPATCH(QuantizeFloat64)(data, out, num_elements, scales, period);
+    }
+
+    HWY_EXPORT(RoundToGridFloat32);
+    bool RoundToGridFloat32_dispatcher(const float* data, int64_t* out, size_t num_elements, double scale) {
+        return HWY_DYNAMIC_DISPATCH(RoundToGridFloat32)(data, out, num_elements, scale);
+    }
+
+    HWY_EXPORT(RoundToGridFloat64);
+    bool RoundToGridFloat64_dispatcher(const double* data, int64_t* out, size_t num_elements, double scale) {
+        return HWY_DYNAMIC_DISPATCH(RoundToGridFloat64)(data, out, num_elements, scale);
+    }
+
+    HWY_EXPORT(DequantizeFloat32);
+    void DequantizeFloat32_dispatcher(const int64_t* quantized, float* out, size_t num_elements, const double* scales, size_t period) {
+        HWY_DYNAMIC_DISPATCH(DequantizeFloat32)(quantized, out, num_elements, scales, period);
+    }
+
+    HWY_EXPORT(DequantizeFloat64);
+    void DequantizeFloat64_dispatcher(const int64_t* quantized, double* out, size_t num_elements, const double* scales, size_t period) {
+        HWY_DYNAMIC_DISPATCH(DequantizeFloat64)(quantized, out, num_elements, scales, period);
+    }
+
+    HWY_EXPORT(ZigZagLagDeltaInt64);
+    void ZigZagLagDeltaInt64_dispatcher(const int64_t* data, uint64_t* out, size_t num_elements, size_t lag) {
+        HWY_DYNAMIC_DISPATCH(ZigZagLagDeltaInt64)(data, out, num_elements, lag);
+    }
+
+    HWY_EXPORT(UnZigZagLagSumInt64);
+    void UnZigZagLagSumInt64_dispatcher(const uint64_t* zigzag, int64_t* out, size_t num_elements, size_t lag) {
+        HWY_DYNAMIC_DISPATCH(UnZigZagLagSumInt64)(zigzag, out, num_elements, lag);
+    }
+} // namespace simd
+
+namespace {
+    constexpr size_t kHeaderBytes = 2 * sizeof(uint32_t);
+    // Halvings of the grid step tried when float rounding of the decoded values overshoots the tolerance.
+    constexpr int kMaxGridRefinements = 8;
+
+    bool quantize(const float* data, int64_t* out, size_t n, const double* scales, size_t period) {
+        return simd::QuantizeFloat32_dispatcher(data, out, n, scales, period);
+    }
+    bool quantize(const double* data, int64_t* out, size_t n, const double* scales, size_t period) {
+        return simd::QuantizeFloat64_dispatcher(data, out, n, scales, period);
+    }
+    bool round_to_grid(const float* data, int64_t* out, size_t n, double scale) {
+        return simd::RoundToGridFloat32_dispatcher(data, out, n, scale);
+    }
+    bool round_to_grid(const double* data, int64_t* out, size_t n, double scale) {
+        return simd::RoundToGridFloat64_dispatcher(data, out, n, scale);
+    }
+    void dequantize(const int64_t* quantized, float* out, size_t n, const double* scales, size_t period) {
+        simd::DequantizeFloat32_dispatcher(quantized, out, n, scales, period);
+    }
+    void dequantize(const int64_t* quantized, double* out, size_t n, const double* scales, size_t period) {
+        simd::DequantizeFloat64_dispatcher(quantized, out, n, scales, period);
+    }
+
+    // An upper bound on |a - b|. The rounded difference can understate it by up to half an ulp, so it is nudged
+    // up one ulp whenever the TwoSum error term shows the subtraction was inexact.
+    double abs_difference_bound(const double a, const double b) {
+        const double difference = a - b;
+        const double b_virtual = difference - a;
+        const double rounding_error = (a - (difference - b_virtual)) + (-b - b_virtual);
+        const double magnitude = std::abs(difference);
+        return rounding_error == 0.0 ? magnitude : std::nextafter(magnitude, std::numeric_limits<double>::infinity());
+    }
+
+    // Columns are delta-coded down each column; rows against the previous row.
+    size_t lag_of(const FixedPointLayout layout, const size_t row_elements) {
+        return layout == FixedPointLayout::Rows ? std::max<size_t>(row_elements, 1) : 1;
+    }
+
+    std::expected<void, std::string> check_scales(std::span<const double> scales, const FixedPointLayout layout, const size_t row_elements) {
+        if (scales.empty()) return std::unexpected("Fixed-point codec requires at least one scale.");
+        if (layout == FixedPointLayout::Columns && scales.size() != row_elements) {
+            return std::unexpected(std::format("Fixed-point codec expected {} column scales, got {}.", row_elements, scales.size()));
+        }
+        if (layout == FixedPointLayout::Rows && row_elements % scales.size() != 0) {
+            return std::unexpected(std::format("Fixed-point row length {} is not a multiple of the {} feature scales.", row_elements, scales.size()));
+        }
+        for (const double scale : scales) {
+            if (!std::isfinite(scale) || scale <= 0.0) return std::unexpected(std::format("Invalid fixed-point scale {}.", scale));
+        }
+        return {};
+    }
+
+    // Rows quantize one row at a time, so the feature scales are repeated over a whole row up front.
+    memory::vector<double> expand_row_scales(std::span<const double> scales, const size_t row_elements) {
+        memory::vector<double> row(row_elements);
+        for (size_t i = 0; i < row_elements; ++i) row[i] = scales[i % scales.size()];
+        return row;
+    }
+}
+
+std::expected<double, std::string> FixedPointSimdCodec::scale_for_tick(const double tick_size) {
+    if (!std::isfinite(tick_size) || tick_size <= 0.0) {
+        return std::unexpected(std::format("Tick size must be a positive finite number, got {}.", tick_size));
+    }
+    const double scale = 1.0 / tick_size;
+    const double snapped = std::round(scale);
+    if (snapped >= 1.0 && std::abs(scale - snapped) <= snapped * 1e-9) return snapped;
+    return scale;
+}
+
+template <typename T>
+FixedPointSimdCodec::EncodeResult FixedPointSimdCodec::encode(std::span<const T> data, const FixedPointLayout layout, const size_t num_rows, std::span<const double> scales, FixedPointSimdCodecWorkspace& workspace) const {
+    const size_t row_elements = layout == FixedPointLayout::Columns ? scales.size() : (num_rows == 0 ? 0 : data.size() / num_rows);
+    if (row_elements * num_rows != data.size()) {
+        return std::unexpected(std::format("Fixed-point data size {} does not match {} rows.", data.size(), num_rows));
+    }
+    if (auto valid = check_scales(scales, layout, row_elements); !valid && !data.empty()) return std::unexpected(valid.error());
+
+    const size_t n = data.size();
+    workspace.ensure_capacity(n);
+    int64_t* quantized = workspace.quantized();
+    bool on_grid = true;
+    if (layout == FixedPointLayout::Columns) {
+        for (size_t c = 0; c < scales.size() && on_grid; ++c) {
+            on_grid = quantize(data.data() + c * num_rows, quantized + c * num_rows, num_rows, scales.data() + c, 1);
+        }
+    } else if (n > 0) {
+        const auto row_scales = expand_row_scales(scales, row_elements);
+        on_grid = quantize(data.data(), quantized, n, row_scales.data(), row_elements);
+    }
+    if (!on_grid) return std::optional<memory::vector<std::byte>>{};
+    return pack(n, lag_of(layout, row_elements), scales, workspace);
+}
+
+FixedPointSimdCodec::EncodeResult FixedPointSimdCodec::pack(const size_t n, const size_t lag, std::span<const double> scales, FixedPointSimdCodecWorkspace& workspace) const {
+    const int64_t* quantized = workspace.quantized();
+    uint64_t* zigzag = workspace.zigzag();
+    if (lag == 1) {
+        simd::ZigZagDeltaInt64_1D_dispatcher(quantized, zigzag, n, 0);
+    } else {
+        simd::ZigZagLagDeltaInt64_dispatcher(quantized, zigzag, n, lag);
+    }
+
+    memory::vector<std::byte> packed(bitpack::max_encoded_size(n));
+    packed.resize(bitpack::encode({zigzag, n}, packed.data()));
+    auto compressed = compressor_->compress(packed);
+    if (!compressed) return std::unexpected(compressed.error());
+
+    memory::vector<std::byte> payload(kHeaderBytes + scales.size_bytes() + compressed->size());
+    const uint32_t header[2] = {static_cast<uint32_t>(scales.size()), 0};
+    std::memcpy(payload.data(), header, kHeaderBytes);
+    std::memcpy(payload.data() + kHeaderBytes, scales.data(), scales.size_bytes());
+    std::memcpy(payload.data() + kHeaderBytes + scales.size_bytes(), compressed->data(), compressed->size());
+    return std::optional{std::move(payload)};
+}
+
+template <typename T>
+std::expected<memory::AlignedVector<T, static_cast<std::size_t>(HWY_ALIGNMENT)>, std::string> FixedPointSimdCodec::decode(std::span<const std::byte> encoded, const FixedPointLayout layout, const size_t num_rows, const size_t row_elements) const {
+    using OutVector = memory::AlignedVector<T, static_cast<std::size_t>(HWY_ALIGNMENT)>;
+    if (encoded.size() < kHeaderBytes) return std::unexpected("Fixed-point payload is too small for its header.");
+    uint32_t header[2];
+    std::memcpy(header, encoded.data(), kHeaderBytes);
+    const size_t num_scales = header[0];
+    if (header[1] != 0) return std::unexpected("Fixed-point payload has a non-zero reserved field.");
+    if (num_scales > (encoded.size() - kHeaderBytes) / sizeof(double)) return std::unexpected("Fixed-point payload is too small for its scales.");
+
+    memory::vector<double> scales(num_scales);
+    std::memcpy(scales.data(), encoded.data() + kHeaderBytes, num_scales * sizeof(double));
+    const size_t n = num_rows * row_elements;
+    if (n > 0) {
+        if (auto valid = check_scales(scales, layout, row_elements); !valid) return std::unexpected(valid.error());
+    }
+
+    auto packed = compressor_->decompress(encoded.subspan(kHeaderBytes + num_scales * sizeof(double)));
+    if (!packed) return std::unexpected(packed.error());
+
+    Int64AlignedVector quantized(n);
+    auto* zigzag = reinterpret_cast<uint64_t*>(quantized.data());
+    if (auto unpacked = bitpack::decode(*packed, {zigzag, n}); !unpacked) return std::unexpected(unpacked.error());
+    const size_t lag = lag_of(layout, row_elements);
+    if (lag == 1) {
+        int64_t prev = 0;
+        simd::UnZigZagCumulativeSumInt64_1D_dispatcher(zigzag, quantized.data(), n, prev);
+    } else {
+        simd::UnZigZagLagSumInt64_dispatcher(zigzag, quantized.data(), n, lag);
+    }
+
+    OutVector out(n);
+    if (layout == FixedPointLayout::Columns) {
+        for (size_t c = 0; c < num_scales && n > 0; ++c) {
+            dequantize(quantized.data() + c * num_rows, out.data() + c * num_rows, num_rows, scales.data() + c, 1);
+        }
+    } else if (n > 0) {
+        const auto row_scales = expand_row_scales(scales, row_elements);
+        dequantize(quantized.data(), out.data(), n, row_scales.data(), row_elements);
+    }
+    return out;
+}
+
+template <typename T>
+FixedPointSimdCodec::BoundedEncodeResult FixedPointSimdCodec::encode_bounded(std::span<const T> data, const size_t num_rows, std::span<const double> error_bounds, const bool relative, FixedPointSimdCodecWorkspace& workspace) const {
+    const size_t num_columns = error_bounds.size();
+    if (num_columns == 0 || num_rows * num_columns != data.size()) {
+        return std::unexpected(std::format("Quantized data size {} does not match {} rows of {} columns.", data.size(), num_rows, num_columns));
+    }
+    for (const double bound : error_bounds) {
+        if (!std::isfinite(bound) || bound <= 0.0) return std::unexpected(std::format("Error bound must be a positive finite number, got {}.", bound));
+    }
+
+    workspace.ensure_capacity(data.size());
+    int64_t* quantized = workspace.quantized();
+    memory::vector<double> scales(num_columns);
+    memory::vector<double> max_error(num_columns, 0.0);
+    memory::AlignedVector<T, static_cast<std::size_t>(HWY_ALIGNMENT)> back(num_rows);
+    bool exact = true;
+    for (size_t c = 0; c < num_columns && num_rows > 0; ++c) {
+        const T* column = data.data() + c * num_rows;
+        int64_t* column_quantized = quantized + c * num_rows;
+        double tolerance = error_bounds[c];
+        if (relative) {
+            double max_magnitude = 0.0;
+            for (size_t i = 0; i < num_rows; ++i) max_magnitude = std::max(max_magnitude, std::abs(static_cast<double>(column[i])));
+            tolerance *= max_magnitude;
+        }
+
+        // A grid step of twice the tolerance keeps rounding within it. An all-zero column has no tolerance but is
+        // exact on any grid.
+        double scale = tolerance > 0.0 ? 0.5 / tolerance : 1.0;
+        bool within = false;
+        for (int attempt = 0; attempt < kMaxGridRefinements && !within; ++attempt) {
+            // Non-finite values and integers beyond 2^53 cannot be represented.
+            if (!std::isfinite(scale) || !round_to_grid(column, column_quantized, num_rows, scale)) return std::optional<BoundedEncoded>{};
+            // Verified with the decoder's own dequantization, so the recorded bound is exactly what readers get.
+            dequantize(column_quantized, back.data(), num_rows, &scale, 1);
+            double error = 0.0;
+            for (size_t i = 0; i < num_rows; ++i) error = std::max(error, abs_difference_bound(static_cast<double>(back[i]), static_cast<double>(column[i])));
+            within = error <= tolerance;
+            if (within) {
+                scales[c] = scale;
+                max_error[c] = error;
+                exact &= std::memcmp(back.data(), column, num_rows * sizeof(T)) == 0;
+            }
+            scale *= 2.0;
+        }
+        if (!within) return std::optional<BoundedEncoded>{};
+    }
+    if (num_rows == 0) std::ranges::fill(scales, 1.0);
+
+    auto packed = pack(data.size(), 1, scales, workspace);
+    if (!packed) return std::unexpected(packed.error());
+
+    const size_t bounds_bytes = num_columns * sizeof(double);
+    BoundedEncoded encoded;
+    encoded.exact = exact;
+    encoded.payload.resize(kHeaderBytes + bounds_bytes + (*packed)->size());
+    const uint32_t header[2] = {static_cast<uint32_t>(num_columns), 0};
+    std::memcpy(encoded.payload.data(), header, kHeaderBytes);
+    std::memcpy(encoded.payload.data() + kHeaderBytes, max_error.data(), bounds_bytes);
+    std::memcpy(encoded.payload.data() + kHeaderBytes + bounds_bytes, (*packed)->data(), (*packed)->size());
+    return std::optional{std::move(encoded)};
+}
+
+std::expected<memory::vector<double>, std::string> FixedPointSimdCodec::max_abs_error(std::span<const std::byte> encoded) {
+    if (encoded.size() < kHeaderBytes) return std::unexpected("Quantized payload is too small for its header.");
+    uint32_t header[2];
+    std::memcpy(header, encoded.data(), kHeaderBytes);
+    if (header[1] != 0) return std::unexpected("Quantized payload has a non-zero reserved field.");
+    if (header[0] > (encoded.size() - kHeaderBytes) / sizeof(double)) return std::unexpected("Quantized payload is too small for its error bounds.");
+
+    memory::vector<double> bounds(header[0]);
+    std::memcpy(bounds.data(), encoded.data() + kHeaderBytes, bounds.size() * sizeof(double));
+    for (const double bound : bounds) {
+        if (!(bound >= 0.0)) return std::unexpected(std::format("Invalid quantization error bound {}.", bound));
+    }
+    return bounds;
+}
+
+template <typename T>
+std::expected<memory::AlignedVector<T, static_cast<std::size_t>(HWY_ALIGNMENT)>, std::string> FixedPointSimdCodec::decode_bounded(std::span<const std::byte> encoded, const size_t num_rows, const size_t num_columns) const {
+    auto bounds = max_abs_error(encoded);
+    if (!bounds) return std::unexpected(bounds.error());
+    if (bounds->size() != num_columns) {
+        return std::unexpected(std::format("Quantized payload has {} columns, expected {}.", bounds->size(), num_columns));
+    }
+    return decode<T>(encoded.subspan(kHeaderBytes + num_columns * sizeof(double)), FixedPointLayout::Columns, num_rows, num_columns);
+}
+
+FixedPointSimdCodec::EncodeResult FixedPointSimdCodec::encode32(std::span<const float> data, const FixedPointLayout layout, const size_t num_rows, std::span<const double> scales, FixedPointSimdCodecWorkspace& workspace) const {
+    return encode(data, layout, num_rows, scales, workspace);
+}
+
+FixedPointSimdCodec::EncodeResult FixedPointSimdCodec::encode64(std::span<const double> data, const FixedPointLayout layout, const size_t num_rows, std::span<const double> scales, FixedPointSimdCodecWorkspace& workspace) const {
+    return encode(data, layout, num_rows, scales, workspace);
+}
+
+std::expected<Float32AlignedVector, std::string> FixedPointSimdCodec::decode32(std::span<const std::byte> encoded, const FixedPointLayout layout, const size_t num_rows, const size_t row_elements) const {
+    return decode<float>(encoded, layout, num_rows, row_elements);
+}
+
+std::expected<Float64AlignedVector, std::string> FixedPointSimdCodec::decode64(std::span<const std::byte> encoded, const FixedPointLayout layout, const size_t num_rows, const size_t row_elements) const {
+    return decode<double>(encoded, layout, num_rows, row_elements);
+}
+
+FixedPointSimdCodec::BoundedEncodeResult FixedPointSimdCodec::encode_bounded32(std::span<const float> data, const size_t num_rows, std::span<const double> error_bounds, const bool relative, FixedPointSimdCodecWorkspace& workspace) const {
+    return encode_bounded(data, num_rows, error_bounds, relative, workspace);
+}
+
+FixedPointSimdCodec::BoundedEncodeResult FixedPointSimdCodec::encode_bounded64(std::span<const double> data, const size_t num_rows, std::span<const double> error_bounds, const bool relative, FixedPointSimdCodecWorkspace& workspace) const {
+    return encode_bounded(data, num_rows, error_bounds, relative, workspace);
+}
+
+std::expected<Float32AlignedVector, std::string> FixedPointSimdCodec::decode_bounded32(std::span<const std::byte> encoded, const size_t num_rows, const size_t num_columns) const {
+    return decode_bounded<float>(encoded, num_rows, num_columns);
+}
+
+std::expected<Float64AlignedVector, std::string> FixedPointSimdCodec::decode_bounded64(std::span<const std::byte> encoded, const size_t num_rows, const size_t num_columns) const {
+    return decode_bounded<double>(encoded, num_rows, num_columns);
+}
+
+} // namespace cryptodd
+#endif // HWY_ONCE
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "i_compressor.h"
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <hwy/aligned_allocator.h>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include "../memory/aligned.h"
+
+/**
+ * @file fixed_point_simd_codec.h
+ * @brief Fixed-point codec: lossless for floats that are integer multiples of a tick, or lossy within an error bound.
+ *
+ * Every value is quantized to q = round(x * scale), where scale is 1 / tick_size (see scale_for_tick()).
+ * A chunk is only encoded this way if q / scale gives back x bit for bit for every value, with |q| <= 2^53;
+ * otherwise encoding reports the chunk as off-grid and the caller falls back to a float codec. The integers
+ * then go through delta -> zigzag -> FOR/PFor bit-packing (bitpack_simd_codec.h) and the compressor:
+ *
+ *     uint32_t num_scales
+ *     uint32_t reserved                 // zero
+ *     double   scales[num_scales]
+ *     compressor(bitpack(zigzag(q[i] - q[i - lag])))   // q[i - lag] taken as 0 for i < lag
+ *
+ * Two layouts are supported:
+ * - Columns: `num_scales` columns of `num_rows` contiguous values, column c quantized with scales[c]. This is
+ *   a 1D series (one column) or Temporal 2D SoA data. lag = 1; each column boundary costs one PFor exception.
+ * - Rows: row-major rows of `row_elements` values (orderbook snapshots, features innermost), value i quantized
+ *   with scales[i % num_scales]. lag = row_elements, so every (level, feature) is delta-coded against the
+ *   previous snapshot.
+ *
+ * Chunks are self-contained: no state is carried over from the previous chunk.
+ *
+ * The same pipeline also serves error-bounded lossy quantization (encode_bounded32/64, Columns only): column c
+ * is rounded to a grid of step 2 * eps, where eps is error_bounds[c], or error_bounds[c] * max |x| over the
+ * column when the bound is relative. Encoding decodes the column again and halves the step while float rounding
+ * pushes some value past eps; the measured maximum error, rounded up, is stored in front of the fixed-point payload:
+ *
+ *     uint32_t num_columns
+ *     uint32_t reserved                 // zero
+ *     double   max_abs_error[num_columns]   // <= eps of the column, 0 when exact
+ *     <fixed-point payload as above>
+ *
+ * Columns that hold NaN or infinities, or whose grid would need integers beyond 2^53, are reported as
+ * unsupported, as off-grid chunks are.
+ */
+namespace cryptodd {
+
+using Float32AlignedVector = memory::AlignedVector<float, static_cast<std::size_t>(HWY_ALIGNMENT)>;
+using Float64AlignedVector = memory::AlignedVector<double, static_cast<std::size_t>(HWY_ALIGNMENT)>;
+using Int64AlignedVector = memory::AlignedVector<int64_t, static_cast<std::size_t>(HWY_ALIGNMENT)>;
+
+namespace simd {
+    // out[i] = round(data[i] * scales[i % period]). Returns false, leaving `out` partially written, as soon as a value is off-grid.
+    bool QuantizeFloat32_dispatcher(const float* data, int64_t* out, size_t num_elements, const double* scales, size_t period);
+    bool QuantizeFloat64_dispatcher(const double* data, int64_t* out, size_t num_elements, const double* scales, size_t period);
+
+    // out[i] = round(data[i] * scale) without the round-trip check. Returns false as soon as a value is non-finite or beyond 2^53.
+    bool RoundToGridFloat32_dispatcher(const float* data, int64_t* out, size_t num_elements, double scale);
+    bool RoundToGridFloat64_dispatcher(const double* data, int64_t* out, size_t num_elements, double scale);
+
+    // out[i] = quantized[i] / scales[i % period], rounded to the output type.
+    void DequantizeFloat32_dispatcher(const int64_t* quantized, float* out, size_t num_elements, const double* scales, size_t period);
+    void DequantizeFloat64_dispatcher(const int64_t* quantized, double* out, size_t num_elements, const double* scales, size_t period);
+
+    // out[i] = zigzag(data[i] - data[i - lag]), and its inverse. The inverse may run in place.
+    void ZigZagLagDeltaInt64_dispatcher(const int64_t* data, uint64_t* out, size_t num_elements, size_t lag);
+    void UnZigZagLagSumInt64_dispatcher(const uint64_t* zigzag, int64_t* out, size_t num_elements, size_t lag);
+}
+
+enum class FixedPointLayout : uint8_t {
+    Columns,
+    Rows,
+};
+
+class FixedPointSimdCodecWorkspace {
+public:
+    FixedPointSimdCodecWorkspace() = default;
+    FixedPointSimdCodecWorkspace(const FixedPointSimdCodecWorkspace&) = delete;
+    FixedPointSimdCodecWorkspace& operator=(const FixedPointSimdCodecWorkspace&) = delete;
+    FixedPointSimdCodecWorkspace(FixedPointSimdCodecWorkspace&&) noexcept = default;
+    FixedPointSimdCodecWorkspace& operator=(FixedPointSimdCodecWorkspace&&) noexcept = default;
+
+    void ensure_capacity(size_t required_elements) {
+        if (capacity_in_elements_ >= required_elements) return;
+        quantized_ = hwy::AllocateAligned<int64_t>(required_elements);
+        zigzag_ = hwy::AllocateAligned<uint64_t>(required_elements);
+        if (!quantized_ || !zigzag_) throw std::bad_alloc();
+        capacity_in_elements_ = required_elements;
+    }
+
+    [[nodiscard]] int64_t* quantized() { return quantized_.get(); }
+    [[nodiscard]] uint64_t* zigzag() { return zigzag_.get(); }
+
+private:
+    hwy::AlignedFreeUniquePtr<int64_t[]> quantized_;
+    hwy::AlignedFreeUniquePtr<uint64_t[]> zigzag_;
+    size_t capacity_in_elements_ = 0;
+};
+
+class FixedPointSimdCodec {
+public:
+    /** @brief Encoded payload, or std::nullopt when a value is off-grid and the chunk must use another codec. */
+    using EncodeResult = std::expected<std::optional<memory::vector<std::byte>>, std::string>;
+
+    struct BoundedEncoded {
+        memory::vector<std::byte> payload;
+        // False when some value does not round-trip bit for bit; max_abs_error() then holds the bounds.
+        bool exact = true;
+    };
+
+    /** @brief Encoded payload, or std::nullopt when some column cannot be quantized and the chunk must use another codec. */
+    using BoundedEncodeResult = std::expected<std::optional<BoundedEncoded>, std::string>;
+
+    explicit FixedPointSimdCodec(std::unique_ptr<ICompressor> compressor) : compressor_(std::move(compressor)) {
+        if (!compressor_) throw std::invalid_argument("Compressor cannot be null.");
+    }
+
+    /**
+     * @brief The scale stored for a tick size: 1 / tick_size, snapped to the nearest integer when within rounding
+     * error, so decimal ticks such as 0.01 decode by an exact division.
+     */
+    [[nodiscard]] static std::expected<double, std::string> scale_for_tick(double tick_size);
+
+    /**
+     * @brief Quantizes and encodes `data` (num_rows rows, see the file comment for `layout`).
+     * @param scales One scale per column (Columns), or per innermost feature (Rows, dividing the row length).
+     */
+    EncodeResult encode32(std::span<const float> data, FixedPointLayout layout, size_t num_rows, std::span<const double> scales, FixedPointSimdCodecWorkspace& workspace) const;
+    EncodeResult encode64(std::span<const double> data, FixedPointLayout layout, size_t num_rows, std::span<const double> scales, FixedPointSimdCodecWorkspace& workspace) const;
+
+    /**
+     * @brief Decodes num_rows * row_elements values. `row_elements` is the number of columns for Columns.
+     */
+    std::expected<Float32AlignedVector, std::string> decode32(std::span<const std::byte> encoded, FixedPointLayout layout, size_t num_rows, size_t row_elements) const;
+    std::expected<Float64AlignedVector, std::string> decode64(std::span<const std::byte> encoded, FixedPointLayout layout, size_t num_rows, size_t row_elements) const;
+
+    /**
+     * @brief Quantizes `num_rows` rows of error_bounds.size() contiguous columns within the given bounds (see the file comment).
+     * @param relative Whether error_bounds are relative to each column's largest magnitude rather than absolute.
+     */
+    BoundedEncodeResult encode_bounded32(std::span<const float> data, size_t num_rows, std::span<const double> error_bounds, bool relative, FixedPointSimdCodecWorkspace& workspace) const;
+    BoundedEncodeResult encode_bounded64(std::span<const double> data, size_t num_rows, std::span<const double> error_bounds, bool relative, FixedPointSimdCodecWorkspace& workspace) const;
+
+    std::expected<Float32AlignedVector, std::string> decode_bounded32(std::span<const std::byte> encoded, size_t num_rows, size_t num_columns) const;
+    std::expected<Float64AlignedVector, std::string> decode_bounded64(std::span<const std::byte> encoded, size_t num_rows, size_t num_columns) const;
+
+    /** @brief The per-column maximum absolute reconstruction error recorded in a bounded payload. */
+    [[nodiscard]] static std::expected<memory::vector<double>, std::string> max_abs_error(std::span<const std::byte> encoded);
+
+private:
+    // Delta-codes, bit-packs and compresses the first n integers of workspace.quantized() behind the scales header.
+    EncodeResult pack(size_t n, size_t lag, std::span<const double> scales, FixedPointSimdCodecWorkspace& workspace) const;
+
+    template <typename T>
+    EncodeResult encode(std::span<const T> data, FixedPointLayout layout, size_t num_rows, std::span<const double> scales, FixedPointSimdCodecWorkspace& workspace) const;
+    template <typename T>
+    std::expected<memory::AlignedVector<T, static_cast<std::size_t>(HWY_ALIGNMENT)>, std::string> decode(std::span<const std::byte> encoded, FixedPointLayout layout, size_t num_rows, size_t row_elements) const;
+    template <typename T>
+    BoundedEncodeResult encode_bounded(std::span<const T> data, size_t num_rows, std::span<const double> error_bounds, bool relative, FixedPointSimdCodecWorkspace& workspace) const;
+    template <typename T>
+    std::expected<memory::AlignedVector<T, static_cast<std::size_t>(HWY_ALIGNMENT)>, std::string> decode_bounded(std::span<const std::byte> encoded, size_t num_rows, size_t num_columns) const;
+
+    std::unique_ptr<ICompressor> compressor_;
+};
+
+} // namespace cryptodd
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "../memory/allocator.h" // Include to get the definition of memory::vector
+#include <algorithm>
 #include <expected>
+#include <functional>
 #include <span>
 #include <string>
 #include <vector>
@@ -11,8 +13,20 @@ namespace cryptodd {
 
 class ICompressor {
 public:
+    /**
+     * @brief Receives consecutive pieces of a decompressed stream. Returning an error aborts decompression.
+     */
+    using BlockSink = std::function<std::expected<void, std::string>(std::span<const std::byte> block)>;
+
     virtual ~ICompressor() = default;
 
+    /**
+     * @brief Returns the decompressed size recorded in the compressed data's header.
+     */
+    std::expected<size_t, std::string> get_decompress_size(std::span<const std::byte> compressed_data) {
+        return this->do_get_decompress_size(compressed_data);
+    }
+
     /**
      * @brief Compresses data directly into a vector with a specific allocator, avoiding copies.
      */
@@ -68,6 +82,31 @@ public:
         return this->decompress_to<Allocator>(compressed_data);
     }
 
+    /**
+     * @brief Decompresses data and hands it to `sink` in pieces of exactly `block_size` bytes (the last one may be shorter).
+     *
+     * Lets callers consume a large payload block by block while it stays cache-resident, instead of
+     * materialising the whole decompressed buffer first. The default implementation decompresses
+     * everything up front and slices it; streaming-capable compressors override it.
+     * @return The total number of decompressed bytes delivered to the sink.
+     */
+    virtual std::expected<size_t, std::string> decompress_blocks(std::span<const std::byte> compressed_data, size_t block_size, const BlockSink& sink) {
+        if (block_size == 0) {
+            return std::unexpected("Block size must be greater than zero.");
+        }
+        auto decompressed = this->decompress(compressed_data);
+        if (!decompressed) {
+            return std::unexpected(decompressed.error());
+        }
+        const std::span<const std::byte> all(*decompressed);
+        for (size_t offset = 0; offset < all.size(); offset += block_size) {
+            if (auto result = sink(all.subspan(offset, std::min(block_size, all.size() - offset))); !result) {
+                return std::unexpected(result.error());
+            }
+        }
+        return all.size();
+    }
+
 protected:
     // --- New Core Virtual Interface for derived classes ---
     // These methods operate on raw spans, allowing the caller to manage allocation.
@@ -0,0 +1,257 @@
+#include "orderbook_bfp16_codec.h"
+// Declares the XOR + shuffle kernels; it refuses to be included once highway.h is.
+#include "orderbook_simd_codec.h"
+
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "orderbook_bfp16_codec.cpp"
+#include "hwy/foreach_target.h"
+
+#include <hwy/highway.h>
+
+HWY_BEFORE_NAMESPACE();
+namespace cryptodd::HWY_NAMESPACE {
+
+namespace hn = hwy::HWY_NAMESPACE;
+
+HWY_NOINLINE void Bfp16Quantize(const float* HWY_RESTRICT data, const float* HWY_RESTRICT refs, const float* HWY_RESTRICT inv_scales, float* HWY_RESTRICT q, size_t num_elements) {
+    size_t i = 0;
+#if HWY_TARGET != HWY_SCALAR
+    const hn::ScalableTag<float> d32;
+    const hn::Rebind<hwy::float16_t, decltype(d32)> d16;
+    const size_t lanes = hn::Lanes(d32);
+    for (; i + lanes <= num_elements; i += lanes) {
+        const auto v_scaled = hn::Mul(hn::Sub(hn::LoadU(d32, data + i), hn::LoadU(d32, refs + i)), hn::LoadU(d32, inv_scales + i));
+        hn::StoreU(hn::PromoteTo(d32, hn::DemoteTo(d16, v_scaled)), d32, q + i);
+    }
+#endif
+    for (; i < num_elements; ++i) {
+        const float scaled = (data[i] - refs[i]) * inv_scales[i];
+        q[i] = hwy::ConvertScalarTo<float>(hwy::ConvertScalarTo<hwy::float16_t>(scaled));
+    }
+}
+
+// q * scale is exact (11 significant bits times a power of two), so fusing it into the add changes nothing.
+HWY_NOINLINE void Bfp16Reconstruct(const float* q, const float* HWY_RESTRICT refs, const float* HWY_RESTRICT scales, float* out, size_t num_elements) {
+    size_t i = 0;
+#if HWY_TARGET != HWY_SCALAR
+    const hn::ScalableTag<float> d32;
+    const size_t lanes = hn::Lanes(d32);
+    for (; i + lanes <= num_elements; i += lanes) {
+        const auto v_value = hn::Add(hn::LoadU(d32, refs + i), hn::Mul(hn::LoadU(d32, q + i), hn::LoadU(d32, scales + i)));
+        hn::StoreU(v_value, d32, out + i);
+    }
+#endif
+    for (; i < num_elements; ++i) {
+        out[i] = refs[i] + q[i] * scales[i];
+    }
+}
+
+} // namespace cryptodd::HWY_NAMESPACE
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <format>
+#include <limits>
+
+namespace cryptodd {
+
+namespace simd {
+    HWY_EXPORT(Bfp16Quantize);
+    void Bfp16Quantize_dispatcher(const float* data, const float* refs, const float* inv_scales, float* q, size_t num_elements) {
+        HWY_DYNAMIC_DISPATCH(Bfp16Quantize)(data, refs, inv_scales, q, num_elements);
+    }
+
+    HWY_EXPORT(Bfp16Reconstruct);
+    void Bfp16Reconstruct_dispatcher(const float* q, const float* refs, const float* scales, float* out, size_t num_elements) {
+        HWY_DYNAMIC_DISPATCH(Bfp16Reconstruct)(q, refs, scales, out, num_elements);
+    }
+} // namespace simd
+
+namespace {
+    constexpr size_t kHeaderBytes = 2 * sizeof(uint32_t);
+    // The largest residual is scaled below 2^15, which f16 (max 65504) holds with 11 significant bits.
+    constexpr int kResidualExponent = 15;
+    // Keeps 2^e and 2^-e normal floats, so q * 2^e never rounds.
+    constexpr int kMinExponent = -100;
+    constexpr int kMaxExponent = 113;
+
+    struct Group {
+        float ref = 0.0f;
+        int8_t exponent = 0;
+    };
+
+    // Picks the reference and exponent of one feature over the depth levels of a snapshot. `values` points at
+    // the feature's level-0 value; levels are `stride` floats apart.
+    std::optional<Group> plan_group(const float* values, const size_t depth, const size_t stride) {
+        float lo = values[0];
+        float hi = values[0];
+        for (size_t level = 0; level < depth; ++level) {
+            const float x = values[level * stride];
+            if (!std::isfinite(x)) return std::nullopt;
+            lo = std::min(lo, x);
+            hi = std::max(hi, x);
+        }
+        // A value of the group rather than the exact midpoint, so residuals stay on the data's own grid.
+        const double mid = 0.5 * (static_cast<double>(lo) + static_cast<double>(hi));
+        float ref = values[0];
+        for (size_t level = 1; level < depth; ++level) {
+            const float x = values[level * stride];
+            if (std::abs(static_cast<double>(x) - mid) < std::abs(static_cast<double>(ref) - mid)) ref = x;
+        }
+        const double max_abs = std::max(static_cast<double>(hi) - ref, ref - static_cast<double>(lo));
+        if (max_abs > std::numeric_limits<float>::max()) return std::nullopt;
+
+        Group group{ref, 0};
+        if (max_abs > 0.0) {
+            group.exponent = static_cast<int8_t>(std::clamp(std::ilogb(max_abs) + 1 - kResidualExponent, kMinExponent, kMaxExponent));
+        }
+        return group;
+    }
+
+    // Repeats the per-feature references and scales of one snapshot over its depth levels.
+    void expand_rows(const float* refs, const int8_t* exponents, const size_t depth, const size_t features,
+                     float* ref_row, float* scale_row, float* inv_scale_row) {
+        for (size_t f = 0; f < features; ++f) {
+            const float scale = std::ldexp(1.0f, exponents[f]);
+            const float inv_scale = std::ldexp(1.0f, -exponents[f]);
+            for (size_t level = 0; level < depth; ++level) {
+                ref_row[level * features + f] = refs[f];
+                scale_row[level * features + f] = scale;
+                if (inv_scale_row) inv_scale_row[level * features + f] = inv_scale;
+            }
+        }
+    }
+
+    size_t streams_size(const size_t num_snapshots, const size_t depth, const size_t features) {
+        const size_t num_groups = num_snapshots * features;
+        return num_groups * sizeof(float) + num_groups * sizeof(int8_t) + num_groups * depth * sizeof(uint16_t);
+    }
+}
+
+OrderbookBfp16Codec::EncodeResult OrderbookBfp16Codec::encode(std::span<const float> snapshots, const size_t depth, const size_t features, OrderbookBfp16CodecWorkspace& workspace) const {
+    const size_t snapshot_floats = depth * features;
+    if (snapshot_floats == 0 || snapshots.size() % snapshot_floats != 0) {
+        return std::unexpected(std::format("Orderbook data size {} is not a multiple of the snapshot size {}.", snapshots.size(), snapshot_floats));
+    }
+    const size_t num_snapshots = snapshots.size() / snapshot_floats;
+    const size_t num_groups = num_snapshots * features;
+    workspace.ensure_capacity(snapshots.size());
+    float* q = workspace.residuals();
+    float* reconstructed = workspace.reconstructed();
+
+    memory::vector<float> refs(num_groups);
+    memory::vector<int8_t> exponents(num_groups);
+    Float32AlignedVector ref_row(snapshot_floats);
+    Float32AlignedVector scale_row(snapshot_floats);
+    Float32AlignedVector inv_scale_row(snapshot_floats);
+    memory::vector<double> max_error(features, 0.0);
+    bool exact = true;
+
+    for (size_t s = 0; s < num_snapshots; ++s) {
+        const float* snapshot = snapshots.data() + s * snapshot_floats;
+        for (size_t f = 0; f < features; ++f) {
+            const auto group = plan_group(snapshot + f, depth, features);
+            if (!group) return std::optional<Encoded>{};
+            refs[s * features + f] = group->ref;
+            exponents[s * features + f] = group->exponent;
+        }
+        expand_rows(refs.data() + s * features, exponents.data() + s * features, depth, features, ref_row.data(), scale_row.data(), inv_scale_row.data());
+
+        float* snapshot_q = q + s * snapshot_floats;
+        float* snapshot_back = reconstructed + s * snapshot_floats;
+        simd::Bfp16Quantize_dispatcher(snapshot, ref_row.data(), inv_scale_row.data(), snapshot_q, snapshot_floats);
+        // Measured with the decoder's own kernel, so the recorded bounds are exactly what readers get.
+        simd::Bfp16Reconstruct_dispatcher(snapshot_q, ref_row.data(), scale_row.data(), snapshot_back, snapshot_floats);
+        for (size_t level = 0; level < depth; ++level) {
+            for (size_t f = 0; f < features; ++f) {
+                const size_t i = level * features + f;
+                exact &= std::bit_cast<uint32_t>(snapshot_back[i]) == std::bit_cast<uint32_t>(snapshot[i]);
+                max_error[f] = std::max(max_error[f], std::abs(static_cast<double>(snapshot_back[i]) - static_cast<double>(snapshot[i])));
+            }
+        }
+    }
+
+    const size_t refs_bytes = num_groups * sizeof(float);
+    memory::vector<std::byte> streams(streams_size(num_snapshots, depth, features));
+    auto* out = reinterpret_cast<uint8_t*>(streams.data()); // NOLINT
+    const Float32AlignedVector zeros(snapshot_floats, 0.0f);
+    simd::XorShuffleFloat32_dispatcher(refs.data(), zeros.data(), out, num_snapshots, features);
+    std::memcpy(out + refs_bytes, exponents.data(), num_groups);
+    simd::DemoteXorShuffle16_dispatcher(q, zeros.data(), out + refs_bytes + num_groups, num_snapshots, snapshot_floats);
+
+    auto compressed = compressor_->compress(streams);
+    if (!compressed) return std::unexpected(compressed.error());
+
+    Encoded encoded;
+    encoded.exact = exact;
+    encoded.payload.resize(kHeaderBytes + features * sizeof(double) + compressed->size());
+    const uint32_t header[2] = {static_cast<uint32_t>(features), 0};
+    std::memcpy(encoded.payload.data(), header, kHeaderBytes);
+    std::memcpy(encoded.payload.data() + kHeaderBytes, max_error.data(), features * sizeof(double));
+    std::memcpy(encoded.payload.data() + kHeaderBytes + features * sizeof(double), compressed->data(), compressed->size());
+    return std::optional{std::move(encoded)};
+}
+
+std::expected<memory::vector<double>, std::string> OrderbookBfp16Codec::max_abs_error(std::span<const std::byte> encoded) {
+    if (encoded.size() < kHeaderBytes) return std::unexpected("BFP16 orderbook payload is too small for its header.");
+    uint32_t header[2];
+    std::memcpy(header, encoded.data(), kHeaderBytes);
+    if (header[1] != 0) return std::unexpected("BFP16 orderbook payload has a non-zero reserved field.");
+    if (header[0] > (encoded.size() - kHeaderBytes) / sizeof(double)) return std::unexpected("BFP16 orderbook payload is too small for its error bounds.");
+
+    memory::vector<double> bounds(header[0]);
+    std::memcpy(bounds.data(), encoded.data() + kHeaderBytes, bounds.size() * sizeof(double));
+    for (const double bound : bounds) {
+        if (!(bound >= 0.0)) return std::unexpected(std::format("Invalid BFP16 orderbook error bound {}.", bound));
+    }
+    return bounds;
+}
+
+std::expected<Float32AlignedVector, std::string> OrderbookBfp16Codec::decode(std::span<const std::byte> encoded, const size_t num_snapshots, const size_t depth, const size_t features) const {
+    auto bounds = max_abs_error(encoded);
+    if (!bounds) return std::unexpected(bounds.error());
+    if (bounds->size() != features) {
+        return std::unexpected(std::format("BFP16 orderbook payload has {} features, expected {}.", bounds->size(), features));
+    }
+    const size_t snapshot_floats = depth * features;
+    if (num_snapshots == 0 || snapshot_floats == 0) return Float32AlignedVector{};
+
+    auto streams = compressor_->decompress(encoded.subspan(kHeaderBytes + features * sizeof(double)));
+    if (!streams) return std::unexpected(streams.error());
+    if (streams->size() != streams_size(num_snapshots, depth, features)) {
+        return std::unexpected("Decompressed data size does not match expected size for the given number of snapshots.");
+    }
+
+    const size_t num_groups = num_snapshots * features;
+    const size_t refs_bytes = num_groups * sizeof(float);
+    const auto* in = reinterpret_cast<const uint8_t*>(streams->data()); // NOLINT
+    memory::vector<int8_t> exponents(num_groups);
+    std::memcpy(exponents.data(), in + refs_bytes, num_groups);
+    for (const int8_t exponent : exponents) {
+        if (exponent < kMinExponent || exponent > kMaxExponent) return std::unexpected(std::format("Invalid BFP16 orderbook exponent {}.", exponent));
+    }
+
+    Float32AlignedVector refs(num_groups);
+    Float32AlignedVector ref_state(features, 0.0f);
+    simd::UnshuffleAndReconstructFloat32_dispatcher(in, refs.data(), num_snapshots, features, ref_state);
+
+    Float32AlignedVector out(num_snapshots * snapshot_floats);
+    Float32AlignedVector q_state(snapshot_floats, 0.0f);
+    simd::UnshuffleAndReconstruct_dispatcher(in + refs_bytes + num_groups, out.data(), num_snapshots, snapshot_floats, q_state);
+
+    Float32AlignedVector ref_row(snapshot_floats);
+    Float32AlignedVector scale_row(snapshot_floats);
+    for (size_t s = 0; s < num_snapshots; ++s) {
+        expand_rows(refs.data() + s * features, exponents.data() + s * features, depth, features, ref_row.data(), scale_row.data(), nullptr);
+        float* snapshot = out.data() + s * snapshot_floats;
+        simd::Bfp16Reconstruct_dispatcher(snapshot, ref_row.data(), scale_row.data(), snapshot, snapshot_floats);
+    }
+    return out;
+}
+
+} // namespace cryptodd
+#endif // HWY_ONCE
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "i_compressor.h"
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <hwy/aligned_allocator.h>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include "../memory/aligned.h"
+
+/**
+ * @file orderbook_bfp16_codec.h
+ * @brief Block-floating-point f16 orderbook codec: f16 residuals against a per-snapshot, per-feature reference.
+ *
+ * Demoting raw values to f16 (GENERIC_OB_SIMD_F16_AS_F32) keeps 11 significant bits of the value itself, so a
+ * price of 65'000 is stored to the nearest 32 and sizes below 2^-24 vanish. This codec instead gives every
+ * (snapshot, feature) group of `depth` values a float reference `ref` (the value closest to the middle of the
+ * group's range) and a shared power-of-two exponent `e`, and stores each value as the f16 residual
+ *
+ *     q = f16((x - ref) * 2^-e)        with e chosen so that max |x - ref| * 2^-e < 2^15
+ *
+ * Values decode as x' = ref + q * 2^e in float arithmetic. q * 2^e is exact, so decoding rounds once and gives
+ * the same result on every SIMD target, with or without FMA. Per group,
+ *
+ *     |x' - x| <= (2^-11 + 2^-24) * max |x - ref| + ulp(x') / 2
+ *
+ * (groups whose range is below 2^-85 are instead within 2^-124), and values are restored exactly whenever the
+ * residuals fit in 11 significant bits at that exponent (e.g. prices on a binary tick spanning fewer than 2048
+ * ticks around the reference). The encoder measures the actual maximum error of every feature over the chunk and
+ * stores it in the payload:
+ *
+ *     uint32_t num_features
+ *     uint32_t reserved                            // zero
+ *     double   max_abs_error[num_features]         // max |x' - x| over the chunk, 0 when exact
+ *     compressor(
+ *         shuffle4(xor(ref[s][f], ref[s - 1][f]))  // num_snapshots * num_features float references
+ *         int8_t   exponent[s][f]
+ *         shuffle2(xor(q[s][i], q[s - 1][i]))      // num_snapshots * depth * num_features f16 residuals
+ *     )
+ *
+ * The first snapshot is XORed against zeros, so chunks are self-contained. Groups holding NaN, infinities, or a
+ * range that overflows float cannot be represented; encoding then reports the chunk as unsupported and the
+ * caller falls back to a lossless codec.
+ */
+namespace cryptodd {
+
+using Float32AlignedVector = memory::AlignedVector<float, static_cast<std::size_t>(HWY_ALIGNMENT)>;
+
+namespace simd {
+    // q[i] = f16((data[i] - refs[i]) * inv_scales[i]), widened back to float.
+    void Bfp16Quantize_dispatcher(const float* data, const float* refs, const float* inv_scales, float* q, size_t num_elements);
+    // out[i] = refs[i] + q[i] * scales[i]. `q` and `out` may alias.
+    void Bfp16Reconstruct_dispatcher(const float* q, const float* refs, const float* scales, float* out, size_t num_elements);
+}
+
+class OrderbookBfp16CodecWorkspace {
+public:
+    OrderbookBfp16CodecWorkspace() = default;
+    OrderbookBfp16CodecWorkspace(const OrderbookBfp16CodecWorkspace&) = delete;
+    OrderbookBfp16CodecWorkspace& operator=(const OrderbookBfp16CodecWorkspace&) = delete;
+    OrderbookBfp16CodecWorkspace(OrderbookBfp16CodecWorkspace&&) noexcept = default;
+    OrderbookBfp16CodecWorkspace& operator=(OrderbookBfp16CodecWorkspace&&) noexcept = default;
+
+    void ensure_capacity(size_t required_floats) {
+        if (capacity_in_floats_ >= required_floats) return;
+        residuals_ = hwy::AllocateAligned<float>(required_floats);
+        reconstructed_ = hwy::AllocateAligned<float>(required_floats);
+        if (!residuals_ || !reconstructed_) throw std::bad_alloc();
+        capacity_in_floats_ = required_floats;
+    }
+
+    [[nodiscard]] float* residuals() { return residuals_.get(); }
+    [[nodiscard]] float* reconstructed() { return reconstructed_.get(); }
+
+private:
+    hwy::AlignedFreeUniquePtr<float[]> residuals_;
+    hwy::AlignedFreeUniquePtr<float[]> reconstructed_;
+    size_t capacity_in_floats_ = 0;
+};
+
+class OrderbookBfp16Codec {
+public:
+    struct Encoded {
+        memory::vector<std::byte> payload;
+        // False when some value does not round-trip bit for bit; max_abs_error() then holds the bounds.
+        bool exact = true;
+    };
+
+    /** @brief Encoded payload, or std::nullopt when some group cannot be represented and the chunk must use another codec. */
+    using EncodeResult = std::expected<std::optional<Encoded>, std::string>;
+
+    explicit OrderbookBfp16Codec(std::unique_ptr<ICompressor> compressor) : compressor_(std::move(compressor)) {
+        if (!compressor_) throw std::invalid_argument("Compressor cannot be null.");
+    }
+
+    /** @brief Encodes num_snapshots = snapshots.size() / (depth * features) row-major snapshots (features innermost). */
+    EncodeResult encode(std::span<const float> snapshots, size_t depth, size_t features, OrderbookBfp16CodecWorkspace& workspace) const;
+
+    std::expected<Float32AlignedVector, std::string> decode(std::span<const std::byte> encoded, size_t num_snapshots, size_t depth, size_t features) const;
+
+    /** @brief The per-feature maximum absolute reconstruction error recorded in an encoded payload. */
+    [[nodiscard]] static std::expected<memory::vector<double>, std::string> max_abs_error(std::span<const std::byte> encoded);
+
+private:
+    std::unique_ptr<ICompressor> compressor_;
+};
+
+} // namespace cryptodd
@@ -272,6 +272,91 @@ HWY_NOINLINE void ShuffleFloat32(const float* HWY_RESTRICT in, uint8_t* HWY_REST
     }
 }
 
+// --- FUSED ENCODING PIPELINE ---
+// Demote/XOR and byte-transpose in registers, writing each delta straight into its byte
+// planes. Output is byte-identical to DemoteAndXor + ShuffleFloat16 (resp. XorFloat32 +
+// ShuffleFloat32) but skips the round trip through the intermediate delta buffer.
+
+HWY_INLINE void DemoteXorShuffleRow16(const float* HWY_RESTRICT current, const float* HWY_RESTRICT prev,
+                                      uint8_t* HWY_RESTRICT out_b0, uint8_t* HWY_RESTRICT out_b1, size_t num_floats) {
+    size_t i = 0;
+
+#if HWY_TARGET != HWY_SCALAR
+    const hn::Rebind<hwy::float16_t, decltype(d32)> d16_half;
+    const hn::Rebind<uint16_t, decltype(d32)> du16_half;
+    const hn::Rebind<uint8_t, decltype(d32)> du8_quarter;
+    const size_t f32_lanes = hn::Lanes(d32);
+
+    for (; i + f32_lanes <= num_floats; i += f32_lanes) {
+        const auto v_curr_u16 = hn::BitCast(du16_half, hn::DemoteTo(d16_half, hn::LoadU(d32, current + i)));
+        const auto v_prev_u16 = hn::BitCast(du16_half, hn::DemoteTo(d16_half, hn::LoadU(d32, prev + i)));
+        const auto v_xor_u16 = hn::Xor(v_curr_u16, v_prev_u16);
+
+        hn::StoreU(hn::TruncateTo(du8_quarter, v_xor_u16), du8_quarter, out_b0 + i);
+        hn::StoreU(hn::TruncateTo(du8_quarter, hn::ShiftRight<8>(v_xor_u16)), du8_quarter, out_b1 + i);
+    }
+#endif
+
+    for (; i < num_floats; ++i) {
+        const hwy::float16_t f16_curr = hwy::ConvertScalarTo<hwy::float16_t>(current[i]);
+        const hwy::float16_t f16_prev = hwy::ConvertScalarTo<hwy::float16_t>(prev[i]);
+        const uint16_t u16_xor = hwy::BitCastScalar<uint16_t>(f16_curr) ^ hwy::BitCastScalar<uint16_t>(f16_prev);
+        out_b0[i] = static_cast<uint8_t>(u16_xor & 0xFF);
+        out_b1[i] = static_cast<uint8_t>(u16_xor >> 8);
+    }
+}
+
+HWY_INLINE void XorShuffleRow32(const float* HWY_RESTRICT current, const float* HWY_RESTRICT prev,
+                                uint8_t* HWY_RESTRICT out_b0, uint8_t* HWY_RESTRICT out_b1,
+                                uint8_t* HWY_RESTRICT out_b2, uint8_t* HWY_RESTRICT out_b3, size_t num_floats) {
+    size_t i = 0;
+
+#if HWY_TARGET != HWY_SCALAR
+    const hn::Rebind<uint8_t, decltype(d32)> du8_quarter;
+    const size_t f32_lanes = hn::Lanes(d32);
+
+    for (; i + f32_lanes <= num_floats; i += f32_lanes) {
+        const VU32 v_curr_u32 = hn::BitCast(du32, hn::LoadU(d32, current + i));
+        const VU32 v_prev_u32 = hn::BitCast(du32, hn::LoadU(d32, prev + i));
+        const VU32 v_xor_u32 = hn::Xor(v_curr_u32, v_prev_u32);
+
+        hn::StoreU(hn::TruncateTo(du8_quarter, v_xor_u32), du8_quarter, out_b0 + i);
+        hn::StoreU(hn::TruncateTo(du8_quarter, hn::ShiftRight<8>(v_xor_u32)), du8_quarter, out_b1 + i);
+        hn::StoreU(hn::TruncateTo(du8_quarter, hn::ShiftRight<16>(v_xor_u32)), du8_quarter, out_b2 + i);
+        hn::StoreU(hn::TruncateTo(du8_quarter, hn::ShiftRight<24>(v_xor_u32)), du8_quarter, out_b3 + i);
+    }
+#endif
+
+    for (; i < num_floats; ++i) {
+        const uint32_t u32_xor = hwy::BitCastScalar<uint32_t>(current[i]) ^ hwy::BitCastScalar<uint32_t>(prev[i]);
+        out_b0[i] = static_cast<uint8_t>((u32_xor      ) & 0xFF);
+        out_b1[i] = static_cast<uint8_t>((u32_xor >> 8 ) & 0xFF);
+        out_b2[i] = static_cast<uint8_t>((u32_xor >> 16) & 0xFF);
+        out_b3[i] = static_cast<uint8_t>((u32_xor >> 24) & 0xFF);
+    }
+}
+
+HWY_NOINLINE void DemoteXorShuffle16(const float* HWY_RESTRICT snapshots, const float* HWY_RESTRICT prev_snapshot,
+                                     uint8_t* HWY_RESTRICT out, size_t num_snapshots, size_t snapshot_floats) {
+    const size_t total_floats = num_snapshots * snapshot_floats;
+    for (size_t s = 0; s < num_snapshots; ++s) {
+        const size_t base_idx = s * snapshot_floats;
+        const float* prev = (s == 0) ? prev_snapshot : snapshots + base_idx - snapshot_floats;
+        DemoteXorShuffleRow16(snapshots + base_idx, prev, out + base_idx, out + total_floats + base_idx, snapshot_floats);
+    }
+}
+
+HWY_NOINLINE void XorShuffleFloat32(const float* HWY_RESTRICT snapshots, const float* HWY_RESTRICT prev_snapshot,
+                                    uint8_t* HWY_RESTRICT out, size_t num_snapshots, size_t snapshot_floats) {
+    const size_t total_floats = num_snapshots * snapshot_floats;
+    for (size_t s = 0; s < num_snapshots; ++s) {
+        const size_t base_idx = s * snapshot_floats;
+        const float* prev = (s == 0) ? prev_snapshot : snapshots + base_idx - snapshot_floats;
+        XorShuffleRow32(snapshots + base_idx, prev, out + base_idx, out + total_floats + base_idx,
+                        out + 2 * total_floats + base_idx, out + 3 * total_floats + base_idx, snapshot_floats);
+    }
+}
+
 
 void UnshuffleAndReconstructFloat32(const uint8_t* HWY_RESTRICT shuffled_in, float* HWY_RESTRICT out,
                                     size_t num_snapshots, size_t snapshot_floats,
@@ -545,5 +630,15 @@ HWY_NOINLINE void simd::UnshuffleAndReconstructFloat32_dispatcher(const uint8_t*
     HWY_DYNAMIC_DISPATCH(UnshuffleAndReconstructFloat32)(shuffled_in, out, num_snapshots, snapshot_floats, last_snapshot_state);
 }
 
+HWY_EXPORT(DemoteXorShuffle16);
+HWY_NOINLINE void simd::DemoteXorShuffle16_dispatcher(const float* snapshots, const float* prev_snapshot, uint8_t* out, size_t num_snapshots, size_t snapshot_floats) {
+    HWY_DYNAMIC_DISPATCH(DemoteXorShuffle16)(snapshots, prev_snapshot, out, num_snapshots, snapshot_floats);
+}
+
+HWY_EXPORT(XorShuffleFloat32);
+HWY_NOINLINE void simd::XorShuffleFloat32_dispatcher(const float* snapshots, const float* prev_snapshot, uint8_t* out, size_t num_snapshots, size_t snapshot_floats) {
+    HWY_DYNAMIC_DISPATCH(XorShuffleFloat32)(snapshots, prev_snapshot, out, num_snapshots, snapshot_floats);
+}
+
 } // namespace cryptodd
 #endif // HWY_ONCE
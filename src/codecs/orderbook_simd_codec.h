@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <expected>
 #include <array>
 #include <memory>
@@ -36,6 +37,12 @@ void XorFloat32_dispatcher(const float* current, const float* prev, float* out,
 void ShuffleFloat32_dispatcher(const float* in, uint8_t* out, size_t num_f32);
 void UnshuffleAndReconstructFloat32_dispatcher(const uint8_t* shuffled_in, float* out, size_t num_snapshots, size_t snapshot_floats, std::span<float> last_snapshot_state);
 
+// Fused single-pass encoders: XOR against the previous snapshot (demoting to f16 first for the 16-bit
+// variant) and scatter the delta bytes into planes in one sweep. Byte-identical to the two-pass
+// DemoteAndXor/XorFloat32 + Shuffle*_dispatcher pipeline, which is kept as the reference path.
+void DemoteXorShuffle16_dispatcher(const float* snapshots, const float* prev_snapshot, uint8_t* out, size_t num_snapshots, size_t snapshot_floats);
+void XorShuffleFloat32_dispatcher(const float* snapshots, const float* prev_snapshot, uint8_t* out, size_t num_snapshots, size_t snapshot_floats);
+
 }
 class OrderbookSimdCodecWorkspace;
 
@@ -43,11 +50,11 @@ namespace detail {
     // Forward declare implementation functions that need privileged access to the workspace.
     inline std::expected<memory::vector<std::byte>, std::string> encode16_impl(std::span<const float> snapshots, std::span<const float> prev_snapshot,
                                               size_t num_snapshots, size_t snapshot_floats, ICompressor& compressor,
-                                              OrderbookSimdCodecWorkspace& workspace);
+                                              OrderbookSimdCodecWorkspace& workspace, codecs::ShuffleLayout layout);
 
     inline std::expected<memory::vector<std::byte>, std::string> encode32_impl(std::span<const float> snapshots, std::span<const float> prev_snapshot,
                                               size_t num_snapshots, size_t snapshot_floats, ICompressor& compressor,
-                                              OrderbookSimdCodecWorkspace& workspace);
+                                              OrderbookSimdCodecWorkspace& workspace, codecs::ShuffleLayout layout);
 }// namespace detail
 
 /**
@@ -131,8 +138,8 @@ public:
 private:
     // Grant access to our internal implementation functions. They need the raw
     // hwy::AlignedFreeUniquePtr to guarantee the alignment contract for SIMD operations.
-    friend std::expected<memory::vector<std::byte>, std::string> detail::encode16_impl(std::span<const float>, std::span<const float>, size_t, size_t, ICompressor&, OrderbookSimdCodecWorkspace&);
-    friend std::expected<memory::vector<std::byte>, std::string> detail::encode32_impl(std::span<const float>, std::span<const float>, size_t, size_t, ICompressor&, OrderbookSimdCodecWorkspace&);
+    friend std::expected<memory::vector<std::byte>, std::string> detail::encode16_impl(std::span<const float>, std::span<const float>, size_t, size_t, ICompressor&, OrderbookSimdCodecWorkspace&, codecs::ShuffleLayout);
+    friend std::expected<memory::vector<std::byte>, std::string> detail::encode32_impl(std::span<const float>, std::span<const float>, size_t, size_t, ICompressor&, OrderbookSimdCodecWorkspace&, codecs::ShuffleLayout);
 
     hwy::AlignedFreeUniquePtr<hwy::float16_t[]> f16_deltas_;
     hwy::AlignedFreeUniquePtr<float[]> f32_deltas_;
@@ -142,25 +149,37 @@ private:
 
 namespace detail {
 
+using ObEncodeFn = void (*)(const float*, const float*, uint8_t*, size_t, size_t);
+using ObDecodeFn = void (*)(const uint8_t*, float*, size_t, size_t, std::span<float>);
+
+// Runs the fused XOR+shuffle encoder over the whole chunk (Global) or one row block at a time (Blocked).
+// A block's first snapshot is XORed against the last snapshot of the previous block, so the deltas are
+// identical in both layouts; only the placement of the byte planes differs.
+inline void encode_planes(const ObEncodeFn encode, const float* snapshots, const float* prev_snapshot, uint8_t* out,
+                          const size_t num_snapshots, const size_t snapshot_floats, const size_t elem_size,
+                          const codecs::ShuffleLayout layout) {
+    if (layout == codecs::ShuffleLayout::Global) {
+        encode(snapshots, prev_snapshot, out, num_snapshots, snapshot_floats);
+        return;
+    }
+    const size_t rows_per_block = codecs::ShuffleBlock::rows_per_block(snapshot_floats * elem_size);
+    for (size_t row = 0; row < num_snapshots; row += rows_per_block) {
+        const size_t rows = std::min(rows_per_block, num_snapshots - row);
+        const float* prev = row == 0 ? prev_snapshot : snapshots + (row - 1) * snapshot_floats;
+        encode(snapshots + row * snapshot_floats, prev, out + row * snapshot_floats * elem_size, rows, snapshot_floats);
+    }
+}
+
 inline std::expected<memory::vector<std::byte>, std::string> encode16_impl(std::span<const float> snapshots, std::span<const float> prev_snapshot,
                                           size_t num_snapshots, size_t snapshot_floats, ICompressor& compressor,
-                                          OrderbookSimdCodecWorkspace& workspace) {
+                                          OrderbookSimdCodecWorkspace& workspace, const codecs::ShuffleLayout layout) {
     const size_t num_floats = snapshots.size();
-    hwy::float16_t* f16_deltas_ptr = workspace.f16_deltas().data();
-
-    simd::DemoteAndXor_dispatcher(snapshots.data(), prev_snapshot.data(), f16_deltas_ptr, snapshot_floats);
-    for (size_t s = 1; s < num_snapshots; ++s) {
-        const float* current_snap = snapshots.data() + s * snapshot_floats;
-        const float* prev_snap = snapshots.data() + (s - 1) * snapshot_floats;
-        hwy::float16_t* out_snap = f16_deltas_ptr + s * snapshot_floats;
-        simd::DemoteAndXor_dispatcher(current_snap, prev_snap, out_snap, snapshot_floats);
-    }
-
     const size_t f16_bytes = num_floats * sizeof(hwy::float16_t);
     uint8_t* shuffled_bytes_ptr = workspace.shuffled_bytes().data();
-    assert(workspace.shuffled_bytes().size_bytes() >= workspace.f16_deltas().size_bytes());
+    assert(workspace.shuffled_bytes().size_bytes() >= f16_bytes);
 
-    simd::ShuffleFloat16_dispatcher(f16_deltas_ptr, shuffled_bytes_ptr, num_floats);
+    encode_planes(&simd::DemoteXorShuffle16_dispatcher, snapshots.data(), prev_snapshot.data(), shuffled_bytes_ptr,
+                  num_snapshots, snapshot_floats, sizeof(hwy::float16_t), layout);
 
     static_assert(sizeof(std::byte) == sizeof(uint8_t));
     std::span<const std::byte> data_to_compress(reinterpret_cast<const std::byte*>(shuffled_bytes_ptr), f16_bytes); // NOLINT
@@ -169,27 +188,68 @@ inline std::expected<memory::vector<std::byte>, std::string> encode16_impl(std::
 
 inline std::expected<memory::vector<std::byte>, std::string> encode32_impl(std::span<const float> snapshots, std::span<const float> prev_snapshot,
                                           size_t num_snapshots, size_t snapshot_floats, ICompressor& compressor,
-                                          OrderbookSimdCodecWorkspace& workspace) {
+                                          OrderbookSimdCodecWorkspace& workspace, const codecs::ShuffleLayout layout) {
     const size_t num_floats = snapshots.size();
-    float* f32_deltas_ptr = workspace.f32_deltas_.get();
-
-    simd::XorFloat32_dispatcher(snapshots.data(), prev_snapshot.data(), f32_deltas_ptr, snapshot_floats);
-    for (size_t s = 1; s < num_snapshots; ++s) {
-        const float* current_snap = snapshots.data() + s * snapshot_floats;
-        const float* prev_snap = snapshots.data() + (s - 1) * snapshot_floats;
-        float* out_snap = f32_deltas_ptr + s * snapshot_floats;
-        simd::XorFloat32_dispatcher(current_snap, prev_snap, out_snap, snapshot_floats);
-    }
-
     const size_t f32_bytes = num_floats * sizeof(float);
     uint8_t* shuffled_bytes_ptr = workspace.shuffled_bytes().data();
-    simd::ShuffleFloat32_dispatcher(f32_deltas_ptr, shuffled_bytes_ptr, num_floats);
+    assert(workspace.shuffled_bytes().size_bytes() >= f32_bytes);
+
+    encode_planes(&simd::XorShuffleFloat32_dispatcher, snapshots.data(), prev_snapshot.data(), shuffled_bytes_ptr,
+                  num_snapshots, snapshot_floats, sizeof(float), layout);
 
     static_assert(sizeof(std::byte) == sizeof(uint8_t));
     std::span<const std::byte> data_to_compress(reinterpret_cast<const std::byte*>(shuffled_bytes_ptr), f32_bytes); // NOLINT
     return compressor.compress(data_to_compress);
 }
 
+// Decodes a chunk. Global chunks are decompressed in full before reconstruction; Blocked chunks are streamed
+// through the compressor one row block at a time, so each block is unshuffled while it is still cache-resident.
+// prev_snapshot carries the reconstruction state across blocks and holds the last snapshot on return.
+inline std::expected<Float32AlignedVector, std::string> decode_impl(std::span<const std::byte> encoded_data, size_t num_snapshots,
+                                          size_t snapshot_floats, size_t elem_size, std::span<float> prev_snapshot,
+                                          ICompressor& compressor, const ObDecodeFn decode, const codecs::ShuffleLayout layout) {
+    const size_t num_floats = num_snapshots * snapshot_floats;
+    static_assert(sizeof(std::byte) == sizeof(uint8_t));
+
+    if (layout == codecs::ShuffleLayout::Global) {
+        auto shuffled_bytes_result = compressor.decompress_to<ByteAlignedAllocator>(encoded_data);
+        if (!shuffled_bytes_result) {
+            return std::unexpected(shuffled_bytes_result.error());
+        }
+        if (shuffled_bytes_result->size() != num_floats * elem_size) {
+            return std::unexpected("Decompressed data size does not match expected size for the given number of snapshots.");
+        }
+
+        Float32AlignedVector final_output(num_floats);
+        decode(reinterpret_cast<const uint8_t*>(shuffled_bytes_result->data()), // NOLINT
+               final_output.data(), num_snapshots, snapshot_floats, prev_snapshot);
+        return final_output;
+    }
+
+    const size_t row_bytes = snapshot_floats * elem_size;
+    const size_t rows_per_block = codecs::ShuffleBlock::rows_per_block(row_bytes);
+    Float32AlignedVector final_output(num_floats);
+    size_t row = 0;
+    auto decompressed = compressor.decompress_blocks(encoded_data, rows_per_block * row_bytes,
+        [&](std::span<const std::byte> block) -> std::expected<void, std::string> {
+            const size_t rows = block.size() / row_bytes;
+            if (rows * row_bytes != block.size() || row + rows > num_snapshots) {
+                return std::unexpected("Decompressed data size does not match expected size for the given number of snapshots.");
+            }
+            decode(reinterpret_cast<const uint8_t*>(block.data()), // NOLINT
+                   final_output.data() + row * snapshot_floats, rows, snapshot_floats, prev_snapshot);
+            row += rows;
+            return {};
+        });
+    if (!decompressed) {
+        return std::unexpected(decompressed.error());
+    }
+    if (row != num_snapshots) {
+        return std::unexpected("Decompressed data size does not match expected size for the given number of snapshots.");
+    }
+    return final_output;
+}
+
 }// namespace detail
 
 class DynamicOrderbookSimdCodec {
@@ -210,11 +270,11 @@ public:
     DynamicOrderbookSimdCodec(const DynamicOrderbookSimdCodec&) = delete;
     DynamicOrderbookSimdCodec& operator=(const DynamicOrderbookSimdCodec&) = delete;
 
-    std::expected<memory::vector<std::byte>, std::string> encode16(std::span<const float> snapshots, std::span<const float> prev_snapshot, OrderbookSimdCodecWorkspace& workspace) const;
-    std::expected<Float32AlignedVector, std::string> decode16(std::span<const std::byte> encoded_data, size_t num_snapshots, std::span<float> prev_snapshot) const;
+    std::expected<memory::vector<std::byte>, std::string> encode16(std::span<const float> snapshots, std::span<const float> prev_snapshot, OrderbookSimdCodecWorkspace& workspace, codecs::ShuffleLayout layout = codecs::ShuffleLayout::Global) const;
+    std::expected<Float32AlignedVector, std::string> decode16(std::span<const std::byte> encoded_data, size_t num_snapshots, std::span<float> prev_snapshot, codecs::ShuffleLayout layout = codecs::ShuffleLayout::Global) const;
 
-    std::expected<memory::vector<std::byte>, std::string> encode32(std::span<const float> snapshots, std::span<const float> prev_snapshot, OrderbookSimdCodecWorkspace& workspace) const;
-    std::expected<Float32AlignedVector, std::string> decode32(std::span<const std::byte> encoded_data, size_t num_snapshots, std::span<float> prev_snapshot) const;
+    std::expected<memory::vector<std::byte>, std::string> encode32(std::span<const float> snapshots, std::span<const float> prev_snapshot, OrderbookSimdCodecWorkspace& workspace, codecs::ShuffleLayout layout = codecs::ShuffleLayout::Global) const;
+    std::expected<Float32AlignedVector, std::string> decode32(std::span<const std::byte> encoded_data, size_t num_snapshots, std::span<float> prev_snapshot, codecs::ShuffleLayout layout = codecs::ShuffleLayout::Global) const;
 
     [[nodiscard]] std::pair<size_t, size_t> get_depth_features_count() const
     {
@@ -234,7 +294,7 @@ private:
     std::unique_ptr<ICompressor> compressor_;
 };
 
-inline std::expected<memory::vector<std::byte>, std::string> DynamicOrderbookSimdCodec::encode16(std::span<const float> snapshots, std::span<const float> prev_snapshot, OrderbookSimdCodecWorkspace& workspace) const {
+inline std::expected<memory::vector<std::byte>, std::string> DynamicOrderbookSimdCodec::encode16(std::span<const float> snapshots, std::span<const float> prev_snapshot, OrderbookSimdCodecWorkspace& workspace, const codecs::ShuffleLayout layout) const {
     if (prev_snapshot.size() != snapshot_floats_) {
         throw std::runtime_error("prev_snapshot size does not match configured snapshot_floats.");
     }
@@ -243,35 +303,20 @@ inline std::expected<memory::vector<std::byte>, std::string> DynamicOrderbookSim
         throw std::runtime_error("Snapshot data size is not a multiple of the configured snapshot_floats.");
     }
     workspace.ensure_capacity(num_floats);
-    return detail::encode16_impl(snapshots, prev_snapshot, num_floats / snapshot_floats_, snapshot_floats_, *compressor_, workspace);
+    return detail::encode16_impl(snapshots, prev_snapshot, num_floats / snapshot_floats_, snapshot_floats_, *compressor_, workspace, layout);
 }
 
-inline std::expected<Float32AlignedVector, std::string> DynamicOrderbookSimdCodec::decode16(std::span<const std::byte> encoded_data, size_t num_snapshots, std::span<float> prev_snapshot) const {
+inline std::expected<Float32AlignedVector, std::string> DynamicOrderbookSimdCodec::decode16(std::span<const std::byte> encoded_data, size_t num_snapshots, std::span<float> prev_snapshot, const codecs::ShuffleLayout layout) const {
     if (prev_snapshot.size() != snapshot_floats_) {
         return std::unexpected("prev_snapshot size does not match configured snapshot_floats.");
     }
     if (num_snapshots == 0) return {};
 
-    auto shuffled_f16_bytes_result = compressor_->decompress_to<ByteAlignedAllocator>(encoded_data);
-    if (!shuffled_f16_bytes_result) {
-        return std::unexpected(shuffled_f16_bytes_result.error());
-    }
-
-    const size_t num_floats = num_snapshots * snapshot_floats_;
-    const size_t f16_bytes = num_floats * sizeof(hwy::float16_t);
-    if (shuffled_f16_bytes_result->size() != f16_bytes) {
-        return std::unexpected("Decompressed data size does not match expected size for the given number of snapshots.");
-    }
-
-    Float32AlignedVector final_output(num_floats);
-    static_assert(sizeof(std::byte) == sizeof(uint8_t));
-    simd::UnshuffleAndReconstruct_dispatcher(reinterpret_cast<const uint8_t*>(shuffled_f16_bytes_result->data()), // NOLINT
-                                       final_output.data(), num_snapshots, snapshot_floats_, prev_snapshot);
-
-    return final_output;
+    return detail::decode_impl(encoded_data, num_snapshots, snapshot_floats_, sizeof(hwy::float16_t), prev_snapshot,
+                               *compressor_, &simd::UnshuffleAndReconstruct_dispatcher, layout);
 }
 
-inline std::expected<memory::vector<std::byte>, std::string> DynamicOrderbookSimdCodec::encode32(std::span<const float> snapshots, std::span<const float> prev_snapshot, OrderbookSimdCodecWorkspace& workspace) const {
+inline std::expected<memory::vector<std::byte>, std::string> DynamicOrderbookSimdCodec::encode32(std::span<const float> snapshots, std::span<const float> prev_snapshot, OrderbookSimdCodecWorkspace& workspace, const codecs::ShuffleLayout layout) const {
     if (prev_snapshot.size() != snapshot_floats_) {
         throw std::runtime_error("prev_snapshot size does not match configured snapshot_floats.");
     }
@@ -280,32 +325,17 @@ inline std::expected<memory::vector<std::byte>, std::string> DynamicOrderbookSim
         throw std::runtime_error("Snapshot data size is not a multiple of the configured snapshot_floats.");
     }
     workspace.ensure_capacity(num_floats);
-    return detail::encode32_impl(snapshots, prev_snapshot, num_floats / snapshot_floats_, snapshot_floats_, *compressor_, workspace);
+    return detail::encode32_impl(snapshots, prev_snapshot, num_floats / snapshot_floats_, snapshot_floats_, *compressor_, workspace, layout);
 }
 
-inline std::expected<Float32AlignedVector, std::string> DynamicOrderbookSimdCodec::decode32(std::span<const std::byte> encoded_data, size_t num_snapshots, std::span<float> prev_snapshot) const {
+inline std::expected<Float32AlignedVector, std::string> DynamicOrderbookSimdCodec::decode32(std::span<const std::byte> encoded_data, size_t num_snapshots, std::span<float> prev_snapshot, const codecs::ShuffleLayout layout) const {
     if (prev_snapshot.size() != snapshot_floats_) {
         return std::unexpected("prev_snapshot size does not match configured snapshot_floats.");
     }
     if (num_snapshots == 0) return {};
 
-    auto shuffled_f32_bytes_result = compressor_->decompress_to<ByteAlignedAllocator>(encoded_data);
-    if (!shuffled_f32_bytes_result) {
-        return std::unexpected(shuffled_f32_bytes_result.error());
-    }
-
-    const size_t num_floats = num_snapshots * snapshot_floats_;
-    const size_t f32_bytes = num_floats * sizeof(float);
-    if (shuffled_f32_bytes_result->size() != f32_bytes) {
-        return std::unexpected("Decompressed data size does not match expected size for the given number of snapshots.");
-    }
-
-    Float32AlignedVector final_output(num_floats);
-    static_assert(sizeof(std::byte) == sizeof(uint8_t));
-    simd::UnshuffleAndReconstructFloat32_dispatcher(reinterpret_cast<const uint8_t*>(shuffled_f32_bytes_result->data()), // NOLINT
-                                              final_output.data(), num_snapshots, snapshot_floats_, prev_snapshot);
-
-    return final_output;
+    return detail::decode_impl(encoded_data, num_snapshots, snapshot_floats_, sizeof(float), prev_snapshot,
+                               *compressor_, &simd::UnshuffleAndReconstructFloat32_dispatcher, layout);
 }
 
 template <size_t Depth, size_t Features>
@@ -331,81 +361,50 @@ public:
     OrderbookSimdCodec(const OrderbookSimdCodec&) = delete;
     OrderbookSimdCodec& operator=(const OrderbookSimdCodec&) = delete;
 
-    std::expected<memory::vector<std::byte>, std::string> encode16(std::span<const float> snapshots, const Snapshot& prev_snapshot, OrderbookSimdCodecWorkspace& workspace) const;
-    std::expected<Float32AlignedVector, std::string> decode16(std::span<const std::byte> encoded_data, size_t num_snapshots, Snapshot& prev_snapshot) const;
+    std::expected<memory::vector<std::byte>, std::string> encode16(std::span<const float> snapshots, const Snapshot& prev_snapshot, OrderbookSimdCodecWorkspace& workspace, codecs::ShuffleLayout layout = codecs::ShuffleLayout::Global) const;
+    std::expected<Float32AlignedVector, std::string> decode16(std::span<const std::byte> encoded_data, size_t num_snapshots, Snapshot& prev_snapshot, codecs::ShuffleLayout layout = codecs::ShuffleLayout::Global) const;
 
-    std::expected<memory::vector<std::byte>, std::string> encode32(std::span<const float> snapshots, const Snapshot& prev_snapshot, OrderbookSimdCodecWorkspace& workspace) const;
-    std::expected<Float32AlignedVector, std::string> decode32(std::span<const std::byte> encoded_data, size_t num_snapshots, Snapshot& prev_snapshot) const;
+    std::expected<memory::vector<std::byte>, std::string> encode32(std::span<const float> snapshots, const Snapshot& prev_snapshot, OrderbookSimdCodecWorkspace& workspace, codecs::ShuffleLayout layout = codecs::ShuffleLayout::Global) const;
+    std::expected<Float32AlignedVector, std::string> decode32(std::span<const std::byte> encoded_data, size_t num_snapshots, Snapshot& prev_snapshot, codecs::ShuffleLayout layout = codecs::ShuffleLayout::Global) const;
 
 private:
     std::unique_ptr<ICompressor> compressor_;
 };
 
 template <size_t Depth, size_t Features>
-std::expected<memory::vector<std::byte>, std::string> OrderbookSimdCodec<Depth, Features>::encode16(std::span<const float> snapshots, const Snapshot& prev_snapshot, OrderbookSimdCodecWorkspace& workspace) const {
+std::expected<memory::vector<std::byte>, std::string> OrderbookSimdCodec<Depth, Features>::encode16(std::span<const float> snapshots, const Snapshot& prev_snapshot, OrderbookSimdCodecWorkspace& workspace, const codecs::ShuffleLayout layout) const {
     const size_t num_floats = snapshots.size();
     if (num_floats == 0 || num_floats % SnapshotFloats != 0) {
         throw std::runtime_error("Snapshot data size is not a multiple of the configured SnapshotFloats.");
     }
     workspace.ensure_capacity(num_floats);
-    return detail::encode16_impl(snapshots, {prev_snapshot.data(), SnapshotFloats}, num_floats / SnapshotFloats, SnapshotFloats, *compressor_, workspace);
+    return detail::encode16_impl(snapshots, {prev_snapshot.data(), SnapshotFloats}, num_floats / SnapshotFloats, SnapshotFloats, *compressor_, workspace, layout);
 }
 
 template <size_t Depth, size_t Features>
-std::expected<Float32AlignedVector, std::string> OrderbookSimdCodec<Depth, Features>::decode16(std::span<const std::byte> encoded_data, size_t num_snapshots, Snapshot& prev_snapshot) const {
+std::expected<Float32AlignedVector, std::string> OrderbookSimdCodec<Depth, Features>::decode16(std::span<const std::byte> encoded_data, size_t num_snapshots, Snapshot& prev_snapshot, const codecs::ShuffleLayout layout) const {
     if (num_snapshots == 0) return {};
 
-    auto shuffled_f16_bytes_result = compressor_->decompress_to<ByteAlignedAllocator>(encoded_data);
-    if (!shuffled_f16_bytes_result) {
-        return std::unexpected(shuffled_f16_bytes_result.error());
-    }
-
-    const size_t num_floats = num_snapshots * SnapshotFloats;
-    const size_t f16_bytes = num_floats * sizeof(hwy::float16_t);
-    if (shuffled_f16_bytes_result->size() != f16_bytes) {
-        return std::unexpected("Decompressed data size does not match expected size for the given number of snapshots.");
-    }
-
-    Float32AlignedVector final_output(num_floats);
-    final_output.resize(num_floats);
-    static_assert(sizeof(std::byte) == sizeof(uint8_t));
-    simd::UnshuffleAndReconstruct_dispatcher(reinterpret_cast<const uint8_t*>(shuffled_f16_bytes_result->data()), // NOLINT
-                                       final_output.data(), num_snapshots, SnapshotFloats, {prev_snapshot.data(), SnapshotFloats});
-
-    return final_output;
+    return detail::decode_impl(encoded_data, num_snapshots, SnapshotFloats, sizeof(hwy::float16_t), {prev_snapshot.data(), SnapshotFloats},
+                               *compressor_, &simd::UnshuffleAndReconstruct_dispatcher, layout);
 }
 
 template <size_t Depth, size_t Features>
-std::expected<memory::vector<std::byte>, std::string> OrderbookSimdCodec<Depth, Features>::encode32(std::span<const float> snapshots, const Snapshot& prev_snapshot, OrderbookSimdCodecWorkspace& workspace) const {
+std::expected<memory::vector<std::byte>, std::string> OrderbookSimdCodec<Depth, Features>::encode32(std::span<const float> snapshots, const Snapshot& prev_snapshot, OrderbookSimdCodecWorkspace& workspace, const codecs::ShuffleLayout layout) const {
     const size_t num_floats = snapshots.size();
     if (num_floats == 0 || num_floats % SnapshotFloats != 0) {
         throw std::runtime_error("Snapshot data size is not a multiple of the configured SnapshotFloats.");
     }
     workspace.ensure_capacity(num_floats);
-    return detail::encode32_impl(snapshots, {prev_snapshot.data(), SnapshotFloats}, num_floats / SnapshotFloats, SnapshotFloats, *compressor_, workspace);
+    return detail::encode32_impl(snapshots, {prev_snapshot.data(), SnapshotFloats}, num_floats / SnapshotFloats, SnapshotFloats, *compressor_, workspace, layout);
 }
 
 template <size_t Depth, size_t Features>
-std::expected<Float32AlignedVector, std::string> OrderbookSimdCodec<Depth, Features>::decode32(std::span<const std::byte> encoded_data, size_t num_snapshots, Snapshot& prev_snapshot) const {
+std::expected<Float32AlignedVector, std::string> OrderbookSimdCodec<Depth, Features>::decode32(std::span<const std::byte> encoded_data, size_t num_snapshots, Snapshot& prev_snapshot, const codecs::ShuffleLayout layout) const {
     if (num_snapshots == 0) return {};
 
-    auto shuffled_f32_bytes_result = compressor_->decompress_to<ByteAlignedAllocator>(encoded_data);
-    if (!shuffled_f32_bytes_result) {
-        return std::unexpected(shuffled_f32_bytes_result.error());
-    }
-
-    const size_t num_floats = num_snapshots * SnapshotFloats;
-    const size_t f32_bytes = num_floats * sizeof(float);
-    if (shuffled_f32_bytes_result->size() != f32_bytes) {
-        return std::unexpected("Decompressed data size does not match expected size for the given number of snapshots.");
-    }
-
-    Float32AlignedVector final_output(num_floats);
-    static_assert(sizeof(std::byte) == sizeof(uint8_t)); // NOLINT
-    simd::UnshuffleAndReconstructFloat32_dispatcher(reinterpret_cast<const uint8_t*>(shuffled_f32_bytes_result->data()), // NOLINT
-                                              final_output.data(), num_snapshots, SnapshotFloats, {prev_snapshot.data(), SnapshotFloats});
-
-    return final_output;
+    return detail::decode_impl(encoded_data, num_snapshots, SnapshotFloats, sizeof(float), {prev_snapshot.data(), SnapshotFloats},
+                               *compressor_, &simd::UnshuffleAndReconstructFloat32_dispatcher, layout);
 }
 
     using OkxObSimdCodec = OrderbookSimdCodec<codecs::Orderbook::OKX_DEPTH, codecs::Orderbook::OKX_FEATURES>;
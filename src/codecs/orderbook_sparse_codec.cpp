@@ -0,0 +1,172 @@
+#include "orderbook_sparse_codec.h"
+// Declares the shuffle kernels; it refuses to be included once highway.h is.
+#include "orderbook_simd_codec.h"
+#include <cstring>
+
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "orderbook_sparse_codec.cpp"
+#include "hwy/foreach_target.h"
+
+#include <hwy/highway.h>
+
+HWY_BEFORE_NAMESPACE();
+namespace cryptodd::HWY_NAMESPACE {
+
+namespace hn = hwy::HWY_NAMESPACE;
+
+HWY_NOINLINE size_t SparseDeltaFloat32(const float* HWY_RESTRICT current, const float* HWY_RESTRICT prev, uint8_t* HWY_RESTRICT bitmap,
+                                       uint32_t* HWY_RESTRICT changed, size_t num_floats) {
+    size_t i = 0;
+    size_t count = 0;
+#if HWY_TARGET != HWY_SCALAR
+    const hn::ScalableTag<float> d32;
+    const hn::RebindToUnsigned<decltype(d32)> du32;
+    const size_t lanes = hn::Lanes(du32);
+    uint8_t bits[HWY_MAX_BYTES / sizeof(uint32_t) / 8 + 1];
+    for (; i + lanes <= num_floats; i += lanes) {
+        const auto v_current = hn::BitCast(du32, hn::LoadU(d32, current + i));
+        const auto v_prev = hn::BitCast(du32, hn::LoadU(d32, prev + i));
+        const auto m_changed = hn::Ne(v_current, v_prev);
+        hn::StoreMaskBits(du32, m_changed, bits);
+        // i is a multiple of lanes, so vectors of 8+ lanes start on a byte; narrower ones fill part of one.
+        if (lanes >= 8) {
+            std::memcpy(bitmap + i / 8, bits, lanes / 8);
+        } else {
+            bitmap[i / 8] |= static_cast<uint8_t>(bits[0] << (i % 8));
+        }
+        count += hn::CompressStore(hn::Xor(v_current, v_prev), m_changed, du32, changed + count);
+    }
+#endif
+    for (; i < num_floats; ++i) {
+        const uint32_t delta = hwy::BitCastScalar<uint32_t>(current[i]) ^ hwy::BitCastScalar<uint32_t>(prev[i]);
+        if (delta != 0) {
+            bitmap[i / 8] |= static_cast<uint8_t>(1u << (i % 8));
+            changed[count++] = delta;
+        }
+    }
+    return count;
+}
+
+} // namespace cryptodd::HWY_NAMESPACE
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+#include <algorithm>
+#include <bit>
+#include <format>
+
+namespace cryptodd {
+
+namespace simd {
+    HWY_EXPORT(SparseDeltaFloat32);
+    size_t SparseDeltaFloat32_dispatcher(const float* current, const float* prev, uint8_t* bitmap, uint32_t* changed, size_t num_floats) {
+        return HWY_DYNAMIC_DISPATCH(SparseDeltaFloat32)(current, prev, bitmap, changed, num_floats);
+    }
+} // namespace simd
+
+namespace {
+    constexpr size_t kHeaderBytes = 2 * sizeof(uint32_t);
+
+    size_t bitmap_bytes(const size_t snapshot_floats) { return (snapshot_floats + 7) / 8; }
+
+    // Copies `prev` to `out`, then XORs the next changed values onto the floats whose bit is set.
+    // Returns how many changed values were consumed.
+    size_t apply_sparse_delta(const float* prev, const uint8_t* bitmap, const float* changed, float* out, const size_t snapshot_floats) {
+        std::memcpy(out, prev, snapshot_floats * sizeof(float));
+        size_t count = 0;
+        for (size_t byte = 0; byte < bitmap_bytes(snapshot_floats); ++byte) {
+            for (unsigned bits = bitmap[byte]; bits != 0; bits &= bits - 1) {
+                const size_t i = byte * 8 + static_cast<size_t>(std::countr_zero(bits));
+                out[i] = std::bit_cast<float>(std::bit_cast<uint32_t>(out[i]) ^ std::bit_cast<uint32_t>(changed[count++]));
+            }
+        }
+        return count;
+    }
+}
+
+OrderbookSparseCodec::EncodeResult OrderbookSparseCodec::encode(std::span<const float> snapshots, std::span<const float> prev_snapshot, OrderbookSparseCodecWorkspace& workspace) const {
+    const size_t snapshot_floats = prev_snapshot.size();
+    if (snapshot_floats == 0 || snapshots.size() % snapshot_floats != 0) {
+        return std::unexpected(std::format("Orderbook data size {} is not a multiple of the snapshot size {}.", snapshots.size(), snapshot_floats));
+    }
+    const size_t num_snapshots = snapshots.size() / snapshot_floats;
+    const size_t row_bitmap_bytes = bitmap_bytes(snapshot_floats);
+    const auto max_changed = static_cast<size_t>(max_changed_fraction_ * static_cast<double>(snapshots.size()));
+    workspace.ensure_capacity(snapshots.size());
+    uint32_t* changed = workspace.changed();
+
+    memory::vector<std::byte> streams(num_snapshots * row_bitmap_bytes);
+    size_t num_changed = 0;
+    for (size_t s = 0; s < num_snapshots; ++s) {
+        const float* prev = s == 0 ? prev_snapshot.data() : snapshots.data() + (s - 1) * snapshot_floats;
+        auto* bitmap = reinterpret_cast<uint8_t*>(streams.data() + s * row_bitmap_bytes); // NOLINT
+        num_changed += simd::SparseDeltaFloat32_dispatcher(snapshots.data() + s * snapshot_floats, prev, bitmap, changed + num_changed, snapshot_floats);
+        // High churn: stop early and leave the chunk to the dense codec.
+        if (num_changed > max_changed) return std::optional<memory::vector<std::byte>>{};
+    }
+
+    streams.resize(streams.size() + num_changed * sizeof(uint32_t));
+    static_assert(sizeof(float) == sizeof(uint32_t));
+    simd::ShuffleFloat32_dispatcher(reinterpret_cast<const float*>(changed), // NOLINT
+                                    reinterpret_cast<uint8_t*>(streams.data() + num_snapshots * row_bitmap_bytes), num_changed); // NOLINT
+
+    auto compressed = compressor_->compress(streams);
+    if (!compressed) return std::unexpected(compressed.error());
+
+    memory::vector<std::byte> payload(kHeaderBytes + compressed->size());
+    const uint32_t header[2] = {static_cast<uint32_t>(num_changed), 0};
+    std::memcpy(payload.data(), header, kHeaderBytes);
+    std::memcpy(payload.data() + kHeaderBytes, compressed->data(), compressed->size());
+    return std::optional{std::move(payload)};
+}
+
+std::expected<Float32AlignedVector, std::string> OrderbookSparseCodec::decode(std::span<const std::byte> encoded, const size_t num_snapshots, std::span<float> prev_snapshot) const {
+    const size_t snapshot_floats = prev_snapshot.size();
+    if (snapshot_floats == 0) return std::unexpected("prev_snapshot must not be empty.");
+    if (encoded.size() < kHeaderBytes) return std::unexpected("Sparse orderbook payload is too small for its header.");
+    uint32_t header[2];
+    std::memcpy(header, encoded.data(), kHeaderBytes);
+    if (header[1] != 0) return std::unexpected("Sparse orderbook payload has a non-zero reserved field.");
+    const size_t num_changed = header[0];
+    if (num_snapshots == 0) return Float32AlignedVector{};
+    if (num_changed > num_snapshots * snapshot_floats) return std::unexpected("Sparse orderbook payload has more changes than floats.");
+
+    auto streams = compressor_->decompress(encoded.subspan(kHeaderBytes));
+    if (!streams) return std::unexpected(streams.error());
+    const size_t row_bitmap_bytes = bitmap_bytes(snapshot_floats);
+    const size_t bitmaps_size = num_snapshots * row_bitmap_bytes;
+    if (streams->size() != bitmaps_size + num_changed * sizeof(uint32_t)) {
+        return std::unexpected("Decompressed data size does not match expected size for the given number of snapshots.");
+    }
+
+    const auto* bitmaps = reinterpret_cast<const uint8_t*>(streams->data()); // NOLINT
+    size_t set_bits = 0;
+    const uint8_t padding_mask = snapshot_floats % 8 == 0 ? 0 : static_cast<uint8_t>(0xFF << (snapshot_floats % 8));
+    for (size_t s = 0; s < num_snapshots; ++s) {
+        const uint8_t* bitmap = bitmaps + s * row_bitmap_bytes;
+        if ((bitmap[row_bitmap_bytes - 1] & padding_mask) != 0) return std::unexpected("Sparse orderbook bitmap marks floats past the snapshot end.");
+        for (size_t byte = 0; byte < row_bitmap_bytes; ++byte) set_bits += static_cast<size_t>(std::popcount(bitmap[byte]));
+    }
+    if (set_bits != num_changed) {
+        return std::unexpected(std::format("Sparse orderbook bitmaps mark {} changes, header records {}.", set_bits, num_changed));
+    }
+
+    Float32AlignedVector changed(num_changed);
+    Float32AlignedVector unshuffle_state(num_changed, 0.0f);
+    if (num_changed > 0) {
+        // One "snapshot" of num_changed floats XORed against zeros is a plain unshuffle.
+        simd::UnshuffleAndReconstructFloat32_dispatcher(bitmaps + bitmaps_size, changed.data(), 1, num_changed, unshuffle_state);
+    }
+
+    Float32AlignedVector out(num_snapshots * snapshot_floats);
+    size_t consumed = 0;
+    for (size_t s = 0; s < num_snapshots; ++s) {
+        const float* prev = s == 0 ? prev_snapshot.data() : out.data() + (s - 1) * snapshot_floats;
+        consumed += apply_sparse_delta(prev, bitmaps + s * row_bitmap_bytes, changed.data() + consumed, out.data() + s * snapshot_floats, snapshot_floats);
+    }
+    std::copy_n(out.end() - static_cast<std::ptrdiff_t>(snapshot_floats), snapshot_floats, prev_snapshot.begin());
+    return out;
+}
+
+} // namespace cryptodd
+#endif // HWY_ONCE
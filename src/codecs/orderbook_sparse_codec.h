@@ -0,0 +1,99 @@
+#pragma once
+
+#include "i_compressor.h"
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <hwy/aligned_allocator.h>
+#include <hwy/base.h>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include "../memory/aligned.h"
+
+/**
+ * @file orderbook_sparse_codec.h
+ * @brief Sparse orderbook delta codec: a changed-levels bitmap per snapshot plus only the changed values.
+ *
+ * Between consecutive snapshots usually only a handful of levels move, yet the dense XOR + shuffle codec
+ * (GENERIC_OB_SIMD_F32) still hands zstd four bytes per float. This codec compares every snapshot bitwise with
+ * the previous one and keeps, per snapshot, a bitmap of the floats that changed and, compress-stored in order,
+ * those floats XORed with their previous value:
+ *
+ *     uint32_t num_changed                          // set bits over all bitmaps
+ *     uint32_t reserved                             // zero
+ *     compressor(
+ *         uint8_t bitmap[num_snapshots][(snapshot_floats + 7) / 8]   // bit i of snapshot s: float i changed
+ *         shuffle4(changed ^ previous)              // num_changed floats, snapshot then float order
+ *     )
+ *
+ * The first snapshot is compared against `prev_snapshot`, as in the dense codec, and decoding applies the
+ * changes onto it. The comparison is bitwise, so NaN payloads and signed zeros round-trip exactly.
+ *
+ * Once more than `max_changed_fraction` of a chunk's floats changed, the bitmap no longer pays for itself and
+ * encoding reports the chunk as unsupported; the caller then falls back to the dense codec.
+ */
+namespace cryptodd {
+
+using Float32AlignedVector = memory::AlignedVector<float, static_cast<std::size_t>(HWY_ALIGNMENT)>;
+
+namespace simd {
+    // Sets bit i of `bitmap` (zeroed by the caller, (num_floats + 7) / 8 bytes) when current[i] and prev[i] differ
+    // bitwise, and compress-stores current[i] ^ prev[i] of those floats to `changed`. Returns how many were stored;
+    // `changed` must have room for num_floats plus one vector of padding.
+    size_t SparseDeltaFloat32_dispatcher(const float* current, const float* prev, uint8_t* bitmap, uint32_t* changed, size_t num_floats);
+}
+
+class OrderbookSparseCodecWorkspace {
+public:
+    // CompressStore may write a whole vector past the last stored lane.
+    static constexpr size_t kChangedPadding = HWY_MAX_BYTES / sizeof(uint32_t);
+
+    OrderbookSparseCodecWorkspace() = default;
+    OrderbookSparseCodecWorkspace(const OrderbookSparseCodecWorkspace&) = delete;
+    OrderbookSparseCodecWorkspace& operator=(const OrderbookSparseCodecWorkspace&) = delete;
+    OrderbookSparseCodecWorkspace(OrderbookSparseCodecWorkspace&&) noexcept = default;
+    OrderbookSparseCodecWorkspace& operator=(OrderbookSparseCodecWorkspace&&) noexcept = default;
+
+    void ensure_capacity(size_t required_floats) {
+        if (capacity_in_floats_ >= required_floats) return;
+        changed_ = hwy::AllocateAligned<uint32_t>(required_floats + kChangedPadding);
+        if (!changed_) throw std::bad_alloc();
+        capacity_in_floats_ = required_floats;
+    }
+
+    [[nodiscard]] uint32_t* changed() { return changed_.get(); }
+
+private:
+    hwy::AlignedFreeUniquePtr<uint32_t[]> changed_;
+    size_t capacity_in_floats_ = 0;
+};
+
+class OrderbookSparseCodec {
+public:
+    // Above this share of changed floats, the dense XOR + shuffle codec compresses better.
+    static constexpr double kDefaultMaxChangedFraction = 0.25;
+
+    /** @brief Encoded payload, or std::nullopt when too many floats changed and the chunk should use the dense codec. */
+    using EncodeResult = std::expected<std::optional<memory::vector<std::byte>>, std::string>;
+
+    explicit OrderbookSparseCodec(std::unique_ptr<ICompressor> compressor, double max_changed_fraction = kDefaultMaxChangedFraction)
+        : compressor_(std::move(compressor)), max_changed_fraction_(max_changed_fraction) {
+        if (!compressor_) throw std::invalid_argument("Compressor cannot be null.");
+        if (!(max_changed_fraction_ >= 0.0 && max_changed_fraction_ <= 1.0)) throw std::invalid_argument("max_changed_fraction must be within [0, 1].");
+    }
+
+    /** @brief Encodes snapshots.size() / prev_snapshot.size() row-major snapshots against `prev_snapshot`. */
+    EncodeResult encode(std::span<const float> snapshots, std::span<const float> prev_snapshot, OrderbookSparseCodecWorkspace& workspace) const;
+
+    /** @brief Decodes `num_snapshots` snapshots onto `prev_snapshot`, which holds the last snapshot on return. */
+    std::expected<Float32AlignedVector, std::string> decode(std::span<const std::byte> encoded, size_t num_snapshots, std::span<float> prev_snapshot) const;
+
+private:
+    std::unique_ptr<ICompressor> compressor_;
+    double max_changed_fraction_;
+};
+
+} // namespace cryptodd
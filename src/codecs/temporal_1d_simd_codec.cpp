@@ -169,6 +169,67 @@ static HWY_NOINLINE void ShuffleFloat32(const float* HWY_RESTRICT in, uint8_t* H
     }
 }
 
+// Fused XOR + byte-plane scatter: same output as DemoteAndXor/XorFloat32 followed by the
+// matching Shuffle kernel, without materialising the delta buffer in between.
+static HWY_INLINE void DemoteXorShuffle16(const float* HWY_RESTRICT current, const float* HWY_RESTRICT prev,
+                                          uint8_t* HWY_RESTRICT out_b0, uint8_t* HWY_RESTRICT out_b1, size_t num_floats) {
+    size_t i = 0;
+
+#if HWY_TARGET != HWY_SCALAR
+    const hn::Rebind<hwy::float16_t, decltype(d32)> d16_half;
+    const hn::Rebind<uint16_t, decltype(d32)> du16_half;
+    const hn::Rebind<uint8_t, decltype(d32)> du8_quarter;
+    const size_t f32_lanes = hn::Lanes(d32);
+
+    for (; i + f32_lanes <= num_floats; i += f32_lanes) {
+        const auto v_curr_u16 = hn::BitCast(du16_half, hn::DemoteTo(d16_half, hn::LoadU(d32, current + i)));
+        const auto v_prev_u16 = hn::BitCast(du16_half, hn::DemoteTo(d16_half, hn::LoadU(d32, prev + i)));
+        const auto v_xor_u16 = hn::Xor(v_curr_u16, v_prev_u16);
+
+        hn::StoreU(hn::TruncateTo(du8_quarter, v_xor_u16), du8_quarter, out_b0 + i);
+        hn::StoreU(hn::TruncateTo(du8_quarter, hn::ShiftRight<8>(v_xor_u16)), du8_quarter, out_b1 + i);
+    }
+#endif
+
+    for (; i < num_floats; ++i) {
+        const hwy::float16_t f16_curr = hwy::ConvertScalarTo<hwy::float16_t>(current[i]);
+        const hwy::float16_t f16_prev = hwy::ConvertScalarTo<hwy::float16_t>(prev[i]);
+        const uint16_t u16_xor = hwy::BitCastScalar<uint16_t>(f16_curr) ^ hwy::BitCastScalar<uint16_t>(f16_prev);
+        out_b0[i] = static_cast<uint8_t>(u16_xor & 0xFF);
+        out_b1[i] = static_cast<uint8_t>(u16_xor >> 8);
+    }
+}
+
+static HWY_INLINE void XorShuffleFloat32(const float* HWY_RESTRICT current, const float* HWY_RESTRICT prev,
+                                         uint8_t* HWY_RESTRICT out_b0, uint8_t* HWY_RESTRICT out_b1,
+                                         uint8_t* HWY_RESTRICT out_b2, uint8_t* HWY_RESTRICT out_b3, size_t num_floats) {
+    size_t i = 0;
+
+#if HWY_TARGET != HWY_SCALAR
+    const hn::Rebind<uint8_t, decltype(d32)> du8_quarter;
+    const size_t f32_lanes = hn::Lanes(d32);
+
+    for (; i + f32_lanes <= num_floats; i += f32_lanes) {
+        const VU32 v_curr_u32 = hn::BitCast(du32, hn::LoadU(d32, current + i));
+        const VU32 v_prev_u32 = hn::BitCast(du32, hn::LoadU(d32, prev + i));
+        const VU32 v_xor_u32 = hn::Xor(v_curr_u32, v_prev_u32);
+
+        hn::StoreU(hn::TruncateTo(du8_quarter, v_xor_u32), du8_quarter, out_b0 + i);
+        hn::StoreU(hn::TruncateTo(du8_quarter, hn::ShiftRight<8>(v_xor_u32)), du8_quarter, out_b1 + i);
+        hn::StoreU(hn::TruncateTo(du8_quarter, hn::ShiftRight<16>(v_xor_u32)), du8_quarter, out_b2 + i);
+        hn::StoreU(hn::TruncateTo(du8_quarter, hn::ShiftRight<24>(v_xor_u32)), du8_quarter, out_b3 + i);
+    }
+#endif
+
+    for (; i < num_floats; ++i) {
+        const uint32_t u32_xor = hwy::BitCastScalar<uint32_t>(current[i]) ^ hwy::BitCastScalar<uint32_t>(prev[i]);
+        out_b0[i] = static_cast<uint8_t>((u32_xor      ) & 0xFF);
+        out_b1[i] = static_cast<uint8_t>((u32_xor >> 8 ) & 0xFF);
+        out_b2[i] = static_cast<uint8_t>((u32_xor >> 16) & 0xFF);
+        out_b3[i] = static_cast<uint8_t>((u32_xor >> 24) & 0xFF);
+    }
+}
+
 HWY_NOINLINE void DemoteAndXor1D(const float* HWY_RESTRICT data, hwy::float16_t* HWY_RESTRICT out, size_t num_elements, float prev_element) {
     if (num_elements == 0) return;
     const hwy::float16_t f16_curr = hwy::ConvertScalarTo<hwy::float16_t>(data[0]);
@@ -183,6 +244,18 @@ HWY_NOINLINE void ShuffleFloat16_1D(const hwy::float16_t* HWY_RESTRICT in, uint8
     ShuffleFloat16(in, out, num_elements);
 }
 
+HWY_NOINLINE void DemoteXorShuffle16_1D(const float* HWY_RESTRICT data, uint8_t* HWY_RESTRICT out, size_t num_elements, float prev_element) {
+    if (num_elements == 0) return;
+    const hwy::float16_t f16_curr = hwy::ConvertScalarTo<hwy::float16_t>(data[0]);
+    const hwy::float16_t f16_prev = hwy::ConvertScalarTo<hwy::float16_t>(prev_element);
+    const uint16_t u16_xor = hwy::BitCastScalar<uint16_t>(f16_curr) ^ hwy::BitCastScalar<uint16_t>(f16_prev);
+    out[0] = static_cast<uint8_t>(u16_xor & 0xFF);
+    out[num_elements] = static_cast<uint8_t>(u16_xor >> 8);
+    if (num_elements > 1) {
+        DemoteXorShuffle16(data + 1, data, out + 1, out + num_elements + 1, num_elements - 1);
+    }
+}
+
 HWY_NOINLINE void UnshuffleAndReconstruct16_1D(const uint8_t* HWY_RESTRICT shuffled_in, float* HWY_RESTRICT out, size_t num_elements, float& prev_element) {
      if (num_elements == 0) return;
     const size_t total_floats = num_elements;
@@ -252,6 +325,19 @@ HWY_NOINLINE void ShuffleFloat32_1D(const float* HWY_RESTRICT in, uint8_t* HWY_R
     ShuffleFloat32(in, out, num_elements);
 }
 
+HWY_NOINLINE void XorShuffleFloat32_1D(const float* HWY_RESTRICT data, uint8_t* HWY_RESTRICT out, size_t num_elements, float prev_element) {
+    if (num_elements == 0) return;
+    const uint32_t u32_xor = hwy::BitCastScalar<uint32_t>(data[0]) ^ hwy::BitCastScalar<uint32_t>(prev_element);
+    out[0] = static_cast<uint8_t>((u32_xor      ) & 0xFF);
+    out[num_elements] = static_cast<uint8_t>((u32_xor >> 8 ) & 0xFF);
+    out[2 * num_elements] = static_cast<uint8_t>((u32_xor >> 16) & 0xFF);
+    out[3 * num_elements] = static_cast<uint8_t>((u32_xor >> 24) & 0xFF);
+    if (num_elements > 1) {
+        XorShuffleFloat32(data + 1, data, out + 1, out + num_elements + 1,
+                          out + 2 * num_elements + 1, out + 3 * num_elements + 1, num_elements - 1);
+    }
+}
+
 HWY_NOINLINE void UnshuffleAndReconstruct32_1D(const uint8_t* HWY_RESTRICT shuffled_in, float* HWY_RESTRICT out, size_t num_elements, float& prev_element) {
     if (num_elements == 0) return;
     const uint8_t* HWY_RESTRICT in_b0 = shuffled_in;
@@ -318,6 +404,92 @@ HWY_NOINLINE void UnshuffleAndReconstruct32_1D(const uint8_t* HWY_RESTRICT shuff
     }
 }
 
+// Fused XOR + 8-byte shuffle for float64: byte b of the XOR delta of element i goes to out[b * num_elements + i].
+HWY_NOINLINE void XorShuffleFloat64_1D(const double* HWY_RESTRICT data, uint8_t* HWY_RESTRICT out, size_t num_elements, double prev_element) {
+    if (num_elements == 0) return;
+    const auto store_bytes = [&](const size_t i, const uint64_t u64_xor) {
+        for (size_t b = 0; b < sizeof(uint64_t); ++b) {
+            out[b * num_elements + i] = static_cast<uint8_t>((u64_xor >> (8 * b)) & 0xFF);
+        }
+    };
+    store_bytes(0, hwy::BitCastScalar<uint64_t>(data[0]) ^ hwy::BitCastScalar<uint64_t>(prev_element));
+
+    size_t i = 1;
+#if HWY_TARGET != HWY_SCALAR && HWY_HAVE_FLOAT64
+    const hn::ScalableTag<double> d64;
+    const hn::Rebind<uint8_t, decltype(du64)> du8_eighth;
+    const size_t f64_lanes = hn::Lanes(d64);
+
+    for (; i + f64_lanes <= num_elements; i += f64_lanes) {
+        const VU64 v_xor_u64 = hn::Xor(hn::BitCast(du64, hn::LoadU(d64, data + i)), hn::BitCast(du64, hn::LoadU(d64, data + i - 1)));
+
+        hn::StoreU(hn::TruncateTo(du8_eighth, v_xor_u64), du8_eighth, out + 0 * num_elements + i);
+        hn::StoreU(hn::TruncateTo(du8_eighth, hn::ShiftRight<8>(v_xor_u64)), du8_eighth, out + 1 * num_elements + i);
+        hn::StoreU(hn::TruncateTo(du8_eighth, hn::ShiftRight<16>(v_xor_u64)), du8_eighth, out + 2 * num_elements + i);
+        hn::StoreU(hn::TruncateTo(du8_eighth, hn::ShiftRight<24>(v_xor_u64)), du8_eighth, out + 3 * num_elements + i);
+        hn::StoreU(hn::TruncateTo(du8_eighth, hn::ShiftRight<32>(v_xor_u64)), du8_eighth, out + 4 * num_elements + i);
+        hn::StoreU(hn::TruncateTo(du8_eighth, hn::ShiftRight<40>(v_xor_u64)), du8_eighth, out + 5 * num_elements + i);
+        hn::StoreU(hn::TruncateTo(du8_eighth, hn::ShiftRight<48>(v_xor_u64)), du8_eighth, out + 6 * num_elements + i);
+        hn::StoreU(hn::TruncateTo(du8_eighth, hn::ShiftRight<56>(v_xor_u64)), du8_eighth, out + 7 * num_elements + i);
+    }
+#endif
+    for (; i < num_elements; ++i) {
+        store_bytes(i, hwy::BitCastScalar<uint64_t>(data[i]) ^ hwy::BitCastScalar<uint64_t>(data[i - 1]));
+    }
+}
+
+// Two passes: the XOR deltas are first gathered from the 8 byte planes straight into `out`, then
+// prefix-XORed in place two lanes at a time.
+HWY_NOINLINE void UnshuffleAndReconstruct64_1D(const uint8_t* HWY_RESTRICT shuffled_in, double* HWY_RESTRICT out, size_t num_elements, double& prev_element) {
+    if (num_elements == 0) return;
+    uint64_t prev_u64 = hwy::BitCastScalar<uint64_t>(prev_element);
+
+    size_t i = 0;
+#if HWY_TARGET != HWY_SCALAR && HWY_HAVE_FLOAT64
+    const hn::ScalableTag<double> d64;
+    const hn::Rebind<uint8_t, decltype(du64)> du8_eighth;
+    const size_t f64_lanes = hn::Lanes(d64);
+
+    for (; i + f64_lanes <= num_elements; i += f64_lanes) {
+        VU64 v_delta_u64 = hn::PromoteTo(du64, hn::LoadU(du8_eighth, shuffled_in + 0 * num_elements + i));
+        v_delta_u64 = hn::Or(v_delta_u64, hn::ShiftLeft<8>(hn::PromoteTo(du64, hn::LoadU(du8_eighth, shuffled_in + 1 * num_elements + i))));
+        v_delta_u64 = hn::Or(v_delta_u64, hn::ShiftLeft<16>(hn::PromoteTo(du64, hn::LoadU(du8_eighth, shuffled_in + 2 * num_elements + i))));
+        v_delta_u64 = hn::Or(v_delta_u64, hn::ShiftLeft<24>(hn::PromoteTo(du64, hn::LoadU(du8_eighth, shuffled_in + 3 * num_elements + i))));
+        v_delta_u64 = hn::Or(v_delta_u64, hn::ShiftLeft<32>(hn::PromoteTo(du64, hn::LoadU(du8_eighth, shuffled_in + 4 * num_elements + i))));
+        v_delta_u64 = hn::Or(v_delta_u64, hn::ShiftLeft<40>(hn::PromoteTo(du64, hn::LoadU(du8_eighth, shuffled_in + 5 * num_elements + i))));
+        v_delta_u64 = hn::Or(v_delta_u64, hn::ShiftLeft<48>(hn::PromoteTo(du64, hn::LoadU(du8_eighth, shuffled_in + 6 * num_elements + i))));
+        v_delta_u64 = hn::Or(v_delta_u64, hn::ShiftLeft<56>(hn::PromoteTo(du64, hn::LoadU(du8_eighth, shuffled_in + 7 * num_elements + i))));
+        hn::StoreU(hn::BitCast(d64, v_delta_u64), d64, out + i);
+    }
+#endif
+    for (; i < num_elements; ++i) {
+        uint64_t u64_delta = 0;
+        for (size_t b = 0; b < sizeof(uint64_t); ++b) {
+            u64_delta |= static_cast<uint64_t>(shuffled_in[b * num_elements + i]) << (8 * b);
+        }
+        out[i] = hwy::BitCastScalar<double>(u64_delta);
+    }
+
+    i = 0;
+#if HWY_TARGET != HWY_SCALAR && HWY_HAVE_FLOAT64
+    const hn::FixedTag<double, 2> d64_128;
+    const hn::FixedTag<uint64_t, 2> du64_128;
+
+    for (; i + 2 <= num_elements; i += 2) {
+        const auto v_delta_u64 = hn::BitCast(du64_128, hn::LoadU(d64_128, out + i));
+        const auto v_scan = hn::Xor(v_delta_u64, hn::SlideUpLanes(du64_128, v_delta_u64, 1));
+        const auto v_recon_u64 = hn::Xor(v_scan, hn::Set(du64_128, prev_u64));
+        hn::StoreU(hn::BitCast(d64_128, v_recon_u64), d64_128, out + i);
+        prev_u64 = hn::ExtractLane(v_recon_u64, 1);
+    }
+#endif
+    for (; i < num_elements; ++i) {
+        prev_u64 ^= hwy::BitCastScalar<uint64_t>(out[i]);
+        out[i] = hwy::BitCastScalar<double>(prev_u64);
+    }
+    prev_element = hwy::BitCastScalar<double>(prev_u64);
+}
+
 HWY_NOINLINE void XorInt64_1D(const int64_t* HWY_RESTRICT data, int64_t* HWY_RESTRICT out, size_t num_elements, int64_t prev_element) {
     if (num_elements == 0) return;
     out[0] = data[0] ^ prev_element;
@@ -408,6 +580,63 @@ HWY_NOINLINE void CumulativeSumInt64_1D(const int64_t* HWY_RESTRICT delta, int64
     }
 }
 
+// out[i] = x[i] - 2 * x[i - 1] + x[i - 2] with x[-1] = x[-2] = prev_element: the delta before the chunk is
+// taken as zero, so the last element alone is enough state to chain chunks. All arithmetic wraps.
+HWY_NOINLINE void DoubleDeltaInt64_1D(const int64_t* HWY_RESTRICT data, int64_t* HWY_RESTRICT out, size_t num_elements, int64_t prev_element) {
+    if (num_elements == 0) return;
+    const auto second_difference = [](const int64_t cur, const int64_t prev1, const int64_t prev2) {
+        return hwy::BitCastScalar<int64_t>(hwy::BitCastScalar<uint64_t>(cur) - 2 * hwy::BitCastScalar<uint64_t>(prev1) + hwy::BitCastScalar<uint64_t>(prev2));
+    };
+    out[0] = second_difference(data[0], prev_element, prev_element);
+    if (num_elements == 1) return;
+    out[1] = second_difference(data[1], data[0], prev_element);
+
+    size_t i = 2;
+#if HWY_TARGET != HWY_SCALAR
+    const size_t lanes = hn::Lanes(di64);
+    for (; i + lanes <= num_elements; i += lanes) {
+        const VI64 v_curr = hn::LoadU(di64, data + i);
+        const VI64 v_prev1 = hn::LoadU(di64, data + i - 1);
+        const VI64 v_prev2 = hn::LoadU(di64, data + i - 2);
+        hn::StoreU(hn::Sub(hn::Sub(v_curr, v_prev1), hn::Sub(v_prev1, v_prev2)), di64, out + i);
+    }
+#endif
+    for (; i < num_elements; ++i) {
+        out[i] = second_difference(data[i], data[i - 1], data[i - 2]);
+    }
+}
+
+// Two-level prefix sum: the deltas are rebuilt from the second differences and the values from the deltas
+// in the same pass, two lanes at a time like CumulativeSumInt64_1D.
+HWY_NOINLINE void DoubleCumulativeSumInt64_1D(const int64_t* HWY_RESTRICT delta, int64_t* HWY_RESTRICT out, size_t num_elements, int64_t& prev_element) {
+    if (num_elements == 0) return;
+    uint64_t current_delta = 0;
+    uint64_t current_value = hwy::BitCastScalar<uint64_t>(prev_element);
+    size_t i = 0;
+
+#if HWY_TARGET != HWY_SCALAR
+    const hn::FixedTag<uint64_t, 2> du64_128;
+    const hn::FixedTag<int64_t, 2> di64_128;
+
+    for (; i + 2 <= num_elements; i += 2) {
+        const auto v_dd = hn::BitCast(du64_128, hn::LoadU(di64_128, delta + i));
+        const auto v_delta = hn::Add(hn::Add(v_dd, hn::SlideUpLanes(du64_128, v_dd, 1)), hn::Set(du64_128, current_delta));
+        const auto v_recon = hn::Add(hn::Add(v_delta, hn::SlideUpLanes(du64_128, v_delta, 1)), hn::Set(du64_128, current_value));
+        hn::StoreU(hn::BitCast(di64_128, v_recon), di64_128, out + i);
+        current_delta = hn::ExtractLane(v_delta, 1);
+        current_value = hn::ExtractLane(v_recon, 1);
+    }
+#endif
+
+    for (; i < num_elements; ++i) {
+        current_delta += hwy::BitCastScalar<uint64_t>(delta[i]);
+        current_value += current_delta;
+        out[i] = hwy::BitCastScalar<int64_t>(current_value);
+    }
+
+    prev_element = hwy::BitCastScalar<int64_t>(current_value);
+}
+
 } // namespace cryptodd::HWY_NAMESPACE
 HWY_AFTER_NAMESPACE();
 
@@ -428,6 +657,11 @@ namespace simd {
         HWY_DYNAMIC_DISPATCH(ShuffleFloat16_1D)(in, out, num_elements);
     }
 
+    HWY_EXPORT(DemoteXorShuffle16_1D);
+    HWY_NOINLINE void DemoteXorShuffle16_1D_dispatcher(const float* data, uint8_t* out, size_t num_elements, float prev_element) {
+        HWY_DYNAMIC_DISPATCH(DemoteXorShuffle16_1D)(data, out, num_elements, prev_element);
+    }
+
     HWY_EXPORT(UnshuffleAndReconstruct16_1D);
     HWY_NOINLINE void UnshuffleAndReconstruct16_1D_dispatcher(const uint8_t* shuffled_in, float* out, size_t num_elements, float& prev_element) {
         HWY_DYNAMIC_DISPATCH(UnshuffleAndReconstruct16_1D)(shuffled_in, out, num_elements, prev_element);
@@ -443,11 +677,26 @@ namespace simd {
         HWY_DYNAMIC_DISPATCH(ShuffleFloat32_1D)(in, out, num_elements);
     }
 
+    HWY_EXPORT(XorShuffleFloat32_1D);
+    HWY_NOINLINE void XorShuffleFloat32_1D_dispatcher(const float* data, uint8_t* out, size_t num_elements, float prev_element) {
+        HWY_DYNAMIC_DISPATCH(XorShuffleFloat32_1D)(data, out, num_elements, prev_element);
+    }
+
     HWY_EXPORT(UnshuffleAndReconstruct32_1D);
     HWY_NOINLINE void UnshuffleAndReconstruct32_1D_dispatcher(const uint8_t* shuffled_in, float* out, size_t num_elements, float& prev_element) {
         HWY_DYNAMIC_DISPATCH(UnshuffleAndReconstruct32_1D)(shuffled_in, out, num_elements, prev_element);
     }
 
+    HWY_EXPORT(XorShuffleFloat64_1D);
+    HWY_NOINLINE void XorShuffleFloat64_1D_dispatcher(const double* data, uint8_t* out, size_t num_elements, double prev_element) {
+        HWY_DYNAMIC_DISPATCH(XorShuffleFloat64_1D)(data, out, num_elements, prev_element);
+    }
+
+    HWY_EXPORT(UnshuffleAndReconstruct64_1D);
+    HWY_NOINLINE void UnshuffleAndReconstruct64_1D_dispatcher(const uint8_t* shuffled_in, double* out, size_t num_elements, double& prev_element) {
+        HWY_DYNAMIC_DISPATCH(UnshuffleAndReconstruct64_1D)(shuffled_in, out, num_elements, prev_element);
+    }
+
     HWY_EXPORT(XorInt64_1D);
     HWY_NOINLINE void XorInt64_1D_dispatcher(const int64_t* data, int64_t* out, size_t num_elements, int64_t prev_element) {
         HWY_DYNAMIC_DISPATCH(XorInt64_1D)(data, out, num_elements, prev_element);
@@ -467,6 +716,16 @@ namespace simd {
     HWY_NOINLINE void CumulativeSumInt64_1D_dispatcher(const int64_t* delta, int64_t* out, size_t num_elements, int64_t& prev_element) {
         HWY_DYNAMIC_DISPATCH(CumulativeSumInt64_1D)(delta, out, num_elements, prev_element);
     }
+
+    HWY_EXPORT(DoubleDeltaInt64_1D);
+    HWY_NOINLINE void DoubleDeltaInt64_1D_dispatcher(const int64_t* data, int64_t* out, size_t num_elements, int64_t prev_element) {
+        HWY_DYNAMIC_DISPATCH(DoubleDeltaInt64_1D)(data, out, num_elements, prev_element);
+    }
+
+    HWY_EXPORT(DoubleCumulativeSumInt64_1D);
+    HWY_NOINLINE void DoubleCumulativeSumInt64_1D_dispatcher(const int64_t* delta, int64_t* out, size_t num_elements, int64_t& prev_element) {
+        HWY_DYNAMIC_DISPATCH(DoubleCumulativeSumInt64_1D)(delta, out, num_elements, prev_element);
+    }
 } // namespace simd
 
 } // namespace cryptodd
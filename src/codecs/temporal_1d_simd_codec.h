@@ -1,6 +1,9 @@
 #pragma once
 
+#include "bitpack_simd_codec.h"
+#include "codec_constants.h"
 #include "i_compressor.h"
+#include <algorithm>
 #include <expected>
 #include <cstdint>
 #include <hwy/aligned_allocator.h>
@@ -12,6 +15,7 @@
 namespace cryptodd {
 
 using Float32AlignedVector = memory::AlignedVector<float, static_cast<std::size_t>(HWY_ALIGNMENT)>;
+using Float64AlignedVector = memory::AlignedVector<double, static_cast<std::size_t>(HWY_ALIGNMENT)>;
 using Int64AlignedVector = memory::AlignedVector<int64_t, static_cast<std::size_t>(HWY_ALIGNMENT)>;
 using ByteAlignedVector = memory::AlignedVector<std::byte, static_cast<std::size_t>(HWY_ALIGNMENT)>;
 using ByteAlignedAllocator = ByteAlignedVector::allocator_type;
@@ -20,17 +24,25 @@ using ByteAlignedAllocator = ByteAlignedVector::allocator_type;
 namespace simd {
     void DemoteAndXor1D_dispatcher(const float* data, hwy::float16_t* out, size_t num_elements, float prev_element);
     void ShuffleFloat16_1D_dispatcher(const hwy::float16_t* in, uint8_t* out, size_t num_elements);
+    void DemoteXorShuffle16_1D_dispatcher(const float* data, uint8_t* out, size_t num_elements, float prev_element);
     void UnshuffleAndReconstruct16_1D_dispatcher(const uint8_t* shuffled_in, float* out, size_t num_elements, float& prev_element);
 
     void XorFloat32_1D_dispatcher(const float* data, float* out, size_t num_elements, float prev_element);
     void ShuffleFloat32_1D_dispatcher(const float* in, uint8_t* out, size_t num_elements);
+    void XorShuffleFloat32_1D_dispatcher(const float* data, uint8_t* out, size_t num_elements, float prev_element);
     void UnshuffleAndReconstruct32_1D_dispatcher(const uint8_t* shuffled_in, float* out, size_t num_elements, float& prev_element);
 
+    void XorShuffleFloat64_1D_dispatcher(const double* data, uint8_t* out, size_t num_elements, double prev_element);
+    void UnshuffleAndReconstruct64_1D_dispatcher(const uint8_t* shuffled_in, double* out, size_t num_elements, double& prev_element);
+
     void XorInt64_1D_dispatcher(const int64_t* data, int64_t* out, size_t num_elements, int64_t prev_element);
     void UnXorInt64_1D_dispatcher(const int64_t* delta, int64_t* out, size_t num_elements, int64_t& prev_element);
 
     void DeltaInt64_1D_dispatcher(const int64_t* data, int64_t* out, size_t num_elements, int64_t prev_element);
     void CumulativeSumInt64_1D_dispatcher(const int64_t* delta, int64_t* out, size_t num_elements, int64_t& prev_element);
+
+    void DoubleDeltaInt64_1D_dispatcher(const int64_t* data, int64_t* out, size_t num_elements, int64_t prev_element);
+    void DoubleCumulativeSumInt64_1D_dispatcher(const int64_t* delta, int64_t* out, size_t num_elements, int64_t& prev_element);
 }
 
 class Temporal1dSimdCodecWorkspace {
@@ -66,12 +78,16 @@ public:
     }
 
     // Chain: float32 -> demote to float16 -> XOR -> shuffle
-    std::expected<memory::vector<std::byte>, std::string> encode16_Xor_Shuffle(std::span<const float> data, float prev_element, Temporal1dSimdCodecWorkspace& workspace) const;
-    std::expected<Float32AlignedVector, std::string> decode16_Xor_Shuffle(std::span<const std::byte> compressed, size_t num_elements, float& prev_element) const;
+    std::expected<memory::vector<std::byte>, std::string> encode16_Xor_Shuffle(std::span<const float> data, float prev_element, Temporal1dSimdCodecWorkspace& workspace, codecs::ShuffleLayout layout = codecs::ShuffleLayout::Global, const codecs::BlockVisitor& on_block = {}) const;
+    std::expected<Float32AlignedVector, std::string> decode16_Xor_Shuffle(std::span<const std::byte> compressed, size_t num_elements, float& prev_element, codecs::ShuffleLayout layout = codecs::ShuffleLayout::Global, const codecs::BlockVisitor& on_block = {}) const;
 
     // Chain: float32 -> XOR -> shuffle
-    std::expected<memory::vector<std::byte>, std::string> encode32_Xor_Shuffle(std::span<const float> data, float prev_element, Temporal1dSimdCodecWorkspace& workspace) const;
-    std::expected<Float32AlignedVector, std::string> decode32_Xor_Shuffle(std::span<const std::byte> compressed, size_t num_elements, float& prev_element) const;
+    std::expected<memory::vector<std::byte>, std::string> encode32_Xor_Shuffle(std::span<const float> data, float prev_element, Temporal1dSimdCodecWorkspace& workspace, codecs::ShuffleLayout layout = codecs::ShuffleLayout::Global, const codecs::BlockVisitor& on_block = {}) const;
+    std::expected<Float32AlignedVector, std::string> decode32_Xor_Shuffle(std::span<const std::byte> compressed, size_t num_elements, float& prev_element, codecs::ShuffleLayout layout = codecs::ShuffleLayout::Global, const codecs::BlockVisitor& on_block = {}) const;
+
+    // Chain: float64 -> XOR -> 8-byte shuffle
+    std::expected<memory::vector<std::byte>, std::string> encode64_Xor_Shuffle(std::span<const double> data, double prev_element, Temporal1dSimdCodecWorkspace& workspace, codecs::ShuffleLayout layout = codecs::ShuffleLayout::Global, const codecs::BlockVisitor& on_block = {}) const;
+    std::expected<Float64AlignedVector, std::string> decode64_Xor_Shuffle(std::span<const std::byte> compressed, size_t num_elements, double& prev_element, codecs::ShuffleLayout layout = codecs::ShuffleLayout::Global, const codecs::BlockVisitor& on_block = {}) const;
 
     // Chain: int64 -> XOR
     std::expected<memory::vector<std::byte>, std::string> encode64_Xor(std::span<const int64_t> data, int64_t prev_element, Temporal1dSimdCodecWorkspace& workspace) const;
@@ -81,56 +97,115 @@ public:
     std::expected<memory::vector<std::byte>, std::string> encode64_Delta(std::span<const int64_t> data, int64_t prev_element, Temporal1dSimdCodecWorkspace& workspace) const;
     std::expected<Int64AlignedVector, std::string> decode64_Delta(std::span<const std::byte> compressed, size_t num_elements, int64_t& prev_element) const;
 
+    // Chain: int64 -> delta-of-delta, for near-constant-interval series such as timestamps
+    std::expected<memory::vector<std::byte>, std::string> encode64_DoubleDelta(std::span<const int64_t> data, int64_t prev_element, Temporal1dSimdCodecWorkspace& workspace) const;
+    std::expected<Int64AlignedVector, std::string> decode64_DoubleDelta(std::span<const std::byte> compressed, size_t num_elements, int64_t& prev_element) const;
+
+    // Chain: int64 -> delta -> zigzag -> FOR/PFor bit-packing [-> compressor]
+    std::expected<memory::vector<std::byte>, std::string> encode64_Delta_BitPack(std::span<const int64_t> data, int64_t prev_element, Temporal1dSimdCodecWorkspace& workspace, bool compress = false) const;
+    std::expected<Int64AlignedVector, std::string> decode64_Delta_BitPack(std::span<const std::byte> encoded, size_t num_elements, int64_t& prev_element, bool compressed = false) const;
+
 private:
+    template <typename T> using EncodeFn = void (*)(const T*, uint8_t*, size_t, T);
+    template <typename T> using DecodeFn = void (*)(const uint8_t*, T*, size_t, T&);
+
+    template <typename T>
+    static void encode_planes(EncodeFn<T> encode, std::span<const T> data, uint8_t* out, size_t elem_size, T prev_element, codecs::ShuffleLayout layout, const codecs::BlockVisitor& on_block);
+    template <typename T>
+    std::expected<memory::AlignedVector<T, static_cast<std::size_t>(HWY_ALIGNMENT)>, std::string> decode_planes(DecodeFn<T> decode, std::span<const std::byte> compressed, size_t num_elements, size_t elem_size, T& prev_element, codecs::ShuffleLayout layout, const codecs::BlockVisitor& on_block) const;
+
     std::unique_ptr<ICompressor> compressor_;
 };
 
 // --- Implementation for Temporal1dSimdCodec ---
 
-inline std::expected<memory::vector<std::byte>, std::string> Temporal1dSimdCodec::encode16_Xor_Shuffle(std::span<const float> data, float prev_element, Temporal1dSimdCodecWorkspace& workspace) const {
-    workspace.ensure_capacity(data.size());
-    auto* f16_deltas = reinterpret_cast<hwy::float16_t*>(workspace.buffer1().get());
-    simd::DemoteAndXor1D_dispatcher(data.data(), f16_deltas, data.size(), prev_element);
-    
-    auto* shuffled_bytes = workspace.buffer2().get();
-    simd::ShuffleFloat16_1D_dispatcher(f16_deltas, shuffled_bytes, data.size());
+// Blocked layout: every block is shuffled on its own, its first delta taken against the last element of the previous block.
+// `on_block` sees each input block just before it is encoded, so both read it from cache.
+template <typename T>
+void Temporal1dSimdCodec::encode_planes(const EncodeFn<T> encode, std::span<const T> data, uint8_t* out, const size_t elem_size, const T prev_element, const codecs::ShuffleLayout layout, const codecs::BlockVisitor& on_block) {
+    if (layout == codecs::ShuffleLayout::Global) {
+        if (on_block) on_block(std::as_bytes(data));
+        encode(data.data(), out, data.size(), prev_element);
+        return;
+    }
+    const size_t block_elements = codecs::ShuffleBlock::rows_per_block(elem_size);
+    for (size_t offset = 0; offset < data.size(); offset += block_elements) {
+        const size_t count = std::min(block_elements, data.size() - offset);
+        if (on_block) on_block(std::as_bytes(data.subspan(offset, count)));
+        encode(data.data() + offset, out + offset * elem_size, count, offset == 0 ? prev_element : data[offset - 1]);
+    }
+}
 
+// Blocked layout: streams the decompressed bytes one block at a time, carrying prev_element across blocks.
+// `on_block` sees each reconstructed block right after it is written.
+template <typename T>
+std::expected<memory::AlignedVector<T, static_cast<std::size_t>(HWY_ALIGNMENT)>, std::string> Temporal1dSimdCodec::decode_planes(const DecodeFn<T> decode, std::span<const std::byte> compressed, const size_t num_elements, const size_t elem_size, T& prev_element, const codecs::ShuffleLayout layout, const codecs::BlockVisitor& on_block) const {
+    using OutVector = memory::AlignedVector<T, static_cast<std::size_t>(HWY_ALIGNMENT)>;
     static_assert(sizeof(std::byte) == sizeof(uint8_t));
-    return compressor_->compress({reinterpret_cast<const std::byte*>(shuffled_bytes), data.size() * sizeof(hwy::float16_t)});
+    if (layout == codecs::ShuffleLayout::Global) {
+        auto shuffled_bytes_result = compressor_->decompress_to<ByteAlignedAllocator>(compressed);
+        if (!shuffled_bytes_result) return std::unexpected(shuffled_bytes_result.error());
+        if (shuffled_bytes_result->size() != num_elements * elem_size) return std::unexpected("Decompressed data size mismatch");
+
+        OutVector out_data(num_elements);
+        decode(reinterpret_cast<const uint8_t*>(shuffled_bytes_result->data()), out_data.data(), num_elements, prev_element);
+        if (on_block) on_block(std::as_bytes(std::span<const T>(out_data)));
+        return out_data;
+    }
+
+    OutVector out_data(num_elements);
+    size_t offset = 0;
+    auto decompressed = compressor_->decompress_blocks(compressed, codecs::ShuffleBlock::rows_per_block(elem_size) * elem_size,
+        [&](std::span<const std::byte> block) -> std::expected<void, std::string> {
+            const size_t count = block.size() / elem_size;
+            if (count * elem_size != block.size() || offset + count > num_elements) return std::unexpected("Decompressed data size mismatch");
+            decode(reinterpret_cast<const uint8_t*>(block.data()), out_data.data() + offset, count, prev_element);
+            if (on_block) on_block(std::as_bytes(std::span<const T>(out_data.data() + offset, count)));
+            offset += count;
+            return {};
+        });
+    if (!decompressed) return std::unexpected(decompressed.error());
+    if (offset != num_elements) return std::unexpected("Decompressed data size mismatch");
+    return out_data;
 }
 
-inline std::expected<Float32AlignedVector, std::string> Temporal1dSimdCodec::decode16_Xor_Shuffle(std::span<const std::byte> compressed, size_t num_elements, float& prev_element) const {
-    auto shuffled_bytes_result = compressor_->decompress_to<ByteAlignedAllocator>(compressed);
-    if (!shuffled_bytes_result) return std::unexpected(shuffled_bytes_result.error());
-    if (shuffled_bytes_result->size() != num_elements * sizeof(hwy::float16_t)) return std::unexpected("Decompressed data size mismatch");
+inline std::expected<memory::vector<std::byte>, std::string> Temporal1dSimdCodec::encode16_Xor_Shuffle(std::span<const float> data, float prev_element, Temporal1dSimdCodecWorkspace& workspace, const codecs::ShuffleLayout layout, const codecs::BlockVisitor& on_block) const {
+    workspace.ensure_capacity(data.size());
+    auto* shuffled_bytes = workspace.buffer1().get();
+    encode_planes(&simd::DemoteXorShuffle16_1D_dispatcher, data, shuffled_bytes, sizeof(hwy::float16_t), prev_element, layout, on_block);
 
-    Float32AlignedVector out_data(num_elements);
     static_assert(sizeof(std::byte) == sizeof(uint8_t));
-    simd::UnshuffleAndReconstruct16_1D_dispatcher(reinterpret_cast<const uint8_t*>(shuffled_bytes_result->data()), out_data.data(), num_elements, prev_element);
-    return out_data;
+    return compressor_->compress({reinterpret_cast<const std::byte*>(shuffled_bytes), data.size() * sizeof(hwy::float16_t)});
 }
 
-inline std::expected<memory::vector<std::byte>, std::string> Temporal1dSimdCodec::encode32_Xor_Shuffle(std::span<const float> data, float prev_element, Temporal1dSimdCodecWorkspace& workspace) const {
-    workspace.ensure_capacity(data.size());
-    auto* f32_deltas = reinterpret_cast<float*>(workspace.buffer1().get());
-    simd::XorFloat32_1D_dispatcher(data.data(), f32_deltas, data.size(), prev_element);
+inline std::expected<Float32AlignedVector, std::string> Temporal1dSimdCodec::decode16_Xor_Shuffle(std::span<const std::byte> compressed, size_t num_elements, float& prev_element, const codecs::ShuffleLayout layout, const codecs::BlockVisitor& on_block) const {
+    return decode_planes(&simd::UnshuffleAndReconstruct16_1D_dispatcher, compressed, num_elements, sizeof(hwy::float16_t), prev_element, layout, on_block);
+}
 
-    auto* shuffled_bytes = workspace.buffer2().get();
-    simd::ShuffleFloat32_1D_dispatcher(f32_deltas, shuffled_bytes, data.size());
+inline std::expected<memory::vector<std::byte>, std::string> Temporal1dSimdCodec::encode32_Xor_Shuffle(std::span<const float> data, float prev_element, Temporal1dSimdCodecWorkspace& workspace, const codecs::ShuffleLayout layout, const codecs::BlockVisitor& on_block) const {
+    workspace.ensure_capacity(data.size());
+    auto* shuffled_bytes = workspace.buffer1().get();
+    encode_planes(&simd::XorShuffleFloat32_1D_dispatcher, data, shuffled_bytes, sizeof(float), prev_element, layout, on_block);
 
     static_assert(sizeof(std::byte) == sizeof(uint8_t));
     return compressor_->compress({reinterpret_cast<const std::byte*>(shuffled_bytes), data.size() * sizeof(float)});
 }
 
-inline std::expected<Float32AlignedVector, std::string> Temporal1dSimdCodec::decode32_Xor_Shuffle(std::span<const std::byte> compressed, size_t num_elements, float& prev_element) const {
-    auto shuffled_bytes_result = compressor_->decompress_to<ByteAlignedAllocator>(compressed);
-    if (!shuffled_bytes_result) return std::unexpected(shuffled_bytes_result.error());
-    if (shuffled_bytes_result->size() != num_elements * sizeof(float)) return std::unexpected("Decompressed data size mismatch");
+inline std::expected<Float32AlignedVector, std::string> Temporal1dSimdCodec::decode32_Xor_Shuffle(std::span<const std::byte> compressed, size_t num_elements, float& prev_element, const codecs::ShuffleLayout layout, const codecs::BlockVisitor& on_block) const {
+    return decode_planes(&simd::UnshuffleAndReconstruct32_1D_dispatcher, compressed, num_elements, sizeof(float), prev_element, layout, on_block);
+}
+
+inline std::expected<memory::vector<std::byte>, std::string> Temporal1dSimdCodec::encode64_Xor_Shuffle(std::span<const double> data, double prev_element, Temporal1dSimdCodecWorkspace& workspace, const codecs::ShuffleLayout layout, const codecs::BlockVisitor& on_block) const {
+    workspace.ensure_capacity(data.size());
+    auto* shuffled_bytes = workspace.buffer1().get();
+    encode_planes(&simd::XorShuffleFloat64_1D_dispatcher, data, shuffled_bytes, sizeof(double), prev_element, layout, on_block);
 
-    Float32AlignedVector out_data(num_elements);
     static_assert(sizeof(std::byte) == sizeof(uint8_t));
-    simd::UnshuffleAndReconstruct32_1D_dispatcher(reinterpret_cast<const uint8_t*>(shuffled_bytes_result->data()), out_data.data(), num_elements, prev_element);
-    return out_data;
+    return compressor_->compress({reinterpret_cast<const std::byte*>(shuffled_bytes), data.size() * sizeof(double)});
+}
+
+inline std::expected<Float64AlignedVector, std::string> Temporal1dSimdCodec::decode64_Xor_Shuffle(std::span<const std::byte> compressed, size_t num_elements, double& prev_element, const codecs::ShuffleLayout layout, const codecs::BlockVisitor& on_block) const {
+    return decode_planes(&simd::UnshuffleAndReconstruct64_1D_dispatcher, compressed, num_elements, sizeof(double), prev_element, layout, on_block);
 }
 
 inline std::expected<memory::vector<std::byte>, std::string> Temporal1dSimdCodec::encode64_Xor(std::span<const int64_t> data, int64_t prev_element, Temporal1dSimdCodecWorkspace& workspace) const {
@@ -169,4 +244,49 @@ inline std::expected<Int64AlignedVector, std::string> Temporal1dSimdCodec::decod
     return out_data;
 }
 
+inline std::expected<memory::vector<std::byte>, std::string> Temporal1dSimdCodec::encode64_DoubleDelta(std::span<const int64_t> data, int64_t prev_element, Temporal1dSimdCodecWorkspace& workspace) const {
+    workspace.ensure_capacity(data.size());
+    auto* i64_deltas = reinterpret_cast<int64_t*>(workspace.buffer1().get());
+    simd::DoubleDeltaInt64_1D_dispatcher(data.data(), i64_deltas, data.size(), prev_element);
+    static_assert(sizeof(std::byte) == sizeof(uint8_t));
+    return compressor_->compress({reinterpret_cast<const std::byte*>(i64_deltas), data.size() * sizeof(int64_t)});
+}
+
+inline std::expected<Int64AlignedVector, std::string> Temporal1dSimdCodec::decode64_DoubleDelta(std::span<const std::byte> compressed, size_t num_elements, int64_t& prev_element) const {
+    auto delta_bytes_result = compressor_->decompress_to<ByteAlignedAllocator>(compressed);
+    if (!delta_bytes_result) return std::unexpected(delta_bytes_result.error());
+    if (delta_bytes_result->size() != num_elements * sizeof(int64_t)) return std::unexpected("Decompressed data size mismatch");
+
+    Int64AlignedVector out_data(num_elements);
+    simd::DoubleCumulativeSumInt64_1D_dispatcher(reinterpret_cast<const int64_t*>(delta_bytes_result->data()), out_data.data(), num_elements, prev_element);
+    return out_data;
+}
+
+inline std::expected<memory::vector<std::byte>, std::string> Temporal1dSimdCodec::encode64_Delta_BitPack(std::span<const int64_t> data, int64_t prev_element, Temporal1dSimdCodecWorkspace& workspace, const bool compress) const {
+    workspace.ensure_capacity(data.size());
+    auto* zigzag_deltas = reinterpret_cast<uint64_t*>(workspace.buffer1().get());
+    simd::ZigZagDeltaInt64_1D_dispatcher(data.data(), zigzag_deltas, data.size(), prev_element);
+
+    memory::vector<std::byte> packed(bitpack::max_encoded_size(data.size()));
+    packed.resize(bitpack::encode({zigzag_deltas, data.size()}, packed.data()));
+    if (!compress) return packed;
+    return compressor_->compress(packed);
+}
+
+inline std::expected<Int64AlignedVector, std::string> Temporal1dSimdCodec::decode64_Delta_BitPack(std::span<const std::byte> encoded, size_t num_elements, int64_t& prev_element, const bool compressed) const {
+    ByteAlignedVector decompressed;
+    if (compressed) {
+        auto decompressed_result = compressor_->decompress_to<ByteAlignedAllocator>(encoded);
+        if (!decompressed_result) return std::unexpected(decompressed_result.error());
+        decompressed = std::move(*decompressed_result);
+        encoded = decompressed;
+    }
+
+    Int64AlignedVector out_data(num_elements);
+    auto* zigzag_deltas = reinterpret_cast<uint64_t*>(out_data.data());
+    if (auto unpacked = bitpack::decode(encoded, {zigzag_deltas, num_elements}); !unpacked) return std::unexpected(unpacked.error());
+    simd::UnZigZagCumulativeSumInt64_1D_dispatcher(zigzag_deltas, out_data.data(), num_elements, prev_element);
+    return out_data;
+}
+
 } // namespace cryptodd
@@ -116,12 +116,69 @@ HWY_NOINLINE void ShuffleFloat16_2D(const hwy::float16_t* HWY_RESTRICT in, uint8
     }
 }
 
-HWY_NOINLINE void UnshuffleAndReconstruct16_2D(const uint8_t* HWY_RESTRICT shuffled_in, float* HWY_RESTRICT out,
-                                               size_t num_rows, size_t num_features, std::span<float> prev_row_state) {
+// Fused single-pass variant of DemoteAndXor2D + ShuffleFloat16_2D: the XOR delta of each
+// column is demoted, combined and split into byte planes in registers, so the intermediate
+// f16 delta buffer is never written. Output is byte-identical to the two-pass pipeline.
+// Column f is read from soa_data + f * column_stride, so a block of rows can be encoded
+// straight out of a larger SoA buffer; the output planes are always dense (num_rows per column).
+HWY_NOINLINE void DemoteXorShuffle16_2D_Strided(const float* HWY_RESTRICT soa_data, const float* HWY_RESTRICT prev_row,
+                                                uint8_t* HWY_RESTRICT out, size_t num_rows, size_t num_features,
+                                                size_t column_stride) {
+    if (num_rows == 0) return;
     const size_t total_elements = num_rows * num_features;
 
     for (size_t f = 0; f < num_features; ++f) {
-        float* HWY_RESTRICT feature_out = out + f * num_rows;
+        const float* HWY_RESTRICT feature_col_in = soa_data + f * column_stride;
+        uint8_t* HWY_RESTRICT out_b0 = out + f * num_rows;
+        uint8_t* HWY_RESTRICT out_b1 = out + total_elements + f * num_rows;
+
+        // First element uses prev_row
+        const hwy::float16_t f16_curr = hwy::ConvertScalarTo<hwy::float16_t>(feature_col_in[0]);
+        const hwy::float16_t f16_prev = hwy::ConvertScalarTo<hwy::float16_t>(prev_row[f]);
+        const uint16_t u16_xor = hwy::BitCastScalar<uint16_t>(f16_curr) ^ hwy::BitCastScalar<uint16_t>(f16_prev);
+        out_b0[0] = static_cast<uint8_t>(u16_xor & 0xFF);
+        out_b1[0] = static_cast<uint8_t>(u16_xor >> 8);
+
+        size_t i = 1;
+#if HWY_TARGET != HWY_SCALAR
+        const hn::Rebind<hwy::float16_t, decltype(d32)> d16_half;
+        const hn::Rebind<uint16_t, decltype(d32)> du16_half;
+        const hn::Rebind<uint8_t, decltype(d32)> du8_quarter;
+        const size_t f32_lanes = hn::Lanes(d32);
+
+        for (; i + f32_lanes <= num_rows; i += f32_lanes) {
+            const auto v_curr_u16 = hn::BitCast(du16_half, hn::DemoteTo(d16_half, hn::LoadU(d32, feature_col_in + i)));
+            const auto v_prev_u16 = hn::BitCast(du16_half, hn::DemoteTo(d16_half, hn::LoadU(d32, feature_col_in + i - 1)));
+            const auto v_xor_u16 = hn::Xor(v_curr_u16, v_prev_u16);
+
+            hn::StoreU(hn::TruncateTo(du8_quarter, v_xor_u16), du8_quarter, out_b0 + i);
+            hn::StoreU(hn::TruncateTo(du8_quarter, hn::ShiftRight<8>(v_xor_u16)), du8_quarter, out_b1 + i);
+        }
+#endif
+        // Scalar remainder loop
+        for (; i < num_rows; ++i) {
+            const hwy::float16_t f16_c = hwy::ConvertScalarTo<hwy::float16_t>(feature_col_in[i]);
+            const hwy::float16_t f16_p = hwy::ConvertScalarTo<hwy::float16_t>(feature_col_in[i - 1]);
+            const uint16_t u16_x = hwy::BitCastScalar<uint16_t>(f16_c) ^ hwy::BitCastScalar<uint16_t>(f16_p);
+            out_b0[i] = static_cast<uint8_t>(u16_x & 0xFF);
+            out_b1[i] = static_cast<uint8_t>(u16_x >> 8);
+        }
+    }
+}
+
+HWY_NOINLINE void DemoteXorShuffle16_2D(const float* HWY_RESTRICT soa_data, const float* HWY_RESTRICT prev_row,
+                                        uint8_t* HWY_RESTRICT out, size_t num_rows, size_t num_features) {
+    DemoteXorShuffle16_2D_Strided(soa_data, prev_row, out, num_rows, num_features, num_rows);
+}
+
+// Inverse of DemoteXorShuffle16_2D_Strided: dense planes in, column f written to out + f * column_stride.
+HWY_NOINLINE void UnshuffleAndReconstruct16_2D_Strided(const uint8_t* HWY_RESTRICT shuffled_in, float* HWY_RESTRICT out,
+                                                       size_t num_rows, size_t num_features, size_t column_stride,
+                                                       std::span<float> prev_row_state) {
+    const size_t total_elements = num_rows * num_features;
+
+    for (size_t f = 0; f < num_features; ++f) {
+        float* HWY_RESTRICT feature_out = out + f * column_stride;
         const uint8_t* HWY_RESTRICT in_b0 = shuffled_in + f * num_rows;
         const uint8_t* HWY_RESTRICT in_b1 = shuffled_in + total_elements + f * num_rows;
 
@@ -176,6 +233,11 @@ HWY_NOINLINE void UnshuffleAndReconstruct16_2D(const uint8_t* HWY_RESTRICT shuff
     }
 }
 
+HWY_NOINLINE void UnshuffleAndReconstruct16_2D(const uint8_t* HWY_RESTRICT shuffled_in, float* HWY_RESTRICT out,
+                                               size_t num_rows, size_t num_features, std::span<float> prev_row_state) {
+    UnshuffleAndReconstruct16_2D_Strided(shuffled_in, out, num_rows, num_features, num_rows, prev_row_state);
+}
+
 HWY_NOINLINE void XorFloat32_2D(const float* HWY_RESTRICT soa_data, const float* HWY_RESTRICT prev_row,
                                 float* HWY_RESTRICT out, size_t num_rows, size_t num_features) {
     if (num_rows == 0) return;
@@ -262,12 +324,66 @@ HWY_NOINLINE void ShuffleFloat32_2D(const float* HWY_RESTRICT in, uint8_t* HWY_R
     }
 }
 
-HWY_NOINLINE void UnshuffleAndReconstruct32_2D(const uint8_t* HWY_RESTRICT shuffled_in, float* HWY_RESTRICT out,
-                                               size_t num_rows, size_t num_features, std::span<float> prev_row_state) {
+// Fused single-pass variant of XorFloat32_2D + ShuffleFloat32_2D (same column_stride contract as above).
+HWY_NOINLINE void XorShuffleFloat32_2D_Strided(const float* HWY_RESTRICT soa_data, const float* HWY_RESTRICT prev_row,
+                                               uint8_t* HWY_RESTRICT out, size_t num_rows, size_t num_features,
+                                               size_t column_stride) {
+    if (num_rows == 0) return;
+    const size_t total_elements = num_rows * num_features;
+
+    for (size_t f = 0; f < num_features; ++f) {
+        const float* HWY_RESTRICT feature_col_in = soa_data + f * column_stride;
+        uint8_t* HWY_RESTRICT out_b0 = out + (0 * total_elements) + (f * num_rows);
+        uint8_t* HWY_RESTRICT out_b1 = out + (1 * total_elements) + (f * num_rows);
+        uint8_t* HWY_RESTRICT out_b2 = out + (2 * total_elements) + (f * num_rows);
+        uint8_t* HWY_RESTRICT out_b3 = out + (3 * total_elements) + (f * num_rows);
+
+        // First element uses prev_row
+        const uint32_t u32_first = hwy::BitCastScalar<uint32_t>(feature_col_in[0]) ^ hwy::BitCastScalar<uint32_t>(prev_row[f]);
+        out_b0[0] = static_cast<uint8_t>((u32_first      ) & 0xFF);
+        out_b1[0] = static_cast<uint8_t>((u32_first >> 8 ) & 0xFF);
+        out_b2[0] = static_cast<uint8_t>((u32_first >> 16) & 0xFF);
+        out_b3[0] = static_cast<uint8_t>((u32_first >> 24) & 0xFF);
+
+        size_t i = 1;
+#if HWY_TARGET != HWY_SCALAR
+        const hn::Rebind<uint8_t, decltype(d32)> du8_quarter;
+        const size_t f32_lanes = hn::Lanes(d32);
+
+        for (; i + f32_lanes <= num_rows; i += f32_lanes) {
+            const VU32 v_curr_u32 = hn::BitCast(du32, hn::LoadU(d32, feature_col_in + i));
+            const VU32 v_prev_u32 = hn::BitCast(du32, hn::LoadU(d32, feature_col_in + i - 1));
+            const VU32 v_xor_u32 = hn::Xor(v_curr_u32, v_prev_u32);
+
+            hn::StoreU(hn::TruncateTo(du8_quarter, v_xor_u32), du8_quarter, out_b0 + i);
+            hn::StoreU(hn::TruncateTo(du8_quarter, hn::ShiftRight<8>(v_xor_u32)), du8_quarter, out_b1 + i);
+            hn::StoreU(hn::TruncateTo(du8_quarter, hn::ShiftRight<16>(v_xor_u32)), du8_quarter, out_b2 + i);
+            hn::StoreU(hn::TruncateTo(du8_quarter, hn::ShiftRight<24>(v_xor_u32)), du8_quarter, out_b3 + i);
+        }
+#endif
+        // Scalar remainder loop
+        for (; i < num_rows; ++i) {
+            const uint32_t u32_x = hwy::BitCastScalar<uint32_t>(feature_col_in[i]) ^ hwy::BitCastScalar<uint32_t>(feature_col_in[i - 1]);
+            out_b0[i] = static_cast<uint8_t>((u32_x      ) & 0xFF);
+            out_b1[i] = static_cast<uint8_t>((u32_x >> 8 ) & 0xFF);
+            out_b2[i] = static_cast<uint8_t>((u32_x >> 16) & 0xFF);
+            out_b3[i] = static_cast<uint8_t>((u32_x >> 24) & 0xFF);
+        }
+    }
+}
+
+HWY_NOINLINE void XorShuffleFloat32_2D(const float* HWY_RESTRICT soa_data, const float* HWY_RESTRICT prev_row,
+                                       uint8_t* HWY_RESTRICT out, size_t num_rows, size_t num_features) {
+    XorShuffleFloat32_2D_Strided(soa_data, prev_row, out, num_rows, num_features, num_rows);
+}
+
+HWY_NOINLINE void UnshuffleAndReconstruct32_2D_Strided(const uint8_t* HWY_RESTRICT shuffled_in, float* HWY_RESTRICT out,
+                                                       size_t num_rows, size_t num_features, size_t column_stride,
+                                                       std::span<float> prev_row_state) {
     const size_t total_elements = num_rows * num_features;
 
     for (size_t f = 0; f < num_features; ++f) {
-        float* HWY_RESTRICT feature_out = out + f * num_rows;
+        float* HWY_RESTRICT feature_out = out + f * column_stride;
         const uint8_t* HWY_RESTRICT in_b0 = shuffled_in + (0 * total_elements) + (f * num_rows);
         const uint8_t* HWY_RESTRICT in_b1 = shuffled_in + (1 * total_elements) + (f * num_rows);
         const uint8_t* HWY_RESTRICT in_b2 = shuffled_in + (2 * total_elements) + (f * num_rows);
@@ -332,6 +448,120 @@ HWY_NOINLINE void UnshuffleAndReconstruct32_2D(const uint8_t* HWY_RESTRICT shuff
     }
 }
 
+HWY_NOINLINE void UnshuffleAndReconstruct32_2D(const uint8_t* HWY_RESTRICT shuffled_in, float* HWY_RESTRICT out,
+                                               size_t num_rows, size_t num_features, std::span<float> prev_row_state) {
+    UnshuffleAndReconstruct32_2D_Strided(shuffled_in, out, num_rows, num_features, num_rows, prev_row_state);
+}
+
+// Float64 variant of XorShuffleFloat32_2D_Strided (same column_stride contract): byte b of the XOR delta at
+// (row i, feature f) goes to out[b * total_elements + f * num_rows + i].
+HWY_NOINLINE void XorShuffleFloat64_2D_Strided(const double* HWY_RESTRICT soa_data, const double* HWY_RESTRICT prev_row,
+                                               uint8_t* HWY_RESTRICT out, size_t num_rows, size_t num_features,
+                                               size_t column_stride) {
+    if (num_rows == 0) return;
+    const size_t total_elements = num_rows * num_features;
+    const auto store_bytes = [&](uint8_t* HWY_RESTRICT planes, const uint64_t u64_xor) {
+        for (size_t b = 0; b < sizeof(uint64_t); ++b) {
+            planes[b * total_elements] = static_cast<uint8_t>((u64_xor >> (8 * b)) & 0xFF);
+        }
+    };
+
+    for (size_t f = 0; f < num_features; ++f) {
+        const double* HWY_RESTRICT feature_col_in = soa_data + f * column_stride;
+        uint8_t* HWY_RESTRICT feature_planes = out + f * num_rows;
+
+        // First element uses prev_row
+        store_bytes(feature_planes, hwy::BitCastScalar<uint64_t>(feature_col_in[0]) ^ hwy::BitCastScalar<uint64_t>(prev_row[f]));
+
+        size_t i = 1;
+#if HWY_TARGET != HWY_SCALAR && HWY_HAVE_FLOAT64
+        const hn::ScalableTag<double> d64;
+        const hn::Rebind<uint8_t, decltype(du64)> du8_eighth;
+        const size_t f64_lanes = hn::Lanes(d64);
+
+        for (; i + f64_lanes <= num_rows; i += f64_lanes) {
+            const auto v_xor_u64 = hn::Xor(hn::BitCast(du64, hn::LoadU(d64, feature_col_in + i)),
+                                           hn::BitCast(du64, hn::LoadU(d64, feature_col_in + i - 1)));
+
+            hn::StoreU(hn::TruncateTo(du8_eighth, v_xor_u64), du8_eighth, feature_planes + 0 * total_elements + i);
+            hn::StoreU(hn::TruncateTo(du8_eighth, hn::ShiftRight<8>(v_xor_u64)), du8_eighth, feature_planes + 1 * total_elements + i);
+            hn::StoreU(hn::TruncateTo(du8_eighth, hn::ShiftRight<16>(v_xor_u64)), du8_eighth, feature_planes + 2 * total_elements + i);
+            hn::StoreU(hn::TruncateTo(du8_eighth, hn::ShiftRight<24>(v_xor_u64)), du8_eighth, feature_planes + 3 * total_elements + i);
+            hn::StoreU(hn::TruncateTo(du8_eighth, hn::ShiftRight<32>(v_xor_u64)), du8_eighth, feature_planes + 4 * total_elements + i);
+            hn::StoreU(hn::TruncateTo(du8_eighth, hn::ShiftRight<40>(v_xor_u64)), du8_eighth, feature_planes + 5 * total_elements + i);
+            hn::StoreU(hn::TruncateTo(du8_eighth, hn::ShiftRight<48>(v_xor_u64)), du8_eighth, feature_planes + 6 * total_elements + i);
+            hn::StoreU(hn::TruncateTo(du8_eighth, hn::ShiftRight<56>(v_xor_u64)), du8_eighth, feature_planes + 7 * total_elements + i);
+        }
+#endif
+        // Scalar remainder loop
+        for (; i < num_rows; ++i) {
+            store_bytes(feature_planes + i, hwy::BitCastScalar<uint64_t>(feature_col_in[i]) ^ hwy::BitCastScalar<uint64_t>(feature_col_in[i - 1]));
+        }
+    }
+}
+
+// Each column's deltas are gathered from the byte planes into its output slice, then prefix-XORed in place
+// while the slice is still cache-hot.
+HWY_NOINLINE void UnshuffleAndReconstruct64_2D_Strided(const uint8_t* HWY_RESTRICT shuffled_in, double* HWY_RESTRICT out,
+                                                       size_t num_rows, size_t num_features, size_t column_stride,
+                                                       std::span<double> prev_row_state) {
+    if (num_rows == 0) return;
+    const size_t total_elements = num_rows * num_features;
+
+    for (size_t f = 0; f < num_features; ++f) {
+        const uint8_t* HWY_RESTRICT feature_planes = shuffled_in + f * num_rows;
+        double* HWY_RESTRICT feature_out = out + f * column_stride;
+
+        size_t i = 0;
+#if HWY_TARGET != HWY_SCALAR && HWY_HAVE_FLOAT64
+        const hn::ScalableTag<double> d64;
+        const hn::Rebind<uint8_t, decltype(du64)> du8_eighth;
+        const size_t f64_lanes = hn::Lanes(d64);
+
+        for (; i + f64_lanes <= num_rows; i += f64_lanes) {
+            auto v_delta_u64 = hn::PromoteTo(du64, hn::LoadU(du8_eighth, feature_planes + 0 * total_elements + i));
+            v_delta_u64 = hn::Or(v_delta_u64, hn::ShiftLeft<8>(hn::PromoteTo(du64, hn::LoadU(du8_eighth, feature_planes + 1 * total_elements + i))));
+            v_delta_u64 = hn::Or(v_delta_u64, hn::ShiftLeft<16>(hn::PromoteTo(du64, hn::LoadU(du8_eighth, feature_planes + 2 * total_elements + i))));
+            v_delta_u64 = hn::Or(v_delta_u64, hn::ShiftLeft<24>(hn::PromoteTo(du64, hn::LoadU(du8_eighth, feature_planes + 3 * total_elements + i))));
+            v_delta_u64 = hn::Or(v_delta_u64, hn::ShiftLeft<32>(hn::PromoteTo(du64, hn::LoadU(du8_eighth, feature_planes + 4 * total_elements + i))));
+            v_delta_u64 = hn::Or(v_delta_u64, hn::ShiftLeft<40>(hn::PromoteTo(du64, hn::LoadU(du8_eighth, feature_planes + 5 * total_elements + i))));
+            v_delta_u64 = hn::Or(v_delta_u64, hn::ShiftLeft<48>(hn::PromoteTo(du64, hn::LoadU(du8_eighth, feature_planes + 6 * total_elements + i))));
+            v_delta_u64 = hn::Or(v_delta_u64, hn::ShiftLeft<56>(hn::PromoteTo(du64, hn::LoadU(du8_eighth, feature_planes + 7 * total_elements + i))));
+            hn::StoreU(hn::BitCast(d64, v_delta_u64), d64, feature_out + i);
+        }
+#endif
+        for (; i < num_rows; ++i) {
+            uint64_t u64_delta = 0;
+            for (size_t b = 0; b < sizeof(uint64_t); ++b) {
+                u64_delta |= static_cast<uint64_t>(feature_planes[b * total_elements + i]) << (8 * b);
+            }
+            feature_out[i] = hwy::BitCastScalar<double>(u64_delta);
+        }
+
+        uint64_t prev_u64 = hwy::BitCastScalar<uint64_t>(prev_row_state[f]);
+        i = 0;
+#if HWY_TARGET != HWY_SCALAR && HWY_HAVE_FLOAT64
+        const hn::FixedTag<double, 2> d64_128;
+        const hn::FixedTag<uint64_t, 2> du64_128;
+
+        for (; i + 2 <= num_rows; i += 2) {
+            // Intra-vector prefix XOR scan: [d0, d1] -> [d0, d0^d1], then XOR with the previous value
+            const auto v_delta_u64 = hn::BitCast(du64_128, hn::LoadU(d64_128, feature_out + i));
+            const auto v_scan = hn::Xor(v_delta_u64, hn::SlideUpLanes(du64_128, v_delta_u64, 1));
+            const auto v_recon_u64 = hn::Xor(v_scan, hn::Set(du64_128, prev_u64));
+            hn::StoreU(hn::BitCast(d64_128, v_recon_u64), d64_128, feature_out + i);
+            prev_u64 = hn::ExtractLane(v_recon_u64, 1);
+        }
+#endif
+        // Scalar remainder loop
+        for (; i < num_rows; ++i) {
+            prev_u64 ^= hwy::BitCastScalar<uint64_t>(feature_out[i]);
+            feature_out[i] = hwy::BitCastScalar<double>(prev_u64);
+        }
+        prev_row_state[f] = hwy::BitCastScalar<double>(prev_u64);
+    }
+}
+
 HWY_NOINLINE void XorInt64_2D(const int64_t* HWY_RESTRICT soa_data, const int64_t* HWY_RESTRICT prev_row,
                              int64_t* HWY_RESTRICT out, size_t num_rows, size_t num_features) {
     if (num_rows == 0) return;
@@ -405,6 +635,222 @@ HWY_NOINLINE void UnXorInt64_2D(const int64_t* HWY_RESTRICT delta, int64_t* HWY_
     }
 }
 
+HWY_NOINLINE void DeltaInt64_2D(const int64_t* HWY_RESTRICT soa_data, const int64_t* HWY_RESTRICT prev_row,
+                                int64_t* HWY_RESTRICT out, size_t num_rows, size_t num_features) {
+    if (num_rows == 0) return;
+    const auto difference = [](const int64_t cur, const int64_t prev) {
+        return hwy::BitCastScalar<int64_t>(hwy::BitCastScalar<uint64_t>(cur) - hwy::BitCastScalar<uint64_t>(prev));
+    };
+    for (size_t f = 0; f < num_features; ++f) {
+        const int64_t* HWY_RESTRICT feature_col_in = soa_data + f * num_rows;
+        int64_t* HWY_RESTRICT feature_col_out = out + f * num_rows;
+
+        feature_col_out[0] = difference(feature_col_in[0], prev_row[f]);
+
+        size_t i = 1;
+#if HWY_TARGET != HWY_SCALAR
+        const size_t lanes = hn::Lanes(di64);
+        for (; i + lanes <= num_rows; i += lanes) {
+            const VI64 v_curr = hn::LoadU(di64, feature_col_in + i);
+            const VI64 v_prev = hn::LoadU(di64, feature_col_in + i - 1);
+            hn::StoreU(hn::Sub(v_curr, v_prev), di64, feature_col_out + i);
+        }
+#endif
+        for (; i < num_rows; ++i) {
+            feature_col_out[i] = difference(feature_col_in[i], feature_col_in[i - 1]);
+        }
+    }
+}
+
+// Fused DeltaInt64_2D + 8-byte shuffle (same column_stride contract as XorShuffleFloat32_2D_Strided): byte b
+// of the residual at (row i, feature f) goes to out[b * total_elements + f * num_rows + i], so the mostly-zero
+// high bytes form long runs for zstd.
+HWY_NOINLINE void DeltaShuffleInt64_2D_Strided(const int64_t* HWY_RESTRICT soa_data, const int64_t* HWY_RESTRICT prev_row,
+                                               uint8_t* HWY_RESTRICT out, size_t num_rows, size_t num_features,
+                                               size_t column_stride) {
+    if (num_rows == 0) return;
+    const size_t total_elements = num_rows * num_features;
+    const auto store_bytes = [&](uint8_t* HWY_RESTRICT planes, const uint64_t residual) {
+        for (size_t b = 0; b < sizeof(uint64_t); ++b) {
+            planes[b * total_elements] = static_cast<uint8_t>((residual >> (8 * b)) & 0xFF);
+        }
+    };
+
+    for (size_t f = 0; f < num_features; ++f) {
+        const int64_t* HWY_RESTRICT feature_col_in = soa_data + f * column_stride;
+        uint8_t* HWY_RESTRICT feature_planes = out + f * num_rows;
+
+        store_bytes(feature_planes, hwy::BitCastScalar<uint64_t>(feature_col_in[0]) - hwy::BitCastScalar<uint64_t>(prev_row[f]));
+
+        size_t i = 1;
+#if HWY_TARGET != HWY_SCALAR
+        const hn::Rebind<uint8_t, decltype(du64)> du8_eighth;
+        const size_t lanes = hn::Lanes(du64);
+        for (; i + lanes <= num_rows; i += lanes) {
+            const VI64 v_curr = hn::LoadU(di64, feature_col_in + i);
+            const VI64 v_prev = hn::LoadU(di64, feature_col_in + i - 1);
+            const auto v_delta = hn::BitCast(du64, hn::Sub(v_curr, v_prev));
+
+            hn::StoreU(hn::TruncateTo(du8_eighth, v_delta), du8_eighth, feature_planes + 0 * total_elements + i);
+            hn::StoreU(hn::TruncateTo(du8_eighth, hn::ShiftRight<8>(v_delta)), du8_eighth, feature_planes + 1 * total_elements + i);
+            hn::StoreU(hn::TruncateTo(du8_eighth, hn::ShiftRight<16>(v_delta)), du8_eighth, feature_planes + 2 * total_elements + i);
+            hn::StoreU(hn::TruncateTo(du8_eighth, hn::ShiftRight<24>(v_delta)), du8_eighth, feature_planes + 3 * total_elements + i);
+            hn::StoreU(hn::TruncateTo(du8_eighth, hn::ShiftRight<32>(v_delta)), du8_eighth, feature_planes + 4 * total_elements + i);
+            hn::StoreU(hn::TruncateTo(du8_eighth, hn::ShiftRight<40>(v_delta)), du8_eighth, feature_planes + 5 * total_elements + i);
+            hn::StoreU(hn::TruncateTo(du8_eighth, hn::ShiftRight<48>(v_delta)), du8_eighth, feature_planes + 6 * total_elements + i);
+            hn::StoreU(hn::TruncateTo(du8_eighth, hn::ShiftRight<56>(v_delta)), du8_eighth, feature_planes + 7 * total_elements + i);
+        }
+#endif
+        for (; i < num_rows; ++i) {
+            store_bytes(feature_planes + i, hwy::BitCastScalar<uint64_t>(feature_col_in[i]) - hwy::BitCastScalar<uint64_t>(feature_col_in[i - 1]));
+        }
+    }
+}
+
+// Prefix sum of one column of wrapping deltas on top of `value`; returns the last reconstructed value.
+// May run in place (feature_delta == feature_out).
+HWY_INLINE uint64_t CumulativeSumInt64Column(const int64_t* feature_delta, int64_t* feature_out,
+                                             const size_t num_rows, uint64_t value) {
+    size_t i = 0;
+#if HWY_TARGET != HWY_SCALAR
+    const hn::FixedTag<uint64_t, 2> du64_128;
+    const hn::FixedTag<int64_t, 2> di64_128;
+
+    for (; i + 2 <= num_rows; i += 2) {
+        const auto v_delta = hn::BitCast(du64_128, hn::LoadU(di64_128, feature_delta + i));
+        // Intra-vector prefix sum: [d0, d1] -> [d0, d0 + d1], then offset by the running value
+        const auto v_recon = hn::Add(hn::Add(v_delta, hn::SlideUpLanes(du64_128, v_delta, 1)), hn::Set(du64_128, value));
+        hn::StoreU(hn::BitCast(di64_128, v_recon), di64_128, feature_out + i);
+        value = hn::ExtractLane(v_recon, 1);
+    }
+#endif
+    for (; i < num_rows; ++i) {
+        value += hwy::BitCastScalar<uint64_t>(feature_delta[i]);
+        feature_out[i] = hwy::BitCastScalar<int64_t>(value);
+    }
+    return value;
+}
+
+HWY_NOINLINE void CumulativeSumInt64_2D(const int64_t* HWY_RESTRICT delta, int64_t* HWY_RESTRICT out,
+                                        size_t num_rows, size_t num_features, std::span<int64_t> prev_row_state) {
+    if (num_rows == 0) return;
+    for (size_t f = 0; f < num_features; ++f) {
+        const uint64_t last = CumulativeSumInt64Column(delta + f * num_rows, out + f * num_rows, num_rows,
+                                                       hwy::BitCastScalar<uint64_t>(prev_row_state[f]));
+        prev_row_state[f] = hwy::BitCastScalar<int64_t>(last);
+    }
+}
+
+// Inverse of DeltaShuffleInt64_2D_Strided. Each column's residuals are gathered from the byte planes into its
+// output slice and then summed in place, so the column is still cache-hot for the second pass.
+HWY_NOINLINE void UnshuffleCumulativeSumInt64_2D_Strided(const uint8_t* HWY_RESTRICT shuffled_in, int64_t* HWY_RESTRICT out,
+                                                         size_t num_rows, size_t num_features, size_t column_stride,
+                                                         std::span<int64_t> prev_row_state) {
+    if (num_rows == 0) return;
+    const size_t total_elements = num_rows * num_features;
+
+    for (size_t f = 0; f < num_features; ++f) {
+        const uint8_t* HWY_RESTRICT feature_planes = shuffled_in + f * num_rows;
+        int64_t* feature_out = out + f * column_stride;
+
+        size_t i = 0;
+#if HWY_TARGET != HWY_SCALAR
+        const hn::Rebind<uint8_t, decltype(du64)> du8_eighth;
+        const size_t lanes = hn::Lanes(du64);
+        for (; i + lanes <= num_rows; i += lanes) {
+            auto v_delta = hn::PromoteTo(du64, hn::LoadU(du8_eighth, feature_planes + 0 * total_elements + i));
+            v_delta = hn::Or(v_delta, hn::ShiftLeft<8>(hn::PromoteTo(du64, hn::LoadU(du8_eighth, feature_planes + 1 * total_elements + i))));
+            v_delta = hn::Or(v_delta, hn::ShiftLeft<16>(hn::PromoteTo(du64, hn::LoadU(du8_eighth, feature_planes + 2 * total_elements + i))));
+            v_delta = hn::Or(v_delta, hn::ShiftLeft<24>(hn::PromoteTo(du64, hn::LoadU(du8_eighth, feature_planes + 3 * total_elements + i))));
+            v_delta = hn::Or(v_delta, hn::ShiftLeft<32>(hn::PromoteTo(du64, hn::LoadU(du8_eighth, feature_planes + 4 * total_elements + i))));
+            v_delta = hn::Or(v_delta, hn::ShiftLeft<40>(hn::PromoteTo(du64, hn::LoadU(du8_eighth, feature_planes + 5 * total_elements + i))));
+            v_delta = hn::Or(v_delta, hn::ShiftLeft<48>(hn::PromoteTo(du64, hn::LoadU(du8_eighth, feature_planes + 6 * total_elements + i))));
+            v_delta = hn::Or(v_delta, hn::ShiftLeft<56>(hn::PromoteTo(du64, hn::LoadU(du8_eighth, feature_planes + 7 * total_elements + i))));
+            hn::StoreU(hn::BitCast(di64, v_delta), di64, feature_out + i);
+        }
+#endif
+        for (; i < num_rows; ++i) {
+            uint64_t residual = 0;
+            for (size_t b = 0; b < sizeof(uint64_t); ++b) {
+                residual |= static_cast<uint64_t>(feature_planes[b * total_elements + i]) << (8 * b);
+            }
+            feature_out[i] = hwy::BitCastScalar<int64_t>(residual);
+        }
+
+        const uint64_t last = CumulativeSumInt64Column(feature_out, feature_out, num_rows, hwy::BitCastScalar<uint64_t>(prev_row_state[f]));
+        prev_row_state[f] = hwy::BitCastScalar<int64_t>(last);
+    }
+}
+
+// out[i] = x[i] - 2 * x[i - 1] + x[i - 2] with x[-1] = x[-2] = prev: the delta before the column is taken
+// as zero, so the previous row alone is enough state to chain chunks. All arithmetic wraps.
+HWY_NOINLINE void DoubleDeltaInt64_2D(const int64_t* HWY_RESTRICT soa_data, const int64_t* HWY_RESTRICT prev_row,
+                                      int64_t* HWY_RESTRICT out, size_t num_rows, size_t num_features) {
+    if (num_rows == 0) return;
+    const auto second_difference = [](const int64_t cur, const int64_t prev1, const int64_t prev2) {
+        return hwy::BitCastScalar<int64_t>(hwy::BitCastScalar<uint64_t>(cur) - 2 * hwy::BitCastScalar<uint64_t>(prev1) + hwy::BitCastScalar<uint64_t>(prev2));
+    };
+    for (size_t f = 0; f < num_features; ++f) {
+        const int64_t* HWY_RESTRICT feature_col_in = soa_data + f * num_rows;
+        int64_t* HWY_RESTRICT feature_col_out = out + f * num_rows;
+
+        feature_col_out[0] = second_difference(feature_col_in[0], prev_row[f], prev_row[f]);
+        if (num_rows == 1) continue;
+        feature_col_out[1] = second_difference(feature_col_in[1], feature_col_in[0], prev_row[f]);
+
+        size_t i = 2;
+#if HWY_TARGET != HWY_SCALAR
+        const size_t lanes = hn::Lanes(di64);
+        for (; i + lanes <= num_rows; i += lanes) {
+            const VI64 v_curr = hn::LoadU(di64, feature_col_in + i);
+            const VI64 v_prev1 = hn::LoadU(di64, feature_col_in + i - 1);
+            const VI64 v_prev2 = hn::LoadU(di64, feature_col_in + i - 2);
+            hn::StoreU(hn::Sub(hn::Sub(v_curr, v_prev1), hn::Sub(v_prev1, v_prev2)), di64, feature_col_out + i);
+        }
+#endif
+        for (; i < num_rows; ++i) {
+            feature_col_out[i] = second_difference(feature_col_in[i], feature_col_in[i - 1], feature_col_in[i - 2]);
+        }
+    }
+}
+
+// Two-level prefix sum: deltas are rebuilt from the second differences and the values from the deltas in the same pass.
+HWY_NOINLINE void DoubleCumulativeSumInt64_2D(const int64_t* HWY_RESTRICT delta, int64_t* HWY_RESTRICT out,
+                                              size_t num_rows, size_t num_features, std::span<int64_t> prev_row_state) {
+    if (num_rows == 0) return;
+
+    for (size_t f = 0; f < num_features; ++f) {
+        const int64_t* HWY_RESTRICT feature_delta = delta + f * num_rows;
+        int64_t* HWY_RESTRICT feature_out = out + f * num_rows;
+
+        uint64_t current_delta = 0;
+        uint64_t current_value = hwy::BitCastScalar<uint64_t>(prev_row_state[f]);
+        size_t i = 0;
+
+#if HWY_TARGET != HWY_SCALAR
+        const hn::FixedTag<uint64_t, 2> du64_128;
+        const hn::FixedTag<int64_t, 2> di64_128;
+
+        for (; i + 2 <= num_rows; i += 2) {
+            const auto v_dd = hn::BitCast(du64_128, hn::LoadU(di64_128, feature_delta + i));
+            const auto v_delta = hn::Add(hn::Add(v_dd, hn::SlideUpLanes(du64_128, v_dd, 1)), hn::Set(du64_128, current_delta));
+            const auto v_recon = hn::Add(hn::Add(v_delta, hn::SlideUpLanes(du64_128, v_delta, 1)), hn::Set(du64_128, current_value));
+            hn::StoreU(hn::BitCast(di64_128, v_recon), di64_128, feature_out + i);
+            current_delta = hn::ExtractLane(v_delta, 1);
+            current_value = hn::ExtractLane(v_recon, 1);
+        }
+#endif
+
+        for (; i < num_rows; ++i) {
+            current_delta += hwy::BitCastScalar<uint64_t>(feature_delta[i]);
+            current_value += current_delta;
+            feature_out[i] = hwy::BitCastScalar<int64_t>(current_value);
+        }
+
+        prev_row_state[f] = hwy::BitCastScalar<int64_t>(current_value);
+    }
+}
+
 } // namespace cryptodd::HWY_NAMESPACE
 HWY_AFTER_NAMESPACE();
 
@@ -429,6 +875,21 @@ namespace simd {
         HWY_DYNAMIC_DISPATCH(ShuffleFloat16_2D)(in, out, num_rows, num_features);
     }
 
+    HWY_EXPORT(DemoteXorShuffle16_2D);
+    HWY_NOINLINE void DemoteXorShuffle16_2D_dispatcher(const float* current, const float* prev, uint8_t* out, size_t num_rows, size_t num_features) {
+        HWY_DYNAMIC_DISPATCH(DemoteXorShuffle16_2D)(current, prev, out, num_rows, num_features);
+    }
+
+    HWY_EXPORT(DemoteXorShuffle16_2D_Strided);
+    HWY_NOINLINE void DemoteXorShuffle16_2D_Strided_dispatcher(const float* current, const float* prev, uint8_t* out, size_t num_rows, size_t num_features, size_t column_stride) {
+        HWY_DYNAMIC_DISPATCH(DemoteXorShuffle16_2D_Strided)(current, prev, out, num_rows, num_features, column_stride);
+    }
+
+    HWY_EXPORT(UnshuffleAndReconstruct16_2D_Strided);
+    HWY_NOINLINE void UnshuffleAndReconstruct16_2D_Strided_dispatcher(const uint8_t* shuffled_in, float* out, size_t num_rows, size_t num_features, size_t column_stride, std::span<float> prev_row_state) {
+        HWY_DYNAMIC_DISPATCH(UnshuffleAndReconstruct16_2D_Strided)(shuffled_in, out, num_rows, num_features, column_stride, prev_row_state);
+    }
+
     HWY_EXPORT(UnshuffleAndReconstruct16_2D);
     HWY_NOINLINE void UnshuffleAndReconstruct16_2D_dispatcher(const uint8_t* shuffled_in, float* out, size_t num_rows, size_t num_features, std::span<float> prev_row_state) {
         HWY_DYNAMIC_DISPATCH(UnshuffleAndReconstruct16_2D)(shuffled_in, out, num_rows, num_features, prev_row_state);
@@ -444,11 +905,36 @@ namespace simd {
         HWY_DYNAMIC_DISPATCH(ShuffleFloat32_2D)(in, out, num_rows, num_features);
     }
 
+    HWY_EXPORT(XorShuffleFloat32_2D);
+    HWY_NOINLINE void XorShuffleFloat32_2D_dispatcher(const float* current, const float* prev, uint8_t* out, size_t num_rows, size_t num_features) {
+        HWY_DYNAMIC_DISPATCH(XorShuffleFloat32_2D)(current, prev, out, num_rows, num_features);
+    }
+
+    HWY_EXPORT(XorShuffleFloat32_2D_Strided);
+    HWY_NOINLINE void XorShuffleFloat32_2D_Strided_dispatcher(const float* current, const float* prev, uint8_t* out, size_t num_rows, size_t num_features, size_t column_stride) {
+        HWY_DYNAMIC_DISPATCH(XorShuffleFloat32_2D_Strided)(current, prev, out, num_rows, num_features, column_stride);
+    }
+
+    HWY_EXPORT(UnshuffleAndReconstruct32_2D_Strided);
+    HWY_NOINLINE void UnshuffleAndReconstruct32_2D_Strided_dispatcher(const uint8_t* shuffled_in, float* out, size_t num_rows, size_t num_features, size_t column_stride, std::span<float> prev_row_state) {
+        HWY_DYNAMIC_DISPATCH(UnshuffleAndReconstruct32_2D_Strided)(shuffled_in, out, num_rows, num_features, column_stride, prev_row_state);
+    }
+
     HWY_EXPORT(UnshuffleAndReconstruct32_2D);
     HWY_NOINLINE void UnshuffleAndReconstruct32_2D_dispatcher(const uint8_t* shuffled_in, float* out, size_t num_rows, size_t num_features, std::span<float> prev_row_state) {
         HWY_DYNAMIC_DISPATCH(UnshuffleAndReconstruct32_2D)(shuffled_in, out, num_rows, num_features, prev_row_state);
     }
 
+    HWY_EXPORT(XorShuffleFloat64_2D_Strided);
+    HWY_NOINLINE void XorShuffleFloat64_2D_Strided_dispatcher(const double* current, const double* prev, uint8_t* out, size_t num_rows, size_t num_features, size_t column_stride) {
+        HWY_DYNAMIC_DISPATCH(XorShuffleFloat64_2D_Strided)(current, prev, out, num_rows, num_features, column_stride);
+    }
+
+    HWY_EXPORT(UnshuffleAndReconstruct64_2D_Strided);
+    HWY_NOINLINE void UnshuffleAndReconstruct64_2D_Strided_dispatcher(const uint8_t* shuffled_in, double* out, size_t num_rows, size_t num_features, size_t column_stride, std::span<double> prev_row_state) {
+        HWY_DYNAMIC_DISPATCH(UnshuffleAndReconstruct64_2D_Strided)(shuffled_in, out, num_rows, num_features, column_stride, prev_row_state);
+    }
+
     HWY_EXPORT(XorInt64_2D);
     HWY_NOINLINE void XorInt64_2D_dispatcher(const int64_t* current, const int64_t* prev, int64_t* out, size_t num_rows, size_t num_features) {
         HWY_DYNAMIC_DISPATCH(XorInt64_2D)(current, prev, out, num_rows, num_features);
@@ -458,6 +944,36 @@ namespace simd {
     HWY_NOINLINE void UnXorInt64_2D_dispatcher(const int64_t* delta, int64_t* out, size_t num_rows, size_t num_features, std::span<int64_t> prev_row_state) {
         HWY_DYNAMIC_DISPATCH(UnXorInt64_2D)(delta, out, num_rows, num_features, prev_row_state);
     }
+
+    HWY_EXPORT(DeltaInt64_2D);
+    HWY_NOINLINE void DeltaInt64_2D_dispatcher(const int64_t* current, const int64_t* prev, int64_t* out, size_t num_rows, size_t num_features) {
+        HWY_DYNAMIC_DISPATCH(DeltaInt64_2D)(current, prev, out, num_rows, num_features);
+    }
+
+    HWY_EXPORT(CumulativeSumInt64_2D);
+    HWY_NOINLINE void CumulativeSumInt64_2D_dispatcher(const int64_t* delta, int64_t* out, size_t num_rows, size_t num_features, std::span<int64_t> prev_row_state) {
+        HWY_DYNAMIC_DISPATCH(CumulativeSumInt64_2D)(delta, out, num_rows, num_features, prev_row_state);
+    }
+
+    HWY_EXPORT(DeltaShuffleInt64_2D_Strided);
+    HWY_NOINLINE void DeltaShuffleInt64_2D_Strided_dispatcher(const int64_t* current, const int64_t* prev, uint8_t* out, size_t num_rows, size_t num_features, size_t column_stride) {
+        HWY_DYNAMIC_DISPATCH(DeltaShuffleInt64_2D_Strided)(current, prev, out, num_rows, num_features, column_stride);
+    }
+
+    HWY_EXPORT(UnshuffleCumulativeSumInt64_2D_Strided);
+    HWY_NOINLINE void UnshuffleCumulativeSumInt64_2D_Strided_dispatcher(const uint8_t* shuffled_in, int64_t* out, size_t num_rows, size_t num_features, size_t column_stride, std::span<int64_t> prev_row_state) {
+        HWY_DYNAMIC_DISPATCH(UnshuffleCumulativeSumInt64_2D_Strided)(shuffled_in, out, num_rows, num_features, column_stride, prev_row_state);
+    }
+
+    HWY_EXPORT(DoubleDeltaInt64_2D);
+    HWY_NOINLINE void DoubleDeltaInt64_2D_dispatcher(const int64_t* current, const int64_t* prev, int64_t* out, size_t num_rows, size_t num_features) {
+        HWY_DYNAMIC_DISPATCH(DoubleDeltaInt64_2D)(current, prev, out, num_rows, num_features);
+    }
+
+    HWY_EXPORT(DoubleCumulativeSumInt64_2D);
+    HWY_NOINLINE void DoubleCumulativeSumInt64_2D_dispatcher(const int64_t* delta, int64_t* out, size_t num_rows, size_t num_features, std::span<int64_t> prev_row_state) {
+        HWY_DYNAMIC_DISPATCH(DoubleCumulativeSumInt64_2D)(delta, out, num_rows, num_features, prev_row_state);
+    }
 } // namespace simd
 
 } // namespace cryptodd
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <algorithm>
 #include <expected>
+#include "codec_constants.h"
 #include "i_compressor.h"
 #include <array>
 #include <cstdint>
@@ -14,6 +16,7 @@
 namespace cryptodd {
 
 using Float32AlignedVector = memory::AlignedVector<float, static_cast<std::size_t>(HWY_ALIGNMENT)>;
+using Float64AlignedVector = memory::AlignedVector<double, static_cast<std::size_t>(HWY_ALIGNMENT)>;
 using Int64AlignedVector = memory::AlignedVector<int64_t, static_cast<std::size_t>(HWY_ALIGNMENT)>;
 using ByteAlignedVector = memory::AlignedVector<std::byte, static_cast<std::size_t>(HWY_ALIGNMENT)>;
 using ByteAlignedAllocator = ByteAlignedVector::allocator_type;
@@ -21,31 +24,60 @@ using ByteAlignedAllocator = ByteAlignedVector::allocator_type;
 namespace simd {
     void DemoteAndXor2D_dispatcher(const float* current, const float* prev, hwy::float16_t* out, size_t num_rows, size_t num_features);
     void ShuffleFloat16_2D_dispatcher(const hwy::float16_t* in, uint8_t* out, size_t num_rows, size_t num_features);
+    void DemoteXorShuffle16_2D_dispatcher(const float* current, const float* prev, uint8_t* out, size_t num_rows, size_t num_features);
     void UnshuffleAndReconstruct16_2D_dispatcher(const uint8_t* shuffled_in, float* out, size_t num_rows, size_t num_features, std::span<float> prev_row_state);
+    // Strided variants: column f lives at base + f * column_stride, byte planes stay dense (num_rows per column).
+    void DemoteXorShuffle16_2D_Strided_dispatcher(const float* current, const float* prev, uint8_t* out, size_t num_rows, size_t num_features, size_t column_stride);
+    void UnshuffleAndReconstruct16_2D_Strided_dispatcher(const uint8_t* shuffled_in, float* out, size_t num_rows, size_t num_features, size_t column_stride, std::span<float> prev_row_state);
 
     void XorFloat32_2D_dispatcher(const float* current, const float* prev, float* out, size_t num_rows, size_t num_features);
     void ShuffleFloat32_2D_dispatcher(const float* in, uint8_t* out, size_t num_rows, size_t num_features);
+    void XorShuffleFloat32_2D_dispatcher(const float* current, const float* prev, uint8_t* out, size_t num_rows, size_t num_features);
     void UnshuffleAndReconstruct32_2D_dispatcher(const uint8_t* shuffled_in, float* out, size_t num_rows, size_t num_features, std::span<float> prev_row_state);
+    void XorShuffleFloat32_2D_Strided_dispatcher(const float* current, const float* prev, uint8_t* out, size_t num_rows, size_t num_features, size_t column_stride);
+    void UnshuffleAndReconstruct32_2D_Strided_dispatcher(const uint8_t* shuffled_in, float* out, size_t num_rows, size_t num_features, size_t column_stride, std::span<float> prev_row_state);
+
+    // Float64 XOR + 8-byte shuffle, with the same column_stride contract as the float32 variants.
+    void XorShuffleFloat64_2D_Strided_dispatcher(const double* current, const double* prev, uint8_t* out, size_t num_rows, size_t num_features, size_t column_stride);
+    void UnshuffleAndReconstruct64_2D_Strided_dispatcher(const uint8_t* shuffled_in, double* out, size_t num_rows, size_t num_features, size_t column_stride, std::span<double> prev_row_state);
 
     void XorInt64_2D_dispatcher(const int64_t* current, const int64_t* prev, int64_t* out, size_t num_rows, size_t num_features);
     void UnXorInt64_2D_dispatcher(const int64_t* delta, int64_t* out, size_t num_rows, size_t num_features, std::span<int64_t> prev_row_state);
+
+    // Per-column wrapping differences against the previous row, and the column-wise prefix sum that undoes them.
+    void DeltaInt64_2D_dispatcher(const int64_t* current, const int64_t* prev, int64_t* out, size_t num_rows, size_t num_features);
+    void CumulativeSumInt64_2D_dispatcher(const int64_t* delta, int64_t* out, size_t num_rows, size_t num_features, std::span<int64_t> prev_row_state);
+    // Same, with the residuals split into 8 byte planes (plane b holds byte b of every residual, in SoA order).
+    void DeltaShuffleInt64_2D_Strided_dispatcher(const int64_t* current, const int64_t* prev, uint8_t* out, size_t num_rows, size_t num_features, size_t column_stride);
+    void UnshuffleCumulativeSumInt64_2D_Strided_dispatcher(const uint8_t* shuffled_in, int64_t* out, size_t num_rows, size_t num_features, size_t column_stride, std::span<int64_t> prev_row_state);
+
+    // Per-column second differences; the delta before each column's first row is taken as zero.
+    void DoubleDeltaInt64_2D_dispatcher(const int64_t* current, const int64_t* prev, int64_t* out, size_t num_rows, size_t num_features);
+    void DoubleCumulativeSumInt64_2D_dispatcher(const int64_t* delta, int64_t* out, size_t num_rows, size_t num_features, std::span<int64_t> prev_row_state);
 }
 
 class Temporal2dSimdCodecWorkspace;
 
 namespace detail {
+    using Int64Encode2dFn = void (*)(const int64_t*, const int64_t*, int64_t*, size_t, size_t);
+    using Int64Decode2dFn = void (*)(const int64_t*, int64_t*, size_t, size_t, std::span<int64_t>);
+
     // Implementation helpers to be shared between static and dynamic codecs.
     inline std::expected<memory::vector<std::byte>, std::string> encode16_2d_impl(std::span<const float> soa_data, std::span<const float> prev_row,
                                                 size_t num_rows, size_t num_features, ICompressor& compressor,
-                                                Temporal2dSimdCodecWorkspace& workspace);
+                                                Temporal2dSimdCodecWorkspace& workspace, codecs::ShuffleLayout layout);
 
     inline std::expected<memory::vector<std::byte>, std::string> encode32_2d_impl(std::span<const float> soa_data, std::span<const float> prev_row,
                                                 size_t num_rows, size_t num_features, ICompressor& compressor,
-                                                Temporal2dSimdCodecWorkspace& workspace);
+                                                Temporal2dSimdCodecWorkspace& workspace, codecs::ShuffleLayout layout);
+
+    inline std::expected<memory::vector<std::byte>, std::string> encode64f_2d_impl(std::span<const double> soa_data, std::span<const double> prev_row,
+                                                size_t num_rows, size_t num_features, ICompressor& compressor,
+                                                Temporal2dSimdCodecWorkspace& workspace, codecs::ShuffleLayout layout);
 
     inline std::expected<memory::vector<std::byte>, std::string> encode64_2d_impl(std::span<const int64_t> soa_data, std::span<const int64_t> prev_row,
                                                 size_t num_rows, size_t num_features, ICompressor& compressor,
-                                                Temporal2dSimdCodecWorkspace& workspace);
+                                                Temporal2dSimdCodecWorkspace& workspace, Int64Encode2dFn encode);
 }
 
 class Temporal2dSimdCodecWorkspace {
@@ -75,9 +107,10 @@ public:
     [[nodiscard]] hwy::AlignedFreeUniquePtr<uint8_t[]>& buffer2() { return buffer2_; }
 
 private:
-    friend std::expected<memory::vector<std::byte>, std::string> detail::encode16_2d_impl(std::span<const float>, std::span<const float>, size_t, size_t, ICompressor&, Temporal2dSimdCodecWorkspace&);
-    friend std::expected<memory::vector<std::byte>, std::string> detail::encode32_2d_impl(std::span<const float>, std::span<const float>, size_t, size_t, ICompressor&, Temporal2dSimdCodecWorkspace&);
-    friend std::expected<memory::vector<std::byte>, std::string> detail::encode64_2d_impl(std::span<const int64_t>, std::span<const int64_t>, size_t, size_t, ICompressor&, Temporal2dSimdCodecWorkspace&);
+    friend std::expected<memory::vector<std::byte>, std::string> detail::encode16_2d_impl(std::span<const float>, std::span<const float>, size_t, size_t, ICompressor&, Temporal2dSimdCodecWorkspace&, codecs::ShuffleLayout);
+    friend std::expected<memory::vector<std::byte>, std::string> detail::encode32_2d_impl(std::span<const float>, std::span<const float>, size_t, size_t, ICompressor&, Temporal2dSimdCodecWorkspace&, codecs::ShuffleLayout);
+    friend std::expected<memory::vector<std::byte>, std::string> detail::encode64f_2d_impl(std::span<const double>, std::span<const double>, size_t, size_t, ICompressor&, Temporal2dSimdCodecWorkspace&, codecs::ShuffleLayout);
+    friend std::expected<memory::vector<std::byte>, std::string> detail::encode64_2d_impl(std::span<const int64_t>, std::span<const int64_t>, size_t, size_t, ICompressor&, Temporal2dSimdCodecWorkspace&, detail::Int64Encode2dFn);
 
     hwy::AlignedFreeUniquePtr<uint8_t[]> buffer1_;
     hwy::AlignedFreeUniquePtr<uint8_t[]> buffer2_;
@@ -86,16 +119,40 @@ private:
 
 namespace detail {
 
+template <typename T> using Encode2dFn = void (*)(const T*, const T*, uint8_t*, size_t, size_t, size_t);
+template <typename T> using Decode2dFn = void (*)(const uint8_t*, T*, size_t, size_t, size_t, std::span<T>);
+
+// Global: one set of byte planes over the whole chunk. Blocked: each run of rows_per_block rows gets its own
+// dense planes, read straight out of the SoA buffer with column_stride = num_rows. A block's first row is
+// coded against the last row of the previous block, so the deltas are identical in both layouts.
+template <typename T>
+void encode_2d_planes(const Encode2dFn<T> encode, const T* soa_data, const T* prev_row, uint8_t* out,
+                             const size_t num_rows, const size_t num_features, const size_t elem_size,
+                             const codecs::ShuffleLayout layout) {
+    if (layout == codecs::ShuffleLayout::Global) {
+        encode(soa_data, prev_row, out, num_rows, num_features, num_rows);
+        return;
+    }
+    const size_t rows_per_block = codecs::ShuffleBlock::rows_per_block(num_features * elem_size);
+    memory::vector<T> block_prev_row(prev_row, prev_row + num_features);
+    for (size_t row = 0; row < num_rows; row += rows_per_block) {
+        const size_t rows = std::min(rows_per_block, num_rows - row);
+        if (row > 0) {
+            for (size_t f = 0; f < num_features; ++f) {
+                block_prev_row[f] = soa_data[f * num_rows + row - 1];
+            }
+        }
+        encode(soa_data + row, block_prev_row.data(), out + row * num_features * elem_size, rows, num_features, num_rows);
+    }
+}
+
 inline std::expected<memory::vector<std::byte>, std::string> encode16_2d_impl(std::span<const float> soa_data, std::span<const float> prev_row,
                                             size_t num_rows, size_t num_features, ICompressor& compressor,
-                                            Temporal2dSimdCodecWorkspace& workspace) {
+                                            Temporal2dSimdCodecWorkspace& workspace, const codecs::ShuffleLayout layout) {
     const size_t total_elements = soa_data.size();
-    auto* f16_deltas_ptr = reinterpret_cast<hwy::float16_t*>(workspace.buffer1().get());
-    
-    simd::DemoteAndXor2D_dispatcher(soa_data.data(), prev_row.data(), f16_deltas_ptr, num_rows, num_features);
-
-    auto* shuffled_bytes_ptr = workspace.buffer2().get();
-    simd::ShuffleFloat16_2D_dispatcher(f16_deltas_ptr, shuffled_bytes_ptr, num_rows, num_features);
+    auto* shuffled_bytes_ptr = workspace.buffer1().get();
+    encode_2d_planes(&simd::DemoteXorShuffle16_2D_Strided_dispatcher, soa_data.data(), prev_row.data(), shuffled_bytes_ptr,
+                     num_rows, num_features, sizeof(hwy::float16_t), layout);
 
     const size_t bytes_to_compress = total_elements * sizeof(hwy::float16_t);
     static_assert(sizeof(std::byte) == sizeof(uint8_t));
@@ -104,27 +161,81 @@ inline std::expected<memory::vector<std::byte>, std::string> encode16_2d_impl(st
 
 inline std::expected<memory::vector<std::byte>, std::string> encode32_2d_impl(std::span<const float> soa_data, std::span<const float> prev_row,
                                             size_t num_rows, size_t num_features, ICompressor& compressor,
-                                            Temporal2dSimdCodecWorkspace& workspace) {
+                                            Temporal2dSimdCodecWorkspace& workspace, const codecs::ShuffleLayout layout) {
     const size_t total_elements = soa_data.size();
-    auto* f32_deltas_ptr = reinterpret_cast<float*>(workspace.buffer1().get());
+    auto* shuffled_bytes_ptr = workspace.buffer1().get();
+    encode_2d_planes(&simd::XorShuffleFloat32_2D_Strided_dispatcher, soa_data.data(), prev_row.data(), shuffled_bytes_ptr,
+                     num_rows, num_features, sizeof(float), layout);
 
-    simd::XorFloat32_2D_dispatcher(soa_data.data(), prev_row.data(), f32_deltas_ptr, num_rows, num_features);
+    const size_t bytes_to_compress = total_elements * sizeof(float);
+    static_assert(sizeof(std::byte) == sizeof(uint8_t));
+    return compressor.compress({reinterpret_cast<const std::byte*>(shuffled_bytes_ptr), bytes_to_compress});
+}
 
-    auto* shuffled_bytes_ptr = workspace.buffer2().get();
-    simd::ShuffleFloat32_2D_dispatcher(f32_deltas_ptr, shuffled_bytes_ptr, num_rows, num_features);
+inline std::expected<memory::vector<std::byte>, std::string> encode64f_2d_impl(std::span<const double> soa_data, std::span<const double> prev_row,
+                                            size_t num_rows, size_t num_features, ICompressor& compressor,
+                                            Temporal2dSimdCodecWorkspace& workspace, const codecs::ShuffleLayout layout) {
+    const size_t total_elements = soa_data.size();
+    auto* shuffled_bytes_ptr = workspace.buffer1().get();
+    encode_2d_planes(&simd::XorShuffleFloat64_2D_Strided_dispatcher, soa_data.data(), prev_row.data(), shuffled_bytes_ptr,
+                     num_rows, num_features, sizeof(double), layout);
 
-    const size_t bytes_to_compress = total_elements * sizeof(float);
+    const size_t bytes_to_compress = total_elements * sizeof(double);
     static_assert(sizeof(std::byte) == sizeof(uint8_t));
     return compressor.compress({reinterpret_cast<const std::byte*>(shuffled_bytes_ptr), bytes_to_compress});
 }
 
+// Blocked chunks are streamed through the compressor one row block at a time and unshuffled into their
+// column slices while still cache-resident; prev_row carries the reconstruction state across blocks.
+template <typename T>
+std::expected<memory::AlignedVector<T, static_cast<std::size_t>(HWY_ALIGNMENT)>, std::string> decode_2d_impl(std::span<const std::byte> compressed, size_t num_rows, size_t num_features,
+                                            size_t elem_size, std::span<T> prev_row, ICompressor& compressor,
+                                            const Decode2dFn<T> decode, const codecs::ShuffleLayout layout) {
+    using OutVector = memory::AlignedVector<T, static_cast<std::size_t>(HWY_ALIGNMENT)>;
+    const size_t total_elements = num_rows * num_features;
+    static_assert(sizeof(std::byte) == sizeof(uint8_t));
+
+    if (layout == codecs::ShuffleLayout::Global) {
+        auto shuffled_bytes_result = compressor.decompress_to<ByteAlignedAllocator>(compressed);
+        if (!shuffled_bytes_result) return std::unexpected(shuffled_bytes_result.error());
+        if (shuffled_bytes_result->size() != total_elements * elem_size) return std::unexpected("Decompressed data size mismatch");
+        OutVector out_data(total_elements);
+        decode(reinterpret_cast<const uint8_t*>(shuffled_bytes_result->data()), out_data.data(), num_rows, num_features, num_rows, prev_row);
+        return out_data;
+    }
+
+    const size_t row_bytes = num_features * elem_size;
+    OutVector out_data(total_elements);
+    size_t row = 0;
+    auto decompressed = compressor.decompress_blocks(compressed, codecs::ShuffleBlock::rows_per_block(row_bytes) * row_bytes,
+        [&](std::span<const std::byte> block) -> std::expected<void, std::string> {
+            const size_t rows = block.size() / row_bytes;
+            if (rows * row_bytes != block.size() || row + rows > num_rows) return std::unexpected("Decompressed data size mismatch");
+            decode(reinterpret_cast<const uint8_t*>(block.data()), out_data.data() + row, rows, num_features, num_rows, prev_row);
+            row += rows;
+            return {};
+        });
+    if (!decompressed) return std::unexpected(decompressed.error());
+    if (row != num_rows) return std::unexpected("Decompressed data size mismatch");
+    return out_data;
+}
+
+// Row count of a dynamic-width chunk, derived from the decompressed size recorded in the frame header.
+inline std::expected<size_t, std::string> decoded_2d_rows(std::span<const std::byte> compressed, size_t num_features, size_t elem_size, ICompressor& compressor) {
+    auto decompressed_size = compressor.get_decompress_size(compressed);
+    if (!decompressed_size) return std::unexpected(decompressed_size.error());
+    const size_t row_bytes = num_features * elem_size;
+    if (*decompressed_size == 0 || *decompressed_size % row_bytes != 0) return std::unexpected("Decompressed data size mismatch");
+    return *decompressed_size / row_bytes;
+}
+
 inline std::expected<memory::vector<std::byte>, std::string> encode64_2d_impl(std::span<const int64_t> soa_data, std::span<const int64_t> prev_row,
                                             size_t num_rows, size_t num_features, ICompressor& compressor,
-                                            Temporal2dSimdCodecWorkspace& workspace) {
+                                            Temporal2dSimdCodecWorkspace& workspace, const Int64Encode2dFn encode) {
     const size_t total_elements = soa_data.size();
     auto* i64_deltas_ptr = reinterpret_cast<int64_t*>(workspace.buffer1().get());
 
-    simd::XorInt64_2D_dispatcher(soa_data.data(), prev_row.data(), i64_deltas_ptr, num_rows, num_features);
+    encode(soa_data.data(), prev_row.data(), i64_deltas_ptr, num_rows, num_features);
 
     const size_t bytes_to_compress = total_elements * sizeof(int64_t);
     static_assert(sizeof(std::byte) == sizeof(uint8_t));
@@ -141,16 +252,31 @@ public:
         if (!compressor_) throw std::invalid_argument("Compressor cannot be null.");
     }
 
-    std::expected<memory::vector<std::byte>, std::string> encode16(std::span<const float> soa_data, std::span<const float> prev_row, Temporal2dSimdCodecWorkspace& workspace) const;
-    std::expected<Float32AlignedVector, std::string> decode16(std::span<const std::byte> compressed, std::span<float> prev_row) const;
+    std::expected<memory::vector<std::byte>, std::string> encode16(std::span<const float> soa_data, std::span<const float> prev_row, Temporal2dSimdCodecWorkspace& workspace, codecs::ShuffleLayout layout = codecs::ShuffleLayout::Global) const;
+    std::expected<Float32AlignedVector, std::string> decode16(std::span<const std::byte> compressed, std::span<float> prev_row, codecs::ShuffleLayout layout = codecs::ShuffleLayout::Global) const;
 
-    std::expected<memory::vector<std::byte>, std::string> encode32(std::span<const float> soa_data, std::span<const float> prev_row, Temporal2dSimdCodecWorkspace& workspace) const;
-    std::expected<Float32AlignedVector, std::string> decode32(std::span<const std::byte> compressed, std::span<float> prev_row) const;
+    std::expected<memory::vector<std::byte>, std::string> encode32(std::span<const float> soa_data, std::span<const float> prev_row, Temporal2dSimdCodecWorkspace& workspace, codecs::ShuffleLayout layout = codecs::ShuffleLayout::Global) const;
+    std::expected<Float32AlignedVector, std::string> decode32(std::span<const std::byte> compressed, std::span<float> prev_row, codecs::ShuffleLayout layout = codecs::ShuffleLayout::Global) const;
+
+    // Chain: float64 -> XOR -> 8-byte shuffle
+    std::expected<memory::vector<std::byte>, std::string> encode64_Xor_Shuffle(std::span<const double> soa_data, std::span<const double> prev_row, Temporal2dSimdCodecWorkspace& workspace, codecs::ShuffleLayout layout = codecs::ShuffleLayout::Global) const;
+    std::expected<Float64AlignedVector, std::string> decode64_Xor_Shuffle(std::span<const std::byte> compressed, std::span<double> prev_row, codecs::ShuffleLayout layout = codecs::ShuffleLayout::Global) const;
 
     std::expected<memory::vector<std::byte>, std::string> encode64(std::span<const int64_t> soa_data, std::span<const int64_t> prev_row, Temporal2dSimdCodecWorkspace& workspace) const;
     std::expected<Int64AlignedVector, std::string> decode64(std::span<const std::byte> compressed, std::span<int64_t> prev_row) const;
 
+    // Chain: int64 -> per-column delta [-> 8-byte shuffle], for monotonic columns such as cumulative volume or trade IDs
+    std::expected<memory::vector<std::byte>, std::string> encode64_Delta(std::span<const int64_t> soa_data, std::span<const int64_t> prev_row, Temporal2dSimdCodecWorkspace& workspace, bool shuffle = false, codecs::ShuffleLayout layout = codecs::ShuffleLayout::Global) const;
+    std::expected<Int64AlignedVector, std::string> decode64_Delta(std::span<const std::byte> compressed, std::span<int64_t> prev_row, bool shuffled = false, codecs::ShuffleLayout layout = codecs::ShuffleLayout::Global) const;
+
+    // Chain: int64 -> per-column delta-of-delta, for near-constant-interval columns such as timestamps
+    std::expected<memory::vector<std::byte>, std::string> encode64_DoubleDelta(std::span<const int64_t> soa_data, std::span<const int64_t> prev_row, Temporal2dSimdCodecWorkspace& workspace) const;
+    std::expected<Int64AlignedVector, std::string> decode64_DoubleDelta(std::span<const std::byte> compressed, std::span<int64_t> prev_row) const;
+
 private:
+    std::expected<memory::vector<std::byte>, std::string> encode64_impl(std::span<const int64_t> soa_data, std::span<const int64_t> prev_row, Temporal2dSimdCodecWorkspace& workspace, detail::Int64Encode2dFn encode) const;
+    std::expected<Int64AlignedVector, std::string> decode64_impl(std::span<const std::byte> compressed, std::span<int64_t> prev_row, detail::Int64Decode2dFn decode) const;
+
     size_t num_features_;
     std::unique_ptr<ICompressor> compressor_;
 };
@@ -170,12 +296,14 @@ public:
     }
 
     std::expected<memory::vector<std::byte>, std::string> encode16(std::span<const float> soa_data, const PrevRowFloat& prev_row,
-                                  Temporal2dSimdCodecWorkspace& workspace) const;
-    std::expected<Float32AlignedVector, std::string> decode16(std::span<const std::byte> compressed, size_t num_rows, PrevRowFloat& prev_row) const;
+                                  Temporal2dSimdCodecWorkspace& workspace, codecs::ShuffleLayout layout = codecs::ShuffleLayout::Global) const;
+    std::expected<Float32AlignedVector, std::string> decode16(std::span<const std::byte> compressed, size_t num_rows, PrevRowFloat& prev_row,
+                                  codecs::ShuffleLayout layout = codecs::ShuffleLayout::Global) const;
 
     std::expected<memory::vector<std::byte>, std::string> encode32(std::span<const float> soa_data, const PrevRowFloat& prev_row,
-                                  Temporal2dSimdCodecWorkspace& workspace) const;
-    std::expected<Float32AlignedVector, std::string> decode32(std::span<const std::byte> compressed, size_t num_rows, PrevRowFloat& prev_row) const;
+                                  Temporal2dSimdCodecWorkspace& workspace, codecs::ShuffleLayout layout = codecs::ShuffleLayout::Global) const;
+    std::expected<Float32AlignedVector, std::string> decode32(std::span<const std::byte> compressed, size_t num_rows, PrevRowFloat& prev_row,
+                                  codecs::ShuffleLayout layout = codecs::ShuffleLayout::Global) const;
 
     std::expected<memory::vector<std::byte>, std::string> encode64(std::span<const int64_t> soa_data, const PrevRowInt64& prev_row,
                                   Temporal2dSimdCodecWorkspace& workspace) const;
@@ -187,57 +315,100 @@ private:
 
 // --- Implementation for DynamicTemporal2dSimdCodec ---
 
-inline std::expected<memory::vector<std::byte>, std::string> DynamicTemporal2dSimdCodec::encode16(std::span<const float> soa_data, std::span<const float> prev_row, Temporal2dSimdCodecWorkspace& workspace) const {
+inline std::expected<memory::vector<std::byte>, std::string> DynamicTemporal2dSimdCodec::encode16(std::span<const float> soa_data, std::span<const float> prev_row, Temporal2dSimdCodecWorkspace& workspace, const codecs::ShuffleLayout layout) const {
     if (prev_row.size() != num_features_) throw std::runtime_error("Invalid prev_row size");
     if (soa_data.empty() || soa_data.size() % num_features_ != 0) throw std::runtime_error("Invalid soa_data size");
     const size_t num_rows = soa_data.size() / num_features_;
     workspace.ensure_capacity(soa_data.size());
-    return detail::encode16_2d_impl(soa_data, prev_row, num_rows, num_features_, *compressor_, workspace);
+    return detail::encode16_2d_impl(soa_data, prev_row, num_rows, num_features_, *compressor_, workspace, layout);
 }
 
-inline std::expected<Float32AlignedVector, std::string> DynamicTemporal2dSimdCodec::decode16(std::span<const std::byte> compressed, std::span<float> prev_row) const {
+inline std::expected<Float32AlignedVector, std::string> DynamicTemporal2dSimdCodec::decode16(std::span<const std::byte> compressed, std::span<float> prev_row, const codecs::ShuffleLayout layout) const {
     if (prev_row.size() != num_features_) return std::unexpected("Invalid prev_row size");
-    auto shuffled_bytes_result = compressor_->decompress_to<ByteAlignedAllocator>(compressed);
-    if (!shuffled_bytes_result) return std::unexpected(shuffled_bytes_result.error());
-    if (shuffled_bytes_result->empty() || (shuffled_bytes_result->size() / sizeof(hwy::float16_t)) % num_features_ != 0) return std::unexpected("Decompressed data size mismatch");
-    const size_t total_elements = shuffled_bytes_result->size() / sizeof(hwy::float16_t);
-    const size_t num_rows = total_elements / num_features_;
-    Float32AlignedVector out_data(total_elements);
-    static_assert(sizeof(std::byte) == sizeof(uint8_t));
-    simd::UnshuffleAndReconstruct16_2D_dispatcher(reinterpret_cast<const uint8_t*>(shuffled_bytes_result->data()), out_data.data(), num_rows, num_features_, prev_row);
-    return out_data;
+    auto num_rows = detail::decoded_2d_rows(compressed, num_features_, sizeof(hwy::float16_t), *compressor_);
+    if (!num_rows) return std::unexpected(num_rows.error());
+    return detail::decode_2d_impl(compressed, *num_rows, num_features_, sizeof(hwy::float16_t), prev_row, *compressor_,
+                                  &simd::UnshuffleAndReconstruct16_2D_Strided_dispatcher, layout);
 }
 
-inline std::expected<memory::vector<std::byte>, std::string> DynamicTemporal2dSimdCodec::encode32(std::span<const float> soa_data, std::span<const float> prev_row, Temporal2dSimdCodecWorkspace& workspace) const {
+inline std::expected<memory::vector<std::byte>, std::string> DynamicTemporal2dSimdCodec::encode32(std::span<const float> soa_data, std::span<const float> prev_row, Temporal2dSimdCodecWorkspace& workspace, const codecs::ShuffleLayout layout) const {
     if (prev_row.size() != num_features_) throw std::runtime_error("Invalid prev_row size");
     if (soa_data.empty() || soa_data.size() % num_features_ != 0) throw std::runtime_error("Invalid soa_data size");
     const size_t num_rows = soa_data.size() / num_features_;
     workspace.ensure_capacity(soa_data.size());
-    return detail::encode32_2d_impl(soa_data, prev_row, num_rows, num_features_, *compressor_, workspace);
+    return detail::encode32_2d_impl(soa_data, prev_row, num_rows, num_features_, *compressor_, workspace, layout);
 }
 
-inline std::expected<Float32AlignedVector, std::string> DynamicTemporal2dSimdCodec::decode32(std::span<const std::byte> compressed, std::span<float> prev_row) const {
+inline std::expected<Float32AlignedVector, std::string> DynamicTemporal2dSimdCodec::decode32(std::span<const std::byte> compressed, std::span<float> prev_row, const codecs::ShuffleLayout layout) const {
     if (prev_row.size() != num_features_) return std::unexpected("Invalid prev_row size");
-    auto shuffled_bytes_result = compressor_->decompress_to<ByteAlignedAllocator>(compressed);
-    if (!shuffled_bytes_result) return std::unexpected(shuffled_bytes_result.error());
-    if (shuffled_bytes_result->empty() || (shuffled_bytes_result->size() / sizeof(float)) % num_features_ != 0) return std::unexpected("Decompressed data size mismatch");
-    const size_t total_elements = shuffled_bytes_result->size() / sizeof(float);
-    const size_t num_rows = total_elements / num_features_;
-    Float32AlignedVector out_data(total_elements);
-    static_assert(sizeof(std::byte) == sizeof(uint8_t));
-    simd::UnshuffleAndReconstruct32_2D_dispatcher(reinterpret_cast<const uint8_t*>(shuffled_bytes_result->data()), out_data.data(), num_rows, num_features_, prev_row);
-    return out_data;
+    auto num_rows = detail::decoded_2d_rows(compressed, num_features_, sizeof(float), *compressor_);
+    if (!num_rows) return std::unexpected(num_rows.error());
+    return detail::decode_2d_impl(compressed, *num_rows, num_features_, sizeof(float), prev_row, *compressor_,
+                                  &simd::UnshuffleAndReconstruct32_2D_Strided_dispatcher, layout);
 }
 
-inline std::expected<memory::vector<std::byte>, std::string> DynamicTemporal2dSimdCodec::encode64(std::span<const int64_t> soa_data, std::span<const int64_t> prev_row, Temporal2dSimdCodecWorkspace& workspace) const {
+inline std::expected<memory::vector<std::byte>, std::string> DynamicTemporal2dSimdCodec::encode64_Xor_Shuffle(std::span<const double> soa_data, std::span<const double> prev_row, Temporal2dSimdCodecWorkspace& workspace, const codecs::ShuffleLayout layout) const {
     if (prev_row.size() != num_features_) throw std::runtime_error("Invalid prev_row size");
     if (soa_data.empty() || soa_data.size() % num_features_ != 0) throw std::runtime_error("Invalid soa_data size");
     const size_t num_rows = soa_data.size() / num_features_;
     workspace.ensure_capacity(soa_data.size());
-    return detail::encode64_2d_impl(soa_data, prev_row, num_rows, num_features_, *compressor_, workspace);
+    return detail::encode64f_2d_impl(soa_data, prev_row, num_rows, num_features_, *compressor_, workspace, layout);
+}
+
+inline std::expected<Float64AlignedVector, std::string> DynamicTemporal2dSimdCodec::decode64_Xor_Shuffle(std::span<const std::byte> compressed, std::span<double> prev_row, const codecs::ShuffleLayout layout) const {
+    if (prev_row.size() != num_features_) return std::unexpected("Invalid prev_row size");
+    auto num_rows = detail::decoded_2d_rows(compressed, num_features_, sizeof(double), *compressor_);
+    if (!num_rows) return std::unexpected(num_rows.error());
+    return detail::decode_2d_impl(compressed, *num_rows, num_features_, sizeof(double), prev_row, *compressor_,
+                                  &simd::UnshuffleAndReconstruct64_2D_Strided_dispatcher, layout);
+}
+
+inline std::expected<memory::vector<std::byte>, std::string> DynamicTemporal2dSimdCodec::encode64(std::span<const int64_t> soa_data, std::span<const int64_t> prev_row, Temporal2dSimdCodecWorkspace& workspace) const {
+    return encode64_impl(soa_data, prev_row, workspace, &simd::XorInt64_2D_dispatcher);
 }
 
 inline std::expected<Int64AlignedVector, std::string> DynamicTemporal2dSimdCodec::decode64(std::span<const std::byte> compressed, std::span<int64_t> prev_row) const {
+    return decode64_impl(compressed, prev_row, &simd::UnXorInt64_2D_dispatcher);
+}
+
+inline std::expected<memory::vector<std::byte>, std::string> DynamicTemporal2dSimdCodec::encode64_Delta(std::span<const int64_t> soa_data, std::span<const int64_t> prev_row, Temporal2dSimdCodecWorkspace& workspace, const bool shuffle, const codecs::ShuffleLayout layout) const {
+    if (!shuffle) return encode64_impl(soa_data, prev_row, workspace, &simd::DeltaInt64_2D_dispatcher);
+    if (prev_row.size() != num_features_) throw std::runtime_error("Invalid prev_row size");
+    if (soa_data.empty() || soa_data.size() % num_features_ != 0) throw std::runtime_error("Invalid soa_data size");
+    const size_t num_rows = soa_data.size() / num_features_;
+    workspace.ensure_capacity(soa_data.size());
+    auto* shuffled_bytes_ptr = workspace.buffer1().get();
+    detail::encode_2d_planes(&simd::DeltaShuffleInt64_2D_Strided_dispatcher, soa_data.data(), prev_row.data(), shuffled_bytes_ptr,
+                             num_rows, num_features_, sizeof(int64_t), layout);
+    return compressor_->compress({reinterpret_cast<const std::byte*>(shuffled_bytes_ptr), soa_data.size() * sizeof(int64_t)});
+}
+
+inline std::expected<Int64AlignedVector, std::string> DynamicTemporal2dSimdCodec::decode64_Delta(std::span<const std::byte> compressed, std::span<int64_t> prev_row, const bool shuffled, const codecs::ShuffleLayout layout) const {
+    if (!shuffled) return decode64_impl(compressed, prev_row, &simd::CumulativeSumInt64_2D_dispatcher);
+    if (prev_row.size() != num_features_) return std::unexpected("Invalid prev_row size");
+    auto num_rows = detail::decoded_2d_rows(compressed, num_features_, sizeof(int64_t), *compressor_);
+    if (!num_rows) return std::unexpected(num_rows.error());
+    return detail::decode_2d_impl(compressed, *num_rows, num_features_, sizeof(int64_t), prev_row, *compressor_,
+                                  &simd::UnshuffleCumulativeSumInt64_2D_Strided_dispatcher, layout);
+}
+
+inline std::expected<memory::vector<std::byte>, std::string> DynamicTemporal2dSimdCodec::encode64_DoubleDelta(std::span<const int64_t> soa_data, std::span<const int64_t> prev_row, Temporal2dSimdCodecWorkspace& workspace) const {
+    return encode64_impl(soa_data, prev_row, workspace, &simd::DoubleDeltaInt64_2D_dispatcher);
+}
+
+inline std::expected<Int64AlignedVector, std::string> DynamicTemporal2dSimdCodec::decode64_DoubleDelta(std::span<const std::byte> compressed, std::span<int64_t> prev_row) const {
+    return decode64_impl(compressed, prev_row, &simd::DoubleCumulativeSumInt64_2D_dispatcher);
+}
+
+inline std::expected<memory::vector<std::byte>, std::string> DynamicTemporal2dSimdCodec::encode64_impl(std::span<const int64_t> soa_data, std::span<const int64_t> prev_row, Temporal2dSimdCodecWorkspace& workspace, const detail::Int64Encode2dFn encode) const {
+    if (prev_row.size() != num_features_) throw std::runtime_error("Invalid prev_row size");
+    if (soa_data.empty() || soa_data.size() % num_features_ != 0) throw std::runtime_error("Invalid soa_data size");
+    const size_t num_rows = soa_data.size() / num_features_;
+    workspace.ensure_capacity(soa_data.size());
+    return detail::encode64_2d_impl(soa_data, prev_row, num_rows, num_features_, *compressor_, workspace, encode);
+}
+
+inline std::expected<Int64AlignedVector, std::string> DynamicTemporal2dSimdCodec::decode64_impl(std::span<const std::byte> compressed, std::span<int64_t> prev_row, const detail::Int64Decode2dFn decode) const {
     if (prev_row.size() != num_features_) return std::unexpected("Invalid prev_row size");
     auto delta_bytes_result = compressor_->decompress(compressed);
     if (!delta_bytes_result) return std::unexpected(delta_bytes_result.error());
@@ -245,50 +416,38 @@ inline std::expected<Int64AlignedVector, std::string> DynamicTemporal2dSimdCodec
     const size_t total_elements = delta_bytes_result->size() / sizeof(int64_t);
     const size_t num_rows = total_elements / num_features_;
     Int64AlignedVector out_data(total_elements);
-    simd::UnXorInt64_2D_dispatcher(reinterpret_cast<const int64_t*>(delta_bytes_result->data()), out_data.data(), num_rows, num_features_, prev_row);
+    decode(reinterpret_cast<const int64_t*>(delta_bytes_result->data()), out_data.data(), num_rows, num_features_, prev_row);
     return out_data;
 }
 
 // --- Implementation for Temporal2dSimdCodec (static) ---
 
 template <size_t NF>
-std::expected<memory::vector<std::byte>, std::string> Temporal2dSimdCodec<NF>::encode16(std::span<const float> soa_data, const PrevRowFloat& prev_row, Temporal2dSimdCodecWorkspace& workspace) const {
+std::expected<memory::vector<std::byte>, std::string> Temporal2dSimdCodec<NF>::encode16(std::span<const float> soa_data, const PrevRowFloat& prev_row, Temporal2dSimdCodecWorkspace& workspace, const codecs::ShuffleLayout layout) const {
     if (soa_data.empty() || soa_data.size() % kNumFeatures != 0) throw std::runtime_error("Invalid soa_data size");
     const size_t num_rows = soa_data.size() / kNumFeatures;
     workspace.ensure_capacity(soa_data.size());
-    return detail::encode16_2d_impl(soa_data, {prev_row.data(), NF}, num_rows, NF, *compressor_, workspace);
+    return detail::encode16_2d_impl(soa_data, {prev_row.data(), NF}, num_rows, NF, *compressor_, workspace, layout);
 }
 
 template <size_t NF>
-std::expected<Float32AlignedVector, std::string> Temporal2dSimdCodec<NF>::decode16(std::span<const std::byte> compressed, size_t num_rows, PrevRowFloat& prev_row) const {
-    const size_t total_elements = num_rows * kNumFeatures;
-    auto shuffled_bytes_result = compressor_->decompress(compressed);
-    if (!shuffled_bytes_result) return std::unexpected(shuffled_bytes_result.error());
-    if (shuffled_bytes_result->size() != total_elements * sizeof(hwy::float16_t)) return std::unexpected("Decompressed data size mismatch");
-    Float32AlignedVector out_data(total_elements);
-    static_assert(sizeof(std::byte) == sizeof(uint8_t));
-    simd::UnshuffleAndReconstruct16_2D_dispatcher(reinterpret_cast<const uint8_t*>(shuffled_bytes_result->data()), out_data.data(), num_rows, NF, {prev_row.data(), NF});
-    return out_data;
+std::expected<Float32AlignedVector, std::string> Temporal2dSimdCodec<NF>::decode16(std::span<const std::byte> compressed, size_t num_rows, PrevRowFloat& prev_row, const codecs::ShuffleLayout layout) const {
+    return detail::decode_2d_impl(compressed, num_rows, NF, sizeof(hwy::float16_t), {prev_row.data(), NF}, *compressor_,
+                                  &simd::UnshuffleAndReconstruct16_2D_Strided_dispatcher, layout);
 }
 
 template <size_t NF>
-std::expected<memory::vector<std::byte>, std::string> Temporal2dSimdCodec<NF>::encode32(std::span<const float> soa_data, const PrevRowFloat& prev_row, Temporal2dSimdCodecWorkspace& workspace) const {
+std::expected<memory::vector<std::byte>, std::string> Temporal2dSimdCodec<NF>::encode32(std::span<const float> soa_data, const PrevRowFloat& prev_row, Temporal2dSimdCodecWorkspace& workspace, const codecs::ShuffleLayout layout) const {
     if (soa_data.empty() || soa_data.size() % kNumFeatures != 0) throw std::runtime_error("Invalid soa_data size");
     const size_t num_rows = soa_data.size() / kNumFeatures;
     workspace.ensure_capacity(soa_data.size());
-    return detail::encode32_2d_impl(soa_data, {prev_row.data(), NF}, num_rows, NF, *compressor_, workspace);
+    return detail::encode32_2d_impl(soa_data, {prev_row.data(), NF}, num_rows, NF, *compressor_, workspace, layout);
 }
 
 template <size_t NF>
-std::expected<Float32AlignedVector, std::string> Temporal2dSimdCodec<NF>::decode32(std::span<const std::byte> compressed, size_t num_rows, PrevRowFloat& prev_row) const {
-    const size_t total_elements = num_rows * kNumFeatures;
-    auto shuffled_bytes_result = compressor_->decompress(compressed);
-    if (!shuffled_bytes_result) return std::unexpected(shuffled_bytes_result.error());
-    if (shuffled_bytes_result->size() != total_elements * sizeof(float)) return std::unexpected("Decompressed data size mismatch");
-    Float32AlignedVector out_data(total_elements);
-    static_assert(sizeof(std::byte) == sizeof(uint8_t));
-    simd::UnshuffleAndReconstruct32_2D_dispatcher(reinterpret_cast<const uint8_t*>(shuffled_bytes_result->data()), out_data.data(), num_rows, NF, {prev_row.data(), NF});
-    return out_data;
+std::expected<Float32AlignedVector, std::string> Temporal2dSimdCodec<NF>::decode32(std::span<const std::byte> compressed, size_t num_rows, PrevRowFloat& prev_row, const codecs::ShuffleLayout layout) const {
+    return detail::decode_2d_impl(compressed, num_rows, NF, sizeof(float), {prev_row.data(), NF}, *compressor_,
+                                  &simd::UnshuffleAndReconstruct32_2D_Strided_dispatcher, layout);
 }
 
 template <size_t NF>
@@ -296,7 +455,7 @@ std::expected<memory::vector<std::byte>, std::string> Temporal2dSimdCodec<NF>::e
     if (soa_data.empty() || soa_data.size() % kNumFeatures != 0) throw std::runtime_error("Invalid soa_data size");
     const size_t num_rows = soa_data.size() / kNumFeatures;
     workspace.ensure_capacity(soa_data.size());
-    return detail::encode64_2d_impl(soa_data, {prev_row.data(), NF}, num_rows, NF, *compressor_, workspace);
+    return detail::encode64_2d_impl(soa_data, {prev_row.data(), NF}, num_rows, NF, *compressor_, workspace, &simd::XorInt64_2D_dispatcher);
 }
 
 template <size_t NF>
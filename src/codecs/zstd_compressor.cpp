@@ -10,6 +10,8 @@
 namespace cryptodd
 {
 
+static_assert(static_cast<int>(ZstdStrategy::BTULTRA2) == ZSTD_btultra2);
+
 // --- Custom Deleters for Zstd Resources ---
 struct ZstdCctxDeleter { void operator()(ZSTD_CCtx* ptr) const { ZSTD_freeCCtx(ptr); } };
 struct ZstdDctxDeleter { void operator()(ZSTD_DCtx* ptr) const { ZSTD_freeDCtx(ptr); } };
@@ -29,6 +31,9 @@ struct ZstdCompressor::Impl
     CdictPtr cdict;
     DdictPtr ddict;
     int compression_level = DEFAULT_COMPRESSION_LEVEL;
+    Params params;
+    // Reused output block for decompress_blocks(), so streaming does not allocate per call.
+    memory::vector<std::byte> stream_block;
 
     explicit Impl(std::span<const std::byte> dict, const int level)
         : cctx(ZSTD_createCCtx()), dctx(ZSTD_createDCtx()), compression_level(level)
@@ -61,6 +66,11 @@ ZstdCompressor::ZstdCompressor(std::span<const std::byte> dict, const int level)
 
 ZstdCompressor::ZstdCompressor(const int level) : ZstdCompressor({}, level) {}
 
+ZstdCompressor::ZstdCompressor(const Params& params) : ZstdCompressor({}, params.level)
+{
+    set_params(params);
+}
+
 ZstdCompressor::~ZstdCompressor() = default;
 ZstdCompressor::ZstdCompressor(ZstdCompressor&&) noexcept = default;
 ZstdCompressor& ZstdCompressor::operator=(ZstdCompressor&&) noexcept = default;
@@ -82,11 +92,18 @@ std::expected<size_t, std::string> ZstdCompressor::do_get_decompress_size(std::s
 }
 
 std::expected<size_t, std::string> ZstdCompressor::do_compress_into(std::span<const std::byte> uncompressed, std::span<std::byte> compressed) {
-    const size_t compressed_size = pimpl_->cdict
-        ? ZSTD_compress_usingCDict(pimpl_->cctx.get(), compressed.data(), compressed.size(),
-                                   uncompressed.data(), uncompressed.size(), pimpl_->cdict.get())
-        : ZSTD_compressCCtx(pimpl_->cctx.get(), compressed.data(), compressed.size(),
-                            uncompressed.data(), uncompressed.size(), pimpl_->compression_level);
+    size_t compressed_size;
+    if (pimpl_->cdict) {
+        compressed_size = ZSTD_compress_usingCDict(pimpl_->cctx.get(), compressed.data(), compressed.size(),
+                                                   uncompressed.data(), uncompressed.size(), pimpl_->cdict.get());
+    } else if (!pimpl_->params.is_level_only()) {
+        // Advanced parameters are sticky on the CCtx (see set_params) and only honoured by ZSTD_compress2.
+        compressed_size = ZSTD_compress2(pimpl_->cctx.get(), compressed.data(), compressed.size(),
+                                         uncompressed.data(), uncompressed.size());
+    } else {
+        compressed_size = ZSTD_compressCCtx(pimpl_->cctx.get(), compressed.data(), compressed.size(),
+                                            uncompressed.data(), uncompressed.size(), pimpl_->compression_level);
+    }
 
     if (ZSTD_isError(compressed_size)) {
         return std::unexpected(std::format("ZSTD compression failed: {}", ZSTD_getErrorName(compressed_size)));
@@ -107,6 +124,60 @@ std::expected<size_t, std::string> ZstdCompressor::do_decompress_into(std::span<
     return result_size;
 }
 
+std::expected<size_t, std::string> ZstdCompressor::decompress_blocks(std::span<const std::byte> compressed_data, const size_t block_size, const BlockSink& sink) {
+    if (block_size == 0) {
+        return std::unexpected("Block size must be greater than zero.");
+    }
+
+    ZSTD_DCtx* dctx = pimpl_->dctx.get();
+    ZSTD_DCtx_reset(dctx, ZSTD_reset_session_only);
+    if (pimpl_->ddict) {
+        if (const size_t ret = ZSTD_DCtx_refDDict(dctx, pimpl_->ddict.get()); ZSTD_isError(ret)) {
+            return std::unexpected(std::format("ZSTD dictionary setup failed: {}", ZSTD_getErrorName(ret)));
+        }
+    }
+
+    auto& block = pimpl_->stream_block;
+    if (block.size() < block_size) {
+        block.resize(block_size);
+    }
+
+    ZSTD_inBuffer input{compressed_data.data(), compressed_data.size(), 0};
+    ZSTD_outBuffer output{block.data(), block_size, 0};
+    size_t total = 0;
+
+    const auto emit = [&]() -> std::expected<void, std::string> {
+        total += output.pos;
+        auto result = sink(std::span<const std::byte>(block.data(), output.pos));
+        output.pos = 0;
+        return result;
+    };
+
+    for (;;) {
+        const size_t ret = ZSTD_decompressStream(dctx, &output, &input);
+        if (ZSTD_isError(ret)) {
+            return std::unexpected(std::format("ZSTD decompression failed: {}", ZSTD_getErrorName(ret)));
+        }
+
+        const bool block_full = output.pos == output.size;
+        if (block_full) {
+            if (auto result = emit(); !result) return std::unexpected(result.error());
+        }
+        // ret == 0 means the current frame is fully decoded and flushed; keep going if more frames follow.
+        if (ret == 0 && input.pos == input.size) {
+            break;
+        }
+        if (!block_full && input.pos == input.size) {
+            return std::unexpected("ZSTD decompression failed: truncated frame.");
+        }
+    }
+
+    if (output.pos > 0) {
+        if (auto result = emit(); !result) return std::unexpected(result.error());
+    }
+    return total;
+}
+
 void ZstdCompressor::set_level(const int level)
 {
     if (level > ZSTD_maxCLevel() || level < ZSTD_minCLevel())
@@ -114,6 +185,43 @@ void ZstdCompressor::set_level(const int level)
         throw std::invalid_argument("Invalid zstd compression level.");
     }
     pimpl_->compression_level = level;
+    pimpl_->params.level = level;
+    if (!pimpl_->params.is_level_only())
+    {
+        set_params(pimpl_->params);
+    }
+}
+
+void ZstdCompressor::set_params(const Params& params)
+{
+    if (params.level > ZSTD_maxCLevel() || params.level < ZSTD_minCLevel())
+    {
+        throw std::invalid_argument("Invalid zstd compression level.");
+    }
+
+    ZSTD_CCtx* cctx = pimpl_->cctx.get();
+    ZSTD_CCtx_reset(cctx, ZSTD_reset_session_and_parameters);
+    const auto set = [cctx](const ZSTD_cParameter param, const int value, const char* name)
+    {
+        if (const size_t ret = ZSTD_CCtx_setParameter(cctx, param, value); ZSTD_isError(ret))
+        {
+            throw std::invalid_argument(std::format("Invalid zstd parameter {}={}: {}", name, value, ZSTD_getErrorName(ret)));
+        }
+    };
+
+    set(ZSTD_c_compressionLevel, params.level, "level");
+    if (params.workers != 0) set(ZSTD_c_nbWorkers, params.workers, "workers");
+    if (params.long_distance_matching) set(ZSTD_c_enableLongDistanceMatching, 1, "long_distance_matching");
+    if (params.window_log != 0) set(ZSTD_c_windowLog, params.window_log, "window_log");
+    if (params.strategy != ZstdStrategy::DEFAULT) set(ZSTD_c_strategy, static_cast<int>(params.strategy), "strategy");
+
+    pimpl_->compression_level = params.level;
+    pimpl_->params = params;
+}
+
+const ZstdCompressor::Params& ZstdCompressor::params() const
+{
+    return pimpl_->params;
 }
 
 } // namespace cryptodd
@@ -7,12 +7,56 @@
 
 namespace cryptodd {
 
+/**
+ * @brief zstd match-finding strategies, numbered like ZSTD_strategy. DEFAULT lets the level decide.
+ */
+enum class ZstdStrategy : int {
+    DEFAULT = 0,
+    FAST = 1,
+    DFAST = 2,
+    GREEDY = 3,
+    LAZY = 4,
+    LAZY2 = 5,
+    BTLAZY2 = 6,
+    BTOPT = 7,
+    BTULTRA = 8,
+    BTULTRA2 = 9,
+};
+
 class ZstdCompressor final : public ICompressor {
 public:
     static constexpr int DEFAULT_COMPRESSION_LEVEL = 1;
+    // Largest window zstd decoders accept unless told otherwise (ZSTD_WINDOWLOG_LIMIT_DEFAULT).
+    static constexpr int DEFAULT_DECODER_WINDOW_LOG = 27;
+
+    /**
+     * @brief Advanced compression parameters. Zero / DEFAULT fields keep zstd's level-derived choice.
+     *
+     * Frames written with window_log above DEFAULT_DECODER_WINDOW_LOG still decode with decompress(), which
+     * writes straight into the full output; decompress_blocks() rejects them, as its window is kept at the default.
+     */
+    struct Params {
+        int level = DEFAULT_COMPRESSION_LEVEL;
+        int workers = 0;                      // ZSTD_c_nbWorkers; 0 compresses on the calling thread.
+        bool long_distance_matching = false;  // ZSTD_c_enableLongDistanceMatching
+        int window_log = 0;                   // ZSTD_c_windowLog
+        ZstdStrategy strategy = ZstdStrategy::DEFAULT;
+
+        /** @brief True when only the level is set, i.e. the plain one-shot API can be used. */
+        [[nodiscard]] bool is_level_only() const noexcept {
+            return workers == 0 && !long_distance_matching && window_log == 0 && strategy == ZstdStrategy::DEFAULT;
+        }
+        /** @brief True when frames may need a decoder window above DEFAULT_DECODER_WINDOW_LOG. */
+        [[nodiscard]] bool needs_long_window() const noexcept { return window_log > DEFAULT_DECODER_WINDOW_LOG; }
+
+        bool operator==(const Params&) const = default;
+    };
+
     // Constructor takes an optional dictionary.
     explicit ZstdCompressor(std::span<const std::byte> dict, int level = DEFAULT_COMPRESSION_LEVEL);
     explicit ZstdCompressor(int level = DEFAULT_COMPRESSION_LEVEL);
+    /** @brief Creates a compressor with advanced parameters. Throws std::invalid_argument if zstd rejects one. */
+    explicit ZstdCompressor(const Params& params);
     ~ZstdCompressor() override;
 
     // --- Rule of Five for PIMPL ---
@@ -23,7 +67,15 @@ public:
 
     void set_level(int level);
 
-    std::expected<size_t, std::string> get_decompress_size(std::span<const std::byte> compressed_data) { return this->do_get_decompress_size(compressed_data); }
+    /** @brief Replaces all compression parameters. Throws std::invalid_argument if zstd rejects one. */
+    void set_params(const Params& params);
+    [[nodiscard]] const Params& params() const;
+
+    /**
+     * @brief Streams the frame through ZSTD_decompressStream into a reusable block buffer.
+     * Peak memory is one block plus the frame's window, regardless of the decompressed size.
+     */
+    std::expected<size_t, std::string> decompress_blocks(std::span<const std::byte> compressed_data, size_t block_size, const BlockSink& sink) override;
 
 protected:
     // Implement the new protected virtual interface from ICompressor
@@ -30,11 +30,13 @@ namespace cryptodd
         using Float32AlignedVector = memory::AlignedVector<float, _DEFAULT_HWY_ALIGNMENT>;
         using ByteAlignedVector = memory::AlignedVector<std::byte, _DEFAULT_HWY_ALIGNMENT>;
         using Int64AlignedVector = memory::AlignedVector<int64_t, _DEFAULT_HWY_ALIGNMENT>;
+        using Float64AlignedVector = memory::AlignedVector<double, _DEFAULT_HWY_ALIGNMENT>;
     } // namespace details
 
     using vect_variant =
         std::variant<memory::vector<uint8_t>, memory::vector<float>, memory::vector<int64_t>, memory::vector<std::byte>,
-                     details::Float32AlignedVector, details::ByteAlignedVector, details::Int64AlignedVector>;
+                     details::Float32AlignedVector, details::ByteAlignedVector, details::Int64AlignedVector,
+                     details::Float64AlignedVector>;
 
     class Buffer
     {
@@ -73,6 +75,10 @@ namespace cryptodd
         {
         }
 
+        explicit Buffer(details::Float64AlignedVector&& data) : m_data(std::move(data))
+        {
+        }
+
         Buffer(const Buffer& other) = delete;
         Buffer& operator=(const Buffer& other) = delete;
 
@@ -0,0 +1,239 @@
+#pragma once
+
+#include "../file_format/cdd_file_format.h"
+#include "../memory/allocator.h"
+
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <span>
+#include <string>
+
+/**
+ * @file chunk_frames.h
+ * @brief Layout of MULTI_FRAME chunk payloads.
+ *
+ * A multi-frame chunk is split along its first dimension into consecutive row ranges ("frames"). Each
+ * frame is encoded exactly like a standalone chunk of the same type, using the row just before it as
+ * its prev state, so frames can be encoded and decoded independently of each other:
+ *
+ *     uint32_t frame_count
+ *     uint32_t state_bytes                      // size of one row of state
+ *     uint64_t rows[frame_count]                // rows in each frame
+ *     uint64_t sizes[frame_count]               // encoded bytes of each frame
+ *     std::byte states[frame_count - 1][state_bytes]  // prev state of frames 1..N-1
+ *     frame payloads, back to back
+ *
+ * Frame 0 starts from the caller-provided state. Integers are stored in native byte order, like the
+ * rest of the chunk payload (see FLAG_LITTLE_ENDIAN / FLAG_BIG_ENDIAN).
+ */
+namespace cryptodd::chunk_frames
+{
+    /**
+     * @brief How a chunk type's data is split into rows.
+     *
+     * Orderbook and 1D chunks are row-major, so a frame is a contiguous byte range. Temporal 2D chunks
+     * are SoA (feature f, row r at f * num_rows + r), so a frame is one slice per feature.
+     */
+    struct RowGeometry
+    {
+        size_t num_rows = 0;
+        size_t row_elements = 0;
+        size_t element_size = 0;
+        bool column_major = false;
+        DType dtype = DType::FLOAT32; // dtype of the decoded data
+
+        [[nodiscard]] size_t row_bytes() const noexcept { return row_elements * element_size; }
+        [[nodiscard]] size_t total_bytes() const noexcept { return num_rows * row_bytes(); }
+    };
+
+    inline std::expected<RowGeometry, std::string> row_geometry(const ChunkDataType type, std::span<const int64_t> shape)
+    {
+        for (const auto dim : shape)
+        {
+            if (dim < 0) return std::unexpected("Shape dimensions cannot be negative.");
+        }
+        switch (type)
+        {
+        case ChunkDataType::TEMPORAL_1D_SIMD_F16_XOR_SHUFFLE_AS_F32:
+        case ChunkDataType::TEMPORAL_1D_SIMD_F32_XOR_SHUFFLE:
+        case ChunkDataType::TEMPORAL_1D_CHIMP_F32:
+        case ChunkDataType::TEMPORAL_1D_FIXED_POINT_F32:
+        case ChunkDataType::TEMPORAL_1D_QUANTIZED_F32:
+            if (shape.size() != 1) return std::unexpected("Temporal 1D data requires a 1D shape.");
+            return RowGeometry{static_cast<size_t>(shape[0]), 1, sizeof(float), false, DType::FLOAT32};
+        case ChunkDataType::TEMPORAL_1D_CHIMP_F64:
+        case ChunkDataType::TEMPORAL_1D_SIMD_F64_XOR_SHUFFLE:
+        case ChunkDataType::TEMPORAL_1D_FIXED_POINT_F64:
+        case ChunkDataType::TEMPORAL_1D_QUANTIZED_F64:
+            if (shape.size() != 1) return std::unexpected("Temporal 1D data requires a 1D shape.");
+            return RowGeometry{static_cast<size_t>(shape[0]), 1, sizeof(double), false, DType::FLOAT64};
+        case ChunkDataType::TEMPORAL_1D_SIMD_I64_XOR:
+        case ChunkDataType::TEMPORAL_1D_SIMD_I64_DELTA:
+        case ChunkDataType::TEMPORAL_1D_SIMD_I64_DELTA_BITPACK:
+        case ChunkDataType::TEMPORAL_1D_SIMD_I64_DELTA_BITPACK_ZSTD:
+        case ChunkDataType::TEMPORAL_1D_SIMD_I64_DOUBLE_DELTA:
+            if (shape.size() != 1) return std::unexpected("Temporal 1D data requires a 1D shape.");
+            return RowGeometry{static_cast<size_t>(shape[0]), 1, sizeof(int64_t), false, DType::INT64};
+        case ChunkDataType::OKX_OB_SIMD_F16_AS_F32:
+        case ChunkDataType::OKX_OB_SIMD_F32:
+        case ChunkDataType::BINANCE_OB_SIMD_F16_AS_F32:
+        case ChunkDataType::BINANCE_OB_SIMD_F32:
+        case ChunkDataType::GENERIC_OB_SIMD_F16_AS_F32:
+        case ChunkDataType::GENERIC_OB_SIMD_F32:
+        case ChunkDataType::ORDERBOOK_FIXED_POINT_F32:
+        case ChunkDataType::GENERIC_OB_SIMD_BFP16_AS_F32:
+        case ChunkDataType::GENERIC_OB_SIMD_SPARSE_F32:
+            if (shape.size() != 3) return std::unexpected("Orderbook data requires a 3D shape.");
+            return RowGeometry{static_cast<size_t>(shape[0]), static_cast<size_t>(shape[1] * shape[2]), sizeof(float), false, DType::FLOAT32};
+        case ChunkDataType::TEMPORAL_2D_SIMD_F16_AS_F32:
+        case ChunkDataType::TEMPORAL_2D_SIMD_F32:
+        case ChunkDataType::TEMPORAL_2D_FIXED_POINT_F32:
+        case ChunkDataType::TEMPORAL_2D_QUANTIZED_F32:
+            if (shape.size() != 2) return std::unexpected("Temporal 2D data requires a 2D shape.");
+            return RowGeometry{static_cast<size_t>(shape[0]), static_cast<size_t>(shape[1]), sizeof(float), true, DType::FLOAT32};
+        case ChunkDataType::TEMPORAL_2D_SIMD_F64:
+        case ChunkDataType::TEMPORAL_2D_FIXED_POINT_F64:
+        case ChunkDataType::TEMPORAL_2D_QUANTIZED_F64:
+            if (shape.size() != 2) return std::unexpected("Temporal 2D data requires a 2D shape.");
+            return RowGeometry{static_cast<size_t>(shape[0]), static_cast<size_t>(shape[1]), sizeof(double), true, DType::FLOAT64};
+        case ChunkDataType::TEMPORAL_2D_SIMD_I64:
+        case ChunkDataType::TEMPORAL_2D_SIMD_I64_DOUBLE_DELTA:
+        case ChunkDataType::TEMPORAL_2D_SIMD_I64_DELTA:
+        case ChunkDataType::TEMPORAL_2D_SIMD_I64_DELTA_SHUFFLE:
+            if (shape.size() != 2) return std::unexpected("Temporal 2D data requires a 2D shape.");
+            return RowGeometry{static_cast<size_t>(shape[0]), static_cast<size_t>(shape[1]), sizeof(int64_t), true, DType::INT64};
+        default:
+            return std::unexpected("Chunk type does not support multi-frame encoding.");
+        }
+    }
+
+    /**
+     * @brief Copies rows [first_row, first_row + count) of `src` into `dst`, laid out as a standalone chunk of `count` rows.
+     */
+    inline void gather_rows(const RowGeometry& geometry, const std::byte* src, const size_t first_row, const size_t count, std::byte* dst)
+    {
+        const size_t es = geometry.element_size;
+        if (!geometry.column_major)
+        {
+            std::memcpy(dst, src + first_row * geometry.row_bytes(), count * geometry.row_bytes());
+            return;
+        }
+        for (size_t f = 0; f < geometry.row_elements; ++f)
+        {
+            std::memcpy(dst + f * count * es, src + (f * geometry.num_rows + first_row) * es, count * es);
+        }
+    }
+
+    /**
+     * @brief Inverse of gather_rows: writes a standalone chunk of `count` rows back into rows [first_row, ...) of `dst`.
+     */
+    inline void scatter_rows(const RowGeometry& geometry, const std::byte* src, const size_t first_row, const size_t count, std::byte* dst)
+    {
+        const size_t es = geometry.element_size;
+        if (!geometry.column_major)
+        {
+            std::memcpy(dst + first_row * geometry.row_bytes(), src, count * geometry.row_bytes());
+            return;
+        }
+        for (size_t f = 0; f < geometry.row_elements; ++f)
+        {
+            std::memcpy(dst + (f * geometry.num_rows + first_row) * es, src + f * count * es, count * es);
+        }
+    }
+
+    /**
+     * @brief Copies row `row` of `src` into `dst` (row_bytes() bytes), i.e. the prev state of the row after it.
+     */
+    inline void extract_row(const RowGeometry& geometry, const std::byte* src, const size_t row, std::byte* dst)
+    {
+        gather_rows(geometry, src, row, 1, dst);
+    }
+
+    /**
+     * @brief Parsed view over a multi-frame payload. Spans point into the payload passed to parse().
+     */
+    struct FrameTable
+    {
+        memory::vector<uint64_t> rows;
+        memory::vector<uint64_t> sizes;
+        size_t state_bytes = 0;
+        std::span<const std::byte> states;
+        memory::vector<std::span<const std::byte>> frames;
+
+        [[nodiscard]] size_t size() const noexcept { return rows.size(); }
+
+        /** @brief Prev state of frame `index`; empty for frame 0, which starts from the caller's state. */
+        [[nodiscard]] std::span<const std::byte> state(const size_t index) const
+        {
+            return index == 0 ? std::span<const std::byte>{} : states.subspan((index - 1) * state_bytes, state_bytes);
+        }
+    };
+
+    inline size_t header_size(const size_t frame_count, const size_t state_bytes)
+    {
+        return 2 * sizeof(uint32_t) + 2 * frame_count * sizeof(uint64_t) + (frame_count - 1) * state_bytes;
+    }
+
+    /**
+     * @brief Writes the frame table header. `states` holds the prev state of frames 1..N-1, back to back.
+     * @return The header bytes; frame payloads are appended by the caller.
+     */
+    inline memory::vector<std::byte> write_header(std::span<const uint64_t> rows, std::span<const uint64_t> sizes,
+                                                  const size_t state_bytes, std::span<const std::byte> states)
+    {
+        const auto frame_count = static_cast<uint32_t>(rows.size());
+        const auto state_size = static_cast<uint32_t>(state_bytes);
+        memory::vector<std::byte> out(header_size(frame_count, state_bytes));
+        std::byte* p = out.data();
+        std::memcpy(p, &frame_count, sizeof(frame_count)); p += sizeof(frame_count);
+        std::memcpy(p, &state_size, sizeof(state_size)); p += sizeof(state_size);
+        std::memcpy(p, rows.data(), rows.size_bytes()); p += rows.size_bytes();
+        std::memcpy(p, sizes.data(), sizes.size_bytes()); p += sizes.size_bytes();
+        std::memcpy(p, states.data(), states.size_bytes());
+        return out;
+    }
+
+    /**
+     * @brief Parses and validates a multi-frame payload against the chunk's row geometry.
+     */
+    inline std::expected<FrameTable, std::string> parse(std::span<const std::byte> payload, const RowGeometry& geometry)
+    {
+        uint32_t frame_count = 0;
+        uint32_t state_bytes = 0;
+        if (payload.size() < 2 * sizeof(uint32_t)) return std::unexpected("Multi-frame payload is too small for its header.");
+        std::memcpy(&frame_count, payload.data(), sizeof(frame_count));
+        std::memcpy(&state_bytes, payload.data() + sizeof(frame_count), sizeof(state_bytes));
+        if (frame_count == 0) return std::unexpected("Multi-frame payload has no frames.");
+        if (state_bytes != geometry.row_bytes()) return std::unexpected("Multi-frame state size does not match the chunk shape.");
+        if (frame_count > payload.size() || payload.size() < header_size(frame_count, state_bytes))
+        {
+            return std::unexpected("Multi-frame payload is too small for its frame table.");
+        }
+
+        FrameTable table;
+        table.state_bytes = state_bytes;
+        table.rows.resize(frame_count);
+        table.sizes.resize(frame_count);
+        const std::byte* p = payload.data() + 2 * sizeof(uint32_t);
+        std::memcpy(table.rows.data(), p, frame_count * sizeof(uint64_t)); p += frame_count * sizeof(uint64_t);
+        std::memcpy(table.sizes.data(), p, frame_count * sizeof(uint64_t)); p += frame_count * sizeof(uint64_t);
+        table.states = {p, (frame_count - 1) * size_t{state_bytes}};
+
+        uint64_t total_rows = 0;
+        size_t offset = header_size(frame_count, state_bytes);
+        table.frames.reserve(frame_count);
+        for (uint32_t i = 0; i < frame_count; ++i)
+        {
+            if (table.sizes[i] > payload.size() - offset) return std::unexpected("Multi-frame payload is truncated.");
+            table.frames.push_back(payload.subspan(offset, table.sizes[i]));
+            offset += table.sizes[i];
+            // Checked frame by frame, so no sum of crafted counts can wrap around to the shape.
+            if (table.rows[i] > geometry.num_rows - total_rows) return std::unexpected("Multi-frame row counts exceed the chunk shape.");
+            total_rows += table.rows[i];
+        }
+        if (offset != payload.size()) return std::unexpected("Multi-frame payload has trailing bytes.");
+        if (total_rows != geometry.num_rows) return std::unexpected("Multi-frame row counts do not add up to the chunk shape.");
+        return table;
+    }
+} // namespace cryptodd::chunk_frames
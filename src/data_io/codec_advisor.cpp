@@ -0,0 +1,367 @@
+#include "codec_advisor.h"
+#include "../codecs/orderbook_sparse_codec.h" // For OrderbookSparseCodec::kDefaultMaxChangedFraction
+#include "chunk_frames.h"
+#include "data_compressor.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <format>
+#include <numeric>
+
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "codec_advisor.cpp"
+#include "hwy/foreach_target.h"
+
+#include <hwy/highway.h>
+
+HWY_BEFORE_NAMESPACE();
+namespace cryptodd::HWY_NAMESPACE {
+
+namespace hn = hwy::HWY_NAMESPACE;
+
+template <typename T>
+HWY_INLINE void ResidualBitStats(const T* HWY_RESTRICT cur, const T* HWY_RESTRICT prev, const size_t num_elements, uint64_t* HWY_RESTRICT sums) {
+    constexpr int kBits = static_cast<int>(sizeof(T) * 8);
+    uint64_t xor_bits = 0;
+    uint64_t delta_bits = 0;
+    uint64_t equal = 0;
+    size_t i = 0;
+#if HWY_TARGET != HWY_SCALAR
+    const hn::ScalableTag<T> d;
+    const hn::RebindToSigned<decltype(d)> di;
+    const size_t lanes = hn::Lanes(d);
+    const auto v_bits = hn::Set(d, static_cast<T>(kBits));
+    // Lanes add at most 64 per vector, so a block of 2^16 vectors cannot overflow even 32-bit lanes.
+    constexpr size_t kBlockVectors = size_t{1} << 16;
+    while (i + lanes <= num_elements) {
+        auto acc_xor = hn::Zero(d);
+        auto acc_delta = hn::Zero(d);
+        for (size_t v = 0; v < kBlockVectors && i + lanes <= num_elements; ++v, i += lanes) {
+            const auto v_cur = hn::LoadU(d, cur + i);
+            const auto v_prev = hn::LoadU(d, prev + i);
+            const auto v_delta = hn::BitCast(di, hn::Sub(v_cur, v_prev));
+            const auto v_zigzag = hn::BitCast(d, hn::Xor(hn::ShiftLeft<1>(v_delta), hn::ShiftRight<kBits - 1>(v_delta)));
+            acc_xor = hn::Add(acc_xor, hn::Sub(v_bits, hn::LeadingZeroCount(hn::Xor(v_cur, v_prev))));
+            acc_delta = hn::Add(acc_delta, hn::Sub(v_bits, hn::LeadingZeroCount(v_zigzag)));
+            equal += hn::CountTrue(d, hn::Eq(v_cur, v_prev));
+        }
+        xor_bits += hn::ReduceSum(d, acc_xor);
+        delta_bits += hn::ReduceSum(d, acc_delta);
+    }
+#endif
+    for (; i < num_elements; ++i) {
+        const T delta = static_cast<T>(cur[i] - prev[i]);
+        const T zigzag = static_cast<T>((delta << 1) ^ static_cast<T>(0 - (delta >> (kBits - 1))));
+        xor_bits += static_cast<uint64_t>(kBits - std::countl_zero(static_cast<T>(cur[i] ^ prev[i])));
+        delta_bits += static_cast<uint64_t>(kBits - std::countl_zero(zigzag));
+        equal += cur[i] == prev[i] ? 1 : 0;
+    }
+    sums[0] += xor_bits;
+    sums[1] += delta_bits;
+    sums[2] += equal;
+}
+
+HWY_NOINLINE void ResidualBitStats32(const uint32_t* HWY_RESTRICT cur, const uint32_t* HWY_RESTRICT prev, const size_t num_elements, uint64_t* HWY_RESTRICT sums) {
+    ResidualBitStats(cur, prev, num_elements, sums);
+}
+
+HWY_NOINLINE void ResidualBitStats64(const uint64_t* HWY_RESTRICT cur, const uint64_t* HWY_RESTRICT prev, const size_t num_elements, uint64_t* HWY_RESTRICT sums) {
+    ResidualBitStats(cur, prev, num_elements, sums);
+}
+
+} // namespace cryptodd::HWY_NAMESPACE
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace cryptodd {
+
+namespace simd {
+    HWY_EXPORT(ResidualBitStats32);
+    HWY_EXPORT(ResidualBitStats64);
+    void ResidualBitStats32_dispatcher(const uint32_t* cur, const uint32_t* prev, size_t num_elements, uint64_t* sums) {
+        HWY_DYNAMIC_DISPATCH(ResidualBitStats32)(cur, prev, num_elements, sums);
+    }
+    void ResidualBitStats64_dispatcher(const uint64_t* cur, const uint64_t* prev, size_t num_elements, uint64_t* sums) {
+        HWY_DYNAMIC_DISPATCH(ResidualBitStats64)(cur, prev, num_elements, sums);
+    }
+} // namespace simd
+
+namespace {
+    // Entropy estimates reach zero on constant data; no real chunk gets below this many bits per element.
+    constexpr double kMaxEstimatedRatio = 1024.0;
+
+    using PlaneHistograms = memory::vector<std::array<uint64_t, 256>>;
+
+    void add_planes(PlaneHistograms& histograms, uint64_t residual) {
+        for (auto& histogram : histograms) {
+            ++histogram[residual & 0xFF];
+            residual >>= 8;
+        }
+    }
+
+    double entropy_bits(const std::array<uint64_t, 256>& histogram) {
+        const uint64_t total = std::accumulate(histogram.begin(), histogram.end(), uint64_t{0});
+        double bits = 0.0;
+        for (const uint64_t count : histogram) {
+            if (count == 0) continue;
+            const double p = static_cast<double>(count) / static_cast<double>(total);
+            bits -= p * std::log2(p);
+        }
+        return bits;
+    }
+
+    std::vector<double> plane_entropies(const PlaneHistograms& histograms) {
+        std::vector<double> entropies;
+        entropies.reserve(histograms.size());
+        for (const auto& histogram : histograms) entropies.push_back(entropy_bits(histogram));
+        return entropies;
+    }
+
+    template <typename U>
+    U zigzag(const U delta) {
+        constexpr int kBits = static_cast<int>(sizeof(U) * 8);
+        return static_cast<U>((delta << 1) ^ static_cast<U>(0 - (delta >> (kBits - 1))));
+    }
+
+    template <typename U>
+    void residual_bit_stats(const U* cur, const U* prev, const size_t num_elements, uint64_t* sums) {
+        if constexpr (sizeof(U) == 4) {
+            simd::ResidualBitStats32_dispatcher(cur, prev, num_elements, sums);
+        } else {
+            simd::ResidualBitStats64_dispatcher(cur, prev, num_elements, sums);
+        }
+    }
+
+    // Residual statistics of `num_segments` runs of `segment_length` words, each word against the word `lag` before it
+    // in its run (zero before the run starts), as the XOR and delta codecs compute them.
+    template <typename U>
+    void accumulate_residuals(SampleStats& stats, const U* words, const size_t num_segments, const size_t segment_length, const size_t lag,
+                              const bool is_integer) {
+        constexpr size_t kPlanes = sizeof(U);
+        PlaneHistograms xor_planes(kPlanes, std::array<uint64_t, 256>{});
+        PlaneHistograms changed_planes(kPlanes, std::array<uint64_t, 256>{});
+        PlaneHistograms delta_planes(is_integer ? kPlanes : 0, std::array<uint64_t, 256>{});
+        PlaneHistograms double_delta_planes(is_integer ? kPlanes : 0, std::array<uint64_t, 256>{});
+        uint64_t sums[3] = {0, 0, 0};
+
+        for (size_t s = 0; s < num_segments; ++s) {
+            const U* segment = words + s * segment_length;
+            const size_t head = std::min(lag, segment_length);
+            const memory::vector<U> zeros(head, U{0});
+            residual_bit_stats(segment, zeros.data(), head, sums);
+            residual_bit_stats(segment + head, segment, segment_length - head, sums);
+
+            for (size_t i = 0; i < segment_length; ++i) {
+                const U prev = i >= lag ? segment[i - lag] : U{0};
+                const U xor_residual = static_cast<U>(segment[i] ^ prev);
+                add_planes(xor_planes, xor_residual);
+                if (xor_residual != 0) add_planes(changed_planes, xor_residual);
+                if (is_integer) {
+                    const U prev_delta = i >= lag ? static_cast<U>(prev - (i >= 2 * lag ? segment[i - 2 * lag] : U{0})) : U{0};
+                    const U delta = static_cast<U>(segment[i] - prev);
+                    add_planes(delta_planes, zigzag(delta));
+                    add_planes(double_delta_planes, zigzag(static_cast<U>(delta - prev_delta)));
+                }
+            }
+        }
+
+        const auto n = static_cast<double>(stats.num_elements);
+        stats.xor_significant_bits = static_cast<double>(sums[0]) / n;
+        stats.delta_significant_bits = is_integer ? static_cast<double>(sums[1]) / n : 0.0;
+        stats.unchanged_fraction = static_cast<double>(sums[2]) / n;
+        stats.xor_plane_entropy = plane_entropies(xor_planes);
+        stats.changed_plane_entropy = sums[2] == stats.num_elements ? std::vector<double>(kPlanes, 0.0) : plane_entropies(changed_planes);
+        stats.delta_plane_entropy = plane_entropies(delta_planes);
+        stats.double_delta_plane_entropy = plane_entropies(double_delta_planes);
+    }
+
+    double sum_of(const std::vector<double>& values) { return std::accumulate(values.begin(), values.end(), 0.0); }
+
+    // Binary entropy: bits per element of a bitmap whose bits are set with probability p.
+    double binary_entropy(const double p) {
+        if (p <= 0.0 || p >= 1.0) return 0.0;
+        return -p * std::log2(p) - (1.0 - p) * std::log2(1.0 - p);
+    }
+
+    // Estimated encoded bits per element, or NaN when the model says the chunk type would not be kept.
+    double estimated_bits(const ChunkDataType codec, const SampleStats& stats) {
+        switch (codec) {
+            case ChunkDataType::TEMPORAL_1D_SIMD_F32_XOR_SHUFFLE:
+            case ChunkDataType::TEMPORAL_1D_SIMD_F64_XOR_SHUFFLE:
+            case ChunkDataType::TEMPORAL_2D_SIMD_F32:
+            case ChunkDataType::TEMPORAL_2D_SIMD_F64:
+            case ChunkDataType::GENERIC_OB_SIMD_F32:
+            case ChunkDataType::TEMPORAL_1D_SIMD_I64_XOR:
+            case ChunkDataType::TEMPORAL_2D_SIMD_I64:
+                return sum_of(stats.xor_plane_entropy);
+            case ChunkDataType::TEMPORAL_1D_SIMD_I64_DELTA:
+            case ChunkDataType::TEMPORAL_2D_SIMD_I64_DELTA_SHUFFLE:
+                return sum_of(stats.delta_plane_entropy);
+            case ChunkDataType::TEMPORAL_1D_SIMD_I64_DOUBLE_DELTA:
+            case ChunkDataType::TEMPORAL_2D_SIMD_I64_DOUBLE_DELTA:
+                return sum_of(stats.double_delta_plane_entropy);
+            case ChunkDataType::TEMPORAL_1D_CHIMP_F32:
+            case ChunkDataType::TEMPORAL_1D_CHIMP_F64:
+                // No entropy stage: the significant XOR bits, a 2-bit flag and a 3-bit leading-zero code when changed.
+                return 2.0 + stats.xor_significant_bits + 3.0 * (1.0 - stats.unchanged_fraction);
+            case ChunkDataType::GENERIC_OB_SIMD_SPARSE_F32:
+                if (1.0 - stats.unchanged_fraction > OrderbookSparseCodec::kDefaultMaxChangedFraction) return std::nan("");
+                return binary_entropy(1.0 - stats.unchanged_fraction) + (1.0 - stats.unchanged_fraction) * sum_of(stats.changed_plane_entropy);
+            default:
+                return static_cast<double>(stats.element_size) * stats.raw_entropy_bits;
+        }
+    }
+
+    // Coarse single-core encode priors in MB/s, used when no trial is run.
+    double nominal_throughput_mbps(const ChunkDataType codec) {
+        switch (codec) {
+            case ChunkDataType::TEMPORAL_1D_CHIMP_F32:
+            case ChunkDataType::TEMPORAL_1D_CHIMP_F64:
+                return 300.0;
+            case ChunkDataType::GENERIC_OB_SIMD_SPARSE_F32:
+                return 700.0;
+            case ChunkDataType::ZSTD_COMPRESSED:
+                return 300.0;
+            default:
+                return 1000.0;
+        }
+    }
+} // namespace
+
+std::vector<ChunkDataType> CodecAdvisor::candidates(const DType dtype, const size_t num_dims) {
+    using enum ChunkDataType;
+    std::vector<ChunkDataType> result;
+    switch (dtype) {
+        case DType::FLOAT32:
+            if (num_dims == 1) result = {TEMPORAL_1D_SIMD_F32_XOR_SHUFFLE, TEMPORAL_1D_CHIMP_F32};
+            if (num_dims == 2) result = {TEMPORAL_2D_SIMD_F32};
+            if (num_dims == 3) result = {GENERIC_OB_SIMD_F32, GENERIC_OB_SIMD_SPARSE_F32};
+            break;
+        case DType::FLOAT64:
+            if (num_dims == 1) result = {TEMPORAL_1D_SIMD_F64_XOR_SHUFFLE, TEMPORAL_1D_CHIMP_F64};
+            if (num_dims == 2) result = {TEMPORAL_2D_SIMD_F64};
+            break;
+        case DType::INT64:
+            if (num_dims == 1) result = {TEMPORAL_1D_SIMD_I64_DELTA, TEMPORAL_1D_SIMD_I64_DOUBLE_DELTA, TEMPORAL_1D_SIMD_I64_XOR};
+            if (num_dims == 2) result = {TEMPORAL_2D_SIMD_I64_DELTA_SHUFFLE, TEMPORAL_2D_SIMD_I64_DOUBLE_DELTA, TEMPORAL_2D_SIMD_I64};
+            break;
+        default:
+            break;
+    }
+    result.push_back(ZSTD_COMPRESSED);
+    return result;
+}
+
+std::expected<SampleStats, CodecError> CodecAdvisor::analyze(std::span<const std::byte> sample, const DType dtype, std::span<const int64_t> shape) {
+    if (shape.empty()) return std::unexpected(CodecError{ErrorCode::InvalidChunkShape, "Sample shape cannot be empty."});
+    size_t num_elements = 1;
+    for (const auto dim : shape) {
+        if (dim < 0) return std::unexpected(CodecError{ErrorCode::InvalidChunkShape, "Shape dimensions cannot be negative."});
+        num_elements *= static_cast<size_t>(dim);
+    }
+    SampleStats stats;
+    stats.num_elements = num_elements;
+    stats.element_size = get_dtype_size(dtype);
+    if (stats.element_size == 0) return std::unexpected(CodecError{ErrorCode::InvalidDataType, "Sample dtype has no fixed element size."});
+    if (sample.size() != num_elements * stats.element_size) {
+        return std::unexpected(CodecError{ErrorCode::InvalidDataSize, std::format("Sample size {} does not match the shape ({} bytes).", sample.size(), num_elements * stats.element_size)});
+    }
+    if (num_elements == 0) return std::unexpected(CodecError{ErrorCode::InvalidDataSize, "Sample is empty."});
+
+    PlaneHistograms raw(1, std::array<uint64_t, 256>{});
+    for (const std::byte b : sample) ++raw[0][std::to_integer<uint8_t>(b)];
+    stats.raw_entropy_bits = entropy_bits(raw[0]);
+
+    // Residuals follow the codecs: 2D samples are SoA columns, orderbook snapshots are compared level by level.
+    const auto num_rows = static_cast<size_t>(shape[0]);
+    const size_t num_segments = shape.size() == 2 ? static_cast<size_t>(shape[1]) : 1;
+    const size_t segment_length = shape.size() == 2 ? num_rows : num_elements;
+    const size_t lag = shape.size() == 3 ? num_elements / std::max<size_t>(num_rows, 1) : 1;
+    if (dtype == DType::FLOAT32) {
+        memory::vector<uint32_t> words(num_elements);
+        std::memcpy(words.data(), sample.data(), sample.size());
+        accumulate_residuals(stats, words.data(), num_segments, segment_length, lag, false);
+    } else if (dtype == DType::FLOAT64 || dtype == DType::INT64) {
+        memory::vector<uint64_t> words(num_elements);
+        std::memcpy(words.data(), sample.data(), sample.size());
+        accumulate_residuals(stats, words.data(), num_segments, segment_length, lag, dtype == DType::INT64);
+    }
+    return stats;
+}
+
+std::expected<std::vector<CodecRecommendation>, CodecError> CodecAdvisor::advise(
+    std::span<const std::byte> sample, const DType dtype, std::span<const int64_t> shape, const AdviseOptions& options) const {
+    auto stats = analyze(sample, dtype, shape);
+    if (!stats) return std::unexpected(stats.error());
+    return advise(sample, dtype, shape, *stats, options);
+}
+
+std::expected<std::vector<CodecRecommendation>, CodecError> CodecAdvisor::advise(
+    std::span<const std::byte> sample, const DType dtype, std::span<const int64_t> shape, const SampleStats& stats,
+    const AdviseOptions& options) const {
+    if (shape.empty() || shape[0] <= 0 || stats.num_elements * stats.element_size != sample.size()) {
+        return std::unexpected(CodecError{ErrorCode::InvalidDataSize, "Sample statistics do not describe this sample."});
+    }
+    if (options.trial_compress && options.trial_rows == 0) {
+        return std::unexpected(CodecError{ErrorCode::InvalidDataSize, "trial_rows must be positive."});
+    }
+
+    // The trial slice: the first rows of the sample, gathered out of the SoA columns for 2D data.
+    const auto num_rows = static_cast<size_t>(shape[0]);
+    const chunk_frames::RowGeometry geometry{num_rows, stats.num_elements / num_rows, stats.element_size, shape.size() == 2, dtype};
+    const size_t trial_rows = std::min(options.trial_rows, num_rows);
+    memory::vector<int64_t> trial_shape(shape.begin(), shape.end());
+    trial_shape[0] = static_cast<int64_t>(trial_rows);
+    memory::vector<std::byte> trial_data;
+    memory::vector<std::byte> zero_state(geometry.row_bytes());
+    if (options.trial_compress) {
+        trial_data.resize(trial_rows * geometry.row_bytes());
+        chunk_frames::gather_rows(geometry, sample.data(), 0, trial_rows, trial_data.data());
+    }
+
+    const double element_bits = static_cast<double>(stats.element_size) * 8.0;
+    std::vector<CodecRecommendation> ranked;
+    for (const auto codec : candidates(dtype, shape.size())) {
+        CodecRecommendation recommendation{codec};
+        if (!options.trial_compress) {
+            const double bits = estimated_bits(codec, stats);
+            if (std::isnan(bits)) continue;
+            recommendation.estimated_ratio = element_bits / std::max(bits, element_bits / kMaxEstimatedRatio);
+            recommendation.estimated_throughput_mbps = nominal_throughput_mbps(codec);
+            ranked.push_back(recommendation);
+            continue;
+        }
+
+        const auto compress = [&] {
+            return codec == ChunkDataType::ZSTD_COMPRESSED
+                       ? compressor_.compress_zstd(trial_data, trial_shape, dtype, options.trial_level)
+                       : compressor_.compress_chunk_frames(trial_data, codec, trial_shape, zero_state, 1, options.trial_level);
+        };
+        // The first run builds this thread's codecs and zstd contexts; only the second is timed.
+        auto chunk = compress();
+        if (!chunk) return std::unexpected(chunk.error());
+        const auto start = std::chrono::steady_clock::now();
+        chunk = compress();
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        if (!chunk) return std::unexpected(chunk.error());
+        // A codec that rejected the slice and fell back to another one is not a candidate.
+        if ((*chunk)->type() != codec) continue;
+
+        recommendation.measured = true;
+        recommendation.estimated_ratio = static_cast<double>(trial_data.size()) / static_cast<double>(std::max<size_t>((*chunk)->data().size(), 1));
+        recommendation.estimated_throughput_mbps = static_cast<double>(trial_data.size()) / std::max(elapsed.count(), 1e-9) / 1e6;
+        ranked.push_back(recommendation);
+    }
+
+    std::ranges::stable_sort(ranked, [](const CodecRecommendation& a, const CodecRecommendation& b) {
+        if (a.estimated_ratio != b.estimated_ratio) return a.estimated_ratio > b.estimated_ratio;
+        return a.estimated_throughput_mbps > b.estimated_throughput_mbps;
+    });
+    return ranked;
+}
+
+} // namespace cryptodd
+#endif // HWY_ONCE
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "../file_format/cdd_file_format.h" // For ChunkDataType, DType
+#include "codec_error.h"
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <vector>
+
+/**
+ * @file codec_advisor.h
+ * @brief Ranks the lossless chunk types for a sample of data, without writing it anywhere.
+ *
+ * The advisor first computes cheap statistics over the sample, using the same residuals the codecs would see
+ * (each element against the previous row, as in the XOR and delta codecs):
+ * - the mean number of significant bits left after XOR, and after delta + zigzag (integers only),
+ * - the order-0 entropy of every byte plane of those residuals, which is what zstd sees after a byte shuffle,
+ * - the share of elements bitwise equal to their previous row (the sparse orderbook codec's density).
+ *
+ * From these it estimates, per candidate chunk type, the encoded bits per element and thus a compression ratio.
+ * Entropy estimates ignore the container and zstd frame overhead, and zstd can beat order-0 entropy on repetitive
+ * data, so they rank candidates well but are only indicative in absolute terms. Optionally each candidate is also
+ * trial-compressed on a slice of the sample at a low zstd level; the ratio and throughput then come from that run.
+ *
+ * Only lossless, parameter-free chunk types are candidates: the f16 and block-floating-point codecs lose precision,
+ * and the fixed-point and quantized codecs need tick sizes or error bounds only the caller knows.
+ */
+namespace cryptodd
+{
+
+class DataCompressor;
+
+namespace simd
+{
+    // Over num_elements pairs, adds to sums[0] the significant bits of cur[i] ^ prev[i], to sums[1] those of
+    // zigzag(cur[i] - prev[i]) and to sums[2] the number of pairs that are bitwise equal.
+    void ResidualBitStats32_dispatcher(const uint32_t* cur, const uint32_t* prev, size_t num_elements, uint64_t* sums);
+    void ResidualBitStats64_dispatcher(const uint64_t* cur, const uint64_t* prev, size_t num_elements, uint64_t* sums);
+}
+
+/** @brief Statistics of a sample, over the residuals of each element against its previous row. */
+struct SampleStats
+{
+    size_t num_elements = 0;
+    size_t element_size = 0;
+    double xor_significant_bits = 0.0;       // mean bits left after XOR with the previous row
+    double delta_significant_bits = 0.0;     // mean bits of zigzag(delta); integers only
+    double unchanged_fraction = 0.0;         // share of elements bitwise equal to their previous row
+    double raw_entropy_bits = 0.0;           // order-0 entropy of the raw bytes, in bits per byte
+    std::vector<double> xor_plane_entropy;   // bits per byte of each byte plane of the XOR residuals
+    std::vector<double> delta_plane_entropy; // same for zigzag(delta) residuals; integers only
+    std::vector<double> double_delta_plane_entropy; // same for zigzag(delta of delta) residuals; integers only
+    std::vector<double> changed_plane_entropy; // XOR residual planes of the changed elements only
+};
+
+/** @brief One ranked candidate. */
+struct CodecRecommendation
+{
+    ChunkDataType codec = ChunkDataType::RAW;
+    double estimated_ratio = 1.0;           // original / encoded bytes
+    double estimated_throughput_mbps = 0.0; // encode throughput on one core, MB/s
+    bool measured = false;                  // true when both figures come from trial compression
+};
+
+struct AdviseOptions
+{
+    bool trial_compress = false; // also compress a slice of the sample with every candidate
+    size_t trial_rows = 4096;    // rows of that slice (first dimension)
+    int trial_level = 1;         // zstd level of the trial
+};
+
+class CodecAdvisor
+{
+public:
+    explicit CodecAdvisor(const DataCompressor& compressor) : compressor_(compressor) {}
+
+    /** @brief The lossless chunk types worth trying for this dtype and number of dimensions, ZSTD_COMPRESSED last. */
+    [[nodiscard]] static std::vector<ChunkDataType> candidates(DType dtype, size_t num_dims);
+
+    /**
+     * @brief Computes the statistics of a sample laid out as for DataCompressor (1D series, Temporal 2D SoA
+     * columns, or row-major orderbook snapshots).
+     */
+    [[nodiscard]] static std::expected<SampleStats, CodecError> analyze(std::span<const std::byte> sample, DType dtype, std::span<const int64_t> shape);
+
+    /** @brief Ranks the candidates for the sample by estimated ratio, best first; ties go to the faster codec. */
+    [[nodiscard]] std::expected<std::vector<CodecRecommendation>, CodecError> advise(
+        std::span<const std::byte> sample, DType dtype, std::span<const int64_t> shape, const AdviseOptions& options = {}) const;
+
+    /** @brief As above, reusing `stats` computed by analyze() for this same sample, dtype and shape. */
+    [[nodiscard]] std::expected<std::vector<CodecRecommendation>, CodecError> advise(
+        std::span<const std::byte> sample, DType dtype, std::span<const int64_t> shape, const SampleStats& stats,
+        const AdviseOptions& options = {}) const;
+
+private:
+    const DataCompressor& compressor_;
+};
+
+} // namespace cryptodd
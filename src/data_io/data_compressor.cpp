@@ -1,22 +1,38 @@
 #include "data_compressor.h"
 
+#include "../codecs/chimp_codec.h"
+#include "../codecs/fixed_point_simd_codec.h"
+#include "../codecs/orderbook_bfp16_codec.h"
 #include "../codecs/orderbook_simd_codec.h"
+#include "../codecs/orderbook_sparse_codec.h"
 #include "../codecs/temporal_1d_simd_codec.h"
 #include "../codecs/temporal_2d_simd_codec.h"
 #include "../codecs/zstd_compressor.h"
 #include "../codecs/codec_constants.h" // For codecs::Orderbook::OKX_DEPTH, etc.
+#include "../memory/per_thread.h"
+#include "chunk_frames.h"
+#include "thread_pool.h"
+#include <algorithm>
 #include <bit> // For std::endian
+#include <chrono>
+#include <cstring>
 
 #include <map>
-#include <mutex>
 #include <format>
+#include <numeric>
+#include <optional>
 #include <stdexcept>
 #include <tuple>
+#include <type_traits>
 
 namespace cryptodd
 {
 
 namespace {
+    // Byte-shuffle codecs write per-block byte planes so readers can stream-decompress and unshuffle
+    // block by block. Chunks are tagged with ChunkFlags::BLOCKED_SHUFFLE so the layout travels with them.
+    constexpr auto kShuffleLayout = codecs::ShuffleLayout::Blocked;
+
     // Helper to create a chunk and handle potential errors from encoding.
     DataCompressor::ChunkResult create_chunk_from_result(
         std::expected<memory::vector<std::byte>, std::string>&& result,
@@ -45,107 +61,395 @@ namespace {
         chunk->set_flags(flags);
         return chunk;
     }
-}
 
-struct DataCompressor::Impl
-{
-    // --- Reusable Workspaces ---
-    // These are protected by mutexes to allow a single DataCompressor instance to be
-    // shared safely between threads. For maximum performance, create one DataCompressor
-    // instance per thread to avoid contention on these locks.
-    mutable OrderbookSimdCodecWorkspace ob_workspace_;
-    mutable std::mutex ob_workspace_mutex_;
-    mutable Temporal1dSimdCodecWorkspace temporal_1d_workspace_;
-    mutable std::mutex temporal_1d_workspace_mutex_;
-    mutable Temporal2dSimdCodecWorkspace temporal_2d_workspace_;
-    mutable std::mutex temporal_2d_workspace_mutex_;
-
-
-    // --- Codec Caching ---
-    // Caches are used to avoid the overhead of recreating codec and compressor
-    // instances if the same configuration (level) is used repeatedly.
-    // The maps are protected by mutexes for thread-safe access.
-
-    // Key: <depth, features, level>
-    using ObCodecKey = std::tuple<size_t, size_t, int>;
-    mutable std::map<ObCodecKey, DynamicOrderbookSimdCodec> ob_codecs_cache_;
-    mutable std::mutex ob_cache_mutex_;
-
-    // Key: <level>
-    mutable std::map<int, Temporal1dSimdCodec> t1d_codecs_cache_;
-    mutable std::mutex t1d_cache_mutex_;
-
-    // Key: <num_features, level>
-    using T2dCodecKey = std::tuple<size_t, int>;
-    mutable std::map<T2dCodecKey, DynamicTemporal2dSimdCodec> t2d_codecs_cache_;
-    mutable std::mutex t2d_cache_mutex_;
-
-    // Key: <level>
-    mutable std::map<int, OkxObSimdCodec> okx_ob_codecs_cache_;
-    mutable std::mutex okx_ob_cache_mutex_;
-
-    // Key: <level>
-    mutable std::map<int, BinanceObSimdCodec> binance_ob_codecs_cache_;
-    mutable std::mutex binance_ob_cache_mutex_;
-    
-    // --- Cache Accessor Methods ---
+    template <typename T>
+    std::span<const T> as_span_of(std::span<const std::byte> bytes)
+    {
+        return {reinterpret_cast<const T*>(bytes.data()), bytes.size() / sizeof(T)};
+    }
 
-    [[nodiscard]] DynamicOrderbookSimdCodec& get_ob_codec(size_t depth, size_t features, int level) const
+    // Encodes one frame (or a whole chunk) through the typed overload matching `type`.
+    DataCompressor::ChunkResult compress_frame(const DataCompressor& compressor, const ChunkDataType type,
+                                               std::span<const int64_t> shape, std::span<const std::byte> data,
+                                               std::span<const std::byte> prev_state, const int level,
+                                               std::span<const double> tick_sizes, std::span<const double> error_bounds,
+                                               const bool relative_error_bound)
     {
-        const ObCodecKey key = {depth, features, level};
-        std::lock_guard lock(ob_cache_mutex_);
-        
-        auto it = ob_codecs_cache_.find(key);
-        if (it == ob_codecs_cache_.end()) {
-            it = ob_codecs_cache_.try_emplace(key, depth, features, std::make_unique<ZstdCompressor>(level)).first;
+        switch (type)
+        {
+        case ChunkDataType::TEMPORAL_1D_QUANTIZED_F32:
+        case ChunkDataType::TEMPORAL_2D_QUANTIZED_F32:
+            return compressor.compress_quantized(as_span_of<float>(data), type, shape, error_bounds, relative_error_bound, as_span_of<float>(prev_state), level);
+        case ChunkDataType::TEMPORAL_1D_QUANTIZED_F64:
+        case ChunkDataType::TEMPORAL_2D_QUANTIZED_F64:
+            return compressor.compress_quantized(as_span_of<double>(data), type, shape, error_bounds, relative_error_bound, as_span_of<double>(prev_state), level);
+        case ChunkDataType::TEMPORAL_1D_FIXED_POINT_F32:
+        case ChunkDataType::TEMPORAL_2D_FIXED_POINT_F32:
+        case ChunkDataType::ORDERBOOK_FIXED_POINT_F32:
+            return compressor.compress_fixed_point(as_span_of<float>(data), type, shape, tick_sizes, as_span_of<float>(prev_state), level);
+        case ChunkDataType::TEMPORAL_1D_FIXED_POINT_F64:
+        case ChunkDataType::TEMPORAL_2D_FIXED_POINT_F64:
+            return compressor.compress_fixed_point(as_span_of<double>(data), type, shape, tick_sizes, as_span_of<double>(prev_state), level);
+        case ChunkDataType::TEMPORAL_1D_SIMD_F16_XOR_SHUFFLE_AS_F32:
+        case ChunkDataType::TEMPORAL_1D_SIMD_F32_XOR_SHUFFLE:
+        case ChunkDataType::TEMPORAL_1D_CHIMP_F32:
+            return compressor.compress_chunk(as_span_of<float>(data), type, as_span_of<float>(prev_state)[0], level);
+        case ChunkDataType::TEMPORAL_1D_CHIMP_F64:
+        case ChunkDataType::TEMPORAL_1D_SIMD_F64_XOR_SHUFFLE:
+            return compressor.compress_chunk(as_span_of<double>(data), type, as_span_of<double>(prev_state)[0], level);
+        case ChunkDataType::TEMPORAL_1D_SIMD_I64_XOR:
+        case ChunkDataType::TEMPORAL_1D_SIMD_I64_DELTA:
+        case ChunkDataType::TEMPORAL_1D_SIMD_I64_DELTA_BITPACK:
+        case ChunkDataType::TEMPORAL_1D_SIMD_I64_DELTA_BITPACK_ZSTD:
+        case ChunkDataType::TEMPORAL_1D_SIMD_I64_DOUBLE_DELTA:
+            return compressor.compress_chunk(as_span_of<int64_t>(data), type, as_span_of<int64_t>(prev_state)[0], level);
+        case ChunkDataType::TEMPORAL_2D_SIMD_F64:
+            return compressor.compress_chunk(as_span_of<double>(data), type, shape, as_span_of<double>(prev_state), level);
+        case ChunkDataType::TEMPORAL_2D_SIMD_I64:
+        case ChunkDataType::TEMPORAL_2D_SIMD_I64_DOUBLE_DELTA:
+        case ChunkDataType::TEMPORAL_2D_SIMD_I64_DELTA:
+        case ChunkDataType::TEMPORAL_2D_SIMD_I64_DELTA_SHUFFLE:
+            return compressor.compress_chunk(as_span_of<int64_t>(data), type, shape, as_span_of<int64_t>(prev_state), level);
+        default:
+            return compressor.compress_chunk(as_span_of<float>(data), type, shape, as_span_of<float>(prev_state), level);
+        }
+    }
+
+    // Turns the rows stored as frame states into what the decoder of the previous frame holds, so a lossy chunk
+    // never stores more precision than its data: f16 codecs keep the rows rounded through f16. BFP16 and
+    // error-bounded chunks carry no state from row to row, so their states are zeroed instead.
+    void round_trip_states(const ChunkDataType type, std::span<std::byte> states)
+    {
+        switch (type)
+        {
+        case ChunkDataType::TEMPORAL_1D_SIMD_F16_XOR_SHUFFLE_AS_F32:
+        case ChunkDataType::OKX_OB_SIMD_F16_AS_F32:
+        case ChunkDataType::BINANCE_OB_SIMD_F16_AS_F32:
+        case ChunkDataType::GENERIC_OB_SIMD_F16_AS_F32:
+        case ChunkDataType::TEMPORAL_2D_SIMD_F16_AS_F32:
+            for (size_t offset = 0; offset + sizeof(float) <= states.size(); offset += sizeof(float)) {
+                float value;
+                std::memcpy(&value, states.data() + offset, sizeof(float));
+                value = hwy::ConvertScalarTo<float>(hwy::ConvertScalarTo<hwy::float16_t>(value));
+                std::memcpy(states.data() + offset, &value, sizeof(float));
+            }
+            break;
+        case ChunkDataType::GENERIC_OB_SIMD_BFP16_AS_F32:
+        case ChunkDataType::TEMPORAL_1D_QUANTIZED_F32:
+        case ChunkDataType::TEMPORAL_1D_QUANTIZED_F64:
+        case ChunkDataType::TEMPORAL_2D_QUANTIZED_F32:
+        case ChunkDataType::TEMPORAL_2D_QUANTIZED_F64:
+            std::ranges::fill(states, std::byte{0});
+            break;
+        default:
+            break;
         }
-        return it->second;
     }
 
-    [[nodiscard]] OkxObSimdCodec& get_okx_ob_codec(int level) const
+    // Encodes a chunk the fixed-point or quantized codec rejected with the float codec `fallback`.
+    template <typename T>
+    DataCompressor::ChunkResult compress_float_fallback(const DataCompressor& compressor, std::span<const T> data, const ChunkDataType fallback,
+                                                        std::span<const int64_t> shape, const size_t row_elements, std::span<const T> prev_state,
+                                                        const int level)
     {
-        std::lock_guard lock(okx_ob_cache_mutex_);
+        memory::vector<T> state(row_elements, T{0});
+        if (!prev_state.empty()) {
+            if (prev_state.size() != state.size()) {
+                return std::unexpected(CodecError{ErrorCode::InvalidStateSize, std::format("Previous state size mismatch. Expected {}, got {}.", state.size(), prev_state.size())});
+            }
+            std::ranges::copy(prev_state, state.begin());
+        }
+        if (shape.size() == 1) {
+            return compressor.compress_chunk(data, fallback, state[0], level);
+        }
+        return compressor.compress_chunk(data, fallback, shape, std::span<const T>(state), level);
+    }
 
-        auto it = okx_ob_codecs_cache_.find(level);
-        if (it == okx_ob_codecs_cache_.end()) {
-            it = okx_ob_codecs_cache_.try_emplace(level, std::make_unique<ZstdCompressor>(level)).first;
+    struct FixedPointPlan
+    {
+        FixedPointLayout layout = FixedPointLayout::Columns;
+        size_t num_rows = 0;
+        ChunkDataType fallback = ChunkDataType::RAW;
+        memory::vector<double> scales;
+    };
+
+    // Checks `shape` against a fixed-point chunk type and turns the tick sizes into one scale per column
+    // (1D and Temporal 2D) or per feature (orderbook). A single tick size applies to all of them.
+    std::expected<FixedPointPlan, CodecError> plan_fixed_point(const ChunkDataType type, std::span<const int64_t> shape, std::span<const double> tick_sizes)
+    {
+        for (const auto dim : shape) {
+            if (dim < 0) {
+                return std::unexpected(CodecError{ErrorCode::InvalidChunkShape, "Shape dimensions cannot be negative."});
+            }
         }
-        return it->second;
+
+        FixedPointPlan plan;
+        size_t num_scales = 1;
+        switch (type) {
+            case ChunkDataType::TEMPORAL_1D_FIXED_POINT_F32:
+            case ChunkDataType::TEMPORAL_1D_FIXED_POINT_F64:
+                if (shape.size() != 1) return std::unexpected(CodecError{ErrorCode::InvalidChunkShape, "Temporal 1D data requires a 1D shape."});
+                plan.fallback = type == ChunkDataType::TEMPORAL_1D_FIXED_POINT_F32 ? ChunkDataType::TEMPORAL_1D_SIMD_F32_XOR_SHUFFLE : ChunkDataType::TEMPORAL_1D_SIMD_F64_XOR_SHUFFLE;
+                break;
+            case ChunkDataType::TEMPORAL_2D_FIXED_POINT_F32:
+            case ChunkDataType::TEMPORAL_2D_FIXED_POINT_F64:
+                if (shape.size() != 2) return std::unexpected(CodecError{ErrorCode::InvalidChunkShape, "Temporal 2D data requires a 2D shape."});
+                num_scales = static_cast<size_t>(shape[1]);
+                plan.fallback = type == ChunkDataType::TEMPORAL_2D_FIXED_POINT_F32 ? ChunkDataType::TEMPORAL_2D_SIMD_F32 : ChunkDataType::TEMPORAL_2D_SIMD_F64;
+                break;
+            case ChunkDataType::ORDERBOOK_FIXED_POINT_F32:
+                if (shape.size() != 3) return std::unexpected(CodecError{ErrorCode::InvalidChunkShape, "Orderbook data requires a 3D shape."});
+                num_scales = static_cast<size_t>(shape[2]);
+                plan.layout = FixedPointLayout::Rows;
+                plan.fallback = ChunkDataType::GENERIC_OB_SIMD_F32;
+                break;
+            default:
+                return std::unexpected(CodecError{ErrorCode::InvalidDataType, "Unsupported or mismatched chunk type for fixed-point data."});
+        }
+        plan.num_rows = static_cast<size_t>(shape[0]);
+
+        if (tick_sizes.size() != 1 && tick_sizes.size() != num_scales) {
+            return std::unexpected(CodecError{ErrorCode::EncodingFailure, std::format("Expected 1 or {} tick sizes, got {}.", num_scales, tick_sizes.size())});
+        }
+        plan.scales.resize(num_scales);
+        for (size_t i = 0; i < num_scales; ++i) {
+            auto scale = FixedPointSimdCodec::scale_for_tick(tick_sizes[tick_sizes.size() == 1 ? 0 : i]);
+            if (!scale) return std::unexpected(CodecError{ErrorCode::EncodingFailure, scale.error()});
+            plan.scales[i] = *scale;
+        }
+        return plan;
     }
 
-    [[nodiscard]] BinanceObSimdCodec& get_binance_ob_codec(int level) const
+    template <typename T>
+    DataCompressor::ChunkResult compress_fixed_point_chunk(const DataCompressor& compressor, const FixedPointSimdCodec& codec,
+                                                           FixedPointSimdCodecWorkspace& workspace, std::span<const T> data,
+                                                           const ChunkDataType type, std::span<const int64_t> shape,
+                                                           std::span<const double> tick_sizes, std::span<const T> prev_state, const int level)
     {
-        std::lock_guard lock(binance_ob_cache_mutex_);
+        auto plan = plan_fixed_point(type, shape, tick_sizes);
+        if (!plan) return std::unexpected(plan.error());
+        const auto geometry = chunk_frames::row_geometry(type, shape);
+        if (!geometry) return std::unexpected(CodecError::from_string(geometry.error(), ErrorCode::InvalidChunkShape));
+        if (data.size() * sizeof(T) != geometry->total_bytes()) {
+            return std::unexpected(CodecError{ErrorCode::InvalidDataSize, std::format("Data size {} does not match the chunk shape ({} elements).", data.size(), geometry->total_bytes() / sizeof(T))});
+        }
 
-        auto it = binance_ob_codecs_cache_.find(level);
-        if (it == binance_ob_codecs_cache_.end()) {
-            it = binance_ob_codecs_cache_.try_emplace(level, std::make_unique<ZstdCompressor>(level)).first;
+        FixedPointSimdCodec::EncodeResult encoded;
+        if constexpr (std::is_same_v<T, float>) {
+            encoded = codec.encode32(data, plan->layout, plan->num_rows, plan->scales, workspace);
+        } else {
+            encoded = codec.encode64(data, plan->layout, plan->num_rows, plan->scales, workspace);
+        }
+        if (!encoded) return std::unexpected(CodecError::from_string(encoded.error(), ErrorCode::EncodingFailure));
+        if (*encoded) {
+            return create_chunk_from_result(std::move(**encoded), type, geometry->dtype, shape, ChunkFlags::NONE);
         }
-        return it->second;
+
+        // Some value is off the tick grid: store the chunk with the float codec it would otherwise have used.
+        return compress_float_fallback(compressor, data, plan->fallback, shape, geometry->row_elements, prev_state, level);
     }
 
-    [[nodiscard]] Temporal1dSimdCodec& get_t1d_codec(int level) const
+    // Checks `shape` against a quantized chunk type and expands the error bounds to one per column.
+    std::expected<FixedPointPlan, CodecError> plan_quantized(const ChunkDataType type, std::span<const int64_t> shape, std::span<const double> error_bounds)
     {
-        std::lock_guard lock(t1d_cache_mutex_);
+        for (const auto dim : shape) {
+            if (dim < 0) {
+                return std::unexpected(CodecError{ErrorCode::InvalidChunkShape, "Shape dimensions cannot be negative."});
+            }
+        }
+
+        FixedPointPlan plan;
+        size_t num_columns = 1;
+        switch (type) {
+            case ChunkDataType::TEMPORAL_1D_QUANTIZED_F32:
+            case ChunkDataType::TEMPORAL_1D_QUANTIZED_F64:
+                if (shape.size() != 1) return std::unexpected(CodecError{ErrorCode::InvalidChunkShape, "Temporal 1D data requires a 1D shape."});
+                plan.fallback = type == ChunkDataType::TEMPORAL_1D_QUANTIZED_F32 ? ChunkDataType::TEMPORAL_1D_SIMD_F32_XOR_SHUFFLE : ChunkDataType::TEMPORAL_1D_SIMD_F64_XOR_SHUFFLE;
+                break;
+            case ChunkDataType::TEMPORAL_2D_QUANTIZED_F32:
+            case ChunkDataType::TEMPORAL_2D_QUANTIZED_F64:
+                if (shape.size() != 2) return std::unexpected(CodecError{ErrorCode::InvalidChunkShape, "Temporal 2D data requires a 2D shape."});
+                num_columns = static_cast<size_t>(shape[1]);
+                plan.fallback = type == ChunkDataType::TEMPORAL_2D_QUANTIZED_F32 ? ChunkDataType::TEMPORAL_2D_SIMD_F32 : ChunkDataType::TEMPORAL_2D_SIMD_F64;
+                break;
+            default:
+                return std::unexpected(CodecError{ErrorCode::InvalidDataType, "Unsupported or mismatched chunk type for quantized data."});
+        }
+        plan.num_rows = static_cast<size_t>(shape[0]);
 
-        auto it = t1d_codecs_cache_.find(level);
-        if (it == t1d_codecs_cache_.end()) {
-            it = t1d_codecs_cache_.try_emplace(level, std::make_unique<ZstdCompressor>(level)).first;
+        if (error_bounds.size() != 1 && error_bounds.size() != num_columns) {
+            return std::unexpected(CodecError{ErrorCode::EncodingFailure, std::format("Expected 1 or {} error bounds, got {}.", num_columns, error_bounds.size())});
         }
-        return it->second;
+        // `scales` carries the bounds here: the codec derives each column's grid from them and validates them.
+        plan.scales.resize(num_columns);
+        for (size_t i = 0; i < num_columns; ++i) plan.scales[i] = error_bounds[error_bounds.size() == 1 ? 0 : i];
+        return plan;
     }
 
-    [[nodiscard]] DynamicTemporal2dSimdCodec& get_t2d_codec(size_t num_features, int level) const
+    template <typename T>
+    DataCompressor::ChunkResult compress_quantized_chunk(const DataCompressor& compressor, const FixedPointSimdCodec& codec,
+                                                         FixedPointSimdCodecWorkspace& workspace, std::span<const T> data,
+                                                         const ChunkDataType type, std::span<const int64_t> shape,
+                                                         std::span<const double> error_bounds, const bool relative,
+                                                         std::span<const T> prev_state, const int level)
     {
-        const T2dCodecKey key = {num_features, level};
-        std::lock_guard lock(t2d_cache_mutex_);
+        auto plan = plan_quantized(type, shape, error_bounds);
+        if (!plan) return std::unexpected(plan.error());
+        const auto geometry = chunk_frames::row_geometry(type, shape);
+        if (!geometry) return std::unexpected(CodecError::from_string(geometry.error(), ErrorCode::InvalidChunkShape));
+        if (data.size() * sizeof(T) != geometry->total_bytes()) {
+            return std::unexpected(CodecError{ErrorCode::InvalidDataSize, std::format("Data size {} does not match the chunk shape ({} elements).", data.size(), geometry->total_bytes() / sizeof(T))});
+        }
 
-        auto it = t2d_codecs_cache_.find(key);
-        if (it == t2d_codecs_cache_.end()) {
-            it = t2d_codecs_cache_.try_emplace(key, num_features, std::make_unique<ZstdCompressor>(level)).first;
+        FixedPointSimdCodec::BoundedEncodeResult encoded;
+        if constexpr (std::is_same_v<T, float>) {
+            encoded = codec.encode_bounded32(data, plan->num_rows, plan->scales, relative, workspace);
+        } else {
+            encoded = codec.encode_bounded64(data, plan->num_rows, plan->scales, relative, workspace);
+        }
+        if (!encoded) return std::unexpected(CodecError::from_string(encoded.error(), ErrorCode::EncodingFailure));
+        if (*encoded) {
+            const ChunkFlags flags = (*encoded)->exact ? ChunkFlags::NONE : ChunkFlags::RECONSTRUCTION_NOT_PERFECT | ChunkFlags::RECONSTRUCTION_BOUNDED;
+            return create_chunk_from_result(std::move((*encoded)->payload), type, geometry->dtype, shape, flags);
         }
-        return it->second;
+
+        // Some column cannot be quantized: store the chunk losslessly with the float codec.
+        return compress_float_fallback(compressor, data, plan->fallback, shape, geometry->row_elements, prev_state, level);
     }
+}
+
+struct DataCompressor::Impl
+{
+    // --- Per-Thread Codec Bundle ---
+    // Every thread that uses this DataCompressor gets its own workspaces and codec caches.
+    // Codecs own a stateful ZstdCompressor (CCtx), so they cannot be shared between threads
+    // either. Once a thread has built its bundle, lookups take no lock at all, which lets a
+    // single shared instance scale with the number of threads.
+    struct CodecBundle
+    {
+        // --- Reusable Workspaces ---
+        OrderbookSimdCodecWorkspace ob_workspace;
+        Temporal1dSimdCodecWorkspace temporal_1d_workspace;
+        Temporal2dSimdCodecWorkspace temporal_2d_workspace;
+        ChimpCodecWorkspace chimp_workspace;
+        FixedPointSimdCodecWorkspace fixed_point_workspace;
+        OrderbookBfp16CodecWorkspace bfp16_ob_workspace;
+        OrderbookSparseCodecWorkspace sparse_ob_workspace;
+
+        // Chimp has no zstd stage, so a single codec serves every level.
+        ChimpCodec chimp_codec;
+
+        // --- Codec Caching ---
+        // Caches are used to avoid the overhead of recreating codec and compressor
+        // instances if the same configuration (level) is used repeatedly.
+
+        // Key: <depth, features, level>
+        using ObCodecKey = std::tuple<size_t, size_t, int>;
+        std::map<ObCodecKey, DynamicOrderbookSimdCodec> ob_codecs_cache;
+
+        // Key: <level>
+        std::map<int, Temporal1dSimdCodec> t1d_codecs_cache;
+
+        // Key: <num_features, level>
+        using T2dCodecKey = std::tuple<size_t, int>;
+        std::map<T2dCodecKey, DynamicTemporal2dSimdCodec> t2d_codecs_cache;
+
+        // Key: <level>
+        std::map<int, FixedPointSimdCodec> fixed_point_codecs_cache;
+
+        // Key: <level>
+        std::map<int, OrderbookBfp16Codec> bfp16_ob_codecs_cache;
+
+        // Key: <level>
+        std::map<int, OrderbookSparseCodec> sparse_ob_codecs_cache;
+
+        // Key: <level>
+        std::map<int, OkxObSimdCodec> okx_ob_codecs_cache;
+
+        // Key: <level>
+        std::map<int, BinanceObSimdCodec> binance_ob_codecs_cache;
+
+        // --- Cache Accessor Methods ---
+
+        [[nodiscard]] DynamicOrderbookSimdCodec& get_ob_codec(size_t depth, size_t features, int level)
+        {
+            const ObCodecKey key = {depth, features, level};
+            auto it = ob_codecs_cache.find(key);
+            if (it == ob_codecs_cache.end()) {
+                it = ob_codecs_cache.try_emplace(key, depth, features, std::make_unique<ZstdCompressor>(level)).first;
+            }
+            return it->second;
+        }
+
+        [[nodiscard]] OkxObSimdCodec& get_okx_ob_codec(int level)
+        {
+            auto it = okx_ob_codecs_cache.find(level);
+            if (it == okx_ob_codecs_cache.end()) {
+                it = okx_ob_codecs_cache.try_emplace(level, std::make_unique<ZstdCompressor>(level)).first;
+            }
+            return it->second;
+        }
+
+        [[nodiscard]] BinanceObSimdCodec& get_binance_ob_codec(int level)
+        {
+            auto it = binance_ob_codecs_cache.find(level);
+            if (it == binance_ob_codecs_cache.end()) {
+                it = binance_ob_codecs_cache.try_emplace(level, std::make_unique<ZstdCompressor>(level)).first;
+            }
+            return it->second;
+        }
+
+        [[nodiscard]] Temporal1dSimdCodec& get_t1d_codec(int level)
+        {
+            auto it = t1d_codecs_cache.find(level);
+            if (it == t1d_codecs_cache.end()) {
+                it = t1d_codecs_cache.try_emplace(level, std::make_unique<ZstdCompressor>(level)).first;
+            }
+            return it->second;
+        }
+
+        [[nodiscard]] FixedPointSimdCodec& get_fixed_point_codec(int level)
+        {
+            auto it = fixed_point_codecs_cache.find(level);
+            if (it == fixed_point_codecs_cache.end()) {
+                it = fixed_point_codecs_cache.try_emplace(level, std::make_unique<ZstdCompressor>(level)).first;
+            }
+            return it->second;
+        }
+
+        [[nodiscard]] OrderbookBfp16Codec& get_bfp16_ob_codec(int level)
+        {
+            auto it = bfp16_ob_codecs_cache.find(level);
+            if (it == bfp16_ob_codecs_cache.end()) {
+                it = bfp16_ob_codecs_cache.try_emplace(level, std::make_unique<ZstdCompressor>(level)).first;
+            }
+            return it->second;
+        }
+
+        [[nodiscard]] OrderbookSparseCodec& get_sparse_ob_codec(int level)
+        {
+            auto it = sparse_ob_codecs_cache.find(level);
+            if (it == sparse_ob_codecs_cache.end()) {
+                it = sparse_ob_codecs_cache.try_emplace(level, std::make_unique<ZstdCompressor>(level)).first;
+            }
+            return it->second;
+        }
+
+        [[nodiscard]] DynamicTemporal2dSimdCodec& get_t2d_codec(size_t num_features, int level)
+        {
+            const T2dCodecKey key = {num_features, level};
+            auto it = t2d_codecs_cache.find(key);
+            if (it == t2d_codecs_cache.end()) {
+                it = t2d_codecs_cache.try_emplace(key, num_features, std::make_unique<ZstdCompressor>(level)).first;
+            }
+            return it->second;
+        }
+    };
+
+    memory::PerThread<CodecBundle> bundles_;
+    ZstdLevelController level_controller_;
+
+    [[nodiscard]] CodecBundle& local() const { return bundles_.local(); }
 };
 
 
@@ -156,10 +460,40 @@ DataCompressor::~DataCompressor() = default;
 DataCompressor::DataCompressor(DataCompressor&&) noexcept = default;
 DataCompressor& DataCompressor::operator=(DataCompressor&&) noexcept = default;
 
+ZstdLevelController& DataCompressor::level_controller() const { return pimpl_->level_controller_; }
+
+template <typename Compress>
+DataCompressor::ChunkResult DataCompressor::compress_adaptive(const size_t raw_bytes, Compress&& compress) const
+{
+    auto& controller = pimpl_->level_controller_;
+    const int level = controller.level();
+    const auto start = std::chrono::steady_clock::now();
+    auto result = compress(level);
+    if (!result) return result;
+    controller.record(level, raw_bytes, std::chrono::steady_clock::now() - start);
+    (*result)->set_flags(with_zstd_level((*result)->flags(), level));
+    return result;
+}
+
 
 DataCompressor::ChunkResult DataCompressor::compress_zstd(
     std::span<const std::byte> data, std::span<const int64_t> shape, DType dtype, int level) const
 {
+    ZstdCompressor::Params params;
+    params.level = level;
+    return compress_zstd(data, shape, dtype, params);
+}
+
+DataCompressor::ChunkResult DataCompressor::compress_zstd(
+    std::span<const std::byte> data, std::span<const int64_t> shape, DType dtype, const ZstdCompressor::Params& params) const
+{
+    if (params.level == ADAPTIVE_LEVEL) {
+        return compress_adaptive(data.size_bytes(), [&](const int l) {
+            auto resolved = params;
+            resolved.level = l;
+            return compress_zstd(data, shape, dtype, resolved);
+        });
+    }
     for (const auto dim : shape) {
         if (dim < 0) {
             return std::unexpected(CodecError{ErrorCode::InvalidChunkShape, "Shape dimensions cannot be negative."});
@@ -167,17 +501,26 @@ DataCompressor::ChunkResult DataCompressor::compress_zstd(
     }
 
     // Zstd is simple and stateless enough to create on the stack without caching.
-    ZstdCompressor compressor(level);
-    auto compressed_result = compressor.compress(data);
+    std::optional<ZstdCompressor> compressor;
+    try {
+        compressor.emplace(params);
+    } catch (const std::invalid_argument& e) {
+        return std::unexpected(CodecError{ErrorCode::CompressionFailure, e.what()});
+    }
+    auto compressed_result = compressor->compress(data);
     if (!compressed_result) {
         return std::unexpected(CodecError::from_string(compressed_result.error(), ErrorCode::CompressionFailure));
     }
-    
+
+    ChunkFlags flags = ChunkFlags::ZSTD;
+    if (params.needs_long_window()) {
+        flags |= ChunkFlags::ZSTD_LONG_WINDOW;
+    }
     return create_chunk_from_result(std::move(*compressed_result),
                                     ChunkDataType::ZSTD_COMPRESSED,
                                     dtype,
                                     shape,
-                                    ChunkFlags::ZSTD);
+                                    flags);
 }
 
 // --- Temporal 1D ---
@@ -195,19 +538,26 @@ DataCompressor::ChunkResult DataCompressor::compress_chunk(
 }
 
 DataCompressor::ChunkResult DataCompressor::compress_chunk(
-    std::span<const float> data, ChunkDataType type, float prev_element, int level) const
+    std::span<const float> data, ChunkDataType type, float prev_element, int level, const codecs::BlockVisitor& on_raw_block) const
 {
-    auto& codec = pimpl_->get_t1d_codec(level);
-    std::lock_guard lock(pimpl_->temporal_1d_workspace_mutex_);
-    
+    if (level == ADAPTIVE_LEVEL) {
+        return compress_adaptive(data.size_bytes(), [&](const int l) { return compress_chunk(data, type, prev_element, l, on_raw_block); });
+    }
+    auto& bundle = pimpl_->local();
+
     std::expected<memory::vector<std::byte>, std::string> encoded_result;
+    ChunkFlags flags = ChunkFlags::BLOCKED_SHUFFLE;
 
     switch (type) {
         case ChunkDataType::TEMPORAL_1D_SIMD_F16_XOR_SHUFFLE_AS_F32:
-            encoded_result = codec.encode16_Xor_Shuffle(data, prev_element, pimpl_->temporal_1d_workspace_);
+            encoded_result = bundle.get_t1d_codec(level).encode16_Xor_Shuffle(data, prev_element, bundle.temporal_1d_workspace, kShuffleLayout, on_raw_block);
             break;
         case ChunkDataType::TEMPORAL_1D_SIMD_F32_XOR_SHUFFLE:
-            encoded_result = codec.encode32_Xor_Shuffle(data, prev_element, pimpl_->temporal_1d_workspace_);
+            encoded_result = bundle.get_t1d_codec(level).encode32_Xor_Shuffle(data, prev_element, bundle.temporal_1d_workspace, kShuffleLayout, on_raw_block);
+            break;
+        case ChunkDataType::TEMPORAL_1D_CHIMP_F32:
+            encoded_result = bundle.chimp_codec.encode32(data, prev_element, bundle.chimp_workspace);
+            flags = ChunkFlags::NONE;
             break;
         default:
             return std::unexpected(CodecError{ErrorCode::InvalidDataType, "Unsupported or mismatched chunk type for 1D float data."});
@@ -215,23 +565,68 @@ DataCompressor::ChunkResult DataCompressor::compress_chunk(
 
     const int64_t shape_val = static_cast<int64_t>(data.size());
     return create_chunk_from_result(std::move(encoded_result),
-        type, DType::FLOAT32, {&shape_val, 1}, ChunkFlags::NONE);
+        type, DType::FLOAT32, {&shape_val, 1}, flags);
+}
+
+DataCompressor::ChunkResult DataCompressor::compress_chunk(
+    std::span<const double> data, ChunkDataType type, int level) const
+{
+    return compress_chunk(data, type, 0.0, level);
+}
+
+DataCompressor::ChunkResult DataCompressor::compress_chunk(
+    std::span<const double> data, ChunkDataType type, double prev_element, int level, const codecs::BlockVisitor& on_raw_block) const
+{
+    if (level == ADAPTIVE_LEVEL) {
+        return compress_adaptive(data.size_bytes(), [&](const int l) { return compress_chunk(data, type, prev_element, l, on_raw_block); });
+    }
+    auto& bundle = pimpl_->local();
+
+    std::expected<memory::vector<std::byte>, std::string> encoded_result;
+    ChunkFlags flags = ChunkFlags::NONE;
+
+    switch (type) {
+        case ChunkDataType::TEMPORAL_1D_CHIMP_F64:
+            encoded_result = bundle.chimp_codec.encode64(data, prev_element, bundle.chimp_workspace);
+            break;
+        case ChunkDataType::TEMPORAL_1D_SIMD_F64_XOR_SHUFFLE:
+            encoded_result = bundle.get_t1d_codec(level).encode64_Xor_Shuffle(data, prev_element, bundle.temporal_1d_workspace, kShuffleLayout, on_raw_block);
+            flags = ChunkFlags::BLOCKED_SHUFFLE;
+            break;
+        default:
+            return std::unexpected(CodecError{ErrorCode::InvalidDataType, "Unsupported or mismatched chunk type for 1D double data."});
+    }
+
+    const int64_t shape_val = static_cast<int64_t>(data.size());
+    return create_chunk_from_result(std::move(encoded_result),
+        type, DType::FLOAT64, {&shape_val, 1}, flags);
 }
 
 DataCompressor::ChunkResult DataCompressor::compress_chunk(
     std::span<const int64_t> data, ChunkDataType type, int64_t prev_element, int level) const
 {
-    auto& codec = pimpl_->get_t1d_codec(level);
-    std::lock_guard lock(pimpl_->temporal_1d_workspace_mutex_);
-    
+    if (level == ADAPTIVE_LEVEL) {
+        return compress_adaptive(data.size_bytes(), [&](const int l) { return compress_chunk(data, type, prev_element, l); });
+    }
+    auto& bundle = pimpl_->local();
+    auto& codec = bundle.get_t1d_codec(level);
+
     std::expected<memory::vector<std::byte>, std::string> encoded_result;
 
     switch (type) {
         case ChunkDataType::TEMPORAL_1D_SIMD_I64_XOR:
-            encoded_result = codec.encode64_Xor(data, prev_element, pimpl_->temporal_1d_workspace_);
+            encoded_result = codec.encode64_Xor(data, prev_element, bundle.temporal_1d_workspace);
             break;
         case ChunkDataType::TEMPORAL_1D_SIMD_I64_DELTA:
-            encoded_result = codec.encode64_Delta(data, prev_element, pimpl_->temporal_1d_workspace_);
+            encoded_result = codec.encode64_Delta(data, prev_element, bundle.temporal_1d_workspace);
+            break;
+        case ChunkDataType::TEMPORAL_1D_SIMD_I64_DOUBLE_DELTA:
+            encoded_result = codec.encode64_DoubleDelta(data, prev_element, bundle.temporal_1d_workspace);
+            break;
+        case ChunkDataType::TEMPORAL_1D_SIMD_I64_DELTA_BITPACK:
+        case ChunkDataType::TEMPORAL_1D_SIMD_I64_DELTA_BITPACK_ZSTD:
+            encoded_result = codec.encode64_Delta_BitPack(data, prev_element, bundle.temporal_1d_workspace,
+                                                          type == ChunkDataType::TEMPORAL_1D_SIMD_I64_DELTA_BITPACK_ZSTD);
             break;
         default:
             return std::unexpected(CodecError{ErrorCode::InvalidDataType, "Unsupported or mismatched chunk type for 1D int64 data."});
@@ -245,6 +640,9 @@ DataCompressor::ChunkResult DataCompressor::compress_chunk(
 DataCompressor::ChunkResult DataCompressor::compress_chunk(
     std::span<const float> data, ChunkDataType type, std::span<const int64_t> shape, std::span<const float> prev_state, int level) const
 {
+    if (level == ADAPTIVE_LEVEL) {
+        return compress_adaptive(data.size_bytes(), [&](const int l) { return compress_chunk(data, type, shape, prev_state, l); });
+    }
     std::expected<memory::vector<std::byte>, std::string> encoded_result;
 
     for (const auto dim : shape) {
@@ -261,16 +659,16 @@ DataCompressor::ChunkResult DataCompressor::compress_chunk(
             if (static_cast<size_t>(shape[1]) != codecs::Orderbook::OKX_DEPTH || static_cast<size_t>(shape[2]) != codecs::Orderbook::OKX_FEATURES) {
                 return std::unexpected(CodecError{ErrorCode::InvalidChunkShape, std::format("OKX orderbook shape mismatch. Expected ({}, {}), got ({}, {}).", codecs::Orderbook::OKX_DEPTH, codecs::Orderbook::OKX_FEATURES, shape[1], shape[2])});
             }
-            auto& codec = pimpl_->get_okx_ob_codec(level);
-            
-            std::lock_guard lock(pimpl_->ob_workspace_mutex_); // Using generic OB workspace mutex for now
+            auto& bundle = pimpl_->local();
+            auto& codec = bundle.get_okx_ob_codec(level);
+
             std::remove_reference_t<decltype(codec)>::Snapshot snapshot;
             std::ranges::copy(prev_state, snapshot.begin());
             if (type == ChunkDataType::OKX_OB_SIMD_F16_AS_F32) {
 
-                encoded_result = codec.encode16(data, snapshot, pimpl_->ob_workspace_);
+                encoded_result = codec.encode16(data, snapshot, bundle.ob_workspace, kShuffleLayout);
             } else {
-                encoded_result = codec.encode32(data, snapshot, pimpl_->ob_workspace_);
+                encoded_result = codec.encode32(data, snapshot, bundle.ob_workspace, kShuffleLayout);
             }
             break;
         }
@@ -281,15 +679,15 @@ DataCompressor::ChunkResult DataCompressor::compress_chunk(
             if (static_cast<size_t>(shape[1]) != codecs::Orderbook::BINANCE_DEPTH || static_cast<size_t>(shape[2]) != codecs::Orderbook::BINANCE_FEATURES) {
                 return std::unexpected(CodecError{ErrorCode::InvalidChunkShape, std::format("Binance orderbook shape mismatch. Expected ({}, {}), got ({}, {}).", codecs::Orderbook::BINANCE_DEPTH, codecs::Orderbook::BINANCE_FEATURES, shape[1], shape[2])});
             }
-            auto& codec = pimpl_->get_binance_ob_codec(level);
-            
-            std::lock_guard lock(pimpl_->ob_workspace_mutex_); // Using generic OB workspace mutex for now
+            auto& bundle = pimpl_->local();
+            auto& codec = bundle.get_binance_ob_codec(level);
+
             std::remove_reference_t<decltype(codec)>::Snapshot snapshot;
             std::ranges::copy(prev_state, snapshot.begin());
             if (type == ChunkDataType::BINANCE_OB_SIMD_F16_AS_F32) {
-                encoded_result = codec.encode16(data, snapshot, pimpl_->ob_workspace_);
+                encoded_result = codec.encode16(data, snapshot, bundle.ob_workspace, kShuffleLayout);
             } else {
-                encoded_result = codec.encode32(data, snapshot, pimpl_->ob_workspace_);
+                encoded_result = codec.encode32(data, snapshot, bundle.ob_workspace, kShuffleLayout);
             }
             break;
         }
@@ -299,28 +697,66 @@ DataCompressor::ChunkResult DataCompressor::compress_chunk(
             if (shape.size() != 3) return std::unexpected(CodecError{ErrorCode::InvalidChunkShape, "Orderbook data requires a 3D shape."});
             const size_t depth = static_cast<size_t>(shape[1]);
             const size_t features = static_cast<size_t>(shape[2]);
-            auto& codec = pimpl_->get_ob_codec(depth, features, level);
-            
-            std::lock_guard lock(pimpl_->ob_workspace_mutex_);
+            auto& bundle = pimpl_->local();
+            auto& codec = bundle.get_ob_codec(depth, features, level);
+
             if (type == ChunkDataType::GENERIC_OB_SIMD_F16_AS_F32) {
-                encoded_result = codec.encode16(data, prev_state, pimpl_->ob_workspace_);
+                encoded_result = codec.encode16(data, prev_state, bundle.ob_workspace, kShuffleLayout);
             } else {
-                encoded_result = codec.encode32(data, prev_state, pimpl_->ob_workspace_);
+                encoded_result = codec.encode32(data, prev_state, bundle.ob_workspace, kShuffleLayout);
             }
             break;
         }
+        case ChunkDataType::GENERIC_OB_SIMD_BFP16_AS_F32:
+        {
+            if (shape.size() != 3) return std::unexpected(CodecError{ErrorCode::InvalidChunkShape, "Orderbook data requires a 3D shape."});
+            const size_t depth = static_cast<size_t>(shape[1]);
+            const size_t features = static_cast<size_t>(shape[2]);
+            if (data.size() != static_cast<size_t>(shape[0]) * depth * features) {
+                return std::unexpected(CodecError{ErrorCode::InvalidDataSize, std::format("Data size {} does not match the chunk shape.", data.size())});
+            }
+            auto& bundle = pimpl_->local();
+            auto encoded = bundle.get_bfp16_ob_codec(level).encode(data, depth, features, bundle.bfp16_ob_workspace);
+            if (!encoded) return std::unexpected(CodecError::from_string(encoded.error(), ErrorCode::EncodingFailure));
+            if (!*encoded) {
+                // NaN, infinities or a range overflowing float: store the chunk losslessly instead.
+                return compress_chunk(data, ChunkDataType::GENERIC_OB_SIMD_F32, shape, prev_state, level);
+            }
+            // Chunks that happen to round-trip exactly are indistinguishable from lossless ones.
+            const ChunkFlags flags = (*encoded)->exact ? ChunkFlags::NONE : ChunkFlags::RECONSTRUCTION_NOT_PERFECT | ChunkFlags::RECONSTRUCTION_BOUNDED;
+            return create_chunk_from_result(std::move((*encoded)->payload), type, DType::FLOAT32, shape, flags);
+        }
+        case ChunkDataType::GENERIC_OB_SIMD_SPARSE_F32:
+        {
+            if (shape.size() != 3) return std::unexpected(CodecError{ErrorCode::InvalidChunkShape, "Orderbook data requires a 3D shape."});
+            const size_t snapshot_floats = static_cast<size_t>(shape[1]) * static_cast<size_t>(shape[2]);
+            if (prev_state.size() != snapshot_floats) {
+                return std::unexpected(CodecError{ErrorCode::InvalidStateSize, std::format("prev_state has {} floats, expected {}.", prev_state.size(), snapshot_floats)});
+            }
+            if (data.size() != static_cast<size_t>(shape[0]) * snapshot_floats) {
+                return std::unexpected(CodecError{ErrorCode::InvalidDataSize, std::format("Data size {} does not match the chunk shape.", data.size())});
+            }
+            auto& bundle = pimpl_->local();
+            auto encoded = bundle.get_sparse_ob_codec(level).encode(data, prev_state, bundle.sparse_ob_workspace);
+            if (!encoded) return std::unexpected(CodecError::from_string(encoded.error(), ErrorCode::EncodingFailure));
+            if (!*encoded) {
+                // Too many levels changed for the bitmap to pay off: use the dense XOR + shuffle codec.
+                return compress_chunk(data, ChunkDataType::GENERIC_OB_SIMD_F32, shape, prev_state, level);
+            }
+            return create_chunk_from_result(std::move(**encoded), type, DType::FLOAT32, shape, ChunkFlags::NONE);
+        }
         case ChunkDataType::TEMPORAL_2D_SIMD_F16_AS_F32:
         case ChunkDataType::TEMPORAL_2D_SIMD_F32:
         {
             if (shape.size() != 2) return std::unexpected(CodecError{ErrorCode::InvalidChunkShape, "Temporal 2D data requires a 2D shape."});
             const size_t num_features = static_cast<size_t>(shape[1]);
-            auto& codec = pimpl_->get_t2d_codec(num_features, level);
+            auto& bundle = pimpl_->local();
+            auto& codec = bundle.get_t2d_codec(num_features, level);
 
-            std::lock_guard lock(pimpl_->temporal_2d_workspace_mutex_);
             if (type == ChunkDataType::TEMPORAL_2D_SIMD_F16_AS_F32) {
-                encoded_result = codec.encode16(data, prev_state, pimpl_->temporal_2d_workspace_);
+                encoded_result = codec.encode16(data, prev_state, bundle.temporal_2d_workspace, kShuffleLayout);
             } else {
-                encoded_result = codec.encode32(data, prev_state, pimpl_->temporal_2d_workspace_);
+                encoded_result = codec.encode32(data, prev_state, bundle.temporal_2d_workspace, kShuffleLayout);
             }
             break;
         }
@@ -328,12 +764,48 @@ DataCompressor::ChunkResult DataCompressor::compress_chunk(
             return std::unexpected(CodecError{ErrorCode::InvalidDataType, "Unsupported or mismatched chunk type for 2D/3D float data."});
     }
 
-    return create_chunk_from_result(std::move(encoded_result), type, DType::FLOAT32, shape, ChunkFlags::NONE);
+    return create_chunk_from_result(std::move(encoded_result), type, DType::FLOAT32, shape, ChunkFlags::BLOCKED_SHUFFLE);
+}
+
+DataCompressor::ChunkResult DataCompressor::compress_chunk(
+    std::span<const double> data, ChunkDataType type, std::span<const int64_t> shape, std::span<const double> prev_row, int level) const
+{
+    if (level == ADAPTIVE_LEVEL) {
+        return compress_adaptive(data.size_bytes(), [&](const int l) { return compress_chunk(data, type, shape, prev_row, l); });
+    }
+    if (shape.size() != 2) return std::unexpected(CodecError{ErrorCode::InvalidChunkShape, "Temporal 2D double data requires a 2D shape."});
+
+    for (const auto dim : shape) {
+        if (dim < 0) {
+            return std::unexpected(CodecError{ErrorCode::InvalidChunkShape, "Shape dimensions cannot be negative."});
+        }
+    }
+
+    std::expected<memory::vector<std::byte>, std::string> encoded_result;
+
+    switch (type) {
+        case ChunkDataType::TEMPORAL_2D_SIMD_F64:
+        {
+            const size_t num_features = static_cast<size_t>(shape[1]);
+            auto& bundle = pimpl_->local();
+            auto& codec = bundle.get_t2d_codec(num_features, level);
+
+            encoded_result = codec.encode64_Xor_Shuffle(data, prev_row, bundle.temporal_2d_workspace, kShuffleLayout);
+            break;
+        }
+        default:
+            return std::unexpected(CodecError{ErrorCode::InvalidDataType, "Unsupported or mismatched chunk type for 2D double data."});
+    }
+
+    return create_chunk_from_result(std::move(encoded_result), type, DType::FLOAT64, shape, ChunkFlags::BLOCKED_SHUFFLE);
 }
 
 DataCompressor::ChunkResult DataCompressor::compress_chunk(
     std::span<const int64_t> data, ChunkDataType type, std::span<const int64_t> shape, std::span<const int64_t> prev_row, int level) const
 {
+    if (level == ADAPTIVE_LEVEL) {
+        return compress_adaptive(data.size_bytes(), [&](const int l) { return compress_chunk(data, type, shape, prev_row, l); });
+    }
     if (shape.size() != 2) return std::unexpected(CodecError{ErrorCode::InvalidChunkShape, "Temporal 2D int64 data requires a 2D shape."});
     
     for (const auto dim : shape) {
@@ -343,22 +815,175 @@ DataCompressor::ChunkResult DataCompressor::compress_chunk(
     }
 
     std::expected<memory::vector<std::byte>, std::string> encoded_result;
+    ChunkFlags flags = ChunkFlags::NONE;
 
     switch (type) {
         case ChunkDataType::TEMPORAL_2D_SIMD_I64:
         {
             const size_t num_features = static_cast<size_t>(shape[1]);
-            auto& codec = pimpl_->get_t2d_codec(num_features, level);
-            
-            std::lock_guard lock(pimpl_->temporal_2d_workspace_mutex_);
-            encoded_result = codec.encode64(data, prev_row, pimpl_->temporal_2d_workspace_);
+            auto& bundle = pimpl_->local();
+            auto& codec = bundle.get_t2d_codec(num_features, level);
+
+            encoded_result = codec.encode64(data, prev_row, bundle.temporal_2d_workspace);
+            break;
+        }
+        case ChunkDataType::TEMPORAL_2D_SIMD_I64_DOUBLE_DELTA:
+        {
+            const size_t num_features = static_cast<size_t>(shape[1]);
+            auto& bundle = pimpl_->local();
+            auto& codec = bundle.get_t2d_codec(num_features, level);
+
+            encoded_result = codec.encode64_DoubleDelta(data, prev_row, bundle.temporal_2d_workspace);
+            break;
+        }
+        case ChunkDataType::TEMPORAL_2D_SIMD_I64_DELTA:
+        case ChunkDataType::TEMPORAL_2D_SIMD_I64_DELTA_SHUFFLE:
+        {
+            const size_t num_features = static_cast<size_t>(shape[1]);
+            auto& bundle = pimpl_->local();
+            auto& codec = bundle.get_t2d_codec(num_features, level);
+
+            if (type == ChunkDataType::TEMPORAL_2D_SIMD_I64_DELTA_SHUFFLE) {
+                encoded_result = codec.encode64_Delta(data, prev_row, bundle.temporal_2d_workspace, true, kShuffleLayout);
+                flags = ChunkFlags::BLOCKED_SHUFFLE;
+            } else {
+                encoded_result = codec.encode64_Delta(data, prev_row, bundle.temporal_2d_workspace);
+            }
             break;
         }
         default:
             return std::unexpected(CodecError{ErrorCode::InvalidDataType, "Unsupported or mismatched chunk type for 2D int64 data."});
     }
 
-    return create_chunk_from_result(std::move(encoded_result), type, DType::INT64, shape, ChunkFlags::NONE);
+    return create_chunk_from_result(std::move(encoded_result), type, DType::INT64, shape, flags);
+}
+
+// --- Fixed-Point ---
+
+DataCompressor::ChunkResult DataCompressor::compress_fixed_point(
+    std::span<const float> data, ChunkDataType type, std::span<const int64_t> shape, std::span<const double> tick_sizes, std::span<const float> prev_state, int level) const
+{
+    if (level == ADAPTIVE_LEVEL) {
+        return compress_adaptive(data.size_bytes(), [&](const int l) { return compress_fixed_point(data, type, shape, tick_sizes, prev_state, l); });
+    }
+    if (type != ChunkDataType::TEMPORAL_1D_FIXED_POINT_F32 && type != ChunkDataType::TEMPORAL_2D_FIXED_POINT_F32 && type != ChunkDataType::ORDERBOOK_FIXED_POINT_F32) {
+        return std::unexpected(CodecError{ErrorCode::InvalidDataType, "Unsupported or mismatched chunk type for fixed-point float data."});
+    }
+    auto& bundle = pimpl_->local();
+    return compress_fixed_point_chunk(*this, bundle.get_fixed_point_codec(level), bundle.fixed_point_workspace, data, type, shape, tick_sizes, prev_state, level);
+}
+
+DataCompressor::ChunkResult DataCompressor::compress_fixed_point(
+    std::span<const double> data, ChunkDataType type, std::span<const int64_t> shape, std::span<const double> tick_sizes, std::span<const double> prev_state, int level) const
+{
+    if (level == ADAPTIVE_LEVEL) {
+        return compress_adaptive(data.size_bytes(), [&](const int l) { return compress_fixed_point(data, type, shape, tick_sizes, prev_state, l); });
+    }
+    if (type != ChunkDataType::TEMPORAL_1D_FIXED_POINT_F64 && type != ChunkDataType::TEMPORAL_2D_FIXED_POINT_F64) {
+        return std::unexpected(CodecError{ErrorCode::InvalidDataType, "Unsupported or mismatched chunk type for fixed-point double data."});
+    }
+    auto& bundle = pimpl_->local();
+    return compress_fixed_point_chunk(*this, bundle.get_fixed_point_codec(level), bundle.fixed_point_workspace, data, type, shape, tick_sizes, prev_state, level);
+}
+
+// --- Error-Bounded Quantization ---
+
+DataCompressor::ChunkResult DataCompressor::compress_quantized(
+    std::span<const float> data, ChunkDataType type, std::span<const int64_t> shape, std::span<const double> error_bounds, bool relative, std::span<const float> prev_state, int level) const
+{
+    if (level == ADAPTIVE_LEVEL) {
+        return compress_adaptive(data.size_bytes(), [&](const int l) { return compress_quantized(data, type, shape, error_bounds, relative, prev_state, l); });
+    }
+    if (type != ChunkDataType::TEMPORAL_1D_QUANTIZED_F32 && type != ChunkDataType::TEMPORAL_2D_QUANTIZED_F32) {
+        return std::unexpected(CodecError{ErrorCode::InvalidDataType, "Unsupported or mismatched chunk type for quantized float data."});
+    }
+    auto& bundle = pimpl_->local();
+    return compress_quantized_chunk(*this, bundle.get_fixed_point_codec(level), bundle.fixed_point_workspace, data, type, shape, error_bounds, relative, prev_state, level);
+}
+
+DataCompressor::ChunkResult DataCompressor::compress_quantized(
+    std::span<const double> data, ChunkDataType type, std::span<const int64_t> shape, std::span<const double> error_bounds, bool relative, std::span<const double> prev_state, int level) const
+{
+    if (level == ADAPTIVE_LEVEL) {
+        return compress_adaptive(data.size_bytes(), [&](const int l) { return compress_quantized(data, type, shape, error_bounds, relative, prev_state, l); });
+    }
+    if (type != ChunkDataType::TEMPORAL_1D_QUANTIZED_F64 && type != ChunkDataType::TEMPORAL_2D_QUANTIZED_F64) {
+        return std::unexpected(CodecError{ErrorCode::InvalidDataType, "Unsupported or mismatched chunk type for quantized double data."});
+    }
+    auto& bundle = pimpl_->local();
+    return compress_quantized_chunk(*this, bundle.get_fixed_point_codec(level), bundle.fixed_point_workspace, data, type, shape, error_bounds, relative, prev_state, level);
+}
+
+// --- Multi-Frame ---
+
+DataCompressor::ChunkResult DataCompressor::compress_chunk_frames(
+    std::span<const std::byte> data, ChunkDataType type, std::span<const int64_t> shape,
+    std::span<const std::byte> prev_state, size_t num_frames, int level, std::span<const double> tick_sizes,
+    std::span<const double> error_bounds, bool relative_error_bound) const
+{
+    if (level == ADAPTIVE_LEVEL) {
+        return compress_adaptive(data.size_bytes(), [&](const int l) { return compress_chunk_frames(data, type, shape, prev_state, num_frames, l, tick_sizes, error_bounds, relative_error_bound); });
+    }
+    auto geometry = chunk_frames::row_geometry(type, shape);
+    if (!geometry) return std::unexpected(CodecError::from_string(geometry.error(), ErrorCode::InvalidChunkShape));
+    if (data.size() != geometry->total_bytes()) {
+        return std::unexpected(CodecError{ErrorCode::InvalidDataSize, std::format("Data size {} does not match the chunk shape ({} bytes).", data.size(), geometry->total_bytes())});
+    }
+    if (prev_state.size() != geometry->row_bytes()) {
+        return std::unexpected(CodecError{ErrorCode::InvalidStateSize, std::format("Previous state size mismatch. Expected {} bytes, got {}.", geometry->row_bytes(), prev_state.size())});
+    }
+
+    const size_t num_rows = geometry->num_rows;
+    num_frames = std::min(num_frames, num_rows);
+    if (num_frames <= 1) {
+        return compress_frame(*this, type, shape, data, prev_state, level, tick_sizes, error_bounds, relative_error_bound);
+    }
+
+    // Spread the remainder over the first frames so sizes differ by at most one row.
+    memory::vector<uint64_t> rows(num_frames, num_rows / num_frames);
+    for (size_t i = 0; i < num_rows % num_frames; ++i) ++rows[i];
+    memory::vector<uint64_t> first_rows(num_frames, 0);
+    std::exclusive_scan(rows.begin(), rows.end(), first_rows.begin(), uint64_t{0});
+
+    const size_t state_bytes = geometry->row_bytes();
+    memory::vector<std::byte> states((num_frames - 1) * state_bytes);
+    for (size_t i = 1; i < num_frames; ++i) {
+        chunk_frames::extract_row(*geometry, data.data(), first_rows[i] - 1, states.data() + (i - 1) * state_bytes);
+    }
+    round_trip_states(type, states);
+
+    memory::vector<ChunkResult> frames(num_frames);
+    ThreadPool::shared().parallel_for(num_frames, [&](const size_t i) {
+        memory::vector<int64_t> frame_shape(shape.begin(), shape.end());
+        frame_shape[0] = static_cast<int64_t>(rows[i]);
+        memory::vector<std::byte> frame_data(rows[i] * state_bytes);
+        chunk_frames::gather_rows(*geometry, data.data(), first_rows[i], rows[i], frame_data.data());
+        const auto frame_state = i == 0 ? prev_state : std::span<const std::byte>(states).subspan((i - 1) * state_bytes, state_bytes);
+        frames[i] = compress_frame(*this, type, frame_shape, frame_data, frame_state, level, tick_sizes, error_bounds, relative_error_bound);
+    });
+
+    memory::vector<uint64_t> sizes(num_frames);
+    for (size_t i = 0; i < num_frames; ++i) {
+        if (!frames[i]) return std::unexpected(frames[i].error());
+        sizes[i] = (*frames[i])->data().size();
+    }
+    ChunkFlags flags = (*frames.front())->flags() | ChunkFlags::MULTI_FRAME;
+    for (const auto& frame : frames) {
+        // A frame that fell back to another codec (off the tick grid, not quantizable, not representable in BFP16,
+        // or too dense for the sparse codec); all frames must share one type.
+        if ((*frame)->type() != type) return compress_chunk_frames(data, (*frame)->type(), shape, prev_state, num_frames, level);
+        // Lossy as soon as one frame is.
+        flags |= (*frame)->flags() & (ChunkFlags::RECONSTRUCTION_NOT_PERFECT | ChunkFlags::RECONSTRUCTION_BOUNDED);
+    }
+
+    auto payload = chunk_frames::write_header(rows, sizes, state_bytes, states);
+    payload.reserve(payload.size() + std::accumulate(sizes.begin(), sizes.end(), size_t{0}));
+    for (const auto& frame : frames) {
+        const auto& frame_data = (*frame)->data();
+        payload.insert(payload.end(), frame_data.begin(), frame_data.end());
+    }
+
+    return create_chunk_from_result(std::move(payload), type, (*frames.front())->dtype(), shape, flags);
 }
 
 } // namespace cryptodd
@@ -3,7 +3,10 @@
 #include "../file_format/cdd_file_format.h" // For Chunk, ChunkDataType, DType, etc.
 #include "codec_error.h"      // For CodecError
 #include "../codecs/zstd_compressor.h"      // For ZstdCompressor::DEFAULT_COMPRESSION_LEVEL
+#include "../codecs/codec_constants.h"      // For codecs::BlockVisitor
+#include "zstd_level_controller.h"
 #include <expected>
+#include <limits>
 #include <memory>
 #include <span>
 #include <vector>
@@ -27,11 +30,15 @@ class Chunk;
  * The class handles the internal dispatch to the correct codec.
  *
  * @section performance Performance and Thread Safety
- * The class is thread-safe. However, for maximum performance in highly concurrent
- * applications, it is **strongly recommended** to create and use one `DataCompressor`
- * instance per thread. This avoids contention on internal workspace buffers. If a single
- * instance is shared, access to these buffers will be serialized by mutexes.
- * Caching of codec instances is handled internally and is thread-safe.
+ * The class is thread-safe and a single instance can be shared between threads. Each calling
+ * thread transparently gets its own workspace buffers and codec cache, so concurrent calls do
+ * not contend on any lock once a thread has warmed up its cache. A thread's state is released when
+ * that thread exits or when the `DataCompressor` is destroyed, whichever comes first.
+ *
+ * @section adaptive Adaptive Level
+ * Passing `ADAPTIVE_LEVEL` as the level lets `level_controller()` pick it: each such chunk's encode time and
+ * size feed the controller, which moves the level within its configured range to meet a throughput or latency
+ * target. The level used is recorded in the chunk's flags (see chunk_zstd_level).
  */
 class DataCompressor
 {
@@ -49,6 +56,12 @@ class DataCompressor
 
     using ChunkResult = std::expected<std::unique_ptr<Chunk>, CodecError>;
 
+    /** @brief A `level` value that asks the level controller for the zstd level (see @ref adaptive). */
+    static constexpr int ADAPTIVE_LEVEL = std::numeric_limits<int>::min();
+
+    /** @brief The controller behind ADAPTIVE_LEVEL, shared by every thread using this compressor. */
+    [[nodiscard]] ZstdLevelController& level_controller() const;
+
     /**
      * @brief Compresses a raw byte span using Zstd. This is for simple, non-SIMD compression.
      * @param data The raw data to compress.
@@ -64,6 +77,21 @@ class DataCompressor
         int level = ZstdCompressor::DEFAULT_COMPRESSION_LEVEL
     ) const;
 
+    /**
+     * @brief Compresses a raw byte span using Zstd with advanced parameters (workers, long-distance
+     * matching, window size, strategy).
+     *
+     * Chunks whose window exceeds ZstdCompressor::DEFAULT_DECODER_WINDOW_LOG are tagged with
+     * ChunkFlags::ZSTD_LONG_WINDOW, so readers know a streaming decoder would need a larger window limit.
+     * @return A Chunk containing the compressed data, or an error (including rejected parameters).
+     */
+    [[nodiscard]] ChunkResult compress_zstd(
+        std::span<const std::byte> data,
+        std::span<const int64_t> shape,
+        DType dtype,
+        const ZstdCompressor::Params& params
+    ) const;
+
     /**
      * @brief Encodes a 1D series of floats with a default (zero) initial state.
      */
@@ -76,18 +104,47 @@ class DataCompressor
     /**
      * @brief Encodes a 1D series of floats based on the specified temporal chunk type.
      * @param data The raw float data to encode.
-     * @param type The target chunk type (e.g., TEMPORAL_1D_SIMD_F16_XOR_SHUFFLE_AS_F32).
+     * @param type The target chunk type (e.g., TEMPORAL_1D_SIMD_F16_XOR_SHUFFLE_AS_F32, TEMPORAL_1D_CHIMP_F32).
      * @param prev_element The state from the previous chunk.
-     * @param level The Zstd compression level.
+     * @param level The Zstd compression level (unused by TEMPORAL_1D_CHIMP_F32).
+     * @param on_raw_block Called with each block of `data` as the XOR+shuffle codecs encode it, covering all of
+     * `data` in order; never called by TEMPORAL_1D_CHIMP_F32. Lets callers hash the input in the same pass.
      * @return A Chunk containing the encoded and compressed data, or an error.
      */
     [[nodiscard]] ChunkResult compress_chunk(
         std::span<const float> data,
         ChunkDataType type,
         float prev_element,
-        int level = ZstdCompressor::DEFAULT_COMPRESSION_LEVEL
+        int level = ZstdCompressor::DEFAULT_COMPRESSION_LEVEL,
+        const codecs::BlockVisitor& on_raw_block = {}
     ) const;
     
+    /**
+     * @brief Encodes a 1D series of doubles based on the specified temporal chunk type.
+     * @param data The raw double data to encode.
+     * @param type The target chunk type (TEMPORAL_1D_CHIMP_F64 or TEMPORAL_1D_SIMD_F64_XOR_SHUFFLE).
+     * @param prev_element The state from the previous chunk.
+     * @param level The Zstd compression level (unused by TEMPORAL_1D_CHIMP_F64).
+     * @param on_raw_block As for the float overload; only TEMPORAL_1D_SIMD_F64_XOR_SHUFFLE calls it.
+     * @return A Chunk containing the encoded data, or an error.
+     */
+    [[nodiscard]] ChunkResult compress_chunk(
+        std::span<const double> data,
+        ChunkDataType type,
+        double prev_element,
+        int level = ZstdCompressor::DEFAULT_COMPRESSION_LEVEL,
+        const codecs::BlockVisitor& on_raw_block = {}
+    ) const;
+
+    /**
+     * @brief Encodes a 1D series of doubles with a default (zero) initial state.
+     */
+    [[nodiscard]] ChunkResult compress_chunk(
+        std::span<const double> data,
+        ChunkDataType type,
+        int level = ZstdCompressor::DEFAULT_COMPRESSION_LEVEL
+    ) const;
+
     /**
      * @brief Encodes a 1D series of int64s based on the specified temporal chunk type.
      * @param data The raw int64 data to encode.
@@ -114,6 +171,11 @@ class DataCompressor
 
     /**
      * @brief Encodes a 2D/3D series of floats (Temporal 2D or Orderbook) based on the chunk type.
+     *
+     * GENERIC_OB_SIMD_BFP16_AS_F32 chunks that are not restored bit for bit carry RECONSTRUCTION_NOT_PERFECT and
+     * RECONSTRUCTION_BOUNDED. Chunks it cannot represent (NaN, infinities) are encoded as GENERIC_OB_SIMD_F32
+     * instead, and the returned chunk carries that type. GENERIC_OB_SIMD_SPARSE_F32 chunks in which more than a
+     * quarter of the floats change between snapshots are likewise encoded as GENERIC_OB_SIMD_F32.
      * @param data The raw float data to encode, laid out in Structure-of-Arrays (SoA) format.
      * @param type The target chunk type (e.g., GENERIC_OB_SIMD_F16_AS_F32, TEMPORAL_2D_SIMD_F32).
      * @param shape The shape of the data. Must be 2D for Temporal 2D or 3D for Orderbook.
@@ -129,6 +191,23 @@ class DataCompressor
         int level = ZstdCompressor::DEFAULT_COMPRESSION_LEVEL
     ) const;
     
+    /**
+     * @brief Encodes a 2D series of doubles based on the specified temporal chunk type.
+     * @param data The raw double data to encode, laid out in Structure-of-Arrays (SoA) format.
+     * @param type The target chunk type (TEMPORAL_2D_SIMD_F64).
+     * @param shape The 2D shape of the data.
+     * @param prev_row The state of the previous row.
+     * @param level The Zstd compression level.
+     * @return A Chunk containing the encoded and compressed data, or an error.
+     */
+    [[nodiscard]] ChunkResult compress_chunk(
+        std::span<const double> data,
+        ChunkDataType type,
+        std::span<const int64_t> shape,
+        std::span<const double> prev_row,
+        int level = ZstdCompressor::DEFAULT_COMPRESSION_LEVEL
+    ) const;
+
     /**
      * @brief Encodes a 2D series of int64s based on the specified temporal chunk type.
      * @param data The raw int64 data to encode, laid out in Structure-of-Arrays (SoA) format.
@@ -145,6 +224,118 @@ class DataCompressor
         std::span<const int64_t> prev_row,
         int level = ZstdCompressor::DEFAULT_COMPRESSION_LEVEL
     ) const;
+
+    /**
+     * @brief Encodes tick-aligned floats as fixed-point integers (see fixed_point_simd_codec.h).
+     *
+     * If any value is not an exact multiple of its tick, the chunk is encoded with the matching float codec
+     * instead (TEMPORAL_1D_SIMD_F32_XOR_SHUFFLE, TEMPORAL_2D_SIMD_F32 or GENERIC_OB_SIMD_F32), and the
+     * returned chunk carries that type.
+     * @param data The raw float data, laid out as for the matching `compress_chunk` overload.
+     * @param type TEMPORAL_1D_FIXED_POINT_F32, TEMPORAL_2D_FIXED_POINT_F32 or ORDERBOOK_FIXED_POINT_F32.
+     * @param shape The shape of the data (1D, 2D or 3D to match `type`).
+     * @param tick_sizes One tick for every column (2D) or feature (orderbook), or a single tick for all of them.
+     * @param prev_state The state of the previous row, used only by the fallback codec. Empty means zeros.
+     * @param level The Zstd compression level.
+     * @return A Chunk containing the encoded data, or an error.
+     */
+    [[nodiscard]] ChunkResult compress_fixed_point(
+        std::span<const float> data,
+        ChunkDataType type,
+        std::span<const int64_t> shape,
+        std::span<const double> tick_sizes,
+        std::span<const float> prev_state = {},
+        int level = ZstdCompressor::DEFAULT_COMPRESSION_LEVEL
+    ) const;
+
+    /**
+     * @brief Double counterpart of the float `compress_fixed_point`, for TEMPORAL_1D_FIXED_POINT_F64 and
+     * TEMPORAL_2D_FIXED_POINT_F64 (falling back to TEMPORAL_1D_SIMD_F64_XOR_SHUFFLE or TEMPORAL_2D_SIMD_F64).
+     */
+    [[nodiscard]] ChunkResult compress_fixed_point(
+        std::span<const double> data,
+        ChunkDataType type,
+        std::span<const int64_t> shape,
+        std::span<const double> tick_sizes,
+        std::span<const double> prev_state = {},
+        int level = ZstdCompressor::DEFAULT_COMPRESSION_LEVEL
+    ) const;
+
+    /**
+     * @brief Encodes floats with a guaranteed per-column error bound (see fixed_point_simd_codec.h).
+     *
+     * Every decoded value is within its column's bound of the original. A chunk that only holds values on the
+     * quantization grid comes back bit-exact and carries no flag; otherwise it is flagged RECONSTRUCTION_NOT_PERFECT
+     * and RECONSTRUCTION_BOUNDED, and the achieved per-column error is recorded in its payload. If a column cannot
+     * be quantized (non-finite values, or a bound too small for the magnitudes), the chunk is encoded losslessly
+     * with the matching float codec instead (TEMPORAL_1D_SIMD_F32_XOR_SHUFFLE or TEMPORAL_2D_SIMD_F32).
+     * @param data The raw float data, laid out as for the matching `compress_chunk` overload.
+     * @param type TEMPORAL_1D_QUANTIZED_F32 or TEMPORAL_2D_QUANTIZED_F32.
+     * @param shape The shape of the data (1D or 2D to match `type`).
+     * @param error_bounds One positive bound for every column, or a single bound for all of them.
+     * @param relative If true, a column's bound is a fraction of the largest magnitude in that column of the chunk.
+     * @param prev_state The state of the previous row, used only by the fallback codec. Empty means zeros.
+     * @param level The Zstd compression level.
+     * @return A Chunk containing the encoded data, or an error.
+     */
+    [[nodiscard]] ChunkResult compress_quantized(
+        std::span<const float> data,
+        ChunkDataType type,
+        std::span<const int64_t> shape,
+        std::span<const double> error_bounds,
+        bool relative,
+        std::span<const float> prev_state = {},
+        int level = ZstdCompressor::DEFAULT_COMPRESSION_LEVEL
+    ) const;
+
+    /**
+     * @brief Double counterpart of the float `compress_quantized`, for TEMPORAL_1D_QUANTIZED_F64 and
+     * TEMPORAL_2D_QUANTIZED_F64 (falling back to TEMPORAL_1D_SIMD_F64_XOR_SHUFFLE or TEMPORAL_2D_SIMD_F64).
+     */
+    [[nodiscard]] ChunkResult compress_quantized(
+        std::span<const double> data,
+        ChunkDataType type,
+        std::span<const int64_t> shape,
+        std::span<const double> error_bounds,
+        bool relative,
+        std::span<const double> prev_state = {},
+        int level = ZstdCompressor::DEFAULT_COMPRESSION_LEVEL
+    ) const;
+
+    /**
+     * @brief Splits a chunk into row ranges and encodes them concurrently into a single MULTI_FRAME chunk.
+     *
+     * Each frame is encoded like a standalone chunk of the same type whose prev state is the row just
+     * before it, so frames can also be decoded independently and in parallel (see DataExtractor).
+     * Frames run on ThreadPool::shared().
+     * @param data The raw data, laid out as for the matching typed `compress_chunk` overload.
+     * @param type The target chunk type. RAW and ZSTD_COMPRESSED are not supported.
+     * @param shape The full shape of the data; rows are split along the first dimension.
+     * @param prev_state The state preceding the first row, as raw bytes (one row, or one element for 1D).
+     * @param num_frames The requested number of frames. Clamped to the number of rows; 1 produces a regular chunk.
+     * @param level The Zstd compression level.
+     * @param tick_sizes The tick sizes of fixed-point chunk types, ignored otherwise. If any frame falls back
+     *        to its float codec, the whole chunk is re-encoded with that codec so every frame shares one type.
+     * @param error_bounds The error bounds of quantized chunk types, ignored otherwise. Falls back like `tick_sizes`.
+     * @param relative_error_bound Whether `error_bounds` are relative to each frame's largest magnitude per column.
+     * @return A Chunk containing the frame table and frame payloads, or an error.
+     */
+    [[nodiscard]] ChunkResult compress_chunk_frames(
+        std::span<const std::byte> data,
+        ChunkDataType type,
+        std::span<const int64_t> shape,
+        std::span<const std::byte> prev_state,
+        size_t num_frames,
+        int level = ZstdCompressor::DEFAULT_COMPRESSION_LEVEL,
+        std::span<const double> tick_sizes = {},
+        std::span<const double> error_bounds = {},
+        bool relative_error_bound = false
+    ) const;
+
+  private:
+    // Runs `compress(level)` at the controller's level, records its timing and stamps the level on the chunk.
+    template <typename Compress>
+    [[nodiscard]] ChunkResult compress_adaptive(size_t raw_bytes, Compress&& compress) const;
 };
 
 } // namespace cryptodd
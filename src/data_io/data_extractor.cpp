@@ -1,87 +1,145 @@
 #include "data_extractor.h"
 
+#include <cstring>
 #include <format>
 #include <map>
-#include <mutex>
+#include <numeric>
 #include <optional>
 
+#include "../codecs/chimp_codec.h"
 #include "../codecs/codec_constants.h"
+#include "../codecs/fixed_point_simd_codec.h"
+#include "../codecs/orderbook_bfp16_codec.h"
 #include "../codecs/orderbook_simd_codec.h"
+#include "../codecs/orderbook_sparse_codec.h"
 #include "../codecs/temporal_1d_simd_codec.h"
 #include "../codecs/temporal_2d_simd_codec.h"
 #include "../codecs/zstd_compressor.h"
+#include "../memory/per_thread.h"
+#include "chunk_frames.h"
+#include "thread_pool.h"
 
 
 namespace cryptodd
 {
 
+namespace {
+    // Chunks written before BLOCKED_SHUFFLE existed carry a single set of byte planes over the whole chunk.
+    codecs::ShuffleLayout shuffle_layout_of(const Chunk& chunk)
+    {
+        return chunk.has_flag(ChunkFlags::BLOCKED_SHUFFLE) ? codecs::ShuffleLayout::Blocked : codecs::ShuffleLayout::Global;
+    }
+
+    // Error-bounded chunks prefix the fixed-point payload with their per-column error bounds.
+    bool is_quantized_type(const ChunkDataType type)
+    {
+        return type == ChunkDataType::TEMPORAL_1D_QUANTIZED_F32 || type == ChunkDataType::TEMPORAL_1D_QUANTIZED_F64 ||
+               type == ChunkDataType::TEMPORAL_2D_QUANTIZED_F32 || type == ChunkDataType::TEMPORAL_2D_QUANTIZED_F64;
+    }
+
+    ChunkFlags without_flag(const ChunkFlags flags, const ChunkFlags flag)
+    {
+        using underlying = std::underlying_type_t<ChunkFlags>;
+        return static_cast<ChunkFlags>(static_cast<underlying>(flags) & ~static_cast<underlying>(flag));
+    }
+}
+
 // PIMPL struct to hide implementation details
 struct DataExtractor::Impl
 {
-    mutable std::unique_ptr<ZstdCompressor> zstd_;
-    mutable std::once_flag zstd_init_flag_;
-
-    // Static, fixed-dimension codecs
-    mutable std::unique_ptr<OrderbookSimdCodec<codecs::Orderbook::OKX_DEPTH, codecs::Orderbook::OKX_FEATURES>> okx_ob_codec_;
-    mutable std::once_flag okx_ob_codec_init_flag_;
-    mutable std::unique_ptr<OrderbookSimdCodec<codecs::Orderbook::BINANCE_DEPTH, codecs::Orderbook::BINANCE_FEATURES>> binance_ob_codec_;
-    mutable std::once_flag binance_ob_codec_init_flag_;
-    mutable std::unique_ptr<Temporal1dSimdCodec> temporal_1d_codec_;
-    mutable std::once_flag temporal_1d_codec_init_flag_;
-
-    // Caches for dynamic-dimension codecs
-    mutable std::map<std::tuple<size_t, size_t>, DynamicOrderbookSimdCodec> ob_codecs_;
-    mutable std::mutex ob_codecs_mutex_;
-    mutable std::map<size_t, DynamicTemporal2dSimdCodec> temporal_2d_codecs_;
-    mutable std::mutex temporal_2d_codecs_mutex_;
+    // --- Per-Thread Codec Bundle ---
+    // Decoding goes through stateful zstd contexts, so codecs cannot be shared between threads.
+    // Each thread lazily builds its own set of codecs; once built, lookups are lock-free.
+    struct CodecBundle
+    {
+        // Static, fixed-dimension codecs
+        std::unique_ptr<ZstdCompressor> zstd;
+        std::unique_ptr<OrderbookSimdCodec<codecs::Orderbook::OKX_DEPTH, codecs::Orderbook::OKX_FEATURES>> okx_ob_codec;
+        std::unique_ptr<OrderbookSimdCodec<codecs::Orderbook::BINANCE_DEPTH, codecs::Orderbook::BINANCE_FEATURES>> binance_ob_codec;
+        std::unique_ptr<Temporal1dSimdCodec> temporal_1d_codec;
+        std::unique_ptr<FixedPointSimdCodec> fixed_point_codec;
+        std::unique_ptr<OrderbookBfp16Codec> bfp16_ob_codec;
+        std::unique_ptr<OrderbookSparseCodec> sparse_ob_codec;
+
+        // Caches for dynamic-dimension codecs
+        std::map<std::tuple<size_t, size_t>, DynamicOrderbookSimdCodec> ob_codecs;
+        std::map<size_t, DynamicTemporal2dSimdCodec> temporal_2d_codecs;
+    };
+
+    memory::PerThread<CodecBundle> bundles_;
+
+    // Chimp decoding keeps no state outside the call, so one instance serves all threads.
+    ChimpCodec chimp_codec_;
 
     // Helper methods for lazy initialization
     [[nodiscard]] ZstdCompressor& get_zstd() const
     {
-        std::call_once(zstd_init_flag_, [this]() { zstd_ = std::make_unique<ZstdCompressor>(); });
-        return *zstd_;
+        auto& bundle = bundles_.local();
+        if (!bundle.zstd) bundle.zstd = std::make_unique<ZstdCompressor>();
+        return *bundle.zstd;
     }
 
     [[nodiscard]] const OrderbookSimdCodec<codecs::Orderbook::OKX_DEPTH, codecs::Orderbook::OKX_FEATURES>& get_okx_ob_codec() const
     {
-        std::call_once(okx_ob_codec_init_flag_,
-                       [this]() { okx_ob_codec_ = std::make_unique<OrderbookSimdCodec<codecs::Orderbook::OKX_DEPTH, codecs::Orderbook::OKX_FEATURES>>(create_compressor()); });
-        return *okx_ob_codec_;
+        auto& bundle = bundles_.local();
+        if (!bundle.okx_ob_codec) bundle.okx_ob_codec = std::make_unique<OrderbookSimdCodec<codecs::Orderbook::OKX_DEPTH, codecs::Orderbook::OKX_FEATURES>>(create_compressor());
+        return *bundle.okx_ob_codec;
     }
 
     [[nodiscard]] const OrderbookSimdCodec<codecs::Orderbook::BINANCE_DEPTH, codecs::Orderbook::BINANCE_FEATURES>& get_binance_ob_codec() const
     {
-        std::call_once(binance_ob_codec_init_flag_,
-                       [this]() { binance_ob_codec_ = std::make_unique<OrderbookSimdCodec<codecs::Orderbook::BINANCE_DEPTH, codecs::Orderbook::BINANCE_FEATURES>>(create_compressor()); });
-        return *binance_ob_codec_;
+        auto& bundle = bundles_.local();
+        if (!bundle.binance_ob_codec) bundle.binance_ob_codec = std::make_unique<OrderbookSimdCodec<codecs::Orderbook::BINANCE_DEPTH, codecs::Orderbook::BINANCE_FEATURES>>(create_compressor());
+        return *bundle.binance_ob_codec;
     }
 
-    [[nodiscard]] DynamicOrderbookSimdCodec& get_ob_codec(const size_t depth, const size_t features)
+    [[nodiscard]] DynamicOrderbookSimdCodec& get_ob_codec(const size_t depth, const size_t features) const
     {
+        auto& ob_codecs = bundles_.local().ob_codecs;
         const std::tuple<size_t, size_t> shape = {depth, features};
-        std::lock_guard lock(ob_codecs_mutex_);
-        auto it = ob_codecs_.find(shape);
-        if (it == ob_codecs_.end())
+        auto it = ob_codecs.find(shape);
+        if (it == ob_codecs.end())
         {
-            it = ob_codecs_.try_emplace(shape, depth, features, create_compressor()).first;
+            it = ob_codecs.try_emplace(shape, depth, features, create_compressor()).first;
         }
         return it->second;
     }
 
     [[nodiscard]] const Temporal1dSimdCodec& get_temporal_1d_codec() const
     {
-        std::call_once(temporal_1d_codec_init_flag_,
-                       [this]() { temporal_1d_codec_ = std::make_unique<Temporal1dSimdCodec>(create_compressor()); });
-        return *temporal_1d_codec_;
+        auto& bundle = bundles_.local();
+        if (!bundle.temporal_1d_codec) bundle.temporal_1d_codec = std::make_unique<Temporal1dSimdCodec>(create_compressor());
+        return *bundle.temporal_1d_codec;
+    }
+
+    [[nodiscard]] const FixedPointSimdCodec& get_fixed_point_codec() const
+    {
+        auto& bundle = bundles_.local();
+        if (!bundle.fixed_point_codec) bundle.fixed_point_codec = std::make_unique<FixedPointSimdCodec>(create_compressor());
+        return *bundle.fixed_point_codec;
+    }
+
+    [[nodiscard]] const OrderbookBfp16Codec& get_bfp16_ob_codec() const
+    {
+        auto& bundle = bundles_.local();
+        if (!bundle.bfp16_ob_codec) bundle.bfp16_ob_codec = std::make_unique<OrderbookBfp16Codec>(create_compressor());
+        return *bundle.bfp16_ob_codec;
+    }
+
+    [[nodiscard]] const OrderbookSparseCodec& get_sparse_ob_codec() const
+    {
+        auto& bundle = bundles_.local();
+        if (!bundle.sparse_ob_codec) bundle.sparse_ob_codec = std::make_unique<OrderbookSparseCodec>(create_compressor());
+        return *bundle.sparse_ob_codec;
     }
 
-    [[nodiscard]] DynamicTemporal2dSimdCodec& get_temporal_2d_codec(const size_t num_features)
+    [[nodiscard]] DynamicTemporal2dSimdCodec& get_temporal_2d_codec(const size_t num_features) const
     {
-        std::lock_guard lock(temporal_2d_codecs_mutex_);
-        auto it = temporal_2d_codecs_.find(num_features);
-        if (it == temporal_2d_codecs_.end())
+        auto& temporal_2d_codecs = bundles_.local().temporal_2d_codecs;
+        auto it = temporal_2d_codecs.find(num_features);
+        if (it == temporal_2d_codecs.end())
         {
-            it = temporal_2d_codecs_.try_emplace(num_features, num_features, create_compressor()).first;
+            it = temporal_2d_codecs.try_emplace(num_features, num_features, create_compressor()).first;
         }
         return it->second;
     }
@@ -137,8 +195,8 @@ struct DataExtractor::Impl
             std::copy_n(prev_snapshot_state.begin(), prev_snapshot_arr.size(), prev_snapshot_arr.begin());
 
             auto res = (chunk.type() == ChunkDataType::OKX_OB_SIMD_F16_AS_F32)
-                           ? codec.decode16(buffer->as_bytes(), num_snapshots, prev_snapshot_arr)
-                           : codec.decode32(buffer->as_bytes(), num_snapshots, prev_snapshot_arr);
+                           ? codec.decode16(buffer->as_bytes(), num_snapshots, prev_snapshot_arr, shuffle_layout_of(chunk))
+                           : codec.decode32(buffer->as_bytes(), num_snapshots, prev_snapshot_arr, shuffle_layout_of(chunk));
             if (!res) return std::unexpected(CodecError::from_string(res.error()));
             std::copy_n(prev_snapshot_arr.begin(), prev_snapshot_state.size(), prev_snapshot_state.begin());
             decoded_result = std::move(*res);
@@ -155,18 +213,34 @@ struct DataExtractor::Impl
             std::copy_n(prev_snapshot_state.begin(), prev_snapshot_arr.size(), prev_snapshot_arr.begin());
 
             auto res = (chunk.type() == ChunkDataType::BINANCE_OB_SIMD_F16_AS_F32)
-                           ? codec.decode16(buffer->as_bytes(), num_snapshots, prev_snapshot_arr)
-                           : codec.decode32(buffer->as_bytes(), num_snapshots, prev_snapshot_arr);
+                           ? codec.decode16(buffer->as_bytes(), num_snapshots, prev_snapshot_arr, shuffle_layout_of(chunk))
+                           : codec.decode32(buffer->as_bytes(), num_snapshots, prev_snapshot_arr, shuffle_layout_of(chunk));
             if (!res) return std::unexpected(CodecError::from_string(res.error()));
             std::copy_n(prev_snapshot_arr.begin(), prev_snapshot_state.size(), prev_snapshot_state.begin());
             decoded_result = std::move(*res);
         }
+        else if (chunk.type() == ChunkDataType::GENERIC_OB_SIMD_BFP16_AS_F32)
+        {
+            if (prev_snapshot_state.size() != depth * features) return std::unexpected(CodecError{ErrorCode::InvalidStateSize, "BFP16 orderbook prev_snapshot_state size mismatch"});
+            auto res = get_bfp16_ob_codec().decode(buffer->as_bytes(), num_snapshots, depth, features);
+            if (!res) return std::unexpected(CodecError::from_string(res.error()));
+            // The chunk does not depend on prev_snapshot_state, but still hands its last snapshot on.
+            if (num_snapshots > 0) std::copy_n(res->end() - static_cast<std::ptrdiff_t>(prev_snapshot_state.size()), prev_snapshot_state.size(), prev_snapshot_state.begin());
+            decoded_result = std::move(*res);
+        }
+        else if (chunk.type() == ChunkDataType::GENERIC_OB_SIMD_SPARSE_F32)
+        {
+            if (prev_snapshot_state.size() != depth * features) return std::unexpected(CodecError{ErrorCode::InvalidStateSize, "Sparse orderbook prev_snapshot_state size mismatch"});
+            auto res = get_sparse_ob_codec().decode(buffer->as_bytes(), num_snapshots, prev_snapshot_state);
+            if (!res) return std::unexpected(CodecError::from_string(res.error()));
+            decoded_result = std::move(*res);
+        }
         else // GENERIC_OB_SIMD
         {
             auto& codec = get_ob_codec(depth, features);
             auto res = (chunk.type() == ChunkDataType::GENERIC_OB_SIMD_F16_AS_F32)
-                           ? codec.decode16(buffer->as_bytes(), num_snapshots, prev_snapshot_state)
-                           : codec.decode32(buffer->as_bytes(), num_snapshots, prev_snapshot_state);
+                           ? codec.decode16(buffer->as_bytes(), num_snapshots, prev_snapshot_state, shuffle_layout_of(chunk))
+                           : codec.decode32(buffer->as_bytes(), num_snapshots, prev_snapshot_state, shuffle_layout_of(chunk));
             if (!res) return std::unexpected(CodecError::from_string(res.error()));
             decoded_result = std::move(*res);
         }
@@ -179,7 +253,7 @@ struct DataExtractor::Impl
         return std::make_unique<Buffer>(std::move(*decoded_result));
     }
 
-    [[nodiscard]] DataExtractor::BufferResult handle_temporal_1d_chunk(const Chunk& chunk, std::unique_ptr<Buffer> buffer, float& prev_element)
+    [[nodiscard]] DataExtractor::BufferResult handle_temporal_1d_chunk(const Chunk& chunk, std::unique_ptr<Buffer> buffer, float& prev_element, const codecs::BlockVisitor& on_block = {})
     {
         if (chunk.get_shape().size() != 1)
         {
@@ -193,17 +267,27 @@ struct DataExtractor::Impl
         case ChunkDataType::TEMPORAL_1D_SIMD_F16_XOR_SHUFFLE_AS_F32:
             {
                 if (chunk.dtype() != DType::FLOAT32) return std::unexpected(CodecError{ErrorCode::InvalidDataType, "Expected FLOAT32 dtype for TEMPORAL_1D_SIMD_F16_XOR_SHUFFLE_AS_F32."});
-                auto result = codec.decode16_Xor_Shuffle(buffer->as_bytes(), num_elements, prev_element);
+                auto result = codec.decode16_Xor_Shuffle(buffer->as_bytes(), num_elements, prev_element, shuffle_layout_of(chunk), on_block);
                 if (!result) return std::unexpected(CodecError::from_string(result.error()));
                 return std::make_unique<Buffer>(std::move(*result));
             }
         case ChunkDataType::TEMPORAL_1D_SIMD_F32_XOR_SHUFFLE:
             {
                 if (chunk.dtype() != DType::FLOAT32) return std::unexpected(CodecError{ErrorCode::InvalidDataType, "Expected FLOAT32 dtype for TEMPORAL_1D_SIMD_F32_XOR_SHUFFLE."});
-                auto result = codec.decode32_Xor_Shuffle(buffer->as_bytes(), num_elements, prev_element);
+                auto result = codec.decode32_Xor_Shuffle(buffer->as_bytes(), num_elements, prev_element, shuffle_layout_of(chunk), on_block);
                 if (!result) return std::unexpected(CodecError::from_string(result.error()));
                 return std::make_unique<Buffer>(std::move(*result));
             }
+        case ChunkDataType::TEMPORAL_1D_CHIMP_F32:
+            {
+                if (chunk.dtype() != DType::FLOAT32) return std::unexpected(CodecError{ErrorCode::InvalidDataType, "Expected FLOAT32 dtype for TEMPORAL_1D_CHIMP_F32."});
+                auto result = chimp_codec_.decode32(buffer->as_bytes(), num_elements, prev_element);
+                if (!result) return std::unexpected(CodecError::from_string(result.error(), ErrorCode::DecompressionFailure));
+                return std::make_unique<Buffer>(std::move(*result));
+            }
+        case ChunkDataType::TEMPORAL_1D_FIXED_POINT_F32:
+        case ChunkDataType::TEMPORAL_1D_QUANTIZED_F32:
+            return handle_fixed_point_chunk(chunk, std::move(buffer), std::as_writable_bytes(std::span(&prev_element, 1)));
         default:
             return std::unexpected(CodecError{ErrorCode::InvalidDataType, "Chunk type does not match float state for 1D temporal codec."});
         }
@@ -234,11 +318,59 @@ struct DataExtractor::Impl
                 if (!result) return std::unexpected(CodecError::from_string(result.error()));
                 return std::make_unique<Buffer>(std::move(*result));
             }
+        case ChunkDataType::TEMPORAL_1D_SIMD_I64_DOUBLE_DELTA:
+            {
+                if (chunk.dtype() != DType::INT64) return std::unexpected(CodecError{ErrorCode::InvalidDataType, "Expected INT64 dtype for TEMPORAL_1D_SIMD_I64_DOUBLE_DELTA."});
+                auto result = codec.decode64_DoubleDelta(buffer->as_bytes(), num_elements, prev_element);
+                if (!result) return std::unexpected(CodecError::from_string(result.error()));
+                return std::make_unique<Buffer>(std::move(*result));
+            }
+        case ChunkDataType::TEMPORAL_1D_SIMD_I64_DELTA_BITPACK:
+        case ChunkDataType::TEMPORAL_1D_SIMD_I64_DELTA_BITPACK_ZSTD:
+            {
+                if (chunk.dtype() != DType::INT64) return std::unexpected(CodecError{ErrorCode::InvalidDataType, "Expected INT64 dtype for bit-packed 1D delta codec."});
+                auto result = codec.decode64_Delta_BitPack(buffer->as_bytes(), num_elements, prev_element,
+                                                           chunk.type() == ChunkDataType::TEMPORAL_1D_SIMD_I64_DELTA_BITPACK_ZSTD);
+                if (!result) return std::unexpected(CodecError::from_string(result.error(), ErrorCode::DecompressionFailure));
+                return std::make_unique<Buffer>(std::move(*result));
+            }
         default:
             return std::unexpected(CodecError{ErrorCode::InvalidDataType, "Chunk type does not match int64 state for 1D temporal codec."});
         }
     }
 
+    [[nodiscard]] DataExtractor::BufferResult handle_temporal_1d_chunk(const Chunk& chunk, std::unique_ptr<Buffer> buffer, double& prev_element, const codecs::BlockVisitor& on_block = {})
+    {
+        if (chunk.get_shape().size() != 1)
+        {
+            return std::unexpected(CodecError{ErrorCode::InvalidChunkShape, std::format("Temporal 1D chunk must have 1 dimension, but got {}.", chunk.get_shape().size())});
+        }
+        const size_t num_elements = chunk.num_elements();
+
+        switch (chunk.type())
+        {
+        case ChunkDataType::TEMPORAL_1D_CHIMP_F64:
+            {
+                if (chunk.dtype() != DType::FLOAT64) return std::unexpected(CodecError{ErrorCode::InvalidDataType, "Expected FLOAT64 dtype for TEMPORAL_1D_CHIMP_F64."});
+                auto result = chimp_codec_.decode64(buffer->as_bytes(), num_elements, prev_element);
+                if (!result) return std::unexpected(CodecError::from_string(result.error(), ErrorCode::DecompressionFailure));
+                return std::make_unique<Buffer>(std::move(*result));
+            }
+        case ChunkDataType::TEMPORAL_1D_SIMD_F64_XOR_SHUFFLE:
+            {
+                if (chunk.dtype() != DType::FLOAT64) return std::unexpected(CodecError{ErrorCode::InvalidDataType, "Expected FLOAT64 dtype for TEMPORAL_1D_SIMD_F64_XOR_SHUFFLE."});
+                auto result = get_temporal_1d_codec().decode64_Xor_Shuffle(buffer->as_bytes(), num_elements, prev_element, shuffle_layout_of(chunk), on_block);
+                if (!result) return std::unexpected(CodecError::from_string(result.error()));
+                return std::make_unique<Buffer>(std::move(*result));
+            }
+        case ChunkDataType::TEMPORAL_1D_FIXED_POINT_F64:
+        case ChunkDataType::TEMPORAL_1D_QUANTIZED_F64:
+            return handle_fixed_point_chunk(chunk, std::move(buffer), std::as_writable_bytes(std::span(&prev_element, 1)));
+        default:
+            return std::unexpected(CodecError{ErrorCode::InvalidDataType, "Chunk type does not match double state for 1D temporal codec."});
+        }
+    }
+
     [[nodiscard]] DataExtractor::BufferResult handle_temporal_2d_chunk(const Chunk& chunk, std::unique_ptr<Buffer> buffer, std::span<float> prev_row)
     {
         if (chunk.get_shape().size() != 2)
@@ -264,22 +396,62 @@ struct DataExtractor::Impl
         case ChunkDataType::TEMPORAL_2D_SIMD_F16_AS_F32:
             {
                 if (chunk.dtype() != DType::FLOAT32) return std::unexpected(CodecError{ErrorCode::InvalidDataType, "Expected FLOAT32 dtype for TEMPORAL_2D_SIMD_F16_AS_F32."});
-                auto result = codec.decode16(buffer->as_bytes(), prev_row);
+                auto result = codec.decode16(buffer->as_bytes(), prev_row, shuffle_layout_of(chunk));
                 if (!result) return std::unexpected(CodecError::from_string(result.error()));
                 return std::make_unique<Buffer>(std::move(*result));
             }
         case ChunkDataType::TEMPORAL_2D_SIMD_F32:
             {
                 if (chunk.dtype() != DType::FLOAT32) return std::unexpected(CodecError{ErrorCode::InvalidDataType, "Expected FLOAT32 dtype for TEMPORAL_2D_SIMD_F32."});
-                auto result = codec.decode32(buffer->as_bytes(), prev_row);
+                auto result = codec.decode32(buffer->as_bytes(), prev_row, shuffle_layout_of(chunk));
                 if (!result) return std::unexpected(CodecError::from_string(result.error()));
                 return std::make_unique<Buffer>(std::move(*result));
             }
+        case ChunkDataType::TEMPORAL_2D_FIXED_POINT_F32:
+        case ChunkDataType::TEMPORAL_2D_QUANTIZED_F32:
+            return handle_fixed_point_chunk(chunk, std::move(buffer), std::as_writable_bytes(prev_row));
         default:
             return std::unexpected(CodecError{ErrorCode::InvalidDataType, "Chunk type does not match float state for 2D temporal codec."});
         }
     }
 
+    [[nodiscard]] DataExtractor::BufferResult handle_temporal_2d_chunk(const Chunk& chunk, std::unique_ptr<Buffer> buffer, std::span<double> prev_row)
+    {
+        if (chunk.get_shape().size() != 2)
+        {
+            return std::unexpected(CodecError{ErrorCode::InvalidChunkShape, std::format("Temporal 2D chunk must have 2 dimensions, but got {}.", chunk.get_shape().size())});
+        }
+        const auto shape = chunk.get_shape();
+        if (shape[1] < 0)
+        {
+            return std::unexpected(
+                CodecError{ErrorCode::InvalidChunkShape, "Temporal 2D chunk has a negative shape dimension."});
+        }
+        const size_t num_features = static_cast<size_t>(shape[1]);
+        if (prev_row.size() != num_features)
+        {
+            return std::unexpected(CodecError{ErrorCode::InvalidStateSize, std::format("Previous row size mismatch. Expected {}, got {}.", num_features, prev_row.size())});
+        }
+
+        auto& codec = get_temporal_2d_codec(num_features);
+
+        switch (chunk.type())
+        {
+        case ChunkDataType::TEMPORAL_2D_SIMD_F64:
+            {
+                if (chunk.dtype() != DType::FLOAT64) return std::unexpected(CodecError{ErrorCode::InvalidDataType, "Expected FLOAT64 dtype for TEMPORAL_2D_SIMD_F64."});
+                auto result = codec.decode64_Xor_Shuffle(buffer->as_bytes(), prev_row, shuffle_layout_of(chunk));
+                if (!result) return std::unexpected(CodecError::from_string(result.error()));
+                return std::make_unique<Buffer>(std::move(*result));
+            }
+        case ChunkDataType::TEMPORAL_2D_FIXED_POINT_F64:
+        case ChunkDataType::TEMPORAL_2D_QUANTIZED_F64:
+            return handle_fixed_point_chunk(chunk, std::move(buffer), std::as_writable_bytes(prev_row));
+        default:
+            return std::unexpected(CodecError{ErrorCode::InvalidDataType, "Chunk type does not match double state for 2D temporal codec."});
+        }
+    }
+
     [[nodiscard]] DataExtractor::BufferResult handle_temporal_2d_chunk(const Chunk& chunk, std::unique_ptr<Buffer> buffer, std::span<int64_t> prev_row)
     {
         if (chunk.get_shape().size() != 2)
@@ -309,10 +481,210 @@ struct DataExtractor::Impl
                 if (!result) return std::unexpected(CodecError::from_string(result.error()));
                 return std::make_unique<Buffer>(std::move(*result));
             }
+        case ChunkDataType::TEMPORAL_2D_SIMD_I64_DOUBLE_DELTA:
+            {
+                if (chunk.dtype() != DType::INT64) return std::unexpected(CodecError{ErrorCode::InvalidDataType, "Expected INT64 dtype for TEMPORAL_2D_SIMD_I64_DOUBLE_DELTA."});
+                auto result = codec.decode64_DoubleDelta(buffer->as_bytes(), prev_row);
+                if (!result) return std::unexpected(CodecError::from_string(result.error()));
+                return std::make_unique<Buffer>(std::move(*result));
+            }
+        case ChunkDataType::TEMPORAL_2D_SIMD_I64_DELTA:
+        case ChunkDataType::TEMPORAL_2D_SIMD_I64_DELTA_SHUFFLE:
+            {
+                if (chunk.dtype() != DType::INT64) return std::unexpected(CodecError{ErrorCode::InvalidDataType, "Expected INT64 dtype for TEMPORAL_2D_SIMD_I64_DELTA."});
+                auto result = codec.decode64_Delta(buffer->as_bytes(), prev_row, chunk.type() == ChunkDataType::TEMPORAL_2D_SIMD_I64_DELTA_SHUFFLE,
+                                                   shuffle_layout_of(chunk));
+                if (!result) return std::unexpected(CodecError::from_string(result.error()));
+                return std::make_unique<Buffer>(std::move(*result));
+            }
         default:
             return std::unexpected(CodecError{ErrorCode::InvalidDataType, "Chunk type does not match int64 state for 2D temporal codec."});
         }
     }
+
+    /**
+     * Decodes any fixed-point or quantized chunk type. These chunks do not depend on the previous chunk, but
+     * `state`, when not empty, still receives the last row so callers can chain chunks of mixed types.
+     */
+    [[nodiscard]] DataExtractor::BufferResult handle_fixed_point_chunk(const Chunk& chunk, std::unique_ptr<Buffer> buffer, std::span<std::byte> state) const
+    {
+        const auto geometry = chunk_frames::row_geometry(chunk.type(), chunk.get_shape());
+        if (!geometry) return std::unexpected(CodecError::from_string(geometry.error(), ErrorCode::InvalidChunkShape));
+        if (chunk.dtype() != geometry->dtype) return std::unexpected(CodecError{ErrorCode::InvalidDataType, "Chunk dtype does not match its fixed-point chunk type."});
+        if (!state.empty() && state.size() != geometry->row_bytes())
+        {
+            return std::unexpected(CodecError{ErrorCode::InvalidStateSize, std::format("Previous state size mismatch. Expected {} bytes, got {}.", geometry->row_bytes(), state.size())});
+        }
+
+        const auto layout = chunk.type() == ChunkDataType::ORDERBOOK_FIXED_POINT_F32 ? FixedPointLayout::Rows : FixedPointLayout::Columns;
+        const bool bounded = is_quantized_type(chunk.type());
+        auto& codec = get_fixed_point_codec();
+        std::unique_ptr<Buffer> output;
+        if (geometry->dtype == DType::FLOAT64)
+        {
+            auto result = bounded ? codec.decode_bounded64(buffer->as_bytes(), geometry->num_rows, geometry->row_elements)
+                                  : codec.decode64(buffer->as_bytes(), layout, geometry->num_rows, geometry->row_elements);
+            if (!result) return std::unexpected(CodecError::from_string(result.error(), ErrorCode::DecompressionFailure));
+            output = std::make_unique<Buffer>(std::move(*result));
+        }
+        else
+        {
+            auto result = bounded ? codec.decode_bounded32(buffer->as_bytes(), geometry->num_rows, geometry->row_elements)
+                                  : codec.decode32(buffer->as_bytes(), layout, geometry->num_rows, geometry->row_elements);
+            if (!result) return std::unexpected(CodecError::from_string(result.error(), ErrorCode::DecompressionFailure));
+            output = std::make_unique<Buffer>(std::move(*result));
+        }
+
+        if (!state.empty() && geometry->num_rows > 0)
+        {
+            chunk_frames::extract_row(*geometry, output->as_bytes().data(), geometry->num_rows - 1, state.data());
+        }
+        return output;
+    }
+
+    // Decodes a single frame of a MULTI_FRAME chunk with the regular handlers.
+    // `state` holds the frame's prev state on entry and its last row on exit.
+    [[nodiscard]] DataExtractor::BufferResult decode_frame(const Chunk& frame, std::unique_ptr<Buffer> buffer, std::span<std::byte> state)
+    {
+        switch (frame.type())
+        {
+        case ChunkDataType::TEMPORAL_1D_FIXED_POINT_F32:
+        case ChunkDataType::TEMPORAL_1D_QUANTIZED_F32:
+        case ChunkDataType::TEMPORAL_1D_FIXED_POINT_F64:
+        case ChunkDataType::TEMPORAL_1D_QUANTIZED_F64:
+        case ChunkDataType::TEMPORAL_2D_FIXED_POINT_F32:
+        case ChunkDataType::TEMPORAL_2D_QUANTIZED_F32:
+        case ChunkDataType::TEMPORAL_2D_FIXED_POINT_F64:
+        case ChunkDataType::TEMPORAL_2D_QUANTIZED_F64:
+        case ChunkDataType::ORDERBOOK_FIXED_POINT_F32:
+            return handle_fixed_point_chunk(frame, std::move(buffer), state);
+        case ChunkDataType::TEMPORAL_1D_SIMD_F16_XOR_SHUFFLE_AS_F32:
+        case ChunkDataType::TEMPORAL_1D_SIMD_F32_XOR_SHUFFLE:
+        case ChunkDataType::TEMPORAL_1D_CHIMP_F32:
+            {
+                float prev_element;
+                std::memcpy(&prev_element, state.data(), sizeof(prev_element));
+                auto result = handle_temporal_1d_chunk(frame, std::move(buffer), prev_element);
+                std::memcpy(state.data(), &prev_element, sizeof(prev_element));
+                return result;
+            }
+        case ChunkDataType::TEMPORAL_1D_SIMD_I64_XOR:
+        case ChunkDataType::TEMPORAL_1D_SIMD_I64_DELTA:
+        case ChunkDataType::TEMPORAL_1D_SIMD_I64_DELTA_BITPACK:
+        case ChunkDataType::TEMPORAL_1D_SIMD_I64_DELTA_BITPACK_ZSTD:
+        case ChunkDataType::TEMPORAL_1D_SIMD_I64_DOUBLE_DELTA:
+            {
+                int64_t prev_element;
+                std::memcpy(&prev_element, state.data(), sizeof(prev_element));
+                auto result = handle_temporal_1d_chunk(frame, std::move(buffer), prev_element);
+                std::memcpy(state.data(), &prev_element, sizeof(prev_element));
+                return result;
+            }
+        case ChunkDataType::TEMPORAL_1D_CHIMP_F64:
+        case ChunkDataType::TEMPORAL_1D_SIMD_F64_XOR_SHUFFLE:
+            {
+                double prev_element;
+                std::memcpy(&prev_element, state.data(), sizeof(prev_element));
+                auto result = handle_temporal_1d_chunk(frame, std::move(buffer), prev_element);
+                std::memcpy(state.data(), &prev_element, sizeof(prev_element));
+                return result;
+            }
+        case ChunkDataType::TEMPORAL_2D_SIMD_F16_AS_F32:
+        case ChunkDataType::TEMPORAL_2D_SIMD_F32:
+            return handle_temporal_2d_chunk(frame, std::move(buffer), std::span(reinterpret_cast<float*>(state.data()), state.size() / sizeof(float)));
+        case ChunkDataType::TEMPORAL_2D_SIMD_F64:
+            return handle_temporal_2d_chunk(frame, std::move(buffer), std::span(reinterpret_cast<double*>(state.data()), state.size() / sizeof(double)));
+        case ChunkDataType::TEMPORAL_2D_SIMD_I64:
+        case ChunkDataType::TEMPORAL_2D_SIMD_I64_DOUBLE_DELTA:
+        case ChunkDataType::TEMPORAL_2D_SIMD_I64_DELTA:
+        case ChunkDataType::TEMPORAL_2D_SIMD_I64_DELTA_SHUFFLE:
+            return handle_temporal_2d_chunk(frame, std::move(buffer), std::span(reinterpret_cast<int64_t*>(state.data()), state.size() / sizeof(int64_t)));
+        default:
+            return handle_orderbook_chunk(frame, std::move(buffer), std::span(reinterpret_cast<float*>(state.data()), state.size() / sizeof(float)));
+        }
+    }
+
+    /**
+     * Decodes every frame of a MULTI_FRAME chunk concurrently on the shared thread pool and stitches
+     * the rows back together. Frame 0 starts from `prev_state`, which receives the chunk's last row.
+     */
+    [[nodiscard]] DataExtractor::BufferResult handle_multi_frame_chunk(const Chunk& chunk, std::span<std::byte> prev_state)
+    {
+        const auto geometry = chunk_frames::row_geometry(chunk.type(), chunk.get_shape());
+        if (!geometry) return std::unexpected(CodecError::from_string(geometry.error(), ErrorCode::InvalidChunkShape));
+        if (prev_state.size() != geometry->row_bytes())
+        {
+            return std::unexpected(CodecError{ErrorCode::InvalidStateSize, std::format("Previous state size mismatch. Expected {} bytes, got {}.", geometry->row_bytes(), prev_state.size())});
+        }
+        const auto table = chunk_frames::parse(chunk.data(), *geometry);
+        if (!table) return std::unexpected(CodecError::from_string(table.error(), ErrorCode::DecompressionFailure));
+
+        const size_t num_frames = table->size();
+        memory::vector<uint64_t> first_rows(num_frames, 0);
+        std::exclusive_scan(table->rows.begin(), table->rows.end(), first_rows.begin(), uint64_t{0});
+
+        const size_t num_values = geometry->num_rows * geometry->row_elements;
+        std::unique_ptr<Buffer> output;
+        switch (geometry->dtype)
+        {
+        case DType::INT64:
+            output = std::make_unique<Buffer>(details::Int64AlignedVector(num_values));
+            break;
+        case DType::FLOAT64:
+            output = std::make_unique<Buffer>(details::Float64AlignedVector(num_values));
+            break;
+        default:
+            output = std::make_unique<Buffer>(details::Float32AlignedVector(num_values));
+            break;
+        }
+        const std::span<std::byte> output_bytes = output->as_bytes();
+
+        memory::vector<std::optional<CodecError>> errors(num_frames);
+        ThreadPool::shared().parallel_for(num_frames, [&](const size_t i) {
+            Chunk frame;
+            frame.set_type(chunk.type());
+            frame.set_dtype(chunk.dtype());
+            memory::vector<int64_t> frame_shape(chunk.get_shape().begin(), chunk.get_shape().end());
+            frame_shape[0] = static_cast<int64_t>(table->rows[i]);
+            frame.set_shape(std::move(frame_shape));
+            frame.set_flags(without_flag(chunk.flags(), ChunkFlags::MULTI_FRAME));
+
+            const auto frame_state = i == 0 ? std::span<const std::byte>(prev_state) : table->state(i);
+            memory::vector<std::byte> state(frame_state.begin(), frame_state.end());
+            auto buffer = std::make_unique<Buffer>(memory::vector<std::byte>(table->frames[i].begin(), table->frames[i].end()));
+            auto result = decode_frame(frame, std::move(buffer), state);
+            if (!result)
+            {
+                errors[i] = result.error();
+                return;
+            }
+            const auto decoded = (*result)->as_bytes();
+            if (decoded.size() != table->rows[i] * geometry->row_bytes())
+            {
+                errors[i] = CodecError{ErrorCode::InvalidDataSize, std::format("Frame {} decoded to {} bytes, expected {}.", i, decoded.size(), table->rows[i] * geometry->row_bytes())};
+                return;
+            }
+            chunk_frames::scatter_rows(*geometry, decoded.data(), first_rows[i], table->rows[i], output_bytes.data());
+            if (i + 1 == num_frames)
+            {
+                std::ranges::copy(state, prev_state.begin());
+            }
+        });
+
+        for (const auto& error : errors)
+        {
+            if (error) return std::unexpected(*error);
+        }
+        return output;
+    }
+
+    [[nodiscard]] DataExtractor::BufferResult handle_multi_frame_chunk(const Chunk& chunk)
+    {
+        const auto geometry = chunk_frames::row_geometry(chunk.type(), chunk.get_shape());
+        if (!geometry) return std::unexpected(CodecError::from_string(geometry.error(), ErrorCode::InvalidChunkShape));
+        memory::vector<std::byte> prev_state(geometry->row_bytes(), std::byte{0});
+        return handle_multi_frame_chunk(chunk, prev_state);
+    }
 };
 
 DataExtractor::DataExtractor() : pimpl_(std::make_unique<Impl>()) {}
@@ -322,6 +694,13 @@ DataExtractor& DataExtractor::operator=(DataExtractor&&) noexcept = default;
 
 DataExtractor::BufferResult DataExtractor::read_chunk(Chunk& chunk)
 {
+    return read_chunk(chunk, codecs::BlockVisitor{});
+}
+
+DataExtractor::BufferResult DataExtractor::read_chunk(Chunk& chunk, const codecs::BlockVisitor& on_raw_block)
+{
+    if (chunk.has_flag(ChunkFlags::MULTI_FRAME)) return pimpl_->handle_multi_frame_chunk(chunk);
+
     // The initial buffer contains the raw (potentially compressed) data from the chunk.
     auto buffer = std::make_unique<Buffer>(std::move(chunk.data()));
 
@@ -339,6 +718,8 @@ DataExtractor::BufferResult DataExtractor::read_chunk(Chunk& chunk)
     case ChunkDataType::BINANCE_OB_SIMD_F32:
     case ChunkDataType::GENERIC_OB_SIMD_F16_AS_F32:
     case ChunkDataType::GENERIC_OB_SIMD_F32:
+    case ChunkDataType::GENERIC_OB_SIMD_BFP16_AS_F32:
+    case ChunkDataType::GENERIC_OB_SIMD_SPARSE_F32:
         {
             const auto shape = chunk.get_shape();
             if (shape.size() < 3 || shape[1] < 0 || shape[2] < 0) {
@@ -350,15 +731,37 @@ DataExtractor::BufferResult DataExtractor::read_chunk(Chunk& chunk)
             return pimpl_->handle_orderbook_chunk(chunk, std::move(buffer), prev_snapshot);
         }
 
+    case ChunkDataType::TEMPORAL_1D_FIXED_POINT_F32:
+    case ChunkDataType::TEMPORAL_1D_QUANTIZED_F32:
+    case ChunkDataType::TEMPORAL_1D_FIXED_POINT_F64:
+    case ChunkDataType::TEMPORAL_1D_QUANTIZED_F64:
+    case ChunkDataType::TEMPORAL_2D_FIXED_POINT_F32:
+    case ChunkDataType::TEMPORAL_2D_QUANTIZED_F32:
+    case ChunkDataType::TEMPORAL_2D_FIXED_POINT_F64:
+    case ChunkDataType::TEMPORAL_2D_QUANTIZED_F64:
+    case ChunkDataType::ORDERBOOK_FIXED_POINT_F32:
+        return pimpl_->handle_fixed_point_chunk(chunk, std::move(buffer), {});
+
     case ChunkDataType::TEMPORAL_1D_SIMD_F16_XOR_SHUFFLE_AS_F32:
     case ChunkDataType::TEMPORAL_1D_SIMD_F32_XOR_SHUFFLE:
+    case ChunkDataType::TEMPORAL_1D_CHIMP_F32:
         {
             float prev_element = 0.0f;
-            return pimpl_->handle_temporal_1d_chunk(chunk, std::move(buffer), prev_element);
+            return pimpl_->handle_temporal_1d_chunk(chunk, std::move(buffer), prev_element, on_raw_block);
+        }
+
+    case ChunkDataType::TEMPORAL_1D_CHIMP_F64:
+    case ChunkDataType::TEMPORAL_1D_SIMD_F64_XOR_SHUFFLE:
+        {
+            double prev_element = 0.0;
+            return pimpl_->handle_temporal_1d_chunk(chunk, std::move(buffer), prev_element, on_raw_block);
         }
 
     case ChunkDataType::TEMPORAL_1D_SIMD_I64_XOR:
     case ChunkDataType::TEMPORAL_1D_SIMD_I64_DELTA:
+    case ChunkDataType::TEMPORAL_1D_SIMD_I64_DELTA_BITPACK:
+    case ChunkDataType::TEMPORAL_1D_SIMD_I64_DELTA_BITPACK_ZSTD:
+    case ChunkDataType::TEMPORAL_1D_SIMD_I64_DOUBLE_DELTA:
         {
             int64_t prev_element = 0;
             return pimpl_->handle_temporal_1d_chunk(chunk, std::move(buffer), prev_element);
@@ -376,7 +779,21 @@ DataExtractor::BufferResult DataExtractor::read_chunk(Chunk& chunk)
             return pimpl_->handle_temporal_2d_chunk(chunk, std::move(buffer), prev_row);
         }
 
+    case ChunkDataType::TEMPORAL_2D_SIMD_F64:
+        {
+            const auto shape = chunk.get_shape();
+            if (shape.size() < 2 || shape[1] < 0) {
+                 return std::unexpected(CodecError{ErrorCode::InvalidChunkShape, "Temporal 2D chunk has invalid shape for state initialization."});
+            }
+            const size_t num_features = static_cast<size_t>(shape[1]);
+            memory::vector<double> prev_row(num_features, 0.0);
+            return pimpl_->handle_temporal_2d_chunk(chunk, std::move(buffer), prev_row);
+        }
+
     case ChunkDataType::TEMPORAL_2D_SIMD_I64:
+    case ChunkDataType::TEMPORAL_2D_SIMD_I64_DOUBLE_DELTA:
+    case ChunkDataType::TEMPORAL_2D_SIMD_I64_DELTA:
+    case ChunkDataType::TEMPORAL_2D_SIMD_I64_DELTA_SHUFFLE:
         {
             const auto shape = chunk.get_shape();
             if (shape.size() < 2 || shape[1] < 0) {
@@ -394,32 +811,48 @@ DataExtractor::BufferResult DataExtractor::read_chunk(Chunk& chunk)
 
 DataExtractor::BufferResult DataExtractor::read_chunk(Chunk& chunk, float& prev_element)
 {
+    if (chunk.has_flag(ChunkFlags::MULTI_FRAME)) return pimpl_->handle_multi_frame_chunk(chunk, std::as_writable_bytes(std::span(&prev_element, 1)));
+    auto buffer = std::make_unique<Buffer>(std::move(chunk.data()));
+    return pimpl_->handle_temporal_1d_chunk(chunk, std::move(buffer), prev_element);
+}
+
+DataExtractor::BufferResult DataExtractor::read_chunk(Chunk& chunk, double& prev_element)
+{
+    if (chunk.has_flag(ChunkFlags::MULTI_FRAME)) return pimpl_->handle_multi_frame_chunk(chunk, std::as_writable_bytes(std::span(&prev_element, 1)));
     auto buffer = std::make_unique<Buffer>(std::move(chunk.data()));
     return pimpl_->handle_temporal_1d_chunk(chunk, std::move(buffer), prev_element);
 }
 
 DataExtractor::BufferResult DataExtractor::read_chunk(Chunk& chunk, int64_t& prev_element)
 {
+    if (chunk.has_flag(ChunkFlags::MULTI_FRAME)) return pimpl_->handle_multi_frame_chunk(chunk, std::as_writable_bytes(std::span(&prev_element, 1)));
     auto buffer = std::make_unique<Buffer>(std::move(chunk.data()));
     return pimpl_->handle_temporal_1d_chunk(chunk, std::move(buffer), prev_element);
 }
 
 DataExtractor::BufferResult DataExtractor::read_chunk(Chunk& chunk, std::span<float> prev_row)
 {
+    if (chunk.has_flag(ChunkFlags::MULTI_FRAME)) return pimpl_->handle_multi_frame_chunk(chunk, std::as_writable_bytes(prev_row));
     switch (chunk.type())
     {
     case ChunkDataType::TEMPORAL_2D_SIMD_F16_AS_F32:
     case ChunkDataType::TEMPORAL_2D_SIMD_F32:
+    case ChunkDataType::TEMPORAL_2D_FIXED_POINT_F32:
+    case ChunkDataType::TEMPORAL_2D_QUANTIZED_F32:
         {
             auto buffer = std::make_unique<Buffer>(std::move(chunk.data()));
             return pimpl_->handle_temporal_2d_chunk(chunk, std::move(buffer), prev_row);
         }
+    case ChunkDataType::ORDERBOOK_FIXED_POINT_F32:
+        return pimpl_->handle_fixed_point_chunk(chunk, std::make_unique<Buffer>(std::move(chunk.data())), std::as_writable_bytes(prev_row));
     case ChunkDataType::OKX_OB_SIMD_F16_AS_F32:
     case ChunkDataType::OKX_OB_SIMD_F32:
     case ChunkDataType::BINANCE_OB_SIMD_F16_AS_F32:
     case ChunkDataType::BINANCE_OB_SIMD_F32:
     case ChunkDataType::GENERIC_OB_SIMD_F16_AS_F32:
     case ChunkDataType::GENERIC_OB_SIMD_F32:
+    case ChunkDataType::GENERIC_OB_SIMD_BFP16_AS_F32:
+    case ChunkDataType::GENERIC_OB_SIMD_SPARSE_F32:
         {
             // This overload is for both 2D and 3D, so we must forward to the correct implementation.
             return pimpl_->handle_orderbook_chunk(chunk, std::make_unique<Buffer>(std::move(chunk.data())), prev_row);
@@ -431,6 +864,7 @@ DataExtractor::BufferResult DataExtractor::read_chunk(Chunk& chunk, std::span<fl
 
 DataExtractor::BufferResult DataExtractor::read_chunk(Chunk& chunk, std::span<int64_t> prev_row)
 {
+    if (chunk.has_flag(ChunkFlags::MULTI_FRAME)) return pimpl_->handle_multi_frame_chunk(chunk, std::as_writable_bytes(prev_row));
     auto buffer = std::make_unique<Buffer>(std::move(chunk.data()));
     return pimpl_->handle_temporal_2d_chunk(chunk, std::move(buffer), prev_row);
 }
@@ -5,6 +5,7 @@
 
 #include "buffer.h"
 #include "codec_error.h" // Include the new error header
+#include "../codecs/codec_constants.h" // For codecs::BlockVisitor
 #include <expected>
 #include <memory>
 #include <span>
@@ -28,8 +29,14 @@ class DataExtractor
     // Stateless overload (default zero-init for prev_state)
     BufferResult read_chunk(Chunk& chunk);
 
+    // Stateless overload that also passes each block of decoded bytes to `on_raw_block` while it is in cache.
+    // Only codecs that reconstruct block by block call it (the 1D XOR+shuffle ones), and then over the whole
+    // output in order; callers compare the bytes seen with the buffer size to know whether it ran.
+    BufferResult read_chunk(Chunk& chunk, const codecs::BlockVisitor& on_raw_block);
+
     // Overloads for stateful decoding of temporal data
     BufferResult read_chunk(Chunk& chunk, float& prev_element); // For 1D float
+    BufferResult read_chunk(Chunk& chunk, double& prev_element); // For 1D double
     BufferResult read_chunk(Chunk& chunk, int64_t& prev_element); // For 1D int64
     BufferResult read_chunk(Chunk& chunk, std::span<float> prev_row); // For 2D float or Orderbook
     BufferResult read_chunk(Chunk& chunk, std::span<int64_t> prev_row); // For 2D int64
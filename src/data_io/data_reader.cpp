@@ -1,10 +1,13 @@
 #include "data_reader.h"
 
 #include "blake3_stream_hasher.h"
+#include "../storage/buffered_file_backend.h"
 #include "../storage/file_backend.h"
 #include "../storage/memory_backend.h"
+#include "../storage/mio_backend.h"
 #include "../file_format/serialization_helpers.h"
 
+#include <algorithm>
 #include <filesystem> // For std::filesystem::exists
 #include <format>
 #include <span>
@@ -39,126 +42,157 @@ DataReader::DataReader(Create, std::unique_ptr<IStorageBackend>&& backend,
         }
 
         index_block_offset_ = *tell_res;
-        uint64_t total_index_size = 0;
-        uint64_t current_block_offset = *tell_res;
+        auto scan_res = scan_index(index_block_offset_);
+        if (!scan_res)
+        {
+            return std::unexpected(scan_res.error());
+        }
+        master_chunk_offsets_ = std::move(scan_res->chunk_offsets);
+        index_block_size_ = scan_res->total_size;
+        index_blocks_ = std::move(scan_res->blocks);
+        return {};
+    }();
+
+    if (!read_header)
+    {
+        throw std::runtime_error(read_header.error());
+    }
+}
+
+std::expected<DataReader::IndexScan, std::string> DataReader::scan_index(const uint64_t first_block_offset)
+{
+    IndexScan scan;
+    uint64_t current_block_offset = first_block_offset;
+
+    while (current_block_offset != 0)
+    {
+        if (auto seek_res = backend_->seek(current_block_offset); !seek_res)
+        {
+            return std::unexpected(seek_res.error());
+        }
+
+        auto size_res = serialization::read_pod<uint32_t>(*backend_);
+        if (!size_res)
+        {
+            return std::unexpected("Failed to read block size: " + size_res.error());
+        }
+        const uint32_t block_size_on_disk = *size_res;
+
+        auto type_res = serialization::read_pod<ChunkOffsetType>(*backend_);
+        if (!type_res)
+        {
+            return std::unexpected("Failed to read block type: " + type_res.error());
+        }
+        const auto block_type = *type_res;
+
+        auto hash_res = serialization::read_pod<blake3_hash256_t>(*backend_);
+        if (!hash_res)
+        {
+            return std::unexpected("Failed to read block hash: " + hash_res.error());
+        }
+        const auto block_hash = *hash_res;
+
+        auto next_offset_res = serialization::read_pod<uint64_t>(*backend_);
+        if (!next_offset_res)
+        {
+            return std::unexpected("Failed to read next block offset: " + next_offset_res.error());
+        }
+
+        scan.total_size += block_size_on_disk;
+        scan.blocks.push_back({current_block_offset, block_size_on_disk});
+        memory::vector<uint64_t> offsets;
 
-        while (current_block_offset != 0)
+        if (block_type == ChunkOffsetType::RAW)
         {
-            if (auto seek_res = backend_->seek(current_block_offset); !seek_res)
+            auto payload_res = serialization::read_vector_pod<uint64_t>(*backend_);
+            if (!payload_res)
             {
-                return std::unexpected(seek_res.error());
+                return std::unexpected("Failed to read RAW block payload: " + payload_res.error());
             }
+            offsets = std::move(*payload_res);
 
-            auto size_res = serialization::read_pod<uint32_t>(*backend_);
-            if (!size_res)
+            const auto raw_payload_bytes =
+                serialization::serialize_vector_pod_to_buffer(std::span<const uint64_t>(offsets));
+            Blake3StreamHasher block_hasher;
+            block_hasher.update(std::span<const std::byte>(raw_payload_bytes));
+            if (block_hasher.finalize_256() != block_hash)
             {
-                return std::unexpected("Failed to read block size: " + size_res.error());
+                return std::unexpected("RAW ChunkOffsetsBlock integrity check failed.");
             }
-            const uint32_t block_size_on_disk = *size_res;
-
-            auto type_res = serialization::read_pod<ChunkOffsetType>(*backend_);
-            if (!type_res)
+        }
+        else if (block_type == ChunkOffsetType::ZSTD_COMPRESSED || block_type == ChunkOffsetType::DELTA_BITPACK)
+        {
+            auto compressed_blob_res = serialization::read_blob(*backend_);
+            if (!compressed_blob_res)
             {
-                return std::unexpected("Failed to read block type: " + type_res.error());
+                return std::unexpected("Failed to read compressed block blob: " + compressed_blob_res.error());
             }
-            const auto block_type = *type_res;
 
-            auto hash_res = serialization::read_pod<blake3_hash256_t>(*backend_);
-            if (!hash_res)
+            const size_t header_and_ptr_size =
+                sizeof(uint32_t) + sizeof(uint16_t) + sizeof(blake3_hash256_t) + sizeof(uint64_t);
+            const size_t raw_payload_size = block_size_on_disk - header_and_ptr_size;
+            const size_t num_elements = (raw_payload_size - sizeof(uint32_t)) / sizeof(uint64_t);
+
+            auto cache_ptr = codec_cache_allocator_->acquire();
+            int64_t prev_element = 0;
+            auto decoded_res = block_type == ChunkOffsetType::DELTA_BITPACK
+                                   ? cache_ptr->codec.decode64_Delta_BitPack(*compressed_blob_res, num_elements, prev_element)
+                                   : cache_ptr->codec.decode64_Delta(*compressed_blob_res, num_elements, prev_element);
+            if (!decoded_res)
             {
-                return std::unexpected("Failed to read block hash: " + hash_res.error());
+                return std::unexpected("SIMD delta decoding failed: " + decoded_res.error());
             }
-            const auto block_hash = *hash_res;
 
-            auto next_offset_res = serialization::read_pod<uint64_t>(*backend_);
-            if (!next_offset_res)
+            const auto raw_payload_bytes =
+                serialization::serialize_vector_pod_to_buffer(std::span<const int64_t>(*decoded_res));
+            Blake3StreamHasher block_hasher;
+            block_hasher.update(std::span<const std::byte>(raw_payload_bytes));
+            if (block_hasher.finalize_256() != block_hash)
             {
-                return std::unexpected("Failed to read next block offset: " + next_offset_res.error());
+                return std::unexpected("Compressed ChunkOffsetsBlock integrity check failed.");
             }
 
-            total_index_size += block_size_on_disk;
-            memory::vector<uint64_t> offsets;
+            offsets.assign(decoded_res->begin(), decoded_res->end());
+        }
+        else
+        {
+            return std::unexpected("Unknown ChunkOffsetsBlock type.");
+        }
 
-            if (block_type == ChunkOffsetType::RAW)
-            {
-                auto payload_res = serialization::read_vector_pod<uint64_t>(*backend_);
-                if (!payload_res)
-                {
-                    return std::unexpected("Failed to read RAW block payload: " + payload_res.error());
-                }
-                offsets = std::move(*payload_res);
-
-                const auto raw_payload_bytes =
-                    serialization::serialize_vector_pod_to_buffer(std::span<const uint64_t>(offsets));
-                Blake3StreamHasher block_hasher;
-                block_hasher.update(std::span<const std::byte>(raw_payload_bytes));
-                if (block_hasher.finalize_256() != block_hash)
-                {
-                    return std::unexpected("RAW ChunkOffsetsBlock integrity check failed.");
-                }
-            }
-            else if (block_type == ChunkOffsetType::ZSTD_COMPRESSED)
+        for (const auto offset : offsets)
+        {
+            if (offset != 0)
             {
-                auto compressed_blob_res = serialization::read_blob(*backend_);
-                if (!compressed_blob_res)
-                {
-                    return std::unexpected("Failed to read ZSTD blob: " + compressed_blob_res.error());
-                }
-
-                const size_t header_and_ptr_size =
-                    sizeof(uint32_t) + sizeof(uint16_t) + sizeof(blake3_hash256_t) + sizeof(uint64_t);
-                const size_t raw_payload_size = block_size_on_disk - header_and_ptr_size;
-                const size_t num_elements = (raw_payload_size - sizeof(uint32_t)) / sizeof(uint64_t);
-
-                auto cache_ptr = codec_cache_allocator_->acquire();
-                int64_t prev_element = 0;
-                auto decoded_res = cache_ptr->codec.decode64_Delta(*compressed_blob_res, num_elements, prev_element);
-                if (!decoded_res)
-                {
-                    return std::unexpected("SIMD delta decoding failed: " + decoded_res.error());
-                }
-
-                const auto raw_payload_bytes =
-                    serialization::serialize_vector_pod_to_buffer(std::span<const int64_t>(*decoded_res));
-                Blake3StreamHasher block_hasher;
-                block_hasher.update(std::span<const std::byte>(raw_payload_bytes));
-                if (block_hasher.finalize_256() != block_hash)
-                {
-                    return std::unexpected("ZSTD ChunkOffsetsBlock integrity check failed.");
-                }
-
-                offsets.assign(decoded_res->begin(), decoded_res->end());
+                scan.chunk_offsets.push_back(offset);
             }
             else
             {
-                return std::unexpected("Unknown ChunkOffsetsBlock type.");
-            }
-
-            for (const auto offset : offsets)
-            {
-                if (offset != 0)
-                {
-                    master_chunk_offsets_.push_back(offset);
-                }
-                else
-                {
-                    break;
-                }
+                break;
             }
-            current_block_offset = *next_offset_res;
         }
+        current_block_offset = *next_offset_res;
+    }
 
-        index_block_size_ = total_index_size;
-        return {};
-    }();
+    return scan;
+}
 
-    if (!read_header)
+std::expected<size_t, std::string> DataReader::verify_index()
+{
+    auto scan_res = scan_index(index_block_offset_);
+    if (!scan_res)
     {
-        throw std::runtime_error(read_header.error());
+        return std::unexpected(scan_res.error());
     }
+    if (scan_res->chunk_offsets.size() != master_chunk_offsets_.size() ||
+        !std::equal(scan_res->chunk_offsets.begin(), scan_res->chunk_offsets.end(), master_chunk_offsets_.begin()))
+    {
+        return std::unexpected("The chunk index on disk no longer matches the index read when the file was opened.");
+    }
+    return scan_res->blocks.size();
 }
 
-std::expected<std::unique_ptr<DataReader>, std::string> DataReader::open(const std::filesystem::path& filepath)
+std::expected<std::unique_ptr<DataReader>, std::string> DataReader::open(const std::filesystem::path& filepath,
+                                                                         const FileReaderOptions& options)
 {
     if (!std::filesystem::exists(filepath))
     {
@@ -166,8 +200,60 @@ std::expected<std::unique_ptr<DataReader>, std::string> DataReader::open(const s
     }
     try
     {
-        auto backend = std::make_unique<storage::FileBackend>(filepath, std::ios_base::in | std::ios_base::binary);
-        return std::make_unique<DataReader>(Create{}, std::move(backend));
+        using storage::AccessHint;
+        constexpr auto mode = std::ios_base::in | std::ios_base::binary;
+        std::unique_ptr<IStorageBackend> backend;
+        storage::MioBackend* mapping = nullptr;
+        if (options.memory_map)
+        {
+            if (options.direct_io)
+            {
+                return std::unexpected("direct_io and memory_map cannot be combined.");
+            }
+            auto mio = std::make_unique<storage::MioBackend>(filepath, mode, options.map);
+            mapping = mio.get();
+            backend = std::move(mio);
+        }
+        else if (options.direct_io)
+        {
+            backend = std::make_unique<storage::BufferedFileBackend>(
+                filepath, mode, storage::WriteBufferOptions{.block_size = options.read_window, .direct_io = true});
+        }
+        else if (options.access == AccessHint::SEQUENTIAL || options.access == AccessHint::RANDOM)
+        {
+            // Readahead hints only apply to the descriptor they are given, which FileBackend's stream keeps to itself.
+            // Random reads get a one-sector window: enough for a chunk header, while payloads bypass it.
+            const size_t window = options.access == AccessHint::RANDOM ? storage::BufferedFileBackend::IO_ALIGNMENT
+                                                                      : options.read_window;
+            backend = std::make_unique<storage::BufferedFileBackend>(filepath, mode,
+                                                                     storage::WriteBufferOptions{.block_size = window});
+        }
+        else
+        {
+            backend = std::make_unique<storage::FileBackend>(filepath, mode);
+        }
+        if (auto advised = backend->advise(options.access); !advised)
+        {
+            return std::unexpected(std::format("Failed to open file '{}': {}", filepath.string(), advised.error()));
+        }
+        auto reader = std::make_unique<DataReader>(Create{}, std::move(backend));
+        reader->access_ = options.access;
+        if (mapping && options.lock_index)
+        {
+            // The header, then every index block. The reader works the same without the lock, so a refusal is kept
+            // for the caller rather than failing the open.
+            auto locked = mapping->lock(0, reader->index_block_offset_);
+            for (size_t i = 0; locked && i < reader->index_blocks_.size(); ++i)
+            {
+                locked = mapping->lock(reader->index_blocks_[i].offset, reader->index_blocks_[i].size);
+            }
+            if (!locked)
+            {
+                reader->index_lock_error_ = std::format("Failed to lock the index of '{}': {}", filepath.string(),
+                                                        locked.error());
+            }
+        }
+        return reader;
     }
     catch (const std::exception& e)
     {
@@ -196,6 +282,62 @@ std::expected<std::unique_ptr<DataReader>, std::string> DataReader::open_in_memo
     return open_in_memory(std::move(std::make_unique<storage::MemoryBackend>()));
 }
 
+std::expected<bool, std::string> DataReader::advise(const storage::AccessHint hint, const uint64_t offset,
+                                                    const uint64_t length)
+{
+    return backend_->advise(hint, offset, length);
+}
+
+std::expected<bool, std::string> DataReader::advise_chunks(const storage::AccessHint hint, const size_t first,
+                                                           const size_t count)
+{
+    if (count == 0)
+    {
+        return false;
+    }
+    if (first >= master_chunk_offsets_.size() || count > master_chunk_offsets_.size() - first)
+    {
+        return std::unexpected(std::format("Chunks [{}, {}) are out of range (total chunks: {}).", first, first + count,
+                                           master_chunk_offsets_.size()));
+    }
+    const uint64_t start = master_chunk_offsets_[first];
+    const size_t next = first + count;
+    if (next == master_chunk_offsets_.size())
+    {
+        return backend_->advise(hint, start, 0);
+    }
+    // Chunks are laid out in index order; an index that is not gives no way to bound the range, and a hint can go.
+    if (master_chunk_offsets_[next] <= start)
+    {
+        return false;
+    }
+    return backend_->advise(hint, start, master_chunk_offsets_[next] - start);
+}
+
+std::expected<size_t, std::string> DataReader::prefetch_chunks(const std::span<const size_t> indices)
+{
+    size_t advised = 0;
+    for (size_t i = 0; i < indices.size();)
+    {
+        size_t run = 1;
+        while (i + run < indices.size() && indices[i + run] == indices[i] + run)
+        {
+            ++run;
+        }
+        auto res = advise_chunks(storage::AccessHint::WILLNEED, indices[i], run);
+        if (!res)
+        {
+            return std::unexpected(res.error());
+        }
+        if (*res)
+        {
+            advised += run;
+        }
+        i += run;
+    }
+    return advised;
+}
+
 std::expected<Chunk, std::string> DataReader::get_chunk(const size_t index)
 {
     if (index >= master_chunk_offsets_.size())
@@ -7,9 +7,11 @@
 #include <expected>
 #include <filesystem>
 #include <mutex>
+#include <optional>
 #include <span>
 
 #include "../storage/i_storage_backend.h"
+#include "../storage/mio_backend.h"
 #include "../file_format/cdd_file_format.h"
 #include "../codecs/zstd_compressor.h"
 
@@ -18,9 +20,38 @@
 
 namespace cryptodd {
 
+    /** @brief How DataReader::open() reads a file. */
+    struct FileReaderOptions {
+        // Read around the page cache (O_DIRECT) through an aligned window of `read_window` bytes, so scanning a large
+        // file does not evict what latency-sensitive readers cache. Meant for sequential scans: each read outside
+        // the window fetches a whole window. A SEQUENTIAL access hint reads through the same window without it.
+        bool direct_io = false;
+        size_t read_window = size_t{1} << 20;
+        // How the file will be read (SEQUENTIAL or RANDOM set the readahead, WILLNEED starts reading it all), applied
+        // before the index is read. Ignored with direct_io, which has no readahead.
+        storage::AccessHint access = storage::AccessHint::NORMAL;
+        // Read through a memory mapping of the file (MioBackend) set up with `map`, instead of read calls. Excludes
+        // direct_io.
+        bool memory_map = false;
+        storage::MapOptions map;
+        // With memory_map: mlock the header and the index blocks, so they stay resident while scans churn the page
+        // cache. Only best effort: a lock refused (e.g. past RLIMIT_MEMLOCK) leaves the reader open, see
+        // DataReader::index_lock_error().
+        bool lock_index = false;
+    };
+
     class DataReader {
     using IStorageBackend = storage::IStorageBackend;
 
+public:
+    // Where one ChunkOffsetsBlock lies in the file.
+    struct IndexBlockExtent {
+        uint64_t offset;
+        uint64_t size;
+    };
+
+private:
+
     std::unique_ptr<storage::IStorageBackend> backend_;
     FileHeader file_header_;
     memory::vector<uint64_t> master_chunk_offsets_; // Consolidated index of all chunk offsets
@@ -29,11 +60,23 @@ namespace cryptodd {
 
     uint64_t index_block_offset_{0};
     uint64_t index_block_size_{0};
+    memory::vector<IndexBlockExtent> index_blocks_;
+    storage::AccessHint access_{storage::AccessHint::NORMAL};
+    std::optional<std::string> index_lock_error_;
 
     std::shared_ptr<ChunkOffsetCodecAllocator> codec_cache_allocator_;
 
     ZstdCompressor& get_zstd_compressor() const;
 
+    struct IndexScan {
+        memory::vector<uint64_t> chunk_offsets;
+        uint64_t total_size{0};
+        memory::vector<IndexBlockExtent> blocks;
+    };
+
+    // Walks the ChunkOffsetsBlock chain starting at `first_block_offset`, checking the hash of every block.
+    std::expected<IndexScan, std::string> scan_index(uint64_t first_block_offset);
+
 public:
     /**
      * @brief Private construction key.
@@ -48,7 +91,8 @@ public:
     explicit DataReader(Create, std::unique_ptr<IStorageBackend>&& backend,
                         std::shared_ptr<ChunkOffsetCodecAllocator> codec_allocator = get_chunk_offset_codec_allocator());
     // Factory function for opening a file for reading. Returns an error on failure.
-    static std::expected<std::unique_ptr<DataReader>, std::string> open(const std::filesystem::path& filepath);
+    static std::expected<std::unique_ptr<DataReader>, std::string> open(const std::filesystem::path& filepath,
+                                                                        const FileReaderOptions& options = {});
 
     // Factory function for opening an in-memory backend for reading. Returns an error on failure.
     static std::expected<std::unique_ptr<DataReader>, std::string> open_in_memory(std::unique_ptr<storage::IStorageBackend> backend);
@@ -64,6 +108,32 @@ public:
 
     [[nodiscard]] uint64_t get_index_block_offset() const { return index_block_offset_; }
     [[nodiscard]] uint64_t get_index_block_size() const { return index_block_size_; }
+    [[nodiscard]] std::span<const IndexBlockExtent> get_index_blocks() const { return index_blocks_; }
+
+    // File offsets of the chunks, in index order.
+    [[nodiscard]] std::span<const uint64_t> get_chunk_offsets() const { return master_chunk_offsets_; }
+
+    // The access hint given at open (FileReaderOptions::access).
+    [[nodiscard]] storage::AccessHint access_hint() const { return access_; }
+
+    // Why FileReaderOptions::lock_index could not lock the whole index, if it could not.
+    [[nodiscard]] const std::optional<std::string>& index_lock_error() const { return index_lock_error_; }
+
+    // Passes an access hint for [offset, offset + length) of the file (0: to the end) to the backend. Returns whether
+    // it reached the OS: a FileBackend only acts on WILLNEED, and direct I/O on none.
+    std::expected<bool, std::string> advise(storage::AccessHint hint, uint64_t offset = 0, uint64_t length = 0);
+
+    // Passes an access hint for the bytes of chunks [first, first + count), up to the next chunk's offset or, for the
+    // last chunk, the end of the file. Returns whether the hint reached the OS.
+    std::expected<bool, std::string> advise_chunks(storage::AccessHint hint, size_t first, size_t count);
+
+    // Starts reading the given chunks into the page cache in the background (WILLNEED), one hint per run of
+    // consecutive indices. Returns the number of chunks whose hint reached the OS.
+    std::expected<size_t, std::string> prefetch_chunks(std::span<const size_t> indices);
+
+    // Re-reads the chunk index from storage and checks every block's hash, and that it still lists the chunks
+    // found at open. Returns the number of index blocks.
+    std::expected<size_t, std::string> verify_index();
 
     // Retrieves a specific chunk by its index. Returns an error on failure.
     std::expected<Chunk, std::string> get_chunk(size_t index);
@@ -0,0 +1,163 @@
+#include "data_verifier.h"
+#include "data_extractor.h"
+#include "data_reader.h"
+#include "thread_pool.h"
+#include "../file_format/chunk_hash.h"
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <format>
+#include <exception>
+#include <future>
+#include <thread>
+
+namespace cryptodd
+{
+
+namespace
+{
+    struct ChunkOutcome
+    {
+        size_t index = 0;
+        uint64_t raw_bytes = 0;
+        bool hashed = true;
+        std::optional<std::string> fault;
+    };
+
+    ChunkOutcome verify_chunk(DataExtractor& extractor, const size_t index, Chunk& chunk)
+    {
+        ChunkOutcome outcome{.index = index};
+        const ChunkFlags flags = chunk.flags();
+        outcome.hashed = chunk_has_hash(flags);
+
+        // Lossy chunks store the hash of their payload.
+        if (outcome.hashed && chunk.has_flag(ChunkFlags::RECONSTRUCTION_NOT_PERFECT) &&
+            calculate_chunk_hash(chunk.data(), flags) != chunk.hash())
+        {
+            outcome.fault = "Checksum mismatch.";
+            return outcome;
+        }
+
+        const bool hash_decoded = outcome.hashed && !chunk.has_flag(ChunkFlags::RECONSTRUCTION_NOT_PERFECT);
+        ChunkHasher hasher(flags);
+        auto decoded = hash_decoded
+            ? extractor.read_chunk(chunk, [&hasher](const std::span<const std::byte> block) { hasher.update(block); })
+            : extractor.read_chunk(chunk);
+        if (!decoded)
+        {
+            outcome.fault = "Decode failed: " + decoded.error().to_string();
+            return outcome;
+        }
+        const auto raw = (*decoded)->as_bytes();
+        outcome.raw_bytes = raw.size();
+        if (!hash_decoded) return outcome;
+
+        // Codecs without a block loop never call the visitor.
+        const auto hash = hasher.size() == raw.size() ? hasher.finalize() : calculate_chunk_hash(raw, flags);
+        if (hash != chunk.hash())
+        {
+            outcome.fault = "Checksum mismatch.";
+        }
+        return outcome;
+    }
+
+    // Waits for every task still queued, so none outlives the state it references when verify_file unwinds.
+    struct DrainOnExit
+    {
+        std::deque<std::future<ChunkOutcome>>& pending;
+
+        ~DrainOnExit()
+        {
+            for (auto& future : pending)
+            {
+                if (future.valid()) future.wait();
+            }
+        }
+    };
+}
+
+std::expected<VerifyReport, std::string> verify_file(DataReader& reader, const VerifyOptions& options)
+{
+    if (options.max_read_mbps < 0.0)
+    {
+        return std::unexpected("max_read_mbps cannot be negative.");
+    }
+
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+    VerifyReport report;
+
+    if (auto index = reader.verify_index())
+    {
+        report.index_blocks = *index;
+    }
+    else
+    {
+        report.index_error = index.error();
+    }
+
+    auto& pool = ThreadPool::shared();
+    const size_t max_in_flight = options.max_in_flight > 0 ? options.max_in_flight : 2 * std::max<size_t>(pool.size(), 1);
+    // DataExtractor keeps per-thread codecs, so every task can share it.
+    DataExtractor extractor;
+    std::deque<std::future<ChunkOutcome>> in_flight;
+    const DrainOnExit drain{in_flight};
+
+    auto collect = [&report](ChunkOutcome outcome) {
+        if (outcome.fault)
+        {
+            report.corrupted.push_back({outcome.index, std::move(*outcome.fault)});
+            return;
+        }
+        ++report.chunks_verified;
+        report.raw_bytes += outcome.raw_bytes;
+        if (!outcome.hashed) ++report.chunks_unhashed;
+    };
+
+    for (size_t i = 0; i < reader.num_chunks(); ++i)
+    {
+        auto chunk = reader.get_chunk(i);
+        if (!chunk)
+        {
+            report.corrupted.push_back({i, "Read failed: " + chunk.error()});
+            continue;
+        }
+        report.bytes_read += chunk->data().size();
+
+        if (options.max_read_mbps > 0.0)
+        {
+            const auto due = start + std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(static_cast<double>(report.bytes_read) / (options.max_read_mbps * 1e6)));
+            std::this_thread::sleep_until(due);
+        }
+
+        while (in_flight.size() >= max_in_flight)
+        {
+            collect(in_flight.front().get());
+            in_flight.pop_front();
+        }
+        in_flight.push_back(pool.submit([&extractor, i, chunk = std::make_shared<Chunk>(std::move(*chunk))] {
+            // A header that makes a codec throw (e.g. a shape too large to allocate) is one more corrupted chunk.
+            try
+            {
+                return verify_chunk(extractor, i, *chunk);
+            }
+            catch (const std::exception& e)
+            {
+                return ChunkOutcome{.index = i, .fault = std::string("Decode failed: ") + e.what()};
+            }
+        }));
+    }
+    for (auto& pending : in_flight)
+    {
+        collect(pending.get());
+    }
+
+    std::ranges::sort(report.corrupted, {}, &ChunkFault::index);
+    report.elapsed_s = std::chrono::duration<double>(Clock::now() - start).count();
+    report.read_mbps = report.elapsed_s > 0.0 ? static_cast<double>(report.bytes_read) / report.elapsed_s / 1e6 : 0.0;
+    return report;
+}
+
+} // namespace cryptodd
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace cryptodd
+{
+
+class DataReader;
+
+struct VerifyOptions
+{
+    double max_read_mbps = 0.0; // cap on the rate chunks are read from storage, in MB/s of stored bytes; 0 is unlimited
+    size_t max_in_flight = 0;   // chunks read but not yet verified; 0 means twice the thread pool size
+};
+
+/** @brief A chunk that could not be read, decoded or whose hash did not match. */
+struct ChunkFault
+{
+    size_t index;
+    std::string reason;
+};
+
+struct VerifyReport
+{
+    size_t chunks_verified = 0; // chunks read, decoded and, unless unhashed, checked
+    size_t chunks_unhashed = 0; // HASH_NONE chunks: decoded, but there is nothing to compare
+    size_t index_blocks = 0;
+    uint64_t bytes_read = 0;    // stored chunk payloads
+    uint64_t raw_bytes = 0;     // decoded size of the verified chunks
+    std::vector<ChunkFault> corrupted; // sorted by chunk index
+    std::optional<std::string> index_error;
+    double elapsed_s = 0.0;
+    double read_mbps = 0.0; // sustained rate over the whole scrub
+
+    [[nodiscard]] bool ok() const { return corrupted.empty() && !index_error; }
+};
+
+/**
+ * @brief Scrubs every chunk of `reader` and its index.
+ *
+ * Chunks are read one after the other (the reader has a single seekable backend) and verified on the shared
+ * ThreadPool: lossless chunks are decoded and hashed in the same pass without being copied out, lossy ones have
+ * their payload hashed. Corruption is collected rather than fatal, so one bad chunk does not hide the next.
+ * Reading sleeps as needed to stay under `max_read_mbps`.
+ *
+ * Fails only if `options` are invalid.
+ */
+std::expected<VerifyReport, std::string> verify_file(DataReader& reader, const VerifyOptions& options = {});
+
+} // namespace cryptodd
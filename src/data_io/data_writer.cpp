@@ -1,12 +1,15 @@
 #include "data_writer.h"
 
 #include "../file_format/serialization_helpers.h"
+#include "../storage/buffered_file_backend.h"
 #include "../storage/file_backend.h"
 #include "../storage/i_storage_backend.h"
 #include "../storage/memory_backend.h"
 #include "../file_format/blake3_stream_hasher.h"
 #include "../codecs/zstd_compressor.h"
 
+#include <algorithm>
+#include <bit>
 #include <format>
 #include <memory> // For std::make_unique
 
@@ -48,7 +51,11 @@ std::expected<void, std::string> DataWriter::write_new_chunk_offsets_block(uint6
         if (can_use_delta_encoding) {
             std::span<const int64_t> offsets_as_i64(reinterpret_cast<const int64_t*>(offsets.data()), offsets.size());
             
-            auto compressed_res = cache_ptr->codec.encode64_Delta(offsets_as_i64, 0, cache_ptr->workspace);
+            // Bit-packed deltas decode without an entropy stage, which keeps opening large files cheap; delta + zstd
+            // stays the default so that older readers can open the file.
+            auto compressed_res = bitpack_index_
+                                      ? cache_ptr->codec.encode64_Delta_BitPack(offsets_as_i64, 0, cache_ptr->workspace)
+                                      : cache_ptr->codec.encode64_Delta(offsets_as_i64, 0, cache_ptr->workspace);
             if (!compressed_res) {
                 return std::unexpected("SIMD delta encoding failed: " + compressed_res.error());
             }
@@ -56,7 +63,7 @@ std::expected<void, std::string> DataWriter::write_new_chunk_offsets_block(uint6
 
             const size_t compressed_payload_disk_size = sizeof(uint32_t) + compressed_payload.size();
             if (compressed_payload_disk_size < raw_offsets_payload.size()) {
-                prev_block.set_type(ChunkOffsetType::ZSTD_COMPRESSED);
+                prev_block.set_type(bitpack_index_ ? ChunkOffsetType::DELTA_BITPACK : ChunkOffsetType::ZSTD_COMPRESSED);
                 
                 if (auto res = backend_->seek(previous_block_offset); !res) return res;
 
@@ -123,29 +130,65 @@ void DataWriter::set_compression_level(int level) {
     get_zstd_compressor().set_level(level);
 }
 
+namespace {
+    // A BufferedFileBackend staging up to `write_buffer_size` bytes, or a plain FileBackend when it is 0.
+    std::expected<std::unique_ptr<storage::IStorageBackend>, std::string> make_file_backend(const std::filesystem::path& filepath,
+                                                                                            const std::ios_base::openmode mode,
+                                                                                            const FileWriterOptions& file_options) {
+        const size_t write_buffer_size = file_options.write_buffer_size;
+        if (write_buffer_size == 0) {
+            if (file_options.preallocate_extent > 0) {
+                return std::unexpected("Preallocation needs a write buffer (write_buffer_size > 0).");
+            }
+            if (file_options.direct_io) {
+                return std::unexpected("Direct I/O needs a write buffer (write_buffer_size > 0).");
+            }
+            return std::make_unique<storage::FileBackend>(filepath, mode);
+        }
+        storage::WriteBufferOptions options;
+        options.block_size = std::min(options.block_size, write_buffer_size);
+        options.max_buffered_blocks = (write_buffer_size + options.block_size - 1) / options.block_size;
+        options.preallocate_extent = file_options.preallocate_extent;
+        options.direct_io = file_options.direct_io;
+        return std::make_unique<storage::BufferedFileBackend>(filepath, mode, options);
+    }
+
+    std::expected<std::unique_ptr<DataWriter>, std::string> with_file_options(std::unique_ptr<DataWriter> writer,
+                                                                              const FileWriterOptions& file_options) {
+        if (auto res = writer->set_chunk_alignment(file_options.chunk_alignment); !res) return std::unexpected(res.error());
+        writer->set_bitpack_index(file_options.bitpack_index);
+        return writer;
+    }
+}
+
 std::expected<std::unique_ptr<DataWriter>, std::string> DataWriter::create_new(const std::filesystem::path& filepath,
                                                                               size_t chunk_offsets_block_capacity,
-                                                                              std::span<const std::byte> user_metadata) {
+                                                                              std::span<const std::byte> user_metadata,
+                                                                              const FileWriterOptions& file_options) {
     if (std::filesystem::exists(filepath)) {
         return std::unexpected("File already exists: " + filepath.string() + ". Use open_for_append for existing files.");
     }
     try {
-        auto backend = std::make_unique<storage::FileBackend>(filepath, std::ios_base::out | std::ios_base::binary |
-                                                                            std::ios_base::trunc);
-        return std::make_unique<DataWriter>(Create{}, std::move(backend), chunk_offsets_block_capacity, user_metadata);
+        auto backend = make_file_backend(filepath, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc,
+                                         file_options);
+        if (!backend) return std::unexpected(backend.error());
+        return with_file_options(std::make_unique<DataWriter>(Create{}, std::move(*backend), chunk_offsets_block_capacity, user_metadata),
+                                 file_options);
     } catch (const std::exception& e) {
         return std::unexpected(std::format("Failed to create new file '{}': {}", filepath.string(), e.what()));
     }
 }
 
-std::expected<std::unique_ptr<DataWriter>, std::string> DataWriter::open_for_append(const std::filesystem::path& filepath) {
+std::expected<std::unique_ptr<DataWriter>, std::string> DataWriter::open_for_append(const std::filesystem::path& filepath,
+                                                                                   const FileWriterOptions& file_options) {
     if (!std::filesystem::exists(filepath)) {
         return std::unexpected("File does not exist: " + filepath.string() + ". Use create_new for new files.");
     }
     try {
-        auto backend = std::make_unique<storage::FileBackend>(filepath, std::ios_base::in | std::ios_base::out |
-                                                                            std::ios_base::binary);
-        return std::make_unique<DataWriter>(Create{}, std::move(backend));
+        auto backend = make_file_backend(filepath, std::ios_base::in | std::ios_base::out | std::ios_base::binary,
+                                         file_options);
+        if (!backend) return std::unexpected(backend.error());
+        return with_file_options(std::make_unique<DataWriter>(Create{}, std::move(*backend)), file_options);
     } catch (const std::exception& e) {
         return std::unexpected(std::format("Failed to open file for append '{}': {}", filepath.string(), e.what()));
     }
@@ -246,16 +289,20 @@ DataWriter::DataWriter(Create, std::unique_ptr<IStorageBackend>&& backend,
                 auto payload_res = serialization::read_vector_pod<uint64_t>(*backend_);
                 if (!payload_res) return std::unexpected("Failed to read RAW block payload: " + payload_res.error());
                 offsets = std::move(*payload_res);
-            } else if (block_type == ChunkOffsetType::ZSTD_COMPRESSED) {
+            } else if (block_type == ChunkOffsetType::ZSTD_COMPRESSED || block_type == ChunkOffsetType::DELTA_BITPACK) {
                 auto compressed_blob_res = serialization::read_blob(*backend_);
-                if (!compressed_blob_res) return std::unexpected("Failed to read ZSTD blob: " + compressed_blob_res.error());
-
-                auto decompressed_res = get_zstd_compressor().decompress(*compressed_blob_res);
-                if (!decompressed_res) return std::unexpected("Failed to decompress ZSTD block: " + decompressed_res.error());
-                
-                auto payload_res = serialization::deserialize_vector_pod_from_buffer<uint64_t>(*decompressed_res);
-                if (!payload_res) return std::unexpected("Failed to parse decompressed ZSTD payload: " + payload_res.error());
-                offsets = std::move(*payload_res);
+                if (!compressed_blob_res) return std::unexpected("Failed to read compressed block blob: " + compressed_blob_res.error());
+
+                const size_t header_and_ptr_size = sizeof(uint32_t) + sizeof(uint16_t) + sizeof(blake3_hash256_t) + sizeof(uint64_t);
+                const size_t num_elements = (block_size_on_disk - header_and_ptr_size - sizeof(uint32_t)) / sizeof(uint64_t);
+
+                auto cache_ptr = codec_cache_allocator_->acquire();
+                int64_t prev_element = 0;
+                auto decoded_res = block_type == ChunkOffsetType::DELTA_BITPACK
+                                       ? cache_ptr->codec.decode64_Delta_BitPack(*compressed_blob_res, num_elements, prev_element)
+                                       : cache_ptr->codec.decode64_Delta(*compressed_blob_res, num_elements, prev_element);
+                if (!decoded_res) return std::unexpected("SIMD delta decoding failed: " + decoded_res.error());
+                offsets.assign(decoded_res->begin(), decoded_res->end());
             } else {
                 return std::unexpected("Unknown ChunkOffsetsBlock type.");
             }
@@ -381,14 +428,17 @@ std::expected<size_t, std::string> DataWriter::append_chunk(ChunkDataType type,
     auto tell_res = backend_->tell();
     if (!tell_res) return std::unexpected(tell_res.error());
     uint64_t chunk_start_offset = *tell_res;
+    if (chunk_alignment_ > 1 && chunk_start_offset % chunk_alignment_ != 0) {
+        // Seeking past the end leaves the padding to the backend, which fills it with zeros.
+        chunk_start_offset += chunk_alignment_ - chunk_start_offset % chunk_alignment_;
+        if (auto res = backend_->seek(chunk_start_offset); !res) return std::unexpected(res.error());
+    }
 
     if (auto res = chunk.write(*backend_); !res) return std::unexpected(res.error());
 
     auto end_tell_res = backend_->tell();
     if (!end_tell_res) return std::unexpected(end_tell_res.error());
     const uint64_t end_of_chunk_pos = *end_tell_res;
-    
-    if (auto res = backend_->flush(); !res) return std::unexpected(res.error());
 
     auto& current_block = chunk_offset_blocks_.back();
     auto offsets = current_block.offsets();
@@ -415,6 +465,10 @@ std::expected<size_t, std::string> DataWriter::append_chunk(ChunkDataType type,
     if (auto res = backend_->seek(end_of_chunk_pos); !res) return std::unexpected(res.error());
 
     current_chunk_offset_block_index_++;
+
+    if (auto res = sync_after_append(); !res) {
+        return std::unexpected(std::format("Chunk {} was written but not synced: {}", new_chunk_index, res.error()));
+    }
     return new_chunk_index;
 }
 
@@ -439,9 +493,88 @@ std::expected<void, std::string> DataWriter::set_user_metadata(std::span<const s
 }
 
 std::expected<void, std::string> DataWriter::flush() {
+    if (durability_.mode != DurabilityMode::NONE) {
+        return sync(true);
+    }
     return backend_->flush();
 }
 
+std::expected<void, std::string> DataWriter::set_durability(const DurabilityOptions& options) {
+    if (options.mode == DurabilityMode::EVERY_N_CHUNKS && options.every_chunks == 0) {
+        return std::unexpected("Durability every_chunks must be positive.");
+    }
+    if (options.mode == DurabilityMode::INTERVAL && options.interval.count() <= 0) {
+        return std::unexpected("Durability interval must be positive.");
+    }
+    if (options.mode != DurabilityMode::NONE && !sync_file_) {
+        if (const auto path = backend_->file_path()) {
+            auto file = SyncFile::open(*path);
+            if (!file) return std::unexpected(file.error());
+            sync_file_ = std::move(*file);
+        }
+    }
+    durability_ = options;
+    chunks_since_sync_ = 0;
+    last_sync_ = std::chrono::steady_clock::now();
+    return {};
+}
+
+std::expected<void, std::string> DataWriter::set_chunk_alignment(const uint32_t alignment) {
+    if (alignment != 0 && !std::has_single_bit(alignment)) {
+        return std::unexpected(std::format("Chunk alignment must be a power of two, got {}.", alignment));
+    }
+    chunk_alignment_ = alignment;
+    return {};
+}
+
+std::optional<DeviceSyncStats> DataWriter::sync_stats() const {
+    if (!sync_file_) return std::nullopt;
+    return GroupCommitter::shared().stats(sync_file_->device());
+}
+
+std::expected<void, std::string> DataWriter::sync(const bool wait) {
+    chunks_since_sync_ = 0;
+    last_sync_ = std::chrono::steady_clock::now();
+    // The previous sync must have succeeded for this one to mean anything.
+    if (pending_sync_) {
+        const auto previous = pending_sync_->get();
+        pending_sync_.reset();
+        if (!previous) return previous;
+    }
+    if (auto res = backend_->flush(); !res) return res;
+    if (!sync_file_) return {};
+
+    auto ticket = GroupCommitter::shared().submit(sync_file_);
+    if (!wait) {
+        pending_sync_ = std::move(ticket);
+        return {};
+    }
+    return ticket.get();
+}
+
+std::expected<void, std::string> DataWriter::sync_after_append() {
+    switch (durability_.mode) {
+        case DurabilityMode::NONE:
+            return {};
+        case DurabilityMode::EACH_APPEND:
+            return sync(true);
+        case DurabilityMode::EVERY_N_CHUNKS:
+            return ++chunks_since_sync_ >= durability_.every_chunks ? sync(true) : std::expected<void, std::string>{};
+        case DurabilityMode::INTERVAL:
+            break;
+    }
+    // A failed background sync is reported as soon as it is known, not only at the next interval.
+    if (pending_sync_ && pending_sync_->wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        const auto previous = pending_sync_->get();
+        pending_sync_.reset();
+        if (!previous) return previous;
+    }
+    if (std::chrono::steady_clock::now() - last_sync_ >= durability_.interval) {
+        return sync(false);
+    }
+    return {};
+}
+
 [[nodiscard]] std::expected<std::unique_ptr<storage::IStorageBackend>, std::string> DataWriter::release_backend() {
     if (auto res = flush(); !res) {
         backend_.reset();
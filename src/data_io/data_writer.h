@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <expected>
 #include <filesystem>
 #include <memory>
@@ -12,10 +13,29 @@
 #include "../file_format/cdd_file_format.h"
 #include "../storage/i_storage_backend.h"
 #include "chunk_offset_codec_allocator_fwd.h"
+#include "group_commit.h"
 #include "../codecs/zstd_compressor.h"
 
 namespace cryptodd {
 
+/** @brief How a file-backed DataWriter writes to disk. */
+struct FileWriterOptions {
+    // Bytes staged in memory before they are written out (see BufferedFileBackend); 0 writes through an unbuffered
+    // FileBackend. Either way, data is only guaranteed to reach the file on flush().
+    size_t write_buffer_size = size_t{8} << 20;
+    // Disk space reserved ahead of the data, in extents of this many bytes, and trimmed on close; 0 disables it.
+    // Needs the write buffer.
+    uint64_t preallocate_extent = 0;
+    // Write around the page cache (O_DIRECT) so bulk ingest does not evict what readers cache. Needs the write buffer.
+    bool direct_io = false;
+    // Chunks start at multiples of this power of two, zero-padded after the previous one; 0 packs them. Aligning
+    // on BufferedFileBackend::IO_ALIGNMENT lets direct readers fetch a chunk without reading its neighbours' sectors.
+    uint32_t chunk_alignment = 0;
+    // Write index blocks as bit-packed deltas (ChunkOffsetType::DELTA_BITPACK), which open faster than delta + zstd
+    // but cannot be read by readers older than the type.
+    bool bitpack_index = false;
+};
+
 class DataWriter {
     using IStorageBackend = storage::IStorageBackend;
 
@@ -26,14 +46,26 @@ private:
     uint64_t current_chunk_offset_block_start_ = 0;
     size_t current_chunk_offset_block_index_ = 0;
     size_t chunk_offsets_block_capacity_;
+    uint32_t chunk_alignment_ = 0;
+    bool bitpack_index_ = false;
 
     mutable std::unique_ptr<ZstdCompressor> zstd_compressor_;
     mutable std::once_flag zstd_init_flag_;
 
     std::shared_ptr<ChunkOffsetCodecAllocator> codec_cache_allocator_;
 
+    DurabilityOptions durability_;
+    std::shared_ptr<const SyncFile> sync_file_; // null for backends that are not files
+    size_t chunks_since_sync_ = 0;
+    std::chrono::steady_clock::time_point last_sync_;
+    std::optional<GroupCommitter::Ticket> pending_sync_; // INTERVAL syncs are not waited for
+
     ZstdCompressor& get_zstd_compressor() const;
 
+    // Flushes, then syncs through the shared GroupCommitter; `wait` also waits for it. Reports a pending sync's failure.
+    std::expected<void, std::string> sync(bool wait);
+    std::expected<void, std::string> sync_after_append();
+
     std::expected<void, std::string> write_new_chunk_offsets_block(uint64_t previous_block_offset);
 
 public:
@@ -62,18 +94,22 @@ public:
      * @param filepath Path to the new file.
      * @param chunk_offsets_block_capacity The number of chunk offsets to store per block.
      * @param user_metadata Optional user-defined metadata to store in the file header.
+     * @param file_options Buffering and preallocation of the file.
      * @return A unique_ptr to the DataWriter on success, or an error string.
      */
     static std::expected<std::unique_ptr<DataWriter>, std::string> create_new(const std::filesystem::path& filepath,
                                                                               size_t chunk_offsets_block_capacity = DEFAULT_CHUNK_OFFSETS_BLOCK_CAPACITY,
-                                                                              std::span<const std::byte> user_metadata = {});
+                                                                              std::span<const std::byte> user_metadata = {},
+                                                                              const FileWriterOptions& file_options = {});
 
     /**
      * @brief Opens an existing file for appending.
      * @param filepath Path to the existing file.
+     * @param file_options As for create_new().
      * @return A unique_ptr to the DataWriter on success, or an error string.
      */
-    static std::expected<std::unique_ptr<DataWriter>, std::string> open_for_append(const std::filesystem::path& filepath);
+    static std::expected<std::unique_ptr<DataWriter>, std::string> open_for_append(const std::filesystem::path& filepath,
+                                                                                   const FileWriterOptions& file_options = {});
 
     /**
      * @brief Creates a new in-memory writer.
@@ -112,11 +148,36 @@ public:
     std::expected<void, std::string> set_user_metadata(std::span<const std::byte> user_metadata);
 
     /**
-     * @brief Flushes any buffered data to the underlying storage.
+     * @brief Flushes any buffered data to the underlying storage and, unless the durability mode is NONE, waits for
+     * it to be synced to the device.
      * @return void on success, or an error string.
      */
     std::expected<void, std::string> flush();
 
+    /**
+     * @brief Sets when appended chunks are made durable (see DurabilityMode). Fails on an invalid interval or count,
+     * or if the file cannot be opened for syncing. Backends that are not files only flush.
+     */
+    std::expected<void, std::string> set_durability(const DurabilityOptions& options);
+
+    [[nodiscard]] const DurabilityOptions& durability() const { return durability_; }
+
+    /**
+     * @brief Places the chunks appended from now on at multiples of `alignment`, a power of two (0 or 1 packs them).
+     * Readers follow the index, so files mixing aligned and packed chunks read the same.
+     */
+    std::expected<void, std::string> set_chunk_alignment(uint32_t alignment);
+
+    [[nodiscard]] uint32_t chunk_alignment() const { return chunk_alignment_; }
+
+    /** @brief Writes the index blocks finished from now on as DELTA_BITPACK rather than delta + zstd (see FileWriterOptions). */
+    void set_bitpack_index(bool enabled) { bitpack_index_ = enabled; }
+
+    [[nodiscard]] bool bitpack_index() const { return bitpack_index_; }
+
+    /** @brief The sync statistics of the device holding the file, once the writer has synced it. */
+    [[nodiscard]] std::optional<DeviceSyncStats> sync_stats() const;
+
     /**
      * @brief Releases ownership of the underlying storage backend.
      * @return A unique_ptr to the storage backend.
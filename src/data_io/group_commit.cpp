@@ -0,0 +1,235 @@
+#include "group_commit.h"
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cmath>
+#include <condition_variable>
+#include <system_error>
+#include <thread>
+
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#include <share.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace cryptodd
+{
+
+void SyncLatencyHistogram::record(const std::chrono::nanoseconds elapsed)
+{
+    const auto us = static_cast<uint64_t>(std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
+    const size_t bucket = us < 2 ? 0 : std::min<size_t>(std::bit_width(us) - 1, NUM_BUCKETS - 1);
+    ++buckets[bucket];
+    ++count;
+    total_us += us;
+    max_us = std::max(max_us, us);
+}
+
+uint64_t SyncLatencyHistogram::quantile_us(const double q) const
+{
+    if (count == 0) return 0;
+    const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(std::clamp(q, 0.0, 1.0) * static_cast<double>(count))));
+    uint64_t seen = 0;
+    for (size_t b = 0; b + 1 < NUM_BUCKETS; ++b)
+    {
+        seen += buckets[b];
+        if (seen >= rank) return std::min(uint64_t{2} << b, max_us);
+    }
+    return max_us;
+}
+
+// --- SyncFile ---
+
+std::expected<std::shared_ptr<SyncFile>, std::string> SyncFile::open(const std::filesystem::path& path)
+{
+#if defined(_WIN32)
+    // _commit (FlushFileBuffers) needs write access.
+    int fd = -1;
+    if (const errno_t err = _wsopen_s(&fd, path.c_str(), _O_WRONLY | _O_BINARY | _O_NOINHERIT, _SH_DENYNO, _S_IREAD | _S_IWRITE); err != 0)
+    {
+        return std::unexpected("Failed to open '" + path.string() + "' for syncing: " + std::generic_category().message(err));
+    }
+    struct _stat64 st{};
+    if (_fstat64(fd, &st) != 0)
+    {
+        const auto message = std::generic_category().message(errno);
+        _close(fd);
+        return std::unexpected("Failed to stat '" + path.string() + "': " + message);
+    }
+#else
+    // Syncing flushes the file's pages whichever descriptor wrote them, so a read-only one is enough.
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return std::unexpected("Failed to open '" + path.string() + "' for syncing: " + std::generic_category().message(errno));
+    }
+    struct stat st{};
+    if (::fstat(fd, &st) != 0)
+    {
+        const auto message = std::generic_category().message(errno);
+        ::close(fd);
+        return std::unexpected("Failed to stat '" + path.string() + "': " + message);
+    }
+#endif
+    return std::shared_ptr<SyncFile>(new SyncFile(fd, static_cast<uint64_t>(st.st_dev)));
+}
+
+SyncFile::~SyncFile()
+{
+#if defined(_WIN32)
+    _close(fd_);
+#else
+    ::close(fd_);
+#endif
+}
+
+std::expected<void, std::string> SyncFile::sync() const
+{
+#if defined(_WIN32)
+    const auto sync_fd = [](const int fd) { return _commit(fd); };
+#elif defined(__APPLE__)
+    const auto sync_fd = [](const int fd) { return ::fsync(fd); };
+#else
+    const auto sync_fd = [](const int fd) { return ::fdatasync(fd); };
+#endif
+    while (sync_fd(fd_) != 0)
+    {
+        if (errno != EINTR) return std::unexpected("fdatasync failed: " + std::generic_category().message(errno));
+    }
+    return {};
+}
+
+// --- GroupCommitter ---
+
+struct GroupCommitter::Device
+{
+    struct Request
+    {
+        std::shared_ptr<const SyncFile> file;
+        std::promise<Result> promise;
+    };
+
+    const SyncFn& sync_fn;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<Request> pending;
+    bool stopping = false;
+    DeviceSyncStats stats;
+    std::thread thread;
+
+    void run()
+    {
+        std::unique_lock lock(mutex);
+        while (true)
+        {
+            cv.wait(lock, [this] { return stopping || !pending.empty(); });
+            if (pending.empty()) return;
+            auto batch = std::move(pending);
+            pending.clear();
+            ++stats.batches;
+            lock.unlock();
+
+            // One sync per file, however many of its requests piled up while the previous batch ran.
+            std::vector<std::pair<const SyncFile*, Result>> results;
+            std::vector<std::chrono::nanoseconds> latencies;
+            for (const auto& request : batch)
+            {
+                const SyncFile* file = request.file.get();
+                if (std::ranges::any_of(results, [file](const auto& r) { return r.first == file; })) continue;
+                const auto start = std::chrono::steady_clock::now();
+                results.emplace_back(file, sync_fn(*file));
+                latencies.push_back(std::chrono::steady_clock::now() - start);
+            }
+
+            lock.lock();
+            stats.syncs += results.size();
+            stats.failures += static_cast<uint64_t>(std::ranges::count_if(results, [](const auto& r) { return !r.second.has_value(); }));
+            for (const auto latency : latencies) stats.latency.record(latency);
+            lock.unlock();
+
+            for (auto& request : batch)
+            {
+                const auto it = std::ranges::find(results, request.file.get(), [](const auto& r) { return r.first; });
+                request.promise.set_value(it->second);
+            }
+            lock.lock();
+        }
+    }
+};
+
+GroupCommitter::GroupCommitter(SyncFn sync_fn)
+    : sync_fn_(sync_fn ? std::move(sync_fn) : SyncFn([](const SyncFile& file) { return file.sync(); }))
+{
+}
+
+GroupCommitter::~GroupCommitter()
+{
+    for (auto& [id, device] : devices_)
+    {
+        {
+            std::lock_guard lock(device->mutex);
+            device->stopping = true;
+        }
+        device->cv.notify_one();
+        device->thread.join();
+    }
+}
+
+GroupCommitter& GroupCommitter::shared()
+{
+    static GroupCommitter committer;
+    return committer;
+}
+
+GroupCommitter::Ticket GroupCommitter::submit(std::shared_ptr<const SyncFile> file)
+{
+    std::promise<Result> promise;
+    Ticket ticket = promise.get_future().share();
+
+    std::lock_guard lock(mutex_);
+    auto& device = devices_[file->device()];
+    if (!device)
+    {
+        device = std::make_unique<Device>(sync_fn_);
+        device->stats.device = file->device();
+        device->thread = std::thread([d = device.get()] { d->run(); });
+    }
+    {
+        std::lock_guard device_lock(device->mutex);
+        ++device->stats.requests;
+        device->pending.push_back({std::move(file), std::move(promise)});
+    }
+    device->cv.notify_one();
+    return ticket;
+}
+
+std::optional<DeviceSyncStats> GroupCommitter::stats(const uint64_t device) const
+{
+    std::lock_guard lock(mutex_);
+    const auto it = devices_.find(device);
+    if (it == devices_.end()) return std::nullopt;
+    std::lock_guard device_lock(it->second->mutex);
+    return it->second->stats;
+}
+
+std::vector<DeviceSyncStats> GroupCommitter::stats() const
+{
+    std::lock_guard lock(mutex_);
+    std::vector<DeviceSyncStats> all;
+    all.reserve(devices_.size());
+    for (const auto& [id, device] : devices_)
+    {
+        std::lock_guard device_lock(device->mutex);
+        all.push_back(device->stats);
+    }
+    return all;
+}
+
+} // namespace cryptodd
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace cryptodd
+{
+
+/**
+ * @brief When a writer makes its data durable (flush, then fdatasync). Whatever the mode, DataWriter::flush() syncs
+ * unless the mode is NONE.
+ *
+ * - NONE: never; data reaches the OS on flush() and the disk whenever the OS decides.
+ * - EVERY_N_CHUNKS: every `every_chunks` appends, waiting for the sync before the append returns.
+ * - INTERVAL: on the first append at least `interval` after the last sync, without waiting for it; a failed sync is
+ *   reported by the next append or flush(). Nothing is synced while no chunk is appended.
+ * - EACH_APPEND: every append returns once its chunk is durable.
+ */
+enum class DurabilityMode : uint8_t
+{
+    NONE = 0,
+    EVERY_N_CHUNKS = 1,
+    INTERVAL = 2,
+    EACH_APPEND = 3,
+};
+
+struct DurabilityOptions
+{
+    DurabilityMode mode = DurabilityMode::NONE;
+    size_t every_chunks = 1;                    // EVERY_N_CHUNKS
+    std::chrono::milliseconds interval{1000}; // INTERVAL
+};
+
+/** @brief Sync latencies in power-of-two microsecond buckets. */
+struct SyncLatencyHistogram
+{
+    // Bucket 0 counts syncs under 2 us, bucket b > 0 those in [2^b, 2^(b+1)) us; the last one is unbounded (> 4 s).
+    static constexpr size_t NUM_BUCKETS = 23;
+
+    std::array<uint64_t, NUM_BUCKETS> buckets{};
+    uint64_t count = 0;
+    uint64_t total_us = 0;
+    uint64_t max_us = 0;
+
+    void record(std::chrono::nanoseconds elapsed);
+
+    /** @brief The upper bound of the bucket holding quantile `q` in [0, 1] (max_us for the last one), 0 if empty. */
+    [[nodiscard]] uint64_t quantile_us(double q) const;
+
+    [[nodiscard]] double mean_us() const { return count > 0 ? static_cast<double>(total_us) / static_cast<double>(count) : 0.0; }
+};
+
+/** @brief What the committer of one device has done since the process started. */
+struct DeviceSyncStats
+{
+    uint64_t device = 0;
+    uint64_t requests = 0; // sync requests submitted
+    uint64_t batches = 0;  // times the committer woke up to serve the pending requests
+    uint64_t syncs = 0;    // fdatasync calls; below `requests` when concurrent requests were coalesced
+    uint64_t failures = 0;
+    SyncLatencyHistogram latency; // of each fdatasync
+};
+
+/**
+ * @class SyncFile
+ * @brief A descriptor of a file held only to make what was written to it durable, independently of the backend
+ * writing it, so it can be synced on another thread and outlive the writer.
+ */
+class SyncFile
+{
+public:
+    static std::expected<std::shared_ptr<SyncFile>, std::string> open(const std::filesystem::path& path);
+
+    ~SyncFile();
+    SyncFile(const SyncFile&) = delete;
+    SyncFile& operator=(const SyncFile&) = delete;
+
+    /** @brief fdatasync: everything written to the file through any descriptor so far reaches the device. */
+    [[nodiscard]] std::expected<void, std::string> sync() const;
+
+    [[nodiscard]] uint64_t device() const { return device_; }
+
+private:
+    SyncFile(int fd, uint64_t device) : fd_(fd), device_(device) {}
+
+    int fd_;
+    uint64_t device_;
+};
+
+/**
+ * @class GroupCommitter
+ * @brief Performs fdatasync calls on one background thread per device and coalesces them.
+ *
+ * Requests arriving while a device's committer is syncing are served together by its next batch, in which each file
+ * is synced once however many requests it has, so writers syncing concurrently (e.g. several contexts appending
+ * with EACH_APPEND) share syncs instead of queueing one per chunk. A slow device never delays another's syncs.
+ */
+class GroupCommitter
+{
+public:
+    using Result = std::expected<void, std::string>;
+    using Ticket = std::shared_future<Result>;
+    using SyncFn = std::function<Result(const SyncFile&)>;
+
+    /** @param sync_fn Performs one sync on a committer thread; SyncFile::sync() when empty. */
+    explicit GroupCommitter(SyncFn sync_fn = {});
+    GroupCommitter(const GroupCommitter&) = delete;
+    GroupCommitter& operator=(const GroupCommitter&) = delete;
+
+    /** @brief Serves the pending requests, then joins the committer threads. */
+    ~GroupCommitter();
+
+    static GroupCommitter& shared();
+
+    /** @brief Queues a sync of `file`; the ticket is ready once a sync that started after this call completed. */
+    [[nodiscard]] Ticket submit(std::shared_ptr<const SyncFile> file);
+
+    /** @brief submit() and wait. */
+    Result sync(std::shared_ptr<const SyncFile> file) { return submit(std::move(file)).get(); }
+
+    [[nodiscard]] std::optional<DeviceSyncStats> stats(uint64_t device) const;
+    [[nodiscard]] std::vector<DeviceSyncStats> stats() const;
+
+private:
+    struct Device;
+
+    SyncFn sync_fn_;
+    mutable std::mutex mutex_;
+    std::map<uint64_t, std::unique_ptr<Device>> devices_;
+};
+
+} // namespace cryptodd
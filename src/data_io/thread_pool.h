@@ -0,0 +1,170 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace cryptodd
+{
+    /**
+     * @brief A fixed-size pool of worker threads draining a FIFO task queue.
+     *
+     * Used to fan a single large chunk out over several cores (see multi-frame chunks in
+     * DataCompressor / DataExtractor). Tasks must not block on other tasks of the same pool.
+     * The destructor finishes every queued task before joining the workers.
+     */
+    class ThreadPool
+    {
+    public:
+        explicit ThreadPool(const size_t num_threads = default_thread_count())
+        {
+            const size_t count = std::max<size_t>(1, num_threads);
+            workers_.reserve(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                workers_.emplace_back([this] { worker_loop(); });
+            }
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+        ThreadPool(ThreadPool&&) = delete;
+        ThreadPool& operator=(ThreadPool&&) = delete;
+
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard lock(mutex_);
+                stopping_ = true;
+            }
+            cv_.notify_all();
+            for (auto& worker : workers_)
+            {
+                worker.join();
+            }
+        }
+
+        /**
+         * @brief Queues a callable and returns a future for its result. Exceptions propagate through the future.
+         */
+        template <typename F>
+        [[nodiscard]] std::future<std::invoke_result_t<std::decay_t<F>>> submit(F&& task)
+        {
+            using Result = std::invoke_result_t<std::decay_t<F>>;
+            // std::function needs a copyable target, hence the shared_ptr around the packaged_task.
+            auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+            auto future = packaged->get_future();
+            {
+                std::lock_guard lock(mutex_);
+                tasks_.emplace_back([packaged] { (*packaged)(); });
+            }
+            cv_.notify_one();
+            return future;
+        }
+
+        /**
+         * @brief Runs `fn(i)` for every i in [0, count) on the pool and the calling thread, and waits for all of them.
+         *
+         * Index 0 runs on the calling thread. When called from one of this pool's own workers, every
+         * index runs inline instead, so a task can never end up waiting on a queue it is blocking.
+         * The first exception thrown by any invocation is rethrown after all of them have finished.
+         */
+        template <typename F>
+        void parallel_for(const size_t count, F&& fn)
+        {
+            if (count == 0) return;
+            if (count == 1 || tls_current_pool_ == this)
+            {
+                for (size_t i = 0; i < count; ++i) fn(i);
+                return;
+            }
+
+            std::vector<std::future<void>> futures;
+            futures.reserve(count - 1);
+            for (size_t i = 1; i < count; ++i)
+            {
+                futures.push_back(submit([&fn, i] { fn(i); }));
+            }
+
+            std::exception_ptr first_error;
+            try
+            {
+                fn(0);
+            }
+            catch (...)
+            {
+                first_error = std::current_exception();
+            }
+            // Every task references `fn`, so all of them must finish before anything propagates.
+            for (auto& future : futures)
+            {
+                future.wait();
+            }
+            for (auto& future : futures)
+            {
+                try
+                {
+                    future.get();
+                }
+                catch (...)
+                {
+                    if (!first_error) first_error = std::current_exception();
+                }
+            }
+            if (first_error) std::rethrow_exception(first_error);
+        }
+
+        [[nodiscard]] size_t size() const noexcept { return workers_.size(); }
+
+        /**
+         * @brief Process-wide pool sized to the hardware, created on first use.
+         */
+        static ThreadPool& shared()
+        {
+            static ThreadPool pool;
+            return pool;
+        }
+
+        static size_t default_thread_count() noexcept
+        {
+            return std::max(1u, std::thread::hardware_concurrency());
+        }
+
+    private:
+        void worker_loop()
+        {
+            tls_current_pool_ = this;
+            for (;;)
+            {
+                std::function<void()> task;
+                {
+                    std::unique_lock lock(mutex_);
+                    cv_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+                    if (tasks_.empty())
+                    {
+                        return; // stopping_ and nothing left to run
+                    }
+                    task = std::move(tasks_.front());
+                    tasks_.pop_front();
+                }
+                task();
+            }
+        }
+
+        static inline thread_local const ThreadPool* tls_current_pool_ = nullptr;
+
+        std::vector<std::thread> workers_;
+        std::deque<std::function<void()>> tasks_;
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        bool stopping_ = false;
+    };
+} // namespace cryptodd
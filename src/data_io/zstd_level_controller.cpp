@@ -0,0 +1,110 @@
+#include "zstd_level_controller.h"
+#include "../file_format/cdd_file_format.h" // For MIN_RECORDED_ZSTD_LEVEL
+#include <algorithm>
+#include <format>
+#include <zstd.h>
+
+namespace cryptodd
+{
+
+namespace
+{
+    // Level 0 means "zstd default" (3), so stepping skips it in both directions.
+    int step_level(const int level, const int direction)
+    {
+        const int next = level + direction;
+        return next == 0 ? next + direction : next;
+    }
+}
+
+std::expected<void, std::string> ZstdLevelController::configure(const AdaptiveLevelOptions& options)
+{
+    const int min_supported = std::max(ZSTD_minCLevel(), MIN_RECORDED_ZSTD_LEVEL);
+    if (options.min_level < min_supported || options.max_level > ZSTD_maxCLevel() || options.min_level > options.max_level)
+    {
+        return std::unexpected(std::format("Adaptive zstd levels must satisfy {} <= min_level <= max_level <= {}.", min_supported, ZSTD_maxCLevel()));
+    }
+    if (options.initial_level < options.min_level || options.initial_level > options.max_level || options.initial_level == 0)
+    {
+        return std::unexpected("The initial adaptive zstd level must be a non-zero level within [min_level, max_level].");
+    }
+    if (options.target_mbps < 0.0 || options.max_latency_ms < 0.0)
+    {
+        return std::unexpected("Adaptive zstd targets cannot be negative.");
+    }
+    if (!(options.smoothing > 0.0 && options.smoothing <= 1.0) || !(options.headroom >= 1.0) || options.min_samples == 0)
+    {
+        return std::unexpected("Adaptive zstd options need 0 < smoothing <= 1, headroom >= 1 and min_samples >= 1.");
+    }
+
+    std::lock_guard lock(mutex_);
+    options_ = options;
+    stats_ = AdaptiveLevelStats{.level = options.initial_level};
+    samples_at_level_ = 0;
+    return {};
+}
+
+int ZstdLevelController::level() const
+{
+    std::lock_guard lock(mutex_);
+    return stats_.level;
+}
+
+void ZstdLevelController::record(const int level, const size_t raw_bytes, const std::chrono::nanoseconds elapsed)
+{
+    const double seconds = std::max(std::chrono::duration<double>(elapsed).count(), 1e-9);
+    const double mbps = static_cast<double>(raw_bytes) / seconds / 1e6;
+    const double latency_ms = seconds * 1e3;
+
+    std::lock_guard lock(mutex_);
+    if (level != stats_.level) return;
+    ++stats_.chunks;
+    if (samples_at_level_ == 0)
+    {
+        stats_.avg_mbps = mbps;
+        stats_.avg_latency_ms = latency_ms;
+    }
+    else
+    {
+        stats_.avg_mbps += options_.smoothing * (mbps - stats_.avg_mbps);
+        stats_.avg_latency_ms += options_.smoothing * (latency_ms - stats_.avg_latency_ms);
+    }
+    if (++samples_at_level_ < options_.min_samples) return;
+
+    const bool throughput_target = options_.target_mbps > 0.0;
+    const bool latency_target = options_.max_latency_ms > 0.0;
+    if (!throughput_target && !latency_target) return;
+
+    const bool too_slow = (throughput_target && stats_.avg_mbps < options_.target_mbps) ||
+                          (latency_target && stats_.avg_latency_ms > options_.max_latency_ms);
+    const bool has_slack = (!throughput_target || stats_.avg_mbps > options_.target_mbps * options_.headroom) &&
+                           (!latency_target || stats_.avg_latency_ms * options_.headroom < options_.max_latency_ms);
+    int next = stats_.level;
+    if (too_slow)
+    {
+        next = step_level(stats_.level, -1);
+    }
+    else if (has_slack)
+    {
+        next = step_level(stats_.level, +1);
+    }
+    if (next < options_.min_level || next > options_.max_level || next == stats_.level) return;
+
+    stats_.level = next;
+    ++stats_.level_changes;
+    samples_at_level_ = 0;
+}
+
+AdaptiveLevelStats ZstdLevelController::stats() const
+{
+    std::lock_guard lock(mutex_);
+    return stats_;
+}
+
+AdaptiveLevelOptions ZstdLevelController::options() const
+{
+    std::lock_guard lock(mutex_);
+    return options_;
+}
+
+} // namespace cryptodd
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "../codecs/zstd_compressor.h" // For ZstdCompressor::DEFAULT_COMPRESSION_LEVEL
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <mutex>
+#include <string>
+
+namespace cryptodd
+{
+
+/**
+ * @brief Targets of the adaptive zstd level. A target of zero is disabled; with both disabled the level never moves.
+ */
+struct AdaptiveLevelOptions
+{
+    int min_level = -5;  // Negative levels trade ratio for speed beyond level 1.
+    int max_level = 9;
+    int initial_level = ZstdCompressor::DEFAULT_COMPRESSION_LEVEL;
+    double target_mbps = 0.0;    // minimum encode throughput, in MB/s of uncompressed data
+    double max_latency_ms = 0.0; // maximum encode time of one chunk
+    double smoothing = 0.3;      // weight of the latest chunk in the moving averages, in (0, 1]
+    double headroom = 1.5;       // the level only goes up once every target is met with this much margin
+    size_t min_samples = 2;      // chunks encoded at a level before it may change again
+};
+
+/** @brief A snapshot of the controller, for monitoring. */
+struct AdaptiveLevelStats
+{
+    int level = ZstdCompressor::DEFAULT_COMPRESSION_LEVEL;
+    double avg_mbps = 0.0;       // moving average at the current level
+    double avg_latency_ms = 0.0; // moving average at the current level
+    uint64_t chunks = 0;         // chunks recorded since the last configure()
+    uint64_t level_changes = 0;
+};
+
+/**
+ * @class ZstdLevelController
+ * @brief Picks the zstd level of the next chunk from the encode speed of the previous ones.
+ *
+ * Each recorded chunk updates moving averages of throughput and latency at the current level. When they miss a
+ * target the level steps down, when every target is met with `headroom` to spare it steps up, always within
+ * [min_level, max_level]. Level 0, which zstd treats as its default level 3, is skipped. The averages restart on
+ * every change, so a level is judged only by chunks encoded at it, and `min_samples` keeps it from oscillating
+ * on a single slow chunk.
+ *
+ * Thread-safe: writers on several threads can share one controller; each chunk's timing counts once.
+ */
+class ZstdLevelController
+{
+public:
+    ZstdLevelController() = default;
+
+    /** @brief Replaces the targets and restarts at `initial_level`. Fails if the options are inconsistent. */
+    std::expected<void, std::string> configure(const AdaptiveLevelOptions& options);
+
+    /** @brief The level to encode the next chunk at. */
+    [[nodiscard]] int level() const;
+
+    /**
+     * @brief Records the encode of one chunk of `raw_bytes` at `level`. Timings of a level the controller has
+     * since left (chunks encoded concurrently with a change) are ignored.
+     */
+    void record(int level, size_t raw_bytes, std::chrono::nanoseconds elapsed);
+
+    [[nodiscard]] AdaptiveLevelStats stats() const;
+    [[nodiscard]] AdaptiveLevelOptions options() const;
+
+private:
+    mutable std::mutex mutex_;
+    AdaptiveLevelOptions options_;
+    AdaptiveLevelStats stats_;
+    size_t samples_at_level_ = 0;
+};
+
+} // namespace cryptodd
@@ -5,6 +5,7 @@
 #include <string>
 #include <array>
 #include <expected>
+#include <optional>
 #include <span>
 
 #include "../storage/i_storage_backend.h"
@@ -22,8 +23,9 @@ constexpr size_t MAX_SHAPE_DIMENSIONS = 32;
 enum class ChunkOffsetType : uint16_t {
     RAW = 1,
     ZSTD_COMPRESSED = 2,
+    DELTA_BITPACK = 3,
 
-    _RESERVED = 3
+    _RESERVED = 4
 };
 
 enum class ChunkDataType : uint16_t {
@@ -49,7 +51,49 @@ enum class ChunkDataType : uint16_t {
     TEMPORAL_2D_SIMD_F32 = 14,
     TEMPORAL_2D_SIMD_I64 = 15,
 
-    _RESERVED = 16,
+    // Temporal 1D Chimp128 bit-packed float codecs (no zstd stage)
+    TEMPORAL_1D_CHIMP_F32 = 16,
+    TEMPORAL_1D_CHIMP_F64 = 17,
+
+    // Temporal 1D int64 delta + zigzag + FOR/PFor bit-packing, without and with a zstd stage on top
+    TEMPORAL_1D_SIMD_I64_DELTA_BITPACK = 18,
+    TEMPORAL_1D_SIMD_I64_DELTA_BITPACK_ZSTD = 19,
+
+    // Delta-of-delta int64 codecs (1D series and per-column 2D), for near-constant-interval timestamps
+    TEMPORAL_1D_SIMD_I64_DOUBLE_DELTA = 20,
+    TEMPORAL_2D_SIMD_I64_DOUBLE_DELTA = 21,
+
+    // Temporal 2D int64 per-column delta, without and with an 8-byte shuffle of the residuals before zstd
+    TEMPORAL_2D_SIMD_I64_DELTA = 22,
+    TEMPORAL_2D_SIMD_I64_DELTA_SHUFFLE = 23,
+
+    // Float64 XOR + 8-byte shuffle (1D series and per-column 2D)
+    TEMPORAL_1D_SIMD_F64_XOR_SHUFFLE = 24,
+    TEMPORAL_2D_SIMD_F64 = 25,
+
+    // Fixed-point (tick-size quantized) floats: int64 delta + zigzag + FOR/PFor bit-packing + zstd.
+    // Chunks that are not on the tick grid are written with the matching float codec instead.
+    TEMPORAL_1D_FIXED_POINT_F32 = 26,
+    TEMPORAL_1D_FIXED_POINT_F64 = 27,
+    TEMPORAL_2D_FIXED_POINT_F32 = 28,
+    TEMPORAL_2D_FIXED_POINT_F64 = 29,
+    ORDERBOOK_FIXED_POINT_F32 = 30,
+
+    // Block-floating-point orderbook: f16 residuals against a per-snapshot, per-feature reference and exponent.
+    // Lossy chunks carry RECONSTRUCTION_BOUNDED; their per-feature error bounds are in the payload header.
+    GENERIC_OB_SIMD_BFP16_AS_F32 = 31,
+
+    // Sparse orderbook delta: a changed-levels bitmap per snapshot plus only the changed floats (lossless).
+    GENERIC_OB_SIMD_SPARSE_F32 = 32,
+
+    // Error-bounded lossy floats: the fixed-point pipeline on a grid derived from a per-column error bound.
+    // Lossy chunks carry RECONSTRUCTION_BOUNDED; their per-column error bounds are in the payload header.
+    TEMPORAL_1D_QUANTIZED_F32 = 33,
+    TEMPORAL_1D_QUANTIZED_F64 = 34,
+    TEMPORAL_2D_QUANTIZED_F32 = 35,
+    TEMPORAL_2D_QUANTIZED_F64 = 36,
+
+    _RESERVED = 37,
 };
 
 enum class DType : uint16_t {
@@ -82,6 +126,14 @@ enum class ChunkFlags : uint64_t {
     DOWN_CAST_128 = 1 << 8,
     RECONSTRUCTION_NOT_PERFECT = 1 << 9,
     SKIP_HASH_CHECK = 1 << 10,
+    BLOCKED_SHUFFLE = 1 << 11, // Shuffled byte planes are stored per row block (see codecs::ShuffleLayout).
+    MULTI_FRAME = 1 << 12, // Payload is a frame table followed by independently encoded row ranges.
+    ZSTD_LONG_WINDOW = 1 << 13, // zstd frames use a window above the default decoder limit (2^27 bytes).
+    RECONSTRUCTION_BOUNDED = 1 << 14, // Lossy, but within error bounds the codec records in the payload (see orderbook_bfp16_codec.h).
+    ZSTD_LEVEL_RECORDED = 1 << 15, // Bits 32-39 hold the zstd level the payload was compressed at (see chunk_zstd_level).
+    HASH_XXH3_128 = 1 << 16, // The hash field holds an XXH3-128 instead of a BLAKE3 (see chunk_hash.h).
+    HASH_BLAKE3_TREE = 1 << 17, // The hash field holds the segment-tree BLAKE3 of a large chunk (see chunk_hash.h).
+    HASH_NONE = 1 << 18, // No hash was computed; the hash field is zero.
 
     _RESERVED_CHUNK_FLAGS = 1ULL << 63
 };
@@ -113,6 +165,25 @@ inline bool hasFlag(ChunkFlags value, ChunkFlags flag) {
     return (static_cast<underlying>(value) & static_cast<underlying>(flag)) != 0;
 }
 
+// The recorded zstd level is a signed byte, so levels below this one cannot be recorded.
+inline constexpr int MIN_RECORDED_ZSTD_LEVEL = -128;
+inline constexpr int RECORDED_ZSTD_LEVEL_SHIFT = 32;
+
+/** @brief Returns `flags` with ZSTD_LEVEL_RECORDED set and `level` (at least MIN_RECORDED_ZSTD_LEVEL) in bits 32-39. */
+inline ChunkFlags with_zstd_level(const ChunkFlags flags, const int level) {
+    using underlying = std::underlying_type_t<ChunkFlags>;
+    constexpr underlying mask = underlying{0xFF} << RECORDED_ZSTD_LEVEL_SHIFT;
+    const auto level_bits = static_cast<underlying>(static_cast<uint8_t>(static_cast<int8_t>(level))) << RECORDED_ZSTD_LEVEL_SHIFT;
+    return static_cast<ChunkFlags>((static_cast<underlying>(flags) & ~mask) | level_bits) | ChunkFlags::ZSTD_LEVEL_RECORDED;
+}
+
+/** @brief The zstd level recorded by with_zstd_level, if any. */
+inline std::optional<int> chunk_zstd_level(const ChunkFlags flags) {
+    if (!hasFlag(flags, ChunkFlags::ZSTD_LEVEL_RECORDED)) return std::nullopt;
+    using underlying = std::underlying_type_t<ChunkFlags>;
+    return static_cast<int8_t>(static_cast<uint8_t>(static_cast<underlying>(flags) >> RECORDED_ZSTD_LEVEL_SHIFT));
+}
+
 /**
  * @brief Gets the size of a DType in bytes.
  * @param dtype The data type.
@@ -0,0 +1,169 @@
+#include "chunk_hash.h"
+#include "../data_io/thread_pool.h"
+#include <algorithm>
+#include <new>
+#include <vector>
+#include <xxhash.h>
+
+namespace cryptodd
+{
+
+namespace
+{
+    blake3_hash256_t blake3_tree_hash(std::span<const std::byte> data)
+    {
+        const size_t num_segments = (data.size() + PARALLEL_HASH_SEGMENT_BYTES - 1) / PARALLEL_HASH_SEGMENT_BYTES;
+        std::vector<blake3_hash256_t> segment_hashes(num_segments);
+        auto& pool = ThreadPool::shared();
+        // One task per worker, each hashing a contiguous run of segments.
+        const size_t num_tasks = std::min(num_segments, pool.size() + 1);
+        pool.parallel_for(num_tasks, [&](const size_t task) {
+            for (size_t s = task * num_segments / num_tasks; s < (task + 1) * num_segments / num_tasks; ++s)
+            {
+                segment_hashes[s] = calculate_blake3_hash256(data.subspan(s * PARALLEL_HASH_SEGMENT_BYTES,
+                                                                          std::min(PARALLEL_HASH_SEGMENT_BYTES, data.size() - s * PARALLEL_HASH_SEGMENT_BYTES)));
+            }
+        });
+
+        Blake3StreamHasher root;
+        const uint64_t total_size = data.size();
+        root.update(std::span<const uint64_t>(&total_size, 1));
+        root.update(std::span<const blake3_hash256_t>(segment_hashes));
+        return root.finalize_256();
+    }
+
+    blake3_hash256_t xxh3_128_hash(std::span<const std::byte> data)
+    {
+        const XXH128_hash_t digest = XXH3_128bits(data.data(), data.size());
+        return {digest.low64, digest.high64, 0, 0};
+    }
+}
+
+ChunkFlags hash_flags(const HashOptions& options, const size_t size)
+{
+    switch (options.algorithm)
+    {
+        case HashAlgorithm::XXH3_128:
+            return ChunkFlags::HASH_XXH3_128;
+        case HashAlgorithm::NONE:
+            return ChunkFlags::HASH_NONE | ChunkFlags::SKIP_HASH_CHECK;
+        case HashAlgorithm::BLAKE3_256:
+            break;
+    }
+    return options.parallel_threshold > 0 && size >= options.parallel_threshold ? ChunkFlags::HASH_BLAKE3_TREE : ChunkFlags::NONE;
+}
+
+HashAlgorithm chunk_hash_algorithm(const ChunkFlags flags)
+{
+    if (hasFlag(flags, ChunkFlags::HASH_NONE)) return HashAlgorithm::NONE;
+    if (hasFlag(flags, ChunkFlags::HASH_XXH3_128)) return HashAlgorithm::XXH3_128;
+    return HashAlgorithm::BLAKE3_256;
+}
+
+blake3_hash256_t calculate_chunk_hash(std::span<const std::byte> data, const ChunkFlags flags)
+{
+    switch (chunk_hash_algorithm(flags))
+    {
+        case HashAlgorithm::NONE:
+            return {};
+        case HashAlgorithm::XXH3_128:
+            return xxh3_128_hash(data);
+        case HashAlgorithm::BLAKE3_256:
+            break;
+    }
+    return hasFlag(flags, ChunkFlags::HASH_BLAKE3_TREE) ? blake3_tree_hash(data) : calculate_blake3_hash256(data);
+}
+
+struct ChunkHasher::Impl
+{
+    HashAlgorithm algorithm = HashAlgorithm::BLAKE3_256;
+    bool tree = false;
+    Blake3StreamHasher blake3; // the whole chunk, or the current segment of a tree hash
+    size_t segment_fill = 0;
+    std::vector<blake3_hash256_t> segment_hashes;
+    std::unique_ptr<XXH3_state_t, decltype(&XXH3_freeState)> xxh3{nullptr, &XXH3_freeState};
+};
+
+ChunkHasher::ChunkHasher(const ChunkFlags flags) : pimpl_(std::make_unique<Impl>())
+{
+    pimpl_->algorithm = chunk_hash_algorithm(flags);
+    pimpl_->tree = hasFlag(flags, ChunkFlags::HASH_BLAKE3_TREE);
+    if (pimpl_->algorithm == HashAlgorithm::XXH3_128)
+    {
+        pimpl_->xxh3.reset(XXH3_createState());
+        if (!pimpl_->xxh3) throw std::bad_alloc();
+        XXH3_128bits_reset(pimpl_->xxh3.get());
+    }
+    // An empty chunk still has a hash.
+    pimpl_->blake3.update_bytes({});
+}
+
+ChunkHasher::~ChunkHasher() = default;
+ChunkHasher::ChunkHasher(ChunkHasher&&) noexcept = default;
+ChunkHasher& ChunkHasher::operator=(ChunkHasher&&) noexcept = default;
+
+void ChunkHasher::update(std::span<const std::byte> data)
+{
+    size_ += data.size();
+    auto& impl = *pimpl_;
+    switch (impl.algorithm)
+    {
+        case HashAlgorithm::NONE:
+            return;
+        case HashAlgorithm::XXH3_128:
+            XXH3_128bits_update(impl.xxh3.get(), data.data(), data.size());
+            return;
+        case HashAlgorithm::BLAKE3_256:
+            break;
+    }
+    if (!impl.tree)
+    {
+        impl.blake3.update_bytes(data);
+        return;
+    }
+    while (!data.empty())
+    {
+        const size_t take = std::min(data.size(), PARALLEL_HASH_SEGMENT_BYTES - impl.segment_fill);
+        impl.blake3.update_bytes(data.first(take));
+        data = data.subspan(take);
+        impl.segment_fill += take;
+        if (impl.segment_fill == PARALLEL_HASH_SEGMENT_BYTES)
+        {
+            impl.segment_hashes.push_back(impl.blake3.finalize_256());
+            impl.blake3.reset();
+            impl.blake3.update_bytes({});
+            impl.segment_fill = 0;
+        }
+    }
+}
+
+blake3_hash256_t ChunkHasher::finalize() const
+{
+    const auto& impl = *pimpl_;
+    switch (impl.algorithm)
+    {
+        case HashAlgorithm::NONE:
+            return {};
+        case HashAlgorithm::XXH3_128:
+            {
+                const XXH128_hash_t digest = XXH3_128bits_digest(impl.xxh3.get());
+                return {digest.low64, digest.high64, 0, 0};
+            }
+        case HashAlgorithm::BLAKE3_256:
+            break;
+    }
+    if (!impl.tree) return impl.blake3.finalize_256();
+
+    Blake3StreamHasher root;
+    const uint64_t total_size = size_;
+    root.update(std::span<const uint64_t>(&total_size, 1));
+    root.update(std::span<const blake3_hash256_t>(impl.segment_hashes));
+    if (impl.segment_fill > 0)
+    {
+        const blake3_hash256_t last = impl.blake3.finalize_256();
+        root.update(std::span<const blake3_hash256_t>(&last, 1));
+    }
+    return root.finalize_256();
+}
+
+} // namespace cryptodd
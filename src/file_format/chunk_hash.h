@@ -0,0 +1,79 @@
+#pragma once
+
+#include "blake3_stream_hasher.h" // For blake3_hash256_t
+#include "cdd_file_format.h"     // For ChunkFlags
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+namespace cryptodd
+{
+
+/**
+ * @brief The integrity hash of a chunk. The choice is recorded per chunk in its flags, so files can mix them.
+ *
+ * - BLAKE3_256: the format's original hash. Chunks at least HashOptions::parallel_threshold bytes long are hashed
+ *   as a tree instead (ChunkFlags::HASH_BLAKE3_TREE): BLAKE3 over the total size and the BLAKE3 of every
+ *   PARALLEL_HASH_SEGMENT_BYTES segment, the segments being hashed concurrently.
+ * - XXH3_128: not cryptographic, but several times faster; catches storage and transfer corruption.
+ *   Stored in the first 16 bytes of the hash field (ChunkFlags::HASH_XXH3_128).
+ * - NONE: nothing is computed and the hash field stays zero (ChunkFlags::HASH_NONE | SKIP_HASH_CHECK).
+ */
+enum class HashAlgorithm : uint8_t
+{
+    BLAKE3_256 = 0,
+    XXH3_128 = 1,
+    NONE = 2,
+};
+
+inline constexpr size_t PARALLEL_HASH_SEGMENT_BYTES = size_t{1} << 20;
+
+struct HashOptions
+{
+    HashAlgorithm algorithm = HashAlgorithm::BLAKE3_256;
+    size_t parallel_threshold = 0; // BLAKE3 chunks at least this large use the tree hash; 0 never does
+};
+
+/** @brief The flags recording how a chunk of `size` bytes is hashed under `options`. */
+[[nodiscard]] ChunkFlags hash_flags(const HashOptions& options, size_t size);
+
+/** @brief The algorithm recorded in `flags`. */
+[[nodiscard]] HashAlgorithm chunk_hash_algorithm(ChunkFlags flags);
+
+/** @brief True when the chunk carries a hash that can be checked, whatever SKIP_HASH_CHECK says. */
+[[nodiscard]] inline bool chunk_has_hash(const ChunkFlags flags) { return !hasFlag(flags, ChunkFlags::HASH_NONE); }
+
+/**
+ * @brief The hash a chunk with `flags` stores for `data`: the raw data for lossless codecs, the payload otherwise.
+ * Returns an all-zero hash for HASH_NONE chunks.
+ */
+[[nodiscard]] blake3_hash256_t calculate_chunk_hash(std::span<const std::byte> data, ChunkFlags flags);
+
+/**
+ * @class ChunkHasher
+ * @brief Computes calculate_chunk_hash(data, flags) from consecutive pieces of `data`, so the hash can be taken
+ * in the same pass as the encode or decode of each piece. Tree hashes are computed one segment after the other.
+ */
+class ChunkHasher
+{
+public:
+    explicit ChunkHasher(ChunkFlags flags);
+    ~ChunkHasher();
+    ChunkHasher(ChunkHasher&&) noexcept;
+    ChunkHasher& operator=(ChunkHasher&&) noexcept;
+
+    void update(std::span<const std::byte> data);
+
+    /** @brief The total size passed to update() so far. */
+    [[nodiscard]] size_t size() const { return size_; }
+
+    [[nodiscard]] blake3_hash256_t finalize() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pimpl_;
+    size_t size_ = 0;
+};
+
+} // namespace cryptodd
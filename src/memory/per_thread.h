@@ -0,0 +1,140 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace cryptodd::memory
+{
+    /**
+     * @brief Owns one lazily-created instance of T per calling thread.
+     *
+     * `local()` resolves the calling thread's instance through a thread_local slot, so repeated
+     * calls from the same thread on the same owner never take a lock. The mutex is only touched
+     * the first time a thread reaches an owner, or when the thread alternates between owners.
+     *
+     * An instance lives until either its thread exits or the owner is destroyed, whichever comes
+     * first: each thread keeps a thread_local record of the owners it reached and releases its
+     * instances from them on exit, so short-lived threads neither leak instances nor hand their
+     * state to a later thread.
+     */
+    template <typename T>
+        requires std::default_initializable<T>
+    class PerThread
+    {
+    public:
+        PerThread() : id_(next_id()) {}
+
+        PerThread(const PerThread&) = delete;
+        PerThread& operator=(const PerThread&) = delete;
+        PerThread(PerThread&&) = delete;
+        PerThread& operator=(PerThread&&) = delete;
+        ~PerThread() = default;
+
+        [[nodiscard]] T& local() const
+        {
+            if (const auto& slot = thread_record().slot; slot.owner_id == id_) [[likely]]
+            {
+                return *slot.value;
+            }
+            return local_slow();
+        }
+
+        [[nodiscard]] size_t size() const
+        {
+            std::lock_guard lock(registry_->mutex);
+            return registry_->instances.size();
+        }
+
+    private:
+        struct ThreadRecord;
+
+        // Shared with the thread records, so a thread exiting after the owner finds it expired.
+        struct Registry
+        {
+            std::mutex mutex;
+            std::map<const ThreadRecord*, std::unique_ptr<T>> instances;
+        };
+
+        struct Slot
+        {
+            uint64_t owner_id = 0;
+            T* value = nullptr;
+        };
+
+        struct ThreadRecord
+        {
+            Slot slot{};
+            std::vector<std::weak_ptr<Registry>> registries;
+
+            ThreadRecord() = default;
+            ThreadRecord(const ThreadRecord&) = delete;
+            ThreadRecord& operator=(const ThreadRecord&) = delete;
+
+            ~ThreadRecord()
+            {
+                for (const auto& weak : registries)
+                {
+                    const auto registry = weak.lock();
+                    if (!registry) continue;
+                    std::unique_ptr<T> instance;
+                    {
+                        std::lock_guard lock(registry->mutex);
+                        if (const auto it = registry->instances.find(this); it != registry->instances.end())
+                        {
+                            instance = std::move(it->second);
+                            registry->instances.erase(it);
+                        }
+                    }
+                    // Destroyed outside the lock.
+                }
+            }
+        };
+
+        static ThreadRecord& thread_record()
+        {
+            thread_local ThreadRecord record;
+            return record;
+        }
+
+        // Ids are never reused, so a stale slot pointing at a destroyed owner can never match.
+        static uint64_t next_id()
+        {
+            static std::atomic<uint64_t> counter{0};
+            return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+        }
+
+        T& local_slow() const
+        {
+            auto& record = thread_record();
+            T* value;
+            bool registered;
+            {
+                std::lock_guard lock(registry_->mutex);
+                auto& instance = registry_->instances[&record];
+                registered = instance != nullptr;
+                if (!registered)
+                {
+                    instance = std::make_unique<T>();
+                }
+                value = instance.get();
+            }
+            if (!registered)
+            {
+                // Drop the owners that are gone, so a long-lived thread does not accumulate them.
+                std::erase_if(record.registries, [](const auto& weak) { return weak.expired(); });
+                record.registries.push_back(registry_);
+            }
+            record.slot = Slot{id_, value};
+            return *value;
+        }
+
+        const uint64_t id_;
+        const std::shared_ptr<Registry> registry_ = std::make_shared<Registry>();
+    };
+} // namespace cryptodd::memory
@@ -5,7 +5,7 @@ High-performance, compressed NumPy array storage.
 # Public API is defined by imports from implementation modules
 from .file import open, Reader, Writer
 from .types import Codec
-from .dataclasses import ChunkInfo, FileHeaderInfo, StoreResult
+from .dataclasses import ChunkInfo, FileHeaderInfo, StoreResult, VerifyReport
 from .exceptions import CddError, CddOperationError, CddConfigError
 from .convenience import save_array, load_array
 from .stream import BufferedAutoChunker, GroupedWriter, GroupedReader
@@ -26,6 +26,7 @@ __all__ = [
     'ChunkInfo',
     'FileHeaderInfo',
     'StoreResult',
+    'VerifyReport',
     'CddError',
     'CddOperationError',
     'CddConfigError',
@@ -16,8 +16,10 @@ def recommend_codec(data: np.ndarray) -> Codec:
 
     The heuristics are:
     - 3D float32 arrays are treated as orderbook data.
-    - 2D float32/int64 arrays are treated as generic temporal 2D data.
+    - 2D float32/int64/float64 arrays are treated as generic temporal 2D data
+      (float64 with the per-column XOR + shuffle codec).
     - 1D float32/int64 arrays are treated as generic temporal 1D data.
+    - 1D float64 arrays use the lossless Chimp128 codec.
     - All other arrays default to ZSTD for general-purpose compression.
 
     Args:
@@ -34,11 +36,15 @@ def recommend_codec(data: np.ndarray) -> Codec:
             return Codec.TEMPORAL_2D_SIMD_F32
         case (2, 'int64'):
             return Codec.TEMPORAL_2D_SIMD_I64
+        case (2, 'float64'):
+            return Codec.TEMPORAL_2D_SIMD_F64
 
         case (1, 'float32'):
             return Codec.TEMPORAL_1D_SIMD_F32_XOR_SHUFFLE
         case (1, 'int64'):
             return Codec.TEMPORAL_1D_SIMD_I64_DELTA
+        case (1, 'float64'):
+            return Codec.TEMPORAL_1D_CHIMP_F64
 
         # Default case for all other shapes and dtypes
         case _:
@@ -40,7 +40,9 @@ def build_store_chunk_req(
 
 def build_load_chunks_req(
     selection_key: int | slice | None,
-    check_checksums: bool
+    check_checksums: bool,
+    access: str | None = None,
+    prefetch_chunks: int | None = None
 ) -> JsonRequest:
     """
     Builds the JSON request for the 'LoadChunks' operation.
@@ -51,6 +53,8 @@ def build_load_chunks_req(
                        negative indices and open-ended slices (e.g., `data[2:]`)
                        into a concrete slice with non-negative start/stop values.
         check_checksums: Whether to verify checksums during load.
+        access: Access hint for this request, overriding the reader's.
+        prefetch_chunks: Chunks to prefetch ahead of the one being read.
     """
     selection_dict: dict[str, Any]
     if selection_key is None:
@@ -85,11 +89,16 @@ def build_load_chunks_req(
     else:
         raise TypeError(f"Unsupported selection key type: {type(selection_key)}")
 
-    return {
+    req: JsonRequest = {
         "op_type": "LoadChunks",
         "selection": selection_dict,
         "check_checksums": check_checksums,
     }
+    if access is not None:
+        req["access"] = access
+    if prefetch_chunks is not None:
+        req["prefetch_chunks"] = prefetch_chunks
+    return req
 
 def build_set_user_metadata_req(metadata: dict) -> JsonRequest:
     """Builds the request to set user metadata."""
@@ -111,6 +120,13 @@ def build_inspect_req() -> JsonRequest:
     """Builds the JSON request for the 'Inspect' operation."""
     return {"op_type": "Inspect"}
 
+def build_verify_req(max_read_mbps: Optional[float] = None) -> JsonRequest:
+    """Builds the JSON request for the 'Verify' operation."""
+    req: JsonRequest = {"op_type": "Verify"}
+    if max_read_mbps is not None:
+        req["max_read_mbps"] = max_read_mbps
+    return req
+
 def build_get_user_metadata_req() -> JsonRequest:
     """Builds the JSON request for the 'GetUserMetadata' operation."""
     return {"op_type": "GetUserMetadata"}
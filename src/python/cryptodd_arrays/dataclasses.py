@@ -23,6 +23,7 @@ class StoreResult:
     original_size: int
     compressed_size: int
     compression_ratio: float
+    zstd_level: int = 0
 
 @dataclass(frozen=True, slots=True)
 class FileHeaderInfo:
@@ -31,3 +32,17 @@ class FileHeaderInfo:
     index_block_offset: int
     index_block_size: int
     user_metadata_base64: str
+
+@dataclass(frozen=True, slots=True)
+class VerifyReport:
+    """Result of scrubbing a file with `Reader.verify()`."""
+    ok: bool
+    chunks_verified: int
+    chunks_unhashed: int
+    index_blocks: int
+    bytes_read: int
+    raw_bytes: int
+    corrupted_chunks: Tuple[int, ...]
+    index_error: Optional[str]
+    elapsed_s: float
+    read_mbps: float
@@ -3,6 +3,7 @@
 
 import json
 import base64
+import warnings
 from typing import Any, Optional, overload, Union, List
 import numpy as np
 from functools import cached_property
@@ -10,7 +11,7 @@ from functools import cached_property
 from .abc import CddFileBase
 from .lowlevel import LowLevelWrapper
 from .types import Codec
-from .dataclasses import ChunkInfo, FileHeaderInfo, StoreResult
+from .dataclasses import ChunkInfo, FileHeaderInfo, StoreResult, VerifyReport
 from ._internal import json_builder, numpy_utils, codec_selector
 from .exceptions import CddConfigError
 
@@ -19,7 +20,18 @@ def open(
     mode: str = 'r',
     *,
     user_metadata: Optional[dict[str, Any]] = None,
-    check_checksums: bool = True
+    check_checksums: bool = True,
+    adaptive_zstd: Optional[dict[str, Any]] = None,
+    hash_algorithm: Optional[str] = None,
+    hash_parallel_threshold: Optional[int] = None,
+    write_buffer_size: Optional[int] = None,
+    preallocate_extent: Optional[int] = None,
+    durability: Optional[dict[str, Any]] = None,
+    chunk_alignment: Optional[int] = None,
+    bitpack_index: Optional[bool] = None,
+    direct_io: bool = False,
+    access: Optional[str] = None,
+    mmap: Union[bool, dict[str, Any], None] = None
 ) -> Union["Reader", "Writer"]:
     """
     Opens a cryptodd-arrays file or an in-memory buffer.
@@ -35,6 +47,53 @@ def open(
             file-level metadata upon creation. Must be JSON-serializable.
         check_checksums (bool): For 'r' mode only. If True (default),
             verifies data integrity on read.
+        adaptive_zstd (dict, optional): For 'w' and 'a' modes. Targets of the
+            level chosen for chunks appended with zstd_adaptive=True: any of
+            min_level, max_level, initial_level, target_mbps (minimum encode
+            throughput) and max_latency_ms (maximum encode time per chunk).
+        hash_algorithm (str, optional): For 'w' and 'a' modes. The integrity
+            hash of appended chunks: 'BLAKE3_256' (default), 'XXH3_128' (much
+            faster, not cryptographic) or 'NONE'. append_chunk(hash_algorithm=...)
+            overrides it per chunk; readers verify each chunk with its own.
+        hash_parallel_threshold (int, optional): For 'w' and 'a' modes. BLAKE3
+            chunks at least this many bytes long are hashed on several threads.
+        write_buffer_size (int, optional): For 'w' and 'a' modes. Bytes of
+            appended data held in memory and written out in large blocks
+            (default 8 MiB); 0 writes each chunk through. Data is only
+            guaranteed to be in the file after flush() or close().
+        preallocate_extent (int, optional): For 'w' and 'a' modes. Disk space
+            is reserved ahead of the data in extents of this many bytes,
+            without changing the file size, and the unused part is released
+            on close. Reduces fragmentation with many concurrent writers.
+            Requires a non-zero write_buffer_size.
+        durability (dict, optional): For 'w' and 'a' modes. When appended
+            data is synced to the device: {"mode": "EVERY_N_CHUNKS",
+            "every_chunks": n}, {"mode": "INTERVAL", "interval_ms": t},
+            {"mode": "EACH_APPEND"} or {"mode": "NONE"} (default). Except
+            with NONE, flush() and close() also sync.
+        chunk_alignment (int, optional): For 'w' and 'a' modes. Appended
+            chunks start at multiples of this power of two (e.g. 4096 for
+            direct_io readers), zero-padded; 0 (default) packs them.
+        bitpack_index (bool, optional): For 'w' and 'a' modes. Writes the
+            chunk index as bit-packed deltas, which open faster than the
+            default delta + zstd but need a reader that knows the format.
+        direct_io (bool): For files. Reads or writes bypass the OS page
+            cache (O_DIRECT) where the file system supports it, so bulk
+            ingest and scans do not evict data cached for other readers.
+            Meant for sequential access; writing needs a write buffer.
+        access (str, optional): For 'r' mode only. How the file will be
+            read, for the OS readahead: 'SEQUENTIAL' (scans), 'RANDOM'
+            (point lookups, no readahead), 'WILLNEED' (start reading the
+            whole file now) or 'NORMAL' (default). Reader.read() can
+            override it per request.
+        mmap (bool | dict, optional): For 'r' mode only. Reads through a
+            memory mapping of the file instead of read calls. A dict sets
+            the mapping up: "populate" (fault the whole file in when it is
+            mapped), "huge_pages" (transparent huge pages, fewer TLB misses
+            on large files) and "lock_index" (mlock the chunk index, as far
+            as RLIMIT_MEMLOCK allows; a RuntimeWarning tells when it could
+            not, see Reader.index_lock_error).
+            Excludes direct_io.
 
     Returns:
         A Reader or Writer object, typically used within a `with` statement.
@@ -50,6 +109,8 @@ def open(
     if is_memory_backend:
         if mode != 'w':
             raise ValueError("In-memory backend only supports 'w' (write) mode.")
+        if direct_io:
+            raise ValueError("direct_io is only supported for files.")
         backend_config = {"type": "Memory", "mode": "WriteTruncate"}
         if user_metadata is not None:
              try:
@@ -77,6 +138,29 @@ def open(
                  raise ValueError("user_metadata cannot be provided in 'a' (append) mode.")
         else:
             raise ValueError(f"Unsupported mode for file-based backend: '{mode}'. Must be 'r', 'w', or 'a'.")
+        if direct_io:
+            backend_config["direct_io"] = True
+        if access is not None:
+            if mode != 'r':
+                raise ValueError("access can only be provided in 'r' mode.")
+            backend_config["access"] = access
+        if mmap:
+            if mode != 'r':
+                raise ValueError("mmap can only be provided in 'r' mode.")
+            backend_config["mmap"] = mmap if isinstance(mmap, dict) else {}
+
+    if adaptive_zstd is not None:
+        if mode == 'r':
+            raise ValueError("adaptive_zstd can only be provided in 'w' or 'a' mode.")
+        writer_options["adaptive_zstd"] = adaptive_zstd
+    for name, value in (("hash_algorithm", hash_algorithm), ("hash_parallel_threshold", hash_parallel_threshold),
+                        ("write_buffer_size", write_buffer_size), ("preallocate_extent", preallocate_extent),
+                        ("durability", durability), ("chunk_alignment", chunk_alignment),
+                        ("bitpack_index", bitpack_index)):
+        if value is not None:
+            if mode == 'r':
+                raise ValueError(f"{name} can only be provided in 'w' or 'a' mode.")
+            writer_options[name] = value
 
     full_config = {"backend": backend_config}
     if writer_options:
@@ -93,7 +177,10 @@ def open(
     if is_memory_backend or mode in ('w', 'a'):
         return Writer(wrapper)
     else: # mode == 'r'
-        return Reader(wrapper, check_checksums=check_checksums)
+        reader = Reader(wrapper, check_checksums=check_checksums)
+        if isinstance(mmap, dict) and mmap.get("lock_index") and reader.index_lock_error:
+            warnings.warn(f"The chunk index is not locked in memory: {reader.index_lock_error}", RuntimeWarning, stacklevel=2)
+        return reader
 
 # =============================================================================
 # Writer and Reader classes remain the same as before
@@ -137,7 +224,24 @@ class Writer(CddFileBase):
         Args:
             data (np.ndarray): The data to write. Must be C-contiguous.
             codec: The codec to use, either as a Codec enum or string name.
-            **codec_params: Optional parameters for the codec (e.g., zstd_level).
+            **codec_params: Optional parameters for the codec (e.g., zstd_level, or
+                num_frames to split the chunk into row ranges encoded in parallel).
+                ZSTD_COMPRESSED also accepts zstd_workers, zstd_long_distance_matching,
+                zstd_window_log and zstd_strategy (e.g. "BTULTRA2").
+                *_FIXED_POINT_* codecs take tick_sizes, one per column/feature or a
+                single one for all.
+                GENERIC_OB_SIMD_BFP16_AS_F32 is lossy; its chunks stay within an error
+                bound the codec records per feature.
+                GENERIC_OB_SIMD_SPARSE_F32 suits books where few levels change between
+                snapshots; busier chunks are stored as GENERIC_OB_SIMD_F32.
+                *_QUANTIZED_* codecs take error_bounds, the maximum absolute error per
+                column or a single one for all; relative_error_bound=True makes them a
+                fraction of each column's largest magnitude in the chunk.
+                zstd_adaptive=True replaces zstd_level with the level the writer's
+                adaptive controller picks (see `open(adaptive_zstd=...)`); codecs
+                without a zstd stage (RAW, TEMPORAL_1D_CHIMP_*,
+                TEMPORAL_1D_SIMD_I64_DELTA_BITPACK) reject it.
+                hash_algorithm overrides the writer's chunk hash (see `open()`).
 
         Returns:
             A StoreResult object with details of the write operation.
@@ -152,6 +256,7 @@ class Writer(CddFileBase):
             original_size=details.get("original_size", -1),
             compressed_size=details.get("compressed_size", -1),
             compression_ratio=details.get("compression_ratio", 0.0),
+            zstd_level=details.get("zstd_level", 0),
         )
 
     def flush(self) -> None:
@@ -159,6 +264,16 @@ class Writer(CddFileBase):
         req = json_builder.build_flush_req()
         self._wrapper.execute(req)
 
+    def sync_stats(self) -> Optional[dict[str, Any]]:
+        """
+        Flushes, then returns the group commit statistics of the device
+        holding the file (requests, batches, syncs, failures, and sync
+        latencies in microseconds: mean_us, p50_us, p99_us, max_us and
+        power-of-two latency_buckets), or None if the writer does not sync.
+        """
+        req = json_builder.build_flush_req()
+        return self._wrapper.execute(req).get("sync_stats")
+
     def close(self) -> None:
         self.flush()
         self._wrapper.close()
@@ -220,6 +335,12 @@ class Reader(CddFileBase):
             ) for s in summaries
         ]
 
+    @property
+    def index_lock_error(self) -> Optional[str]:
+        """Why the chunk index could not be locked in memory (mmap
+        "lock_index"), or None if it was locked or not asked to be."""
+        return self._inspection.get("index_lock_error")
+
     @property
     def nchunks(self) -> int:
         """The total number of chunks in the file."""
@@ -242,6 +363,29 @@ class Reader(CddFileBase):
         - `reader[2:5]` reads chunks 2, 3, and 4 and concatenates them into
           a single NumPy array.
         """
+        return self.read(key)
+
+    def read(
+        self,
+        key: Union[int, slice],
+        *,
+        access: Optional[str] = None,
+        prefetch_chunks: Optional[int] = None
+    ) -> np.ndarray:
+        """
+        Reads data by chunk index or slice, like `reader[key]`.
+
+        Args:
+            key: A chunk index or a slice of chunks (step 1).
+            access: Overrides the access hint given to `open` for this read
+                ('SEQUENTIAL', 'RANDOM', 'WILLNEED' or 'NORMAL').
+                'SEQUENTIAL' and 'RANDOM' only take effect if the file was
+                opened with one of them or with mmap; otherwise only
+                'WILLNEED' does. With direct_io, hints are ignored.
+            prefetch_chunks: How many chunks to keep reading ahead of the
+                one being decoded (default 4, none with 'RANDOM'); 0
+                disables it.
+        """
         resolved_slice: slice
         is_single_item = isinstance(key, int)
 
@@ -274,13 +418,35 @@ class Reader(CddFileBase):
         output_buffer = np.empty(int(total_elements), dtype=output_dtype)
 
         # Build request and execute
-        req = json_builder.build_load_chunks_req(resolved_slice, self._check_checksums)
+        req = json_builder.build_load_chunks_req(resolved_slice, self._check_checksums, access, prefetch_chunks)
         result = self._wrapper.execute(req, output_data=output_buffer)
 
         # Reshape the flat buffer to its final N-dimensional shape
         final_shape = tuple(result.get("final_shape", output_buffer.shape))
         return output_buffer.reshape(final_shape)
 
+    def verify(self, max_read_mbps: Optional[float] = None) -> VerifyReport:
+        """
+        Checks every chunk and index block against its stored hash without
+        loading the data. Corruption is reported, not raised.
+
+        Args:
+            max_read_mbps: Caps the read rate from storage, in MB/s.
+        """
+        res = self._wrapper.execute(json_builder.build_verify_req(max_read_mbps))
+        return VerifyReport(
+            ok=res["ok"],
+            chunks_verified=res["chunks_verified"],
+            chunks_unhashed=res["chunks_unhashed"],
+            index_blocks=res["index_blocks"],
+            bytes_read=res["bytes_read"],
+            raw_bytes=res["raw_bytes"],
+            corrupted_chunks=tuple(fault["index"] for fault in res["faults"]),
+            index_error=res.get("index_error"),
+            elapsed_s=res["elapsed_s"],
+            read_mbps=res["read_mbps"],
+        )
+
     def close(self) -> None:
         self._wrapper.close()
 
@@ -30,6 +30,45 @@ class Codec(IntEnum):
     TEMPORAL_2D_SIMD_F32 = 13
     TEMPORAL_2D_SIMD_I64 = 14
 
+    # Temporal 1D Chimp128 (lossless bit-packed floats, no zstd stage)
+    TEMPORAL_1D_CHIMP_F32 = 15
+    TEMPORAL_1D_CHIMP_F64 = 16
+
+    # Temporal 1D int64 delta + zigzag + bit-packing (optionally with zstd on top)
+    TEMPORAL_1D_SIMD_I64_DELTA_BITPACK = 17
+    TEMPORAL_1D_SIMD_I64_DELTA_BITPACK_ZSTD = 18
+
+    # Delta-of-delta int64 (1D series and per-column 2D), for near-constant-interval timestamps
+    TEMPORAL_1D_SIMD_I64_DOUBLE_DELTA = 19
+    TEMPORAL_2D_SIMD_I64_DOUBLE_DELTA = 20
+
+    # Temporal 2D int64 per-column delta (optionally byte-shuffled before zstd)
+    TEMPORAL_2D_SIMD_I64_DELTA = 21
+    TEMPORAL_2D_SIMD_I64_DELTA_SHUFFLE = 22
+
+    # Float64 XOR + 8-byte shuffle (1D series and per-column 2D)
+    TEMPORAL_1D_SIMD_F64_XOR_SHUFFLE = 23
+    TEMPORAL_2D_SIMD_F64 = 24
+
+    # Fixed-point floats quantized to a tick size (pass tick_sizes=[...]); off-grid chunks use the float codec
+    TEMPORAL_1D_FIXED_POINT_F32 = 25
+    TEMPORAL_1D_FIXED_POINT_F64 = 26
+    TEMPORAL_2D_FIXED_POINT_F32 = 27
+    TEMPORAL_2D_FIXED_POINT_F64 = 28
+    ORDERBOOK_FIXED_POINT_F32 = 29
+
+    # Block-floating-point orderbook: f16 residuals against a per-snapshot reference (lossy, bounded error)
+    GENERIC_OB_SIMD_BFP16_AS_F32 = 30
+    # Sparse orderbook delta: changed-levels bitmap plus changed values (falls back to GENERIC_OB_SIMD_F32)
+    GENERIC_OB_SIMD_SPARSE_F32 = 31
+
+    # Error-bounded lossy floats (pass error_bounds=[...], optionally relative_error_bound=True);
+    # chunks that cannot be quantized use the lossless float codec
+    TEMPORAL_1D_QUANTIZED_F32 = 32
+    TEMPORAL_1D_QUANTIZED_F64 = 33
+    TEMPORAL_2D_QUANTIZED_F32 = 34
+    TEMPORAL_2D_QUANTIZED_F64 = 35
+
     # Deprecated/Exchange-Specific (for reference)
     OKX_OB_SIMD_F16_AS_F32 = 2
     OKX_OB_SIMD_F32 = 3
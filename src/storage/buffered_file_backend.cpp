@@ -0,0 +1,502 @@
+#include "buffered_file_backend.h"
+#include "file_advice.h"
+#include "file_allocation.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#include <share.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace cryptodd::storage {
+
+namespace {
+#if defined(_WIN32)
+    // The CRT has no positional nor vectored I/O: each call seeks, then writes the buffers one after the other.
+    // The backend is single-threaded, so nothing can move the file position in between.
+    struct iovec {
+        void* iov_base;
+        size_t iov_len;
+    };
+    using ssize_t = std::ptrdiff_t;
+    constexpr size_t IOV_MAX = 1024;
+    constexpr size_t MAX_CRT_IO = INT_MAX;
+
+    // The CRT cannot open files unbuffered, so `direct` is always turned off.
+    int open_file(const std::filesystem::path& path, const bool writable, const bool truncate, bool& direct) {
+        direct = false;
+        int flags = _O_BINARY | _O_NOINHERIT | (writable ? _O_RDWR | _O_CREAT : _O_RDONLY);
+        if (truncate) flags |= _O_TRUNC;
+        int fd = -1;
+        if (const errno_t err = _wsopen_s(&fd, path.c_str(), flags, _SH_DENYNO, _S_IREAD | _S_IWRITE); err != 0) {
+            errno = err;
+            return -1;
+        }
+        return fd;
+    }
+
+    bool file_size(const int fd, uint64_t& size) {
+        struct _stat64 st{};
+        if (_fstat64(fd, &st) != 0) return false;
+        size = static_cast<uint64_t>(st.st_size);
+        return true;
+    }
+
+    ssize_t pread_at(const int fd, void* buffer, const size_t length, const uint64_t offset) {
+        if (_lseeki64(fd, static_cast<__int64>(offset), SEEK_SET) < 0) return -1;
+        return _read(fd, buffer, static_cast<unsigned>(std::min(length, MAX_CRT_IO)));
+    }
+
+    ssize_t pwritev_at(const int fd, const iovec* iov, const int count, const uint64_t offset) {
+        if (_lseeki64(fd, static_cast<__int64>(offset), SEEK_SET) < 0) return -1;
+        ssize_t total = 0;
+        for (int i = 0; i < count; ++i) {
+            const size_t length = std::min(iov[i].iov_len, MAX_CRT_IO);
+            const int n = _write(fd, iov[i].iov_base, static_cast<unsigned>(length));
+            if (n < 0) return total > 0 ? total : -1;
+            total += n;
+            if (static_cast<size_t>(n) < iov[i].iov_len) break;
+        }
+        return total;
+    }
+
+    int truncate_file(const int fd, const uint64_t size) {
+        if (const errno_t err = _chsize_s(fd, static_cast<__int64>(size)); err != 0) {
+            errno = err;
+            return -1;
+        }
+        return 0;
+    }
+
+    int close_file(const int fd) { return _close(fd); }
+#else
+    // Turns `direct` off when the file cannot be opened for direct I/O.
+    int open_file(const std::filesystem::path& path, const bool writable, const bool truncate, bool& direct) {
+        int flags = (writable ? O_RDWR | O_CREAT : O_RDONLY) | O_CLOEXEC;
+        if (truncate) flags |= O_TRUNC;
+#if defined(O_DIRECT)
+        if (direct) {
+            const int fd = ::open(path.c_str(), flags | O_DIRECT, 0644);
+            // File systems without direct I/O, like tmpfs, refuse the flag.
+            if (fd >= 0 || errno != EINVAL) return fd;
+        }
+        direct = false;
+        return ::open(path.c_str(), flags, 0644);
+#elif defined(F_NOCACHE)
+        const int fd = ::open(path.c_str(), flags, 0644);
+        if (direct && fd >= 0 && ::fcntl(fd, F_NOCACHE, 1) != 0) direct = false;
+        return fd;
+#else
+        direct = false;
+        return ::open(path.c_str(), flags, 0644);
+#endif
+    }
+
+    bool file_size(const int fd, uint64_t& size) {
+        struct stat st{};
+        if (::fstat(fd, &st) != 0) return false;
+        size = static_cast<uint64_t>(st.st_size);
+        return true;
+    }
+
+    ssize_t pread_at(const int fd, void* buffer, const size_t length, const uint64_t offset) {
+        return ::pread(fd, buffer, length, static_cast<off_t>(offset));
+    }
+
+    ssize_t pwritev_at(const int fd, const iovec* iov, const int count, const uint64_t offset) {
+        return ::pwritev(fd, iov, count, static_cast<off_t>(offset));
+    }
+
+    int truncate_file(const int fd, const uint64_t size) { return ::ftruncate(fd, static_cast<off_t>(size)); }
+
+    int close_file(const int fd) { return ::close(fd); }
+#endif
+
+    std::string errno_message(const std::string& what) {
+        return "BufferedFileBackend: " + what + ": " + std::generic_category().message(errno);
+    }
+
+    constexpr uint64_t align_down(const uint64_t value) { return value / BufferedFileBackend::IO_ALIGNMENT * BufferedFileBackend::IO_ALIGNMENT; }
+    constexpr uint64_t align_up(const uint64_t value) { return align_down(value + BufferedFileBackend::IO_ALIGNMENT - 1); }
+
+    // Writes every byte of `iov` at `offset`, resuming after short writes, at most IOV_MAX buffers per call.
+    std::expected<void, std::string> pwritev_all(const int fd, uint64_t offset, std::span<iovec> iov,
+                                                 BufferedFileBackend::IoStats& stats) {
+        while (!iov.empty()) {
+            const int count = static_cast<int>(std::min<size_t>(iov.size(), IOV_MAX));
+            const ssize_t written = pwritev_at(fd, iov.data(), count, offset);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                return std::unexpected(errno_message("pwritev failed"));
+            }
+            ++stats.write_calls;
+            stats.bytes_written += static_cast<uint64_t>(written);
+            offset += static_cast<uint64_t>(written);
+
+            auto remaining = static_cast<size_t>(written);
+            while (!iov.empty() && remaining >= iov.front().iov_len) {
+                remaining -= iov.front().iov_len;
+                iov = iov.subspan(1);
+            }
+            if (remaining > 0) {
+                iov.front().iov_base = static_cast<std::byte*>(iov.front().iov_base) + remaining;
+                iov.front().iov_len -= remaining;
+            }
+        }
+        return {};
+    }
+}
+
+BufferedFileBackend::BufferedFileBackend(std::filesystem::path filepath, std::ios_base::openmode mode, WriteBufferOptions options)
+    : filepath_(std::move(filepath)), options_(options) {
+    options_.block_size = std::max(IO_ALIGNMENT, (options_.block_size + IO_ALIGNMENT - 1) / IO_ALIGNMENT * IO_ALIGNMENT);
+    options_.max_buffered_blocks = std::max<size_t>(options_.max_buffered_blocks, 1);
+    writable_ = (mode & std::ios_base::out) != 0;
+
+    // Same as FileBackend: writing without reading truncates.
+    const bool truncate = (mode & std::ios_base::trunc) || (writable_ && !(mode & std::ios_base::in));
+    direct_ = options_.direct_io;
+    fd_ = open_file(filepath_, writable_, truncate, direct_);
+    if (fd_ < 0) {
+        throw std::runtime_error(errno_message("Failed to open file '" + filepath_.string() + "'"));
+    }
+
+    if (!file_size(fd_, size_)) {
+        const auto message = errno_message("Failed to stat file '" + filepath_.string() + "'");
+        close_file(fd_);
+        throw std::runtime_error(message);
+    }
+    disk_size_ = allocated_end_ = size_;
+
+    if (!writable_) {
+        tail_start_ = size_;
+        return;
+    }
+    // Appends continue the last, partial block, so it is staged as it is on disk to keep writes block-aligned.
+    tail_start_ = size_ - size_ % options_.block_size;
+    tail_size_ = static_cast<size_t>(size_ - tail_start_);
+    if (tail_size_ > 0) {
+        blocks_.push_back(take_block());
+        const auto n = read_at(blocks_.front().get(), direct_ ? align_up(tail_size_) : tail_size_, tail_start_);
+        if (!n || *n < tail_size_) {
+            const auto message = n ? "BufferedFileBackend: Failed to read the last block of '" + filepath_.string() + "': unexpected end of file"
+                                   : n.error();
+            close_file(fd_);
+            throw std::runtime_error(message);
+        }
+    }
+}
+
+BufferedFileBackend::~BufferedFileBackend() {
+    if (fd_ < 0) return;
+    // Errors are ignored in the destructor; call flush() first to see them.
+    if (writable_ && write_out(true)) {
+        if (disk_size_ > size_) {
+            // Cuts off the sector padding and, with it, the reservation past the end.
+            (void)truncate_file(fd_, size_);
+        } else {
+            (void)release_preallocated(fd_, size_, allocated_end_);
+        }
+    }
+    close_file(fd_);
+}
+
+BufferedFileBackend::Block BufferedFileBackend::allocate_block(const size_t size) {
+    return Block(static_cast<std::byte*>(::operator new[](size, std::align_val_t{IO_ALIGNMENT})));
+}
+
+BufferedFileBackend::Block BufferedFileBackend::take_block() {
+    if (!spare_blocks_.empty()) {
+        Block block = std::move(spare_blocks_.back());
+        spare_blocks_.pop_back();
+        return block;
+    }
+    return allocate_block(options_.block_size);
+}
+
+std::expected<size_t, std::string> BufferedFileBackend::read_at(std::byte* buffer, const size_t length, const uint64_t offset) {
+    size_t done = 0;
+    while (done < length) {
+        const size_t requested = length - done;
+        const ssize_t n = pread_at(fd_, buffer + done, requested, offset + done);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return std::unexpected(errno_message("pread failed"));
+        }
+        ++stats_.read_calls;
+        stats_.bytes_read += static_cast<uint64_t>(n);
+        done += static_cast<size_t>(n);
+        // A short direct read is the end of the file; asking for the rest would be a misaligned read.
+        if (n == 0 || (direct_ && static_cast<size_t>(n) < requested)) break;
+    }
+    return done;
+}
+
+std::expected<size_t, std::string> BufferedFileBackend::read_window(std::span<std::byte> buffer) {
+    size_t done = 0;
+    while (done < buffer.size()) {
+        if (pos_ < window_start_ || pos_ >= window_start_ + window_size_) {
+            // Without direct I/O, what is left of a read at least a window long goes straight to the caller.
+            if (!direct_ && buffer.size() - done >= options_.block_size) {
+                const auto n = read_at(buffer.data() + done, buffer.size() - done, pos_);
+                if (!n) return std::unexpected(n.error());
+                done += *n;
+                pos_ += *n;
+                break;
+            }
+            if (!window_) window_ = allocate_block(options_.block_size);
+            window_start_ = align_down(pos_);
+            window_size_ = 0;
+            // Direct reads must cover whole sectors; the others stop at the end of the file instead of probing past it.
+            const size_t length = direct_ ? options_.block_size
+                                          : static_cast<size_t>(std::min<uint64_t>(options_.block_size, size_ - window_start_));
+            const auto n = read_at(window_.get(), length, window_start_);
+            if (!n) return std::unexpected(n.error());
+            window_size_ = *n;
+            if (pos_ >= window_start_ + window_size_) break;
+        }
+        const auto n = static_cast<size_t>(std::min<uint64_t>(buffer.size() - done, window_start_ + window_size_ - pos_));
+        std::memcpy(buffer.data() + done, window_.get() + (pos_ - window_start_), n);
+        done += n;
+        pos_ += n;
+    }
+    return done;
+}
+
+std::expected<void, std::string> BufferedFileBackend::write_patch(const uint64_t offset, std::span<std::byte> data) {
+    if (!direct_) {
+        iovec iov{data.data(), data.size()};
+        return pwritev_all(fd_, offset, std::span(&iov, 1), stats_);
+    }
+    // Patches lie before the staged tail, in sectors already written, which are read back to be patched whole.
+    const uint64_t start = align_down(offset);
+    const auto length = static_cast<size_t>(align_up(offset + data.size()) - start);
+    Block sectors = length <= options_.block_size ? take_block() : allocate_block(length);
+    const auto n = read_at(sectors.get(), length, start);
+    if (!n) return std::unexpected(n.error());
+    std::memset(sectors.get() + *n, 0, length - *n);
+    std::memcpy(sectors.get() + (offset - start), data.data(), data.size());
+
+    iovec iov{sectors.get(), length};
+    auto res = pwritev_all(fd_, start, std::span(&iov, 1), stats_);
+    if (length <= options_.block_size) {
+        spare_blocks_.push_back(std::move(sectors));
+    }
+    return res;
+}
+
+void BufferedFileBackend::add_patch(const uint64_t offset, std::span<const std::byte> data) {
+    const uint64_t data_end = offset + data.size();
+    auto first = patches_.upper_bound(offset);
+    if (first != patches_.begin()) {
+        if (const auto prev = std::prev(first); prev->first + prev->second.size() >= offset) first = prev;
+    }
+    auto last = first;
+    uint64_t start = offset;
+    uint64_t end = data_end;
+    for (; last != patches_.end() && last->first <= data_end; ++last) {
+        start = std::min(start, last->first);
+        end = std::max<uint64_t>(end, last->first + last->second.size());
+    }
+
+    // Rewriting or extending a single patch, like consecutive index slots, is done in place.
+    if (first != last && std::next(first) == last && first->first <= offset) {
+        auto& buffer = first->second;
+        buffer.resize(std::max<size_t>(buffer.size(), data_end - first->first));
+        std::ranges::copy(data, buffer.begin() + static_cast<ptrdiff_t>(offset - first->first));
+        return;
+    }
+
+    memory::vector<std::byte> merged(end - start);
+    for (auto it = first; it != last; ++it) {
+        std::ranges::copy(it->second, merged.begin() + static_cast<ptrdiff_t>(it->first - start));
+    }
+    std::ranges::copy(data, merged.begin() + static_cast<ptrdiff_t>(offset - start));
+    patches_.erase(first, last);
+    patches_.emplace(start, std::move(merged));
+}
+
+std::expected<void, std::string> BufferedFileBackend::reserve(const uint64_t end) {
+    const uint64_t extent = options_.preallocate_extent;
+    if (extent == 0 || end <= allocated_end_) return {};
+    const uint64_t new_end = (end + extent - 1) / extent * extent;
+    auto reserved = preallocate(fd_, allocated_end_, new_end - allocated_end_, true);
+    if (!reserved) return std::unexpected("BufferedFileBackend: " + reserved.error());
+    if (*reserved) {
+        stats_.preallocated_bytes += new_end - allocated_end_;
+    }
+    // Where preallocation is unsupported, recording the end anyway keeps from retrying on every write.
+    allocated_end_ = new_end;
+    return {};
+}
+
+std::expected<void, std::string> BufferedFileBackend::write_out(const bool all) {
+    const size_t block_size = options_.block_size;
+    const size_t full_blocks = tail_size_ / block_size;
+    const size_t partial = all ? tail_size_ % block_size : 0;
+
+    // Whatever is written below, the window may no longer match the file.
+    window_size_ = 0;
+
+    // Data goes out before the patches, so an index entry never reaches the file ahead of its chunk.
+    if (tail_dirty_ && (full_blocks > 0 || partial > 0)) {
+        std::vector<iovec> iov;
+        iov.reserve(full_blocks + 1);
+        for (size_t i = 0; i < full_blocks; ++i) {
+            iov.push_back({blocks_[i].get(), block_size});
+        }
+        const uint64_t data_end = tail_start_ + full_blocks * block_size + partial;
+        if (partial > 0) {
+            // Direct I/O writes the last sector whole, zero-padded; the padding is cut off on close.
+            const size_t length = direct_ ? static_cast<size_t>(align_up(partial)) : partial;
+            std::memset(blocks_[full_blocks].get() + partial, 0, length - partial);
+            iov.push_back({blocks_[full_blocks].get(), length});
+        }
+        if (auto res = reserve(std::max(data_end, size_)); !res) return res;
+        if (auto res = pwritev_all(fd_, tail_start_, iov, stats_); !res) return res;
+        disk_size_ = std::max<uint64_t>(disk_size_, direct_ ? align_up(data_end) : data_end);
+    }
+
+    for (auto& [offset, data] : patches_) {
+        if (auto res = write_patch(offset, data); !res) return res;
+    }
+    patches_.clear();
+
+    // A seek past the end that was never written to still extends the file. Sector padding is left in place until
+    // close: truncating it away would also release the reservation past it, taken again by the very next append.
+    if (all && size_ > disk_size_) {
+        if (truncate_file(fd_, size_) != 0) {
+            return std::unexpected(errno_message("Failed to set the file size"));
+        }
+        disk_size_ = size_;
+    }
+
+    // Written full blocks are recycled; a partial one stays staged so later appends rewrite it whole.
+    for (size_t i = 0; i < full_blocks; ++i) {
+        spare_blocks_.push_back(std::move(blocks_[i]));
+    }
+    blocks_.erase(blocks_.begin(), blocks_.begin() + static_cast<ptrdiff_t>(full_blocks));
+    tail_start_ += full_blocks * block_size;
+    tail_size_ -= full_blocks * block_size;
+    tail_dirty_ = !all && tail_size_ > 0;
+    return {};
+}
+
+std::expected<size_t, std::string> BufferedFileBackend::read(std::span<std::byte> buffer) {
+    if (writable_ && (tail_dirty_ || !patches_.empty() || size_ > disk_size_)) {
+        if (auto res = write_out(true); !res) return std::unexpected(res.error());
+    }
+    if (pos_ >= size_) {
+        return 0;
+    }
+    const size_t to_read = static_cast<size_t>(std::min<uint64_t>(buffer.size(), size_ - pos_));
+    if (direct_ || !writable_) {
+        return read_window(buffer.first(to_read));
+    }
+    const auto done = read_at(buffer.data(), to_read, pos_);
+    if (!done) return done;
+    pos_ += *done;
+    return done;
+}
+
+std::expected<size_t, std::string> BufferedFileBackend::write(std::span<const std::byte> data) {
+    if (!writable_) {
+        return std::unexpected("BufferedFileBackend: Attempted to write to a read-only backend.");
+    }
+    const size_t total = data.size();
+    const size_t block_size = options_.block_size;
+
+    // A seek past the end leaves a gap, staged as zeros ahead of the data.
+    while (!data.empty()) {
+        if (pos_ < tail_start_) {
+            const auto n = static_cast<size_t>(std::min<uint64_t>(data.size(), tail_start_ - pos_));
+            add_patch(pos_, data.first(n));
+            data = data.subspan(n);
+            pos_ += n;
+            continue;
+        }
+
+        const bool gap = pos_ > tail_end();
+        const uint64_t relative = (gap ? tail_end() : pos_) - tail_start_;
+        const size_t block_index = relative / block_size;
+        const size_t in_block = relative % block_size;
+        while (blocks_.size() <= block_index) {
+            blocks_.push_back(take_block());
+        }
+        size_t n = block_size - in_block;
+        if (gap) {
+            n = static_cast<size_t>(std::min<uint64_t>(n, pos_ - tail_end()));
+            std::memset(blocks_[block_index].get() + in_block, 0, n);
+        } else {
+            n = std::min(n, data.size());
+            std::memcpy(blocks_[block_index].get() + in_block, data.data(), n);
+            data = data.subspan(n);
+            pos_ += n;
+        }
+        tail_size_ = std::max<size_t>(tail_size_, relative + n);
+        tail_dirty_ = true;
+
+        if (tail_size_ >= options_.max_buffered_blocks * block_size) {
+            if (auto res = write_out(false); !res) return std::unexpected(res.error());
+        }
+    }
+    size_ = std::max(size_, pos_);
+    return total;
+}
+
+std::expected<void, std::string> BufferedFileBackend::seek(const uint64_t offset) {
+    // Like the other backends, seeking past the end grows the file; nothing is written until it has to be.
+    if (writable_) {
+        size_ = std::max(size_, offset);
+    }
+    pos_ = offset;
+    return {};
+}
+
+std::expected<uint64_t, std::string> BufferedFileBackend::tell() {
+    return pos_;
+}
+
+std::expected<void, std::string> BufferedFileBackend::flush() {
+    if (!writable_ || (!tail_dirty_ && patches_.empty() && size_ <= disk_size_)) {
+        return {};
+    }
+    ++stats_.flushes;
+    return write_out(true);
+}
+
+std::expected<void, std::string> BufferedFileBackend::rewind() {
+    pos_ = 0;
+    return {};
+}
+
+std::expected<uint64_t, std::string> BufferedFileBackend::size() {
+    return size_;
+}
+
+std::expected<bool, std::string> BufferedFileBackend::advise(const AccessHint hint, const uint64_t offset, const uint64_t length) {
+    if (direct_) {
+        return false;
+    }
+    auto res = advise_file(fd_, hint, offset, length);
+    if (!res) {
+        return std::unexpected("BufferedFileBackend: " + res.error());
+    }
+    return res;
+}
+
+} // namespace cryptodd::storage
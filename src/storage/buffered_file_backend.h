@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <ios>
+#include <map>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "i_storage_backend.h"
+#include "../memory/allocator.h"
+
+namespace cryptodd::storage {
+
+struct WriteBufferOptions {
+    size_t block_size = size_t{1} << 20; // rounded up to a multiple of BufferedFileBackend::IO_ALIGNMENT
+    size_t max_buffered_blocks = 8;
+    // Disk space is reserved ahead of the data in extents of this size (fallocate, keeping the file size) and what
+    // is left past the end is given back on close; 0 lets the file grow as it is written.
+    uint64_t preallocate_extent = 0;
+    // Bypass the page cache (O_DIRECT, F_NOCACHE on macOS). Silently off where the platform or file system has no
+    // direct I/O; BufferedFileBackend::direct_io() tells which.
+    bool direct_io = false;
+};
+
+/**
+ * @class BufferedFileBackend
+ * @brief A write-combining file backend for writers.
+ *
+ * Appends are staged in `block_size` blocks placed at block-aligned file offsets; once `max_buffered_blocks` are
+ * full, every full block goes out in a single pwritev. Writes behind the staged tail (the writer's index patches)
+ * are held in memory, merged with adjacent ones, and issued after the data they point to. Seeking never touches
+ * the file, and nothing is written before the buffer fills or flush() is called: flush() is the durability point.
+ *
+ * Reads are served from the file after writing out anything pending, so they are meant for the few reads a
+ * writer makes (e.g. the header when appending), not for scanning. A read-only backend reads through a window of
+ * `block_size` bytes instead, so the small reads of a chunk header share one call; a read at least a window long
+ * goes straight to the file.
+ *
+ * With `preallocate_extent`, space is reserved past the end of the file without changing its size: readers never
+ * see the reservation, and a crash leaves only blocks past the end, which the next close or truncate releases.
+ *
+ * With `direct_io`, the file's data never enters the page cache, so bulk writes and scans leave it to the readers
+ * that need it. Every transfer then covers whole IO_ALIGNMENT sectors: a flush ending mid-sector writes it padded
+ * with zeros, which stay past the logical end until the backend is closed (so other readers of the file may see
+ * up to one sector of trailing zeros, and the reservation past them is kept), patches are read, modified and
+ * written back by sector, and every read goes through the aligned window, which suits sequential scans of a
+ * read-only backend rather than scattered small reads.
+ */
+class BufferedFileBackend final : public IStorageBackend {
+public:
+    static constexpr size_t IO_ALIGNMENT = 4096;
+
+    /** @brief Counters of the system calls issued, for monitoring and tests. */
+    struct IoStats {
+        uint64_t write_calls = 0;   // pwrite/pwritev calls
+        uint64_t bytes_written = 0;
+        uint64_t read_calls = 0;    // pread calls
+        uint64_t bytes_read = 0;
+        uint64_t flushes = 0;       // explicit flush() calls that had something to write
+        uint64_t preallocated_bytes = 0;
+    };
+
+    explicit BufferedFileBackend(std::filesystem::path filepath,
+                                 std::ios_base::openmode mode = std::ios_base::in | std::ios_base::out | std::ios_base::binary,
+                                 WriteBufferOptions options = {});
+
+    ~BufferedFileBackend() override;
+
+    BufferedFileBackend(const BufferedFileBackend&) = delete;
+    BufferedFileBackend& operator=(const BufferedFileBackend&) = delete;
+
+    std::expected<size_t, std::string> read(std::span<std::byte> buffer) override;
+    std::expected<size_t, std::string> write(std::span<const std::byte> data) override;
+    std::expected<void, std::string> seek(uint64_t offset) override;
+    std::expected<uint64_t, std::string> tell() override;
+    std::expected<void, std::string> flush() override;
+    std::expected<void, std::string> rewind() override;
+    [[nodiscard]] std::expected<uint64_t, std::string> size() override;
+    [[nodiscard]] std::optional<std::filesystem::path> file_path() const override { return filepath_; }
+    // posix_fadvise on the descriptor the reads go through; nothing with direct I/O, which skips the page cache.
+    std::expected<bool, std::string> advise(AccessHint hint, uint64_t offset = 0, uint64_t length = 0) override;
+
+    [[nodiscard]] const IoStats& io_stats() const { return stats_; }
+
+    /** @brief Whether the file was opened for direct I/O. */
+    [[nodiscard]] bool direct_io() const { return direct_; }
+
+private:
+    struct AlignedDelete {
+        void operator()(std::byte* p) const { ::operator delete[](p, std::align_val_t{IO_ALIGNMENT}); }
+    };
+    using Block = std::unique_ptr<std::byte[], AlignedDelete>;
+
+    [[nodiscard]] uint64_t tail_end() const { return tail_start_ + tail_size_; }
+    static Block allocate_block(size_t size);
+    Block take_block();
+    // Reads up to `length` bytes at `offset`, less only at the end of the file.
+    std::expected<size_t, std::string> read_at(std::byte* buffer, size_t length, uint64_t offset);
+    // Direct I/O and read-only reads, served from `window_`.
+    std::expected<size_t, std::string> read_window(std::span<std::byte> buffer);
+    std::expected<void, std::string> write_patch(uint64_t offset, std::span<std::byte> data);
+    // Reserves whole extents up to at least `end` when it passes what is already reserved.
+    std::expected<void, std::string> reserve(uint64_t end);
+    void add_patch(uint64_t offset, std::span<const std::byte> data);
+    // Writes the full blocks, or every staged byte when `all`, then the patches, and recycles the written blocks.
+    std::expected<void, std::string> write_out(bool all);
+
+    int fd_ = -1;
+    std::filesystem::path filepath_;
+    WriteBufferOptions options_;
+    bool writable_ = false;
+    bool direct_ = false;
+
+    uint64_t pos_ = 0;
+    uint64_t size_ = 0;      // logical size, including what is still staged
+    uint64_t disk_size_ = 0; // size of the file as the OS knows it
+    uint64_t allocated_end_ = 0; // end of the space reserved with preallocate_extent
+
+    // Staged bytes cover [tail_start_, tail_start_ + tail_size_); tail_start_ is block-aligned.
+    uint64_t tail_start_ = 0;
+    size_t tail_size_ = 0;
+    bool tail_dirty_ = false;
+    std::vector<Block> blocks_;
+    std::vector<Block> spare_blocks_;
+
+    // Pending writes before tail_start_, keyed by offset; never overlapping nor adjacent.
+    std::map<uint64_t, memory::vector<std::byte>> patches_;
+
+    // What the file holds at [window_start_, window_start_ + window_size_), with direct I/O or read-only.
+    Block window_;
+    uint64_t window_start_ = 0;
+    size_t window_size_ = 0;
+
+    IoStats stats_;
+};
+
+} // namespace cryptodd::storage
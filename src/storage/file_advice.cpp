@@ -0,0 +1,67 @@
+#include "file_advice.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <system_error>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace cryptodd::storage {
+
+#if defined(_WIN32)
+
+// The CRT has no equivalent; Windows adapts its readahead to the reads it sees.
+std::expected<bool, std::string> advise_file(int, AccessHint, uint64_t, uint64_t) { return false; }
+int open_for_advice(const std::filesystem::path&) { errno = ENOSYS; return -1; }
+void close_for_advice(int) {}
+
+#else
+
+std::expected<bool, std::string> advise_file(const int fd, const AccessHint hint, const uint64_t offset, const uint64_t length) {
+#if defined(POSIX_FADV_NORMAL)
+    int advice = POSIX_FADV_NORMAL;
+    switch (hint) {
+        case AccessHint::NORMAL: advice = POSIX_FADV_NORMAL; break;
+        case AccessHint::SEQUENTIAL: advice = POSIX_FADV_SEQUENTIAL; break;
+        case AccessHint::RANDOM: advice = POSIX_FADV_RANDOM; break;
+        case AccessHint::WILLNEED: advice = POSIX_FADV_WILLNEED; break;
+    }
+    // posix_fadvise returns the error instead of setting errno.
+    if (const int error = ::posix_fadvise(fd, static_cast<off_t>(offset), static_cast<off_t>(length), advice); error != 0) {
+        return std::unexpected("posix_fadvise failed: " + std::generic_category().message(error));
+    }
+    return true;
+#elif defined(F_RDADVISE)
+    // macOS has no posix_fadvise; F_RDADVISE starts reading a range, the only hint it can take.
+    if (hint == AccessHint::WILLNEED) {
+        radvisory advisory{};
+        advisory.ra_offset = static_cast<off_t>(offset);
+        advisory.ra_count = static_cast<int>(std::min<uint64_t>(length == 0 ? INT32_MAX : length, INT32_MAX));
+        if (::fcntl(fd, F_RDADVISE, &advisory) != 0) {
+            return std::unexpected("fcntl(F_RDADVISE) failed: " + std::generic_category().message(errno));
+        }
+        return true;
+    }
+#else
+    (void)fd;
+    (void)hint;
+    (void)offset;
+    (void)length;
+#endif
+    return false;
+}
+
+int open_for_advice(const std::filesystem::path& path) {
+    return ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+}
+
+void close_for_advice(const int fd) {
+    if (fd >= 0) ::close(fd);
+}
+
+#endif
+
+} // namespace cryptodd::storage
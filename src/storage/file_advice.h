@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <string>
+
+#include "i_storage_backend.h"
+
+namespace cryptodd::storage {
+
+/**
+ * @brief posix_fadvise for the file open as `fd`; a length of 0 extends to the end. A no-op where unsupported.
+ * @return Whether the hint was passed on to the OS, on success.
+ *
+ * WILLNEED starts reading into the page cache, which is the file's, so any descriptor of it will do. SEQUENTIAL,
+ * RANDOM and NORMAL set the readahead of `fd` itself (on Linux, for the whole file): they only affect reads made
+ * through that descriptor.
+ */
+std::expected<bool, std::string> advise_file(int fd, AccessHint hint, uint64_t offset, uint64_t length);
+
+/** @brief Opens `path` read-only, only to pass hints for it with advise_file(); -1 with errno set on failure. */
+int open_for_advice(const std::filesystem::path& path);
+
+void close_for_advice(int fd);
+
+} // namespace cryptodd::storage
@@ -0,0 +1,61 @@
+#include "file_allocation.h"
+
+#include <cerrno>
+#include <system_error>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace cryptodd::storage {
+
+#if defined(_WIN32)
+
+// Windows grows files with SetEndOfFile, which is not what is wanted here: nothing is reserved.
+std::expected<bool, std::string> preallocate(int, uint64_t, uint64_t, bool) { return false; }
+std::expected<void, std::string> release_preallocated(int, uint64_t, uint64_t) { return {}; }
+
+#else
+
+namespace {
+    std::string errno_message(const std::string& what) {
+        return what + ": " + std::generic_category().message(errno);
+    }
+
+#if defined(__linux__)
+    bool unsupported(const int error) {
+        return error == EOPNOTSUPP || error == ENOSYS;
+    }
+#endif
+}
+
+std::expected<bool, std::string> preallocate(const int fd, const uint64_t offset, const uint64_t length, const bool keep_size) {
+    if (length == 0) return false;
+#if defined(__linux__)
+    while (::fallocate(fd, keep_size ? FALLOC_FL_KEEP_SIZE : 0, static_cast<off_t>(offset), static_cast<off_t>(length)) != 0) {
+        if (errno == EINTR) continue;
+        if (unsupported(errno)) return false;
+        return std::unexpected(errno_message("fallocate failed"));
+    }
+    return true;
+#else
+    (void)fd;
+    (void)offset;
+    (void)keep_size;
+    return false;
+#endif
+}
+
+std::expected<void, std::string> release_preallocated(const int fd, const uint64_t size, const uint64_t allocated_end) {
+    if (allocated_end <= size) return {};
+    // Punching a hole past the end is a no-op on ext4; truncating to the current size drops the blocks past it.
+    if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        return std::unexpected(errno_message("Failed to trim preallocated blocks"));
+    }
+    return {};
+}
+
+#endif
+
+} // namespace cryptodd::storage
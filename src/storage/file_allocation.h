@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+#include <expected>
+#include <string>
+
+namespace cryptodd::storage {
+
+/**
+ * @brief Reserves disk blocks for [offset, offset + length) of the file open as `fd`, so it grows in large extents
+ * instead of one write at a time. With `keep_size` the file size does not change and the reservation past the end
+ * stays invisible to readers; without it, the file grows and the range reads as zeros.
+ *
+ * @return Whether blocks were reserved: false, without error, where the platform or file system cannot preallocate.
+ */
+std::expected<bool, std::string> preallocate(int fd, uint64_t offset, uint64_t length, bool keep_size);
+
+/** @brief Gives back the blocks reserved past `size` (see preallocate with `keep_size`), up to `allocated_end`. */
+std::expected<void, std::string> release_preallocated(int fd, uint64_t size, uint64_t allocated_end);
+
+} // namespace cryptodd::storage
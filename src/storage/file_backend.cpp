@@ -1,5 +1,9 @@
 #include "file_backend.h"
+#include "file_advice.h"
+
+#include <cerrno>
 #include <limits>
+#include <system_error>
 
 namespace cryptodd::storage {
 
@@ -30,6 +34,7 @@ FileBackend::~FileBackend() {
     if (file_.is_open()) {
         file_.close();
     }
+    close_for_advice(advice_fd_);
 }
 
 std::expected<size_t, std::string> FileBackend::read(std::span<std::byte> buffer) {
@@ -158,4 +163,30 @@ std::expected<uint64_t, std::string> FileBackend::size() {
     return file_size;
 }
 
+std::expected<bool, std::string> FileBackend::advise(const AccessHint hint, const uint64_t offset, const uint64_t length) {
+#if defined(_WIN32)
+    (void)hint;
+    (void)offset;
+    (void)length;
+    return false;
+#else
+    // WILLNEED fills the file's page cache, which the stream reads from, whichever descriptor it is given.
+    if (hint != AccessHint::WILLNEED) {
+        return false;
+    }
+    if (advice_fd_ < 0) {
+        advice_fd_ = open_for_advice(filepath_);
+        if (advice_fd_ < 0) {
+            return std::unexpected("FileBackend: failed to open '" + filepath_.string() + "' for advice: " +
+                                   std::generic_category().message(errno));
+        }
+    }
+    auto res = advise_file(advice_fd_, hint, offset, length);
+    if (!res) {
+        return std::unexpected("FileBackend: " + res.error());
+    }
+    return res;
+#endif
+}
+
 }
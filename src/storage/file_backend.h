@@ -16,6 +16,7 @@ private:
     std::fstream file_;
     std::filesystem::path filepath_;
     std::atomic_bool write_pending_ = false;
+    int advice_fd_ = -1; // opened by the first advise()
 
 public:
     explicit FileBackend(std::filesystem::path filepath,
@@ -30,6 +31,9 @@ public:
     std::expected<void, std::string> flush() override;
     std::expected<void, std::string> rewind() override;
     [[nodiscard]] std::expected<uint64_t, std::string> size() override;
+    [[nodiscard]] std::optional<std::filesystem::path> file_path() const override { return filepath_; }
+    // Only WILLNEED: the stream's descriptor is out of reach, and readahead hints only apply to the one they are given.
+    std::expected<bool, std::string> advise(AccessHint hint, uint64_t offset = 0, uint64_t length = 0) override;
 };
 
 } // namespace cryptodd::storage
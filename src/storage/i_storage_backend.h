@@ -2,12 +2,22 @@
 
 #include <cstdint>
 #include <expected>
+#include <filesystem>
+#include <optional>
 #include <span>
 #include <string>
 #include <vector>
 
 namespace cryptodd::storage {
 
+/** @brief How a range of storage is about to be read, for the OS to adapt its readahead and caching. */
+enum class AccessHint : uint8_t {
+    NORMAL = 0,     // the default readahead
+    SEQUENTIAL = 1, // read in order: read ahead aggressively
+    RANDOM = 2,     // scattered reads: do not read ahead
+    WILLNEED = 3,   // start reading the range in the background now
+};
+
 // Interface for storage backends
 class IStorageBackend {
 public:
@@ -33,6 +43,16 @@ public:
 
     /** @return The total size of the storage on success. */
     [[nodiscard]] virtual std::expected<uint64_t, std::string> size() = 0;
+
+    /** @return The path of the file backing the storage, or nullopt when it is not a file (e.g. memory). */
+    [[nodiscard]] virtual std::optional<std::filesystem::path> file_path() const { return std::nullopt; }
+
+    /**
+     * @brief Advises how [offset, offset + length) will be read; a length of 0 extends to the end. Only a hint:
+     * backends that cannot act on it succeed without doing anything.
+     * @return Whether the hint was passed on to the OS, on success.
+     */
+    virtual std::expected<bool, std::string> advise(AccessHint /*hint*/, uint64_t /*offset*/ = 0, uint64_t /*length*/ = 0) { return false; }
 };
 
 } // namespace cryptodd::storage
\ No newline at end of file
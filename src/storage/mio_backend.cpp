@@ -1,4 +1,5 @@
 #include "mio_backend.h"
+#include "file_allocation.h"
 
 #include <algorithm>
 #include <expected>
@@ -10,6 +11,13 @@
 
 #include <mio/mmap.hpp>
 
+#if !defined(_WIN32)
+#include <cerrno>
+#include <span>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 namespace cryptodd::storage {
 
 struct MioBackend::Impl {
@@ -18,10 +26,75 @@ struct MioBackend::Impl {
 
     // Use a variant to hold either a read-only or a read-write mapping.
     std::variant<std::monostate, mmap_source, mmap_sink> mapping;
+
+    // The mapped bytes, empty when nothing is mapped. Writable only through a sink.
+    [[nodiscard]] std::span<std::byte> bytes() {
+        return std::visit(
+            []<typename T0>(T0& map) -> std::span<std::byte> {
+                using T = std::decay_t<T0>;
+                if constexpr (std::is_same_v<T, std::monostate>) {
+                    return {};
+                } else {
+                    if (!map.is_open()) {
+                        return {};
+                    }
+                    return {const_cast<std::byte*>(map.data()), map.size()};
+                }
+            },
+            mapping);
+    }
 };
 
-MioBackend::MioBackend(std::filesystem::path filepath, std::ios_base::openmode mode)
-    : pimpl_(std::make_unique<Impl>()), filepath_(std::move(filepath)) {
+#if !defined(_WIN32)
+namespace {
+    uint64_t page_size() {
+        static const auto size = static_cast<uint64_t>(::sysconf(_SC_PAGESIZE));
+        return size;
+    }
+
+    // The pages of `mapping` covering [offset, offset + length), a length of 0 extending to the end; empty past it.
+    std::span<std::byte> page_span(const std::span<std::byte> mapping, const uint64_t offset, const uint64_t length) {
+        if (offset >= mapping.size()) {
+            return {};
+        }
+        const uint64_t start = offset / page_size() * page_size();
+        const uint64_t end = length == 0 || length > mapping.size() - offset ? mapping.size() : offset + length;
+        return mapping.subspan(static_cast<size_t>(start), static_cast<size_t>(end - start));
+    }
+
+    std::expected<void, std::string> lock_pages(const std::span<std::byte> pages) {
+        if (!pages.empty() && ::mlock(pages.data(), pages.size()) != 0) {
+            return std::unexpected("MioBackend: Failed to lock " + std::to_string(pages.size()) + " bytes: " +
+                                   std::generic_category().message(errno));
+        }
+        return {};
+    }
+
+    std::expected<void, std::string> populate(const std::span<std::byte> mapping) {
+#if defined(MADV_POPULATE_READ)
+        // Read faults even for a writable mapping, as MAP_POPULATE does for shared ones: write faults would dirty
+        // every page and have the next sync write the whole file back.
+        if (::madvise(mapping.data(), mapping.size(), MADV_POPULATE_READ) == 0) {
+            return {};
+        }
+        if (errno != EINVAL) {
+            return std::unexpected("MioBackend: Failed to populate the mapping: " + std::generic_category().message(errno));
+        }
+        // EINVAL: a kernel older than 5.14, fault the pages in one by one.
+#endif
+        (void)::madvise(mapping.data(), mapping.size(), MADV_WILLNEED);
+        volatile std::byte sink{};
+        for (size_t offset = 0; offset < mapping.size(); offset += page_size()) {
+            sink = mapping[offset];
+        }
+        (void)sink;
+        return {};
+    }
+}
+#endif
+
+MioBackend::MioBackend(std::filesystem::path filepath, std::ios_base::openmode mode, MapOptions options)
+    : pimpl_(std::make_unique<Impl>()), filepath_(std::move(filepath)), options_(options) {
     writable_ = (mode & std::ios_base::out) != 0;
 
     std::error_code ec;
@@ -63,6 +136,9 @@ MioBackend::MioBackend(std::filesystem::path filepath, std::ios_base::openmode m
             }
             pimpl_->mapping = std::move(source);
         }
+        if (auto setup = setup_mapping(); !setup) {
+            throw std::runtime_error(setup.error());
+        }
     }
 }
 
@@ -70,8 +146,14 @@ MioBackend::~MioBackend() {
     // Ensure data is flushed for writable mappings on destruction.
     // Errors are ignored in the destructor as per RAII best practices.
     if (writable_ && pimpl_ && std::holds_alternative<Impl::mmap_sink>(pimpl_->mapping)) {
+        auto& sink = std::get<Impl::mmap_sink>(pimpl_->mapping);
         std::error_code ec;
-        std::get<Impl::mmap_sink>(pimpl_->mapping).sync(ec);
+        sink.sync(ec);
+        // The file grows ahead of the data (see remap); trim it back so readers never see the unwritten tail.
+        if (!ec && sink.size() > logical_size_) {
+            sink.unmap();
+            std::filesystem::resize_file(filepath_, logical_size_, ec);
+        }
     }
 }
 
@@ -105,8 +187,48 @@ std::expected<void, std::string> MioBackend::remap(uint64_t required_size) {
     if (ec) {
         return std::unexpected("MioBackend: Failed to remap file after resize: " + ec.message());
     }
+#if !defined(_WIN32)
+    // resize_file leaves a sparse hole, filled one page fault at a time and, on a full disk, failing with SIGBUS
+    // when written through the mapping. Allocating the whole increment up front gives large extents and a clean error.
+    if (auto allocated = preallocate(new_sink.file_handle(), current_size, new_size - current_size, false); !allocated) {
+        return std::unexpected("MioBackend: Failed to allocate " + std::to_string(new_size - current_size) + " bytes: " + allocated.error());
+    }
+#endif
     pimpl_->mapping = std::move(new_sink);
+    // The pages mapped before were populated then and are still in the page cache.
+    return setup_mapping(current_size);
+}
+
+std::expected<void, std::string> MioBackend::setup_mapping(const uint64_t populate_from) {
+#if defined(_WIN32)
+    (void)populate_from;
+    return {};
+#else
+    const auto mapping = pimpl_->bytes();
+    if (mapping.empty()) {
+        return {};
+    }
+#if defined(MADV_HUGEPAGE)
+    // EINVAL: a kernel without transparent huge pages.
+    if (options_.huge_pages && ::madvise(mapping.data(), mapping.size(), MADV_HUGEPAGE) != 0 && errno != EINVAL) {
+        return std::unexpected("MioBackend: Failed to request huge pages: " + std::generic_category().message(errno));
+    }
+#endif
+    if (access_ != AccessHint::NORMAL) {
+        if (auto advised = advise(access_); !advised) {
+            return std::unexpected(advised.error());
+        }
+    }
+    for (const auto& [offset, length] : locked_ranges_) {
+        if (auto locked = lock_pages(page_span(mapping, offset, length)); !locked) {
+            return locked;
+        }
+    }
+    if (const auto fresh = page_span(mapping, populate_from, 0); options_.populate && !fresh.empty()) {
+        return populate(fresh);
+    }
     return {};
+#endif
 }
 
 std::expected<size_t, std::string> MioBackend::read(std::span<std::byte> buffer) {
@@ -187,6 +309,9 @@ std::expected<void, std::string> MioBackend::seek(uint64_t offset) {
                     return std::unexpected("MioBackend: Failed to remap after seek resize: " + ec.message());
                 }
                 pimpl_->mapping = std::move(new_sink);
+                if (auto setup = setup_mapping(current_mapped_size); !setup) {
+                    return setup;
+                }
             }
             // Update the logical size to the seek position.
             logical_size_ = offset;
@@ -228,4 +353,46 @@ std::expected<uint64_t, std::string> MioBackend::size() {
     return logical_size_;
 }
 
+std::expected<bool, std::string> MioBackend::advise(const AccessHint hint, const uint64_t offset, const uint64_t length) {
+#if defined(_WIN32)
+    (void)hint;
+    (void)offset;
+    (void)length;
+    return false;
+#else
+    if (offset == 0 && length == 0 && hint != AccessHint::WILLNEED) {
+        access_ = hint;
+    }
+    const auto pages = page_span(pimpl_->bytes(), offset, length);
+    if (pages.empty()) {
+        return false;
+    }
+    int advice = MADV_NORMAL;
+    switch (hint) {
+        case AccessHint::NORMAL: advice = MADV_NORMAL; break;
+        case AccessHint::SEQUENTIAL: advice = MADV_SEQUENTIAL; break;
+        case AccessHint::RANDOM: advice = MADV_RANDOM; break;
+        case AccessHint::WILLNEED: advice = MADV_WILLNEED; break;
+    }
+    if (::madvise(pages.data(), pages.size(), advice) != 0) {
+        return std::unexpected("MioBackend: madvise failed: " + std::generic_category().message(errno));
+    }
+    return true;
+#endif
+}
+
+std::expected<void, std::string> MioBackend::lock(const uint64_t offset, const uint64_t length) {
+#if defined(_WIN32)
+    (void)offset;
+    (void)length;
+    return {};
+#else
+    if (auto locked = lock_pages(page_span(pimpl_->bytes(), offset, length)); !locked) {
+        return locked;
+    }
+    locked_ranges_.emplace_back(offset, length);
+    return {};
+#endif
+}
+
 }
@@ -4,9 +4,21 @@
 
 #include <filesystem>
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace cryptodd::storage {
 
+/** @brief How MioBackend sets up each mapping of the file. Ignored on Windows. */
+struct MapOptions {
+    // Fault the whole mapping in when it is made, as MAP_POPULATE would, instead of one page fault per page on first
+    // access: scans run from memory, at the cost of reading the whole file up front.
+    bool populate = false;
+    // MADV_HUGEPAGE: back the mapping with transparent huge pages where the kernel and file system allow it, which
+    // cuts TLB misses when scanning multi-GB files. Silently ignored where they do not.
+    bool huge_pages = false;
+};
+
 class MioBackend final : public IStorageBackend {
 private:
     struct Impl; // Forward-declaration for PIMPL
@@ -15,12 +27,19 @@ private:
     uint64_t current_pos_ = 0;
     uint64_t logical_size_ = 0; // Tracks the logical size, independent of physical allocation.
     bool writable_ = false;
+    MapOptions options_;
+    AccessHint access_ = AccessHint::NORMAL; // last hint for the whole file, kept across remaps
+    std::vector<std::pair<uint64_t, uint64_t>> locked_ranges_; // offset, length; kept across remaps
     
     std::expected<void, std::string> remap(uint64_t required_size); // Kept private
+    // Applies the options, the access hint and the locks to a new mapping; only what lies from `populate_from` on,
+    // which a previous mapping did not cover, is populated.
+    std::expected<void, std::string> setup_mapping(uint64_t populate_from = 0);
 
 public:
     explicit MioBackend(std::filesystem::path filepath,
-                        std::ios_base::openmode mode = std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+                        std::ios_base::openmode mode = std::ios_base::in | std::ios_base::out | std::ios_base::binary,
+                        MapOptions options = {});
 
     ~MioBackend() override;
 
@@ -37,6 +56,16 @@ public:
     std::expected<void, std::string> flush() override;
     std::expected<void, std::string> rewind() override;
     [[nodiscard]] std::expected<uint64_t, std::string> size() override;
+    [[nodiscard]] std::optional<std::filesystem::path> file_path() const override { return filepath_; }
+    // madvise on the mapped range; nothing before the first mapping, nor on Windows. A hint for the whole file other
+    // than WILLNEED also applies to the mappings made as the file grows.
+    std::expected<bool, std::string> advise(AccessHint hint, uint64_t offset = 0, uint64_t length = 0) override;
+
+    /**
+     * @brief mlock()s [offset, offset + length) of the mapping (0: to the end) so it is never paged out, e.g. the
+     * chunk index of a file scanned while it is looked up. Bounded by RLIMIT_MEMLOCK; a no-op on Windows.
+     */
+    std::expected<void, std::string> lock(uint64_t offset, uint64_t length);
 };
 
 } // namespace cryptodd::storage
@@ -221,11 +221,13 @@ protected:
 
                 cryptodd::memory::vector<T> expected_data = std::cref(full_data);
 
-                if (is_f16_codec) {
-                    auto f16_codec = cryptodd::FloatConversionSimdCodec();
-                    auto f16_floats = f16_codec.convert_f32_to_f16(std::span<const float>(expected_data));
-                    auto f32_floats = f16_codec.convert_f16_to_f32(f16_floats);
-                    expected_data.assign(f32_floats.begin(), f32_floats.end());
+                if constexpr (std::is_same_v<T, float>) {
+                    if (is_f16_codec) {
+                        auto f16_codec = cryptodd::FloatConversionSimdCodec();
+                        auto f16_floats = f16_codec.convert_f32_to_f16(std::span<const float>(expected_data));
+                        auto f32_floats = f16_codec.convert_f16_to_f32(f16_floats);
+                        expected_data.assign(f32_floats.begin(), f32_floats.end());
+                    }
                 }
 
                 for (size_t i = 0; i < full_data.size(); ++i) {
@@ -249,6 +251,8 @@ TEST_P(CApiTemporal1dSimdTest, FullWorkflow) {
     const auto& config = GetParam();
     if (config.dtype == "FLOAT32") {
         run_workflow<float>();
+    } else if (config.dtype == "FLOAT64") {
+        run_workflow<double>();
     } else if (config.dtype == "INT64") {
         run_workflow<int64_t>();
     } else {
@@ -263,9 +267,12 @@ INSTANTIATE_TEST_SUITE_P(
     ::testing::Values(
         TestConfig1D{"F32_XorShuffle", "TEMPORAL_1D_SIMD_F32_XOR_SHUFFLE", "FLOAT32", {5000}, false},
         TestConfig1D{"F16_XorShuffle", "TEMPORAL_1D_SIMD_F16_XOR_SHUFFLE_AS_F32", "FLOAT32", {5000}, false},
+        TestConfig1D{"F64_XorShuffle", "TEMPORAL_1D_SIMD_F64_XOR_SHUFFLE", "FLOAT64", {5000}, false},
         TestConfig1D{"I64_Xor", "TEMPORAL_1D_SIMD_I64_XOR", "INT64", {4000}, false},
         TestConfig1D{"I64_Delta", "TEMPORAL_1D_SIMD_I64_DELTA", "INT64", {4000}, false},
+        TestConfig1D{"I64_DoubleDelta", "TEMPORAL_1D_SIMD_I64_DOUBLE_DELTA", "INT64", {4000}, false},
         TestConfig1D{"Append_F32_XorShuffle", "TEMPORAL_1D_SIMD_F32_XOR_SHUFFLE", "FLOAT32", {8000}, true},
+        TestConfig1D{"Append_F64_XorShuffle", "TEMPORAL_1D_SIMD_F64_XOR_SHUFFLE", "FLOAT64", {8000}, true},
         TestConfig1D{"Append_I64_Delta", "TEMPORAL_1D_SIMD_I64_DELTA", "INT64", {6000}, true}
     ),
     [](const ::testing::TestParamInfo<CApiTemporal1dSimdTest::ParamType>& info) {
@@ -235,11 +235,13 @@ protected:
 
                 cryptodd::memory::vector<T> expected_data = std::cref(full_data);
 
-                if (is_f16_codec) {
-                    auto f16_codec = cryptodd::FloatConversionSimdCodec();
-                    auto f16_floats = f16_codec.convert_f32_to_f16(std::span<const float>(expected_data));
-                    auto f32_floats = f16_codec.convert_f16_to_f32(f16_floats);
-                    expected_data.assign(f32_floats.begin(), f32_floats.end());
+                if constexpr (std::is_same_v<T, float>) {
+                    if (is_f16_codec) {
+                        auto f16_codec = cryptodd::FloatConversionSimdCodec();
+                        auto f16_floats = f16_codec.convert_f32_to_f16(std::span<const float>(expected_data));
+                        auto f32_floats = f16_codec.convert_f16_to_f32(f16_floats);
+                        expected_data.assign(f32_floats.begin(), f32_floats.end());
+                    }
                 }
 
                 for (size_t i = 0; i < full_data.size(); ++i) {
@@ -264,6 +266,8 @@ TEST_P(CApiTemporal2dSimdTest, FullWorkflow) {
     const auto& config = GetParam();
     if (config.dtype == "FLOAT32") {
         run_workflow<float>();
+    } else if (config.dtype == "FLOAT64") {
+        run_workflow<double>();
     } else if (config.dtype == "INT64") {
         run_workflow<int64_t>();
     } else {
@@ -278,9 +282,16 @@ INSTANTIATE_TEST_SUITE_P(
     ::testing::Values(
         TestConfig2D{"F32", "TEMPORAL_2D_SIMD_F32", "FLOAT32", {1000, 10}, false},
         TestConfig2D{"F16", "TEMPORAL_2D_SIMD_F16_AS_F32", "FLOAT32", {1000, 10}, false},
+        TestConfig2D{"F64", "TEMPORAL_2D_SIMD_F64", "FLOAT64", {1000, 10}, false},
         TestConfig2D{"I64", "TEMPORAL_2D_SIMD_I64", "INT64", {800, 12}, false},
+        TestConfig2D{"I64_DoubleDelta", "TEMPORAL_2D_SIMD_I64_DOUBLE_DELTA", "INT64", {800, 12}, false},
+        TestConfig2D{"I64_Delta", "TEMPORAL_2D_SIMD_I64_DELTA", "INT64", {800, 12}, false},
+        TestConfig2D{"I64_DeltaShuffle", "TEMPORAL_2D_SIMD_I64_DELTA_SHUFFLE", "INT64", {800, 12}, false},
         TestConfig2D{"Append_F32", "TEMPORAL_2D_SIMD_F32", "FLOAT32", {2000, 8}, true},
-        TestConfig2D{"Append_I64", "TEMPORAL_2D_SIMD_I64", "INT64", {1500, 15}, true}
+        TestConfig2D{"Append_F64", "TEMPORAL_2D_SIMD_F64", "FLOAT64", {2000, 8}, true},
+        TestConfig2D{"Append_I64", "TEMPORAL_2D_SIMD_I64", "INT64", {1500, 15}, true},
+        TestConfig2D{"Append_I64_DoubleDelta", "TEMPORAL_2D_SIMD_I64_DOUBLE_DELTA", "INT64", {1500, 15}, true},
+        TestConfig2D{"Append_I64_DeltaShuffle", "TEMPORAL_2D_SIMD_I64_DELTA_SHUFFLE", "INT64", {1500, 15}, true}
     ),
     [](const ::testing::TestParamInfo<CApiTemporal2dSimdTest::ParamType>& info) {
         return info.param.test_name;
@@ -1,5 +1,7 @@
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
+#include <iterator>
 #include <gtest/gtest.h>
 #include <nlohmann/json.hpp>
 #include <numeric>
@@ -9,6 +11,8 @@
 #include "base64.h" // For verifying metadata
 #include "cryptodd/c_api.h"
 #include "data_reader.h"
+#include "group_commit.h"
+#include "chunk_hash.h"
 
 namespace fs = std::filesystem;
 using json = nlohmann::json;
@@ -419,6 +423,134 @@ TEST_F(CApiTest, ZstdCompressionLevels) {
     ASSERT_TRUE(std::string_view(error_response["error"]["message"].get<std::string>()).find("Invalid zstd compression level") != std::string::npos);
 }
 
+TEST_F(CApiTest, AdaptiveZstdLevel) {
+    json config = {{"backend", {{"type", "Memory"}, {"mode", "WriteTruncate"}}},
+                   {"writer_options", {{"adaptive_zstd", {{"min_level", -2}, {"max_level", 3}, {"target_mbps", 1e9}}}}}};
+    cdd_handle_t handle = create_context(config);
+    ASSERT_GT(handle, 0);
+
+    auto data = generate_random_data(4096);
+    json store_req = {
+        {"op_type", "StoreChunk"},
+        {"data_spec", {{"dtype", "UINT8"}, {"shape", {4096}}}},
+        {"encoding", {{"codec", "ZSTD_COMPRESSED"}, {"zstd_adaptive", true}}}
+    };
+    // The unreachable target walks the level down from 1, skipping 0, and stops at min_level.
+    std::vector<int> levels;
+    for (int i = 0; i < 8; ++i) {
+        auto res = execute_op(handle, store_req, data);
+        ASSERT_FALSE(res.is_null());
+        ASSERT_EQ(res["details"]["zstd_level"], res["zstd_level"]);
+        levels.push_back(res["zstd_level"].get<int>());
+    }
+    ASSERT_EQ(levels.front(), 1);
+    ASSERT_EQ(levels.back(), -2);
+    ASSERT_TRUE(std::ranges::find(levels, 0) == levels.end());
+
+    store_req["encoding"]["zstd_level"] = 3;
+    const std::string bad_req = store_req.dump();
+    int64_t result_code = cdd_execute_op(handle, bad_req.c_str(), bad_req.length(), data.data(), data.size(), nullptr, 0, response_buffer_.data(), response_buffer_.size());
+    ASSERT_EQ(result_code, CDD_ERROR_OPERATION_FAILED);
+
+    // Chimp has no zstd stage, so no level to adapt.
+    const std::vector<float> floats(1024, 1.5f);
+    const auto float_bytes = std::as_bytes(std::span(floats));
+    const json chimp_req = {
+        {"op_type", "StoreChunk"},
+        {"data_spec", {{"dtype", "FLOAT32"}, {"shape", {1024}}}},
+        {"encoding", {{"codec", "TEMPORAL_1D_CHIMP_F32"}, {"zstd_adaptive", true}}}
+    };
+    const std::string chimp_str = chimp_req.dump();
+    result_code = cdd_execute_op(handle, chimp_str.c_str(), chimp_str.length(), float_bytes.data(), float_bytes.size(), nullptr, 0, response_buffer_.data(), response_buffer_.size());
+    ASSERT_EQ(result_code, CDD_ERROR_OPERATION_FAILED);
+    const json chimp_error = json::parse(response_buffer_.data());
+    ASSERT_NE(chimp_error["error"]["message"].get<std::string>().find("no zstd stage"), std::string::npos);
+
+    json bad_config = {{"backend", {{"type", "Memory"}, {"mode", "WriteTruncate"}}},
+                       {"writer_options", {{"adaptive_zstd", {{"min_level", 5}, {"max_level", 1}}}}}};
+    ASSERT_LT(create_context(bad_config), 0);
+}
+
+TEST_F(CApiTest, AdviseRanksCodecs) {
+    json mem_config = {{"backend", {{"type", "Memory"}, {"mode", "WriteTruncate"}}}};
+    cdd_handle_t handle = create_context(mem_config);
+    ASSERT_GT(handle, 0);
+
+    // Millisecond timestamps with a little jitter: delta coding beats plain zstd.
+    std::vector<int64_t> timestamps(2048);
+    for (size_t i = 0; i < timestamps.size(); ++i) timestamps[i] = 1700000000000 + static_cast<int64_t>(i) * 100 + static_cast<int64_t>(i % 3);
+    const auto bytes = std::as_bytes(std::span(timestamps));
+    json advise_req = {
+        {"op_type", "Advise"},
+        {"client_key", "advise-1"},
+        {"data_spec", {{"dtype", "INT64"}, {"shape", {2048}}}}
+    };
+    auto result = execute_op(handle, advise_req, bytes);
+    ASSERT_FALSE(result.is_null());
+    ASSERT_EQ(result["client_key"], "advise-1");
+    ASSERT_EQ(result["recommendations"].size(), 4);
+    ASSERT_NE(result["recommendations"][0]["codec"], "ZSTD_COMPRESSED");
+    ASSERT_FALSE(result["recommendations"][0]["measured"].get<bool>());
+
+    advise_req["trial_compress"] = true;
+    advise_req["trial_rows"] = 1024;
+    result = execute_op(handle, advise_req, bytes);
+    ASSERT_FALSE(result.is_null());
+    ASSERT_TRUE(result["recommendations"][0]["measured"].get<bool>());
+    ASSERT_GT(result["recommendations"][0]["estimated_ratio"].get<double>(), 1.0);
+
+    // The sample must match its data_spec.
+    advise_req["data_spec"]["shape"] = {4096};
+    const std::string bad_req = advise_req.dump();
+    int64_t result_code = cdd_execute_op(handle, bad_req.c_str(), bad_req.length(), bytes.data(), bytes.size(), nullptr, 0, response_buffer_.data(), response_buffer_.size());
+    ASSERT_EQ(result_code, CDD_ERROR_OPERATION_FAILED);
+}
+
+TEST_F(CApiTest, ZstdAdvancedParameters) {
+    test_filepath_ = generate_unique_test_filepath();
+    json file_write_config = {{"backend", {{"type", "File"}, {"mode", "WriteTruncate"}, {"path", test_filepath_.string()}}}};
+    cdd_handle_t handle = create_context(file_write_config);
+    ASSERT_GT(handle, 0);
+
+    // Repetitive data so long-distance matching has something to find.
+    auto pattern = generate_random_data(4096);
+    std::vector<std::byte> data;
+    for (int i = 0; i < 64; ++i) data.insert(data.end(), pattern.begin(), pattern.end());
+
+    json store_req = {
+        {"op_type", "StoreChunk"},
+        {"data_spec", {{"dtype", "UINT8"}, {"shape", {data.size()}}}},
+        {"encoding", {{"codec", "ZSTD_COMPRESSED"}, {"zstd_level", 3}, {"zstd_workers", 2},
+                      {"zstd_long_distance_matching", true}, {"zstd_window_log", 28}, {"zstd_strategy", "BTULTRA2"}}}
+    };
+    auto store_res = execute_op(handle, store_req, data);
+    ASSERT_FALSE(store_res.is_null());
+    ASSERT_LT(store_res["details"]["compressed_size"].get<int64_t>(), static_cast<int64_t>(data.size()));
+
+    // Advanced parameters are rejected for codecs with their own zstd stage.
+    json bad_codec_req = {
+        {"op_type", "StoreChunk"},
+        {"data_spec", {{"dtype", "INT64"}, {"shape", {16}}}},
+        {"encoding", {{"codec", "TEMPORAL_1D_SIMD_I64_DELTA"}, {"zstd_workers", 2}}}
+    };
+    std::vector<std::byte> ints(16 * sizeof(int64_t));
+    int64_t result_code = cdd_execute_op(handle, bad_codec_req.dump().c_str(), bad_codec_req.dump().length(), ints.data(), ints.size(), nullptr, 0, response_buffer_.data(), response_buffer_.size());
+    ASSERT_LT(result_code, 0);
+
+    cdd_context_destroy(handle);
+    if (auto& back = handles_to_cleanup_.back(); back != nullptr && *back == handle)
+    {
+        handles_to_cleanup_.pop_back();
+    }
+
+    json file_read_config = {{"backend", {{"type", "File"}, {"mode", "Read"}, {"path", test_filepath_.string()}}}};
+    handle = create_context(file_read_config);
+    std::vector<std::byte> output_buffer(data.size());
+    auto load_res = execute_op(handle, {{"op_type", "LoadChunks"}, {"selection", {{"type", "All"}}}}, {}, output_buffer);
+    ASSERT_EQ(load_res["bytes_written_to_output"], data.size());
+    ASSERT_EQ(output_buffer, data);
+}
+
 
 TEST_F(CApiTest, LoadChunksChecksumVerification) {
     test_filepath_ = generate_unique_test_filepath();
@@ -495,6 +627,283 @@ TEST_F(CApiTest, LoadChunksChecksumVerification) {
     }
 }
 
+TEST_F(CApiTest, SelectableChunkHash) {
+    test_filepath_ = generate_unique_test_filepath();
+    auto data = generate_random_data(4096);
+
+    // XXH3 by default, BLAKE3 (tree-hashed above 1 KiB) and no hash as per-chunk overrides.
+    {
+        json write_config = {{"backend", {{"type", "File"}, {"mode", "WriteTruncate"}, {"path", test_filepath_.string()}}},
+                             {"writer_options", {{"hash_algorithm", "XXH3_128"}, {"hash_parallel_threshold", 1024}}}};
+        cdd_handle_t writer_handle = create_context(write_config);
+        ASSERT_GT(writer_handle, 0);
+        json store_req = {{"op_type", "StoreChunk"}, {"data_spec", {{"dtype", "UINT8"}, {"shape", {4096}}}}, {"encoding", {{"codec", "RAW"}}}};
+        ASSERT_FALSE(execute_op(writer_handle, store_req, data).is_null());
+        store_req["encoding"]["hash_algorithm"] = "BLAKE3_256";
+        ASSERT_FALSE(execute_op(writer_handle, store_req, data).is_null());
+        store_req["encoding"]["hash_algorithm"] = "NONE";
+        ASSERT_FALSE(execute_op(writer_handle, store_req, data).is_null());
+        store_req["encoding"]["hash_algorithm"] = "MD5";
+        ASSERT_LT(cdd_execute_op(writer_handle, store_req.dump().c_str(), store_req.dump().length(), data.data(), data.size(), nullptr, 0, response_buffer_.data(), response_buffer_.size()), 0);
+        handles_to_cleanup_.pop_back(); // Close writer
+    }
+
+    {
+        auto reader_res = cryptodd::DataReader::open(test_filepath_);
+        ASSERT_TRUE(reader_res.has_value()) << reader_res.error();
+        const std::span<const std::byte> bytes(data);
+        auto xxh3_chunk = reader_res.value()->get_chunk(0);
+        ASSERT_TRUE(xxh3_chunk.has_value());
+        ASSERT_EQ(cryptodd::chunk_hash_algorithm(xxh3_chunk->flags()), cryptodd::HashAlgorithm::XXH3_128);
+        ASSERT_EQ(xxh3_chunk->hash(), cryptodd::calculate_chunk_hash(bytes, cryptodd::ChunkFlags::HASH_XXH3_128));
+        auto tree_chunk = reader_res.value()->get_chunk(1);
+        ASSERT_TRUE(tree_chunk.has_value());
+        ASSERT_TRUE(tree_chunk->has_flag(cryptodd::ChunkFlags::HASH_BLAKE3_TREE));
+        ASSERT_EQ(tree_chunk->hash(), cryptodd::calculate_chunk_hash(bytes, cryptodd::ChunkFlags::HASH_BLAKE3_TREE));
+        auto unhashed_chunk = reader_res.value()->get_chunk(2);
+        ASSERT_TRUE(unhashed_chunk.has_value());
+        ASSERT_FALSE(cryptodd::chunk_has_hash(unhashed_chunk->flags()));
+        ASSERT_EQ(unhashed_chunk->hash(), cryptodd::blake3_hash256_t{});
+    }
+
+    // Every chunk verifies with its own algorithm; the unhashed one is skipped even when checks are forced.
+    json read_config = {{"backend", {{"type", "File"}, {"mode", "Read"}, {"path", test_filepath_.string()}}}};
+    cdd_handle_t reader_handle = create_context(read_config);
+    std::vector<std::byte> read_buffer(3 * data.size());
+    auto load_res = execute_op(reader_handle, {{"op_type", "LoadChunks"}, {"selection", {{"type", "All"}}}, {"check_checksums", true}}, {}, read_buffer);
+    ASSERT_FALSE(load_res.is_null());
+    ASSERT_EQ(load_res["bytes_written_to_output"], read_buffer.size());
+    ASSERT_EQ(0, std::memcmp(read_buffer.data() + 2 * data.size(), data.data(), data.size()));
+}
+
+TEST_F(CApiTest, VerifyReportsCorruptedChunks) {
+    test_filepath_ = generate_unique_test_filepath();
+    std::vector<std::vector<std::byte>> chunks;
+    {
+        json write_config = {{"backend", {{"type", "File"}, {"mode", "WriteTruncate"}, {"path", test_filepath_.string()}}}};
+        cdd_handle_t writer_handle = create_context(write_config);
+        for (int i = 0; i < 4; ++i) {
+            chunks.push_back(generate_random_data(1000));
+            execute_op(writer_handle, {{"op_type", "StoreChunk"}, {"data_spec", {{"dtype", "UINT8"}, {"shape", {1000}}}}, {"encoding", {{"codec", "RAW"}}}}, chunks.back());
+        }
+        handles_to_cleanup_.pop_back(); // Close writer
+    }
+
+    json read_config = {{"backend", {{"type", "File"}, {"mode", "Read"}, {"path", test_filepath_.string()}}}};
+    {
+        cdd_handle_t reader_handle = create_context(read_config);
+        auto verify_res = execute_op(reader_handle, {{"op_type", "Verify"}});
+        ASSERT_FALSE(verify_res.is_null());
+        ASSERT_TRUE(verify_res["ok"].get<bool>());
+        ASSERT_EQ(verify_res["chunks_verified"], 4);
+        ASSERT_EQ(verify_res["bytes_read"], 4000);
+        ASSERT_GE(verify_res["index_blocks"], 1);
+        ASSERT_TRUE(verify_res["faults"].empty());
+    }
+
+    // Flip one byte in the payload of chunk 2, found by its content.
+    {
+        std::fstream file(test_filepath_, std::ios::binary | std::ios::in | std::ios::out);
+        ASSERT_TRUE(file.is_open());
+        std::vector<char> image((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        const auto* pattern = reinterpret_cast<const char*>(chunks[2].data());
+        const auto found = std::search(image.begin(), image.end(), pattern, pattern + chunks[2].size());
+        ASSERT_NE(found, image.end());
+        const auto corruption_offset = std::distance(image.begin(), found) + 500;
+        char byte_to_flip = ~image[corruption_offset];
+        file.clear();
+        file.seekp(corruption_offset);
+        file.write(&byte_to_flip, 1);
+    }
+
+    cdd_handle_t reader_handle = create_context(read_config);
+    auto verify_res = execute_op(reader_handle, {{"op_type", "Verify"}, {"max_in_flight", 2}});
+    ASSERT_FALSE(verify_res.is_null());
+    ASSERT_FALSE(verify_res["ok"].get<bool>());
+    ASSERT_EQ(verify_res["faults"].size(), 1);
+    ASSERT_EQ(verify_res["faults"][0]["index"], 2);
+    ASSERT_EQ(verify_res["chunks_verified"], 3);
+    ASSERT_TRUE(verify_res["faults"][0]["reason"].get<std::string>().find("Checksum mismatch") != std::string::npos);
+    ASSERT_GE(verify_res["read_mbps"].get<double>(), 0.0);
+
+    // Verify needs a reader, and a negative rate limit is rejected.
+    json bad_req = {{"op_type", "Verify"}, {"max_read_mbps", -1.0}};
+    ASSERT_EQ(cdd_execute_op(reader_handle, bad_req.dump().c_str(), bad_req.dump().length(), nullptr, 0, nullptr, 0, response_buffer_.data(), response_buffer_.size()), CDD_ERROR_OPERATION_FAILED);
+    cdd_handle_t memory_writer = create_context({{"backend", {{"type", "Memory"}, {"mode", "WriteTruncate"}}}});
+    json verify_req = {{"op_type", "Verify"}};
+    ASSERT_EQ(cdd_execute_op(memory_writer, verify_req.dump().c_str(), verify_req.dump().length(), nullptr, 0, nullptr, 0, response_buffer_.data(), response_buffer_.size()), CDD_ERROR_OPERATION_FAILED);
+}
+
+TEST_F(CApiTest, DurabilityPolicy) {
+    test_filepath_ = generate_unique_test_filepath();
+    json write_config = {{"backend", {{"type", "File"}, {"mode", "WriteTruncate"}, {"path", test_filepath_.string()}}},
+                         {"writer_options", {{"durability", {{"mode", "EVERY_N_CHUNKS"}, {"every_chunks", 2}}}}}};
+    cdd_handle_t writer_handle = create_context(write_config);
+    ASSERT_GT(writer_handle, 0);
+
+    // The sync statistics are those of the device, shared with any other writer on it: compare deltas.
+    auto first = execute_op(writer_handle, {{"op_type", "Flush"}});
+    ASSERT_FALSE(first.is_null());
+    ASSERT_TRUE(first.contains("sync_stats"));
+    const auto requests_before = first["sync_stats"]["requests"].get<uint64_t>();
+    auto data = generate_random_data(1000);
+    json store_req = {{"op_type", "StoreChunk"}, {"data_spec", {{"dtype", "UINT8"}, {"shape", {1000}}}}, {"encoding", {{"codec", "RAW"}}}};
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_FALSE(execute_op(writer_handle, store_req, data).is_null());
+    }
+    auto flush_res = execute_op(writer_handle, {{"op_type", "Flush"}});
+    ASSERT_FALSE(flush_res.is_null());
+    const auto& stats = flush_res["sync_stats"];
+    // Two syncs for five chunks, one for the flush.
+    ASSERT_EQ(stats["requests"].get<uint64_t>() - requests_before, 3u);
+    ASSERT_GE(stats["syncs"].get<uint64_t>(), 4u);
+    ASSERT_LE(stats["p50_us"].get<uint64_t>(), stats["p99_us"].get<uint64_t>());
+    ASSERT_EQ(stats["latency_buckets"].size(), cryptodd::SyncLatencyHistogram::NUM_BUCKETS);
+
+    // No durability, no statistics.
+    cdd_handle_t memory_writer = create_context({{"backend", {{"type", "Memory"}, {"mode", "WriteTruncate"}}}});
+    auto memory_flush = execute_op(memory_writer, {{"op_type", "Flush"}});
+    ASSERT_FALSE(memory_flush.is_null());
+    ASSERT_FALSE(memory_flush.contains("sync_stats"));
+
+    for (const json& bad : {json{{"mode", "SOMETIMES"}}, json{{"mode", "EVERY_N_CHUNKS"}, {"every_chunks", 0}}, json{{"mode", "INTERVAL"}, {"interval_ms", -5}}}) {
+        const auto other_path = generate_unique_test_filepath();
+        json bad_config = {{"backend", {{"type", "File"}, {"mode", "WriteTruncate"}, {"path", other_path.string()}}}, {"writer_options", {{"durability", bad}}}};
+        const std::string bad_str = bad_config.dump();
+        ASSERT_LT(cdd_context_create(bad_str.c_str(), bad_str.length()), 0) << bad.dump();
+        fs::remove(other_path);
+    }
+}
+
+TEST_F(CApiTest, DirectIoAndChunkAlignment) {
+    test_filepath_ = generate_unique_test_filepath();
+    std::vector<std::vector<std::byte>> chunks;
+    {
+        json write_config = {{"backend", {{"type", "File"}, {"mode", "WriteTruncate"}, {"path", test_filepath_.string()}, {"direct_io", true}}},
+                             {"writer_options", {{"chunk_alignment", 4096}}}};
+        cdd_handle_t writer_handle = create_context(write_config);
+        ASSERT_GT(writer_handle, 0);
+        for (int i = 0; i < 3; ++i) {
+            chunks.push_back(generate_random_data(1000));
+            ASSERT_FALSE(execute_op(writer_handle, {{"op_type", "StoreChunk"}, {"data_spec", {{"dtype", "UINT8"}, {"shape", {1000}}}}, {"encoding", {{"codec", "RAW"}}}}, chunks.back()).is_null());
+        }
+        handles_to_cleanup_.pop_back(); // Close writer
+    }
+
+    {
+        auto reader_res = cryptodd::DataReader::open(test_filepath_);
+        ASSERT_TRUE(reader_res.has_value()) << reader_res.error();
+        for (const auto offset : reader_res.value()->get_chunk_offsets()) {
+            ASSERT_EQ(offset % 4096, 0u);
+        }
+    }
+
+    json read_config = {{"backend", {{"type", "File"}, {"mode", "Read"}, {"path", test_filepath_.string()}, {"direct_io", true}}}};
+    cdd_handle_t reader_handle = create_context(read_config);
+    std::vector<std::byte> read_buffer(3000);
+    auto load_res = execute_op(reader_handle, {{"op_type", "LoadChunks"}, {"selection", {{"type", "All"}}}}, {}, read_buffer);
+    ASSERT_FALSE(load_res.is_null());
+    ASSERT_EQ(load_res["bytes_written_to_output"], 3000);
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        ASSERT_EQ(0, std::memcmp(read_buffer.data() + i * 1000, chunks[i].data(), 1000));
+    }
+
+    for (const json& bad : {json{{"backend", {{"type", "Memory"}, {"mode", "WriteTruncate"}, {"direct_io", true}}}},
+                            json{{"backend", {{"type", "Memory"}, {"mode", "WriteTruncate"}}}, {"writer_options", {{"chunk_alignment", 1000}}}}}) {
+        const std::string bad_str = bad.dump();
+        ASSERT_LT(cdd_context_create(bad_str.c_str(), bad_str.length()), 0) << bad_str;
+    }
+}
+
+TEST_F(CApiTest, AccessHintsAndPrefetch) {
+    test_filepath_ = generate_unique_test_filepath();
+    std::vector<std::byte> all_data;
+    {
+        json write_config = {{"backend", {{"type", "File"}, {"mode", "WriteTruncate"}, {"path", test_filepath_.string()}}}};
+        cdd_handle_t writer_handle = create_context(write_config);
+        ASSERT_GT(writer_handle, 0);
+        for (int i = 0; i < 6; ++i) {
+            const auto data = generate_random_data(1000);
+            all_data.insert(all_data.end(), data.begin(), data.end());
+            ASSERT_FALSE(execute_op(writer_handle, {{"op_type", "StoreChunk"}, {"data_spec", {{"dtype", "UINT8"}, {"shape", {1000}}}}, {"encoding", {{"codec", "RAW"}}}}, data).is_null());
+        }
+        handles_to_cleanup_.pop_back(); // Close writer
+    }
+
+    json read_config = {{"backend", {{"type", "File"}, {"mode", "Read"}, {"path", test_filepath_.string()}, {"access", "SEQUENTIAL"}}}};
+    cdd_handle_t reader_handle = create_context(read_config);
+    ASSERT_GT(reader_handle, 0);
+    std::vector<std::byte> read_buffer(all_data.size());
+
+    // A sequential load prefetches every chunk of the selection after the first ahead of its read.
+    auto load_res = execute_op(reader_handle, {{"op_type", "LoadChunks"}, {"selection", {{"type", "All"}}}}, {}, read_buffer);
+    ASSERT_FALSE(load_res.is_null());
+    ASSERT_EQ(load_res["prefetched_chunks"], 5);
+    ASSERT_EQ(read_buffer, all_data);
+
+    // Random lookups do not prefetch unless asked to.
+    std::ranges::fill(read_buffer, std::byte{0});
+    load_res = execute_op(reader_handle, {{"op_type", "LoadChunks"}, {"selection", {{"type", "Indices"}, {"indices", {4, 1}}}}, {"access", "RANDOM"}}, {}, read_buffer);
+    ASSERT_FALSE(load_res.is_null());
+    ASSERT_FALSE(load_res.contains("prefetched_chunks"));
+    ASSERT_EQ(0, std::memcmp(read_buffer.data(), all_data.data() + 4000, 1000));
+    ASSERT_EQ(0, std::memcmp(read_buffer.data() + 1000, all_data.data() + 1000, 1000));
+
+    load_res = execute_op(reader_handle, {{"op_type", "LoadChunks"}, {"selection", {{"type", "Range"}, {"start_index", 1}, {"count", 4}}}, {"access", "RANDOM"}, {"prefetch_chunks", 2}}, {}, read_buffer);
+    ASSERT_FALSE(load_res.is_null());
+    ASSERT_EQ(load_res["prefetched_chunks"], 3);
+    ASSERT_EQ(0, std::memcmp(read_buffer.data(), all_data.data() + 1000, 4000));
+
+    json bad_config = {{"backend", {{"type", "File"}, {"mode", "Read"}, {"path", test_filepath_.string()}, {"access", "BACKWARDS"}}}};
+    const std::string bad_str = bad_config.dump();
+    ASSERT_LT(cdd_context_create(bad_str.c_str(), bad_str.length()), 0);
+}
+
+TEST_F(CApiTest, MemoryMappedRead) {
+    test_filepath_ = generate_unique_test_filepath();
+    std::vector<std::byte> all_data;
+    {
+        json write_config = {{"backend", {{"type", "File"}, {"mode", "WriteTruncate"}, {"path", test_filepath_.string()}}}};
+        cdd_handle_t writer_handle = create_context(write_config);
+        ASSERT_GT(writer_handle, 0);
+        for (int i = 0; i < 3; ++i) {
+            const auto data = generate_random_data(5000);
+            all_data.insert(all_data.end(), data.begin(), data.end());
+            ASSERT_FALSE(execute_op(writer_handle, {{"op_type", "StoreChunk"}, {"data_spec", {{"dtype", "UINT8"}, {"shape", {5000}}}}, {"encoding", {{"codec", "RAW"}}}}, data).is_null());
+        }
+        handles_to_cleanup_.pop_back(); // Close writer
+    }
+
+    json read_config = {{"backend", {{"type", "File"}, {"mode", "Read"}, {"path", test_filepath_.string()}, {"access", "SEQUENTIAL"},
+                                     {"mmap", {{"populate", true}, {"huge_pages", true}, {"lock_index", true}}}}}};
+    cdd_handle_t reader_handle = create_context(read_config);
+    ASSERT_GT(reader_handle, 0);
+    std::vector<std::byte> read_buffer(all_data.size());
+    auto load_res = execute_op(reader_handle, {{"op_type", "LoadChunks"}, {"selection", {{"type", "All"}}}}, {}, read_buffer);
+    ASSERT_FALSE(load_res.is_null());
+    ASSERT_EQ(read_buffer, all_data);
+    // A lock refused (e.g. past RLIMIT_MEMLOCK) leaves the reader open, and Inspect says why.
+    auto inspect_res = execute_op(reader_handle, {{"op_type", "Inspect"}});
+    ASSERT_FALSE(inspect_res.is_null());
+    if (inspect_res.contains("index_lock_error")) {
+        ASSERT_TRUE(inspect_res["index_lock_error"].is_string());
+    }
+
+    json unlocked_config = read_config;
+    unlocked_config["backend"]["mmap"] = json::object();
+    cdd_handle_t unlocked_handle = create_context(unlocked_config);
+    ASSERT_GT(unlocked_handle, 0);
+    inspect_res = execute_op(unlocked_handle, {{"op_type", "Inspect"}});
+    ASSERT_FALSE(inspect_res.is_null());
+    ASSERT_FALSE(inspect_res.contains("index_lock_error"));
+
+    for (const json& bad : {json{{"backend", {{"type", "File"}, {"mode", "WriteTruncate"}, {"path", test_filepath_.string()}, {"mmap", json::object()}}}},
+                            json{{"backend", {{"type", "File"}, {"mode", "Read"}, {"path", test_filepath_.string()}, {"direct_io", true}, {"mmap", json::object()}}}}}) {
+        const std::string bad_str = bad.dump();
+        ASSERT_LT(cdd_context_create(bad_str.c_str(), bad_str.length()), 0) << bad_str;
+    }
+}
+
 TEST_F(CApiTest, SetMetadataAfterWriteFails) {
     test_filepath_ = generate_unique_test_filepath();
     json write_config = {{"backend", {{"type", "File"}, {"mode", "WriteTruncate"}, {"path", test_filepath_.string()}}}};
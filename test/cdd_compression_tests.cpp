@@ -47,54 +47,59 @@ protected:
 TEST_F(CddCompressionTest, CompressionSuccess) {
     const size_t capacity = 256;
     const size_t total_chunks = capacity + 1;
-    memory::vector<memory::vector<std::byte>> original_chunks;
 
-    // --- WRITE ---
-    {
-        auto writer_result = DataWriter::create_new(test_filepath_, capacity);
-        ASSERT_TRUE(writer_result.has_value()) << writer_result.error();
-        auto writer = std::move(*writer_result);
-
-        for (size_t i = 0; i < total_chunks; ++i) {
-            memory::vector<std::byte> data(256, static_cast<std::byte>(i));
-            original_chunks.push_back(data);
-            memory::vector<int64_t> shape = {16, 16};
-            const auto raw_data_hash = calculate_blake3_hash256(data);
-            Chunk temp_chunk;
-            temp_chunk.set_data(std::move(data));
-            auto append_result = writer->append_chunk(ChunkDataType::RAW, DType::UINT8, ChunkFlags::NONE, shape, temp_chunk, raw_data_hash);
-            ASSERT_TRUE(append_result.has_value()) << append_result.error();
+    // Delta + zstd index blocks by default, which older readers can open; bit-packed ones on request.
+    for (const bool bitpack_index : {false, true}) {
+        fs::remove(test_filepath_);
+        memory::vector<memory::vector<std::byte>> original_chunks;
+
+        // --- WRITE ---
+        {
+            auto writer_result = DataWriter::create_new(test_filepath_, capacity, {}, {.bitpack_index = bitpack_index});
+            ASSERT_TRUE(writer_result.has_value()) << writer_result.error();
+            auto writer = std::move(*writer_result);
+
+            for (size_t i = 0; i < total_chunks; ++i) {
+                memory::vector<std::byte> data(256, static_cast<std::byte>(i));
+                original_chunks.push_back(data);
+                memory::vector<int64_t> shape = {16, 16};
+                const auto raw_data_hash = calculate_blake3_hash256(data);
+                Chunk temp_chunk;
+                temp_chunk.set_data(std::move(data));
+                auto append_result = writer->append_chunk(ChunkDataType::RAW, DType::UINT8, ChunkFlags::NONE, shape, temp_chunk, raw_data_hash);
+                ASSERT_TRUE(append_result.has_value()) << append_result.error();
+            }
+            ASSERT_TRUE(writer->flush().has_value());
         }
-        ASSERT_TRUE(writer->flush().has_value());
-    }
-
-    // --- MANUAL VERIFICATION of block type ---
-    {
-        storage::FileBackend backend(test_filepath_, std::ios_base::in | std::ios_base::binary);
-        FileHeader header;
-        ASSERT_TRUE(header.read(backend).has_value());
 
-        // We are now at the start of the first ChunkOffsetsBlock.
-        // Read its header to check the type.
-        auto size_res = serialization::read_pod<uint32_t>(backend);
-        ASSERT_TRUE(size_res.has_value()) << size_res.error();
+        // --- MANUAL VERIFICATION of block type ---
+        {
+            storage::FileBackend backend(test_filepath_, std::ios_base::in | std::ios_base::binary);
+            FileHeader header;
+            ASSERT_TRUE(header.read(backend).has_value());
 
-        auto type_res = serialization::read_pod<ChunkOffsetType>(backend);
-        ASSERT_TRUE(type_res.has_value()) << type_res.error();
-        EXPECT_EQ(*type_res, ChunkOffsetType::ZSTD_COMPRESSED);
-    }
+            // We are now at the start of the first ChunkOffsetsBlock.
+            // Read its header to check the type.
+            auto size_res = serialization::read_pod<uint32_t>(backend);
+            ASSERT_TRUE(size_res.has_value()) << size_res.error();
 
-    // --- READ and VERIFY all data ---
-    {
-        auto reader_result = DataReader::open(test_filepath_);
-        ASSERT_TRUE(reader_result.has_value()) << reader_result.error();
-        auto reader = std::move(*reader_result);
-        ASSERT_EQ(reader->num_chunks(), total_chunks);
+            auto type_res = serialization::read_pod<ChunkOffsetType>(backend);
+            ASSERT_TRUE(type_res.has_value()) << type_res.error();
+            EXPECT_EQ(*type_res, bitpack_index ? ChunkOffsetType::DELTA_BITPACK : ChunkOffsetType::ZSTD_COMPRESSED);
+        }
 
-        for (size_t i = 0; i < total_chunks; ++i) {
-            auto chunk_result = reader->get_chunk(i);
-            ASSERT_TRUE(chunk_result.has_value()) << "Failed to get chunk " << i << ": " << chunk_result.error();
-            EXPECT_EQ(chunk_result->data(), original_chunks[i]) << "Data mismatch for chunk " << i;
+        // --- READ and VERIFY all data ---
+        {
+            auto reader_result = DataReader::open(test_filepath_);
+            ASSERT_TRUE(reader_result.has_value()) << reader_result.error();
+            auto reader = std::move(*reader_result);
+            ASSERT_EQ(reader->num_chunks(), total_chunks);
+
+            for (size_t i = 0; i < total_chunks; ++i) {
+                auto chunk_result = reader->get_chunk(i);
+                ASSERT_TRUE(chunk_result.has_value()) << "Failed to get chunk " << i << ": " << chunk_result.error();
+                EXPECT_EQ(chunk_result->data(), original_chunks[i]) << "Data mismatch for chunk " << i;
+            }
         }
     }
 }
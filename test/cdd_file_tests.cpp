@@ -6,6 +6,7 @@
 #include <filesystem>
 // Include the single-header UUID library for unique filenames
 #include "../src/codecs/zstd_compressor.h"
+#include "../src/storage/file_backend.h"
 #include "../src/storage/memory_backend.h"
 #include "../src/file_format/blake3_stream_hasher.h"
 #include "test_helpers.h"
@@ -501,6 +502,189 @@ TEST_F(CddFileTest, InMemoryWriterToReader) {
     ASSERT_EQ(chunk2_result->data(), data2);
 }
 
+TEST_F(CddFileTest, DirectIoWithAlignedChunks) {
+    constexpr uint32_t kAlignment = 4096;
+    const FileWriterOptions file_options{.write_buffer_size = 64 * 1024, .direct_io = true, .chunk_alignment = kAlignment};
+    memory::vector<int64_t> shape = {0};
+    std::vector<memory::vector<std::byte>> written;
+    const auto append = [&](DataWriter& writer, const size_t size) {
+        auto data = generate_random_data(size);
+        shape[0] = static_cast<int64_t>(size);
+        Chunk chunk;
+        chunk.set_data({data.begin(), data.end()});
+        ASSERT_TRUE(writer.append_chunk(ChunkDataType::RAW, DType::UINT8, ChunkFlags::NONE, shape, chunk,
+                                        calculate_blake3_hash256(data)).has_value());
+        written.push_back(std::move(data));
+    };
+
+    {
+        auto writer_result = DataWriter::create_new(test_filepath_, 4, {}, file_options);
+        ASSERT_TRUE(writer_result.has_value()) << writer_result.error();
+        ASSERT_EQ((*writer_result)->chunk_alignment(), kAlignment);
+        ASSERT_FALSE((*writer_result)->set_chunk_alignment(3).has_value());
+        for (size_t i = 0; i < 10; ++i) append(**writer_result, 100 + i * 1500);
+        ASSERT_TRUE((*writer_result)->flush().has_value());
+    }
+    {
+        auto writer_result = DataWriter::open_for_append(test_filepath_, file_options);
+        ASSERT_TRUE(writer_result.has_value()) << writer_result.error();
+        for (size_t i = 0; i < 3; ++i) append(**writer_result, 5000);
+    }
+
+    for (const bool direct_io : {true, false}) {
+        auto reader_result = DataReader::open(test_filepath_, {.direct_io = direct_io, .read_window = 16 * 1024});
+        ASSERT_TRUE(reader_result.has_value()) << reader_result.error();
+        auto& reader = **reader_result;
+        ASSERT_EQ(reader.num_chunks(), written.size());
+        for (size_t i = 0; i < written.size(); ++i) {
+            ASSERT_EQ(reader.get_chunk_offsets()[i] % kAlignment, 0u) << "chunk " << i;
+            auto chunk = reader.get_chunk(i);
+            ASSERT_TRUE(chunk.has_value()) << chunk.error();
+            ASSERT_EQ(chunk->data(), written[i]);
+        }
+    }
+
+    ASSERT_FALSE(DataWriter::create_new(generate_unique_test_filepath(), 4, {},
+                                        {.write_buffer_size = 0, .direct_io = true}).has_value());
+}
+
+namespace {
+    // Forwards to a memory backend and records the hints it is given.
+    class AdviceRecordingBackend final : public storage::IStorageBackend {
+    public:
+        struct Advice {
+            storage::AccessHint hint;
+            uint64_t offset;
+            uint64_t length;
+        };
+
+        explicit AdviceRecordingBackend(std::unique_ptr<storage::IStorageBackend> inner, std::vector<Advice>& advice)
+            : inner_(std::move(inner)), advice_(advice) {}
+
+        std::expected<size_t, std::string> read(std::span<std::byte> buffer) override { return inner_->read(buffer); }
+        std::expected<size_t, std::string> write(std::span<const std::byte> data) override { return inner_->write(data); }
+        std::expected<void, std::string> seek(uint64_t offset) override { return inner_->seek(offset); }
+        std::expected<uint64_t, std::string> tell() override { return inner_->tell(); }
+        std::expected<void, std::string> flush() override { return inner_->flush(); }
+        std::expected<void, std::string> rewind() override { return inner_->rewind(); }
+        std::expected<uint64_t, std::string> size() override { return inner_->size(); }
+        std::expected<bool, std::string> advise(storage::AccessHint hint, uint64_t offset, uint64_t length) override {
+            advice_.push_back({hint, offset, length});
+            return true;
+        }
+
+    private:
+        std::unique_ptr<storage::IStorageBackend> inner_;
+        std::vector<Advice>& advice_;
+    };
+}
+
+TEST_F(CddFileTest, AccessHints) {
+    memory::vector<int64_t> shape = {0};
+    std::vector<memory::vector<std::byte>> written;
+    {
+        auto writer_result = DataWriter::create_new(test_filepath_, 4);
+        ASSERT_TRUE(writer_result.has_value()) << writer_result.error();
+        for (size_t i = 0; i < 10; ++i) {
+            auto data = generate_random_data(1000 + i * 100);
+            shape[0] = static_cast<int64_t>(data.size());
+            Chunk chunk;
+            chunk.set_data({data.begin(), data.end()});
+            ASSERT_TRUE((*writer_result)->append_chunk(ChunkDataType::RAW, DType::UINT8, ChunkFlags::NONE, shape, chunk,
+                                                       calculate_blake3_hash256(data)).has_value());
+            written.push_back(std::move(data));
+        }
+    }
+
+    using storage::AccessHint;
+    for (const auto access : {AccessHint::NORMAL, AccessHint::SEQUENTIAL, AccessHint::RANDOM, AccessHint::WILLNEED}) {
+        auto reader_result = DataReader::open(test_filepath_, {.access = access});
+        ASSERT_TRUE(reader_result.has_value()) << reader_result.error();
+        auto& reader = **reader_result;
+        ASSERT_EQ(reader.access_hint(), access);
+        ASSERT_TRUE(reader.advise_chunks(AccessHint::WILLNEED, 2, 8).has_value());
+        for (size_t i = 0; i < written.size(); ++i) {
+            auto chunk = reader.get_chunk(i);
+            ASSERT_TRUE(chunk.has_value()) << chunk.error();
+            ASSERT_EQ(chunk->data(), written[i]);
+        }
+    }
+
+    // The ranges hinted for chunks, through a backend that records them.
+    std::vector<AdviceRecordingBackend::Advice> advice;
+    auto reader_result = DataReader::open_in_memory(std::make_unique<AdviceRecordingBackend>(
+        std::make_unique<storage::FileBackend>(test_filepath_, std::ios_base::in | std::ios_base::binary), advice));
+    ASSERT_TRUE(reader_result.has_value()) << reader_result.error();
+    auto& reader = **reader_result;
+    const auto offsets = reader.get_chunk_offsets();
+
+    ASSERT_TRUE(reader.advise_chunks(AccessHint::WILLNEED, 1, 3).has_value());
+    ASSERT_EQ(advice.size(), 1u);
+    ASSERT_EQ(advice[0].offset, offsets[1]);
+    ASSERT_EQ(advice[0].length, offsets[4] - offsets[1]);
+    // The last chunk extends to the end of the file.
+    ASSERT_TRUE(reader.advise_chunks(AccessHint::WILLNEED, 9, 1).has_value());
+    ASSERT_EQ(advice[1].offset, offsets[9]);
+    ASSERT_EQ(advice[1].length, 0u);
+    ASSERT_FALSE(reader.advise_chunks(AccessHint::WILLNEED, 8, 3).has_value());
+
+    // One hint per run of consecutive chunks.
+    advice.clear();
+    const std::vector<size_t> indices = {0, 1, 2, 5, 7, 8};
+    auto prefetched = reader.prefetch_chunks(indices);
+    ASSERT_TRUE(prefetched.has_value()) << prefetched.error();
+    ASSERT_EQ(*prefetched, indices.size());
+    ASSERT_EQ(advice.size(), 3u);
+    ASSERT_EQ(advice[0].offset, offsets[0]);
+    ASSERT_EQ(advice[0].length, offsets[3] - offsets[0]);
+    ASSERT_EQ(advice[1].offset, offsets[5]);
+    ASSERT_EQ(advice[1].length, offsets[6] - offsets[5]);
+    ASSERT_EQ(advice[2].offset, offsets[7]);
+    ASSERT_EQ(advice[2].length, offsets[9] - offsets[7]);
+    ASSERT_TRUE(std::ranges::all_of(advice, [](const auto& a) { return a.hint == AccessHint::WILLNEED; }));
+}
+
+TEST_F(CddFileTest, MemoryMappedReader) {
+    memory::vector<int64_t> shape = {0};
+    std::vector<memory::vector<std::byte>> written;
+    {
+        auto writer_result = DataWriter::create_new(test_filepath_, 4);
+        ASSERT_TRUE(writer_result.has_value()) << writer_result.error();
+        for (size_t i = 0; i < 10; ++i) {
+            auto data = generate_random_data(5000 + i * 1000);
+            shape[0] = static_cast<int64_t>(data.size());
+            Chunk chunk;
+            chunk.set_data({data.begin(), data.end()});
+            ASSERT_TRUE((*writer_result)->append_chunk(ChunkDataType::RAW, DType::UINT8, ChunkFlags::NONE, shape, chunk,
+                                                       calculate_blake3_hash256(data)).has_value());
+            written.push_back(std::move(data));
+        }
+    }
+
+    for (const bool lock_index : {false, true}) {
+        auto reader_result = DataReader::open(test_filepath_, {.access = storage::AccessHint::SEQUENTIAL,
+                                                               .memory_map = true,
+                                                               .map = {.populate = true, .huge_pages = true},
+                                                               .lock_index = lock_index});
+        ASSERT_TRUE(reader_result.has_value()) << reader_result.error();
+        auto& reader = **reader_result;
+        if (!lock_index) {
+            ASSERT_FALSE(reader.index_lock_error().has_value());
+        }
+        // Four offsets per block.
+        ASSERT_EQ(reader.get_index_blocks().size(), 3u);
+        ASSERT_EQ(reader.get_index_blocks().front().offset, reader.get_index_block_offset());
+        ASSERT_EQ(*reader.verify_index(), 3u);
+        for (size_t i = 0; i < written.size(); ++i) {
+            auto chunk = reader.get_chunk(i);
+            ASSERT_TRUE(chunk.has_value()) << chunk.error();
+            ASSERT_EQ(chunk->data(), written[i]);
+        }
+    }
+
+    ASSERT_FALSE(DataReader::open(test_filepath_, {.direct_io = true, .memory_map = true}).has_value());
+}
+
 // --- Parameterized Test for Chunk Offset Block Chaining ---
 
 struct ChunkOffsetChainingTestParams {
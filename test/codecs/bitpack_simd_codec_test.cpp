@@ -0,0 +1,138 @@
+#include "bitpack_simd_codec.h"
+#include "temporal_1d_simd_codec.h"
+#include "zstd_compressor.h"
+#include "../../src/data_io/data_compressor.h"
+#include "../../src/data_io/data_extractor.h"
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace cryptodd;
+
+namespace {
+    // Exchange-like timestamps: mostly small positive steps with an occasional gap.
+    std::vector<int64_t> generate_timestamps(const size_t num_elements, const uint32_t seed) {
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<int64_t> step(0, 50);
+        std::bernoulli_distribution gap(0.01);
+        std::vector<int64_t> data(num_elements);
+        int64_t ts = 1'700'000'000'000;
+        for (auto& val : data) {
+            ts += gap(gen) ? 60'000 : step(gen);
+            val = ts;
+        }
+        return data;
+    }
+
+    std::expected<std::vector<uint64_t>, std::string> round_trip(const std::vector<uint64_t>& values) {
+        std::vector<std::byte> encoded(bitpack::max_encoded_size(values.size()));
+        encoded.resize(bitpack::encode(values, encoded.data()));
+        std::vector<uint64_t> decoded(values.size());
+        if (auto res = bitpack::decode(encoded, decoded); !res) return std::unexpected(res.error());
+        return decoded;
+    }
+}
+
+class BitPackSimdCodecTest : public ::testing::Test {
+protected:
+    static constexpr size_t kNumElements = 16 * 1024 + 77; // Ends on a partial block
+
+    Temporal1dSimdCodec codec{std::make_unique<ZstdCompressor>()};
+    Temporal1dSimdCodecWorkspace workspace;
+};
+
+TEST_F(BitPackSimdCodecTest, RoundTrip_AllBitWidths) {
+    std::mt19937_64 gen(1);
+    for (unsigned width = 0; width <= 64; ++width) {
+        for (const size_t n : {size_t{1}, size_t{255}, codecs::BitPack::BLOCK_VALUES, size_t{3 * 256 + 5}}) {
+            const uint64_t mask = width == 64 ? ~uint64_t{0} : (uint64_t{1} << width) - 1;
+            const uint64_t base = gen();
+            std::vector<uint64_t> values(n);
+            for (auto& val : values) val = base + (gen() & mask);
+
+            auto decoded = round_trip(values);
+            ASSERT_TRUE(decoded.has_value()) << "width " << width << ", n " << n << ": " << decoded.error();
+            ASSERT_EQ(*decoded, values) << "width " << width << ", n " << n;
+        }
+    }
+}
+
+TEST_F(BitPackSimdCodecTest, OutliersBecomeExceptions) {
+    std::vector<uint64_t> values(4 * codecs::BitPack::BLOCK_VALUES, 3);
+    for (size_t i = 0; i < values.size(); i += 97) values[i] = std::numeric_limits<uint64_t>::max() - i;
+
+    std::vector<std::byte> encoded(bitpack::max_encoded_size(values.size()));
+    encoded.resize(bitpack::encode(values, encoded.data()));
+    // A handful of 64-bit outliers must not widen the whole block.
+    ASSERT_LT(encoded.size(), values.size());
+
+    std::vector<uint64_t> decoded(values.size());
+    ASSERT_TRUE(bitpack::decode(encoded, decoded).has_value());
+    ASSERT_EQ(decoded, values);
+}
+
+TEST_F(BitPackSimdCodecTest, RejectsCorruptedPayload) {
+    std::vector<uint64_t> values(1000);
+    for (size_t i = 0; i < values.size(); ++i) values[i] = i * i;
+    std::vector<std::byte> encoded(bitpack::max_encoded_size(values.size()));
+    encoded.resize(bitpack::encode(values, encoded.data()));
+    std::vector<uint64_t> decoded(values.size());
+
+    auto truncated = std::span<const std::byte>(encoded).first(encoded.size() - 8);
+    ASSERT_FALSE(bitpack::decode(truncated, decoded).has_value());
+
+    auto trailing = encoded;
+    trailing.resize(encoded.size() + 8);
+    ASSERT_FALSE(bitpack::decode(trailing, decoded).has_value());
+
+    auto bad_width = encoded;
+    bad_width[8] = std::byte{65};
+    ASSERT_FALSE(bitpack::decode(bad_width, decoded).has_value());
+}
+
+TEST_F(BitPackSimdCodecTest, DeltaBitPack_RoundTripAndCarryPrevElement) {
+    const auto original = generate_timestamps(kNumElements, 2);
+    const int64_t initial_prev = original.front() - 10;
+
+    for (const bool compress : {false, true}) {
+        auto encoded = codec.encode64_Delta_BitPack(original, initial_prev, workspace, compress);
+        ASSERT_TRUE(encoded.has_value()) << encoded.error();
+        ASSERT_LT(encoded->size(), original.size() * sizeof(int64_t) / 4);
+
+        int64_t decoder_prev = initial_prev;
+        auto decoded = codec.decode64_Delta_BitPack(*encoded, original.size(), decoder_prev, compress);
+        ASSERT_TRUE(decoded.has_value()) << decoded.error();
+        ASSERT_TRUE(std::equal(decoded->begin(), decoded->end(), original.begin(), original.end()));
+        ASSERT_EQ(decoder_prev, original.back());
+    }
+}
+
+TEST_F(BitPackSimdCodecTest, DeltaBitPack_ExtremeValuesWrap) {
+    const std::vector<int64_t> original = {std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::min(), 0, -1,
+                                           std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max(), 42};
+    auto encoded = codec.encode64_Delta_BitPack(original, 0, workspace);
+    ASSERT_TRUE(encoded.has_value()) << encoded.error();
+
+    int64_t decoder_prev = 0;
+    auto decoded = codec.decode64_Delta_BitPack(*encoded, original.size(), decoder_prev);
+    ASSERT_TRUE(decoded.has_value()) << decoded.error();
+    ASSERT_TRUE(std::equal(decoded->begin(), decoded->end(), original.begin(), original.end()));
+}
+
+TEST_F(BitPackSimdCodecTest, DataCompressorRoundTrip) {
+    const auto original = generate_timestamps(kNumElements, 3);
+    DataCompressor compressor;
+    DataExtractor extractor;
+
+    for (const auto type : {ChunkDataType::TEMPORAL_1D_SIMD_I64_DELTA_BITPACK, ChunkDataType::TEMPORAL_1D_SIMD_I64_DELTA_BITPACK_ZSTD}) {
+        auto chunk = compressor.compress_chunk(std::span<const int64_t>(original), type);
+        ASSERT_TRUE(chunk.has_value()) << chunk.error().to_string();
+        ASSERT_EQ((*chunk)->dtype(), DType::INT64);
+
+        auto decoded = extractor.read_chunk(**chunk);
+        ASSERT_TRUE(decoded.has_value()) << decoded.error().to_string();
+        const auto values = (*decoded)->get<int64_t>();
+        ASSERT_TRUE(std::equal(values.begin(), values.end(), original.begin(), original.end()));
+    }
+}
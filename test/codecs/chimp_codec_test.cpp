@@ -0,0 +1,169 @@
+#include "chimp_codec.h"
+#include "../../src/data_io/data_compressor.h"
+#include "../../src/data_io/data_extractor.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace cryptodd;
+
+namespace {
+    // Tick-like prices: a random walk over a 0.5 tick grid that often stays on the same level.
+    template <typename T>
+    std::vector<T> generate_tick_prices(const size_t num_elements, const uint32_t seed) {
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<int> step(-2, 2);
+        std::vector<T> data(num_elements);
+        T price = static_cast<T>(30000.0);
+        for (T& val : data) {
+            price += static_cast<T>(step(gen)) * static_cast<T>(0.5);
+            val = price;
+        }
+        return data;
+    }
+
+    template <typename T>
+    bool bitwise_equal(std::span<const T> a, std::span<const T> b) {
+        return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size_bytes()) == 0;
+    }
+}
+
+class ChimpCodecTest : public ::testing::Test {
+protected:
+    static constexpr size_t kNumElements = 16 * 1024 + 3;
+
+    ChimpCodec codec;
+    ChimpCodecWorkspace workspace;
+};
+
+TEST_F(ChimpCodecTest, RoundTrip_Float64) {
+    const auto original = generate_tick_prices<double>(kNumElements, 1);
+    const double initial_prev = 29999.5;
+
+    auto encoded = codec.encode64(original, initial_prev, workspace);
+    ASSERT_TRUE(encoded.has_value()) << encoded.error();
+    ASSERT_EQ(encoded->size() % sizeof(uint64_t), 0u);
+    ASSERT_LT(encoded->size(), original.size() * sizeof(double) / 2);
+
+    double decoder_prev = initial_prev;
+    auto decoded = codec.decode64(*encoded, original.size(), decoder_prev);
+    ASSERT_TRUE(decoded.has_value()) << decoded.error();
+    ASSERT_TRUE(bitwise_equal<double>(*decoded, original));
+    ASSERT_EQ(decoder_prev, original.back());
+}
+
+TEST_F(ChimpCodecTest, RoundTrip_Float32) {
+    const auto original = generate_tick_prices<float>(kNumElements, 2);
+    const float initial_prev = 123.45f;
+
+    auto encoded = codec.encode32(original, initial_prev, workspace);
+    ASSERT_TRUE(encoded.has_value()) << encoded.error();
+
+    float decoder_prev = initial_prev;
+    auto decoded = codec.decode32(*encoded, original.size(), decoder_prev);
+    ASSERT_TRUE(decoded.has_value()) << decoded.error();
+    ASSERT_TRUE(bitwise_equal<float>(*decoded, original));
+    ASSERT_EQ(decoder_prev, original.back());
+}
+
+TEST_F(ChimpCodecTest, RoundTrip_RandomBitsAndSpecialValues) {
+    std::mt19937_64 gen(3);
+    std::vector<double> original(4096);
+    for (double& val : original) {
+        val = std::bit_cast<double>(gen());
+    }
+    original[10] = std::numeric_limits<double>::quiet_NaN();
+    original[11] = -0.0;
+    original[12] = 0.0;
+    original[13] = std::numeric_limits<double>::infinity();
+    original[14] = std::numeric_limits<double>::denorm_min();
+    original[15] = original[14];
+
+    auto encoded = codec.encode64(original, 0.0, workspace);
+    ASSERT_TRUE(encoded.has_value()) << encoded.error();
+    double decoder_prev = 0.0;
+    auto decoded = codec.decode64(*encoded, original.size(), decoder_prev);
+    ASSERT_TRUE(decoded.has_value()) << decoded.error();
+    ASSERT_TRUE(bitwise_equal<double>(*decoded, original));
+}
+
+TEST_F(ChimpCodecTest, ChainedChunksCarryPrevElement) {
+    const auto original = generate_tick_prices<double>(3000, 4);
+    const std::span<const double> all(original);
+
+    double encoder_prev = 0.0;
+    double decoder_prev = 0.0;
+    for (size_t offset = 0; offset < original.size(); offset += 1000) {
+        const auto part = all.subspan(offset, 1000);
+        auto encoded = codec.encode64(part, encoder_prev, workspace);
+        ASSERT_TRUE(encoded.has_value()) << encoded.error();
+        encoder_prev = part.back();
+
+        auto decoded = codec.decode64(*encoded, part.size(), decoder_prev);
+        ASSERT_TRUE(decoded.has_value()) << decoded.error();
+        ASSERT_TRUE(bitwise_equal<double>(*decoded, part));
+    }
+    ASSERT_EQ(decoder_prev, original.back());
+}
+
+TEST_F(ChimpCodecTest, EmptyInput) {
+    auto encoded = codec.encode32({}, 1.0f, workspace);
+    ASSERT_TRUE(encoded.has_value()) << encoded.error();
+    ASSERT_TRUE(encoded->empty());
+
+    float decoder_prev = 1.0f;
+    auto decoded = codec.decode32(*encoded, 0, decoder_prev);
+    ASSERT_TRUE(decoded.has_value()) << decoded.error();
+    ASSERT_TRUE(decoded->empty());
+    ASSERT_EQ(decoder_prev, 1.0f);
+}
+
+TEST_F(ChimpCodecTest, RejectsTruncatedPayload) {
+    const auto original = generate_tick_prices<double>(kNumElements, 5);
+    auto encoded = codec.encode64(original, 0.0, workspace);
+    ASSERT_TRUE(encoded.has_value()) << encoded.error();
+
+    encoded->resize(encoded->size() - sizeof(uint64_t));
+    double decoder_prev = 0.0;
+    ASSERT_FALSE(codec.decode64(*encoded, original.size(), decoder_prev).has_value());
+
+    encoded->resize(encoded->size() - 1);
+    ASSERT_FALSE(codec.decode64(*encoded, original.size(), decoder_prev).has_value());
+}
+
+TEST_F(ChimpCodecTest, DataCompressorRoundTrip_Float64) {
+    const auto original = generate_tick_prices<double>(kNumElements, 6);
+    DataCompressor compressor;
+    DataExtractor extractor;
+
+    auto chunk = compressor.compress_chunk(std::span<const double>(original), ChunkDataType::TEMPORAL_1D_CHIMP_F64);
+    ASSERT_TRUE(chunk.has_value()) << chunk.error().to_string();
+    ASSERT_EQ((*chunk)->dtype(), DType::FLOAT64);
+
+    auto decoded = extractor.read_chunk(**chunk);
+    ASSERT_TRUE(decoded.has_value()) << decoded.error().to_string();
+    ASSERT_EQ((*decoded)->dtype(), DType::FLOAT64);
+    ASSERT_TRUE(bitwise_equal<double>((*decoded)->get<double>(), original));
+}
+
+TEST_F(ChimpCodecTest, DataCompressorMultiFrame_Float32) {
+    const auto original = generate_tick_prices<float>(kNumElements, 7);
+    const std::vector<int64_t> shape = {static_cast<int64_t>(original.size())};
+    const float prev = 0.0f;
+    DataCompressor compressor;
+    DataExtractor extractor;
+
+    auto chunk = compressor.compress_chunk_frames(std::as_bytes(std::span(original)), ChunkDataType::TEMPORAL_1D_CHIMP_F32,
+                                                  shape, std::as_bytes(std::span(&prev, 1)), 4);
+    ASSERT_TRUE(chunk.has_value()) << chunk.error().to_string();
+    ASSERT_TRUE((*chunk)->has_flag(ChunkFlags::MULTI_FRAME));
+
+    float decoder_prev = 0.0f;
+    auto decoded = extractor.read_chunk(**chunk, decoder_prev);
+    ASSERT_TRUE(decoded.has_value()) << decoded.error().to_string();
+    ASSERT_TRUE(bitwise_equal<float>((*decoded)->get<float>(), original));
+    ASSERT_EQ(decoder_prev, original.back());
+}
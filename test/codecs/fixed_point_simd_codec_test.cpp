@@ -0,0 +1,292 @@
+#include "fixed_point_simd_codec.h"
+#include "zstd_compressor.h"
+#include "../../src/data_io/data_compressor.h"
+#include "../../src/data_io/data_extractor.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace cryptodd;
+
+namespace {
+    // A random walk on the tick grid, built as integer / scale so every value is exactly on it.
+    template <typename T>
+    std::vector<T> generate_ticks(const size_t num_elements, const double scale, const uint32_t seed) {
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<int64_t> step(-20, 20);
+        std::vector<T> data(num_elements);
+        int64_t ticks = 3'000'000;
+        for (auto& val : data) {
+            ticks += step(gen);
+            val = static_cast<T>(static_cast<double>(ticks) / scale);
+        }
+        return data;
+    }
+}
+
+class FixedPointSimdCodecTest : public ::testing::Test {
+protected:
+    static constexpr size_t kNumRows = 4 * 1024 + 13;
+
+    FixedPointSimdCodec codec{std::make_unique<ZstdCompressor>()};
+    FixedPointSimdCodecWorkspace workspace;
+};
+
+TEST_F(FixedPointSimdCodecTest, ScaleForTick) {
+    EXPECT_EQ(*FixedPointSimdCodec::scale_for_tick(0.01), 100.0);
+    EXPECT_EQ(*FixedPointSimdCodec::scale_for_tick(1e-8), 1e8);
+    EXPECT_EQ(*FixedPointSimdCodec::scale_for_tick(0.25), 4.0);
+    EXPECT_EQ(*FixedPointSimdCodec::scale_for_tick(5.0), 0.2);
+    EXPECT_FALSE(FixedPointSimdCodec::scale_for_tick(0.0).has_value());
+    EXPECT_FALSE(FixedPointSimdCodec::scale_for_tick(-0.01).has_value());
+    EXPECT_FALSE(FixedPointSimdCodec::scale_for_tick(std::nan("")).has_value());
+}
+
+TEST_F(FixedPointSimdCodecTest, Columns_RoundTrip_Float64) {
+    const std::vector<double> scales = {100.0, 1e8, 2.0};
+    std::vector<double> data;
+    for (size_t c = 0; c < scales.size(); ++c) {
+        const auto column = generate_ticks<double>(kNumRows, scales[c], static_cast<uint32_t>(c));
+        data.insert(data.end(), column.begin(), column.end());
+    }
+
+    auto encoded = codec.encode64(data, FixedPointLayout::Columns, kNumRows, scales, workspace);
+    ASSERT_TRUE(encoded.has_value()) << encoded.error();
+    ASSERT_TRUE(encoded->has_value()) << "On-grid data was reported off-grid.";
+    ASSERT_LT((*encoded)->size(), data.size() * sizeof(double) / 4);
+
+    auto decoded = codec.decode64(**encoded, FixedPointLayout::Columns, kNumRows, scales.size());
+    ASSERT_TRUE(decoded.has_value()) << decoded.error();
+    ASSERT_TRUE(std::equal(decoded->begin(), decoded->end(), data.begin(), data.end()));
+}
+
+TEST_F(FixedPointSimdCodecTest, Rows_RoundTrip_Float32) {
+    constexpr size_t kRowElements = 20 * 3;
+    const std::vector<double> scales = {10.0, 1000.0, 1.0};
+    std::vector<float> data(kNumRows * kRowElements);
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int64_t> ticks(1, 100'000);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<float>(static_cast<double>(ticks(gen)) / scales[i % scales.size()]);
+    }
+
+    auto encoded = codec.encode32(data, FixedPointLayout::Rows, kNumRows, scales, workspace);
+    ASSERT_TRUE(encoded.has_value()) << encoded.error();
+    ASSERT_TRUE(encoded->has_value()) << "On-grid data was reported off-grid.";
+
+    auto decoded = codec.decode32(**encoded, FixedPointLayout::Rows, kNumRows, kRowElements);
+    ASSERT_TRUE(decoded.has_value()) << decoded.error();
+    ASSERT_TRUE(std::equal(decoded->begin(), decoded->end(), data.begin(), data.end()));
+}
+
+TEST_F(FixedPointSimdCodecTest, OffGridIsReported) {
+    const std::vector<double> scales = {100.0};
+    auto data = generate_ticks<double>(kNumRows, scales[0], 1);
+    for (const double bad : {data[kNumRows / 2] + 1e-9, std::nan(""), std::numeric_limits<double>::infinity(), 1e300}) {
+        auto copy = data;
+        copy[kNumRows / 2] = bad;
+        auto encoded = codec.encode64(copy, FixedPointLayout::Columns, kNumRows, scales, workspace);
+        ASSERT_TRUE(encoded.has_value()) << encoded.error();
+        ASSERT_FALSE(encoded->has_value()) << "Value " << bad << " was accepted as on-grid.";
+    }
+}
+
+TEST_F(FixedPointSimdCodecTest, RejectsCorruptedPayload) {
+    const std::vector<double> scales = {100.0};
+    const auto data = generate_ticks<double>(1000, scales[0], 2);
+    auto encoded = codec.encode64(data, FixedPointLayout::Columns, data.size(), scales, workspace);
+    ASSERT_TRUE(encoded.has_value() && encoded->has_value());
+
+    ASSERT_FALSE(codec.decode64(**encoded, FixedPointLayout::Columns, data.size(), 2).has_value());
+    auto bad_scale = **encoded;
+    const double negative = -100.0;
+    std::memcpy(bad_scale.data() + 2 * sizeof(uint32_t), &negative, sizeof(negative));
+    ASSERT_FALSE(codec.decode64(bad_scale, FixedPointLayout::Columns, data.size(), 1).has_value());
+}
+
+TEST_F(FixedPointSimdCodecTest, DataCompressor_RoundTripAndFallback) {
+    DataCompressor compressor;
+    DataExtractor extractor;
+    const std::vector<double> tick = {0.01};
+
+    const auto prices = generate_ticks<float>(kNumRows, 100.0, 3);
+    const int64_t shape = static_cast<int64_t>(prices.size());
+    auto chunk = compressor.compress_fixed_point(std::span<const float>(prices), ChunkDataType::TEMPORAL_1D_FIXED_POINT_F32, {&shape, 1}, tick);
+    ASSERT_TRUE(chunk.has_value()) << chunk.error().to_string();
+    ASSERT_EQ((*chunk)->type(), ChunkDataType::TEMPORAL_1D_FIXED_POINT_F32);
+
+    float prev_element = 0.0f;
+    auto decoded = extractor.read_chunk(**chunk, prev_element);
+    ASSERT_TRUE(decoded.has_value()) << decoded.error().to_string();
+    const auto values = (*decoded)->get<float>();
+    ASSERT_TRUE(std::equal(values.begin(), values.end(), prices.begin(), prices.end()));
+    ASSERT_EQ(prev_element, prices.back());
+
+    // Off the grid: the chunk is written with the regular float codec and still round-trips.
+    auto off_grid = prices;
+    off_grid[10] = 1.0f / 3.0f;
+    auto fallback = compressor.compress_fixed_point(std::span<const float>(off_grid), ChunkDataType::TEMPORAL_1D_FIXED_POINT_F32, {&shape, 1}, tick);
+    ASSERT_TRUE(fallback.has_value()) << fallback.error().to_string();
+    ASSERT_EQ((*fallback)->type(), ChunkDataType::TEMPORAL_1D_SIMD_F32_XOR_SHUFFLE);
+    auto fallback_decoded = extractor.read_chunk(**fallback);
+    ASSERT_TRUE(fallback_decoded.has_value()) << fallback_decoded.error().to_string();
+    const auto fallback_values = (*fallback_decoded)->get<float>();
+    ASSERT_TRUE(std::equal(fallback_values.begin(), fallback_values.end(), off_grid.begin(), off_grid.end()));
+}
+
+TEST_F(FixedPointSimdCodecTest, DataCompressor_MultiFrame2D) {
+    DataCompressor compressor;
+    DataExtractor extractor;
+    const std::vector<double> ticks = {0.01, 0.5, 1e-8, 1.0};
+    const std::vector<double> scales = {100.0, 2.0, 1e8, 1.0};
+    const int64_t shape[] = {static_cast<int64_t>(kNumRows), static_cast<int64_t>(ticks.size())};
+
+    std::vector<double> data;
+    for (size_t c = 0; c < ticks.size(); ++c) {
+        const auto column = generate_ticks<double>(kNumRows, scales[c], static_cast<uint32_t>(10 + c));
+        data.insert(data.end(), column.begin(), column.end());
+    }
+    const std::vector<double> zero_row(ticks.size(), 0.0);
+
+    for (const bool on_grid : {true, false}) {
+        auto input = data;
+        if (!on_grid) input[kNumRows + 5] += 0.1;
+        auto chunk = compressor.compress_chunk_frames(std::as_bytes(std::span(input)), ChunkDataType::TEMPORAL_2D_FIXED_POINT_F64, shape,
+                                                      std::as_bytes(std::span(zero_row)), 4, ZstdCompressor::DEFAULT_COMPRESSION_LEVEL, ticks);
+        ASSERT_TRUE(chunk.has_value()) << chunk.error().to_string();
+        ASSERT_TRUE((*chunk)->has_flag(ChunkFlags::MULTI_FRAME));
+        ASSERT_EQ((*chunk)->type(), on_grid ? ChunkDataType::TEMPORAL_2D_FIXED_POINT_F64 : ChunkDataType::TEMPORAL_2D_SIMD_F64);
+
+        auto decoded = extractor.read_chunk(**chunk);
+        ASSERT_TRUE(decoded.has_value()) << decoded.error().to_string();
+        const auto values = (*decoded)->get<double>();
+        ASSERT_TRUE(std::equal(values.begin(), values.end(), input.begin(), input.end()));
+    }
+}
+
+TEST_F(FixedPointSimdCodecTest, Bounded_WithinRecordedBound) {
+    // Off-grid random walks of very different magnitudes, one bound per column.
+    const std::vector<double> bounds = {1e-4, 0.5, 1e-9};
+    std::mt19937 gen(20);
+    std::normal_distribution<double> step(0.0, 1.0);
+    std::vector<double> data;
+    for (size_t c = 0; c < bounds.size(); ++c) {
+        double value = 30'000.0 * static_cast<double>(c);
+        for (size_t i = 0; i < kNumRows; ++i) data.push_back(value += step(gen) * std::pow(10.0, -3.0 * static_cast<double>(c)));
+    }
+
+    auto encoded = codec.encode_bounded64(data, kNumRows, bounds, false, workspace);
+    ASSERT_TRUE(encoded.has_value()) << encoded.error();
+    ASSERT_TRUE(encoded->has_value());
+    ASSERT_FALSE((*encoded)->exact);
+    ASSERT_LT((*encoded)->payload.size(), data.size() * sizeof(double) / 2);
+
+    auto decoded = codec.decode_bounded64((*encoded)->payload, kNumRows, bounds.size());
+    ASSERT_TRUE(decoded.has_value()) << decoded.error();
+    auto recorded = FixedPointSimdCodec::max_abs_error((*encoded)->payload);
+    ASSERT_TRUE(recorded.has_value()) << recorded.error();
+    ASSERT_EQ(recorded->size(), bounds.size());
+    for (size_t c = 0; c < bounds.size(); ++c) {
+        double measured = 0.0;
+        for (size_t i = c * kNumRows; i < (c + 1) * kNumRows; ++i) measured = std::max(measured, std::abs((*decoded)[i] - data[i]));
+        // The recorded bound covers the rounding of the difference itself, so it may sit one ulp above.
+        EXPECT_LE((*recorded)[c], bounds[c]) << "column " << c;
+        EXPECT_GE((*recorded)[c], measured) << "column " << c;
+        EXPECT_LE((*recorded)[c], std::nextafter(measured, std::numeric_limits<double>::infinity())) << "column " << c;
+    }
+
+    // Relative to the largest magnitude of the column.
+    std::vector<float> sizes(kNumRows);
+    std::lognormal_distribution<float> size(0.0f, 2.0f);
+    for (auto& val : sizes) val = size(gen);
+    const double relative_bound[] = {1e-3};
+    auto relative = codec.encode_bounded32(sizes, kNumRows, relative_bound, true, workspace);
+    ASSERT_TRUE(relative.has_value() && relative->has_value());
+    auto relative_decoded = codec.decode_bounded32((*relative)->payload, kNumRows, 1);
+    ASSERT_TRUE(relative_decoded.has_value()) << relative_decoded.error();
+    const double tolerance = 1e-3 * *std::ranges::max_element(sizes);
+    for (size_t i = 0; i < kNumRows; ++i) {
+        ASSERT_LE(std::abs(static_cast<double>((*relative_decoded)[i]) - sizes[i]), tolerance) << "row " << i;
+    }
+}
+
+TEST_F(FixedPointSimdCodecTest, Bounded_ExactAndUnsupported) {
+    // Values already on the grid come back bit for bit, as does an all-zero column.
+    auto data = generate_ticks<double>(1000, 2.0, 21);
+    data.resize(2000, 0.0);
+    const double bounds[] = {0.25, 1e-3};
+    auto encoded = codec.encode_bounded64(data, 1000, bounds, false, workspace);
+    ASSERT_TRUE(encoded.has_value() && encoded->has_value());
+    ASSERT_TRUE((*encoded)->exact);
+    auto decoded = codec.decode_bounded64((*encoded)->payload, 1000, 2);
+    ASSERT_TRUE(decoded.has_value()) << decoded.error();
+    ASSERT_TRUE(std::equal(decoded->begin(), decoded->end(), data.begin(), data.end()));
+    ASSERT_FALSE(codec.decode_bounded64((*encoded)->payload, 1000, 1).has_value());
+
+    // Non-finite values and grids beyond 2^53 are reported as unsupported; invalid bounds are errors.
+    for (const double bad : {std::numeric_limits<double>::infinity(), std::nan(""), 1e300}) {
+        auto copy = data;
+        copy[7] = bad;
+        auto rejected = codec.encode_bounded64(copy, 1000, bounds, false, workspace);
+        ASSERT_TRUE(rejected.has_value()) << rejected.error();
+        ASSERT_FALSE(rejected->has_value()) << "Value " << bad << " was accepted.";
+    }
+    for (const double bad : {0.0, -1.0, std::nan("")}) {
+        const double bad_bounds[] = {bad, 1.0};
+        ASSERT_FALSE(codec.encode_bounded64(data, 1000, bad_bounds, false, workspace).has_value());
+    }
+}
+
+TEST_F(FixedPointSimdCodecTest, DataCompressor_QuantizedFlagsFallbackAndFrames) {
+    DataCompressor compressor;
+    DataExtractor extractor;
+    const std::vector<double> bounds = {1e-3};
+    constexpr size_t kColumns = 3;
+    const int64_t shape[] = {static_cast<int64_t>(kNumRows), kColumns};
+    std::mt19937 gen(22);
+    std::uniform_real_distribution<float> value(-100.0f, 100.0f);
+    std::vector<float> data(kNumRows * kColumns);
+    for (auto& val : data) val = value(gen);
+    const std::vector<float> zero_row(kColumns, 0.0f);
+
+    auto chunk = compressor.compress_quantized(std::span<const float>(data), ChunkDataType::TEMPORAL_2D_QUANTIZED_F32, shape, bounds, false);
+    ASSERT_TRUE(chunk.has_value()) << chunk.error().to_string();
+    ASSERT_EQ((*chunk)->type(), ChunkDataType::TEMPORAL_2D_QUANTIZED_F32);
+    ASSERT_TRUE((*chunk)->has_flag(ChunkFlags::RECONSTRUCTION_NOT_PERFECT));
+    ASSERT_TRUE((*chunk)->has_flag(ChunkFlags::RECONSTRUCTION_BOUNDED));
+
+    std::vector<float> last_row(kColumns, 0.0f);
+    auto decoded = extractor.read_chunk(**chunk, std::span<float>(last_row));
+    ASSERT_TRUE(decoded.has_value()) << decoded.error().to_string();
+    const auto values = (*decoded)->get<float>();
+    ASSERT_EQ(values.size(), data.size());
+    for (size_t i = 0; i < data.size(); ++i) ASSERT_LE(std::abs(static_cast<double>(values[i]) - data[i]), bounds[0]) << "element " << i;
+    for (size_t c = 0; c < kColumns; ++c) ASSERT_EQ(last_row[c], values[(c + 1) * kNumRows - 1]);
+
+    // Multi-frame chunks keep the lossy flags of their frames, and each frame honours the bound.
+    auto frames = compressor.compress_chunk_frames(std::as_bytes(std::span(data)), ChunkDataType::TEMPORAL_2D_QUANTIZED_F32, shape,
+                                                   std::as_bytes(std::span(zero_row)), 4, ZstdCompressor::DEFAULT_COMPRESSION_LEVEL, {}, bounds);
+    ASSERT_TRUE(frames.has_value()) << frames.error().to_string();
+    ASSERT_TRUE((*frames)->has_flag(ChunkFlags::MULTI_FRAME));
+    ASSERT_TRUE((*frames)->has_flag(ChunkFlags::RECONSTRUCTION_BOUNDED));
+    auto frames_decoded = extractor.read_chunk(**frames);
+    ASSERT_TRUE(frames_decoded.has_value()) << frames_decoded.error().to_string();
+    const auto frame_values = (*frames_decoded)->get<float>();
+    ASSERT_EQ(frame_values.size(), data.size());
+    for (size_t i = 0; i < data.size(); ++i) ASSERT_LE(std::abs(static_cast<double>(frame_values[i]) - data[i]), bounds[0]) << "element " << i;
+
+    // A NaN cannot be quantized: the chunk is stored losslessly with the float codec.
+    auto with_nan = data;
+    with_nan[123] = std::nanf("");
+    auto fallback = compressor.compress_quantized(std::span<const float>(with_nan), ChunkDataType::TEMPORAL_2D_QUANTIZED_F32, shape, bounds, false);
+    ASSERT_TRUE(fallback.has_value()) << fallback.error().to_string();
+    ASSERT_EQ((*fallback)->type(), ChunkDataType::TEMPORAL_2D_SIMD_F32);
+    ASSERT_FALSE((*fallback)->has_flag(ChunkFlags::RECONSTRUCTION_BOUNDED));
+
+    const std::vector<double> wrong_count = {1e-3, 1e-3};
+    ASSERT_FALSE(compressor.compress_quantized(std::span<const float>(data), ChunkDataType::TEMPORAL_2D_QUANTIZED_F32, shape, wrong_count, false).has_value());
+}
@@ -0,0 +1,192 @@
+#include "orderbook_bfp16_codec.h"
+#include "zstd_compressor.h"
+#include "../../src/data_io/data_compressor.h"
+#include "../../src/data_io/data_extractor.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace cryptodd;
+
+namespace {
+    constexpr size_t kDepth = 20;
+    constexpr size_t kFeatures = 3;
+    constexpr size_t kSnapshotFloats = kDepth * kFeatures;
+
+    // Snapshots of (price, size, count): prices a few ticks apart around a drifting mid near 65'000,
+    // sizes spread over several orders of magnitude, small integer counts.
+    std::vector<float> generate_book(const size_t num_snapshots, const uint32_t seed) {
+        std::mt19937 gen(seed);
+        std::normal_distribution<double> drift(0.0, 2.0);
+        std::lognormal_distribution<double> size(-3.0, 2.0);
+        std::uniform_int_distribution<int> count(1, 40);
+        std::vector<float> data(num_snapshots * kSnapshotFloats);
+        double mid = 65'000.0;
+        for (size_t s = 0; s < num_snapshots; ++s) {
+            mid += drift(gen);
+            for (size_t level = 0; level < kDepth; ++level) {
+                float* row = data.data() + s * kSnapshotFloats + level * kFeatures;
+                row[0] = static_cast<float>(mid + (static_cast<double>(level) - 10.0) * 0.1);
+                row[1] = static_cast<float>(size(gen));
+                row[2] = static_cast<float>(count(gen));
+            }
+        }
+        return data;
+    }
+
+    // The documented per-group bound, checked independently of the bounds the encoder records.
+    void expect_within_bound(std::span<const float> original, std::span<const float> decoded) {
+        ASSERT_EQ(original.size(), decoded.size());
+        for (size_t s = 0; s < original.size() / kSnapshotFloats; ++s) {
+            for (size_t f = 0; f < kFeatures; ++f) {
+                float lo = std::numeric_limits<float>::max();
+                float hi = std::numeric_limits<float>::lowest();
+                for (size_t level = 0; level < kDepth; ++level) {
+                    lo = std::min(lo, original[s * kSnapshotFloats + level * kFeatures + f]);
+                    hi = std::max(hi, original[s * kSnapshotFloats + level * kFeatures + f]);
+                }
+                const double span = static_cast<double>(hi) - lo;
+                for (size_t level = 0; level < kDepth; ++level) {
+                    const size_t i = s * kSnapshotFloats + level * kFeatures + f;
+                    const double ulp = std::nextafter(std::abs(decoded[i]), std::numeric_limits<float>::infinity()) - std::abs(decoded[i]);
+                    ASSERT_LE(std::abs(static_cast<double>(decoded[i]) - original[i]), (std::ldexp(1.0, -11) + std::ldexp(1.0, -24)) * span + ulp / 2)
+                        << "snapshot " << s << ", level " << level << ", feature " << f;
+                }
+            }
+        }
+    }
+}
+
+class OrderbookBfp16CodecTest : public ::testing::Test {
+protected:
+    static constexpr size_t kNumSnapshots = 1000;
+
+    OrderbookBfp16Codec codec{std::make_unique<ZstdCompressor>()};
+    OrderbookBfp16CodecWorkspace workspace;
+};
+
+TEST_F(OrderbookBfp16CodecTest, RoundTripWithinRecordedBound) {
+    const auto data = generate_book(kNumSnapshots, 1);
+    auto encoded = codec.encode(data, kDepth, kFeatures, workspace);
+    ASSERT_TRUE(encoded.has_value()) << encoded.error();
+    ASSERT_TRUE(encoded->has_value());
+    ASSERT_FALSE((*encoded)->exact);
+    ASSERT_LT((*encoded)->payload.size(), data.size() * sizeof(float) / 2);
+
+    auto decoded = codec.decode((*encoded)->payload, kNumSnapshots, kDepth, kFeatures);
+    ASSERT_TRUE(decoded.has_value()) << decoded.error();
+    expect_within_bound(data, *decoded);
+
+    auto bounds = OrderbookBfp16Codec::max_abs_error((*encoded)->payload);
+    ASSERT_TRUE(bounds.has_value()) << bounds.error();
+    ASSERT_EQ(bounds->size(), kFeatures);
+    std::vector<double> measured(kFeatures, 0.0);
+    for (size_t i = 0; i < data.size(); ++i) {
+        measured[i % kFeatures] = std::max(measured[i % kFeatures], std::abs(static_cast<double>((*decoded)[i]) - data[i]));
+    }
+    for (size_t f = 0; f < kFeatures; ++f) {
+        EXPECT_EQ((*bounds)[f], measured[f]) << "feature " << f;
+    }
+    // Prices within a few ticks of their reference and small counts fit in 11 bits, so they come back exact;
+    // demoting the prices themselves to f16 would round them to the nearest 32. Sizes span too many orders of
+    // magnitude per snapshot and are the lossy feature.
+    EXPECT_EQ((*bounds)[0], 0.0);
+    EXPECT_GT((*bounds)[1], 0.0);
+    EXPECT_EQ((*bounds)[2], 0.0);
+}
+
+TEST_F(OrderbookBfp16CodecTest, ExactWhenResidualsFit) {
+    // Prices on a 0.5 tick, spanning 40 ticks: every residual fits in 11 significant bits.
+    auto data = generate_book(100, 2);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = std::round(data[i] * 2.0f) / 2.0f;
+        if (i % kFeatures == 1) data[i] = static_cast<float>(i % 7);
+    }
+    auto encoded = codec.encode(data, kDepth, kFeatures, workspace);
+    ASSERT_TRUE(encoded.has_value() && encoded->has_value());
+    ASSERT_TRUE((*encoded)->exact);
+
+    auto decoded = codec.decode((*encoded)->payload, 100, kDepth, kFeatures);
+    ASSERT_TRUE(decoded.has_value()) << decoded.error();
+    ASSERT_TRUE(std::equal(decoded->begin(), decoded->end(), data.begin(), data.end()));
+}
+
+TEST_F(OrderbookBfp16CodecTest, ExtremeRangesAndNonFinite) {
+    auto data = generate_book(10, 3);
+    data[5 * kSnapshotFloats + 1] = 3e38f;
+    data[5 * kSnapshotFloats + 4] = 1e-40f;
+    data[6 * kSnapshotFloats + 1] = 1e-30f;
+    auto encoded = codec.encode(data, kDepth, kFeatures, workspace);
+    ASSERT_TRUE(encoded.has_value() && encoded->has_value());
+    auto decoded = codec.decode((*encoded)->payload, 10, kDepth, kFeatures);
+    ASSERT_TRUE(decoded.has_value()) << decoded.error();
+    expect_within_bound(data, *decoded);
+
+    // Non-finite values are reported as unsupported.
+    for (const float bad : {std::numeric_limits<float>::infinity(), std::nanf("")}) {
+        auto copy = data;
+        copy[5 * kSnapshotFloats + 7] = bad;
+        auto rejected = codec.encode(copy, kDepth, kFeatures, workspace);
+        ASSERT_TRUE(rejected.has_value()) << rejected.error();
+        ASSERT_FALSE(rejected->has_value()) << "Value " << bad << " was accepted.";
+    }
+    // So is a group with nothing near the middle of a range overflowing float: every residual would overflow.
+    auto split = data;
+    for (size_t level = 1; level < kDepth; ++level) split[5 * kSnapshotFloats + level * kFeatures + 1] = -3e38f;
+    auto rejected = codec.encode(split, kDepth, kFeatures, workspace);
+    ASSERT_TRUE(rejected.has_value()) << rejected.error();
+    ASSERT_FALSE(rejected->has_value());
+}
+
+TEST_F(OrderbookBfp16CodecTest, RejectsCorruptedPayload) {
+    const auto data = generate_book(50, 4);
+    auto encoded = codec.encode(data, kDepth, kFeatures, workspace);
+    ASSERT_TRUE(encoded.has_value() && encoded->has_value());
+    const auto& payload = (*encoded)->payload;
+
+    ASSERT_FALSE(codec.decode(payload, 50, kDepth, kFeatures + 1).has_value());
+    ASSERT_FALSE(codec.decode(payload, 51, kDepth, kFeatures).has_value());
+    ASSERT_FALSE(codec.decode(std::span(payload).first(4), 50, kDepth, kFeatures).has_value());
+}
+
+TEST_F(OrderbookBfp16CodecTest, DataCompressor_FlagsFallbackAndFrames) {
+    DataCompressor compressor;
+    DataExtractor extractor;
+    const auto data = generate_book(kNumSnapshots, 5);
+    const int64_t shape[] = {static_cast<int64_t>(kNumSnapshots), kDepth, kFeatures};
+    const std::vector<float> zero_state(kSnapshotFloats, 0.0f);
+
+    auto chunk = compressor.compress_chunk(std::span<const float>(data), ChunkDataType::GENERIC_OB_SIMD_BFP16_AS_F32, shape, zero_state);
+    ASSERT_TRUE(chunk.has_value()) << chunk.error().to_string();
+    ASSERT_EQ((*chunk)->type(), ChunkDataType::GENERIC_OB_SIMD_BFP16_AS_F32);
+    ASSERT_TRUE((*chunk)->has_flag(ChunkFlags::RECONSTRUCTION_NOT_PERFECT));
+    ASSERT_TRUE((*chunk)->has_flag(ChunkFlags::RECONSTRUCTION_BOUNDED));
+
+    std::vector<float> last_snapshot(kSnapshotFloats, 0.0f);
+    auto decoded = extractor.read_chunk(**chunk, last_snapshot);
+    ASSERT_TRUE(decoded.has_value()) << decoded.error().to_string();
+    const auto values = (*decoded)->get<float>();
+    expect_within_bound(data, values);
+    ASSERT_TRUE(std::equal(last_snapshot.begin(), last_snapshot.end(), values.end() - kSnapshotFloats));
+
+    // Multi-frame chunks keep the lossy flags of their frames.
+    auto frames = compressor.compress_chunk_frames(std::as_bytes(std::span(data)), ChunkDataType::GENERIC_OB_SIMD_BFP16_AS_F32, shape,
+                                                   std::as_bytes(std::span(zero_state)), 4);
+    ASSERT_TRUE(frames.has_value()) << frames.error().to_string();
+    ASSERT_TRUE((*frames)->has_flag(ChunkFlags::MULTI_FRAME));
+    ASSERT_TRUE((*frames)->has_flag(ChunkFlags::RECONSTRUCTION_BOUNDED));
+    auto frames_decoded = extractor.read_chunk(**frames);
+    ASSERT_TRUE(frames_decoded.has_value()) << frames_decoded.error().to_string();
+    const auto frame_values = (*frames_decoded)->get<float>();
+    ASSERT_TRUE(std::equal(frame_values.begin(), frame_values.end(), values.begin(), values.end()));
+
+    // A NaN cannot be represented: the chunk is stored losslessly with the float codec.
+    auto with_nan = data;
+    with_nan[123] = std::nanf("");
+    auto fallback = compressor.compress_chunk(std::span<const float>(with_nan), ChunkDataType::GENERIC_OB_SIMD_BFP16_AS_F32, shape, zero_state);
+    ASSERT_TRUE(fallback.has_value()) << fallback.error().to_string();
+    ASSERT_EQ((*fallback)->type(), ChunkDataType::GENERIC_OB_SIMD_F32);
+    ASSERT_FALSE((*fallback)->has_flag(ChunkFlags::RECONSTRUCTION_BOUNDED));
+}
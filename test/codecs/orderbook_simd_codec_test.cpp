@@ -162,4 +162,88 @@ std::make_unique<cryptodd::ZstdCompressor>());    cryptodd::OrderbookSimdCodecWo
     for (size_t i = 0; i < OkxCodec::SnapshotFloats; ++i) {
         ASSERT_EQ(last_original_snapshot_ptr[i], decoder_prev_snapshot[i]);
     }
-}
\ No newline at end of file
+}
+
+TEST(OrderbookSimdFusedKernelTest, FusedEncodeMatchesTwoPassReference)
+{
+    // Odd snapshot widths exercise the scalar remainder of both the fused and reference kernels.
+    for (const size_t snapshot_floats : {size_t{1}, size_t{7}, size_t{37}, OkxCodec::SnapshotFloats}) {
+        constexpr size_t num_snapshots = 5;
+        const size_t num_floats = num_snapshots * snapshot_floats;
+        std::mt19937 gen(static_cast<unsigned>(snapshot_floats));
+        std::uniform_real_distribution<float> dis(-1000.0f, 1000.0f);
+        std::vector<float> snapshots(num_floats);
+        std::vector<float> prev_snapshot(snapshot_floats);
+        for (float& v : snapshots) v = dis(gen);
+        for (float& v : prev_snapshot) v = dis(gen);
+
+        std::vector<hwy::float16_t> f16_deltas(num_floats);
+        std::vector<uint8_t> reference16(num_floats * sizeof(hwy::float16_t));
+        std::vector<uint8_t> fused16(reference16.size());
+        for (size_t s = 0; s < num_snapshots; ++s) {
+            const float* prev = s == 0 ? prev_snapshot.data() : snapshots.data() + (s - 1) * snapshot_floats;
+            simd::DemoteAndXor_dispatcher(snapshots.data() + s * snapshot_floats, prev, f16_deltas.data() + s * snapshot_floats, snapshot_floats);
+        }
+        simd::ShuffleFloat16_dispatcher(f16_deltas.data(), reference16.data(), num_floats);
+        simd::DemoteXorShuffle16_dispatcher(snapshots.data(), prev_snapshot.data(), fused16.data(), num_snapshots, snapshot_floats);
+        ASSERT_EQ(reference16, fused16) << "snapshot_floats=" << snapshot_floats;
+
+        std::vector<float> f32_deltas(num_floats);
+        std::vector<uint8_t> reference32(num_floats * sizeof(float));
+        std::vector<uint8_t> fused32(reference32.size());
+        for (size_t s = 0; s < num_snapshots; ++s) {
+            const float* prev = s == 0 ? prev_snapshot.data() : snapshots.data() + (s - 1) * snapshot_floats;
+            simd::XorFloat32_dispatcher(snapshots.data() + s * snapshot_floats, prev, f32_deltas.data() + s * snapshot_floats, snapshot_floats);
+        }
+        simd::ShuffleFloat32_dispatcher(f32_deltas.data(), reference32.data(), num_floats);
+        simd::XorShuffleFloat32_dispatcher(snapshots.data(), prev_snapshot.data(), fused32.data(), num_snapshots, snapshot_floats);
+        ASSERT_EQ(reference32, fused32) << "snapshot_floats=" << snapshot_floats;
+    }
+}
+
+TEST(OrderbookSimdBlockedLayoutTest, BlockedRoundTripMatchesGlobal)
+{
+    OkxCodec codec(std::make_unique<cryptodd::ZstdCompressor>());
+    cryptodd::OrderbookSimdCodecWorkspace workspace;
+
+    // Several full row blocks plus a partial one, so state must carry across block boundaries.
+    const size_t rows_per_block = codecs::ShuffleBlock::rows_per_block(OkxCodec::SnapshotFloats * sizeof(float));
+    const size_t num_snapshots = rows_per_block * 3 + 7;
+    const auto original = generate_random_snapshots(num_snapshots);
+    OkxCodec::Snapshot initial_prev{};
+    std::iota(initial_prev.begin(), initial_prev.end(), 0.5f);
+
+    // Float32 is lossless in both layouts.
+    auto encoded32 = codec.encode32(original, initial_prev, workspace, codecs::ShuffleLayout::Blocked);
+    ASSERT_TRUE(encoded32.has_value()) << encoded32.error();
+    OkxCodec::Snapshot prev32 = initial_prev;
+    auto decoded32 = codec.decode32(*encoded32, num_snapshots, prev32, codecs::ShuffleLayout::Blocked);
+    ASSERT_TRUE(decoded32.has_value()) << decoded32.error();
+    ASSERT_EQ(decoded32->size(), original.size());
+    for (size_t i = 0; i < original.size(); ++i) {
+        ASSERT_EQ(original[i], (*decoded32)[i]) << "at " << i;
+    }
+    for (size_t i = 0; i < OkxCodec::SnapshotFloats; ++i) {
+        ASSERT_EQ(original[(num_snapshots - 1) * OkxCodec::SnapshotFloats + i], prev32[i]);
+    }
+
+    // Float16 is lossy, but blocked and global decodes must agree bit for bit.
+    auto global16 = codec.encode16(original, initial_prev, workspace, codecs::ShuffleLayout::Global);
+    auto blocked16 = codec.encode16(original, initial_prev, workspace, codecs::ShuffleLayout::Blocked);
+    ASSERT_TRUE(global16.has_value() && blocked16.has_value());
+    OkxCodec::Snapshot global_prev = initial_prev;
+    OkxCodec::Snapshot blocked_prev = initial_prev;
+    auto global_decoded = codec.decode16(*global16, num_snapshots, global_prev, codecs::ShuffleLayout::Global);
+    auto blocked_decoded = codec.decode16(*blocked16, num_snapshots, blocked_prev, codecs::ShuffleLayout::Blocked);
+    ASSERT_TRUE(global_decoded.has_value()) << global_decoded.error();
+    ASSERT_TRUE(blocked_decoded.has_value()) << blocked_decoded.error();
+    ASSERT_EQ(global_decoded->size(), blocked_decoded->size());
+    for (size_t i = 0; i < global_decoded->size(); ++i) {
+        ASSERT_EQ((*global_decoded)[i], (*blocked_decoded)[i]) << "at " << i;
+    }
+    ASSERT_EQ(global_prev, blocked_prev);
+
+    // A blocked chunk decoded with the wrong snapshot count is rejected rather than overrunning the output.
+    OkxCodec::Snapshot bad_prev = initial_prev;
+    ASSERT_FALSE(codec.decode32(*encoded32, num_snapshots - 1, bad_prev, codecs::ShuffleLayout::Blocked).has_value());
+}
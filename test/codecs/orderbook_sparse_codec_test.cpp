@@ -0,0 +1,139 @@
+#include "orderbook_sparse_codec.h"
+#include "zstd_compressor.h"
+#include "../../src/data_io/data_compressor.h"
+#include "../../src/data_io/data_extractor.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace cryptodd;
+
+namespace {
+    constexpr size_t kDepth = 256;
+    constexpr size_t kFeatures = 3;
+    constexpr size_t kSnapshotFloats = kDepth * kFeatures;
+
+    // A deep book where each update touches `changes_per_snapshot` random floats.
+    std::vector<float> generate_book(const size_t num_snapshots, const size_t snapshot_floats, const size_t changes_per_snapshot, const uint32_t seed) {
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<size_t> pick(0, snapshot_floats - 1);
+        std::lognormal_distribution<float> size(-3.0f, 2.0f);
+        std::vector<float> data(num_snapshots * snapshot_floats);
+        for (size_t i = 0; i < snapshot_floats; ++i) data[i] = size(gen);
+        for (size_t s = 1; s < num_snapshots; ++s) {
+            std::copy_n(data.begin() + (s - 1) * snapshot_floats, snapshot_floats, data.begin() + s * snapshot_floats);
+            for (size_t c = 0; c < changes_per_snapshot; ++c) data[s * snapshot_floats + pick(gen)] = size(gen);
+        }
+        return data;
+    }
+}
+
+class OrderbookSparseCodecTest : public ::testing::Test {
+protected:
+    static constexpr size_t kNumSnapshots = 1000;
+
+    OrderbookSparseCodec codec{std::make_unique<ZstdCompressor>()};
+    OrderbookSparseCodecWorkspace workspace;
+};
+
+TEST_F(OrderbookSparseCodecTest, RoundTripSparseBook) {
+    const auto data = generate_book(kNumSnapshots, kSnapshotFloats, 4, 1);
+    const std::vector<float> zero_state(kSnapshotFloats, 0.0f);
+    auto encoded = codec.encode(data, zero_state, workspace);
+    ASSERT_TRUE(encoded.has_value()) << encoded.error();
+    ASSERT_TRUE(encoded->has_value()) << "A sparse book was reported as too dense.";
+    // About one bit per float plus the few changed values.
+    ASSERT_LT((*encoded)->size(), data.size() / 4);
+
+    std::vector<float> state(kSnapshotFloats, 0.0f);
+    auto decoded = codec.decode(**encoded, kNumSnapshots, state);
+    ASSERT_TRUE(decoded.has_value()) << decoded.error();
+    ASSERT_TRUE(std::equal(decoded->begin(), decoded->end(), data.begin(), data.end()));
+    ASSERT_TRUE(std::equal(state.begin(), state.end(), data.end() - kSnapshotFloats));
+}
+
+TEST_F(OrderbookSparseCodecTest, BitwiseChangesAndOddSnapshotSize) {
+    // 7 x 3 floats: bitmaps end in a partial byte and the SIMD loop leaves a tail.
+    constexpr size_t kOddFloats = 21;
+    auto data = generate_book(50, kOddFloats, 2, 2);
+    std::vector<float> prev(kOddFloats, 1.0f);
+    // Equal as floats but not bitwise: both must be recorded as changes.
+    data[3] = -0.0f;
+    data[kOddFloats + 3] = 0.0f;
+    uint32_t nan_bits = 0x7FC00001;
+    std::memcpy(&data[5 * kOddFloats + 20], &nan_bits, sizeof(nan_bits));
+    nan_bits = 0x7FC00002;
+    std::memcpy(&data[6 * kOddFloats + 20], &nan_bits, sizeof(nan_bits));
+
+    auto encoded = OrderbookSparseCodec(std::make_unique<ZstdCompressor>(), 1.0).encode(data, prev, workspace);
+    ASSERT_TRUE(encoded.has_value() && encoded->has_value());
+    auto decoded = codec.decode(**encoded, 50, prev);
+    ASSERT_TRUE(decoded.has_value()) << decoded.error();
+    ASSERT_EQ(std::memcmp(decoded->data(), data.data(), data.size() * sizeof(float)), 0);
+}
+
+TEST_F(OrderbookSparseCodecTest, HighChurnIsReported) {
+    const std::vector<float> zero_state(kSnapshotFloats, 0.0f);
+    const auto busy = generate_book(100, kSnapshotFloats, kSnapshotFloats, 3);
+    auto encoded = codec.encode(busy, zero_state, workspace);
+    ASSERT_TRUE(encoded.has_value()) << encoded.error();
+    ASSERT_FALSE(encoded->has_value());
+
+    // The same chunk is accepted once the threshold allows it.
+    auto accepted = OrderbookSparseCodec(std::make_unique<ZstdCompressor>(), 1.0).encode(busy, zero_state, workspace);
+    ASSERT_TRUE(accepted.has_value() && accepted->has_value());
+}
+
+TEST_F(OrderbookSparseCodecTest, RejectsCorruptedPayload) {
+    const auto data = generate_book(50, kSnapshotFloats, 4, 4);
+    std::vector<float> state(kSnapshotFloats, 0.0f);
+    auto encoded = codec.encode(data, state, workspace);
+    ASSERT_TRUE(encoded.has_value() && encoded->has_value());
+
+    ASSERT_FALSE(codec.decode(**encoded, 51, state).has_value());
+    std::vector<float> wrong_state(kSnapshotFloats - 1, 0.0f);
+    ASSERT_FALSE(codec.decode(**encoded, 50, wrong_state).has_value());
+    auto bad_count = **encoded;
+    const uint32_t num_changed = 1;
+    std::memcpy(bad_count.data(), &num_changed, sizeof(num_changed));
+    ASSERT_FALSE(codec.decode(bad_count, 50, state).has_value());
+}
+
+TEST_F(OrderbookSparseCodecTest, DataCompressor_FallbackAndFrames) {
+    DataCompressor compressor;
+    DataExtractor extractor;
+    const auto data = generate_book(kNumSnapshots, kSnapshotFloats, 4, 5);
+    const int64_t shape[] = {static_cast<int64_t>(kNumSnapshots), kDepth, kFeatures};
+    const std::vector<float> zero_state(kSnapshotFloats, 0.0f);
+
+    auto chunk = compressor.compress_chunk(std::span<const float>(data), ChunkDataType::GENERIC_OB_SIMD_SPARSE_F32, shape, zero_state);
+    ASSERT_TRUE(chunk.has_value()) << chunk.error().to_string();
+    ASSERT_EQ((*chunk)->type(), ChunkDataType::GENERIC_OB_SIMD_SPARSE_F32);
+
+    std::vector<float> last_snapshot(kSnapshotFloats, 0.0f);
+    auto decoded = extractor.read_chunk(**chunk, last_snapshot);
+    ASSERT_TRUE(decoded.has_value()) << decoded.error().to_string();
+    const auto values = (*decoded)->get<float>();
+    ASSERT_TRUE(std::equal(values.begin(), values.end(), data.begin(), data.end()));
+    ASSERT_TRUE(std::equal(last_snapshot.begin(), last_snapshot.end(), data.end() - kSnapshotFloats));
+
+    // Each frame after the first is encoded against the last snapshot of the previous one.
+    auto frames = compressor.compress_chunk_frames(std::as_bytes(std::span(data)), ChunkDataType::GENERIC_OB_SIMD_SPARSE_F32, shape,
+                                                   std::as_bytes(std::span(zero_state)), 4);
+    ASSERT_TRUE(frames.has_value()) << frames.error().to_string();
+    ASSERT_EQ((*frames)->type(), ChunkDataType::GENERIC_OB_SIMD_SPARSE_F32);
+    auto frames_decoded = extractor.read_chunk(**frames);
+    ASSERT_TRUE(frames_decoded.has_value()) << frames_decoded.error().to_string();
+    const auto frame_values = (*frames_decoded)->get<float>();
+    ASSERT_TRUE(std::equal(frame_values.begin(), frame_values.end(), data.begin(), data.end()));
+
+    // A chunk where every level moves is stored with the dense codec.
+    const auto busy = generate_book(100, kSnapshotFloats, kSnapshotFloats, 6);
+    const int64_t busy_shape[] = {100, kDepth, kFeatures};
+    auto fallback = compressor.compress_chunk(std::span<const float>(busy), ChunkDataType::GENERIC_OB_SIMD_SPARSE_F32, busy_shape, zero_state);
+    ASSERT_TRUE(fallback.has_value()) << fallback.error().to_string();
+    ASSERT_EQ((*fallback)->type(), ChunkDataType::GENERIC_OB_SIMD_F32);
+}
@@ -1,6 +1,7 @@
 #include "temporal_1d_simd_codec.h"
 #include "zstd_compressor.h"
 #include <gtest/gtest.h>
+#include <limits>
 #include <numeric>
 #include <random>
 #include <vector>
@@ -97,6 +98,41 @@ TEST_F(Temporal1dSimdCodecTest, FullPipeline_Float32_Xor_Shuffle) {
     ASSERT_EQ(original_float_data.back(), decoder_prev_element);
 }
 
+TEST_F(Temporal1dSimdCodecTest, FullPipeline_Float64_Xor_Shuffle) {
+    Codec1D codec(std::make_unique<cryptodd::ZstdCompressor>());
+    cryptodd::Temporal1dSimdCodecWorkspace workspace;
+
+    // Ragged length so the SIMD kernels also run their scalar tail.
+    const auto original = generate_random_1d_data<double>(kNumElements + 37);
+    const double initial_prev = 123.456789;
+
+    for (const auto layout : {codecs::ShuffleLayout::Global, codecs::ShuffleLayout::Blocked}) {
+        double encoder_prev = initial_prev;
+        double decoder_prev = initial_prev;
+
+        // Two chained chunks: the second one must pick up the state left by the first.
+        for (size_t part = 0; part < 2; ++part) {
+            auto encoded_result = codec.encode64_Xor_Shuffle(original, encoder_prev, workspace, layout);
+            ASSERT_TRUE(encoded_result.has_value()) << encoded_result.error();
+            ASSERT_FALSE(encoded_result->empty());
+
+            auto decoded_result = codec.decode64_Xor_Shuffle(*encoded_result, original.size(), decoder_prev, layout);
+            ASSERT_TRUE(decoded_result.has_value()) << decoded_result.error();
+            auto& decoded_data = *decoded_result;
+
+            // Verify data (lossless)
+            ASSERT_EQ(decoded_data.size(), original.size());
+            for (size_t i = 0; i < original.size(); ++i) {
+                ASSERT_EQ(original[i], decoded_data[i]) << "part " << part << ", index " << i;
+            }
+
+            // Verify final state
+            encoder_prev = original.back();
+            ASSERT_EQ(encoder_prev, decoder_prev);
+        }
+    }
+}
+
 TEST_F(Temporal1dSimdCodecTest, FullPipeline_Int64_Xor) {
     Codec1D codec(std::make_unique<cryptodd::ZstdCompressor>());
     cryptodd::Temporal1dSimdCodecWorkspace workspace;
@@ -149,4 +185,94 @@ TEST_F(Temporal1dSimdCodecTest, FullPipeline_Int64_Delta) {
 
     // Verify final state
     ASSERT_EQ(original_int64_data.back(), decoder_prev_element);
-}
\ No newline at end of file
+}
+
+TEST_F(Temporal1dSimdCodecTest, FullPipeline_Int64_DoubleDelta) {
+    Codec1D codec(std::make_unique<cryptodd::ZstdCompressor>());
+    cryptodd::Temporal1dSimdCodecWorkspace workspace;
+
+    // Near-constant 100ms ticks with jitter, chained over several odd-sized chunks to cover every remainder path.
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int64_t> jitter(-2, 2);
+    memory::vector<int64_t> timestamps(kNumElements + 5);
+    int64_t ts = 1'700'000'000'000;
+    for (auto& val : timestamps) {
+        ts += 100 + jitter(gen);
+        val = ts;
+    }
+    timestamps[42] = std::numeric_limits<int64_t>::min(); // Wrapping second differences must still round-trip
+    timestamps[43] = std::numeric_limits<int64_t>::max();
+
+    int64_t encoder_prev_element = initial_prev_element_int64;
+    int64_t decoder_prev_element = initial_prev_element_int64;
+    const std::span<const int64_t> all(timestamps);
+    for (size_t offset = 0; offset < all.size();) {
+        const auto part = all.subspan(offset, std::min<size_t>(all.size() - offset, offset == 0 ? 1 : 4099));
+        auto encoded_result = codec.encode64_DoubleDelta(part, encoder_prev_element, workspace);
+        ASSERT_TRUE(encoded_result.has_value()) << encoded_result.error();
+        encoder_prev_element = part.back();
+
+        auto decoded_result = codec.decode64_DoubleDelta(*encoded_result, part.size(), decoder_prev_element);
+        ASSERT_TRUE(decoded_result.has_value()) << decoded_result.error();
+        ASSERT_TRUE(std::equal(decoded_result->begin(), decoded_result->end(), part.begin(), part.end()));
+        ASSERT_EQ(decoder_prev_element, part.back());
+        offset += part.size();
+    }
+}
+
+TEST_F(Temporal1dSimdCodecTest, FusedEncodeMatchesTwoPassReference) {
+    // Sizes around the vector width exercise the first-element and scalar remainder paths.
+    for (const size_t n : {size_t{1}, size_t{2}, size_t{15}, size_t{33}, size_t{1027}}) {
+        const float* data = original_float_data.data();
+
+        std::vector<hwy::float16_t> f16_deltas(n);
+        std::vector<uint8_t> reference16(n * sizeof(hwy::float16_t));
+        std::vector<uint8_t> fused16(reference16.size());
+        simd::DemoteAndXor1D_dispatcher(data, f16_deltas.data(), n, initial_prev_element_float);
+        simd::ShuffleFloat16_1D_dispatcher(f16_deltas.data(), reference16.data(), n);
+        simd::DemoteXorShuffle16_1D_dispatcher(data, fused16.data(), n, initial_prev_element_float);
+        ASSERT_EQ(reference16, fused16) << "n=" << n;
+
+        std::vector<float> f32_deltas(n);
+        std::vector<uint8_t> reference32(n * sizeof(float));
+        std::vector<uint8_t> fused32(reference32.size());
+        simd::XorFloat32_1D_dispatcher(data, f32_deltas.data(), n, initial_prev_element_float);
+        simd::ShuffleFloat32_1D_dispatcher(f32_deltas.data(), reference32.data(), n);
+        simd::XorShuffleFloat32_1D_dispatcher(data, fused32.data(), n, initial_prev_element_float);
+        ASSERT_EQ(reference32, fused32) << "n=" << n;
+    }
+}
+
+TEST_F(Temporal1dSimdCodecTest, BlockedLayoutRoundTripMatchesGlobal) {
+    Codec1D codec(std::make_unique<cryptodd::ZstdCompressor>());
+    cryptodd::Temporal1dSimdCodecWorkspace workspace;
+
+    // Spans several f16 and f32 blocks with a ragged tail.
+    const size_t n = codecs::ShuffleBlock::rows_per_block(sizeof(hwy::float16_t)) * 2 + 1234;
+    const auto data = generate_random_1d_data<float>(n);
+
+    auto blocked32 = codec.encode32_Xor_Shuffle(data, initial_prev_element_float, workspace, codecs::ShuffleLayout::Blocked);
+    ASSERT_TRUE(blocked32.has_value()) << blocked32.error();
+    float prev32 = initial_prev_element_float;
+    auto decoded32 = codec.decode32_Xor_Shuffle(*blocked32, n, prev32, codecs::ShuffleLayout::Blocked);
+    ASSERT_TRUE(decoded32.has_value()) << decoded32.error();
+    ASSERT_EQ(decoded32->size(), n);
+    for (size_t i = 0; i < n; ++i) {
+        ASSERT_EQ(data[i], (*decoded32)[i]) << "at " << i;
+    }
+    ASSERT_EQ(data.back(), prev32);
+
+    auto global16 = codec.encode16_Xor_Shuffle(data, initial_prev_element_float, workspace, codecs::ShuffleLayout::Global);
+    auto blocked16 = codec.encode16_Xor_Shuffle(data, initial_prev_element_float, workspace, codecs::ShuffleLayout::Blocked);
+    ASSERT_TRUE(global16.has_value() && blocked16.has_value());
+    float global_prev = initial_prev_element_float;
+    float blocked_prev = initial_prev_element_float;
+    auto global_decoded = codec.decode16_Xor_Shuffle(*global16, n, global_prev, codecs::ShuffleLayout::Global);
+    auto blocked_decoded = codec.decode16_Xor_Shuffle(*blocked16, n, blocked_prev, codecs::ShuffleLayout::Blocked);
+    ASSERT_TRUE(global_decoded.has_value()) << global_decoded.error();
+    ASSERT_TRUE(blocked_decoded.has_value()) << blocked_decoded.error();
+    for (size_t i = 0; i < n; ++i) {
+        ASSERT_EQ((*global_decoded)[i], (*blocked_decoded)[i]) << "at " << i;
+    }
+    ASSERT_EQ(global_prev, blocked_prev);
+}
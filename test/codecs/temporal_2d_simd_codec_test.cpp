@@ -3,6 +3,7 @@
 #include <gtest/gtest.h>
 #include <numeric>
 #include <random>
+#include <utility>
 #include <vector>
 
 using StaticCodec = cryptodd::Temporal2dSimdCodec<8>;
@@ -169,4 +170,179 @@ TEST_F(Temporal2dSimdCodecTest, Dynamic_FullPipelineRoundTrip_Float32) {
         const float last_original_val = original_float_data[(f * kNumRows) + kNumRows - 1];
         ASSERT_EQ(last_original_val, decoder_prev_row[f]);
     }
-}
\ No newline at end of file
+}
+
+TEST_F(Temporal2dSimdCodecTest, Dynamic_FullPipelineRoundTrip_Float64) {
+    constexpr size_t kFeatures = StaticCodec::kNumFeatures;
+    DynamicCodec codec(kFeatures, std::make_unique<cryptodd::ZstdCompressor>());
+    cryptodd::Temporal2dSimdCodecWorkspace workspace;
+
+    // Spans several shuffle blocks with a ragged tail.
+    const size_t num_rows = codecs::ShuffleBlock::rows_per_block(kFeatures * sizeof(double)) * 2 + 13;
+    const auto data = generate_random_soa_data<double>(num_rows, kFeatures);
+
+    for (const auto layout : {codecs::ShuffleLayout::Global, codecs::ShuffleLayout::Blocked}) {
+        memory::vector<double> encoder_prev_row(kFeatures);
+        std::iota(encoder_prev_row.begin(), encoder_prev_row.end(), 0.25);
+        memory::vector<double> decoder_prev_row = encoder_prev_row;
+
+        // Two chained chunks: the second one must pick up the state left by the first.
+        for (size_t part = 0; part < 2; ++part) {
+            auto encoded_result = codec.encode64_Xor_Shuffle(data, encoder_prev_row, workspace, layout);
+            ASSERT_TRUE(encoded_result.has_value()) << encoded_result.error();
+            ASSERT_FALSE(encoded_result->empty());
+
+            auto decoded_result = codec.decode64_Xor_Shuffle(*encoded_result, decoder_prev_row, layout);
+            ASSERT_TRUE(decoded_result.has_value()) << decoded_result.error();
+            auto& decoded_data = *decoded_result;
+
+            // Verify data (lossless)
+            ASSERT_EQ(decoded_data.size(), data.size());
+            for (size_t i = 0; i < data.size(); ++i) {
+                ASSERT_EQ(data[i], decoded_data[i]) << "part " << part << ", index " << i;
+            }
+
+            // Verify final state
+            for (size_t f = 0; f < kFeatures; ++f) {
+                encoder_prev_row[f] = data[(f * num_rows) + num_rows - 1];
+                ASSERT_EQ(encoder_prev_row[f], decoder_prev_row[f]);
+            }
+        }
+    }
+}
+
+TEST_F(Temporal2dSimdCodecTest, Dynamic_FullPipelineRoundTrip_Int64_DoubleDelta) {
+    DynamicCodec codec(StaticCodec::kNumFeatures, std::make_unique<cryptodd::ZstdCompressor>());
+    cryptodd::Temporal2dSimdCodecWorkspace workspace;
+
+    memory::vector<int64_t> decoder_prev_row(initial_prev_row_int64.begin(), initial_prev_row_int64.end());
+
+    // Encode
+    auto encoded_result = codec.encode64_DoubleDelta(original_int64_data, decoder_prev_row, workspace);
+    ASSERT_TRUE(encoded_result.has_value()) << encoded_result.error();
+    auto& encoded_data = *encoded_result;
+    ASSERT_FALSE(encoded_data.empty());
+
+    // Decode
+    auto decoded_result = codec.decode64_DoubleDelta(encoded_data, decoder_prev_row);
+    ASSERT_TRUE(decoded_result.has_value()) << decoded_result.error();
+    auto& decoded_data = *decoded_result;
+
+    // Verify data (lossless)
+    ASSERT_EQ(decoded_data.size(), original_int64_data.size());
+    for (size_t i = 0; i < original_int64_data.size(); ++i) {
+        ASSERT_EQ(original_int64_data[i], decoded_data[i]);
+    }
+
+    // Verify final state
+    for (size_t f = 0; f < StaticCodec::kNumFeatures; ++f) {
+        const int64_t last_original_val = original_int64_data[(f * kNumRows) + kNumRows - 1];
+        ASSERT_EQ(last_original_val, decoder_prev_row[f]);
+    }
+}
+
+TEST_F(Temporal2dSimdCodecTest, Dynamic_FullPipelineRoundTrip_Int64_Delta) {
+    constexpr size_t kFeatures = StaticCodec::kNumFeatures;
+    DynamicCodec codec(kFeatures, std::make_unique<cryptodd::ZstdCompressor>());
+    cryptodd::Temporal2dSimdCodecWorkspace workspace;
+
+    // Spans several shuffle blocks with a ragged tail.
+    const size_t num_rows = codecs::ShuffleBlock::rows_per_block(kFeatures * sizeof(int64_t)) * 2 + 13;
+    const auto data = generate_random_soa_data<int64_t>(num_rows, kFeatures);
+
+    const std::pair<bool, codecs::ShuffleLayout> variants[] = {
+        {false, codecs::ShuffleLayout::Global}, {true, codecs::ShuffleLayout::Global}, {true, codecs::ShuffleLayout::Blocked}};
+    for (const auto& [shuffle, layout] : variants) {
+        memory::vector<int64_t> encoder_prev_row(initial_prev_row_int64.begin(), initial_prev_row_int64.end());
+        memory::vector<int64_t> decoder_prev_row = encoder_prev_row;
+
+        // Two chained chunks: the second one must pick up the state left by the first.
+        for (size_t part = 0; part < 2; ++part) {
+            auto encoded_result = codec.encode64_Delta(data, encoder_prev_row, workspace, shuffle, layout);
+            ASSERT_TRUE(encoded_result.has_value()) << encoded_result.error();
+            ASSERT_FALSE(encoded_result->empty());
+
+            auto decoded_result = codec.decode64_Delta(*encoded_result, decoder_prev_row, shuffle, layout);
+            ASSERT_TRUE(decoded_result.has_value()) << decoded_result.error();
+            auto& decoded_data = *decoded_result;
+
+            // Verify data (lossless)
+            ASSERT_EQ(decoded_data.size(), data.size());
+            for (size_t i = 0; i < data.size(); ++i) {
+                ASSERT_EQ(data[i], decoded_data[i]) << "shuffle " << shuffle << ", part " << part << ", index " << i;
+            }
+
+            // Verify final state
+            for (size_t f = 0; f < kFeatures; ++f) {
+                encoder_prev_row[f] = data[(f * num_rows) + num_rows - 1];
+                ASSERT_EQ(encoder_prev_row[f], decoder_prev_row[f]);
+            }
+        }
+    }
+}
+
+TEST_F(Temporal2dSimdCodecTest, FusedEncodeMatchesTwoPassReference) {
+    constexpr size_t num_features = StaticCodec::kNumFeatures;
+    // Row counts around the vector width exercise the per-column first element and scalar remainder.
+    for (const size_t num_rows : {size_t{1}, size_t{2}, size_t{9}, size_t{31}, kNumRows}) {
+        const auto soa_data = generate_random_soa_data<float>(num_rows, num_features);
+        const size_t total = num_rows * num_features;
+
+        std::vector<hwy::float16_t> f16_deltas(total);
+        std::vector<uint8_t> reference16(total * sizeof(hwy::float16_t));
+        std::vector<uint8_t> fused16(reference16.size());
+        simd::DemoteAndXor2D_dispatcher(soa_data.data(), initial_prev_row_float.data(), f16_deltas.data(), num_rows, num_features);
+        simd::ShuffleFloat16_2D_dispatcher(f16_deltas.data(), reference16.data(), num_rows, num_features);
+        simd::DemoteXorShuffle16_2D_dispatcher(soa_data.data(), initial_prev_row_float.data(), fused16.data(), num_rows, num_features);
+        ASSERT_EQ(reference16, fused16) << "num_rows=" << num_rows;
+
+        std::vector<float> f32_deltas(total);
+        std::vector<uint8_t> reference32(total * sizeof(float));
+        std::vector<uint8_t> fused32(reference32.size());
+        simd::XorFloat32_2D_dispatcher(soa_data.data(), initial_prev_row_float.data(), f32_deltas.data(), num_rows, num_features);
+        simd::ShuffleFloat32_2D_dispatcher(f32_deltas.data(), reference32.data(), num_rows, num_features);
+        simd::XorShuffleFloat32_2D_dispatcher(soa_data.data(), initial_prev_row_float.data(), fused32.data(), num_rows, num_features);
+        ASSERT_EQ(reference32, fused32) << "num_rows=" << num_rows;
+    }
+}
+
+TEST_F(Temporal2dSimdCodecTest, BlockedLayoutRoundTripMatchesGlobal) {
+    constexpr size_t kFeatures = StaticCodec::kNumFeatures;
+    const size_t rows_per_block = codecs::ShuffleBlock::rows_per_block(kFeatures * sizeof(float));
+    const size_t num_rows = rows_per_block * 2 + 13;
+    const auto data = generate_random_soa_data<float>(num_rows, kFeatures);
+
+    StaticCodec static_codec(std::make_unique<cryptodd::ZstdCompressor>());
+    DynamicCodec dynamic_codec(kFeatures, std::make_unique<cryptodd::ZstdCompressor>());
+    cryptodd::Temporal2dSimdCodecWorkspace workspace;
+
+    // Float32, lossless: the dynamic codec must recover the row count from the frame on its own.
+    memory::vector<float> encoder_prev_row(initial_prev_row_float.begin(), initial_prev_row_float.end());
+    auto blocked32 = dynamic_codec.encode32(data, encoder_prev_row, workspace, codecs::ShuffleLayout::Blocked);
+    ASSERT_TRUE(blocked32.has_value()) << blocked32.error();
+    memory::vector<float> decoder_prev_row = encoder_prev_row;
+    auto decoded32 = dynamic_codec.decode32(*blocked32, decoder_prev_row, codecs::ShuffleLayout::Blocked);
+    ASSERT_TRUE(decoded32.has_value()) << decoded32.error();
+    ASSERT_EQ(decoded32->size(), data.size());
+    for (size_t i = 0; i < data.size(); ++i) {
+        ASSERT_EQ(data[i], (*decoded32)[i]) << "at " << i;
+    }
+    for (size_t f = 0; f < kFeatures; ++f) {
+        ASSERT_EQ(data[f * num_rows + num_rows - 1], decoder_prev_row[f]);
+    }
+
+    // Float16: blocked and global decodes agree bit for bit.
+    auto global16 = static_codec.encode16(data, initial_prev_row_float, workspace, codecs::ShuffleLayout::Global);
+    auto blocked16 = static_codec.encode16(data, initial_prev_row_float, workspace, codecs::ShuffleLayout::Blocked);
+    ASSERT_TRUE(global16.has_value() && blocked16.has_value());
+    StaticCodec::PrevRowFloat global_prev = initial_prev_row_float;
+    StaticCodec::PrevRowFloat blocked_prev = initial_prev_row_float;
+    auto global_decoded = static_codec.decode16(*global16, num_rows, global_prev, codecs::ShuffleLayout::Global);
+    auto blocked_decoded = static_codec.decode16(*blocked16, num_rows, blocked_prev, codecs::ShuffleLayout::Blocked);
+    ASSERT_TRUE(global_decoded.has_value()) << global_decoded.error();
+    ASSERT_TRUE(blocked_decoded.has_value()) << blocked_decoded.error();
+    for (size_t i = 0; i < data.size(); ++i) {
+        ASSERT_EQ((*global_decoded)[i], (*blocked_decoded)[i]) << "at " << i;
+    }
+    ASSERT_EQ(global_prev, blocked_prev);
+}
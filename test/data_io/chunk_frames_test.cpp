@@ -0,0 +1,196 @@
+#include "gtest/gtest.h"
+#include "../../src/data_io/chunk_frames.h"
+#include "../../src/data_io/data_compressor.h"
+#include "../../src/data_io/data_extractor.h"
+#include <cstring>
+#include <hwy/base.h>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace cryptodd {
+
+namespace {
+    std::vector<float> random_walk(const size_t count, const uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::normal_distribution<float> step(0.0f, 0.25f);
+        std::vector<float> values(count);
+        float value = 100.0f;
+        for (auto& v : values) {
+            value += step(rng);
+            v = value;
+        }
+        return values;
+    }
+
+    template <typename T>
+    std::span<const std::byte> bytes_of(const std::vector<T>& values) {
+        return std::as_bytes(std::span(values));
+    }
+
+    // Encodes `values` once as a regular chunk and once split into `num_frames`, then checks that both
+    // decode to the same output and leave the same final state.
+    template <typename T>
+    void expect_frames_match_single(const std::vector<T>& values, const ChunkDataType type,
+                                    const std::vector<int64_t>& shape, const size_t row_elements, const size_t num_frames) {
+        DataCompressor compressor;
+        DataExtractor extractor;
+        const std::vector<T> prev(row_elements, T{});
+
+        auto single = compressor.compress_chunk_frames(bytes_of(values), type, shape, bytes_of(prev), 1);
+        ASSERT_TRUE(single.has_value()) << single.error().to_string();
+        ASSERT_FALSE((*single)->has_flag(ChunkFlags::MULTI_FRAME));
+
+        auto framed = compressor.compress_chunk_frames(bytes_of(values), type, shape, bytes_of(prev), num_frames);
+        ASSERT_TRUE(framed.has_value()) << framed.error().to_string();
+        ASSERT_TRUE((*framed)->has_flag(ChunkFlags::MULTI_FRAME));
+        ASSERT_EQ((*framed)->get_shape()[0], shape[0]);
+
+        std::vector<T> single_state(row_elements, T{});
+        std::vector<T> framed_state(row_elements, T{});
+        auto decoded_single = row_elements == 1 && shape.size() == 1
+                                  ? extractor.read_chunk(**single, single_state[0])
+                                  : extractor.read_chunk(**single, std::span<T>(single_state));
+        auto decoded_framed = row_elements == 1 && shape.size() == 1
+                                  ? extractor.read_chunk(**framed, framed_state[0])
+                                  : extractor.read_chunk(**framed, std::span<T>(framed_state));
+        ASSERT_TRUE(decoded_single.has_value()) << decoded_single.error().to_string();
+        ASSERT_TRUE(decoded_framed.has_value()) << decoded_framed.error().to_string();
+
+        const auto single_bytes = (*decoded_single)->as_bytes();
+        const auto framed_bytes = (*decoded_framed)->as_bytes();
+        ASSERT_EQ(single_bytes.size(), values.size() * sizeof(T));
+        ASSERT_EQ(framed_bytes.size(), single_bytes.size());
+        ASSERT_TRUE(std::equal(single_bytes.begin(), single_bytes.end(), framed_bytes.begin()));
+        ASSERT_EQ(single_state, framed_state);
+    }
+}
+
+TEST(ChunkFramesTest, Temporal1dFloatFramesMatchSingleFrame) {
+    const auto values = random_walk(10'007, 1);
+    const std::vector<int64_t> shape = {static_cast<int64_t>(values.size())};
+    expect_frames_match_single(values, ChunkDataType::TEMPORAL_1D_SIMD_F32_XOR_SHUFFLE, shape, 1, 4);
+    expect_frames_match_single(values, ChunkDataType::TEMPORAL_1D_SIMD_F16_XOR_SHUFFLE_AS_F32, shape, 1, 3);
+}
+
+TEST(ChunkFramesTest, F16FrameStatesAreRoundedThroughF16) {
+    const auto values = random_walk(3'001, 6);
+    const std::vector<int64_t> shape = {static_cast<int64_t>(values.size())};
+    const float prev = 0.0f;
+    DataCompressor compressor;
+
+    auto chunk = compressor.compress_chunk_frames(bytes_of(values), ChunkDataType::TEMPORAL_1D_SIMD_F16_XOR_SHUFFLE_AS_F32,
+                                                  shape, std::as_bytes(std::span(&prev, 1)), 3);
+    ASSERT_TRUE(chunk.has_value()) << chunk.error().to_string();
+    const auto geometry = chunk_frames::row_geometry((*chunk)->type(), shape);
+    ASSERT_TRUE(geometry.has_value());
+    const auto table = chunk_frames::parse((*chunk)->data(), *geometry);
+    ASSERT_TRUE(table.has_value()) << table.error();
+
+    size_t first_row = 0;
+    for (size_t i = 1; i < table->size(); ++i) {
+        first_row += table->rows[i - 1];
+        float state;
+        std::memcpy(&state, table->state(i).data(), sizeof(state));
+        const float row = values[first_row - 1];
+        ASSERT_EQ(state, hwy::ConvertScalarTo<float>(hwy::ConvertScalarTo<hwy::float16_t>(row))) << "frame " << i;
+    }
+}
+
+TEST(ChunkFramesTest, Temporal1dFloatFramesAreLossless) {
+    const auto values = random_walk(5'000, 2);
+    const std::vector<int64_t> shape = {static_cast<int64_t>(values.size())};
+    const float prev = 0.0f;
+    DataCompressor compressor;
+    DataExtractor extractor;
+
+    auto chunk = compressor.compress_chunk_frames(bytes_of(values), ChunkDataType::TEMPORAL_1D_SIMD_F32_XOR_SHUFFLE,
+                                                  shape, std::as_bytes(std::span(&prev, 1)), 8);
+    ASSERT_TRUE(chunk.has_value()) << chunk.error().to_string();
+    auto decoded = extractor.read_chunk(**chunk);
+    ASSERT_TRUE(decoded.has_value()) << decoded.error().to_string();
+    const auto bytes = (*decoded)->as_bytes();
+    ASSERT_EQ(bytes.size(), values.size() * sizeof(float));
+    ASSERT_EQ(std::memcmp(bytes.data(), values.data(), bytes.size()), 0);
+}
+
+TEST(ChunkFramesTest, Temporal1dInt64FramesMatchSingleFrame) {
+    std::vector<int64_t> values(20'000);
+    std::iota(values.begin(), values.end(), int64_t{1'700'000'000'000});
+    const std::vector<int64_t> shape = {static_cast<int64_t>(values.size())};
+    expect_frames_match_single(values, ChunkDataType::TEMPORAL_1D_SIMD_I64_DELTA, shape, 1, 5);
+    expect_frames_match_single(values, ChunkDataType::TEMPORAL_1D_SIMD_I64_XOR, shape, 1, 2);
+}
+
+TEST(ChunkFramesTest, OrderbookFramesMatchSingleFrame) {
+    constexpr size_t snapshots = 301, depth = 20, features = 3;
+    const auto values = random_walk(snapshots * depth * features, 3);
+    const std::vector<int64_t> shape = {snapshots, depth, features};
+    expect_frames_match_single(values, ChunkDataType::GENERIC_OB_SIMD_F32, shape, depth * features, 4);
+    expect_frames_match_single(values, ChunkDataType::GENERIC_OB_SIMD_F16_AS_F32, shape, depth * features, 4);
+}
+
+TEST(ChunkFramesTest, Temporal2dFramesMatchSingleFrame) {
+    constexpr size_t rows = 1'003, features = 7;
+    const auto values = random_walk(rows * features, 4);
+    const std::vector<int64_t> shape = {rows, features};
+    expect_frames_match_single(values, ChunkDataType::TEMPORAL_2D_SIMD_F32, shape, features, 6);
+    expect_frames_match_single(values, ChunkDataType::TEMPORAL_2D_SIMD_F16_AS_F32, shape, features, 6);
+
+    std::vector<int64_t> ints(rows * features);
+    std::iota(ints.begin(), ints.end(), int64_t{0});
+    expect_frames_match_single(ints, ChunkDataType::TEMPORAL_2D_SIMD_I64, shape, features, 3);
+}
+
+TEST(ChunkFramesTest, FrameCountIsClampedToRows) {
+    const std::vector<float> values = {1.0f, 2.0f, 3.0f};
+    const std::vector<int64_t> shape = {3};
+    expect_frames_match_single(values, ChunkDataType::TEMPORAL_1D_SIMD_F32_XOR_SHUFFLE, shape, 1, 64);
+}
+
+TEST(ChunkFramesTest, RejectsUnsupportedType) {
+    DataCompressor compressor;
+    const std::vector<float> values(16, 1.0f);
+    const std::vector<int64_t> shape = {16};
+    auto result = compressor.compress_chunk_frames(bytes_of(values), ChunkDataType::ZSTD_COMPRESSED, shape, {}, 4);
+    ASSERT_FALSE(result.has_value());
+}
+
+TEST(ChunkFramesTest, RejectsRowCountsThatWrapAround) {
+    DataCompressor compressor;
+    DataExtractor extractor;
+    std::vector<int64_t> values(5'000);
+    std::iota(values.begin(), values.end(), int64_t{0});
+    const std::vector<int64_t> shape = {static_cast<int64_t>(values.size())};
+    const int64_t prev = 0;
+
+    auto chunk = compressor.compress_chunk_frames(bytes_of(values), ChunkDataType::TEMPORAL_1D_SIMD_I64_DELTA, shape,
+                                                  std::as_bytes(std::span(&prev, 1)), 5);
+    ASSERT_TRUE(chunk.has_value()) << chunk.error().to_string();
+    // Four frames of 2^62 rows and one of the whole shape: the counts add up to it modulo 2^64.
+    std::vector<uint64_t> rows(5, uint64_t{1} << 62);
+    rows.back() = values.size();
+    std::memcpy((*chunk)->data().data() + 2 * sizeof(uint32_t), rows.data(), rows.size() * sizeof(uint64_t));
+
+    const auto geometry = chunk_frames::row_geometry((*chunk)->type(), shape);
+    ASSERT_TRUE(geometry.has_value());
+    ASSERT_FALSE(chunk_frames::parse((*chunk)->data(), *geometry).has_value());
+    ASSERT_FALSE(extractor.read_chunk(**chunk).has_value());
+}
+
+TEST(ChunkFramesTest, RejectsTruncatedPayload) {
+    DataCompressor compressor;
+    DataExtractor extractor;
+    const auto values = random_walk(4'096, 5);
+    const std::vector<int64_t> shape = {static_cast<int64_t>(values.size())};
+    const float prev = 0.0f;
+
+    auto chunk = compressor.compress_chunk_frames(bytes_of(values), ChunkDataType::TEMPORAL_1D_SIMD_F32_XOR_SHUFFLE,
+                                                  shape, std::as_bytes(std::span(&prev, 1)), 4);
+    ASSERT_TRUE(chunk.has_value()) << chunk.error().to_string();
+    (*chunk)->data().resize((*chunk)->data().size() - 1);
+    auto decoded = extractor.read_chunk(**chunk);
+    ASSERT_FALSE(decoded.has_value());
+}
+
+} // namespace cryptodd
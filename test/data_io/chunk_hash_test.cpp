@@ -0,0 +1,118 @@
+#include "gtest/gtest.h"
+#include "../../src/data_io/data_compressor.h"
+#include "../../src/data_io/data_extractor.h"
+#include "../../src/file_format/chunk_hash.h"
+#include <random>
+#include <vector>
+
+namespace cryptodd {
+
+namespace {
+    std::vector<std::byte> random_bytes(const size_t size, const uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::vector<std::byte> bytes(size);
+        for (auto& b : bytes) b = static_cast<std::byte>(rng());
+        return bytes;
+    }
+}
+
+TEST(ChunkHashTest, FlagsRecordAlgorithm) {
+    const HashOptions tree{.algorithm = HashAlgorithm::BLAKE3_256, .parallel_threshold = 1000};
+    ASSERT_EQ(hash_flags(HashOptions{}, 1 << 30), ChunkFlags::NONE);
+    ASSERT_EQ(hash_flags(tree, 999), ChunkFlags::NONE);
+    ASSERT_EQ(hash_flags(tree, 1000), ChunkFlags::HASH_BLAKE3_TREE);
+    ASSERT_EQ(hash_flags({.algorithm = HashAlgorithm::XXH3_128, .parallel_threshold = 1000}, 1 << 20), ChunkFlags::HASH_XXH3_128);
+
+    const auto none = hash_flags({.algorithm = HashAlgorithm::NONE}, 10);
+    ASSERT_TRUE(hasFlag(none, ChunkFlags::SKIP_HASH_CHECK));
+    ASSERT_FALSE(chunk_has_hash(none));
+
+    for (const auto algorithm : {HashAlgorithm::BLAKE3_256, HashAlgorithm::XXH3_128, HashAlgorithm::NONE}) {
+        ASSERT_EQ(chunk_hash_algorithm(hash_flags({.algorithm = algorithm}, 10) | ChunkFlags::ZSTD), algorithm);
+    }
+}
+
+TEST(ChunkHashTest, AlgorithmsAreDeterministicAndDistinct) {
+    const auto data = random_bytes(100'000, 1);
+    const std::span<const std::byte> span(data);
+
+    // The default keeps the format's original hash, so existing files still verify.
+    ASSERT_EQ(calculate_chunk_hash(span, ChunkFlags::NONE), calculate_blake3_hash256(span));
+
+    const auto xxh3 = calculate_chunk_hash(span, ChunkFlags::HASH_XXH3_128);
+    ASSERT_EQ(xxh3, calculate_chunk_hash(span, ChunkFlags::HASH_XXH3_128));
+    ASSERT_NE(xxh3, calculate_blake3_hash256(span));
+    ASSERT_EQ(xxh3[2], 0u);
+    ASSERT_EQ(xxh3[3], 0u);
+
+    ASSERT_EQ(calculate_chunk_hash(span, ChunkFlags::HASH_NONE), blake3_hash256_t{});
+}
+
+TEST(ChunkHashTest, TreeHashDetectsCorruptionInAnySegment) {
+    // Not a multiple of the segment size, so the last segment is partial.
+    auto data = random_bytes(3 * PARALLEL_HASH_SEGMENT_BYTES + 12345, 2);
+    const auto tree = calculate_chunk_hash(std::span<const std::byte>(data), ChunkFlags::HASH_BLAKE3_TREE);
+    ASSERT_EQ(tree, calculate_chunk_hash(std::span<const std::byte>(data), ChunkFlags::HASH_BLAKE3_TREE));
+    ASSERT_NE(tree, calculate_blake3_hash256(std::span<const std::byte>(data)));
+
+    for (const size_t offset : {size_t{0}, PARALLEL_HASH_SEGMENT_BYTES + 7, data.size() - 1}) {
+        data[offset] ^= std::byte{1};
+        ASSERT_NE(calculate_chunk_hash(std::span<const std::byte>(data), ChunkFlags::HASH_BLAKE3_TREE), tree) << offset;
+        data[offset] ^= std::byte{1};
+    }
+
+    // The total size is part of the root: a truncated chunk cannot match.
+    ASSERT_NE(calculate_chunk_hash(std::span<const std::byte>(data).first(data.size() - 1), ChunkFlags::HASH_BLAKE3_TREE), tree);
+    ASSERT_NE(calculate_chunk_hash(std::span<const std::byte>{}, ChunkFlags::HASH_BLAKE3_TREE), blake3_hash256_t{});
+}
+
+TEST(ChunkHashTest, IncrementalHasherMatchesOneShot) {
+    const auto data = random_bytes(2 * PARALLEL_HASH_SEGMENT_BYTES + 777, 3);
+    const std::span<const std::byte> span(data);
+    for (const auto flags : {ChunkFlags::NONE, ChunkFlags::HASH_XXH3_128, ChunkFlags::HASH_BLAKE3_TREE, ChunkFlags::HASH_NONE}) {
+        // Pieces that straddle the tree segments.
+        ChunkHasher hasher(flags);
+        for (size_t offset = 0; offset < span.size(); offset += 100'003) {
+            hasher.update(span.subspan(offset, std::min<size_t>(100'003, span.size() - offset)));
+        }
+        ASSERT_EQ(hasher.size(), span.size());
+        ASSERT_EQ(hasher.finalize(), calculate_chunk_hash(span, flags)) << static_cast<uint64_t>(flags);
+        ASSERT_EQ(ChunkHasher(flags).finalize(), calculate_chunk_hash({}, flags));
+    }
+}
+
+TEST(ChunkHashTest, HashWhileEncodingAndDecoding) {
+    std::mt19937 rng(4);
+    std::normal_distribution<float> step(0.0f, 1.0f);
+    // Several shuffle blocks, the last one partial.
+    std::vector<float> values(100'000);
+    float value = 50.0f;
+    for (auto& v : values) v = value += step(rng);
+    const auto raw = std::as_bytes(std::span<const float>(values));
+
+    DataCompressor compressor;
+    ChunkHasher encode_hasher(ChunkFlags::HASH_XXH3_128);
+    size_t blocks = 0;
+    auto chunk = compressor.compress_chunk(std::span<const float>(values), ChunkDataType::TEMPORAL_1D_SIMD_F32_XOR_SHUFFLE, 0.0f, 1,
+                                           [&](const std::span<const std::byte> block) { encode_hasher.update(block); ++blocks; });
+    ASSERT_TRUE(chunk.has_value()) << chunk.error().to_string();
+    ASSERT_GT(blocks, 1u);
+    ASSERT_EQ(encode_hasher.size(), raw.size());
+    ASSERT_EQ(encode_hasher.finalize(), calculate_chunk_hash(raw, ChunkFlags::HASH_XXH3_128));
+
+    DataExtractor extractor;
+    ChunkHasher decode_hasher(ChunkFlags::NONE);
+    auto decoded = extractor.read_chunk(**chunk, [&](const std::span<const std::byte> block) { decode_hasher.update(block); });
+    ASSERT_TRUE(decoded.has_value()) << decoded.error().to_string();
+    ASSERT_EQ(decode_hasher.size(), raw.size());
+    ASSERT_EQ(decode_hasher.finalize(), calculate_blake3_hash256(raw));
+
+    // Codecs without a block loop never call the visitor.
+    size_t chimp_bytes = 0;
+    auto chimp = compressor.compress_chunk(std::span<const float>(values), ChunkDataType::TEMPORAL_1D_CHIMP_F32, 0.0f, 1,
+                                           [&](const std::span<const std::byte> block) { chimp_bytes += block.size(); });
+    ASSERT_TRUE(chimp.has_value());
+    ASSERT_EQ(chimp_bytes, 0u);
+}
+
+} // namespace cryptodd
@@ -0,0 +1,121 @@
+#include "gtest/gtest.h"
+#include "../../src/data_io/data_compressor.h"
+#include "../../src/data_io/data_reader.h"
+#include "../../src/data_io/data_verifier.h"
+#include "../../src/data_io/data_writer.h"
+#include "../../src/file_format/chunk_hash.h"
+#include "../../src/storage/memory_backend.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace cryptodd {
+
+namespace {
+    constexpr size_t kChunks = 6;
+    constexpr size_t kChunkBytes = 4096;
+
+    // Chunk i is filled with the byte 0x10 + i, so it can be found in the file image.
+    std::vector<std::byte> chunk_bytes(const size_t i) {
+        return std::vector<std::byte>(kChunkBytes, static_cast<std::byte>(0x10 + i));
+    }
+
+    // Writes kChunks RAW chunks, chunk `unhashed` without a hash, and returns the file image.
+    std::unique_ptr<storage::IStorageBackend> write_file(const size_t unhashed) {
+        auto writer = DataWriter::create_in_memory(4);
+        EXPECT_TRUE(writer.has_value());
+        for (size_t i = 0; i < kChunks; ++i) {
+            const auto data = chunk_bytes(i);
+            const int64_t shape[] = {static_cast<int64_t>(data.size())};
+            const auto flags = i == unhashed ? hash_flags({.algorithm = HashAlgorithm::NONE}, data.size()) : ChunkFlags::NONE;
+            Chunk chunk;
+            chunk.set_data({data.begin(), data.end()});
+            EXPECT_TRUE((*writer)->append_chunk(ChunkDataType::RAW, DType::UINT8, flags, shape, chunk, calculate_chunk_hash(data, flags)).has_value());
+        }
+        auto backend = (*writer)->release_backend();
+        EXPECT_TRUE(backend.has_value());
+        EXPECT_TRUE((*backend)->rewind().has_value());
+        return std::move(*backend);
+    }
+}
+
+TEST(DataVerifierTest, ReportsCorruptedChunksAndKeepsGoing) {
+    auto backend = write_file(4);
+    auto& image = dynamic_cast<storage::MemoryBackend&>(*backend);
+    for (const size_t corrupt : {size_t{1}, size_t{3}}) {
+        const auto pattern = chunk_bytes(corrupt);
+        const auto buffer = image.get_buffer();
+        const auto found = std::ranges::search(buffer, pattern);
+        ASSERT_FALSE(found.empty());
+        found[100] ^= std::byte{1};
+    }
+
+    auto reader = DataReader::open_in_memory(std::move(backend));
+    ASSERT_TRUE(reader.has_value()) << reader.error();
+    auto report = verify_file(**reader, {.max_in_flight = 1});
+    ASSERT_TRUE(report.has_value()) << report.error();
+
+    ASSERT_FALSE(report->ok());
+    ASSERT_EQ(report->corrupted.size(), 2u);
+    ASSERT_EQ(report->corrupted[0].index, 1u);
+    ASSERT_EQ(report->corrupted[1].index, 3u);
+    ASSERT_EQ(report->chunks_verified, kChunks - 2);
+    ASSERT_EQ(report->chunks_unhashed, 1u);
+    ASSERT_EQ(report->raw_bytes, (kChunks - 2) * kChunkBytes);
+    ASSERT_EQ(report->bytes_read, kChunks * kChunkBytes);
+    // Six chunks in blocks of four.
+    ASSERT_EQ(report->index_blocks, 2u);
+    ASSERT_FALSE(report->index_error.has_value());
+}
+
+TEST(DataVerifierTest, ReportsChunksThatThrowWhileDecoding) {
+    auto writer = DataWriter::create_in_memory(4);
+    ASSERT_TRUE(writer.has_value()) << writer.error();
+    DataCompressor compressor;
+    for (size_t i = 0; i < kChunks; ++i) {
+        // Distinct lengths, so each chunk's shape can be found in the file image.
+        const std::vector<float> values(1000 + i, static_cast<float>(i));
+        const int64_t shape[] = {static_cast<int64_t>(values.size())};
+        auto chunk = compressor.compress_chunk(std::span(values), ChunkDataType::TEMPORAL_1D_SIMD_F32_XOR_SHUFFLE, 0.0f);
+        ASSERT_TRUE(chunk.has_value()) << chunk.error().to_string();
+        const auto flags = (*chunk)->flags();
+        ASSERT_TRUE((*writer)->append_chunk(ChunkDataType::TEMPORAL_1D_SIMD_F32_XOR_SHUFFLE, DType::FLOAT32, flags, shape,
+                                            **chunk, calculate_chunk_hash(std::as_bytes(std::span(values)), flags)).has_value());
+    }
+    auto backend = (*writer)->release_backend();
+    ASSERT_TRUE(backend.has_value()) << backend.error();
+    ASSERT_TRUE((*backend)->rewind().has_value());
+
+    // A shape too large for the decoder to allocate its output: the blocked layout sizes it before decompressing.
+    const int64_t length = 1002, huge = int64_t{1} << 62;
+    const auto buffer = dynamic_cast<storage::MemoryBackend&>(**backend).get_buffer();
+    const auto found = std::ranges::search(buffer, std::as_bytes(std::span(&length, 1)));
+    ASSERT_FALSE(found.empty());
+    std::memcpy(found.data(), &huge, sizeof(huge));
+
+    auto reader = DataReader::open_in_memory(std::move(*backend));
+    ASSERT_TRUE(reader.has_value()) << reader.error();
+    auto report = verify_file(**reader, {.max_in_flight = 1});
+    ASSERT_TRUE(report.has_value()) << report.error();
+    ASSERT_EQ(report->corrupted.size(), 1u);
+    ASSERT_EQ(report->corrupted[0].index, 2u);
+    ASSERT_EQ(report->chunks_verified, kChunks - 1);
+}
+
+TEST(DataVerifierTest, CleanFileAndRateLimit) {
+    auto reader = DataReader::open_in_memory(write_file(kChunks));
+    ASSERT_TRUE(reader.has_value()) << reader.error();
+
+    // 24 KiB at 0.1 MB/s takes at least 0.2 s.
+    auto report = verify_file(**reader, {.max_read_mbps = 0.1});
+    ASSERT_TRUE(report.has_value()) << report.error();
+    ASSERT_TRUE(report->ok());
+    ASSERT_EQ(report->chunks_verified, kChunks);
+    ASSERT_EQ(report->chunks_unhashed, 0u);
+    ASSERT_GE(report->elapsed_s, 0.2);
+    ASSERT_LE(report->read_mbps, 0.1 + 1e-9);
+
+    ASSERT_FALSE(verify_file(**reader, {.max_read_mbps = -1.0}).has_value());
+}
+
+} // namespace cryptodd
@@ -0,0 +1,149 @@
+#include "gtest/gtest.h"
+#include "../../src/data_io/data_writer.h"
+#include "../../src/data_io/group_commit.h"
+#include "../../src/file_format/chunk_hash.h"
+#include "../test_helpers.h"
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace cryptodd {
+
+namespace {
+    void append_chunks(DataWriter& writer, const size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            const auto data = generate_random_data(1000);
+            const int64_t shape[] = {static_cast<int64_t>(data.size())};
+            Chunk chunk;
+            chunk.set_data({data.begin(), data.end()});
+            ASSERT_TRUE(writer.append_chunk(ChunkDataType::RAW, DType::UINT8, ChunkFlags::NONE, shape, chunk,
+                                            calculate_chunk_hash(data, ChunkFlags::NONE)).has_value());
+        }
+    }
+
+    uint64_t sync_requests(const DataWriter& writer) {
+        const auto stats = writer.sync_stats();
+        return stats ? stats->requests : 0;
+    }
+}
+
+TEST(GroupCommitTest, LatencyHistogram) {
+    using std::chrono::microseconds;
+    SyncLatencyHistogram histogram;
+    ASSERT_EQ(histogram.quantile_us(0.5), 0u);
+    for (const auto us : {1, 3, 3, 100, 5000}) histogram.record(microseconds(us));
+    histogram.record(std::chrono::seconds(60));
+
+    ASSERT_EQ(histogram.count, 6u);
+    ASSERT_EQ(histogram.buckets[0], 1u);  // < 2 us
+    ASSERT_EQ(histogram.buckets[1], 2u);  // [2, 4) us
+    ASSERT_EQ(histogram.buckets[6], 1u);  // [64, 128) us
+    ASSERT_EQ(histogram.buckets[12], 1u); // [4096, 8192) us
+    ASSERT_EQ(histogram.buckets.back(), 1u);
+    ASSERT_EQ(histogram.max_us, 60'000'000u);
+
+    ASSERT_EQ(histogram.quantile_us(0.0), 2u);
+    ASSERT_EQ(histogram.quantile_us(0.5), 4u);
+    ASSERT_EQ(histogram.quantile_us(0.8), 8192u);
+    ASSERT_EQ(histogram.quantile_us(1.0), 60'000'000u);
+}
+
+TEST(GroupCommitTest, CoalescesConcurrentRequests) {
+    const auto path = generate_unique_test_filepath();
+    std::ofstream(path) << "data";
+    auto file = SyncFile::open(path);
+    ASSERT_TRUE(file.has_value()) << file.error();
+
+    // The first sync blocks until every request is queued, so all the later ones pile up behind it.
+    std::promise<void> all_submitted;
+    const std::shared_future<void> gate = all_submitted.get_future().share();
+    std::atomic<size_t> calls{0};
+    GroupCommitter committer([&](const SyncFile& f) {
+        if (calls++ == 0) gate.wait();
+        return f.sync();
+    });
+
+    constexpr size_t kThreads = 4;
+    constexpr size_t kRequests = 25;
+    std::vector<std::vector<GroupCommitter::Ticket>> tickets(kThreads);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            for (size_t i = 0; i < kRequests; ++i) tickets[t].push_back(committer.submit(*file));
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    all_submitted.set_value();
+    for (auto& thread_tickets : tickets) {
+        for (auto& ticket : thread_tickets) ASSERT_TRUE(ticket.get().has_value());
+    }
+
+    const auto stats = committer.stats((*file)->device());
+    ASSERT_TRUE(stats.has_value());
+    ASSERT_EQ(stats->requests, kThreads * kRequests);
+    ASSERT_EQ(stats->failures, 0u);
+    // A batch syncs its single file once, whatever the number of requests it serves: here the blocked batch and
+    // at most one more for everything queued behind it.
+    ASSERT_EQ(stats->syncs, stats->batches);
+    ASSERT_EQ(stats->syncs, calls.load());
+    ASSERT_LE(stats->syncs, 2u);
+    ASSERT_LT(stats->syncs, stats->requests);
+    ASSERT_EQ(stats->latency.count, stats->syncs);
+    ASSERT_EQ(committer.stats().size(), 1u);
+
+    std::filesystem::remove(path);
+}
+
+TEST(GroupCommitTest, WriterDurabilityModes) {
+    const auto path = generate_unique_test_filepath();
+    auto writer = DataWriter::create_new(path);
+    ASSERT_TRUE(writer.has_value()) << writer.error();
+    auto& w = **writer;
+
+    ASSERT_FALSE(w.set_durability({.mode = DurabilityMode::EVERY_N_CHUNKS, .every_chunks = 0}).has_value());
+    ASSERT_FALSE(w.set_durability({.mode = DurabilityMode::INTERVAL, .interval = std::chrono::milliseconds(0)}).has_value());
+
+    // NONE never syncs, not even on flush.
+    append_chunks(w, 3);
+    ASSERT_TRUE(w.flush().has_value());
+    ASSERT_FALSE(w.sync_stats().has_value());
+
+    ASSERT_TRUE(w.set_durability({.mode = DurabilityMode::EVERY_N_CHUNKS, .every_chunks = 3}).has_value());
+    const auto before = sync_requests(w);
+    append_chunks(w, 7);
+    ASSERT_EQ(sync_requests(w) - before, 2u);
+    ASSERT_TRUE(w.flush().has_value());
+    ASSERT_EQ(sync_requests(w) - before, 3u);
+
+    ASSERT_TRUE(w.set_durability({.mode = DurabilityMode::EACH_APPEND}).has_value());
+    append_chunks(w, 4);
+    ASSERT_EQ(sync_requests(w) - before, 7u);
+
+    // A long interval: only the first append after it elapsed syncs, here none.
+    ASSERT_TRUE(w.set_durability({.mode = DurabilityMode::INTERVAL, .interval = std::chrono::hours(1)}).has_value());
+    append_chunks(w, 4);
+    ASSERT_EQ(sync_requests(w) - before, 7u);
+    ASSERT_TRUE(w.set_durability({.mode = DurabilityMode::INTERVAL, .interval = std::chrono::milliseconds(1)}).has_value());
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    append_chunks(w, 1);
+    ASSERT_TRUE(w.flush().has_value());
+    ASSERT_EQ(sync_requests(w) - before, 9u);
+    ASSERT_EQ(w.num_chunks(), 19u);
+
+    writer->reset();
+    std::filesystem::remove(path);
+}
+
+TEST(GroupCommitTest, MemoryWriterOnlyFlushes) {
+    auto writer = DataWriter::create_in_memory();
+    ASSERT_TRUE(writer.has_value());
+    ASSERT_TRUE((*writer)->set_durability({.mode = DurabilityMode::EACH_APPEND}).has_value());
+    append_chunks(**writer, 2);
+    ASSERT_TRUE((*writer)->flush().has_value());
+    ASSERT_FALSE((*writer)->sync_stats().has_value());
+}
+
+} // namespace cryptodd
@@ -0,0 +1,77 @@
+#include "gtest/gtest.h"
+#include "../../src/data_io/thread_pool.h"
+#include <atomic>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace cryptodd {
+
+TEST(ThreadPoolTest, SubmitReturnsResult) {
+    ThreadPool pool(2);
+    auto future = pool.submit([] { return 21 * 2; });
+    ASSERT_EQ(future.get(), 42);
+}
+
+TEST(ThreadPoolTest, SubmitPropagatesExceptions) {
+    ThreadPool pool(1);
+    auto future = pool.submit([]() -> int { throw std::runtime_error("boom"); });
+    ASSERT_THROW(future.get(), std::runtime_error);
+}
+
+TEST(ThreadPoolTest, ParallelForVisitsEveryIndexOnce) {
+    ThreadPool pool(4);
+    constexpr size_t count = 1000;
+    std::vector<std::atomic<int>> hits(count);
+    pool.parallel_for(count, [&](const size_t i) { hits[i].fetch_add(1); });
+    for (size_t i = 0; i < count; ++i) {
+        ASSERT_EQ(hits[i].load(), 1) << "index " << i;
+    }
+}
+
+TEST(ThreadPoolTest, ParallelForRunsIndexZeroOnCaller) {
+    ThreadPool pool(2);
+    std::thread::id index_zero_thread;
+    pool.parallel_for(4, [&](const size_t i) {
+        if (i == 0) index_zero_thread = std::this_thread::get_id();
+    });
+    ASSERT_EQ(index_zero_thread, std::this_thread::get_id());
+}
+
+TEST(ThreadPoolTest, ParallelForRethrowsAfterAllTasksFinish) {
+    ThreadPool pool(4);
+    std::atomic<int> completed{0};
+    ASSERT_THROW(pool.parallel_for(64, [&](const size_t i) {
+        if (i == 7) throw std::runtime_error("frame failed");
+        completed.fetch_add(1);
+    }), std::runtime_error);
+    ASSERT_EQ(completed.load(), 63);
+}
+
+TEST(ThreadPoolTest, NestedParallelForDoesNotDeadlock) {
+    ThreadPool pool(1);
+    std::atomic<int> total{0};
+    pool.parallel_for(4, [&](size_t) {
+        pool.parallel_for(4, [&](size_t) { total.fetch_add(1); });
+    });
+    ASSERT_EQ(total.load(), 16);
+}
+
+TEST(ThreadPoolTest, DestructorDrainsQueuedTasks) {
+    std::atomic<int> completed{0};
+    {
+        ThreadPool pool(1);
+        for (int i = 0; i < 32; ++i) {
+            (void)pool.submit([&] { completed.fetch_add(1); });
+        }
+    }
+    ASSERT_EQ(completed.load(), 32);
+}
+
+TEST(ThreadPoolTest, SharedPoolIsSingleton) {
+    ASSERT_EQ(&ThreadPool::shared(), &ThreadPool::shared());
+    ASSERT_GE(ThreadPool::shared().size(), 1u);
+}
+
+} // namespace cryptodd
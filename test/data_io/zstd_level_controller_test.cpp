@@ -0,0 +1,116 @@
+#include "gtest/gtest.h"
+#include "../../src/data_io/data_compressor.h"
+#include "../../src/data_io/data_extractor.h"
+#include "../../src/data_io/zstd_level_controller.h"
+#include <chrono>
+#include <random>
+#include <vector>
+
+namespace cryptodd {
+
+namespace {
+    using namespace std::chrono_literals;
+
+    constexpr size_t kChunkBytes = 1'000'000;
+
+    // Records `count` chunks of kChunkBytes at the controller's level, each encoded in `elapsed`.
+    void feed(ZstdLevelController& controller, const size_t count, const std::chrono::nanoseconds elapsed) {
+        for (size_t i = 0; i < count; ++i) controller.record(controller.level(), kChunkBytes, elapsed);
+    }
+}
+
+TEST(ZstdLevelControllerTest, StepsDownWhenTooSlowAndSkipsLevelZero) {
+    ZstdLevelController controller;
+    ASSERT_TRUE(controller.configure({.min_level = -2, .max_level = 5, .initial_level = 2, .target_mbps = 100.0}).has_value());
+    ASSERT_EQ(controller.level(), 2);
+
+    // 1 MB in 20 ms is 50 MB/s: below the target, so every min_samples chunks the level drops.
+    feed(controller, 2, 20ms);
+    ASSERT_EQ(controller.level(), 1);
+    feed(controller, 2, 20ms);
+    ASSERT_EQ(controller.level(), -1);
+    feed(controller, 10, 20ms);
+    ASSERT_EQ(controller.level(), -2);
+    ASSERT_EQ(controller.stats().level_changes, 3);
+}
+
+TEST(ZstdLevelControllerTest, StepsUpOnlyWithHeadroom) {
+    ZstdLevelController controller;
+    ASSERT_TRUE(controller.configure({.min_level = 1, .max_level = 3, .initial_level = 1, .target_mbps = 100.0, .headroom = 1.5}).has_value());
+
+    // 125 MB/s meets the target but not with 1.5x headroom: the level holds.
+    feed(controller, 10, 8ms);
+    ASSERT_EQ(controller.level(), 1);
+    // 500 MB/s leaves room to spare: the level climbs to its maximum and stays there.
+    feed(controller, 10, 2ms);
+    ASSERT_EQ(controller.level(), 3);
+    ASSERT_NEAR(controller.stats().avg_mbps, 500.0, 1.0);
+}
+
+TEST(ZstdLevelControllerTest, LatencyTargetAndStaleSamples) {
+    ZstdLevelController controller;
+    ASSERT_TRUE(controller.configure({.min_level = -5, .max_level = 9, .initial_level = 3, .max_latency_ms = 10.0}).has_value());
+    feed(controller, 2, 15ms);
+    ASSERT_EQ(controller.level(), 2);
+
+    // A chunk encoded at a level the controller has left does not count.
+    controller.record(3, kChunkBytes, 100ms);
+    ASSERT_EQ(controller.stats().chunks, 2);
+    ASSERT_EQ(controller.level(), 2);
+}
+
+TEST(ZstdLevelControllerTest, RejectsInconsistentOptions) {
+    ZstdLevelController controller;
+    ASSERT_FALSE(controller.configure({.min_level = 5, .max_level = 1, .initial_level = 3}).has_value());
+    ASSERT_FALSE(controller.configure({.min_level = -1, .max_level = 3, .initial_level = 0}).has_value());
+    ASSERT_FALSE(controller.configure({.min_level = -1000, .max_level = 3}).has_value());
+    ASSERT_FALSE(controller.configure({.target_mbps = -1.0}).has_value());
+    ASSERT_FALSE(controller.configure({.smoothing = 0.0}).has_value());
+}
+
+TEST(ZstdLevelControllerTest, ChunkFlagsRecordLevel) {
+    ASSERT_FALSE(chunk_zstd_level(ChunkFlags::ZSTD).has_value());
+    for (const int level : {-128, -5, 1, 22}) {
+        const auto flags = with_zstd_level(ChunkFlags::ZSTD | ChunkFlags::MULTI_FRAME, level);
+        ASSERT_EQ(chunk_zstd_level(flags), level);
+        ASSERT_TRUE(hasFlag(flags, ChunkFlags::MULTI_FRAME));
+        // Recording again replaces the level.
+        ASSERT_EQ(chunk_zstd_level(with_zstd_level(flags, 7)), 7);
+    }
+}
+
+TEST(ZstdLevelControllerTest, DataCompressorAdaptiveLevel) {
+    DataCompressor compressor;
+    DataExtractor extractor;
+    // An unreachable target drives the level down to min_level one chunk at a time.
+    ASSERT_TRUE(compressor.level_controller().configure({.min_level = -3, .max_level = 3, .initial_level = 1, .target_mbps = 1e9, .min_samples = 1}).has_value());
+
+    std::mt19937 rng(1);
+    std::normal_distribution<float> step(0.0f, 1.0f);
+    std::vector<float> values(4096);
+    float value = 100.0f;
+    for (auto& v : values) v = value += step(rng);
+
+    const int expected_levels[] = {1, -1, -2, -3, -3};
+    for (const int expected : expected_levels) {
+        auto chunk = compressor.compress_chunk(std::span<const float>(values), ChunkDataType::TEMPORAL_1D_SIMD_F32_XOR_SHUFFLE, DataCompressor::ADAPTIVE_LEVEL);
+        ASSERT_TRUE(chunk.has_value()) << chunk.error().to_string();
+        ASSERT_EQ(chunk_zstd_level((*chunk)->flags()), expected);
+        auto decoded = extractor.read_chunk(**chunk);
+        ASSERT_TRUE(decoded.has_value()) << decoded.error().to_string();
+        const auto floats = (*decoded)->get<float>();
+        ASSERT_TRUE(std::equal(floats.begin(), floats.end(), values.begin(), values.end()));
+    }
+
+    // Plain zstd and fixed levels: the flag is only set by the adaptive path.
+    const int64_t shape[] = {static_cast<int64_t>(values.size())};
+    auto zstd_chunk = compressor.compress_zstd(std::as_bytes(std::span(values)), shape, DType::FLOAT32, DataCompressor::ADAPTIVE_LEVEL);
+    ASSERT_TRUE(zstd_chunk.has_value()) << zstd_chunk.error().to_string();
+    ASSERT_EQ(chunk_zstd_level((*zstd_chunk)->flags()), -3);
+    ASSERT_TRUE((*zstd_chunk)->has_flag(ChunkFlags::ZSTD));
+    auto fixed = compressor.compress_chunk(std::span<const float>(values), ChunkDataType::TEMPORAL_1D_SIMD_F32_XOR_SHUFFLE, 5);
+    ASSERT_TRUE(fixed.has_value());
+    ASSERT_FALSE(chunk_zstd_level((*fixed)->flags()).has_value());
+}
+
+} // namespace cryptodd
@@ -0,0 +1,128 @@
+#include "gtest/gtest.h"
+#include "../../src/memory/per_thread.h"
+#include <atomic>
+#include <latch>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace cryptodd::memory {
+
+namespace {
+    struct Counter {
+        int value = 0;
+    };
+
+    struct Tracked {
+        static inline std::atomic<int> live{0};
+        Tracked() { ++live; }
+        ~Tracked() { --live; }
+    };
+}
+
+TEST(PerThreadTest, SameThreadReturnsSameInstance) {
+    PerThread<Counter> per_thread;
+    auto& first = per_thread.local();
+    first.value = 42;
+    auto& second = per_thread.local();
+    ASSERT_EQ(&first, &second);
+    ASSERT_EQ(second.value, 42);
+    ASSERT_EQ(per_thread.size(), 1);
+}
+
+TEST(PerThreadTest, DistinctOwnersOnSameThreadAreIndependent) {
+    PerThread<Counter> a;
+    PerThread<Counter> b;
+
+    // Alternate between owners to exercise the thread_local slot being re-targeted.
+    for (int i = 0; i < 10; ++i) {
+        a.local().value += 1;
+        b.local().value += 2;
+    }
+    ASSERT_NE(&a.local(), &b.local());
+    ASSERT_EQ(a.local().value, 10);
+    ASSERT_EQ(b.local().value, 20);
+}
+
+TEST(PerThreadTest, EachThreadGetsItsOwnInstance) {
+    PerThread<Counter> per_thread;
+    constexpr int num_threads = 8;
+    constexpr int iterations = 10000;
+
+    std::vector<Counter*> seen(num_threads, nullptr);
+    std::vector<int> values(num_threads, 0);
+    // Every thread stays alive until all of them recorded their instance, so addresses cannot be reused.
+    std::latch recorded(num_threads);
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < iterations; ++i) {
+                ++per_thread.local().value;
+            }
+            seen[t] = &per_thread.local();
+            values[t] = per_thread.local().value;
+            recorded.arrive_and_wait();
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Non-atomic increments must not have raced: every instance saw exactly its own thread.
+    ASSERT_EQ(std::set<Counter*>(seen.begin(), seen.end()).size(), static_cast<size_t>(num_threads));
+    for (const int value : values) {
+        ASSERT_EQ(value, iterations);
+    }
+    // Each thread released its instance when it exited.
+    ASSERT_EQ(per_thread.size(), 0);
+}
+
+TEST(PerThreadTest, ThreadExitReleasesInstance) {
+    PerThread<Tracked> per_thread;
+    (void)per_thread.local();
+    ASSERT_EQ(Tracked::live, 1);
+
+    std::thread([&] {
+        (void)per_thread.local();
+        ASSERT_EQ(per_thread.size(), 2);
+    }).join();
+    ASSERT_EQ(per_thread.size(), 1);
+    ASSERT_EQ(Tracked::live, 1);
+
+    // A later thread starts from a fresh instance, whatever id the runtime gives it.
+    PerThread<Counter> counters;
+    std::thread([&] { counters.local().value = 5; }).join();
+    std::thread([&] { ASSERT_EQ(counters.local().value, 0); }).join();
+}
+
+TEST(PerThreadTest, OwnerDestroyedBeforeThreadExits) {
+    std::latch owner_gone(1);
+    std::latch used(1);
+    auto per_thread = std::make_unique<PerThread<Tracked>>();
+    std::thread worker([&] {
+        (void)per_thread->local();
+        used.count_down();
+        owner_gone.wait();
+    });
+    used.wait();
+    ASSERT_EQ(Tracked::live, 1);
+    per_thread.reset();
+    ASSERT_EQ(Tracked::live, 0);
+    owner_gone.count_down();
+    worker.join();
+    ASSERT_EQ(Tracked::live, 0);
+}
+
+TEST(PerThreadTest, NewOwnerDoesNotInheritStaleSlot) {
+    Counter* old_instance;
+    {
+        PerThread<Counter> first;
+        old_instance = &first.local();
+        old_instance->value = 7;
+    }
+    PerThread<Counter> second;
+    ASSERT_EQ(second.local().value, 0);
+}
+
+} // namespace cryptodd::memory
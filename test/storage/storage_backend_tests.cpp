@@ -1,12 +1,18 @@
 #include <gtest/gtest.h>
 #include <filesystem>
+#include <fstream>
 #include <memory>
 #include <random>
 #include <string>
 #include <vector>
 #include <algorithm>
 
+#if defined(__linux__)
+#include <sys/stat.h>
+#endif
+
 #include "i_storage_backend.h"
+#include "buffered_file_backend.h"
 #include "file_backend.h"
 #include "memory_backend.h"
 #include "mio_backend.h"
@@ -31,6 +37,8 @@ protected:
                 backend_ = std::make_unique<FileBackend>(test_filepath_);
             } else if (backend_type == "MioBackend") {
                 backend_ = std::make_unique<MioBackend>(test_filepath_);
+            } else if (backend_type == "BufferedFileBackend") {
+                backend_ = std::make_unique<BufferedFileBackend>(test_filepath_);
             }
         }
         ASSERT_TRUE(backend_ != nullptr);
@@ -160,6 +168,26 @@ TEST_P(StorageBackendTest, ReadPastEnd) {
     EXPECT_EQ(*read_res, 0); // Should read 0 bytes at EOF
 }
 
+TEST_P(StorageBackendTest, AdviseIsOnlyAHint) {
+    const auto data = generate_random_data(100000);
+    ASSERT_TRUE(backend_->write(data).has_value());
+    ASSERT_TRUE(backend_->flush().has_value());
+
+    for (const auto hint : {AccessHint::SEQUENTIAL, AccessHint::RANDOM, AccessHint::WILLNEED, AccessHint::NORMAL}) {
+        auto whole = backend_->advise(hint);
+        ASSERT_TRUE(whole.has_value()) << whole.error();
+        auto range = backend_->advise(hint, 5000, 20000);
+        ASSERT_TRUE(range.has_value()) << range.error();
+    }
+    // Past the end is not an error either.
+    ASSERT_TRUE(backend_->advise(AccessHint::WILLNEED, 1 << 30, 4096).has_value());
+
+    std::vector<std::byte> read_back(data.size());
+    ASSERT_TRUE(backend_->rewind().has_value());
+    ASSERT_EQ(*backend_->read(read_back), data.size());
+    ASSERT_EQ(read_back, data);
+}
+
 TEST_P(StorageBackendTest, ReadOnlyMode) {
     if (GetParam() == "MemoryBackend") {
         // MemoryBackend doesn't have a read-only mode in its constructor
@@ -172,6 +200,8 @@ TEST_P(StorageBackendTest, ReadOnlyMode) {
         std::unique_ptr<IStorageBackend> writer_backend;
         if (GetParam() == "FileBackend") {
             writer_backend = std::make_unique<FileBackend>(test_filepath_);
+        } else if (GetParam() == "BufferedFileBackend") {
+            writer_backend = std::make_unique<BufferedFileBackend>(test_filepath_);
         } else {
             writer_backend = std::make_unique<MioBackend>(test_filepath_);
         }
@@ -183,6 +213,8 @@ TEST_P(StorageBackendTest, ReadOnlyMode) {
     std::unique_ptr<IStorageBackend> reader_backend;
     if (GetParam() == "FileBackend") {
         reader_backend = std::make_unique<FileBackend>(test_filepath_, std::ios_base::in | std::ios_base::binary);
+    } else if (GetParam() == "BufferedFileBackend") {
+        reader_backend = std::make_unique<BufferedFileBackend>(test_filepath_, std::ios_base::in | std::ios_base::binary);
     } else {
         reader_backend = std::make_unique<MioBackend>(test_filepath_, std::ios_base::in | std::ios_base::binary);
     }
@@ -203,7 +235,7 @@ TEST_P(StorageBackendTest, ReadOnlyMode) {
 INSTANTIATE_TEST_SUITE_P(
     AllBackends,
     StorageBackendTest,
-    ::testing::Values("MemoryBackend", "FileBackend", "MioBackend"),
+    ::testing::Values("MemoryBackend", "FileBackend", "MioBackend", "BufferedFileBackend"),
     [](const ::testing::TestParamInfo<StorageBackendTest::ParamType>& info) {
         return info.param;
     }
@@ -289,4 +321,300 @@ TEST(MioBackendAdversarialTest, MatchesMemoryBackend) {
     if (fs::exists(test_filepath)) {
         fs::remove(test_filepath);
     }
-}
\ No newline at end of file
+}
+
+namespace {
+// Random appends, seeks, overwrites and reads, mirrored on a MemoryBackend.
+void check_matches_memory_backend(const WriteBufferOptions& options) {
+    fs::path test_filepath = generate_unique_test_filepath();
+    {
+        auto buffered = std::make_unique<BufferedFileBackend>(test_filepath, std::ios_base::in | std::ios_base::out | std::ios_base::binary,
+                                                              options);
+        auto mem_backend = std::make_unique<MemoryBackend>();
+
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<int> op_dist(0, 3); // 0: append, 1: seek, 2: overwrite, 3: read back
+        std::uniform_int_distribution<size_t> size_dist(1, 6000);
+        std::uniform_int_distribution<uint64_t> seek_dist(0, 60000);
+
+        for (int i = 0; i < 300; ++i) {
+            const int op = op_dist(gen);
+            const auto size = *mem_backend->size();
+            if (op == 0 || (op == 2 && size == 0)) {
+                auto data = generate_random_data(size_dist(gen));
+                ASSERT_TRUE(buffered->seek(size).has_value());
+                ASSERT_TRUE(mem_backend->seek(size).has_value());
+                ASSERT_TRUE(buffered->write(data).has_value());
+                ASSERT_TRUE(mem_backend->write(data).has_value());
+            } else if (op == 1) {
+                const uint64_t offset = seek_dist(gen);
+                ASSERT_TRUE(buffered->seek(offset).has_value());
+                ASSERT_TRUE(mem_backend->seek(offset).has_value());
+            } else if (op == 2) {
+                const uint64_t offset = std::uniform_int_distribution<uint64_t>(0, size - 1)(gen);
+                auto data = generate_random_data(std::uniform_int_distribution<size_t>(1, 64)(gen));
+                ASSERT_TRUE(buffered->seek(offset).has_value());
+                ASSERT_TRUE(mem_backend->seek(offset).has_value());
+                ASSERT_TRUE(buffered->write(data).has_value());
+                ASSERT_TRUE(mem_backend->write(data).has_value());
+            } else if (size > 0) {
+                const uint64_t offset = std::uniform_int_distribution<uint64_t>(0, size - 1)(gen);
+                std::vector<std::byte> from_buffered(256), from_memory(256);
+                ASSERT_TRUE(buffered->seek(offset).has_value());
+                ASSERT_TRUE(mem_backend->seek(offset).has_value());
+                auto buffered_read = buffered->read(from_buffered);
+                auto memory_read = mem_backend->read(from_memory);
+                ASSERT_TRUE(buffered_read.has_value()) << buffered_read.error();
+                ASSERT_EQ(*buffered_read, *memory_read);
+                from_buffered.resize(*buffered_read);
+                from_memory.resize(*memory_read);
+                ASSERT_EQ(from_buffered, from_memory);
+            }
+            ASSERT_EQ(*buffered->tell(), *mem_backend->tell());
+            ASSERT_EQ(*buffered->size(), *mem_backend->size());
+        }
+
+        ASSERT_TRUE(buffered->flush().has_value());
+        const auto final_size = *mem_backend->size();
+        // Direct I/O leaves the last sector's padding in place until close.
+        const uint64_t padding = buffered->direct_io() ? BufferedFileBackend::IO_ALIGNMENT : 1;
+        ASSERT_GE(fs::file_size(test_filepath), final_size);
+        ASSERT_LT(fs::file_size(test_filepath), final_size + padding);
+        buffered.reset();
+        ASSERT_EQ(fs::file_size(test_filepath), final_size);
+        std::vector<std::byte> expected(final_size);
+        ASSERT_TRUE(mem_backend->rewind().has_value());
+        ASSERT_EQ(*mem_backend->read(expected), final_size);
+        std::ifstream file(test_filepath, std::ios::binary);
+        std::vector<std::byte> actual(final_size);
+        file.read(reinterpret_cast<char*>(actual.data()), static_cast<std::streamsize>(final_size));
+        ASSERT_EQ(actual, expected);
+    }
+    fs::remove(test_filepath);
+}
+}
+
+// Small blocks so the test crosses many block boundaries and buffer spills.
+TEST(BufferedFileBackendTest, MatchesMemoryBackend) {
+    check_matches_memory_backend({.block_size = 4096, .max_buffered_blocks = 3});
+}
+
+// Unaligned patches, flushes and reads all go through whole sectors.
+TEST(BufferedFileBackendTest, DirectIoMatchesMemoryBackend) {
+    check_matches_memory_backend({.block_size = 8192, .max_buffered_blocks = 2, .direct_io = true});
+}
+
+TEST(BufferedFileBackendTest, DirectIoSequentialScan) {
+    fs::path test_filepath = generate_unique_test_filepath();
+    const auto data = generate_random_data(300000);
+    {
+        BufferedFileBackend writer(test_filepath, std::ios_base::out | std::ios_base::binary,
+                                   WriteBufferOptions{.block_size = 65536, .direct_io = true});
+        if (!writer.direct_io()) {
+            GTEST_SKIP() << "The file system does not support direct I/O.";
+        }
+        ASSERT_TRUE(writer.write(data).has_value());
+        ASSERT_TRUE(writer.flush().has_value());
+        // The last sector went out padded; the padding stays until close.
+        ASSERT_EQ(writer.io_stats().bytes_written % BufferedFileBackend::IO_ALIGNMENT, 0u);
+        ASSERT_EQ(fs::file_size(test_filepath) % BufferedFileBackend::IO_ALIGNMENT, 0u);
+        ASSERT_EQ(*writer.size(), data.size());
+    }
+    ASSERT_EQ(fs::file_size(test_filepath), data.size());
+
+    BufferedFileBackend reader(test_filepath, std::ios_base::in | std::ios_base::binary,
+                               WriteBufferOptions{.block_size = 65536, .direct_io = true});
+    ASSERT_TRUE(reader.direct_io());
+    // Reads skip the page cache, so no hint is passed on.
+    ASSERT_FALSE(*reader.advise(AccessHint::WILLNEED));
+    std::vector<std::byte> scanned;
+    std::vector<std::byte> piece(1000);
+    while (true) {
+        const auto n = reader.read(piece);
+        ASSERT_TRUE(n.has_value()) << n.error();
+        if (*n == 0) break;
+        scanned.insert(scanned.end(), piece.begin(), piece.begin() + static_cast<ptrdiff_t>(*n));
+    }
+    ASSERT_EQ(scanned, data);
+    // One read per 64 KiB window, not per piece.
+    ASSERT_EQ(reader.io_stats().read_calls, (data.size() + 65535) / 65536);
+
+    // Reads straddling a window edge.
+    ASSERT_TRUE(reader.seek(65536 - 10).has_value());
+    std::vector<std::byte> straddling(20);
+    ASSERT_EQ(*reader.read(straddling), 20u);
+    ASSERT_TRUE(std::equal(straddling.begin(), straddling.end(), data.begin() + 65536 - 10));
+    fs::remove(test_filepath);
+}
+
+TEST(BufferedFileBackendTest, ReadOnlyReadsShareAWindow) {
+    fs::path test_filepath = generate_unique_test_filepath();
+    const auto data = generate_random_data(300000);
+    {
+        std::ofstream out(test_filepath, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    }
+
+    BufferedFileBackend reader(test_filepath, std::ios_base::in | std::ios_base::binary,
+                               WriteBufferOptions{.block_size = 65536});
+    std::vector<std::byte> scanned;
+    std::vector<std::byte> piece(1000);
+    while (true) {
+        const auto n = reader.read(piece);
+        ASSERT_TRUE(n.has_value()) << n.error();
+        if (*n == 0) break;
+        scanned.insert(scanned.end(), piece.begin(), piece.begin() + static_cast<ptrdiff_t>(*n));
+    }
+    ASSERT_EQ(scanned, data);
+    ASSERT_EQ(reader.io_stats().read_calls, (data.size() + 65535) / 65536);
+
+    // A read at least a window long skips the window.
+    const auto calls = reader.io_stats().read_calls;
+    ASSERT_TRUE(reader.seek(100).has_value());
+    std::vector<std::byte> large(100000);
+    ASSERT_EQ(*reader.read(large), large.size());
+    ASSERT_TRUE(std::equal(large.begin(), large.end(), data.begin() + 100));
+    ASSERT_EQ(reader.io_stats().read_calls, calls + 1);
+    fs::remove(test_filepath);
+}
+
+TEST(BufferedFileBackendTest, CoalescesAppendsAndPatches) {
+    fs::path test_filepath = generate_unique_test_filepath();
+    {
+        BufferedFileBackend backend(test_filepath, std::ios_base::out | std::ios_base::binary,
+                                    WriteBufferOptions{.block_size = 4096, .max_buffered_blocks = 4});
+        // An index-like header, then records appended after patching their slot, as DataWriter does.
+        ASSERT_TRUE(backend.write(std::vector<std::byte>(256)).has_value());
+        for (uint64_t i = 0; i < 100; ++i) {
+            const auto record = generate_random_data(200);
+            const auto start = *backend.tell();
+            ASSERT_TRUE(backend.write(record).has_value());
+            ASSERT_TRUE(backend.seek(8 * (i % 32)).has_value());
+            ASSERT_TRUE(backend.write(std::as_bytes(std::span(&start, 1))).has_value());
+            ASSERT_TRUE(backend.seek(start + record.size()).has_value());
+        }
+        // 20 KB in 4 KB blocks: a single pwritev once four blocks filled; the later slot patches wait in memory.
+        ASSERT_EQ(backend.io_stats().write_calls, 1u);
+        ASSERT_EQ(fs::file_size(test_filepath), 4u * 4096);
+
+        // The partial block, then the slots patched since the spill (i = 81..99), merged into two runs.
+        ASSERT_TRUE(backend.flush().has_value());
+        ASSERT_EQ(backend.io_stats().flushes, 1u);
+        ASSERT_EQ(backend.io_stats().write_calls, 4u);
+        ASSERT_EQ(fs::file_size(test_filepath), 256u + 100 * 200);
+        // Nothing new to write: flush is free.
+        const auto calls = backend.io_stats().write_calls;
+        ASSERT_TRUE(backend.flush().has_value());
+        ASSERT_EQ(backend.io_stats().write_calls, calls);
+    }
+    {
+        // Reopened for append, the partial last block is staged again and the index reads back.
+        BufferedFileBackend backend(test_filepath);
+        ASSERT_EQ(*backend.size(), 256u + 100 * 200);
+        uint64_t last_slot = 0;
+        ASSERT_TRUE(backend.seek(8 * (99 % 32)).has_value());
+        ASSERT_EQ(*backend.read(std::as_writable_bytes(std::span(&last_slot, 1))), sizeof(uint64_t));
+        ASSERT_EQ(last_slot, 256u + 99 * 200);
+    }
+    fs::remove(test_filepath);
+}
+
+#if defined(__linux__)
+TEST(BufferedFileBackendTest, PreallocatesAheadAndTrimsOnClose) {
+    constexpr uint64_t kExtent = 1 << 20;
+    const auto allocated_bytes = [](const fs::path& path) {
+        struct stat st{};
+        EXPECT_EQ(::stat(path.c_str(), &st), 0);
+        return static_cast<uint64_t>(st.st_blocks) * 512;
+    };
+    fs::path test_filepath = generate_unique_test_filepath();
+    {
+        BufferedFileBackend backend(test_filepath, std::ios_base::out | std::ios_base::binary,
+                                    WriteBufferOptions{.block_size = 4096, .max_buffered_blocks = 2, .preallocate_extent = kExtent});
+        const auto data = generate_random_data(10000);
+        ASSERT_TRUE(backend.write(data).has_value());
+        ASSERT_TRUE(backend.flush().has_value());
+        if (backend.io_stats().preallocated_bytes == 0) {
+            GTEST_SKIP() << "The file system does not support fallocate.";
+        }
+        // One extent reserved, but the file size only covers what was written.
+        ASSERT_EQ(backend.io_stats().preallocated_bytes, kExtent);
+        ASSERT_EQ(fs::file_size(test_filepath), 10000u);
+        ASSERT_GE(allocated_bytes(test_filepath), kExtent);
+
+        ASSERT_TRUE(backend.write(generate_random_data(kExtent)).has_value());
+        ASSERT_TRUE(backend.flush().has_value());
+        ASSERT_EQ(backend.io_stats().preallocated_bytes, 2 * kExtent);
+    }
+    ASSERT_EQ(fs::file_size(test_filepath), 10000u + kExtent);
+    ASSERT_LT(allocated_bytes(test_filepath), 2 * kExtent);
+    fs::remove(test_filepath);
+}
+
+// Flushes ending mid-sector keep their padding, and so the reservation past it, until close.
+TEST(BufferedFileBackendTest, DirectIoFlushesKeepTheReservation) {
+    constexpr uint64_t kExtent = 1 << 20;
+    fs::path test_filepath = generate_unique_test_filepath();
+    {
+        BufferedFileBackend backend(test_filepath, std::ios_base::out | std::ios_base::binary,
+                                    WriteBufferOptions{.block_size = 8192, .preallocate_extent = kExtent, .direct_io = true});
+        if (!backend.direct_io()) {
+            GTEST_SKIP() << "The file system does not support direct I/O.";
+        }
+        for (int i = 0; i < 20; ++i) {
+            ASSERT_TRUE(backend.write(generate_random_data(1000)).has_value());
+            ASSERT_TRUE(backend.flush().has_value());
+        }
+        if (backend.io_stats().preallocated_bytes == 0) {
+            GTEST_SKIP() << "The file system does not support fallocate.";
+        }
+        ASSERT_EQ(backend.io_stats().preallocated_bytes, kExtent);
+        ASSERT_EQ(*backend.size(), 20000u);
+    }
+    ASSERT_EQ(fs::file_size(test_filepath), 20000u);
+    fs::remove(test_filepath);
+}
+#endif
+
+TEST(MioBackendTest, TrimsGrowthOnClose) {
+    fs::path test_filepath = generate_unique_test_filepath();
+    {
+        MioBackend backend(test_filepath);
+        // Writes grow the mapping ahead of the data.
+        for (int i = 0; i < 5; ++i) {
+            ASSERT_TRUE(backend.write(generate_random_data(1000)).has_value());
+        }
+        ASSERT_EQ(*backend.size(), 5000u);
+    }
+    ASSERT_EQ(fs::file_size(test_filepath), 5000u);
+    MioBackend reader(test_filepath, std::ios_base::in | std::ios_base::binary);
+    ASSERT_EQ(*reader.size(), 5000u);
+    fs::remove(test_filepath);
+}
+
+TEST(MioBackendTest, MapOptions) {
+    fs::path test_filepath = generate_unique_test_filepath();
+    const auto data = generate_random_data(3 * 1024 * 1024 + 123);
+    const MapOptions options{.populate = true, .huge_pages = true};
+    {
+        // The hint and the lock, given before anything is mapped, follow the mappings made as the file grows.
+        MioBackend writer(test_filepath, std::ios_base::in | std::ios_base::out | std::ios_base::binary, options);
+        ASSERT_TRUE(writer.advise(AccessHint::SEQUENTIAL).has_value());
+        ASSERT_TRUE(writer.lock(0, 4096).has_value());
+        for (size_t offset = 0; offset < data.size(); offset += 100000) {
+            const auto piece = std::span(data).subspan(offset, std::min<size_t>(100000, data.size() - offset));
+            ASSERT_TRUE(writer.write(piece).has_value());
+        }
+    }
+    ASSERT_EQ(fs::file_size(test_filepath), data.size());
+
+    MioBackend reader(test_filepath, std::ios_base::in | std::ios_base::binary, options);
+    auto locked = reader.lock(5000, 20000);
+    ASSERT_TRUE(locked.has_value()) << locked.error();
+    ASSERT_TRUE(reader.lock(data.size() + 4096, 4096).has_value());
+    ASSERT_TRUE(reader.advise(AccessHint::RANDOM).has_value());
+    std::vector<std::byte> read_back(data.size());
+    ASSERT_EQ(*reader.read(read_back), data.size());
+    ASSERT_EQ(read_back, data);
+    fs::remove(test_filepath);
+}
@@ -56,6 +56,135 @@ def test_save_and_load_with_explicit_codec_and_metadata(tmp_path: Path):
     with cdd_open(str(filepath)) as f:
         assert f.user_metadata == metadata
 
+def test_save_and_load_with_advanced_zstd_parameters(tmp_path: Path):
+    """
+    Tests that zstd multithreading, long-distance matching, window size and
+    strategy are accepted end to end and the data reads back unchanged.
+    """
+    filepath = tmp_path / "test_zstd_advanced.cdd"
+    original_data = np.tile(np.random.rand(4096).astype(np.float32), 64)
+
+    save_array(
+        str(filepath),
+        original_data,
+        codec=Codec.ZSTD_COMPRESSED,
+        zstd_level=3,
+        zstd_workers=2,
+        zstd_long_distance_matching=True,
+        zstd_window_log=28,
+        zstd_strategy="BTULTRA2",
+    )
+
+    loaded_data = load_array(str(filepath))
+    np.testing.assert_array_equal(loaded_data, original_data)
+
+def test_save_and_load_float64_with_chimp_codec(tmp_path: Path):
+    """
+    Tests that 1D float64 series round-trip bit-exactly through the Chimp128 codec.
+    """
+    filepath = tmp_path / "test_chimp.cdd"
+    steps = np.random.choice([-0.5, 0.0, 0.0, 0.0, 0.5], size=10_000)
+    original_data = 30_000.0 + np.cumsum(steps)
+
+    save_array(str(filepath), original_data, codec=Codec.TEMPORAL_1D_CHIMP_F64)
+
+    loaded_data = load_array(str(filepath))
+    assert loaded_data.dtype == np.float64
+    np.testing.assert_array_equal(loaded_data, original_data)
+
+def test_save_and_load_float64_with_xor_shuffle_codecs(tmp_path: Path):
+    """
+    Tests that float64 series and 2D feature arrays round-trip bit-exactly through
+    the float64 XOR + byte-shuffle codecs, including auto-selection for 2D input.
+    """
+    series = 30_000.0 + np.cumsum(np.random.choice([-0.5, 0.0, 0.5], size=5_000))
+    filepath = tmp_path / "test_f64_1d.cdd"
+    save_array(str(filepath), series, codec=Codec.TEMPORAL_1D_SIMD_F64_XOR_SHUFFLE)
+    np.testing.assert_array_equal(load_array(str(filepath)), series)
+
+    features = np.cumsum(np.random.rand(1000, 6), axis=0)
+    filepath = tmp_path / "test_f64_2d.cdd"
+    save_array(str(filepath), features)
+    loaded_data = load_array(str(filepath))
+    assert loaded_data.dtype == np.float64
+    np.testing.assert_array_equal(loaded_data, features)
+
+def test_save_and_load_with_fixed_point_codecs(tmp_path: Path):
+    """
+    Tests that tick-aligned prices round-trip bit-exactly through the fixed-point codecs,
+    and that off-grid data still round-trips through the float fallback.
+    """
+    prices = (3_000_000 + np.cumsum(np.random.randint(-20, 21, size=5_000))) / 100
+    filepath = tmp_path / "test_fixed_point_1d.cdd"
+    save_array(str(filepath), prices, codec=Codec.TEMPORAL_1D_FIXED_POINT_F64, tick_sizes=[0.01])
+    np.testing.assert_array_equal(load_array(str(filepath)), prices)
+
+    book = (np.random.randint(1, 50_000, size=(200, 10, 3)) * 0.5).astype(np.float32)
+    filepath = tmp_path / "test_fixed_point_ob.cdd"
+    save_array(str(filepath), book, codec=Codec.ORDERBOOK_FIXED_POINT_F32, tick_sizes=[0.5])
+    np.testing.assert_array_equal(load_array(str(filepath)), book)
+
+    off_grid = np.random.rand(1000, 4)
+    filepath = tmp_path / "test_fixed_point_fallback.cdd"
+    save_array(str(filepath), off_grid, codec=Codec.TEMPORAL_2D_FIXED_POINT_F64, tick_sizes=[0.01])
+    np.testing.assert_array_equal(load_array(str(filepath)), off_grid)
+
+def test_save_and_load_with_bfp16_orderbook_codec(tmp_path: Path):
+    """
+    Tests that the block-floating-point orderbook codec stays within its documented error bound
+    (about 2^-11 of each snapshot's per-feature range, plus float rounding).
+    """
+    mid = 65_000.0 + np.cumsum(np.random.randn(500))
+    prices = mid[:, None] + np.arange(-10, 10) * 0.1
+    sizes = np.random.lognormal(-3.0, 2.0, size=(500, 20))
+    book = np.stack([prices, sizes, np.random.randint(1, 30, size=(500, 20))], axis=-1).astype(np.float32)
+    filepath = tmp_path / "test_bfp16_ob.cdd"
+    save_array(str(filepath), book, codec=Codec.GENERIC_OB_SIMD_BFP16_AS_F32)
+    loaded = load_array(str(filepath))
+
+    assert loaded.shape == book.shape
+    span = book.max(axis=1, keepdims=True) - book.min(axis=1, keepdims=True)
+    assert np.all(np.abs(loaded - book) <= span * 2.0**-10 + np.spacing(np.abs(book)))
+    # Small integer counts are restored exactly.
+    np.testing.assert_array_equal(loaded[..., 2], book[..., 2])
+
+def test_save_and_load_with_sparse_orderbook_codec(tmp_path: Path):
+    """
+    Tests that the sparse orderbook codec round-trips a book where few levels change per snapshot,
+    and that a busy book falls back to the dense codec without losing data.
+    """
+    book = np.repeat(np.random.lognormal(-3.0, 2.0, size=(1, 256, 3)), 400, axis=0).astype(np.float32)
+    for i in range(1, len(book)):
+        book[i:, np.random.randint(256), np.random.randint(3)] = np.float32(np.random.lognormal(-3.0, 2.0))
+    filepath = tmp_path / "test_sparse_ob.cdd"
+    save_array(str(filepath), book, codec=Codec.GENERIC_OB_SIMD_SPARSE_F32)
+    np.testing.assert_array_equal(load_array(str(filepath)), book)
+
+    busy = np.random.rand(50, 256, 3).astype(np.float32)
+    save_array(str(filepath), busy, codec=Codec.GENERIC_OB_SIMD_SPARSE_F32)
+    np.testing.assert_array_equal(load_array(str(filepath)), busy)
+
+def test_save_and_load_with_quantized_codecs(tmp_path: Path):
+    """
+    Tests that the error-bounded codecs keep every value within its absolute or relative bound,
+    and that non-finite data round-trips exactly through the float fallback.
+    """
+    prices = 30_000 + np.cumsum(np.random.randn(5_000))
+    filepath = tmp_path / "test_quantized_1d.cdd"
+    save_array(str(filepath), prices, codec=Codec.TEMPORAL_1D_QUANTIZED_F64, error_bounds=[1e-4])
+    assert np.all(np.abs(load_array(str(filepath)) - prices) <= 1e-4)
+
+    features = (np.random.rand(1000, 4) * 100.0).astype(np.float32)
+    filepath = tmp_path / "test_quantized_2d.cdd"
+    save_array(str(filepath), features, codec=Codec.TEMPORAL_2D_QUANTIZED_F32, error_bounds=[1e-3], relative_error_bound=True)
+    loaded = load_array(str(filepath))
+    assert loaded.dtype == np.float32
+    assert np.all(np.abs(loaded.astype(np.float64) - features) <= 1e-3 * np.abs(features).max())
+
+    features[10, 2] = np.nan
+    save_array(str(filepath), features, codec=Codec.TEMPORAL_2D_QUANTIZED_F32, error_bounds=[1e-3])
+    np.testing.assert_array_equal(load_array(str(filepath)), features)
+
 def test_load_array_fails_on_multi_chunk_file(tmp_path: Path):
     """
     Ensures `load_array` raises a ValueError for files with more than one chunk.
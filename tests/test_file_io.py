@@ -31,6 +31,142 @@ def test_writer_create_and_append(tmp_path: Path):
         np.testing.assert_array_equal(f[0], np.array([1, 2, 3], dtype=np.int32))
         np.testing.assert_array_equal(f[1], np.array([4., 5., 6.], dtype=np.float32))
 
+def test_writer_adaptive_zstd_level(tmp_path: Path):
+    """Chunks appended with zstd_adaptive report the level the controller picked."""
+    filepath = tmp_path / "adaptive_test.cdd"
+    data = np.cumsum(np.random.default_rng(0).normal(size=10_000)).astype(np.float32)
+
+    # An unreachable throughput target walks the level down to its minimum.
+    with cdd_open(str(filepath), 'w', adaptive_zstd={"min_level": -3, "max_level": 3, "target_mbps": 1e9}) as f:
+        levels = [f.append_chunk(data, Codec.TEMPORAL_1D_SIMD_F32_XOR_SHUFFLE, zstd_adaptive=True).zstd_level for _ in range(12)]
+        assert levels[0] == 1
+        assert levels[-1] == -3
+        assert f.append_chunk(data, 'ZSTD_COMPRESSED', zstd_level=5).zstd_level == 5
+
+    with cdd_open(str(filepath), 'r') as f:
+        for i in range(f.nchunks):
+            np.testing.assert_array_equal(f[i], data)
+
+def test_writer_hash_algorithms(tmp_path: Path):
+    """Chunks hashed with different algorithms all verify on read."""
+    filepath = tmp_path / "hash_test.cdd"
+    data = np.arange(100_000, dtype=np.int64)
+
+    with cdd_open(str(filepath), 'w', hash_algorithm='XXH3_128', hash_parallel_threshold=1 << 16) as f:
+        f.append_chunk(data, 'ZSTD_COMPRESSED')
+        f.append_chunk(data, 'ZSTD_COMPRESSED', hash_algorithm='BLAKE3_256')
+        f.append_chunk(data, 'RAW', hash_algorithm='NONE')
+
+    with cdd_open(str(filepath), 'r', check_checksums=True) as f:
+        for i in range(f.nchunks):
+            np.testing.assert_array_equal(f[i], data)
+
+    with pytest.raises(ValueError):
+        cdd_open(str(filepath), 'r', hash_algorithm='XXH3_128')
+
+def test_writer_preallocation(tmp_path: Path):
+    """Preallocated space never shows up in the file."""
+    filepath = tmp_path / "prealloc_test.cdd"
+    data = np.arange(1000, dtype=np.int64)
+
+    with cdd_open(str(filepath), 'w', preallocate_extent=1 << 20) as f:
+        for _ in range(3):
+            f.append_chunk(data, 'RAW')
+    assert filepath.stat().st_size < 1 << 20
+
+    with cdd_open(str(filepath), 'a', preallocate_extent=1 << 20) as f:
+        f.append_chunk(data, 'RAW')
+
+    with cdd_open(str(filepath), 'r') as f:
+        assert f.nchunks == 4
+        np.testing.assert_array_equal(f[3], data)
+
+    with pytest.raises(CddError):
+        cdd_open(str(tmp_path / "unbuffered.cdd"), 'w', preallocate_extent=1 << 20, write_buffer_size=0)
+
+def test_direct_io_with_aligned_chunks(tmp_path: Path):
+    """Direct I/O writers and readers see the same data; chunks land on 4 KiB boundaries."""
+    filepath = tmp_path / "direct_io_test.cdd"
+    arrays = [np.arange(n, dtype=np.float64) for n in (10, 1000, 3000)]
+
+    with cdd_open(str(filepath), 'w', direct_io=True, chunk_alignment=4096) as f:
+        for a in arrays:
+            f.append_chunk(a, 'RAW')
+    assert filepath.stat().st_size > 2 * 4096
+
+    for direct_io in (True, False):
+        with cdd_open(str(filepath), 'r', direct_io=direct_io) as f:
+            assert f.nchunks == len(arrays)
+            for i, a in enumerate(arrays):
+                np.testing.assert_array_equal(f[i], a)
+
+    with pytest.raises(ValueError):
+        cdd_open(None, 'w', direct_io=True)
+    with pytest.raises(CddError):
+        cdd_open(str(tmp_path / "misaligned.cdd"), 'w', chunk_alignment=1000)
+
+def test_access_hints(tmp_path: Path):
+    """Access hints on open and per read change how the file is read, never what is read."""
+    filepath = tmp_path / "access_test.cdd"
+    arrays = [np.arange(i * 100, i * 100 + 500, dtype=np.int64) for i in range(8)]
+    with cdd_open(str(filepath), 'w') as f:
+        for a in arrays:
+            f.append_chunk(a, 'RAW')
+
+    for access in ('NORMAL', 'SEQUENTIAL', 'RANDOM', 'WILLNEED'):
+        with cdd_open(str(filepath), 'r', access=access) as f:
+            np.testing.assert_array_equal(f[:], np.concatenate(arrays))
+            np.testing.assert_array_equal(f.read(3, access='RANDOM'), arrays[3])
+            np.testing.assert_array_equal(f.read(slice(2, 7), access='SEQUENTIAL', prefetch_chunks=2),
+                                          np.concatenate(arrays[2:7]))
+
+    with pytest.raises(ValueError):
+        cdd_open(str(tmp_path / "hinted.cdd"), 'w', access='SEQUENTIAL')
+    with pytest.raises(CddError):
+        cdd_open(str(filepath), 'r', access='BACKWARDS')
+
+def test_memory_mapped_read(tmp_path: Path):
+    """A memory-mapped reader, whatever its mapping options, reads what was written."""
+    filepath = tmp_path / "mmap_test.cdd"
+    arrays = [np.arange(i * 1000, i * 1000 + 2000, dtype=np.float32) for i in range(5)]
+    with cdd_open(str(filepath), 'w') as f:
+        for a in arrays:
+            f.append_chunk(a, 'RAW')
+
+    for mmap in (True, {"populate": True, "huge_pages": True, "lock_index": True}):
+        with cdd_open(str(filepath), 'r', mmap=mmap, access='SEQUENTIAL') as f:
+            np.testing.assert_array_equal(f[:], np.concatenate(arrays))
+            np.testing.assert_array_equal(f[4], arrays[4])
+            if mmap is True:
+                assert f.index_lock_error is None
+
+    with pytest.raises(ValueError):
+        cdd_open(str(tmp_path / "mapped.cdd"), 'w', mmap=True)
+    with pytest.raises(CddError):
+        cdd_open(str(filepath), 'r', mmap=True, direct_io=True)
+
+def test_writer_durability(tmp_path: Path):
+    """A writer syncing every other chunk reports its device's sync statistics."""
+    filepath = tmp_path / "durability_test.cdd"
+    data = np.arange(1000, dtype=np.int32)
+
+    with cdd_open(str(filepath), 'w', durability={"mode": "EVERY_N_CHUNKS", "every_chunks": 2}) as f:
+        before = f.sync_stats()["requests"]
+        for _ in range(4):
+            f.append_chunk(data, 'RAW')
+        stats = f.sync_stats()
+        assert stats["requests"] - before == 3
+        assert stats["p50_us"] <= stats["p99_us"] <= stats["max_us"]
+
+    with cdd_open(str(filepath), 'r') as f:
+        assert f.nchunks == 4
+
+    with cdd_open(str(tmp_path / "no_sync.cdd"), 'w') as f:
+        assert f.sync_stats() is None
+
+    with pytest.raises(CddError):
+        cdd_open(str(tmp_path / "bad.cdd"), 'w', durability={"mode": "EVERY_N_CHUNKS", "every_chunks": 0})
+
 def test_writer_fails_on_non_contiguous_array(tmp_path: Path):
     """Ensures the C-contiguity check is working from the Python side."""
     filepath = tmp_path / "contig_test.cdd"
@@ -68,6 +204,30 @@ def test_reader_properties(multi_chunk_file: Path):
 
     assert f.closed
 
+def test_reader_verify(multi_chunk_file: Path, tmp_path: Path):
+    """Verify scrubs every chunk and reports the corrupted ones by index."""
+    with cdd_open(str(multi_chunk_file), 'r') as f:
+        report = f.verify()
+    assert report.ok
+    assert report.chunks_verified == 3
+    assert report.corrupted_chunks == ()
+    assert report.index_blocks >= 1
+
+    # Flip a byte inside the payload of the last chunk (the int64 values 10..19).
+    image = bytearray(multi_chunk_file.read_bytes())
+    offset = image.find(np.arange(10, 20, dtype=np.int64).tobytes())
+    assert offset > 0
+    image[offset + 8] ^= 0xFF
+    corrupted = tmp_path / "corrupted.cdd"
+    corrupted.write_bytes(bytes(image))
+
+    with cdd_open(str(corrupted), 'r') as f:
+        report = f.verify(max_read_mbps=100.0)
+    assert not report.ok
+    assert report.corrupted_chunks == (2,)
+    assert report.chunks_verified == 2
+
+
 def test_reader_integer_indexing(multi_chunk_file: Path):
     """Tests reading single chunks with positive and negative indices."""
     with cdd_open(str(multi_chunk_file), 'r') as f: